@@ -0,0 +1,107 @@
+#include "display.h"
+
+// Pines de los segmentos en orden A, B, C, D, E, F, G
+static const uint8_t segment_pins[7] = {
+    DISPLAY_PIN_A, DISPLAY_PIN_B, DISPLAY_PIN_C, DISPLAY_PIN_D, DISPLAY_PIN_E, DISPLAY_PIN_F, DISPLAY_PIN_G
+};
+
+// Comun de cada digito, de izquierda a derecha
+static const uint8_t common_pins[DISPLAY_DIGITS] = { DISPLAY_PIN_A1, DISPLAY_PIN_A2 };
+
+// Cada bit representa un segmento
+static const uint8_t digit_to_segments[10] = {
+    0b00111111, // 0: A B C D E F
+    0b00000101, // 1: A C
+    0b01011011, // 2: A B D E
+    0b01001111, // 3: A B C D G
+    0b01100101, // 4: B C G F
+    0b01101110, // 5: A C D F G
+    0b01111110, // 6: A C D E F G
+    0b00000111, // 7: A B
+    0b01111111, // 8: A B C D E F G
+    0b01101111  // 9: A B C D F G
+};
+
+// Valor del puerto para cada digito, ya con segmentos y comunes
+static volatile uint32_t frames[DISPLAY_DIGITS];
+// Digito que se enciende en el proximo refresco
+static uint8_t current_digit = 0;
+
+/**
+ * @brief Arma la palabra del puerto para un pin con un nivel dado
+ */
+static uint32_t pin_level(uint8_t pin, uint8_t level)
+{
+    return level ? (1UL << pin) : 0;
+}
+
+/**
+ * @brief Calcula el valor del puerto que muestra un numero en un digito
+ */
+static uint32_t build_frame(uint8_t digit, uint8_t number)
+{
+    uint32_t frame = 0;
+    uint8_t seg = digit_to_segments[number];
+
+    for (int i = 0; i < 7; i++)
+    {
+        uint8_t on = (seg >> i) & 1;
+        frame |= pin_level(segment_pins[i], on ? DISPLAY_SEGMENT_ON : !DISPLAY_SEGMENT_ON);
+    }
+    for (int i = 0; i < DISPLAY_DIGITS; i++)
+    {
+        frame |= pin_level(common_pins[i], (i == digit) ? DISPLAY_COMMON_ON : !DISPLAY_COMMON_ON);
+    }
+    return frame;
+}
+
+void display_init(void)
+{
+    gpio_pin_config_t out_config = {.pinDirection = kGPIO_DigitalOutput, .outputLogic = !DISPLAY_SEGMENT_ON};
+    uint32_t mask = 0;
+
+    GPIO_PortInit(GPIO, DISPLAY_PORT);
+
+    // Inicializo segmentos apagados
+    for (int i = 0; i < 7; i++)
+    {
+        GPIO_PinInit(GPIO, DISPLAY_PORT, segment_pins[i], &out_config);
+        mask |= 1UL << segment_pins[i];
+    }
+    // Inicializo comunes deshabilitados
+    out_config.outputLogic = !DISPLAY_COMMON_ON;
+    for (int i = 0; i < DISPLAY_DIGITS; i++)
+    {
+        GPIO_PinInit(GPIO, DISPLAY_PORT, common_pins[i], &out_config);
+        mask |= 1UL << common_pins[i];
+    }
+
+    // Solo los pines del display se escriben con GPIO_PortMaskedWrite. La mascara del puerto
+    // queda fija y la usa display_refresh() desde la interrupcion, nadie mas puede usar acceso
+    // enmascarado en DISPLAY_PORT
+    GPIO_PortMaskedSet(GPIO, DISPLAY_PORT, ~mask);
+
+    display_set_value(0);
+
+    // Configuro SysTick para refrescar un digito por interrupcion
+    SysTick_Config(SystemCoreClock / DISPLAY_TICK_HZ);
+}
+
+void display_set_value(uint8_t value)
+{
+    if (value > 99)
+        return;
+
+    frames[0] = build_frame(0, value / 10);
+    frames[1] = build_frame(1, value % 10);
+}
+
+void display_refresh(void)
+{
+    // Segmentos y comunes cambian en una sola escritura
+    GPIO_PortMaskedWrite(GPIO, DISPLAY_PORT, frames[current_digit]);
+
+    current_digit++;
+    if (current_digit >= DISPLAY_DIGITS)
+        current_digit = 0;
+}
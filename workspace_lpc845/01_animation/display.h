@@ -0,0 +1,66 @@
+#ifndef _DISPLAY_H_
+#define _DISPLAY_H_
+
+#include <stdint.h>
+#include "fsl_gpio.h"
+
+// Mapeo de segmentos: A, B, C, D, E, F, G
+//      --B--
+//     |     |
+//     F     A
+//     |     |
+//      --G--
+//     |     |
+//     E     C
+//     |     |
+//      --D--
+
+// Todos los pines del display estan en el puerto 0
+#define DISPLAY_PORT 0
+
+#define DISPLAY_PIN_A 11
+#define DISPLAY_PIN_B 10
+#define DISPLAY_PIN_C 6
+#define DISPLAY_PIN_D 14
+#define DISPLAY_PIN_E 0
+#define DISPLAY_PIN_F 13
+#define DISPLAY_PIN_G 15
+
+// Comunes de cada digito (A1 izquierdo, A2 derecho)
+#define DISPLAY_PIN_A1 8
+#define DISPLAY_PIN_A2 9
+
+// Nivel que enciende un segmento y nivel que habilita un comun (anodo comun)
+#define DISPLAY_SEGMENT_ON 0
+#define DISPLAY_COMMON_ON  1
+
+#define DISPLAY_DIGITS 2
+
+// Frecuencia de refresco de cada digito en Hz
+#ifndef DISPLAY_REFRESH_HZ
+#define DISPLAY_REFRESH_HZ 100
+#endif
+
+// Frecuencia a la que hay que llamar a display_refresh()
+#define DISPLAY_TICK_HZ (DISPLAY_REFRESH_HZ * DISPLAY_DIGITS)
+
+/**
+ * @brief Inicializa los pines del display y el SysTick a DISPLAY_TICK_HZ
+ * @note Deja la mascara de DISPLAY_PORT para el display, el resto del programa no debe usar
+ * GPIO_PortMaskedSet/Write/Read en ese puerto (usar GPIO_PortSet/Clear/Toggle, que no dependen
+ * de la mascara)
+ */
+void display_init(void);
+
+/**
+ * @brief Cambia el valor mostrado, no bloquea
+ * @param value numero de 0 a 99
+ */
+void display_set_value(uint8_t value);
+
+/**
+ * @brief Enciende el siguiente digito, llamar desde SysTick_Handler
+ */
+void display_refresh(void);
+
+#endif /* _DISPLAY_H_ */
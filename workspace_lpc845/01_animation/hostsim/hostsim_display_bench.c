@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Runs the display driver against the GPIO model of the register simulator with the SysTick
+ * refresh of the application. Every refresh is logged from SysTick_Handler: the port value, the
+ * register accesses it made and the core cycle count. Checks the port value of both digits for
+ * all numbers against the wiring of the board (common anode, segments low, commons high), that
+ * each refresh is a single masked write that leaves the other pins alone while the main loop
+ * toggles one of them, and the refresh rate against DISPLAY_REFRESH_HZ.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "fsl_hostsim_models.h"
+#include "display.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_LOG_SIZE      (1024U)
+#define BENCH_TIMING_TICKS  (400U)
+#define BENCH_REFRESH_SLACK (2U) /* Percent off the configured refresh rate. */
+
+/* Pins of port 0 outside the display, driven by the bench. */
+#define BENCH_OTHER_PINS   ((1UL << 1U) | (1UL << 4U) | (1UL << 12U))
+#define BENCH_TOGGLE_PIN   (12U)
+
+typedef struct _bench_refresh
+{
+    uint64_t cycles;
+    uint32_t port;
+    uint32_t traps;
+} bench_refresh_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Segment patterns of the original display_digit, bit 0 is segment A. */
+static const uint8_t s_segments[10] = {0x3FU, 0x05U, 0x5BU, 0x4FU, 0x65U, 0x6EU, 0x7EU, 0x07U, 0x7FU, 0x6FU};
+
+static const uint8_t s_segmentPins[7] = {DISPLAY_PIN_A, DISPLAY_PIN_B, DISPLAY_PIN_C, DISPLAY_PIN_D,
+                                         DISPLAY_PIN_E, DISPLAY_PIN_F, DISPLAY_PIN_G};
+
+static hostsim_gpio_model_t s_gpio;
+static bench_refresh_t s_log[BENCH_LOG_SIZE];
+static volatile uint32_t s_refreshes;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void SysTick_Handler(void)
+{
+    bench_refresh_t *entry = &s_log[s_refreshes % BENCH_LOG_SIZE];
+    hostsim_stats_t before;
+    hostsim_stats_t after;
+
+    HOSTSIM_GetStats(&before);
+    display_refresh();
+    HOSTSIM_GetStats(&after);
+
+    entry->cycles = HOSTSIM_GetCycles();
+    entry->traps  = after.trapCount - before.trapCount;
+    entry->port   = GPIO->PIN[DISPLAY_PORT];
+    s_refreshes++;
+}
+
+static uint32_t BENCH_DisplayMask(void)
+{
+    uint32_t mask = (1UL << DISPLAY_PIN_A1) | (1UL << DISPLAY_PIN_A2);
+    uint32_t i;
+
+    for (i = 0U; i < 7U; i++)
+    {
+        mask |= 1UL << s_segmentPins[i];
+    }
+
+    return mask;
+}
+
+/* Port value showing a number on one digit: lit segments low, the common of the digit high. */
+static uint32_t BENCH_Frame(uint32_t digit, uint32_t number)
+{
+    uint32_t frame = (digit == 0U) ? (1UL << DISPLAY_PIN_A1) : (1UL << DISPLAY_PIN_A2);
+    uint32_t i;
+
+    for (i = 0U; i < 7U; i++)
+    {
+        if ((s_segments[number] & (1U << i)) == 0U)
+        {
+            frame |= 1UL << s_segmentPins[i];
+        }
+    }
+
+    return frame;
+}
+
+/* Waits for refreshes while the main loop toggles a pin of the same port. */
+static uint32_t BENCH_Wait(uint32_t refreshes)
+{
+    uint32_t target  = s_refreshes + refreshes;
+    uint32_t toggles = 0U;
+
+    while ((int32_t)(s_refreshes - target) < 0)
+    {
+        GPIO_PortToggle(GPIO, DISPLAY_PORT, 1UL << BENCH_TOGGLE_PIN);
+        toggles++;
+        __WFI();
+    }
+
+    return toggles;
+}
+
+static bool BENCH_Entry(const bench_refresh_t *entry, uint32_t expected, uint32_t others)
+{
+    return (entry->traps == 1U) && ((entry->port & BENCH_DisplayMask()) == expected) &&
+           ((entry->port & (BENCH_OTHER_PINS & ~(1UL << BENCH_TOGGLE_PIN))) == others);
+}
+
+int main(void)
+{
+    gpio_pin_config_t out_config = {.pinDirection = kGPIO_DigitalOutput, .outputLogic = 1U};
+    uint32_t mask                = BENCH_DisplayMask();
+    uint32_t others              = BENCH_OTHER_PINS & ~(1UL << BENCH_TOGGLE_PIN);
+    uint32_t toggles             = 0U;
+    uint32_t first;
+    uint32_t index;
+    uint32_t value;
+    uint64_t cycles;
+    uint64_t period;
+    uint64_t interval;
+    uint64_t intervalMax = 0U;
+    uint32_t late        = 0U;
+    bool ok;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+    HOSTSIM_GpioModelInit(&s_gpio, GPIO);
+
+    /* Other pins of the port, high outputs. */
+    for (index = 0U; index < 32U; index++)
+    {
+        if ((BENCH_OTHER_PINS & (1UL << index)) != 0U)
+        {
+            GPIO_PinInit(GPIO, DISPLAY_PORT, index, &out_config);
+        }
+    }
+
+    display_init();
+    ok = ((GPIO->DIR[DISPLAY_PORT] & mask) == mask) && (GPIO->MASK[DISPLAY_PORT] == ~mask) &&
+         ((GPIO->PIN[DISPLAY_PORT] & BENCH_OTHER_PINS) == BENCH_OTHER_PINS);
+    (void)printf("init: display pins outputs, masked write limited to them          %s\r\n", ok ? "ok" : "FAILED");
+
+    /* Every number, the two refreshes after the next one show the tens and the units. */
+    ok = true;
+    for (value = 0U; value < 100U; value++)
+    {
+        display_set_value((uint8_t)value);
+        toggles += BENCH_Wait(1U);
+        first = s_refreshes;
+        toggles += BENCH_Wait(2U);
+        for (index = first; index < (first + 2U); index++)
+        {
+            /* The digits alternate from the first refresh on, digit 0 on the even ones. */
+            ok = ok && BENCH_Entry(&s_log[index % BENCH_LOG_SIZE],
+                                   BENCH_Frame(index % DISPLAY_DIGITS, ((index % DISPLAY_DIGITS) == 0U) ?
+                                                                           (value / 10U) :
+                                                                           (value % 10U)),
+                                   others);
+        }
+    }
+    ok = ok && (((GPIO->PIN[DISPLAY_PORT] >> BENCH_TOGGLE_PIN) & 1U) == (1U ^ (toggles & 1U)));
+    (void)printf("frames: 100 numbers, one masked write each, other pins untouched %s\r\n", ok ? "ok" : "FAILED");
+
+    /* A number over 99 is ignored. */
+    display_set_value(100U);
+    (void)BENCH_Wait(3U);
+    index = s_refreshes - 1U;
+    ok    = BENCH_Entry(&s_log[index % BENCH_LOG_SIZE], BENCH_Frame(index % DISPLAY_DIGITS, 9U), others);
+    (void)printf("range: 100 keeps showing 99                                      %s\r\n", ok ? "ok" : "FAILED");
+
+    /* Refresh timing from the SysTick period. */
+    period = SystemCoreClock / DISPLAY_TICK_HZ;
+    first  = s_refreshes;
+    (void)BENCH_Wait(BENCH_TIMING_TICKS);
+    for (index = first + 1U; index < (first + BENCH_TIMING_TICKS); index++)
+    {
+        interval    = s_log[index % BENCH_LOG_SIZE].cycles - s_log[(index - 1U) % BENCH_LOG_SIZE].cycles;
+        intervalMax = (interval > intervalMax) ? interval : intervalMax;
+        late += (interval > ((period * 3U) / 2U)) ? 1U : 0U;
+    }
+    cycles = s_log[(first + BENCH_TIMING_TICKS - 1U) % BENCH_LOG_SIZE].cycles - s_log[first % BENCH_LOG_SIZE].cycles;
+    interval = cycles / (BENCH_TIMING_TICKS - 1U);
+    ok = (interval * 100U >= period * (100U - BENCH_REFRESH_SLACK)) &&
+         (interval * 100U <= period * (100U + BENCH_REFRESH_SLACK)) && (late <= (BENCH_TIMING_TICKS / 100U));
+    (void)printf("timing: %u Hz per digit, refresh every %.2f ms (max %.2f ms, %u late)  %s\r\n",
+                 (unsigned int)(((uint64_t)SystemCoreClock / DISPLAY_DIGITS) / interval),
+                 ((double)interval * 1000.0) / (double)SystemCoreClock,
+                 ((double)intervalMax * 1000.0) / (double)SystemCoreClock, (unsigned int)late, ok ? "ok" : "FAILED");
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 # Add set(CONFIG_USE_CMSIS_DSP_Source true) in config.cmake to use this component
+# Add set(CONFIG_USE_CMSIS_DSP_CM0_FAST_Q15 true) as well to use the Cortex-M0 family kernels of the fast Q15 filters
 
 include_guard(GLOBAL)
 message("${CMAKE_CURRENT_LIST_FILE} component is included.")
@@ -42,6 +43,12 @@ message("${CMAKE_CURRENT_LIST_FILE} component is included.")
           ${CMAKE_CURRENT_LIST_DIR}/Source/DistanceFunctions
         )
 
+    if(CONFIG_USE_CMSIS_DSP_CM0_FAST_Q15)
+      target_compile_definitions(${MCUX_SDK_PROJECT_NAME} PUBLIC
+                  -DCMSIS_DSP_CM0_FAST_Q15
+              )
+    endif()
+
     if(CONFIG_USE_COMPONENT_CONFIGURATION)
   message("===>Import configuration from ${CMAKE_CURRENT_LIST_FILE}")
 
@@ -959,6 +959,44 @@ arm_status arm_fir_decimate_init_f32(
         uint32_t blockSize);
 
 
+  /**
+   * @brief Instance structure for the Q15 moving average filter.
+   */
+  typedef struct
+  {
+          uint16_t windowShift;       /**< log2 of the window length. */
+          uint16_t index;             /**< position of the oldest sample in the state buffer. */
+          q31_t sum;                  /**< sum of the samples in the window. */
+          q15_t *pState;              /**< points to the state variable array. The array is of length 2^windowShift. */
+  } arm_moving_average_instance_q15;
+
+  /**
+   * @brief Processing function for the Q15 moving average filter.
+   * @param[in,out] S          points to an instance of the Q15 moving average structure.
+   * @param[in]     pSrc       points to the block of input data.
+   * @param[out]    pDst       points to the block of output data.
+   * @param[in]     blockSize  number of samples to process.
+   */
+  void arm_moving_average_q15(
+        arm_moving_average_instance_q15 * S,
+  const q15_t * pSrc,
+        q15_t * pDst,
+        uint32_t blockSize);
+
+  /**
+   * @brief  Initialization function for the Q15 moving average filter.
+   * @param[in,out] S            points to an instance of the Q15 moving average structure.
+   * @param[in]     windowShift  log2 of the window length, 0 to 15.
+   * @param[in]     pState       points to the state buffer of 2^windowShift samples.
+   * @return    The function returns ARM_MATH_SUCCESS if initialization is successful or ARM_MATH_ARGUMENT_ERROR if
+   * <code>windowShift</code> is out of range.
+   */
+  arm_status arm_moving_average_init_q15(
+        arm_moving_average_instance_q15 * S,
+        uint16_t windowShift,
+        q15_t * pState);
+
+
   /**
    * @brief Processing function for the Q31 FIR decimator.
    * @param[in]  S     points to an instance of the Q31 FIR decimator structure.
@@ -130,6 +130,8 @@
 #include "arm_lms_norm_q31.c"
 #include "arm_lms_q15.c"
 #include "arm_lms_q31.c"
+#include "arm_moving_average_init_q15.c"
+#include "arm_moving_average_q15.c"
 
 #include "arm_levinson_durbin_f32.c"
 #include "arm_levinson_durbin_q31.c"
@@ -54,8 +54,113 @@
                    Refer to \ref arm_biquad_cascade_df1_q15() for a slower implementation of this function
                    which uses 64-bit accumulation to avoid wrap around distortion. Both the slow and the fast versions use the same instance structure.
                    Use the function \ref arm_biquad_cascade_df1_init_q15() to initialize the filter structure.
+
+  @par           Cortex-M0 family
+                   Built with <code>CMSIS_DSP_CM0_FAST_Q15</code> defined for a core without DSP extension, this
+                   function uses a kernel for the Cortex-M0 family instead of the generic C version.
+                   The outputs are bit exact with the generic C version as long as the coefficient after b0 is 0,
+                   as the coefficient layout requires. The coefficients and the state of a stage are kept in
+                   registers for the whole block and two samples are computed per pass, alternating the roles of
+                   the state variables instead of moving them.
  */
 
+#if defined (CMSIS_DSP_CM0_FAST_Q15) && !defined (ARM_MATH_DSP)
+
+ARM_DSP_ATTRIBUTE void arm_biquad_cascade_df1_fast_q15(
+  const arm_biquad_casd_df1_inst_q15 * S,
+  const q15_t * pSrc,
+        q15_t * pDst,
+        uint32_t blockSize)
+{
+  const q15_t *pIn = pSrc;                             /* Source pointer */
+        q15_t *pOut = pDst;                            /* Destination pointer */
+        q15_t *pState = S->pState;                     /* State pointer */
+  const q15_t *pCoeffs = S->pCoeffs;                   /* Coefficient pointer */
+        q31_t acc;                                     /* Accumulator */
+        q31_t b0, b1, b2, a1, a2;                      /* Filter coefficients */
+        q31_t Xn, Xn1, Xn2, Yn1, Yn2;                  /* Filter state variables */
+        int32_t shift = (int32_t) (15 - S->postShift); /* Post shift */
+        uint32_t sample, stage = S->numStages;         /* Loop counters */
+
+  do
+  {
+    /* Coefficients are stored as {b0, 0, b1, b2, a1, a2} */
+    b0 = pCoeffs[0];
+    b1 = pCoeffs[2];
+    b2 = pCoeffs[3];
+    a1 = pCoeffs[4];
+    a2 = pCoeffs[5];
+    pCoeffs += 6U;
+
+    /* State is stored as {x[n-1], x[n-2], y[n-1], y[n-2]} */
+    Xn1 = pState[0];
+    Xn2 = pState[1];
+    Yn1 = pState[2];
+    Yn2 = pState[3];
+
+    /* Compute 2 outputs at a time. The first output overwrites y[n-2] and the
+     * second one y[n-1], so after two samples the state is back in place. */
+    sample = blockSize >> 1U;
+
+    while (sample > 0U)
+    {
+      /* acc =  b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2] */
+      Xn = *pIn++;
+      acc = (b0 * Xn) + (b1 * Xn1) + (b2 * Xn2) + (a1 * Yn1) + (a2 * Yn2);
+
+      /* The result is converted from 3.29 to 1.31 and then saturation is applied */
+      Yn2 = __SSAT((acc >> shift), 16);
+      *pOut++ = (q15_t) Yn2;
+
+      /* x[n-1] of the second sample is Xn, x[n-2] is Xn1 */
+      Xn2 = *pIn++;
+      acc = (b0 * Xn2) + (b1 * Xn) + (b2 * Xn1) + (a1 * Yn2) + (a2 * Yn1);
+
+      Yn1 = __SSAT((acc >> shift), 16);
+      *pOut++ = (q15_t) Yn1;
+
+      /* Xn2 holds the newest sample: swap the input history back in place */
+      Xn1 = Xn2;
+      Xn2 = Xn;
+
+      /* Decrement loop counter */
+      sample--;
+    }
+
+    if ((blockSize & 0x1U) != 0U)
+    {
+      Xn = *pIn++;
+      acc = (b0 * Xn) + (b1 * Xn1) + (b2 * Xn2) + (a1 * Yn1) + (a2 * Yn2);
+
+      Yn2 = Yn1;
+      Yn1 = __SSAT((acc >> shift), 16);
+      *pOut++ = (q15_t) Yn1;
+
+      Xn2 = Xn1;
+      Xn1 = Xn;
+    }
+
+    /* The first stage goes from the input buffer to the output buffer. */
+    /* Subsequent (numStages - 1) occur in-place in the output buffer */
+    pIn = pDst;
+
+    /* Reset the output pointer */
+    pOut = pDst;
+
+    /* Store the updated state variables back into the state array */
+    *pState++ = (q15_t) Xn1;
+    *pState++ = (q15_t) Xn2;
+    *pState++ = (q15_t) Yn1;
+    *pState++ = (q15_t) Yn2;
+
+    /* Decrement loop counter */
+    stage--;
+
+  } while (stage > 0U);
+}
+
+#else
+
 ARM_DSP_ATTRIBUTE void arm_biquad_cascade_df1_fast_q15(
   const arm_biquad_casd_df1_inst_q15 * S,
   const q15_t * pSrc,
@@ -244,6 +349,8 @@ ARM_DSP_ATTRIBUTE void arm_biquad_cascade_df1_fast_q15(
   } while (stage > 0U);
 }
 
+#endif /* #if defined (CMSIS_DSP_CM0_FAST_Q15) && !defined (ARM_MATH_DSP) */
+
 /**
   @} end of BiquadCascadeDF1 group
  */
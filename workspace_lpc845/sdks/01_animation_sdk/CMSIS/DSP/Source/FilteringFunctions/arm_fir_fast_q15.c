@@ -54,8 +54,157 @@
   @remark
                    Refer to \ref arm_fir_q15() for a slower implementation of this function which uses 64-bit accumulation to avoid wrap around distortion.  Both the slow and the fast versions use the same instance structure.
                    Use function \ref arm_fir_init_q15() to initialize the filter structure.
+
+  @par           Cortex-M0 family
+                   Built with <code>CMSIS_DSP_CM0_FAST_Q15</code> defined for a core without DSP extension, this
+                   function uses a kernel for the Cortex-M0 family instead of the generic C version.
+                   The outputs are bit exact with the generic C version, they use the same 32-bit accumulator.
+                   No output wraps around as long as the sum of the absolute coefficient values stays below 2.0,
+                   for full scale input. Two outputs are computed per pass so each coefficient is loaded once for
+                   both, and <code>numTaps</code> equal to <code>CMSIS_DSP_CM0_FIR_TAPS</code> runs a fully unrolled tap loop.
+                   Any <code>numTaps</code> greater than 0 is accepted.
  */
 
+#if defined (CMSIS_DSP_CM0_FAST_Q15) && !defined (ARM_MATH_DSP)
+
+/* Tap count the kernel is unrolled for at compile time, other lengths run the same kernel with a loop.
+   0 disables the specialization. */
+#if !defined (CMSIS_DSP_CM0_FIR_TAPS)
+  #define CMSIS_DSP_CM0_FIR_TAPS 8U
+#endif
+
+/* acc0, acc1, x0, x1, c0 and the two pointers fit in the 8 low registers of the Cortex-M0.
+   Called with a constant numTaps the compiler unrolls the tap loop completely. */
+__STATIC_FORCEINLINE void arm_fir_fast_q15_cm0(
+  const q15_t * pState,
+  const q15_t * pCoeffs,
+        q15_t * pDst,
+        uint32_t blockSize,
+        uint32_t numTaps)
+{
+  const q15_t *px;                                     /* Temporary pointer for state buffer */
+  const q15_t *pb;                                     /* Temporary pointer for coefficient buffer */
+        q31_t acc0, acc1;                              /* Accumulators */
+        q31_t x0, x1, c0;                              /* Temporary variables to hold state and coefficient values */
+        uint32_t tapCnt, blkCnt;                       /* Loop counters */
+
+  /* Compute 2 outputs at a time, they share the coefficient loads:
+   *
+   *    acc0 =  b[numTaps-1] * x[n-numTaps+1] + ... + b[0] * x[n]
+   *    acc1 =  b[numTaps-1] * x[n-numTaps+2] + ... + b[0] * x[n+1]
+   */
+  blkCnt = blockSize >> 1U;
+
+  while (blkCnt > 0U)
+  {
+    acc0 = 0;
+    acc1 = 0;
+
+    px = pState;
+    pb = pCoeffs;
+
+    /* x0 is the sample of output 0, x1 the one of output 1 */
+    x0 = *px++;
+
+    tapCnt = numTaps;
+
+    while (tapCnt > 0U)
+    {
+      c0 = *pb++;
+      x1 = *px++;
+
+      acc0 += x0 * c0;
+      acc1 += x1 * c0;
+
+      /* The sample of output 1 is the next sample of output 0 */
+      x0 = x1;
+
+      tapCnt--;
+    }
+
+    /* The results are in 2.30 format. Convert to 1.15 with saturation. */
+    *pDst++ = (q15_t) (__SSAT((acc0 >> 15), 16));
+    *pDst++ = (q15_t) (__SSAT((acc1 >> 15), 16));
+
+    /* Advance the state pointer by 2 for the next 2 samples */
+    pState = pState + 2U;
+
+    blkCnt--;
+  }
+
+  if ((blockSize & 0x1U) != 0U)
+  {
+    acc0 = 0;
+
+    px = pState;
+    pb = pCoeffs;
+
+    tapCnt = numTaps;
+
+    while (tapCnt > 0U)
+    {
+      acc0 += (q31_t) *px++ * *pb++;
+
+      tapCnt--;
+    }
+
+    *pDst = (q15_t) (__SSAT((acc0 >> 15), 16));
+  }
+}
+
+ARM_DSP_ATTRIBUTE void arm_fir_fast_q15(
+  const arm_fir_instance_q15 * S,
+  const q15_t * pSrc,
+        q15_t * pDst,
+        uint32_t blockSize)
+{
+        q15_t *pState = S->pState;                     /* State pointer */
+        q15_t *pStateCurnt;                            /* Points to the current sample of the state */
+        uint32_t numTaps = S->numTaps;                 /* Number of filter coefficients in the filter */
+        uint32_t cnt;                                  /* Loop counter */
+
+  /* S->pState points to state array which contains previous frame (numTaps - 1) samples */
+  /* Append the new block behind them */
+  pStateCurnt = &(S->pState[(numTaps - 1U)]);
+
+  cnt = blockSize;
+
+  while (cnt > 0U)
+  {
+    *pStateCurnt++ = *pSrc++;
+
+    cnt--;
+  }
+
+#if (CMSIS_DSP_CM0_FIR_TAPS > 0U)
+  if (numTaps == CMSIS_DSP_CM0_FIR_TAPS)
+  {
+    arm_fir_fast_q15_cm0(pState, S->pCoeffs, pDst, blockSize, CMSIS_DSP_CM0_FIR_TAPS);
+  }
+  else
+#endif
+  {
+    arm_fir_fast_q15_cm0(pState, S->pCoeffs, pDst, blockSize, numTaps);
+  }
+
+  /* Processing is complete.
+     Now copy the last numTaps - 1 samples to the start of the state buffer.
+     This prepares the state buffer for the next function call. */
+  pStateCurnt = S->pState;
+  pState = pState + blockSize;
+
+  cnt = numTaps - 1U;
+
+  while (cnt > 0U)
+  {
+    *pStateCurnt++ = *pState++;
+
+    cnt--;
+  }
+}
+
+#else
+
 ARM_DSP_ATTRIBUTE void arm_fir_fast_q15(
   const arm_fir_instance_q15 * S,
   const q15_t * pSrc,
@@ -326,6 +475,8 @@ ARM_DSP_ATTRIBUTE void arm_fir_fast_q15(
 
 }
 
+#endif /* #if defined (CMSIS_DSP_CM0_FAST_Q15) && !defined (ARM_MATH_DSP) */
+
 /**
   @} end of FIR group
  */
@@ -0,0 +1,72 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_moving_average_init_q15.c
+ * Description:  Q15 moving average filter initialization function
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dsp/filtering_functions.h"
+
+/**
+  @ingroup groupFilters
+ */
+
+/**
+  @addtogroup MovingAverage
+  @{
+ */
+
+/**
+  @brief         Initialization function for the Q15 moving average filter.
+  @param[in,out] S            points to an instance of the Q15 moving average structure.
+  @param[in]     windowShift  log2 of the window length, 0 to 15.
+  @param[in]     pState       points to the state buffer of 2^windowShift samples.
+  @return        execution status
+                   - \ref ARM_MATH_SUCCESS        : Operation successful
+                   - \ref ARM_MATH_ARGUMENT_ERROR : <code>windowShift</code> is greater than 15
+ */
+ARM_DSP_ATTRIBUTE arm_status arm_moving_average_init_q15(
+        arm_moving_average_instance_q15 * S,
+        uint16_t windowShift,
+        q15_t * pState)
+{
+  /* A longer window could overflow the 32-bit sum */
+  if (windowShift > 15U)
+  {
+    return (ARM_MATH_ARGUMENT_ERROR);
+  }
+
+  /* Assign window length */
+  S->windowShift = windowShift;
+
+  /* Clear state buffer, the window starts filled with zeros */
+  memset(pState, 0, (1UL << windowShift) * sizeof(q15_t));
+
+  /* Assign state pointer */
+  S->pState = pState;
+
+  S->index = 0U;
+  S->sum = 0;
+
+  return (ARM_MATH_SUCCESS);
+}
+
+/**
+  @} end of MovingAverage group
+ */
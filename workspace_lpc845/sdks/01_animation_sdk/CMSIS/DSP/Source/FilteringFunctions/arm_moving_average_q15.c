@@ -0,0 +1,129 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_moving_average_q15.c
+ * Description:  Q15 moving average filter processing function
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dsp/filtering_functions.h"
+
+/**
+  @ingroup groupFilters
+ */
+
+/**
+  @defgroup MovingAverage Moving Average Filter
+
+  Mean of the last 2^windowShift input samples.
+
+  The filter keeps the sum of the window and updates it with the incoming and the
+  outgoing sample, so the cost per sample does not depend on the window length.
+  It gives the same result as summing the whole window for every output.
+
+  @par           Instance Structure
+                   The state buffer holds the 2^windowShift samples of the window.
+                   Use \ref arm_moving_average_init_q15() to initialize the structure,
+                   it clears the window.
+ */
+
+/**
+  @addtogroup MovingAverage
+  @{
+ */
+
+/**
+  @brief         Processing function for the Q15 moving average filter.
+  @param[in,out] S          points to an instance of the Q15 moving average structure
+  @param[in]     pSrc       points to the block of input data
+  @param[out]    pDst       points to the block of output data
+  @param[in]     blockSize  number of samples to process
+
+  @par           Scaling and Overflow Behavior
+                   The window is summed in a 32-bit accumulator, 2^15 windows of 1.15 samples
+                   fit in it without overflow. The sum is shifted right by <code>windowShift</code>,
+                   which truncates towards minus infinity, so the result never needs saturation.
+ */
+ARM_DSP_ATTRIBUTE void arm_moving_average_q15(
+        arm_moving_average_instance_q15 * S,
+  const q15_t * pSrc,
+        q15_t * pDst,
+        uint32_t blockSize)
+{
+        q15_t *pState = S->pState;                     /* State pointer */
+        q31_t sum = S->sum;                            /* Sum of the window */
+        q31_t in;                                      /* Temporary variable to hold input value */
+        uint32_t shift = S->windowShift;               /* Window length in bits */
+        uint32_t mask = (1UL << shift) - 1U;           /* Window index mask */
+        uint32_t index = S->index;                     /* Position of the oldest sample */
+        uint32_t blkCnt;                               /* Loop counter */
+
+#if defined (ARM_MATH_LOOPUNROLL)
+
+  /* Loop unrolling: Compute 2 outputs at a time */
+  blkCnt = blockSize >> 1U;
+
+  while (blkCnt > 0U)
+  {
+    /* The incoming sample replaces the oldest one */
+    in = *pSrc++;
+    sum += in - pState[index];
+    pState[index] = (q15_t) in;
+    index = (index + 1U) & mask;
+    *pDst++ = (q15_t) (sum >> shift);
+
+    in = *pSrc++;
+    sum += in - pState[index];
+    pState[index] = (q15_t) in;
+    index = (index + 1U) & mask;
+    *pDst++ = (q15_t) (sum >> shift);
+
+    /* Decrement loop counter */
+    blkCnt--;
+  }
+
+  /* Loop unrolling: Compute remaining outputs */
+  blkCnt = blockSize & 0x1U;
+
+#else
+
+  /* Initialize blkCnt with number of samples */
+  blkCnt = blockSize;
+
+#endif /* #if defined (ARM_MATH_LOOPUNROLL) */
+
+  while (blkCnt > 0U)
+  {
+    in = *pSrc++;
+    sum += in - pState[index];
+    pState[index] = (q15_t) in;
+    index = (index + 1U) & mask;
+    *pDst++ = (q15_t) (sum >> shift);
+
+    /* Decrement loop counter */
+    blkCnt--;
+  }
+
+  /* Store the window position and sum for the next call */
+  S->sum = sum;
+  S->index = (uint16_t) index;
+}
+
+/**
+  @} end of MovingAverage group
+ */
@@ -64,17 +64,27 @@ static void KernelUnblock (void) {
 
 // Get Kernel sleep time
 static uint32_t GetKernelSleepTime (void) {
+#if defined(RTX_THREAD_WATCHDOG) || !defined(RTX_DELAY_WHEEL)
   const os_thread_t *thread;
+#endif
+#ifdef RTX_DELAY_WHEEL
+  uint32_t           ticks;
+#else
   const os_timer_t  *timer;
+#endif
   uint32_t           delay;
 
   delay = osWaitForever;
 
   // Check Thread Delay list
+#ifdef RTX_DELAY_WHEEL
+  delay = osRtxThreadDelaySleep();
+#else
   thread = osRtxInfo.thread.delay_list;
   if (thread != NULL) {
     delay = thread->delay;
   }
+#endif
 
 #ifdef RTX_THREAD_WATCHDOG
   // Check Thread Watchdog list
@@ -87,12 +97,21 @@ static uint32_t GetKernelSleepTime (void) {
 #endif
 
   // Check Active Timer list
+#ifdef RTX_DELAY_WHEEL
+  if (osRtxInfo.timer.tick != NULL) {
+    ticks = osRtxTimerSleep();
+    if (ticks < delay) {
+      delay = ticks;
+    }
+  }
+#else
   timer = osRtxInfo.timer.list;
   if (timer != NULL) {
     if (timer->tick < delay) {
       delay = timer->tick;
     }
   }
+#endif
 
   return delay;
 }
@@ -424,8 +443,12 @@ static uint32_t svcRtxKernelSuspend (void) {
 /// Resume the RTOS Kernel scheduler.
 /// \note API identical to osKernelResume
 static void svcRtxKernelResume (uint32_t sleep_ticks) {
+#if defined(RTX_THREAD_WATCHDOG) || !defined(RTX_DELAY_WHEEL)
   os_thread_t *thread;
+#endif
+#ifndef RTX_DELAY_WHEEL
   os_timer_t  *timer;
+#endif
   uint32_t     delay;
   uint32_t     ticks, kernel_tick;
 
@@ -442,6 +465,13 @@ static void svcRtxKernelResume (uint32_t sleep_ticks) {
     ticks = sleep_ticks;
   }
 
+#ifdef RTX_DELAY_WHEEL
+  // Skip Thread Delay and Timer sleep ticks
+  osRtxThreadDelaySkip(ticks);
+  if (osRtxInfo.timer.tick != NULL) {
+    osRtxTimerSkip(ticks);
+  }
+#else
   // Update Thread Delay sleep ticks
   thread = osRtxInfo.thread.delay_list;
   if (thread != NULL) {
@@ -453,6 +483,7 @@ static void svcRtxKernelResume (uint32_t sleep_ticks) {
   if (timer != NULL) {
     timer->tick -= ticks;
   }
+#endif
 
 #ifdef RTX_THREAD_WATCHDOG
   // Update Thread Watchdog sleep ticks
@@ -604,9 +635,9 @@ static osStatus_t svcRtxKernelDestroyClass (uint32_t safety_class, uint32_t mode
   }
 
   // Threads in Delay List
-  thread = osRtxInfo.thread.delay_list;
+  thread = osRtxThreadDelayFirst();
   while (thread != NULL) {
-    thread_next = thread->delay_next;
+    thread_next = osRtxThreadDelayNext(thread);
     if ((((mode & osSafetyWithSameClass)  != 0U) &&
          ((thread->attr >> osRtxAttrClass_Pos) == (uint8_t)safety_class)) ||
         (((mode & osSafetyWithLowerClass) != 0U) &&
@@ -52,6 +52,14 @@
 #define os_message_queue_t  osRtxMessageQueue_t
 #define os_object_t         osRtxObject_t
 
+#ifdef RTX_DELAY_WHEEL
+// Delay wheel: levels of slots by expiry Tick and one overflow slot
+#define osRtxWheelBits      4U
+#define osRtxWheelSize      (1U << osRtxWheelBits)
+#define osRtxWheelLevels    4U
+#define osRtxWheelSlots     ((osRtxWheelLevels << osRtxWheelBits) + 1U)
+#endif
+
 
 //  ==== Library sections ====
 
@@ -237,6 +245,49 @@ __STATIC_INLINE void osRtxThreadSetRunning (os_thread_t *thread) {
   osRtxInfo.thread.run.curr = thread;
 }
 
+#ifdef RTX_DELAY_WHEEL
+// Delay wheel Slot of expiry Tick
+__STATIC_INLINE uint32_t osRtxWheelSlot (uint32_t tick, uint32_t expiry) {
+  uint32_t delta = expiry - tick;
+  uint32_t level = 0U;
+  uint32_t slot;
+
+  while ((level < osRtxWheelLevels) && (delta >= osRtxWheelSize)) {
+    delta >>= osRtxWheelBits;
+    level++;
+  }
+  slot = level << osRtxWheelBits;
+  if (level < osRtxWheelLevels) {
+    slot += (expiry >> (level * osRtxWheelBits)) & (osRtxWheelSize - 1U);
+  }
+  return slot;
+}
+
+// Delay wheel Slot to cascade at Tick (level 1..osRtxWheelLevels), osRtxWheelSlots if none
+__STATIC_INLINE uint32_t osRtxWheelCascade (uint32_t tick, uint32_t level) {
+  uint32_t slot;
+
+  if ((level > osRtxWheelLevels) ||
+      ((tick & ((1U << (level * osRtxWheelBits)) - 1U)) != 0U)) {
+    slot = osRtxWheelSlots;
+  } else {
+    slot = level << osRtxWheelBits;
+    if (level < osRtxWheelLevels) {
+      slot += (tick >> (level * osRtxWheelBits)) & (osRtxWheelSize - 1U);
+    }
+  }
+  return slot;
+}
+#else
+// Thread Delay list First/Next
+__STATIC_INLINE os_thread_t *osRtxThreadDelayFirst (void) {
+  return osRtxInfo.thread.delay_list;
+}
+__STATIC_INLINE os_thread_t *osRtxThreadDelayNext (const os_thread_t *thread) {
+  return thread->delay_next;
+}
+#endif
+
 
 //  ==== Library functions ====
 
@@ -253,6 +304,12 @@ extern void         osRtxThreadReadyPut    (os_thread_t *thread);
 //lint -esym(765,osRtxThreadDelayRemove)    "Global scope"
 extern void         osRtxThreadDelayRemove (os_thread_t *thread);
 extern void         osRtxThreadDelayTick   (void);
+#ifdef RTX_DELAY_WHEEL
+extern os_thread_t *osRtxThreadDelayFirst  (void);
+extern os_thread_t *osRtxThreadDelayNext   (const os_thread_t *thread);
+extern uint32_t     osRtxThreadDelaySleep  (void);
+extern void         osRtxThreadDelaySkip   (uint32_t ticks);
+#endif
 extern uint32_t    *osRtxThreadRegPtr      (const os_thread_t *thread);
 extern void         osRtxThreadSwitch      (os_thread_t *thread);
 extern void         osRtxThreadDispatch    (os_thread_t *thread);
@@ -279,6 +336,10 @@ extern bool_t       osRtxThreadStartup     (void);
 // Timer Library functions
 extern int32_t osRtxTimerSetup       (void);
 extern void    osRtxTimerThread      (void *argument);
+#ifdef RTX_DELAY_WHEEL
+extern uint32_t osRtxTimerSleep      (void);
+extern void    osRtxTimerSkip        (uint32_t ticks);
+#endif
 #ifdef RTX_SAFETY_CLASS
 extern void    osRtxTimerDeleteClass (uint32_t safety_class, uint32_t mode);
 #endif
@@ -0,0 +1,471 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Project:     CMSIS-RTOS RTX
+ * Title:       Memory functions, Two-Level Segregated Fit allocator
+ *
+ * Replaces the weak first-fit functions of rtx_memory.c when OS_MEMORY_TLSF
+ * is enabled. Free blocks are kept in segregated lists, a first level per
+ * power of two and MEM_SL_COUNT second level lists in between, found with
+ * two bitmaps. Allocation looks at up to MEM_FIT_SCAN blocks of the list of
+ * the size before it splits a bigger block, allocation and free take bounded
+ * time.
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtx_lib.h"
+
+#ifdef RTX_MEMORY_TLSF
+
+
+//  Memory Pool Header structure
+//  followed by the second level bitmaps (uint8_t, padded to 8 bytes)
+//  and the free list heads (uint32_t, fl_count * MEM_SL_COUNT)
+typedef struct {
+  uint32_t size;                // Memory Pool size
+  uint32_t used;                // Used Memory
+  uint32_t fl_map;              // First level bitmap of non-empty free lists
+  uint32_t fl_count;            // Number of first level lists
+} mem_head_t;
+
+//  Memory Block Header structure
+typedef struct {
+  uint32_t prev;                // Offset of previous Memory Block (0 for the first block)
+  uint32_t info;                // Block Info or max used Memory (in last block)
+} mem_block_t;
+
+//  Free Memory Block structure
+typedef struct {
+  mem_block_t head;             // Memory Block Header
+  uint32_t    next_free;        // Offset of next free Memory Block in list (0 for none)
+  uint32_t    prev_free;        // Offset of previous free Memory Block in list (0 for none)
+} mem_free_t;
+
+//  Memory Block Info: Length = <31:3>:'000', Free = <2>, Type = <1:0>
+#define MB_INFO_LEN_MASK        0xFFFFFFF8U     // Length mask
+#define MB_INFO_FREE            0x00000004U     // Free flag
+#define MB_INFO_TYPE_MASK       0x00000003U     // Type mask
+
+//  Free lists: first level by highest bit of the size, MEM_SL_COUNT second level lists each
+#define MEM_ALIGN_BITS          3U
+#define MEM_SL_BITS             3U
+#define MEM_SL_COUNT            (1U << MEM_SL_BITS)
+#define MEM_SMALL_SIZE          (1U << (MEM_SL_BITS + MEM_ALIGN_BITS))  // Sizes below in first level 0
+#define MEM_BLOCK_MIN           ((uint32_t)sizeof(mem_free_t))          // Free block with list links
+#define MEM_FIT_SCAN            4U      // Blocks of the list of the size itself checked first
+
+#if ((defined(__ARM_ARCH_6M__)      && (__ARM_ARCH_6M__      != 0)) || \
+     (defined(__ARM_ARCH_8M_BASE__) && (__ARM_ARCH_8M_BASE__ != 0)))
+//  Bit number of an isolated bit by De Bruijn multiplication
+static const uint8_t MemDeBruijnBit[32] = {
+   0U,  1U, 28U,  2U, 29U, 14U, 24U,  3U, 30U, 22U, 20U, 15U, 25U, 17U,  4U,  8U,
+  31U, 27U, 13U, 23U, 21U, 19U, 16U,  7U, 26U, 12U, 18U,  6U, 11U,  5U, 10U,  9U
+};
+#endif
+
+//  Memory Head Pointer
+__STATIC_INLINE mem_head_t *MemHeadPtr (void *mem) {
+  //lint -e{9079} -e{9087} "conversion from pointer to void to pointer to other type" [MISRA Note 6]
+  return ((mem_head_t *)mem);
+}
+
+//  Memory Block Pointer
+__STATIC_INLINE mem_block_t *MemBlockPtr (void *mem, uint32_t offset) {
+  //lint -e{9079} -e{9087} "cast between pointers to different object types"
+  return ((mem_block_t *)(void *)((uint8_t *)mem + offset));
+}
+
+//  Free Memory Block Pointer
+__STATIC_INLINE mem_free_t *MemFreePtr (void *mem, uint32_t offset) {
+  //lint -e{9079} -e{9087} "cast between pointers to different object types"
+  return ((mem_free_t *)(void *)((uint8_t *)mem + offset));
+}
+
+//  Second level bitmap of a first level list
+__STATIC_INLINE uint8_t *MemSlMap (void *mem, uint32_t fl) {
+  return ((uint8_t *)mem + sizeof(mem_head_t) + fl);
+}
+
+//  Free list head of a first and second level list
+__STATIC_INLINE uint32_t *MemFreeList (void *mem, uint32_t fl, uint32_t sl) {
+  uint32_t offset;
+
+  offset = sizeof(mem_head_t) + ((MemHeadPtr(mem)->fl_count + 7U) & ~7U);
+  //lint -e{9079} -e{9087} "cast between pointers to different object types"
+  return ((uint32_t *)(void *)((uint8_t *)mem + offset) + ((fl * MEM_SL_COUNT) + sl));
+}
+
+//  Offset of the first Memory Block, behind the free lists
+__STATIC_INLINE uint32_t MemBlockFirst (void *mem) {
+  uint32_t fl_count = MemHeadPtr(mem)->fl_count;
+
+  return (sizeof(mem_head_t) + ((fl_count + 7U) & ~7U) + (fl_count * MEM_SL_COUNT * 4U));
+}
+
+
+//  ==== Helper functions ====
+
+/// Get number of the lowest set bit.
+/// \param[in]  value           non-zero value.
+/// \return bit number.
+static uint32_t MemLowestBit (uint32_t value) {
+#if ((defined(__ARM_ARCH_6M__)      && (__ARM_ARCH_6M__      != 0)) || \
+     (defined(__ARM_ARCH_8M_BASE__) && (__ARM_ARCH_8M_BASE__ != 0)))
+  // No CLZ instruction, De Bruijn multiplication of the isolated bit
+  return MemDeBruijnBit[((value & (0U - value)) * 0x077CB531U) >> 27];
+#else
+  return (uint32_t)__CLZ(__RBIT(value));
+#endif
+}
+
+/// Get number of the highest set bit.
+/// \param[in]  value           non-zero value.
+/// \return bit number.
+static uint32_t MemHighestBit (uint32_t value) {
+#if ((defined(__ARM_ARCH_6M__)      && (__ARM_ARCH_6M__      != 0)) || \
+     (defined(__ARM_ARCH_8M_BASE__) && (__ARM_ARCH_8M_BASE__ != 0)))
+  // No CLZ instruction, set all bits below the highest one and isolate it
+  value |= value >> 1;
+  value |= value >> 2;
+  value |= value >> 4;
+  value |= value >> 8;
+  value |= value >> 16;
+  return MemDeBruijnBit[((value ^ (value >> 1)) * 0x077CB531U) >> 27];
+#else
+  return (31U - (uint32_t)__CLZ(value));
+#endif
+}
+
+/// Get free list of a block size.
+/// \param[in]  size            block size.
+/// \param[out] fl              first level list.
+/// \param[out] sl              second level list.
+static void MemMapping (uint32_t size, uint32_t *fl, uint32_t *sl) {
+  uint32_t bit;
+
+  if (size < MEM_SMALL_SIZE) {
+    *fl = 0U;
+    *sl = size >> MEM_ALIGN_BITS;
+  } else {
+    bit = MemHighestBit(size);
+    *fl = (bit - (MEM_SL_BITS + MEM_ALIGN_BITS)) + 1U;
+    *sl = (size >> (bit - MEM_SL_BITS)) & (MEM_SL_COUNT - 1U);
+  }
+}
+
+/// Put a free Memory Block at the head of its free list.
+/// \param[in]  mem             pointer to memory pool.
+/// \param[in]  offset          block offset.
+static void MemFreePut (void *mem, uint32_t offset) {
+  mem_free_t *block;
+  uint32_t   *list;
+  uint32_t    fl, sl;
+
+  block = MemFreePtr(mem, offset);
+  MemMapping(block->head.info & MB_INFO_LEN_MASK, &fl, &sl);
+  list = MemFreeList(mem, fl, sl);
+
+  block->next_free = *list;
+  block->prev_free = 0U;
+  if (*list != 0U) {
+    MemFreePtr(mem, *list)->prev_free = offset;
+  }
+  *list = offset;
+
+  *MemSlMap(mem, fl) |= (uint8_t)(1U << sl);
+  MemHeadPtr(mem)->fl_map |= 1U << fl;
+}
+
+/// Take a free Memory Block out of its free list.
+/// \param[in]  mem             pointer to memory pool.
+/// \param[in]  offset          block offset.
+static void MemFreeTake (void *mem, uint32_t offset) {
+  const mem_free_t *block;
+  uint32_t         *list;
+  uint32_t          fl, sl;
+
+  block = MemFreePtr(mem, offset);
+  if (block->next_free != 0U) {
+    MemFreePtr(mem, block->next_free)->prev_free = block->prev_free;
+  }
+  if (block->prev_free != 0U) {
+    MemFreePtr(mem, block->prev_free)->next_free = block->next_free;
+  } else {
+    MemMapping(block->head.info & MB_INFO_LEN_MASK, &fl, &sl);
+    list  = MemFreeList(mem, fl, sl);
+    *list = block->next_free;
+    if (*list == 0U) {
+      *MemSlMap(mem, fl) &= (uint8_t)~(1U << sl);
+      if (*MemSlMap(mem, fl) == 0U) {
+        MemHeadPtr(mem)->fl_map &= ~(1U << fl);
+      }
+    }
+  }
+}
+
+/// Find a free Memory Block big enough for a block size.
+/// \param[in]  mem             pointer to memory pool.
+/// \param[in]  size            block size.
+/// \return block offset or 0 if none is available.
+static uint32_t MemFreeFind (void *mem, uint32_t size) {
+  const mem_head_t *head;
+  uint32_t          fl, sl, map;
+  uint32_t          offset;
+  uint32_t          n;
+
+  head = MemHeadPtr(mem);
+
+  // A block of the list of the size itself is the closest fit, look at its first
+  // MEM_FIT_SCAN blocks to keep the time bounded before a bigger block is split
+  MemMapping(size, &fl, &sl);
+  if (fl < head->fl_count) {
+    offset = *MemFreeList(mem, fl, sl);
+    for (n = 1U; (offset != 0U) && ((MemBlockPtr(mem, offset)->info & MB_INFO_LEN_MASK) < size); n++) {
+      offset = (n < MEM_FIT_SCAN) ? MemFreePtr(mem, offset)->next_free : 0U;
+    }
+    if (offset != 0U) {
+      //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+      return offset;
+    }
+  }
+
+  // Round up to the next list, all blocks in it are big enough
+  if (size >= MEM_SMALL_SIZE) {
+    MemMapping(size + ((1U << (MemHighestBit(size) - MEM_SL_BITS)) - 1U), &fl, &sl);
+  } else {
+    MemMapping(size, &fl, &sl);
+  }
+
+  // Search the second level lists of the first level, then the next first level list
+  map = 0U;
+  if (fl < head->fl_count) {
+    map = (uint32_t)*MemSlMap(mem, fl) & (0xFFFFFFFFU << sl);
+  }
+  if (map == 0U) {
+    map = head->fl_map & ~((2U << fl) - 1U);
+    if (map == 0U) {
+      //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+      return 0U;
+    }
+    fl  = MemLowestBit(map);
+    map = *MemSlMap(mem, fl);
+  }
+  sl = MemLowestBit(map);
+
+  return *MemFreeList(mem, fl, sl);
+}
+
+
+//  ==== Library functions ====
+
+/// Initialize Memory Pool with variable block size.
+/// \param[in]  mem             pointer to memory pool.
+/// \param[in]  size            size of a memory pool in bytes.
+/// \return 1 - success, 0 - failure.
+uint32_t osRtxMemoryInit (void *mem, uint32_t size) {
+  mem_head_t  *head;
+  mem_block_t *ptr;
+  uint32_t    *list;
+  uint32_t     offset;
+
+  // Check parameters
+  //lint -e{923} "cast from pointer to unsigned int" [MISRA Note 7]
+  if ((mem == NULL) || (((uint32_t)mem & 7U) != 0U) || ((size & 7U) != 0U) ||
+      (size < MEM_SMALL_SIZE)) {
+    EvrRtxMemoryInit(mem, size, 0U);
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return 0U;
+  }
+
+  // First level lists up to the one of the pool size
+  head = MemHeadPtr(mem);
+  head->fl_count = (MemHighestBit(size) - (MEM_SL_BITS + MEM_ALIGN_BITS)) + 2U;
+  offset = MemBlockFirst(mem);
+  if (size < (offset + MEM_BLOCK_MIN + sizeof(mem_block_t))) {
+    EvrRtxMemoryInit(mem, size, 0U);
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return 0U;
+  }
+
+  // Initialize memory pool header, bitmaps and free lists
+  head->size   = size;
+  head->used   = offset + sizeof(mem_block_t);
+  head->fl_map = 0U;
+  //lint -e{9079} -e{9087} "cast between pointers to different object types"
+  for (list = (uint32_t *)(void *)MemSlMap(mem, 0U); list < (uint32_t *)(void *)MemBlockPtr(mem, offset); list++) {
+    *list = 0U;
+  }
+
+  // Initialize first and last block header, the first block is free
+  ptr = MemBlockPtr(mem, offset);
+  ptr->prev = 0U;
+  ptr->info = (size - offset - sizeof(mem_block_t)) | MB_INFO_FREE;
+  ptr = MemBlockPtr(mem, size - sizeof(mem_block_t));
+  ptr->prev = offset;
+  ptr->info = head->used;
+  MemFreePut(mem, offset);
+
+  EvrRtxMemoryInit(mem, size, 1U);
+
+  return 1U;
+}
+
+/// Allocate a memory block from a Memory Pool.
+/// \param[in]  mem             pointer to memory pool.
+/// \param[in]  size            size of a memory block in bytes.
+/// \param[in]  type            memory block type: 0 - generic, 1 - control block
+/// \return allocated memory block or NULL in case of no memory is available.
+void *osRtxMemoryAlloc (void *mem, uint32_t size, uint32_t type) {
+  mem_head_t  *head;
+  mem_block_t *ptr;
+  mem_block_t *p, *p_new;
+  uint32_t     block_size;
+  uint32_t     hole_size;
+  uint32_t     offset;
+
+  // Check parameters
+  if ((mem == NULL) || (size == 0U) || ((type & ~MB_INFO_TYPE_MASK) != 0U) ||
+      (size > MemHeadPtr(mem)->size)) {
+    EvrRtxMemoryAlloc(mem, size, type, NULL);
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return NULL;
+  }
+  head = MemHeadPtr(mem);
+
+  // Add block header to size
+  block_size = size + sizeof(mem_block_t);
+  // Make sure that block is 8-byte aligned and holds the free list links when freed
+  block_size = (block_size + 7U) & ~((uint32_t)7U);
+  if (block_size < MEM_BLOCK_MIN) {
+    block_size = MEM_BLOCK_MIN;
+  }
+
+  // Search for free block big enough
+  offset = MemFreeFind(mem, block_size);
+  if (offset == 0U) {
+    // Failed (no free block)
+    EvrRtxMemoryAlloc(mem, size, type, NULL);
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return NULL;
+  }
+  MemFreeTake(mem, offset);
+  p = MemBlockPtr(mem, offset);
+  hole_size = p->info & MB_INFO_LEN_MASK;
+
+  // Split off the rest as a free block if it holds one
+  if ((hole_size - block_size) >= MEM_BLOCK_MIN) {
+    p_new = MemBlockPtr(mem, offset + block_size);
+    p_new->prev = offset;
+    p_new->info = (hole_size - block_size) | MB_INFO_FREE;
+    MemBlockPtr(mem, offset + hole_size)->prev = offset + block_size;
+    MemFreePut(mem, offset + block_size);
+  } else {
+    block_size = hole_size;
+  }
+  p->info = block_size | type;
+
+  // Update used memory
+  head->used += block_size;
+
+  // Update max used memory
+  p_new = MemBlockPtr(mem, head->size - sizeof(mem_block_t));
+  if (p_new->info < head->used) {
+    p_new->info = head->used;
+  }
+
+  ptr = MemBlockPtr(mem, offset + sizeof(mem_block_t));
+
+  EvrRtxMemoryAlloc(mem, size, type, ptr);
+
+  return ptr;
+}
+
+/// Return an allocated memory block back to a Memory Pool.
+/// \param[in]  mem             pointer to memory pool.
+/// \param[in]  block           memory block to be returned to the memory pool.
+/// \return 1 - success, 0 - failure.
+uint32_t osRtxMemoryFree (void *mem, void *block) {
+  mem_head_t  *head;
+  mem_block_t *p, *p_next, *p_prev;
+  uint32_t     offset, last;
+  uint32_t     block_size;
+
+  // Check parameters
+  if ((mem == NULL) || (block == NULL)) {
+    EvrRtxMemoryFree(mem, block, 0U);
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return 0U;
+  }
+  head = MemHeadPtr(mem);
+
+  // Memory block header, inside the pool and allocated (no list walk, checked by its neighbour)
+  offset = (uint32_t)((uint8_t *)block - (uint8_t *)mem) - sizeof(mem_block_t);
+  last   = head->size - sizeof(mem_block_t);
+  if ((offset < MemBlockFirst(mem)) || (offset >= last) || ((offset & 7U) != 0U)) {
+    // Not found
+    EvrRtxMemoryFree(mem, block, 0U);
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return 0U;
+  }
+  p = MemBlockPtr(mem, offset);
+  block_size = p->info & MB_INFO_LEN_MASK;
+  if (((p->info & MB_INFO_FREE) != 0U) || (block_size == 0U) || (block_size > (last - offset)) ||
+      (MemBlockPtr(mem, offset + block_size)->prev != offset)) {
+    // Not found (or already free)
+    EvrRtxMemoryFree(mem, block, 0U);
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return 0U;
+  }
+
+  // Update used memory
+  head->used -= block_size;
+
+  // Mark block free, the header stays marked if it is merged into the previous block
+  p->info |= MB_INFO_FREE;
+
+  // Merge with next block if free
+  if ((offset + block_size) != last) {
+    p_next = MemBlockPtr(mem, offset + block_size);
+    if ((p_next->info & MB_INFO_FREE) != 0U) {
+      MemFreeTake(mem, offset + block_size);
+      block_size += p_next->info & MB_INFO_LEN_MASK;
+    }
+  }
+
+  // Merge with previous block if free
+  if (p->prev != 0U) {
+    p_prev = MemBlockPtr(mem, p->prev);
+    if ((p_prev->info & MB_INFO_FREE) != 0U) {
+      MemFreeTake(mem, p->prev);
+      block_size += p_prev->info & MB_INFO_LEN_MASK;
+      offset = p->prev;
+      p = p_prev;
+    }
+  }
+
+  // Free block
+  p->info = block_size | MB_INFO_FREE;
+  MemBlockPtr(mem, offset + block_size)->prev = offset;
+  MemFreePut(mem, offset);
+
+  EvrRtxMemoryFree(mem, block, 1U);
+
+  return 1U;
+}
+
+#endif  // RTX_MEMORY_TLSF
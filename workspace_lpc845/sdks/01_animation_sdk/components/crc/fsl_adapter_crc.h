@@ -21,6 +21,56 @@
 *************************************************************************************
 ***********************************************************************************/
 
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/*
+ * @brief   Enable the 16-entry (nibble) lookup tables of the software CRC adapter.
+ * Costs 128 bytes of flash per enabled polynomial.
+ */
+#ifndef HAL_CRC_NIBBLE_TABLE_ENABLE
+#define HAL_CRC_NIBBLE_TABLE_ENABLE (1U)
+#endif
+
+/*
+ * @brief   Enable the 256-entry (byte) lookup tables of the software CRC adapter.
+ * Costs 2 Kbytes of flash per enabled polynomial.
+ */
+#ifndef HAL_CRC_BYTE_TABLE_ENABLE
+#define HAL_CRC_BYTE_TABLE_ENABLE (0U)
+#endif
+
+/*
+ * @brief   Enable the slice-by-4 lookup tables of the software CRC adapter.
+ * Costs 8 Kbytes of flash per enabled polynomial, the byte tables are included.
+ */
+#ifndef HAL_CRC_SLICE4_TABLE_ENABLE
+#define HAL_CRC_SLICE4_TABLE_ENABLE (0U)
+#endif
+
+/*
+ * @brief   Select the polynomials the lookup tables are generated for.
+ * Polynomials without tables are always computed bitwise.
+ */
+#ifndef HAL_CRC_TABLE_CRC_8_ENABLE
+#define HAL_CRC_TABLE_CRC_8_ENABLE (1U)
+#endif
+#ifndef HAL_CRC_TABLE_CRC_16_ENABLE
+#define HAL_CRC_TABLE_CRC_16_ENABLE (1U)
+#endif
+#ifndef HAL_CRC_TABLE_CRC_32_ENABLE
+#define HAL_CRC_TABLE_CRC_32_ENABLE (1U)
+#endif
+
+/*
+ * @brief   Engine used when hal_crc_config_t::crcEngine is KHAL_CrcEngineDefault.
+ */
+#ifndef HAL_CRC_DEFAULT_ENGINE
+#define HAL_CRC_DEFAULT_ENGINE KHAL_CrcEngineNibble
+#endif
+
 /************************************************************************************
 *************************************************************************************
 * Public types
@@ -55,6 +105,22 @@ typedef enum _hal_crc_polynomial
     KHAL_CrcPolynomial_CRC_32      = 0x4C11DB7U, /*!< x^32+x^26+x^23+x^22+x^16+x^12+x^11+x^10+x^8+x^7+x^5+x^4+x^2+x+1 */
 } hal_crc_polynomial_t;
 
+/*! @brief Software CRC computation engines.
+ *
+ * An engine whose tables are not compiled in, or that has no table for the configured
+ * polynomial, falls back to the next smaller one down to the bitwise engine. All
+ * engines return the same result. Zero and values out of range select the default
+ * engine. The hardware CRC adapter ignores this setting.
+ */
+typedef enum _hal_crc_engine
+{
+    KHAL_CrcEngineDefault = 0U, /*!< Use HAL_CRC_DEFAULT_ENGINE. */
+    KHAL_CrcEngineBitwise = 1U, /*!< One shift/XOR step per bit, no table. */
+    KHAL_CrcEngineNibble  = 2U, /*!< Two lookups per byte in a 16-entry table. */
+    KHAL_CrcEngineByte    = 3U, /*!< One lookup per byte in a 256-entry table. */
+    KHAL_CrcEngineSlice4  = 4U, /*!< Four lookups per 32-bit word in four 256-entry tables. */
+} hal_crc_engine_t;
+
 /*! @brief CRC configuration structure. */
 typedef struct _hal_crc_config
 {
@@ -67,8 +133,20 @@ typedef struct _hal_crc_config
     uint8_t complementChecksum;         /*!< wether output the complement checksum. */
     uint8_t crcSize;                    /*!< Number of CRC octets, 2 mean use CRC16, 4 mean use CRC32. */
     uint8_t crcStartByte; /*!< Start CRC with this byte position. Byte #0 is the first byte of Sync Address. */
+    hal_crc_engine_t crcEngine; /*!< Software CRC engine, zero for the default. See "hal_crc_engine_t". */
 } hal_crc_config_t;
 
+/*! @brief CRC context used by the incremental API, the members are private to the adapter. */
+typedef struct _hal_crc_context
+{
+    hal_crc_config_t *crcConfig; /*!< Configuration the computation was started with. */
+    const uint32_t *table;       /*!< Lookup table of the selected engine, NULL for the bitwise engine. */
+    uint32_t crcReg;             /*!< Running CRC register. */
+    uint32_t crcPoly;            /*!< Polynomial aligned (and reflected) for the running register. */
+    uint32_t skipBytes;          /*!< Leading bytes still to be skipped, see crcStartByte. */
+    hal_crc_engine_t engine;     /*!< Engine actually used. */
+} hal_crc_context_t;
+
 /************************************************************************************
 *************************************************************************************
 * Public prototypes
@@ -115,6 +193,46 @@ extern "C" {
  */
 uint32_t HAL_CrcCompute(hal_crc_config_t *crcConfig, uint8_t *dataIn, uint32_t length);
 
+/*!
+ * @brief Start an incremental CRC computation.
+ *
+ * The data can then be fed in any number of chunks with HAL_CrcUpdate, the result is the
+ * same as HAL_CrcCompute over the concatenated data.
+ *
+ *  @code
+ * HAL_CrcInit(&context, &config);
+ * HAL_CrcUpdate(&context, header, sizeof(header));
+ * HAL_CrcUpdate(&context, payload, payloadLength);
+ * res = HAL_CrcFinal(&context);
+ *  @endcode
+ *
+ * @note The configuration structure must stay valid until HAL_CrcFinal is called. The
+ * hardware CRC adapter keeps the running CRC in the peripheral, so only one computation
+ * can be in progress at a time there.
+ *
+ * @param context    CRC context.
+ * @param crcConfig  configuration structure.
+ */
+void HAL_CrcInit(hal_crc_context_t *context, hal_crc_config_t *crcConfig);
+
+/*!
+ * @brief Feed data into an incremental CRC computation.
+ *
+ * @param context  CRC context started by HAL_CrcInit.
+ * @param dataIn   input data buffer.
+ * @param length   input data buffer size.
+ */
+void HAL_CrcUpdate(hal_crc_context_t *context, const uint8_t *dataIn, uint32_t length);
+
+/*!
+ * @brief Finish an incremental CRC computation.
+ *
+ * @param context  CRC context started by HAL_CrcInit.
+ *
+ * @retval Computed CRC value.
+ */
+uint32_t HAL_CrcFinal(hal_crc_context_t *context);
+
 /*! @} */
 
 #if defined(__cplusplus)
@@ -8,86 +8,459 @@
 #include "fsl_common.h"
 #include "fsl_adapter_crc.h"
 
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#if (defined(HAL_CRC_SLICE4_TABLE_ENABLE) && (HAL_CRC_SLICE4_TABLE_ENABLE > 0U))
+#define HAL_CRC_TABLE_SLICES (4U)
+#elif (defined(HAL_CRC_BYTE_TABLE_ENABLE) && (HAL_CRC_BYTE_TABLE_ENABLE > 0U))
+#define HAL_CRC_TABLE_SLICES (1U)
+#else
+#define HAL_CRC_TABLE_SLICES (0U)
+#endif
+
+/*
+ * The lookup tables are linear in their index, so each entry is the XOR of the entries
+ * of its set bits. The tables below are generated by the preprocessor from those
+ * single-bit entries, which are the polynomial advanced by 0..31 register shifts.
+ */
+#define HAL_CRC_ENTRY(i, b0, b1, b2, b3, b4, b5, b6, b7)                                        \
+    ((((i)&0x01U) != 0U ? (b0) : 0U) ^ (((i)&0x02U) != 0U ? (b1) : 0U) ^                    \
+     (((i)&0x04U) != 0U ? (b2) : 0U) ^ (((i)&0x08U) != 0U ? (b3) : 0U) ^                    \
+     (((i)&0x10U) != 0U ? (b4) : 0U) ^ (((i)&0x20U) != 0U ? (b5) : 0U) ^                    \
+     (((i)&0x40U) != 0U ? (b6) : 0U) ^ (((i)&0x80U) != 0U ? (b7) : 0U))
+#define HAL_CRC_ENTRY4(i, ...)                                                                  \
+    HAL_CRC_ENTRY((i), __VA_ARGS__), HAL_CRC_ENTRY((i) + 1U, __VA_ARGS__),                    \
+        HAL_CRC_ENTRY((i) + 2U, __VA_ARGS__), HAL_CRC_ENTRY((i) + 3U, __VA_ARGS__)
+#define HAL_CRC_ENTRY16(i, ...)                                                                 \
+    HAL_CRC_ENTRY4((i), __VA_ARGS__), HAL_CRC_ENTRY4((i) + 4U, __VA_ARGS__),                  \
+        HAL_CRC_ENTRY4((i) + 8U, __VA_ARGS__), HAL_CRC_ENTRY4((i) + 12U, __VA_ARGS__)
+#define HAL_CRC_ENTRY64(i, ...)                                                                 \
+    HAL_CRC_ENTRY16((i), __VA_ARGS__), HAL_CRC_ENTRY16((i) + 16U, __VA_ARGS__),               \
+        HAL_CRC_ENTRY16((i) + 32U, __VA_ARGS__), HAL_CRC_ENTRY16((i) + 48U, __VA_ARGS__)
+#define HAL_CRC_TABLE256(...)                                                                   \
+    HAL_CRC_ENTRY64(0U, __VA_ARGS__), HAL_CRC_ENTRY64(64U, __VA_ARGS__),                      \
+        HAL_CRC_ENTRY64(128U, __VA_ARGS__), HAL_CRC_ENTRY64(192U, __VA_ARGS__)
+#define HAL_CRC_TABLE16(b0, b1, b2, b3) HAL_CRC_ENTRY16(0U, b0, b1, b2, b3, 0U, 0U, 0U, 0U)
+
+/*! @brief Lookup tables of one polynomial, index 0 is MSB-first, index 1 is reflected input. */
+typedef struct _hal_crc_table_set
+{
+    uint32_t crcPoly; /*!< Polynomial left-aligned to bit 31. */
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+    const uint32_t *nibbleTable[2];
+#endif
+#if (HAL_CRC_TABLE_SLICES > 0U)
+    const uint32_t *byteTable[2]; /*!< HAL_CRC_TABLE_SLICES consecutive 256-entry tables. */
+#endif
+} hal_crc_table_set_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+#if (defined(HAL_CRC_TABLE_CRC_8_ENABLE) && (HAL_CRC_TABLE_CRC_8_ENABLE > 0U))
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+static const uint32_t s_crc8NibbleTable[2][16] = {
+    {HAL_CRC_TABLE16(0x03000000U, 0x06000000U, 0x0C000000U, 0x18000000U)},
+    {HAL_CRC_TABLE16(0x00000018U, 0x00000030U, 0x00000060U, 0x000000C0U)},
+};
+#endif
+#if (HAL_CRC_TABLE_SLICES > 0U)
+static const uint32_t s_crc8ByteTable[2][HAL_CRC_TABLE_SLICES][256] = {
+    {
+        {HAL_CRC_TABLE256(0x03000000U, 0x06000000U, 0x0C000000U, 0x18000000U, 0x30000000U, 0x60000000U, 0xC0000000U, 0x83000000U)},
+#if (HAL_CRC_TABLE_SLICES > 1U)
+        {HAL_CRC_TABLE256(0x05000000U, 0x0A000000U, 0x14000000U, 0x28000000U, 0x50000000U, 0xA0000000U, 0x43000000U, 0x86000000U)},
+        {HAL_CRC_TABLE256(0x0F000000U, 0x1E000000U, 0x3C000000U, 0x78000000U, 0xF0000000U, 0xE3000000U, 0xC5000000U, 0x89000000U)},
+        {HAL_CRC_TABLE256(0x11000000U, 0x22000000U, 0x44000000U, 0x88000000U, 0x13000000U, 0x26000000U, 0x4C000000U, 0x98000000U)},
+#endif
+    },
+    {
+        {HAL_CRC_TABLE256(0x000000C1U, 0x00000003U, 0x00000006U, 0x0000000CU, 0x00000018U, 0x00000030U, 0x00000060U, 0x000000C0U)},
+#if (HAL_CRC_TABLE_SLICES > 1U)
+        {HAL_CRC_TABLE256(0x00000061U, 0x000000C2U, 0x00000005U, 0x0000000AU, 0x00000014U, 0x00000028U, 0x00000050U, 0x000000A0U)},
+        {HAL_CRC_TABLE256(0x00000091U, 0x000000A3U, 0x000000C7U, 0x0000000FU, 0x0000001EU, 0x0000003CU, 0x00000078U, 0x000000F0U)},
+        {HAL_CRC_TABLE256(0x00000019U, 0x00000032U, 0x00000064U, 0x000000C8U, 0x00000011U, 0x00000022U, 0x00000044U, 0x00000088U)},
+#endif
+    },
+};
+#endif
+#endif /* HAL_CRC_TABLE_CRC_8_ENABLE */
+
+#if (defined(HAL_CRC_TABLE_CRC_16_ENABLE) && (HAL_CRC_TABLE_CRC_16_ENABLE > 0U))
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+static const uint32_t s_crc16NibbleTable[2][16] = {
+    {HAL_CRC_TABLE16(0x10210000U, 0x20420000U, 0x40840000U, 0x81080000U)},
+    {HAL_CRC_TABLE16(0x00001081U, 0x00002102U, 0x00004204U, 0x00008408U)},
+};
+#endif
+#if (HAL_CRC_TABLE_SLICES > 0U)
+static const uint32_t s_crc16ByteTable[2][HAL_CRC_TABLE_SLICES][256] = {
+    {
+        {HAL_CRC_TABLE256(0x10210000U, 0x20420000U, 0x40840000U, 0x81080000U, 0x12310000U, 0x24620000U, 0x48C40000U, 0x91880000U)},
+#if (HAL_CRC_TABLE_SLICES > 1U)
+        {HAL_CRC_TABLE256(0x33310000U, 0x66620000U, 0xCCC40000U, 0x89A90000U, 0x03730000U, 0x06E60000U, 0x0DCC0000U, 0x1B980000U)},
+        {HAL_CRC_TABLE256(0x37300000U, 0x6E600000U, 0xDCC00000U, 0xA9A10000U, 0x43630000U, 0x86C60000U, 0x1DAD0000U, 0x3B5A0000U)},
+        {HAL_CRC_TABLE256(0x76B40000U, 0xED680000U, 0xCAF10000U, 0x85C30000U, 0x1BA70000U, 0x374E0000U, 0x6E9C0000U, 0xDD380000U)},
+#endif
+    },
+    {
+        {HAL_CRC_TABLE256(0x00001189U, 0x00002312U, 0x00004624U, 0x00008C48U, 0x00001081U, 0x00002102U, 0x00004204U, 0x00008408U)},
+#if (HAL_CRC_TABLE_SLICES > 1U)
+        {HAL_CRC_TABLE256(0x000019D8U, 0x000033B0U, 0x00006760U, 0x0000CEC0U, 0x00009591U, 0x00002333U, 0x00004666U, 0x00008CCCU)},
+        {HAL_CRC_TABLE256(0x00005ADCU, 0x0000B5B8U, 0x00006361U, 0x0000C6C2U, 0x00008595U, 0x0000033BU, 0x00000676U, 0x00000CECU)},
+        {HAL_CRC_TABLE256(0x00001CBBU, 0x00003976U, 0x000072ECU, 0x0000E5D8U, 0x0000C3A1U, 0x00008F53U, 0x000016B7U, 0x00002D6EU)},
+#endif
+    },
+};
+#endif
+#endif /* HAL_CRC_TABLE_CRC_16_ENABLE */
+
+#if (defined(HAL_CRC_TABLE_CRC_32_ENABLE) && (HAL_CRC_TABLE_CRC_32_ENABLE > 0U))
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+static const uint32_t s_crc32NibbleTable[2][16] = {
+    {HAL_CRC_TABLE16(0x04C11DB7U, 0x09823B6EU, 0x130476DCU, 0x2608EDB8U)},
+    {HAL_CRC_TABLE16(0x1DB71064U, 0x3B6E20C8U, 0x76DC4190U, 0xEDB88320U)},
+};
+#endif
+#if (HAL_CRC_TABLE_SLICES > 0U)
+static const uint32_t s_crc32ByteTable[2][HAL_CRC_TABLE_SLICES][256] = {
+    {
+        {HAL_CRC_TABLE256(0x04C11DB7U, 0x09823B6EU, 0x130476DCU, 0x2608EDB8U, 0x4C11DB70U, 0x9823B6E0U, 0x34867077U, 0x690CE0EEU)},
+#if (HAL_CRC_TABLE_SLICES > 1U)
+        {HAL_CRC_TABLE256(0xD219C1DCU, 0xA0F29E0FU, 0x452421A9U, 0x8A484352U, 0x10519B13U, 0x20A33626U, 0x41466C4CU, 0x828CD898U)},
+        {HAL_CRC_TABLE256(0x01D8AC87U, 0x03B1590EU, 0x0762B21CU, 0x0EC56438U, 0x1D8AC870U, 0x3B1590E0U, 0x762B21C0U, 0xEC564380U)},
+        {HAL_CRC_TABLE256(0xDC6D9AB7U, 0xBC1A28D9U, 0x7CF54C05U, 0xF9EA980AU, 0xF7142DA3U, 0xEAE946F1U, 0xD1139055U, 0xA6E63D1DU)},
+#endif
+    },
+    {
+        {HAL_CRC_TABLE256(0x77073096U, 0xEE0E612CU, 0x076DC419U, 0x0EDB8832U, 0x1DB71064U, 0x3B6E20C8U, 0x76DC4190U, 0xEDB88320U)},
+#if (HAL_CRC_TABLE_SLICES > 1U)
+        {HAL_CRC_TABLE256(0x191B3141U, 0x32366282U, 0x646CC504U, 0xC8D98A08U, 0x4AC21251U, 0x958424A2U, 0xF0794F05U, 0x3B83984BU)},
+        {HAL_CRC_TABLE256(0x01C26A37U, 0x0384D46EU, 0x0709A8DCU, 0x0E1351B8U, 0x1C26A370U, 0x384D46E0U, 0x709A8DC0U, 0xE1351B80U)},
+        {HAL_CRC_TABLE256(0xB8BC6765U, 0xAA09C88BU, 0x8F629757U, 0xC5B428EFU, 0x5019579FU, 0xA032AF3EU, 0x9B14583DU, 0xED59B63BU)},
+#endif
+    },
+};
+#endif
+#endif /* HAL_CRC_TABLE_CRC_32_ENABLE */
+static const hal_crc_table_set_t s_crcTableSets[] = {
+#if (defined(HAL_CRC_TABLE_CRC_8_ENABLE) && (HAL_CRC_TABLE_CRC_8_ENABLE > 0U))
+    {
+        .crcPoly = (uint32_t)KHAL_CrcPolynomial_CRC_8_CCITT << 24U,
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+        .nibbleTable = {s_crc8NibbleTable[0], s_crc8NibbleTable[1]},
+#endif
+#if (HAL_CRC_TABLE_SLICES > 0U)
+        .byteTable = {s_crc8ByteTable[0][0], s_crc8ByteTable[1][0]},
+#endif
+    },
+#endif
+#if (defined(HAL_CRC_TABLE_CRC_16_ENABLE) && (HAL_CRC_TABLE_CRC_16_ENABLE > 0U))
+    {
+        .crcPoly = (uint32_t)KHAL_CrcPolynomial_CRC_16 << 16U,
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+        .nibbleTable = {s_crc16NibbleTable[0], s_crc16NibbleTable[1]},
+#endif
+#if (HAL_CRC_TABLE_SLICES > 0U)
+        .byteTable = {s_crc16ByteTable[0][0], s_crc16ByteTable[1][0]},
+#endif
+    },
+#endif
+#if (defined(HAL_CRC_TABLE_CRC_32_ENABLE) && (HAL_CRC_TABLE_CRC_32_ENABLE > 0U))
+    {
+        .crcPoly = (uint32_t)KHAL_CrcPolynomial_CRC_32,
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+        .nibbleTable = {s_crc32NibbleTable[0], s_crc32NibbleTable[1]},
+#endif
+#if (HAL_CRC_TABLE_SLICES > 0U)
+        .byteTable = {s_crc32ByteTable[0][0], s_crc32ByteTable[1][0]},
+#endif
+    },
+#endif
+    {.crcPoly = 0U},
+};
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
-uint32_t HAL_CrcCompute(hal_crc_config_t *crcConfig, uint8_t *dataIn, uint32_t length)
+static uint32_t HAL_CrcReflect32(uint32_t value)
 {
-    uint32_t shiftReg    = crcConfig->crcSeed << ((4U - crcConfig->crcSize) << 3U);
-    uint32_t crcPoly     = crcConfig->crcPoly << ((4U - crcConfig->crcSize) << 3U);
-    uint32_t crcXorOut   = crcConfig->crcXorOut << ((4U - crcConfig->crcSize) << 3U);
-    uint16_t startOffset = crcConfig->crcStartByte;
-    uint8_t crcBits      = 8U * crcConfig->crcSize;
-    uint32_t computedCRC = 0;
-    uint32_t i, j;
-    uint8_t data = 0;
-    uint8_t bit;
+    value = ((value >> 1U) & 0x55555555U) | ((value & 0x55555555U) << 1U);
+    value = ((value >> 2U) & 0x33333333U) | ((value & 0x33333333U) << 2U);
+    value = ((value >> 4U) & 0x0F0F0F0FU) | ((value & 0x0F0F0F0FU) << 4U);
+    return __REV(value);
+}
 
-    /* Size 0 will bypass CRC calculation. */
-    if (crcConfig->crcSize != 0U)
+static void HAL_CrcSelectEngine(hal_crc_context_t *context, uint32_t crcPoly)
+{
+    const hal_crc_table_set_t *tableSet = &s_crcTableSets[0];
+    hal_crc_engine_t engine             = context->crcConfig->crcEngine;
+
+    /* Configurations written before crcEngine existed leave it zero or, on the stack, undefined. */
+    if ((engine == KHAL_CrcEngineDefault) || ((uint32_t)engine > (uint32_t)KHAL_CrcEngineSlice4))
     {
-        for (i = 0UL + startOffset; i < length; i++)
-        {
-            data = dataIn[i];
+        engine = HAL_CRC_DEFAULT_ENGINE;
+    }
+
+    while ((tableSet->crcPoly != 0U) && (tableSet->crcPoly != crcPoly))
+    {
+        tableSet++;
+    }
+
+    context->table = NULL;
+    if (tableSet->crcPoly == 0U)
+    {
+        engine = KHAL_CrcEngineBitwise;
+    }
+#if (HAL_CRC_TABLE_SLICES < 4U)
+    if (engine == KHAL_CrcEngineSlice4)
+    {
+        engine = KHAL_CrcEngineByte;
+    }
+#endif
+#if (HAL_CRC_TABLE_SLICES > 0U)
+    if ((engine == KHAL_CrcEngineSlice4) || (engine == KHAL_CrcEngineByte))
+    {
+        context->table = tableSet->byteTable[(uint32_t)context->crcConfig->crcRefIn];
+    }
+#else
+    if (engine == KHAL_CrcEngineByte)
+    {
+        engine = KHAL_CrcEngineNibble;
+    }
+#endif
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+    if (engine == KHAL_CrcEngineNibble)
+    {
+        context->table = tableSet->nibbleTable[(uint32_t)context->crcConfig->crcRefIn];
+    }
+#else
+    if (engine == KHAL_CrcEngineNibble)
+    {
+        engine = KHAL_CrcEngineBitwise;
+    }
+#endif
+    context->engine = engine;
+}
+
+/*
+ * The register keeps the CRC left-aligned to bit 31 and is shifted MSB first. When the
+ * input is reflected the whole register is kept reflected instead (CRC in the low bits,
+ * shifted LSB first), which is equivalent and avoids reflecting every input byte.
+ */
+static uint32_t HAL_CrcUpdateBitwise(uint32_t crcReg, uint32_t crcPoly, bool reflected, const uint8_t *data, uint32_t length)
+{
+    uint32_t i;
+    uint32_t j;
 
-            if (crcConfig->crcRefIn == KHAL_CrcRefInput)
+    for (i = 0U; i < length; i++)
+    {
+        if (reflected)
+        {
+            crcReg ^= data[i];
+            for (j = 0U; j < 8U; j++)
             {
-                bit = 0U;
-                for (j = 0U; j < 8U; j++)
-                {
-                    bit = (bit << 1);
-                    bit |= ((data & 1U) != 0U) ? 1U : 0U;
-                    data = (data >> 1);
-                }
-                data = bit;
+                crcReg = ((crcReg & 1U) != 0U) ? ((crcReg >> 1U) ^ crcPoly) : (crcReg >> 1U);
             }
-
-            for (j = 0; j < 8U; j++)
+        }
+        else
+        {
+            crcReg ^= (uint32_t)data[i] << 24U;
+            for (j = 0U; j < 8U; j++)
             {
-                bit  = ((data & 0x80U) != 0U) ? 1U : 0U;
-                data = (data << 1);
-
-                if ((shiftReg & 1UL << 31) != 0U)
-                {
-                    bit = (bit != 0U) ? 0U : 1U;
-                }
-
-                shiftReg = (shiftReg << 1);
-
-                if (bit != 0U)
-                {
-                    shiftReg ^= crcPoly;
-                }
-
-                if ((bool)bit && ((crcPoly & (1UL << (32U - crcBits))) != 0U))
-                {
-                    shiftReg |= (1UL << (32U - crcBits));
-                }
-                else
-                {
-                    shiftReg &= ~(1UL << (32U - crcBits));
-                }
+                crcReg = ((crcReg & (1UL << 31U)) != 0U) ? ((crcReg << 1U) ^ crcPoly) : (crcReg << 1U);
             }
         }
+    }
+
+    return crcReg;
+}
 
-        shiftReg ^= crcXorOut;
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+static uint32_t HAL_CrcUpdateNibble(uint32_t crcReg, const uint32_t *table, bool reflected, const uint8_t *data, uint32_t length)
+{
+    uint32_t i;
 
-        if (crcConfig->crcByteOrder == KHAL_CrcMSByteFirst)
+    for (i = 0U; i < length; i++)
+    {
+        if (reflected)
         {
-            computedCRC = (shiftReg >> (32U - crcBits));
+            crcReg = (crcReg >> 4U) ^ table[(crcReg ^ data[i]) & 0x0FU];
+            crcReg = (crcReg >> 4U) ^ table[(crcReg ^ ((uint32_t)data[i] >> 4U)) & 0x0FU];
         }
         else
         {
-            computedCRC = 0;
-            j           = 1U;
-            for (i = 0; i < 32U; i++)
-            {
-                computedCRC = (computedCRC << 1);
-                computedCRC |= ((shiftReg & j) != 0U) ? 1U : 0U;
-                j = (j << 1);
-            }
+            crcReg = (crcReg << 4U) ^ table[(crcReg >> 28U) ^ ((uint32_t)data[i] >> 4U)];
+            crcReg = (crcReg << 4U) ^ table[(crcReg >> 28U) ^ ((uint32_t)data[i] & 0x0FU)];
         }
     }
 
-    return computedCRC;
+    return crcReg;
+}
+#endif
+
+#if (HAL_CRC_TABLE_SLICES > 0U)
+static uint32_t HAL_CrcUpdateByte(uint32_t crcReg, const uint32_t *table, bool reflected, const uint8_t *data, uint32_t length)
+{
+    uint32_t i;
+
+    if (reflected)
+    {
+        for (i = 0U; i < length; i++)
+        {
+            crcReg = (crcReg >> 8U) ^ table[(crcReg ^ data[i]) & 0xFFU];
+        }
+    }
+    else
+    {
+        for (i = 0U; i < length; i++)
+        {
+            crcReg = (crcReg << 8U) ^ table[(crcReg >> 24U) ^ data[i]];
+        }
+    }
+
+    return crcReg;
+}
+#endif
+
+#if (HAL_CRC_TABLE_SLICES > 1U)
+static uint32_t HAL_CrcUpdateSlice4(uint32_t crcReg, const uint32_t *table, bool reflected, const uint8_t *data, uint32_t length)
+{
+    const uint32_t *word;
+    uint32_t head = (4U - ((uint32_t)(uintptr_t)data & 3U)) & 3U;
+
+    /* Bring the data to a word boundary, the M0+ does not support unaligned loads. */
+    if (head > length)
+    {
+        head = length;
+    }
+    crcReg = HAL_CrcUpdateByte(crcReg, table, reflected, data, head);
+    data += head;
+    length -= head;
+
+    word = (const uint32_t *)(const void *)data;
+    while (length >= 4U)
+    {
+        if (reflected)
+        {
+            crcReg ^= *word;
+            crcReg = table[768U + (crcReg & 0xFFU)] ^ table[512U + ((crcReg >> 8U) & 0xFFU)] ^
+                     table[256U + ((crcReg >> 16U) & 0xFFU)] ^ table[crcReg >> 24U];
+        }
+        else
+        {
+            crcReg ^= __REV(*word);
+            crcReg = table[768U + (crcReg >> 24U)] ^ table[512U + ((crcReg >> 16U) & 0xFFU)] ^
+                     table[256U + ((crcReg >> 8U) & 0xFFU)] ^ table[crcReg & 0xFFU];
+        }
+        word++;
+        length -= 4U;
+    }
+
+    return HAL_CrcUpdateByte(crcReg, table, reflected, (const uint8_t *)(const void *)word, length);
+}
+#endif
+
+void HAL_CrcInit(hal_crc_context_t *context, hal_crc_config_t *crcConfig)
+{
+    uint32_t alignShift = (4U - crcConfig->crcSize) << 3U;
+
+    assert(NULL != context);
+    assert((crcConfig->crcSize > 0U) && (crcConfig->crcSize <= 4U));
+
+    context->crcConfig = crcConfig;
+    context->skipBytes = crcConfig->crcStartByte;
+    context->crcReg    = crcConfig->crcSeed << alignShift;
+    context->crcPoly   = crcConfig->crcPoly << alignShift;
+
+    HAL_CrcSelectEngine(context, context->crcPoly);
+
+    if (crcConfig->crcRefIn == KHAL_CrcRefInput)
+    {
+        context->crcReg  = HAL_CrcReflect32(context->crcReg);
+        context->crcPoly = HAL_CrcReflect32(context->crcPoly);
+    }
+}
+
+void HAL_CrcUpdate(hal_crc_context_t *context, const uint8_t *dataIn, uint32_t length)
+{
+    bool reflected = (context->crcConfig->crcRefIn == KHAL_CrcRefInput);
+
+    if (context->skipBytes != 0U)
+    {
+        if (context->skipBytes >= length)
+        {
+            context->skipBytes -= length;
+            length = 0U;
+        }
+        else
+        {
+            dataIn += context->skipBytes;
+            length -= context->skipBytes;
+            context->skipBytes = 0U;
+        }
+    }
+
+    switch (context->engine)
+    {
+#if (HAL_CRC_TABLE_SLICES > 1U)
+        case KHAL_CrcEngineSlice4:
+            context->crcReg = HAL_CrcUpdateSlice4(context->crcReg, context->table, reflected, dataIn, length);
+            break;
+#endif
+#if (HAL_CRC_TABLE_SLICES > 0U)
+        case KHAL_CrcEngineByte:
+            context->crcReg = HAL_CrcUpdateByte(context->crcReg, context->table, reflected, dataIn, length);
+            break;
+#endif
+#if (defined(HAL_CRC_NIBBLE_TABLE_ENABLE) && (HAL_CRC_NIBBLE_TABLE_ENABLE > 0U))
+        case KHAL_CrcEngineNibble:
+            context->crcReg = HAL_CrcUpdateNibble(context->crcReg, context->table, reflected, dataIn, length);
+            break;
+#endif
+        default:
+            context->crcReg = HAL_CrcUpdateBitwise(context->crcReg, context->crcPoly, reflected, dataIn, length);
+            break;
+    }
+}
+
+uint32_t HAL_CrcFinal(hal_crc_context_t *context)
+{
+    hal_crc_config_t *crcConfig = context->crcConfig;
+    uint32_t crcBits            = 8U * (uint32_t)crcConfig->crcSize;
+    uint32_t shiftReg           = context->crcReg;
+
+    if (crcConfig->crcRefIn == KHAL_CrcRefInput)
+    {
+        shiftReg = HAL_CrcReflect32(shiftReg);
+    }
+
+    /* The result is reflected within its size before the XOR mask, as the CRC peripheral does. */
+    if (crcConfig->crcRefOut == KHAL_CrcRefOutput)
+    {
+        shiftReg = HAL_CrcReflect32(shiftReg) << (32U - crcBits);
+    }
+
+    shiftReg ^= crcConfig->crcXorOut << (32U - crcBits);
+
+    /* LS byte first reflects the whole 32-bit register. */
+    return (crcConfig->crcByteOrder == KHAL_CrcMSByteFirst) ? (shiftReg >> (32U - crcBits)) :
+                                                              HAL_CrcReflect32(shiftReg);
+}
+
+uint32_t HAL_CrcCompute(hal_crc_config_t *crcConfig, uint8_t *dataIn, uint32_t length)
+{
+    hal_crc_context_t context;
+
+    /* Size 0 will bypass CRC calculation. */
+    if (crcConfig->crcSize == 0U)
+    {
+        return 0U;
+    }
+
+    HAL_CrcInit(&context, crcConfig);
+    HAL_CrcUpdate(&context, dataIn, length);
+
+    return HAL_CrcFinal(&context);
 }
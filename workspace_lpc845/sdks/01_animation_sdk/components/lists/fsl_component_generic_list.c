@@ -28,39 +28,61 @@
 #define LIST_EXIT_CRITICAL()  EnableGlobalIRQ(regPrimask);
 #endif
 
-static list_status_t LIST_Error_Check(list_handle_t list, list_element_handle_t newElement)
+/*! *********************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+********************************************************************************** */
+#if (defined(GENERIC_LIST_DEBUG) && (GENERIC_LIST_DEBUG > 0U))
+/*! *********************************************************************************
+ * \brief     Checks the list before an insertion, debug variant.
+ *
+ * \param[in] list - ID of list to insert into.
+ *            newElement - element to add
+ *
+ * \return kLIST_Full if list is full.
+ *         kLIST_DuplicateError if the element is in the list.
+ *         kLIST_Ok if the element can be inserted.
+ *
+ * \pre
+ *
+ * \post
+ *
+ * \remarks  Asserts when the size or the tail of the list do not match the linked elements.
+ *
+ ********************************************************************************** */
+list_status_t LIST_DebugCheck(list_handle_t list, list_element_handle_t newElement)
 {
-    list_status_t listStatus = kLIST_Ok;
-#if (defined(GENERIC_LIST_DUPLICATED_CHECKING) && (GENERIC_LIST_DUPLICATED_CHECKING > 0U))
+    list_status_t listStatus      = kLIST_Ok;
     list_element_handle_t element = list->head;
-#endif
-    if ((list->max != 0U) && (list->max == list->size))
-    {
-        listStatus = kLIST_Full; /*List is full*/
-    }
-#if (defined(GENERIC_LIST_DUPLICATED_CHECKING) && (GENERIC_LIST_DUPLICATED_CHECKING > 0U))
-    else
+    list_element_handle_t last    = NULL;
+    uint32_t count                = 0U;
+
+    while (element != NULL) /*Scan list*/
     {
-        while (element != NULL) /*Scan list*/
+        assert(element->list == list);
+        /* Determine if element is duplicated */
+        if (element == newElement)
         {
-            /* Determine if element is duplicated */
-            if (element == newElement)
-            {
-                listStatus = kLIST_DuplicateError;
-                break;
-            }
-            element = element->next;
+            listStatus = kLIST_DuplicateError;
         }
+        last = element;
+        count++;
+        element = element->next;
+    }
+    assert(count == list->size);
+    assert(last == list->tail);
+    (void)last;
+    (void)count;
+
+    if ((list->max != 0U) && (list->max == list->size))
+    {
+        listStatus = kLIST_Full; /*List is full*/
     }
-#endif
     return listStatus;
 }
+#endif
 
-/*! *********************************************************************************
-*************************************************************************************
-* Public functions
-*************************************************************************************
-********************************************************************************** */
 /*! *********************************************************************************
  * \brief     Initializes the list descriptor.
  *
@@ -125,26 +147,7 @@ list_status_t LIST_AddTail(list_handle_t list, list_element_handle_t listElement
     LIST_ENTER_CRITICAL();
     list_status_t listStatus = kLIST_Ok;
 
-    listStatus = LIST_Error_Check(list, listElement);
-    if (listStatus == kLIST_Ok) /* Avoiding list status error */
-    {
-        if (list->size == 0U)
-        {
-            list->head = listElement;
-        }
-        else
-        {
-            list->tail->next = listElement;
-        }
-#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
-#else
-        listElement->prev = list->tail;
-#endif
-        listElement->list = list;
-        listElement->next = NULL;
-        list->tail        = listElement;
-        list->size++;
-    }
+    listStatus = LIST_AddTailUnlocked(list, listElement);
 
     LIST_EXIT_CRITICAL();
     return listStatus;
@@ -171,27 +174,8 @@ list_status_t LIST_AddHead(list_handle_t list, list_element_handle_t listElement
     LIST_ENTER_CRITICAL();
     list_status_t listStatus = kLIST_Ok;
 
-    listStatus = LIST_Error_Check(list, listElement);
-    if (listStatus == kLIST_Ok) /* Avoiding list status error */
-    {
-        /* Links element to the head of the list */
-        if (list->size == 0U)
-        {
-            list->tail = listElement;
-        }
-#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
-#else
-        else
-        {
-            list->head->prev = listElement;
-        }
-        listElement->prev = NULL;
-#endif
-        listElement->list = list;
-        listElement->next = list->head;
-        list->head        = listElement;
-        list->size++;
-    }
+    /* Links element to the head of the list */
+    listStatus = LIST_AddHeadUnlocked(list, listElement);
 
     LIST_EXIT_CRITICAL();
     return listStatus;
@@ -218,27 +202,13 @@ list_element_handle_t LIST_RemoveHead(list_handle_t list)
 
     LIST_ENTER_CRITICAL();
 
-    if ((NULL == list) || (list->size == 0U))
+    if (NULL == list)
     {
         listElement = NULL; /*LIST_ is empty*/
     }
     else
     {
-        listElement = list->head;
-        list->size--;
-        if (list->size == 0U)
-        {
-            list->tail = NULL;
-        }
-#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
-#else
-        else
-        {
-            listElement->next->prev = NULL;
-        }
-#endif
-        listElement->list = NULL;
-        list->head        = listElement->next; /*Is NULL if element is head*/
+        listElement = LIST_RemoveHeadUnlocked(list);
     }
 
     LIST_EXIT_CRITICAL();
@@ -412,7 +382,7 @@ list_status_t LIST_AddPrevElement(list_element_handle_t listElement, list_elemen
     }
     else
     {
-        listStatus = LIST_Error_Check(listElement->list, newElement);
+        listStatus = LIST_CheckInsert(listElement->list, newElement);
         if (listStatus == kLIST_Ok)
         {
 #if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
@@ -459,6 +429,80 @@ list_status_t LIST_AddPrevElement(list_element_handle_t listElement, list_elemen
     return listStatus;
 }
 
+/*! *********************************************************************************
+ * \brief     Links an element in sorted position.
+ *
+ * \param[in] list - ID of list to insert into.
+ *            element - element to add
+ *            compare - compare function, negative if element goes in front of member.
+ *
+ * \return kLIST_Full if list is full.
+ *         kLIST_DuplicateError if the element is in the list.
+ *         kLIST_Ok if insertion was successful.
+ *
+ * \pre
+ *
+ * \post
+ *
+ * \remarks  Members comparing equal stay in front of the element. An element sorted
+ *           after the tail is linked without walking the list.
+ *
+ ********************************************************************************** */
+list_status_t LIST_AddSorted(list_handle_t list, list_element_handle_t listElement, list_element_compare_t compare)
+{
+    list_element_handle_t element;
+    list_element_handle_t prevElement = NULL;
+    list_status_t listStatus;
+    LIST_ENTER_CRITICAL();
+
+    listStatus = LIST_CheckInsert(list, listElement);
+    if (listStatus == kLIST_Ok)
+    {
+        element = list->head;
+        if ((list->tail != NULL) && (compare(listElement, list->tail) >= 0))
+        {
+            /* Goes behind the tail */
+            prevElement = list->tail;
+            element     = NULL;
+        }
+        else
+        {
+            while ((element != NULL) && (compare(listElement, element) >= 0))
+            {
+                prevElement = element;
+                element     = element->next;
+            }
+        }
+
+        if (prevElement == NULL) /*Element is new head*/
+        {
+            list->head = listElement;
+        }
+        else
+        {
+            prevElement->next = listElement;
+        }
+        if (element == NULL) /*Element is new tail*/
+        {
+            list->tail = listElement;
+        }
+#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
+#else
+        else
+        {
+            element->prev = listElement;
+        }
+        listElement->prev = prevElement;
+#endif
+        listElement->next = element;
+        listElement->list = list;
+        list->size++;
+    }
+
+    LIST_EXIT_CRITICAL();
+    return listStatus;
+}
+
 /*! *********************************************************************************
  * \brief     Gets the current size of a list.
  *
@@ -54,6 +54,12 @@
 #define gMemManagerLightGuardsCheckEnable 0
 #endif
 
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+#if (MML_SIZE_CLASS_NUM > 32U)
+#error "MML_SIZE_CLASS_NUM can not exceed the 32 bits of the size class bitmap"
+#endif
+#endif
+
 /*! Extend Heap usage beyond the size defined by MinimalHeapSize_c up to __HEAP_end__ symbol address
  *   to make full use of the remaining available SRAM for the dynamic allocator. Also, only the data up to the
  *   highest allocated block will be retained by calling the @function MEM_GetHeapUpperLimit() from the power
@@ -93,6 +99,9 @@
 #define BLOCK_HDR_POSTGUARD_SIZE    28U
 #define BLOCK_HDR_POSTGUARD_PATTERN 0x39U
 
+/* Smallest remainder, header included, worth splitting off a reused free block */
+#define BLOCK_SPLIT_MIN_SIZE (BLOCK_HDR_SIZE + 8U)
+
 #if defined(__IAR_SYSTEMS_ICC__)
 #define __mem_get_LR() __get_LR()
 #elif defined(__GNUC__)
@@ -145,6 +154,9 @@ typedef struct blockHeader_s
     struct blockHeader_s *next;
     struct blockHeader_s *next_free;
     struct blockHeader_s *prev_free;
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+    struct blockHeader_s *prev; /* previous block in the area, free or not */
+#endif
 #ifdef MEM_TRACKING
     void *first_alloc_caller;
     void *second_alloc_caller;
@@ -170,6 +182,10 @@ typedef union void_ptr_tag
 typedef struct _memAreaPriv_s
 {
     freeBlockHeaderList_t FreeBlockHdrList;
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+    uint32_t freeClassBitmap;                        /* BIT(n) set when freeClassHead[n] is not empty */
+    blockHeader_t *freeClassHead[MML_SIZE_CLASS_NUM]; /* free blocks by size class, the top block excluded */
+#endif
 #ifdef MEM_STATISTICS_INTERNAL
     mem_statis_t statistics;
 #endif
@@ -358,7 +374,8 @@ static void MEM_BufferFrees_memStatis(void *buffer)
 
 #endif /* MEM_STATISTICS_INTERNAL */
 
-#if defined(gMemManagerLightFreeBlocksCleanUp) && (gMemManagerLightFreeBlocksCleanUp > 0)
+#if defined(gMemManagerLightFreeBlocksCleanUp) && (gMemManagerLightFreeBlocksCleanUp > 0) && \
+    !(defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0))
 static void MEM_BufferFreeBlocksCleanUp(memAreaPrivDesc_t *p_area, blockHeader_t *BlockHdr)
 {
     blockHeader_t *NextBlockHdr     = BlockHdr->next;
@@ -441,6 +458,247 @@ static memAreaPrivDesc_t *MEM_GetAreaByAreaId(uint8_t area_id)
     return p_area;
 }
 
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+#if !(defined(__ARM_FEATURE_CLZ) && (__ARM_FEATURE_CLZ > 0))
+/* Bit position of an isolated bit, index is the bit times a de Bruijn sequence, used where CLZ is missing (M0/M0+) */
+static const uint8_t s_memDeBruijnBitPosition[32] = {0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,  30U, 22U, 20U,
+                                                     15U, 25U, 17U, 4U,  8U,  31U, 27U, 13U, 23U, 21U, 19U,
+                                                     16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,  10U, 9U};
+#endif
+
+/* Position of the lowest set bit, value must not be 0 */
+static uint32_t MEM_LowestBitSet(uint32_t value)
+{
+#if defined(__ARM_FEATURE_CLZ) && (__ARM_FEATURE_CLZ > 0)
+    return 31U - (uint32_t)__CLZ(value & (0U - value));
+#else
+    return (uint32_t)s_memDeBruijnBitPosition[((value & (0U - value)) * 0x077CB531U) >> 27U];
+#endif
+}
+
+/* Position of the highest set bit, value must not be 0 */
+static uint32_t MEM_HighestBitSet(uint32_t value)
+{
+#if defined(__ARM_FEATURE_CLZ) && (__ARM_FEATURE_CLZ > 0)
+    return 31U - (uint32_t)__CLZ(value);
+#else
+    /* Smear the highest bit to the right, then keep it alone */
+    value |= value >> 1U;
+    value |= value >> 2U;
+    value |= value >> 4U;
+    value |= value >> 8U;
+    value |= value >> 16U;
+    return MEM_LowestBitSet((value >> 1U) + 1U);
+#endif
+}
+
+static uint32_t MEM_BlockSize(blockHeader_t *BlockHdr)
+{
+    return (uint32_t)BlockHdr->next - (uint32_t)BlockHdr - BLOCK_HDR_SIZE;
+}
+
+/* Size class holding a free block of size bytes */
+static uint32_t MEM_SizeClass(uint32_t size)
+{
+    uint32_t size_class = (size < 8U) ? 0U : (MEM_HighestBitSet(size) - 2U);
+
+    return (size_class < MML_SIZE_CLASS_NUM) ? size_class : (MML_SIZE_CLASS_NUM - 1U);
+}
+
+static void MEM_FreeClassInsert(memAreaPrivDesc_t *p_area, blockHeader_t *BlockHdr)
+{
+    uint32_t size_class = MEM_SizeClass(MEM_BlockSize(BlockHdr));
+    blockHeader_t *Head = p_area->ctx.freeClassHead[size_class];
+
+    BlockHdr->used      = MEMMANAGER_BLOCK_FREE;
+    BlockHdr->prev_free = NULL;
+    BlockHdr->next_free = Head;
+    if (Head != NULL)
+    {
+        Head->prev_free = BlockHdr;
+    }
+    p_area->ctx.freeClassHead[size_class] = BlockHdr;
+    p_area->ctx.freeClassBitmap |= (1UL << size_class);
+}
+
+/* Must be called before the size of the block changes */
+static void MEM_FreeClassRemove(memAreaPrivDesc_t *p_area, blockHeader_t *BlockHdr)
+{
+    uint32_t size_class = MEM_SizeClass(MEM_BlockSize(BlockHdr));
+
+    if (BlockHdr->prev_free != NULL)
+    {
+        BlockHdr->prev_free->next_free = BlockHdr->next_free;
+    }
+    else
+    {
+        p_area->ctx.freeClassHead[size_class] = BlockHdr->next_free;
+        if (BlockHdr->next_free == NULL)
+        {
+            p_area->ctx.freeClassBitmap &= ~(1UL << size_class);
+        }
+    }
+    if (BlockHdr->next_free != NULL)
+    {
+        BlockHdr->next_free->prev_free = BlockHdr->prev_free;
+    }
+}
+
+/* Carve size bytes from the unused top of the area, the top block moves up */
+static blockHeader_t *MEM_AllocateFromTop(memAreaPrivDesc_t *p_area, uint32_t size)
+{
+    blockHeader_t *BlockHdr = p_area->ctx.FreeBlockHdrList.tail;
+    blockHeader_t *NewTailHdr;
+    uint32_t current_footprint = (uint32_t)BlockHdr + BLOCK_HDR_SIZE - 1U;
+    uint32_t total_size        = size + BLOCK_HDR_SIZE;
+    int32_t remaining_bytes;
+
+    remaining_bytes = (int32_t)p_area->end_address.raw_address - (int32_t)current_footprint - (int32_t)total_size;
+    if (remaining_bytes < 0) /* need to keep the room for the next BlockHeader */
+    {
+        return NULL;
+    }
+
+    if (p_area->low_watermark > (uint32_t)remaining_bytes)
+    {
+        p_area->low_watermark = (uint32_t)remaining_bytes;
+    }
+    MEM_ReinitRamBank((uint32_t)BlockHdr + BLOCK_HDR_SIZE,
+                      ROUNDUP_WORD(((uint32_t)BlockHdr + total_size + BLOCK_HDR_SIZE)));
+
+    NewTailHdr            = (blockHeader_t *)((uint32_t)BlockHdr + total_size);
+    NewTailHdr->used      = MEMMANAGER_BLOCK_FREE;
+    NewTailHdr->next      = NULL;
+    NewTailHdr->next_free = NULL;
+    NewTailHdr->prev_free = NULL;
+    NewTailHdr->prev      = BlockHdr;
+#if defined(MEM_STATISTICS_INTERNAL)
+    NewTailHdr->buff_size = 0U;
+#endif
+#if defined(gMemManagerLightGuardsCheckEnable) && (gMemManagerLightGuardsCheckEnable == 1)
+    MEM_BlockHeaderSetGuards(NewTailHdr);
+#endif
+
+    BlockHdr->next                    = NewTailHdr;
+    p_area->ctx.FreeBlockHdrList.tail = NewTailHdr;
+
+    return BlockHdr;
+}
+
+static blockHeader_t *MEM_SegregatedFitAllocate(memAreaPrivDesc_t *p_area, uint32_t numBytes)
+{
+    uint32_t size = ROUNDUP_WORD(numBytes);
+    uint32_t size_class;
+    uint32_t class_mask;
+    blockHeader_t *BlockHdr = NULL;
+    blockHeader_t *RemainderHdr;
+
+    /* Smallest class whose blocks all fit, the last class holds every larger block so check its head */
+    size_class = (size <= 4U) ? 0U : (MEM_HighestBitSet(size - 1U) - 1U);
+    if (size_class >= MML_SIZE_CLASS_NUM)
+    {
+        size_class = MML_SIZE_CLASS_NUM - 1U;
+    }
+    class_mask = p_area->ctx.freeClassBitmap & ~((1UL << size_class) - 1UL);
+    if (class_mask != 0U)
+    {
+        BlockHdr = p_area->ctx.freeClassHead[MEM_LowestBitSet(class_mask)];
+        if (MEM_BlockSize(BlockHdr) < size)
+        {
+            BlockHdr = NULL;
+        }
+    }
+
+    if (BlockHdr == NULL)
+    {
+        BlockHdr = MEM_AllocateFromTop(p_area, size);
+        if (BlockHdr != NULL)
+        {
+            return BlockHdr;
+        }
+
+        /* Last chance before failing, the head of the class of the request may be large enough */
+        BlockHdr = p_area->ctx.freeClassHead[MEM_SizeClass(size)];
+        if ((BlockHdr == NULL) || (MEM_BlockSize(BlockHdr) < size))
+        {
+            return NULL;
+        }
+    }
+
+    MEM_FreeClassRemove(p_area, BlockHdr);
+
+    /* Give the unneeded end of the block back, its next block is in use or the top block */
+    if ((MEM_BlockSize(BlockHdr) - size) >= BLOCK_SPLIT_MIN_SIZE)
+    {
+        RemainderHdr       = (blockHeader_t *)((uint32_t)BlockHdr + BLOCK_HDR_SIZE + size);
+        RemainderHdr->next = BlockHdr->next;
+        RemainderHdr->prev = BlockHdr;
+#if defined(MEM_STATISTICS_INTERNAL)
+        RemainderHdr->buff_size = 0U;
+#endif
+#if defined(gMemManagerLightGuardsCheckEnable) && (gMemManagerLightGuardsCheckEnable == 1)
+        MEM_BlockHeaderSetGuards(RemainderHdr);
+#endif
+        BlockHdr->next->prev = RemainderHdr;
+        BlockHdr->next       = RemainderHdr;
+        MEM_FreeClassInsert(p_area, RemainderHdr);
+    }
+
+    return BlockHdr;
+}
+
+static void MEM_SegregatedFitFree(memAreaPrivDesc_t *p_area, blockHeader_t *BlockHdr)
+{
+    blockHeader_t *NextBlockHdr = BlockHdr->next;
+    blockHeader_t *PrevBlockHdr = BlockHdr->prev;
+
+    /* Free blocks never touch each other, so merging with both neighbours is enough */
+    if (NextBlockHdr->used == MEMMANAGER_BLOCK_FREE)
+    {
+        if (NextBlockHdr->next != NULL)
+        {
+            MEM_FreeClassRemove(p_area, NextBlockHdr);
+            BlockHdr->next       = NextBlockHdr->next;
+            BlockHdr->next->prev = BlockHdr;
+        }
+        else
+        {
+            /* Meld in the unused top of the area */
+            BlockHdr->next                    = NULL;
+            p_area->ctx.FreeBlockHdrList.tail = BlockHdr;
+        }
+        NextBlockHdr->used = MEMMANAGER_BLOCK_INVALID;
+    }
+
+    if ((PrevBlockHdr != NULL) && (PrevBlockHdr->used == MEMMANAGER_BLOCK_FREE))
+    {
+        MEM_FreeClassRemove(p_area, PrevBlockHdr);
+        PrevBlockHdr->next = BlockHdr->next;
+        if (BlockHdr->next != NULL)
+        {
+            BlockHdr->next->prev = PrevBlockHdr;
+        }
+        else
+        {
+            p_area->ctx.FreeBlockHdrList.tail = PrevBlockHdr;
+        }
+        BlockHdr->used = MEMMANAGER_BLOCK_INVALID;
+        BlockHdr       = PrevBlockHdr;
+    }
+
+    if (BlockHdr->next != NULL)
+    {
+        MEM_FreeClassInsert(p_area, BlockHdr);
+    }
+    else
+    {
+        BlockHdr->used      = MEMMANAGER_BLOCK_FREE;
+        BlockHdr->next_free = NULL;
+        BlockHdr->prev_free = NULL;
+    }
+}
+#endif /* gMemManagerLightSegregatedFit */
+
 /*! *********************************************************************************
 *************************************************************************************
 * Public functions
@@ -575,6 +833,11 @@ mem_status_t MEM_RegisterExtendedArea(memAreaCfg_t *area_desc, uint8_t *p_area_i
         firstBlockHdr->used      = MEMMANAGER_BLOCK_FREE;
         firstBlockHdr->next_free = NULL;
         firstBlockHdr->prev_free = NULL;
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+        firstBlockHdr->prev         = NULL;
+        p_area->ctx.freeClassBitmap = 0U;
+        (void)memset((void *)p_area->ctx.freeClassHead, 0, sizeof(p_area->ctx.freeClassHead));
+#endif
 
 #if defined(MEM_STATISTICS_INTERNAL)
         firstBlockHdr->buff_size = 0U;
@@ -606,12 +869,20 @@ static bool MEM_AreaIsEmpty(memAreaPrivDesc_t *p_area)
 {
     bool res = false;
 
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+    /* Everything melds back in the top block when the last buffer is freed */
+    if (p_area->ctx.FreeBlockHdrList.tail == (blockHeader_t *)p_area->start_address.raw_address)
+    {
+        res = true;
+    }
+#else
     blockHeader_t *FreeBlockHdr     = p_area->ctx.FreeBlockHdrList.head;
     blockHeader_t *NextFreeBlockHdr = FreeBlockHdr->next_free;
     if ((FreeBlockHdr == (blockHeader_t *)p_area->start_address.raw_address) && (NextFreeBlockHdr == NULL))
     {
         res = true;
     }
+#endif
 
     return res;
 }
@@ -678,6 +949,9 @@ static void *MEM_BufferAllocateFromArea(memAreaPrivDesc_t *p_area, uint8_t area_
 {
     uint32_t regPrimask = DisableGlobalIRQ();
 
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+    blockHeader_t *BlockHdrFound = NULL;
+#else
     blockHeader_t *FreeBlockHdr     = p_area->ctx.FreeBlockHdrList.head;
     blockHeader_t *NextFreeBlockHdr = FreeBlockHdr->next_free;
     blockHeader_t *PrevFreeBlockHdr = FreeBlockHdr->prev_free;
@@ -686,6 +960,7 @@ static void *MEM_BufferAllocateFromArea(memAreaPrivDesc_t *p_area, uint8_t area_
 #if defined(cMemManagerLightReuseFreeBlocks) && (cMemManagerLightReuseFreeBlocks > 0)
     blockHeader_t *UsableBlockHdr = NULL;
 #endif
+#endif /* gMemManagerLightSegregatedFit */
     void *buffer = NULL;
 
 #ifdef MEM_MANAGER_BENCH
@@ -693,6 +968,17 @@ static void *MEM_BufferAllocateFromArea(memAreaPrivDesc_t *p_area, uint8_t area_
     START_TIME = TM_GetTimestamp();
 #endif /* MEM_MANAGER_BENCH */
 
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+    BlockHdrFound = MEM_SegregatedFitAllocate(p_area, numBytes);
+    if (BlockHdrFound != NULL)
+    {
+        BlockHdrFound->used    = MEMMANAGER_BLOCK_USED;
+        BlockHdrFound->area_id = area_id;
+#if defined(MEM_STATISTICS_INTERNAL)
+        BlockHdrFound->buff_size = (uint16_t)numBytes;
+#endif
+    }
+#else
     do
     {
         assert(FreeBlockHdr->used == MEMMANAGER_BLOCK_FREE);
@@ -861,6 +1147,7 @@ static void *MEM_BufferAllocateFromArea(memAreaPrivDesc_t *p_area, uint8_t area_
         /* avoid looping */
         assert(FreeBlockHdr != FreeBlockHdr->next_free);
     } while (true);
+#endif /* gMemManagerLightSegregatedFit */
     /* MEM_DBG_LOG("BlockHdrFound: %x", BlockHdrFound); */
 
 #ifdef MEM_DEBUG_OUT_OF_MEMORY
@@ -997,6 +1284,13 @@ static mem_status_t MEM_BufferFreeBackToArea(memAreaPrivDesc_t *p_area, void *bu
     MEM_BufferFrees_memStatis(buffer);
 #endif /* MEM_STATISTICS_INTERNAL */
 
+#if defined(MEM_STATISTICS_INTERNAL)
+    BlockHdr->buff_size = 0U;
+#endif
+
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+    MEM_SegregatedFitFree(p_area, BlockHdr);
+#else
     if ((uint32_t)BlockHdr < (uint32_t)p_area->ctx.FreeBlockHdrList.head)
     {
         /* BlockHdr is placed before FreeBlockHdrList.head so we can set it as
@@ -1025,13 +1319,11 @@ static mem_status_t MEM_BufferFreeBackToArea(memAreaPrivDesc_t *p_area, void *bu
     }
 
     BlockHdr->used = MEMMANAGER_BLOCK_FREE;
-#if defined(MEM_STATISTICS_INTERNAL)
-    BlockHdr->buff_size = 0U;
-#endif
 
 #if defined(gMemManagerLightFreeBlocksCleanUp) && (gMemManagerLightFreeBlocksCleanUp != 0)
     MEM_BufferFreeBlocksCleanUp(p_area, BlockHdr);
 #endif
+#endif /* gMemManagerLightSegregatedFit */
     return ret;
 }
 
@@ -1195,7 +1487,12 @@ uint32_t MEM_ResetFreeHeapSizeLowWaterMarkByAreaId(uint8_t area_id)
         {
             break;
         }
-        FreeBlockHdr      = p_area->ctx.FreeBlockHdrList.head;
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+        /* The watermark follows the unused top of the area */
+        FreeBlockHdr = p_area->ctx.FreeBlockHdrList.tail;
+#else
+        FreeBlockHdr = p_area->ctx.FreeBlockHdrList.head;
+#endif
         current_footprint = (uint32_t)FreeBlockHdr + BLOCK_HDR_SIZE - 1U;
 
         /* Current allocation should never be greater than heap end */
@@ -1288,6 +1585,19 @@ void *MEM_BufferRealloc(void *buffer, uint32_t new_size)
 static uint32_t MEM_GetFreeHeapSpaceInArea(memAreaPrivDesc_t *p_area)
 {
     uint32_t free_sz = 0U;
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+    blockHeader_t *freeBlockHdr;
+
+    /* Count every free block of every size class */
+    for (uint32_t size_class = 0U; size_class < MML_SIZE_CLASS_NUM; size_class++)
+    {
+        for (freeBlockHdr = p_area->ctx.freeClassHead[size_class]; freeBlockHdr != NULL;
+             freeBlockHdr = freeBlockHdr->next_free)
+        {
+            free_sz += MEM_BlockSize(freeBlockHdr);
+        }
+    }
+#else
     /* skip unshared areas  */
     blockHeader_t *freeBlockHdr = p_area->ctx.FreeBlockHdrList.head;
 
@@ -1297,6 +1607,7 @@ static uint32_t MEM_GetFreeHeapSpaceInArea(memAreaPrivDesc_t *p_area)
         free_sz += ((uint32_t)freeBlockHdr->next - (uint32_t)freeBlockHdr - BLOCK_HDR_SIZE);
         freeBlockHdr = freeBlockHdr->next_free;
     }
+#endif
 
     /* Add remaining free space in the heap */
     free_sz += p_area->end_address.raw_address - (uint32_t)p_area->ctx.FreeBlockHdrList.tail - BLOCK_HDR_SIZE + (uint32_t)1U;
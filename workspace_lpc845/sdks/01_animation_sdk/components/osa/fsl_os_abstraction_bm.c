@@ -63,6 +63,10 @@ typedef struct TaskControlBlock
     osa_task_priority_t priority; /*!< Task's priority                        */
     osa_task_param_t param;       /*!< Task's parameter                       */
     uint8_t haveToRun;            /*!< Task was signaled                      */
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    uint8_t isQueued;                    /*!< Task is in the ready queue of its level */
+    struct TaskControlBlock *readyNext; /*!< Next task in the ready queue           */
+#endif
 } task_control_block_t;
 
 /*! @brief Type for a task pointer */
@@ -134,8 +138,24 @@ typedef struct MsgQueue
     uint16_t max;               /*!< The max number of queue messages     */
     uint16_t head;              /*!< Index of the next message to be read */
     uint16_t tail;              /*!< Index of the next place to write to  */
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+    uint16_t oldest;            /*!< Slot index of the oldest slot in use */
+    uint16_t pending;           /*!< Slots reserved or committed, from head to tail */
+    uint16_t reading;           /*!< Slots being read or not reclaimed yet, from oldest to head */
+#endif
 } msg_queue_t;
 
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+/*! @brief State of a message slot, the state bytes follow the messages in the queue memory */
+typedef enum _msg_slot_state
+{
+    kMsgSlotFree      = 0U, /*!< Not in use, or released before it was committed */
+    kMsgSlotReserved  = 1U, /*!< Written by a producer                           */
+    kMsgSlotCommitted = 2U, /*!< Holds a message                                 */
+    kMsgSlotReading   = 3U, /*!< Copied out by OSA_MsgQGet                       */
+} msg_slot_state_t;
+#endif
+
 /*! @brief Type for a message queue handler */
 typedef msg_queue_t *msg_queue_handler_t;
 
@@ -145,6 +165,11 @@ typedef struct _osa_state
 #if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
     list_label_t taskList;
     task_handler_t curTaskHandler;
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    volatile uint32_t readyMap; /* Bit (31 - level) is set when the ready queue of the level is not empty */
+    task_handler_t readyHead[FSL_OSA_BM_PRIORITY_LEVELS];
+    task_handler_t readyTail[FSL_OSA_BM_PRIORITY_LEVELS];
+#endif
 #endif
     volatile uint32_t interruptDisableCount;
     volatile uint32_t interruptRegPrimask;
@@ -174,6 +199,20 @@ __WEAK_FUNC void main_task(osa_task_param_t arg)
 }
 __WEAK_FUNC void OSA_TimeInit(void);
 __WEAK_FUNC uint32_t OSA_TimeDiff(uint32_t time_start, uint32_t time_end);
+#if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
+static void OSA_TaskSetReady(task_handler_t taskHandler);
+static int32_t OSA_TaskComparePriority(list_element_handle_t listElement, list_element_handle_t member);
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+static void OSA_TaskRemoveReady(task_handler_t taskHandler);
+__WEAK_FUNC void OSA_TaskIdleHook(void);
+#endif
+#endif
+static void OSA_MsgQCopy(uint8_t *pDest, const uint8_t *pSrc, uint32_t size);
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+static uint8_t *OSA_MsgQClaimHead(msg_queue_t *pQueue);
+static void OSA_MsgQFreeSlot(msg_queue_t *pQueue, uint32_t slot);
+static uint32_t OSA_MsgQSlotIndex(msg_queue_t *pQueue, void *pSlot);
+#endif
 
 /*! *********************************************************************************
 *************************************************************************************
@@ -405,51 +444,24 @@ osa_task_priority_t OSA_TaskGetPriority(osa_task_handle_t taskHandle)
 osa_status_t OSA_TaskSetPriority(osa_task_handle_t taskHandle, osa_task_priority_t taskPriority)
 {
     assert(taskHandle);
-    list_element_handle_t list_element;
-    task_control_block_t *tcb = NULL;
-#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
-    task_control_block_t *preTcb = NULL;
-#endif
     task_control_block_t *ptaskStruct = (task_control_block_t *)taskHandle;
     uint32_t regPrimask;
 
+    OSA_EnterCritical(&regPrimask);
     ptaskStruct->priority = taskPriority;
     (void)LIST_RemoveElement(&ptaskStruct->link);
     /* Insert task control block into the task list. */
-    list_element = LIST_GetHead(&s_osaState.taskList);
-    while (NULL != list_element)
-    {
-        tcb = (task_control_block_t *)(void *)list_element;
-        if (ptaskStruct->priority <= tcb->priority)
-        {
-#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
-            if (preTcb == NULL)
-            {
-                (&tcb->link)->list->head = (struct list_element_tag *)(void *)ptaskStruct;
-            }
-            else
-            {
-                (&preTcb->link)->next = (struct list_element_tag *)(void *)ptaskStruct;
-            }
-            (&ptaskStruct->link)->list = (&tcb->link)->list;
-            (&ptaskStruct->link)->next = (struct list_element_tag *)(void *)tcb;
-            (&ptaskStruct->link)->list->size++;
-#else
-            (void)LIST_AddPrevElement(&tcb->link, &ptaskStruct->link);
-#endif
-            break;
-        }
-#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
-        preTcb = tcb;
-#endif
-        list_element = LIST_GetNext(list_element);
-    }
-    if (ptaskStruct->priority > tcb->priority)
+    (void)LIST_AddSorted(&s_osaState.taskList, (list_element_handle_t)(void *)&(ptaskStruct->link),
+                         OSA_TaskComparePriority);
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    /* A ready task moves to the ready queue of its new level. */
+    if (0U != ptaskStruct->isQueued)
     {
-        OSA_EnterCritical(&regPrimask);
-        (void)LIST_AddTail(&s_osaState.taskList, (list_element_handle_t)(void *)&(ptaskStruct->link));
-        OSA_ExitCritical(regPrimask);
+        OSA_TaskRemoveReady(ptaskStruct);
+        OSA_TaskSetReady(ptaskStruct);
     }
+#endif
+    OSA_ExitCritical(regPrimask);
 
     return KOSA_StatusSuccess;
 }
@@ -467,12 +479,6 @@ osa_status_t OSA_TaskSetPriority(osa_task_handle_t taskHandle, osa_task_priority
 #if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
 osa_status_t OSA_TaskCreate(osa_task_handle_t taskHandle, const osa_task_def_t *thread_def, osa_task_param_t task_param)
 {
-    list_element_handle_t list_element;
-
-    task_control_block_t *tcb = NULL;
-#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
-    task_control_block_t *preTcb = NULL;
-#endif
     list_status_t listStatus;
 
     task_control_block_t *ptaskStruct = (task_control_block_t *)taskHandle;
@@ -484,52 +490,25 @@ osa_status_t OSA_TaskCreate(osa_task_handle_t taskHandle, const osa_task_def_t *
     ptaskStruct->haveToRun = 1U;
     ptaskStruct->priority  = (uint16_t)PRIORITY_OSA_TO_RTOS(thread_def->tpriority);
     ptaskStruct->param     = task_param;
-
-    list_element = LIST_GetHead(&s_osaState.taskList);
-    while (NULL != list_element)
-    {
-        tcb = (task_control_block_t *)(void *)list_element;
-        if (ptaskStruct->priority <= tcb->priority)
-        {
-            OSA_EnterCritical(&regPrimask);
-#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
-            if (preTcb == NULL)
-            {
-                (&tcb->link)->list->head = (struct list_element_tag *)(void *)ptaskStruct;
-            }
-            else
-            {
-                (&preTcb->link)->next = (struct list_element_tag *)(void *)ptaskStruct;
-            }
-            (&ptaskStruct->link)->list = (&tcb->link)->list;
-            (&ptaskStruct->link)->next = (struct list_element_tag *)(void *)tcb;
-            (&ptaskStruct->link)->list->size++;
-            OSA_ExitCritical(regPrimask);
-            return KOSA_StatusSuccess;
-#else
-            listStatus = LIST_AddPrevElement(&tcb->link, &ptaskStruct->link);
-            OSA_ExitCritical(regPrimask);
-            if (listStatus == (list_status_t)kLIST_DuplicateError)
-            {
-                return KOSA_StatusError;
-            }
-            break;
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    ptaskStruct->isQueued = 0U;
 #endif
-        }
-#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
-        preTcb = tcb;
-#endif
-        list_element = LIST_GetNext(list_element);
-    }
 
-    if ((NULL == tcb) || (ptaskStruct->priority > tcb->priority))
+    /* Insert task control block into the task list, in front of the tasks of the same priority. */
+    OSA_EnterCritical(&regPrimask);
+    listStatus = LIST_AddSorted(&s_osaState.taskList, (list_element_handle_t)(void *)&(ptaskStruct->link),
+                                OSA_TaskComparePriority);
+    OSA_ExitCritical(regPrimask);
+    if (listStatus == (list_status_t)kLIST_DuplicateError)
     {
-        OSA_EnterCritical(&regPrimask);
-        listStatus = LIST_AddTail(&s_osaState.taskList, (list_element_handle_t)(void *)&(ptaskStruct->link));
-        (void)listStatus;
-        assert(listStatus == kLIST_Ok);
-        OSA_ExitCritical(regPrimask);
+        return KOSA_StatusError;
     }
+    assert(listStatus == kLIST_Ok);
+
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    /* Only a task in the task list is queued, a rejected one must not be scheduled. */
+    OSA_TaskSetReady(ptaskStruct);
+#endif
 
     return KOSA_StatusSuccess;
 }
@@ -551,6 +530,9 @@ osa_status_t OSA_TaskDestroy(osa_task_handle_t taskHandle)
 
     OSA_EnterCritical(&regPrimask);
     (void)LIST_RemoveElement(taskHandle);
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    OSA_TaskRemoveReady((task_handler_t)taskHandle);
+#endif
     OSA_ExitCritical(regPrimask);
     return KOSA_StatusSuccess;
 }
@@ -824,7 +806,7 @@ osa_status_t OSA_SemaphorePost(osa_semaphore_handle_t semaphoreHandle)
 #if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
     if (pSemStruct->waitingTask != NULL)
     {
-        pSemStruct->waitingTask->haveToRun = 1U;
+        OSA_TaskSetReady(pSemStruct->waitingTask);
     }
 #endif
 
@@ -1020,7 +1002,7 @@ osa_status_t OSA_EventSet(osa_event_handle_t eventHandle, osa_event_flags_t flag
 #if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
     if (pEventStruct->waitingTask != NULL)
     {
-        pEventStruct->waitingTask->haveToRun = 1U;
+        OSA_TaskSetReady(pEventStruct->waitingTask);
     }
 #endif
     OSA_ExitCritical(regPrimask);
@@ -1047,7 +1029,7 @@ osa_status_t OSA_EventClear(osa_event_handle_t eventHandle, osa_event_flags_t fl
 #if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
         if (NULL != pEventStruct->waitingTask)
         {
-            pEventStruct->waitingTask->haveToRun = 1U;
+            OSA_TaskSetReady(pEventStruct->waitingTask);
         }
 #endif
     }
@@ -1194,6 +1176,237 @@ osa_status_t OSA_EventDestroy(osa_event_handle_t eventHandle)
     return KOSA_StatusSuccess;
 }
 
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQCopy
+ * Description   : This function copies a message, word by word if both buffers and
+ * the size are 4 byte aligned.
+ *
+ *END**************************************************************************/
+static void OSA_MsgQCopy(uint8_t *pDest, const uint8_t *pSrc, uint32_t size)
+{
+    uint32_t i;
+
+    if (0U == ((((uintptr_t)pDest) | ((uintptr_t)pSrc) | size) & 3U))
+    {
+        for (i = 0U; i < (size / 4U); i++)
+        {
+            ((uint32_t *)(void *)pDest)[i] = ((const uint32_t *)(const void *)pSrc)[i];
+        }
+    }
+    else
+    {
+        for (i = 0U; i < size; i++)
+        {
+            pDest[i] = pSrc[i];
+        }
+    }
+}
+
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQClaimHead
+ * Description   : This function skips the released slots at the head of the queue
+ * and claims the head message for reading if it is committed. It is called in a
+ * critical section.
+ * Return        : The claimed message, NULL if there is none.
+ *
+ *END**************************************************************************/
+static uint8_t *OSA_MsgQClaimHead(msg_queue_t *pQueue)
+{
+    uint8_t *pState = &pQueue->queueMem[pQueue->max * pQueue->size];
+    uint8_t *pMsg   = NULL;
+
+    while (0U != pQueue->pending)
+    {
+        if ((uint8_t)kMsgSlotReserved == pState[pQueue->head])
+        {
+            /* Messages are read in the order of their reservations. */
+            break;
+        }
+
+        if ((uint8_t)kMsgSlotCommitted == pState[pQueue->head])
+        {
+            pState[pQueue->head] = (uint8_t)kMsgSlotReading;
+            pMsg                 = &pQueue->queueMem[pQueue->head * pQueue->size];
+            pQueue->number--;
+            pQueue->reading++;
+        }
+        else if (0U == pQueue->reading)
+        {
+            /* A released slot with no slot in use before it is reclaimed at once. */
+            pQueue->oldest = (uint16_t)(((pQueue->head + 1U) < pQueue->max) ? (pQueue->head + 1U) : 0U);
+        }
+        else
+        {
+            pQueue->reading++;
+        }
+
+        pQueue->head++;
+        if (pQueue->head >= pQueue->max)
+        {
+            pQueue->head = 0U;
+        }
+        pQueue->pending--;
+
+        if (NULL != pMsg)
+        {
+            break;
+        }
+    }
+
+    return pMsg;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQFreeSlot
+ * Description   : This function frees a slot and reclaims the free slots behind the
+ * head in order, a slot is only written again once all slots before it are free.
+ * It is called in a critical section.
+ *
+ *END**************************************************************************/
+static void OSA_MsgQFreeSlot(msg_queue_t *pQueue, uint32_t slot)
+{
+    uint8_t *pState = &pQueue->queueMem[pQueue->max * pQueue->size];
+
+    pState[slot] = (uint8_t)kMsgSlotFree;
+
+    while ((0U != pQueue->reading) && ((uint8_t)kMsgSlotFree == pState[pQueue->oldest]))
+    {
+        pQueue->oldest++;
+        if (pQueue->oldest >= pQueue->max)
+        {
+            pQueue->oldest = 0U;
+        }
+        pQueue->reading--;
+    }
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQSlotIndex
+ * Description   : This function gets the index of a slot in the queue memory.
+ *
+ *END**************************************************************************/
+static uint32_t OSA_MsgQSlotIndex(msg_queue_t *pQueue, void *pSlot)
+{
+    uint32_t slot = (uint32_t)((uint8_t *)pSlot - pQueue->queueMem) / pQueue->size;
+
+    assert(slot < pQueue->max);
+
+    return slot;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQReserve
+ * Description   : This function reserves a message slot at the end of the queue.
+ * Return        : KOSA_StatusSuccess if a slot is reserved, otherwise return KOSA_StatusError.
+ *
+ *END**************************************************************************/
+osa_status_t OSA_MsgQReserve(osa_msgq_handle_t msgqHandle, void **ppSlot)
+{
+    assert(msgqHandle);
+    assert(ppSlot);
+    msg_queue_t *pQueue = (msg_queue_t *)msgqHandle;
+    osa_status_t status = KOSA_StatusError;
+    uint32_t regPrimask;
+
+    OSA_EnterCritical(&regPrimask);
+    if ((NULL != pQueue->queueMem) && ((pQueue->pending + pQueue->reading) < pQueue->max))
+    {
+        pQueue->queueMem[(pQueue->max * pQueue->size) + pQueue->tail] = (uint8_t)kMsgSlotReserved;
+        *ppSlot = &pQueue->queueMem[pQueue->tail * pQueue->size];
+
+        pQueue->tail++;
+        if (pQueue->tail >= pQueue->max)
+        {
+            pQueue->tail = 0U;
+        }
+        pQueue->pending++;
+        status = KOSA_StatusSuccess;
+    }
+    OSA_ExitCritical(regPrimask);
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQCommit
+ * Description   : This function puts the message of a reserved slot into the queue.
+ * Return        : KOSA_StatusSuccess if the message is put, otherwise return KOSA_StatusError.
+ *
+ *END**************************************************************************/
+osa_status_t OSA_MsgQCommit(osa_msgq_handle_t msgqHandle, void *pSlot)
+{
+    assert(msgqHandle);
+    msg_queue_t *pQueue = (msg_queue_t *)msgqHandle;
+    osa_status_t status = KOSA_StatusError;
+    uint32_t regPrimask;
+    uint32_t slot;
+
+    if (NULL == pQueue->queueMem)
+    {
+        return KOSA_StatusError;
+    }
+
+    slot = OSA_MsgQSlotIndex(pQueue, pSlot);
+
+    OSA_EnterCritical(&regPrimask);
+    if (NULL != pQueue->queueMem)
+    {
+        pQueue->queueMem[(pQueue->max * pQueue->size) + slot] = (uint8_t)kMsgSlotCommitted;
+        pQueue->number++;
+#if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
+        if (NULL != pQueue->waitingTask)
+        {
+            OSA_TaskSetReady(pQueue->waitingTask);
+        }
+#endif
+        status = KOSA_StatusSuccess;
+    }
+    OSA_ExitCritical(regPrimask);
+
+    return status;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_MsgQRelease
+ * Description   : This function gives a reserved slot back, OSA_MsgQGet skips it.
+ * Return        : KOSA_StatusSuccess if the slot is released, otherwise return KOSA_StatusError.
+ *
+ *END**************************************************************************/
+osa_status_t OSA_MsgQRelease(osa_msgq_handle_t msgqHandle, void *pSlot)
+{
+    assert(msgqHandle);
+    msg_queue_t *pQueue = (msg_queue_t *)msgqHandle;
+    osa_status_t status = KOSA_StatusError;
+    uint32_t regPrimask;
+    uint32_t slot;
+
+    if (NULL == pQueue->queueMem)
+    {
+        return KOSA_StatusError;
+    }
+
+    slot = OSA_MsgQSlotIndex(pQueue, pSlot);
+
+    OSA_EnterCritical(&regPrimask);
+    if (NULL != pQueue->queueMem)
+    {
+        OSA_MsgQFreeSlot(pQueue, slot);
+        status = KOSA_StatusSuccess;
+    }
+    OSA_ExitCritical(regPrimask);
+
+    return status;
+}
+#endif /* FSL_OSA_BM_MSGQ_SLOTS */
+
 /*FUNCTION**********************************************************************
  *
  * Function Name : OSA_MsgQCreate
@@ -1214,6 +1427,12 @@ osa_status_t OSA_MsgQCreate(osa_msgq_handle_t msgqHandle, uint32_t msgNo, uint32
     pMsgQStruct->tail     = 0;
     pMsgQStruct->size     = msgSize;
     pMsgQStruct->queueMem = (uint8_t *)((uint8_t *)msgqHandle + sizeof(msg_queue_t));
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+    pMsgQStruct->oldest  = 0;
+    pMsgQStruct->pending = 0;
+    pMsgQStruct->reading = 0;
+    (void)memset(&pMsgQStruct->queueMem[msgNo * msgSize], (int)kMsgSlotFree, msgNo);
+#endif
     return KOSA_StatusSuccess;
 }
 
@@ -1229,6 +1448,21 @@ osa_status_t OSA_MsgQPut(osa_msgq_handle_t msgqHandle, osa_msg_handle_t pMessage
     assert(msgqHandle);
     msg_queue_t *pQueue;
     osa_status_t status = KOSA_StatusSuccess;
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+    void *pSlot;
+
+    pQueue = (msg_queue_t *)msgqHandle;
+
+    /* Only the reservation and the commit run with the interrupts disabled. */
+    status = OSA_MsgQReserve(msgqHandle, &pSlot);
+    if (KOSA_StatusSuccess == status)
+    {
+        OSA_MsgQCopy((uint8_t *)pSlot, (const uint8_t *)pMessage, pQueue->size);
+        status = OSA_MsgQCommit(msgqHandle, pSlot);
+    }
+
+    return status;
+#else
     uint32_t regPrimask;
 
     uint8_t *pMsgArray;
@@ -1248,10 +1482,7 @@ osa_status_t OSA_MsgQPut(osa_msgq_handle_t msgqHandle, osa_msg_handle_t pMessage
     else
     {
         pMsgArray = &pQueue->queueMem[pQueue->tail];
-        for (uint32_t i = 0; i < pQueue->size; i++)
-        {
-            pMsgArray[i] = *((uint8_t *)pMessage + i);
-        }
+        OSA_MsgQCopy(pMsgArray, (const uint8_t *)pMessage, pQueue->size);
 
         pQueue->number++;
         pQueue->tail += (uint16_t)pQueue->size;
@@ -1263,12 +1494,13 @@ osa_status_t OSA_MsgQPut(osa_msgq_handle_t msgqHandle, osa_msg_handle_t pMessage
 #if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
         if (NULL != pQueue->waitingTask)
         {
-            pQueue->waitingTask->haveToRun = 1U;
+            OSA_TaskSetReady(pQueue->waitingTask);
         }
 #endif
     }
     OSA_ExitCritical(regPrimask);
     return status;
+#endif /* FSL_OSA_BM_MSGQ_SLOTS */
 }
 /*FUNCTION**********************************************************************
  *
@@ -1290,7 +1522,9 @@ osa_status_t OSA_MsgQGet(osa_msgq_handle_t msgqHandle, osa_msg_handle_t pMessage
     osa_status_t status = KOSA_StatusSuccess;
     uint32_t regPrimask;
 
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
     uint8_t *pMsgArray;
+#endif
 
 #if (FSL_OSA_BM_TIMER_CONFIG != FSL_OSA_BM_TIMER_NONE)
     uint32_t currentTime;
@@ -1308,13 +1542,18 @@ osa_status_t OSA_MsgQGet(osa_msgq_handle_t msgqHandle, osa_msg_handle_t pMessage
 #endif
 
     OSA_EnterCritical(&regPrimask);
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+    pMsgArray = OSA_MsgQClaimHead(pQueue);
+    if (NULL != pMsgArray)
+    {
+        /* The message is copied once the interrupts are enabled again. */
+        pQueue->isWaiting = 0U;
+        status            = KOSA_StatusSuccess;
+    }
+#else
     if (0U != pQueue->number)
     {
-        pMsgArray = (uint8_t *)pMessage;
-        for (uint32_t i = 0; i < pQueue->size; i++)
-        {
-            pMsgArray[i] = pQueue->queueMem[pQueue->head + i];
-        }
+        OSA_MsgQCopy((uint8_t *)pMessage, &pQueue->queueMem[pQueue->head], pQueue->size);
 
         pQueue->number--;
         pQueue->head += (uint16_t)pQueue->size;
@@ -1326,6 +1565,7 @@ osa_status_t OSA_MsgQGet(osa_msgq_handle_t msgqHandle, osa_msg_handle_t pMessage
         }
         status = KOSA_StatusSuccess;
     }
+#endif /* FSL_OSA_BM_MSGQ_SLOTS */
     else
     {
         if (0U == millisec)
@@ -1364,6 +1604,22 @@ osa_status_t OSA_MsgQGet(osa_msgq_handle_t msgqHandle, osa_msg_handle_t pMessage
     }
     OSA_ExitCritical(regPrimask);
 
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+    if (NULL != pMsgArray)
+    {
+        uint32_t slot = OSA_MsgQSlotIndex(pQueue, pMsgArray);
+
+        OSA_MsgQCopy((uint8_t *)pMessage, pMsgArray, pQueue->size);
+
+        OSA_EnterCritical(&regPrimask);
+        if (NULL != pQueue->queueMem)
+        {
+            OSA_MsgQFreeSlot(pQueue, slot);
+        }
+        OSA_ExitCritical(regPrimask);
+    }
+#endif
+
     return status;
 }
 
@@ -1464,6 +1720,126 @@ int main(void)
     return 0;
 }
 #endif /*(defined(FSL_OSA_MAIN_FUNC_ENABLE) && (FSL_OSA_MAIN_FUNC_ENABLE > 0U))*/
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskComparePriority
+ * Description   : Orders the task list by priority, a task goes in front of the
+ * tasks of the same priority.
+ *
+ *END**************************************************************************/
+static int32_t OSA_TaskComparePriority(list_element_handle_t listElement, list_element_handle_t member)
+{
+    task_handler_t task = (task_handler_t)(void *)listElement;
+    task_handler_t tcb  = (task_handler_t)(void *)member;
+
+    return (task->priority <= tcb->priority) ? -1 : 1;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskSetReady
+ * Description   : Marks a task as signaled. With the bitmap scheduler the task
+ * also goes to the tail of the ready queue of its priority level, unless it is
+ * queued already.
+ *
+ *END**************************************************************************/
+static void OSA_TaskSetReady(task_handler_t taskHandler)
+{
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    uint32_t regPrimask;
+    uint32_t level = (taskHandler->priority < (FSL_OSA_BM_PRIORITY_LEVELS - 1U)) ? (uint32_t)taskHandler->priority :
+                                                                                   (FSL_OSA_BM_PRIORITY_LEVELS - 1U);
+
+    OSA_EnterCritical(&regPrimask);
+    taskHandler->haveToRun = 1U;
+    if (0U == taskHandler->isQueued)
+    {
+        taskHandler->isQueued  = 1U;
+        taskHandler->readyNext = NULL;
+        if (NULL == s_osaState.readyTail[level])
+        {
+            s_osaState.readyHead[level] = taskHandler;
+            s_osaState.readyMap |= 0x80000000U >> level;
+        }
+        else
+        {
+            s_osaState.readyTail[level]->readyNext = taskHandler;
+        }
+        s_osaState.readyTail[level] = taskHandler;
+    }
+    OSA_ExitCritical(regPrimask);
+#else
+    taskHandler->haveToRun = 1U;
+#endif
+}
+
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskRemoveReady
+ * Description   : Takes a task out of the ready queues, called with interrupts
+ * disabled when the task is destroyed or its priority changes.
+ *
+ *END**************************************************************************/
+static void OSA_TaskRemoveReady(task_handler_t taskHandler)
+{
+    task_handler_t prev = NULL;
+    task_handler_t tcb;
+    uint32_t level;
+
+    if (0U == taskHandler->isQueued)
+    {
+        return;
+    }
+
+    /* The priority may have changed since the task was queued, look at all levels. */
+    for (level = 0U; level < FSL_OSA_BM_PRIORITY_LEVELS; level++)
+    {
+        for (tcb = s_osaState.readyHead[level]; (NULL != tcb) && (tcb != taskHandler); tcb = tcb->readyNext)
+        {
+            prev = tcb;
+        }
+
+        if (NULL != tcb)
+        {
+            if (NULL == prev)
+            {
+                s_osaState.readyHead[level] = tcb->readyNext;
+            }
+            else
+            {
+                prev->readyNext = tcb->readyNext;
+            }
+            if (s_osaState.readyTail[level] == tcb)
+            {
+                s_osaState.readyTail[level] = prev;
+            }
+            if (NULL == s_osaState.readyHead[level])
+            {
+                s_osaState.readyMap &= ~(0x80000000U >> level);
+            }
+            break;
+        }
+        prev = NULL;
+    }
+
+    taskHandler->isQueued = 0U;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : OSA_TaskIdleHook
+ * Description   : Called by OSA_Start with interrupts disabled when no task is
+ * ready. Waits for the next interrupt, which wakes the core even with
+ * interrupts disabled and runs once they are enabled again.
+ *
+ *END**************************************************************************/
+__WEAK_FUNC void OSA_TaskIdleHook(void)
+{
+    __WFI();
+}
+#endif /* FSL_OSA_BM_SCHEDULER_BITMAP */
 #endif /* FSL_OSA_TASK_ENABLE */
 
 /*FUNCTION**********************************************************************
@@ -1477,6 +1853,11 @@ int main(void)
 void OSA_Init(void)
 {
     LIST_Init((&s_osaState.taskList), 0);
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    s_osaState.readyMap = 0U;
+    (void)memset(s_osaState.readyHead, 0, sizeof(s_osaState.readyHead));
+    (void)memset(s_osaState.readyTail, 0, sizeof(s_osaState.readyTail));
+#endif
     s_osaState.curTaskHandler        = NULL;
     s_osaState.interruptDisableCount = 0U;
     s_osaState.tickCounter           = 0U;
@@ -1492,12 +1873,24 @@ void OSA_Init(void)
 #if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
 void OSA_Start(void)
 {
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    uint32_t regPrimask;
+#endif
 #if (FSL_OSA_BM_TIMER_CONFIG != FSL_OSA_BM_TIMER_NONE)
     OSA_TimeInit();
 #endif
     while (true)
     {
         OSA_ProcessTasks();
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+        /* Sleep until an interrupt, the check and the WFI must not be split by a wakeup. */
+        regPrimask = DisableGlobalIRQ();
+        if (0U == OSA_TaskShouldYield())
+        {
+            OSA_TaskIdleHook();
+        }
+        EnableGlobalIRQ(regPrimask);
+#endif
     }
 }
 
@@ -1507,6 +1900,47 @@ void OSA_Start(void)
  * Description   : This function is used to process registered tasks.
  *
  *END**************************************************************************/
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+void OSA_ProcessTasks(void)
+{
+    task_control_block_t *tcb;
+    uint32_t regPrimask;
+    uint32_t level;
+
+    OSA_EnterCritical(&regPrimask);
+    while (0U != s_osaState.readyMap)
+    {
+        /* Take the head of the highest ready level, bit 31 is level 0. */
+        level                       = __CLZ(s_osaState.readyMap);
+        tcb                         = s_osaState.readyHead[level];
+        s_osaState.readyHead[level] = tcb->readyNext;
+        if (NULL == tcb->readyNext)
+        {
+            s_osaState.readyTail[level] = NULL;
+            s_osaState.readyMap &= ~(0x80000000U >> level);
+        }
+        tcb->isQueued = 0U;
+
+        /* A task that waits again stays queued until it is popped, skip it. */
+        if (0U != tcb->haveToRun)
+        {
+            OSA_ExitCritical(regPrimask);
+            s_osaState.curTaskHandler = (osa_task_handle_t)tcb;
+            if (NULL != tcb->p_func)
+            {
+                tcb->p_func(tcb->param);
+            }
+            OSA_EnterCritical(&regPrimask);
+            /* Still signaled, run again after the other ready tasks of the level. */
+            if (0U != tcb->haveToRun)
+            {
+                OSA_TaskSetReady(tcb);
+            }
+        }
+    }
+    OSA_ExitCritical(regPrimask);
+}
+#else
 void OSA_ProcessTasks(void)
 {
     list_element_handle_t list_element;
@@ -1531,6 +1965,7 @@ void OSA_ProcessTasks(void)
         }
     }
 }
+#endif /* FSL_OSA_BM_SCHEDULER_BITMAP */
 
 /*FUNCTION**********************************************************************
  *
@@ -1540,6 +1975,9 @@ void OSA_ProcessTasks(void)
  *END**************************************************************************/
 uint8_t OSA_TaskShouldYield(void)
 {
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+    return (0U != s_osaState.readyMap) ? 1U : 0U;
+#else
     list_element_handle_t list_element;
     uint8_t status = 0;
     task_control_block_t *tcb;
@@ -1556,6 +1994,7 @@ uint8_t OSA_TaskShouldYield(void)
         list_element = LIST_GetNext(list_element);
     }
     return status;
+#endif
 }
 #endif
 
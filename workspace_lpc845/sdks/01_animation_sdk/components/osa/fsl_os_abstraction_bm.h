@@ -77,6 +77,69 @@ void OSA_ProcessTasks(void);
  */
 uint8_t OSA_TaskShouldYield(void);
 
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+/*!
+ * @brief OSA idle hook
+ *
+ * With the bitmap scheduler, OSA_Start calls this function with interrupts disabled when no task
+ * is ready. The default implementation executes WFI, a pending interrupt wakes the core and is
+ * served once OSA_Start enables the interrupts again. Applications may override it, e.g. to enter
+ * a deeper low power mode.
+ */
+void OSA_TaskIdleHook(void);
+#endif
+
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+/*!
+ * @brief Reserves a message slot at the end of the queue.
+ *
+ * The caller writes the message directly into the queue memory and passes the slot to
+ * OSA_MsgQCommit, or gives it back with OSA_MsgQRelease. Messages are read in the order of their
+ * reservations, a reserved slot holds back the messages reserved after it until it is committed
+ * or released, so keep the time between the two calls short. Can be called from interrupts.
+ *
+ * @code
+ *   msg_t *pMsg;
+ *   if (KOSA_StatusSuccess == OSA_MsgQReserve((osa_msgq_handle_t)msgqHandle, (void **)&pMsg))
+ *   {
+ *       pMsg->value = value;
+ *       (void)OSA_MsgQCommit((osa_msgq_handle_t)msgqHandle, pMsg);
+ *   }
+ * @endcode
+ *
+ * @param msgqHandle Message Queue handler.
+ * @param ppSlot Returns the message slot, 4 byte aligned when the message size is a multiple of 4.
+ *
+ * @retval KOSA_StatusSuccess The slot is reserved.
+ * @retval KOSA_StatusError   The queue is full or was destroyed.
+ */
+osa_status_t OSA_MsgQReserve(osa_msgq_handle_t msgqHandle, void **ppSlot);
+
+/*!
+ * @brief Commits a reserved message slot.
+ *
+ * The message becomes available to OSA_MsgQGet and the task waiting for the queue is set ready.
+ *
+ * @param msgqHandle Message Queue handler.
+ * @param pSlot The slot returned by OSA_MsgQReserve.
+ *
+ * @retval KOSA_StatusSuccess The message was put into the queue.
+ * @retval KOSA_StatusError   The queue was destroyed.
+ */
+osa_status_t OSA_MsgQCommit(osa_msgq_handle_t msgqHandle, void *pSlot);
+
+/*!
+ * @brief Releases a reserved message slot without putting a message.
+ *
+ * @param msgqHandle Message Queue handler.
+ * @param pSlot The slot returned by OSA_MsgQReserve.
+ *
+ * @retval KOSA_StatusSuccess The slot was given back.
+ * @retval KOSA_StatusError   The queue was destroyed.
+ */
+osa_status_t OSA_MsgQRelease(osa_msgq_handle_t msgqHandle, void *pSlot);
+#endif
+
 /*!
  * @brief Correct OSA tick counter for when exiting sleep
  *
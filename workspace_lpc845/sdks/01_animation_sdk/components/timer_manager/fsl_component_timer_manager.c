@@ -96,10 +96,14 @@ typedef enum _timer_state
 typedef struct _timer_handle_struct_t
 {
     struct _timer_handle_struct_t *next; /*!< LIST_ element of the link */
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+    struct _timer_handle_struct_t *nextActive; /*!< Next timer of the delta queue */
+#endif
     volatile uint8_t tmrStatus;          /*!< Timer status */
     volatile uint8_t tmrType;            /*!< Timer mode*/
     uint64_t timeoutInUs;                /*!< Time out of the timer, should be microseconds */
-    uint64_t remainingUs;                /*!< Remaining of the timer, should be microseconds */
+    uint64_t remainingUs; /*!< Remaining of the timer, should be microseconds, relative to the previous timer of the
+                             delta queue when TM_ENABLE_DELTA_QUEUE is set */
     timer_callback_t pfCallBack;         /*!< Callback function of the timer */
     void *param;                         /*!< Parameter of callback function of the timer */
 } timer_handle_struct_t;
@@ -110,6 +114,9 @@ typedef struct _timermanager_state
     uint32_t mUsActiveInTimerInterval;            /*!< Timer active intervl in microseconds */
     uint32_t previousTimeInUs;                    /*!< Previous timer count in microseconds */
     timer_handle_struct_t *timerHead;             /*!< Timer list head */
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+    timer_handle_struct_t *activeHead; /*!< Delta queue head, the active timer expiring first */
+#endif
     TIMER_HANDLE_DEFINE(halTimerHandle);          /*!< Timer handle buffer */
 #if (defined(TM_ENABLE_TIME_STAMP) && (TM_ENABLE_TIME_STAMP > 0U))
     TIME_STAMP_HANDLE_DEFINE(halTimeStampHandle); /*!< Time stamp handle buffer */
@@ -257,6 +264,81 @@ static void TimerMarkTimerFree(timer_handle_t timerHandle)
     timer->tmrStatus             = 0;
 }
 
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+/*! -------------------------------------------------------------------------
+ * \brief     Insert a timer in the delta queue, must be called with interrupts masked
+ * \param[in] timer - the timer
+ * \param[in] timeoutUs - time until the timer expires, from the last time update
+ *---------------------------------------------------------------------------*/
+static void TimerQueueInsert(timer_handle_struct_t *timer, uint64_t timeoutUs)
+{
+    timer_handle_struct_t **link = &s_timermanager.activeHead;
+
+    /* Timers with the same expiry time keep their start order */
+    while ((NULL != *link) && ((*link)->remainingUs <= timeoutUs))
+    {
+        timeoutUs -= (*link)->remainingUs;
+        link = &(*link)->nextActive;
+    }
+    if (NULL != *link)
+    {
+        (*link)->remainingUs -= timeoutUs;
+    }
+    timer->remainingUs = timeoutUs;
+    timer->nextActive  = *link;
+    *link              = timer;
+}
+
+/*! -------------------------------------------------------------------------
+ * \brief     Remove a timer from the delta queue, must be called with interrupts masked
+ * \param[in] timer - the timer
+ *---------------------------------------------------------------------------*/
+static void TimerQueueRemove(timer_handle_struct_t *timer)
+{
+    timer_handle_struct_t **link = &s_timermanager.activeHead;
+
+    while ((NULL != *link) && (*link != timer))
+    {
+        link = &(*link)->nextActive;
+    }
+    if (NULL != *link)
+    {
+        /* The next timer inherits the time left to this one */
+        if (NULL != timer->nextActive)
+        {
+            timer->nextActive->remainingUs += timer->remainingUs;
+        }
+        *link             = timer->nextActive;
+        timer->nextActive = NULL;
+    }
+}
+
+/*! -------------------------------------------------------------------------
+ * \brief     Time left until a queued timer expires, from the last time update
+ * \param[in] timer - the timer
+ * \param[in] timerType - only stop at a timer of this type when timer is NULL
+ * \param[out] found - the timer that was reached, NULL if none
+ * \return    sum of the deltas up to the timer
+ *---------------------------------------------------------------------------*/
+static uint64_t TimerQueueTimeLeft(timer_handle_struct_t *timer, uint8_t timerType, timer_handle_struct_t **found)
+{
+    timer_handle_struct_t *th = s_timermanager.activeHead;
+    uint64_t timeLeft         = 0U;
+
+    while (NULL != th)
+    {
+        timeLeft += th->remainingUs;
+        if ((th == timer) || ((NULL == timer) && ((timerType & TimerGetTimerType(th)) > 0U)))
+        {
+            break;
+        }
+        th = th->nextActive;
+    }
+    *found = th;
+    return timeLeft;
+}
+#endif /* TM_ENABLE_DELTA_QUEUE */
+
 /*! -------------------------------------------------------------------------
  * \brief  Notify Timer task to run.
  * \return
@@ -281,6 +363,31 @@ static void NotifyTimersTask(void)
  *---------------------------------------------------------------------------*/
 TIMER_MANAGER_STATIC void TimersUpdate(bool updateRemainingUs, bool updateOnlyPowerTimer, uint32_t remainingUs)
 {
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+    /* The elapsed time is consumed from the head of the delta queue, it only walks over the
+     * timers it expires. Low power and normal timers share the queue. */
+    timer_handle_struct_t *th = s_timermanager.activeHead;
+    uint64_t elapsedUs        = remainingUs;
+
+    (void)updateOnlyPowerTimer;
+    if (updateRemainingUs)
+    {
+        while ((NULL != th) && (0U != elapsedUs))
+        {
+            if (th->remainingUs > elapsedUs)
+            {
+                th->remainingUs -= elapsedUs;
+                elapsedUs = 0U;
+            }
+            else
+            {
+                elapsedUs -= th->remainingUs;
+                th->remainingUs = 0U;
+                th              = th->nextActive;
+            }
+        }
+    }
+#else
     timer_handle_struct_t *th = s_timermanager.timerHead;
 
     if ((s_timermanager.numberOfLowPowerActiveTimers != 0U) || (s_timermanager.numberOfActiveTimers != 0U))
@@ -309,6 +416,7 @@ TIMER_MANAGER_STATIC void TimersUpdate(bool updateRemainingUs, bool updateOnlyPo
             th = th->next;
         }
     }
+#endif /* TM_ENABLE_DELTA_QUEUE */
 }
 
 /*! -------------------------------------------------------------------------
@@ -326,7 +434,42 @@ static void TimerManagerTaskProcess(bool isInTaskContext)
     uint8_t activeLPTimerNum, activeTimerNum;
     uint32_t regPrimask               = DisableGlobalIRQ();
     s_timermanager.mUsInTimerInterval = HAL_TimerGetMaxTimeout((hal_timer_handle_t)s_timermanager.halTimerHandle);
-    timer_handle_struct_t *th         = s_timermanager.timerHead;
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+    timer_handle_struct_t *th;
+
+    (void)state;
+    /* Expired timers are the zero deltas at the head of the queue */
+    th = s_timermanager.activeHead;
+    while ((NULL != th) && (0U == th->remainingUs) && (isInTaskContext == true))
+    {
+        timerType = TimerGetTimerType(th);
+        if (0U != (timerType & (uint32_t)(kTimerModeSingleShot)))
+        {
+            (void)TimerStop(th);
+        }
+        else
+        {
+            /* Restart the interval timer, a zero interval would expire again forever */
+            s_timermanager.activeHead = th->nextActive;
+            TimerQueueInsert(th, (0U != th->timeoutInUs) ? th->timeoutInUs : 1U);
+        }
+
+        /* This timer has expired. */
+        /*Call callback if it is not NULL*/
+        EnableGlobalIRQ(regPrimask);
+        if (NULL != th->pfCallBack)
+        {
+            th->pfCallBack(th->param);
+        }
+        regPrimask = DisableGlobalIRQ();
+        th         = s_timermanager.activeHead;
+    }
+    if ((NULL != th) && (s_timermanager.mUsInTimerInterval > th->remainingUs))
+    {
+        s_timermanager.mUsInTimerInterval = (uint32_t)th->remainingUs;
+    }
+#else
+    timer_handle_struct_t *th = s_timermanager.timerHead;
     timer_handle_struct_t *th_next;
     while (NULL != th)
     {
@@ -381,6 +524,7 @@ static void TimerManagerTaskProcess(bool isInTaskContext)
         }
         th = th_next;
     }
+#endif /* TM_ENABLE_DELTA_QUEUE */
     if (s_timermanager.mUsInTimerInterval < TM_MIN_TIMER_INTERVAL)
     {
         s_timermanager.mUsInTimerInterval = TM_MIN_TIMER_INTERVAL;
@@ -536,6 +680,9 @@ static timer_status_t TimerStop(timer_handle_t timerHandle)
         if ((state == kTimerStateActive_c) || (state == kTimerStateReady_c))
         {
             TimerSetTimerStatus(timerHandle, (uint8_t)kTimerStateInactive_c);
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+            TimerQueueRemove((timer_handle_struct_t *)timerHandle);
+#endif
             DecrementActiveTimerNumber(TimerGetTimerType(timerHandle));
             /* if no sw active timers are enabled, */
             /* call the TimerManagerTask() to countdown the ticks and stop the hw timer*/
@@ -565,9 +712,18 @@ TIMER_MANAGER_STATIC void TimerEnable(timer_handle_t timerHandle)
     if ((uint8_t)kTimerStateInactive_c == TimerGetTimerStatus(timerHandle))
     {
         IncrementActiveTimerNumber(TimerGetTimerType(timerHandle));
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+        /* Bring the queue up to date first, the timeout counts from now. The timer is queued
+         * right away, so it goes active without waiting for the timer task. */
+        currentTimerCount = HAL_TimerGetCurrentTimerCount((hal_timer_handle_t)s_timermanager.halTimerHandle);
+        TimersUpdateWithoutSyncTask(currentTimerCount);
+        TimerQueueInsert((timer_handle_struct_t *)timerHandle, ((timer_handle_struct_t *)timerHandle)->timeoutInUs);
+        TimerSetTimerStatus(timerHandle, (uint8_t)kTimerStateActive_c);
+#else
         TimerSetTimerStatus(timerHandle, (uint8_t)kTimerStateReady_c);
         currentTimerCount = HAL_TimerGetCurrentTimerCount((hal_timer_handle_t)s_timermanager.halTimerHandle);
         TimersUpdateWithoutSyncTask(currentTimerCount);
+#endif
     }
     EnableGlobalIRQ(regPrimask);
     NotifyTimersTask();
@@ -712,6 +868,12 @@ void TM_EnterTickless(timer_handle_t timerHandle, uint64_t timerTimeout)
 
     uint32_t regPrimask = DisableGlobalIRQ();
 
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+    /* The queue must be up to date before the timer is inserted */
+    remainingUs = HAL_TimerGetCurrentTimerCount((hal_timer_handle_t)s_timermanager.halTimerHandle);
+    TimersUpdateWithoutSyncTask(remainingUs);
+#endif
+
     if (timerTimeout > 0U)
     {
         /* Set current timer as a single shot timer */
@@ -719,11 +881,19 @@ void TM_EnterTickless(timer_handle_t timerHandle, uint64_t timerTimeout)
 
         /* Register timeout */
         th->timeoutInUs = timerTimeout;
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+        TimerQueueInsert(th, timerTimeout);
+
+        /* Enable timer */
+        ++s_timermanager.numberOfActiveTimers;
+        TimerSetTimerStatus(timerHandle, (uint8_t)kTimerStateActive_c);
+#else
         th->remainingUs = timerTimeout;
 
         /* Enable timer */
         ++s_timermanager.numberOfActiveTimers;
         TimerSetTimerStatus(timerHandle, (uint8_t)kTimerStateReady_c);
+#endif
     }
 
     /* Sync directly the timer manager ressources while bypassing the task
@@ -731,8 +901,12 @@ void TM_EnterTickless(timer_handle_t timerHandle, uint64_t timerTimeout)
      * interrupts
      * This should guarantuee that the device will wake up at the latest in
      * timerTimeout usec */
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+    TimerManagerTaskProcess(false);
+#else
     remainingUs = HAL_TimerGetCurrentTimerCount((hal_timer_handle_t)s_timermanager.halTimerHandle);
     TimersUpdateDirectSync(remainingUs);
+#endif
 
     EnableGlobalIRQ(regPrimask);
 }
@@ -1001,9 +1175,26 @@ uint32_t TM_GetRemainingTime(timer_handle_t timerHandle)
 {
     timer_handle_struct_t *timerState = timerHandle;
     assert(timerHandle);
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+    timer_handle_struct_t *found;
+    uint64_t timeLeft;
+    uint32_t elapsedUs;
+    uint32_t regPrimask = DisableGlobalIRQ();
+
+    timeLeft  = TimerQueueTimeLeft(timerState, 0U, &found);
+    elapsedUs = HAL_TimerGetCurrentTimerCount((hal_timer_handle_t)s_timermanager.halTimerHandle) -
+                s_timermanager.previousTimeInUs;
+    EnableGlobalIRQ(regPrimask);
+    if ((NULL == found) || (timeLeft <= elapsedUs))
+    {
+        return 0U;
+    }
+    return (uint32_t)(timeLeft - elapsedUs);
+#else
     return ((uint32_t)(timerState->remainingUs) -
             (uint32_t)(HAL_TimerGetCurrentTimerCount((hal_timer_handle_t)s_timermanager.halTimerHandle) -
                        s_timermanager.previousTimeInUs));
+#endif
 }
 
 /*!
@@ -1018,6 +1209,21 @@ uint32_t TM_GetFirstExpireTime(uint8_t timerType)
     uint32_t min = 0xFFFFFFFFU;
     uint32_t remainingTime;
 
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+    /* The queue is sorted, the first timer of the type expires first */
+    timer_handle_struct_t *found;
+    uint64_t timeLeft;
+    uint32_t regPrimask = DisableGlobalIRQ();
+
+    timeLeft      = TimerQueueTimeLeft(NULL, timerType, &found);
+    remainingTime = HAL_TimerGetCurrentTimerCount((hal_timer_handle_t)s_timermanager.halTimerHandle) -
+                    s_timermanager.previousTimeInUs;
+    EnableGlobalIRQ(regPrimask);
+    if (NULL != found)
+    {
+        min = (timeLeft > remainingTime) ? (uint32_t)(timeLeft - remainingTime) : 0U;
+    }
+#else
     timer_handle_struct_t *th = s_timermanager.timerHead;
     while (NULL != th)
     {
@@ -1031,6 +1237,7 @@ uint32_t TM_GetFirstExpireTime(uint8_t timerType)
         }
         th = th->next;
     }
+#endif
     return min;
 }
 
@@ -89,9 +89,23 @@
 #ifndef TM_ENABLE_TIME_STAMP
 #define TM_ENABLE_TIME_STAMP (0)
 #endif
+/*
+ * @brief   Enable/Disable the delta queue of active timers
+ * The active timers are kept sorted by expiry time, each one storing its remaining time relative to the
+ * previous one. Time accounting and expiry only touch the expired timers instead of every opened timer,
+ * and the hardware timer is programmed straight to the first expiry.
+ * VALID RANGE: TRUE/FALSE
+ */
+#ifndef TM_ENABLE_DELTA_QUEUE
+#define TM_ENABLE_DELTA_QUEUE (0)
+#endif
 
 /*! @brief Definition of timer manager handle size. */
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+#define TIMER_HANDLE_SIZE (40U)
+#else
 #define TIMER_HANDLE_SIZE (32U)
+#endif
 
 /*!
  * @brief Defines the timer manager handle
@@ -157,18 +157,30 @@
 #  # description: SCT Driver
 #  set(CONFIG_USE_driver_sctimer true)
 
+#  # description: SCT PWM Waveform Driver
+#  set(CONFIG_USE_driver_sctimer_pwm_wave true)
+
 #  # description: PINT Driver
 #  set(CONFIG_USE_driver_pint true)
 
+#  # description: PINT Capture Driver
+#  set(CONFIG_USE_driver_pint_capture true)
+
 #  # description: MRT Driver
 #  set(CONFIG_USE_driver_mrt true)
 
 #  # description: USART Driver
 #  set(CONFIG_USE_driver_lpc_miniusart true)
 
+#  # description: USART DMA Driver
+#  set(CONFIG_USE_driver_lpc_miniusart_dma true)
+
 #  # description: SPI Driver
 #  set(CONFIG_USE_driver_lpc_minispi true)
 
+#  # description: SPI DMA Driver
+#  set(CONFIG_USE_driver_lpc_minispi_dma true)
+
 #  # description: IOCON Driver
 #  set(CONFIG_USE_driver_lpc_iocon_lite true)
 
@@ -178,6 +190,9 @@
 #  # description: I2C Driver
 #  set(CONFIG_USE_driver_lpc_i2c_dma true)
 
+#  # description: I2C Transaction Queue Driver
+#  set(CONFIG_USE_driver_lpc_i2c_queue true)
+
 #  # description: GPIO Driver
 #  set(CONFIG_USE_driver_lpc_gpio true)
 
@@ -193,6 +208,9 @@
 #  # description: ADC Driver
 #  set(CONFIG_USE_driver_lpc_adc true)
 
+#  # description: ADC DMA Driver
+#  set(CONFIG_USE_driver_lpc_adc_dma true)
+
 #  # description: LPC_ACOMP Driver
 #  set(CONFIG_USE_driver_lpc_acomp true)
 
@@ -202,12 +220,18 @@
 #  # description: IAP Driver
 #  set(CONFIG_USE_driver_iap true)
 
+#  # description: IAP Store Driver
+#  set(CONFIG_USE_driver_iap_store true)
+
 #  # description: CTimer Driver
 #  set(CONFIG_USE_driver_ctimer true)
 
 #  # description: CAPT Driver
 #  set(CONFIG_USE_driver_capt true)
 
+#  # description: CAPT Touch Driver
+#  set(CONFIG_USE_driver_capt_touch true)
+
 #  # description: Component miniusart_adapter
 #  set(CONFIG_USE_component_miniusart_adapter true)
 
@@ -395,28 +419,36 @@ include_if_use(device_project_template.LPC845)
 include_if_use(device_startup.LPC845)
 include_if_use(device_system.LPC845)
 include_if_use(driver_capt.LPC845)
+include_if_use(driver_capt_touch.LPC845)
 include_if_use(driver_clock.LPC845)
 include_if_use(driver_common.LPC845)
 include_if_use(driver_ctimer.LPC845)
 include_if_use(driver_iap.LPC845)
+include_if_use(driver_iap_store.LPC845)
 include_if_use(driver_inputmux.LPC845)
 include_if_use(driver_inputmux_connections.LPC845)
 include_if_use(driver_lpc_acomp.LPC845)
 include_if_use(driver_lpc_adc.LPC845)
+include_if_use(driver_lpc_adc_dma.LPC845)
 include_if_use(driver_lpc_crc.LPC845)
 include_if_use(driver_lpc_dac.LPC845)
 include_if_use(driver_lpc_dma.LPC845)
 include_if_use(driver_lpc_gpio.LPC845)
 include_if_use(driver_lpc_i2c.LPC845)
 include_if_use(driver_lpc_i2c_dma.LPC845)
+include_if_use(driver_lpc_i2c_queue.LPC845)
 include_if_use(driver_lpc_iocon_lite.LPC845)
 include_if_use(driver_lpc_minispi.LPC845)
+include_if_use(driver_lpc_minispi_dma.LPC845)
 include_if_use(driver_lpc_miniusart.LPC845)
+include_if_use(driver_lpc_miniusart_dma.LPC845)
 include_if_use(driver_mrt.LPC845)
 include_if_use(driver_pint.LPC845)
+include_if_use(driver_pint_capture.LPC845)
 include_if_use(driver_power.LPC845)
 include_if_use(driver_reset.LPC845)
 include_if_use(driver_sctimer.LPC845)
+include_if_use(driver_sctimer_pwm_wave.LPC845)
 include_if_use(driver_swm.LPC845)
 include_if_use(driver_swm_connections.LPC845)
 include_if_use(driver_syscon.LPC845)
@@ -0,0 +1,322 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef FSL_CAPT_TOUCH_H_
+#define FSL_CAPT_TOUCH_H_
+
+#include "fsl_capt.h"
+#include "fsl_dma.h"
+
+/*!
+ * @addtogroup capt_touch_driver
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*! @{ */
+/*! @brief CAPT touch driver version. */
+#define FSL_CAPT_TOUCH_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*! @} */
+
+/*! @brief Number of X pins the XPINSEL field selects. */
+#define CAPT_TOUCH_MAX_PINS (16U)
+
+/*! @brief Number of link descriptors the application provides for the scan. */
+#define CAPT_TOUCH_DESCRIPTOR_NUM (2U)
+
+/*! @brief Fraction bits of the filtered counts and baselines. */
+#define CAPT_TOUCH_FRAC_BITS (8U)
+
+/*! @brief Slider position when no slider pin is touched. */
+#define CAPT_TOUCH_SLIDER_RELEASED (0xFFFFU)
+
+/*! @brief Get the count from a TOUCH word stored by the DMA. */
+#define CAPT_TOUCH_SAMPLE_COUNT(sample) (((sample)&CAPT_TOUCH_COUNT_MASK) >> CAPT_TOUCH_COUNT_SHIFT)
+
+/*! @brief Get the X pin from a TOUCH word stored by the DMA. */
+#define CAPT_TOUCH_SAMPLE_XPIN(sample) (((sample)&CAPT_TOUCH_XVAL_MASK) >> CAPT_TOUCH_XVAL_SHIFT)
+
+/*! @brief Events reported to the callback, several may be set at once. */
+enum
+{
+    kCAPT_TouchEventCalibrated = 1U << 0U, /*!< The baselines are calibrated, the keys are decoded from now on. */
+    kCAPT_TouchEventKeys       = 1U << 1U, /*!< A key was touched or released, see CAPT_TouchGetKeys. */
+    kCAPT_TouchEventSlider     = 1U << 2U, /*!< The slider position changed, see CAPT_TouchGetSliderPosition. */
+    kCAPT_TouchEventLowPower   = 1U << 3U, /*!< The CAPT polls in low-power mode, the DMA is stopped. */
+    kCAPT_TouchEventWakeUp     = 1U << 4U, /*!< A touch in low-power mode restarted the scan. */
+    kCAPT_TouchEventDmaError   = 1U << 5U, /*!< The DMA reported an error, the scan is stopped. */
+};
+
+/*! @brief State of the touch pipeline. */
+typedef enum _capt_touch_state
+{
+    kCAPT_TouchStateIdle          = 0U, /*!< Stopped. */
+    kCAPT_TouchStateScan          = 1U, /*!< Continuous polling, the DMA stores every measurement. */
+    kCAPT_TouchStateLowPowerEntry = 2U, /*!< Poll-now of all X pins together to set the low-power threshold. */
+    kCAPT_TouchStateLowPower      = 3U, /*!< Low-power polling, the CAPT interrupt wakes the core on a touch. */
+} capt_touch_state_t;
+
+/*! @brief Touch pipeline configuration. */
+typedef struct _capt_touch_config
+{
+    uint16_t keyPins;            /*!< X pins decoded as keys, mask of _capt_xpins. */
+    const uint8_t *sliderPins;   /*!< X pin numbers of the slider from one end to the other, NULL for none. */
+    uint8_t sliderPinCount;      /*!< Pins of the slider, 2 or more, 0 for none. */
+    uint16_t sliderRange;        /*!< Slider positions, 0 at the first pin and sliderRange - 1 at the last one. */
+    uint8_t filterShift;         /*!< IIR filter of the counts, each round moves 1/2^filterShift towards the count. */
+    uint8_t baselineShift;       /*!< IIR filter of the baselines, slower than the filter to follow the drift only. */
+    uint16_t touchThreshold;     /*!< Counts from the baseline that touch a pin. */
+    uint16_t releaseThreshold;   /*!< Counts from the baseline under which a touched pin is released. */
+    uint8_t touchDebounce;       /*!< Rounds over touchThreshold before a pin is touched. */
+    uint8_t releaseDebounce;     /*!< Rounds under releaseThreshold before a pin is released. */
+    uint8_t calibrationRounds;   /*!< Rounds that set the baselines after CAPT_TouchStart. */
+    uint16_t stuckRounds;        /*!< Rounds a pin stays touched before its baseline is reset, 0 for never. */
+    uint16_t lowPowerIdleRounds; /*!< Rounds without a touch before the low-power mode, 0 for never. */
+    uint16_t lowPowerThreshold;  /*!< Counts from the combined count of all pins that wake the core. */
+} capt_touch_config_t;
+
+/*! @brief Filter and debounce state of an X pin. */
+typedef struct _capt_touch_channel
+{
+    uint32_t filtered;    /*!< Filtered count, CAPT_TOUCH_FRAC_BITS fraction bits. */
+    uint32_t baseline;    /*!< Count without a touch, CAPT_TOUCH_FRAC_BITS fraction bits. */
+    int16_t delta;        /*!< Counts from the baseline, positive towards a touch. */
+    uint16_t touchRounds; /*!< Rounds the pin is touched. */
+    uint8_t debounce;     /*!< Rounds the touch or release condition held. */
+    bool touched;         /*!< Debounced touch state. */
+} capt_touch_channel_t;
+
+/*! @brief Statistics of the touch pipeline. */
+typedef struct _capt_touch_stats
+{
+    uint32_t rounds;          /*!< Polling rounds processed. */
+    uint32_t timeouts;        /*!< Measurements that timed out. */
+    uint32_t lowPowerEntries; /*!< Entries into the low-power mode. */
+    uint32_t wakeUps;         /*!< Touches that woke the core in low-power mode. */
+    uint32_t stuckResets;     /*!< Baselines reset after stuckRounds. */
+} capt_touch_stats_t;
+
+/*! @brief CAPT touch handle typedef. */
+typedef struct _capt_touch_handle capt_touch_handle_t;
+
+/*!
+ * @brief CAPT touch callback typedef.
+ *
+ * Called from the DMA interrupt after a polling round changed the keys or the slider, and from the
+ * CAPT interrupt when the low-power mode starts or ends.
+ */
+typedef void (*capt_touch_callback_t)(CAPT_Type *base, capt_touch_handle_t *handle, uint32_t events, void *userData);
+
+/*! @brief CAPT touch handle structure. */
+struct _capt_touch_handle
+{
+    CAPT_Type *base;                                   /*!< CAPT peripheral base address. */
+    dma_handle_t *dmaHandle;                           /*!< The DMA handle used. */
+    dma_descriptor_t *descriptors;                     /*!< CAPT_TOUCH_DESCRIPTOR_NUM link descriptors. */
+    uint32_t buffer[2U * CAPT_TOUCH_MAX_PINS];         /*!< Ping-pong buffer, one polling round per block. */
+    uint32_t blockSize;                                /*!< Measurements of a polling round. */
+    capt_touch_channel_t channel[CAPT_TOUCH_MAX_PINS]; /*!< State of the X pins. */
+    uint16_t xpins;                                    /*!< X pins polled, keys and slider. */
+    uint16_t keyPins;                                  /*!< X pins decoded as keys. */
+    uint16_t reseed;                                   /*!< X pins whose filter restarts from the next count. */
+    bool resync;                                       /*!< Correct the baselines for the drift in low-power mode. */
+    uint8_t sliderPins[CAPT_TOUCH_MAX_PINS];           /*!< X pins of the slider in order. */
+    uint8_t sliderPinCount;                            /*!< Pins of the slider. */
+    uint16_t sliderRange;                              /*!< Slider positions. */
+    uint8_t filterShift;                               /*!< See capt_touch_config_t. */
+    uint8_t baselineShift;                             /*!< See capt_touch_config_t. */
+    uint16_t touchThreshold;                           /*!< See capt_touch_config_t. */
+    uint16_t releaseThreshold;                         /*!< See capt_touch_config_t. */
+    uint8_t touchDebounce;                             /*!< See capt_touch_config_t. */
+    uint8_t releaseDebounce;                           /*!< See capt_touch_config_t. */
+    uint8_t calibrationRounds;                         /*!< See capt_touch_config_t. */
+    uint8_t calibrationLeft;                           /*!< Calibration rounds still to process. */
+    uint16_t stuckRounds;                              /*!< See capt_touch_config_t. */
+    uint16_t lowPowerIdleRounds;                       /*!< See capt_touch_config_t. */
+    uint16_t lowPowerThreshold;                        /*!< See capt_touch_config_t. */
+    uint16_t idleRounds;                               /*!< Rounds without a touch. */
+    bool touchLower;                                   /*!< A touch lowers the count, TCHLOWER of POLL_TCNT. */
+    volatile capt_touch_state_t state;                 /*!< State of the pipeline. */
+    volatile uint16_t keys;                            /*!< Touched keys, mask of _capt_xpins. */
+    volatile uint16_t sliderPosition;                  /*!< Slider position or CAPT_TOUCH_SLIDER_RELEASED. */
+    uint16_t lowPowerCount;                            /*!< Combined count of all pins, sets TCNT. */
+    capt_touch_stats_t stats;                          /*!< Statistics. */
+    capt_touch_callback_t callback;                    /*!< Callback function called on the events. */
+    void *userData;                                    /*!< Callback parameter passed to callback function. */
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /*_cplusplus. */
+
+/*!
+ * @name CAPT Touch Operation
+ * @{
+ */
+
+/*!
+ * @brief Gets the default touch pipeline configuration.
+ *
+ * @code
+ *   config->keyPins            = 0U;
+ *   config->sliderPins         = NULL;
+ *   config->sliderPinCount     = 0U;
+ *   config->sliderRange        = 256U;
+ *   config->filterShift        = 1U;
+ *   config->baselineShift      = 6U;
+ *   config->touchThreshold     = 60U;
+ *   config->releaseThreshold   = 40U;
+ *   config->touchDebounce      = 2U;
+ *   config->releaseDebounce    = 2U;
+ *   config->calibrationRounds  = 8U;
+ *   config->stuckRounds        = 2000U;
+ *   config->lowPowerIdleRounds = 0U;
+ *   config->lowPowerThreshold  = 10U;
+ * @endcode
+ *
+ * @param config Returns the default configuration.
+ */
+void CAPT_TouchGetDefaultConfig(capt_touch_config_t *config);
+
+/*!
+ * @brief Init the CAPT touch handle.
+ *
+ * The CAPT is configured with CAPT_Init before, its pollCount sets the rate of the polling rounds
+ * and enableTouchLower the direction of a touch. The DMA channel must be enabled, the CAPT request
+ * of the channel is kDmaRequestCAPT_DMA.
+ *
+ * @code
+ * DMA_ALLOCATE_LINK_DESCRIPTORS(s_captDescriptors, CAPT_TOUCH_DESCRIPTOR_NUM);
+ *
+ * CAPT_Init(CAPT, &captConfig);
+ * DMA_Init(DMA0);
+ * DMA_EnableChannel(DMA0, kDmaRequestCAPT_DMA);
+ * DMA_CreateHandle(&dmaHandle, DMA0, kDmaRequestCAPT_DMA);
+ * CAPT_TouchCreateHandle(CAPT, &touchHandle, &touchConfig, callback, NULL, &dmaHandle, s_captDescriptors);
+ * CAPT_TouchStart(CAPT, &touchHandle);
+ * @endcode
+ *
+ * @param base CAPT peripheral base address.
+ * @param handle pointer to capt_touch_handle_t structure.
+ * @param config Touch pipeline configuration.
+ * @param callback pointer to user callback function.
+ * @param userData user param passed to the callback function.
+ * @param dmaHandle DMA handle pointer.
+ * @param descriptors CAPT_TOUCH_DESCRIPTOR_NUM link descriptors allocated with DMA_ALLOCATE_LINK_DESCRIPTORS.
+ * @retval kStatus_Success The handle is ready.
+ * @retval kStatus_InvalidArgument No pin, a slider pin out of range or a release threshold over the touch one.
+ */
+status_t CAPT_TouchCreateHandle(CAPT_Type *base,
+                                capt_touch_handle_t *handle,
+                                const capt_touch_config_t *config,
+                                capt_touch_callback_t callback,
+                                void *userData,
+                                dma_handle_t *dmaHandle,
+                                dma_descriptor_t *descriptors);
+
+/*!
+ * @brief Calibrates the baselines and starts the scan.
+ *
+ * The CAPT polls the pins continuously and the DMA stores every measurement, the pins of a round are
+ * processed together when its block is full. The first calibrationRounds rounds set the baselines,
+ * the pins must not be touched.
+ *
+ * @param base CAPT peripheral base address.
+ * @param handle pointer to capt_touch_handle_t structure.
+ * @retval kStatus_Success The scan was started.
+ * @retval kStatus_Busy The DMA channel is still in use.
+ */
+status_t CAPT_TouchStart(CAPT_Type *base, capt_touch_handle_t *handle);
+
+/*!
+ * @brief Stops the CAPT and the DMA.
+ *
+ * @param base CAPT peripheral base address.
+ * @param handle pointer to capt_touch_handle_t structure.
+ */
+void CAPT_TouchStop(CAPT_Type *base, capt_touch_handle_t *handle);
+
+/*!
+ * @brief Switches to the low-power mode.
+ *
+ * The DMA stops and one poll-now of all pins together sets the threshold of the low-power polling,
+ * lowPowerThreshold counts from it. Then only a touch raises the CAPT interrupt and the scan restarts.
+ * The first round after the wake-up corrects the baselines for the drift, the pins far from the touch
+ * take their count and the touched ones move by the mean drift of those. The pipeline switches by
+ * itself after lowPowerIdleRounds rounds without a touch.
+ *
+ * @param base CAPT peripheral base address.
+ * @param handle pointer to capt_touch_handle_t structure.
+ * @retval kStatus_Success The low-power mode is entered.
+ * @retval kStatus_Fail The scan is not running or still calibrates.
+ */
+status_t CAPT_TouchEnterLowPower(CAPT_Type *base, capt_touch_handle_t *handle);
+
+/*!
+ * @brief CAPT interrupt handler of the touch pipeline.
+ *
+ * Call it from CMP_CAPT_IRQHandler, it handles the low-power mode only.
+ *
+ * @param base CAPT peripheral base address.
+ * @param handle pointer to capt_touch_handle_t structure.
+ */
+void CAPT_TouchHandleIRQ(CAPT_Type *base, capt_touch_handle_t *handle);
+
+/*!
+ * @brief Processes the measurements of one polling round.
+ *
+ * Filters the count of each pin, tracks its baseline while it is not touched, debounces the touch
+ * and decodes the keys and the slider once for the round. The DMA callback calls it for each block,
+ * rounds read by other means, e.g. recorded ones, can be fed directly.
+ *
+ * @param handle pointer to capt_touch_handle_t structure.
+ * @param samples TOUCH register words, one per pin.
+ * @param count Number of words.
+ * @return Events of the round, see kCAPT_TouchEventKeys.
+ */
+uint32_t CAPT_TouchProcessRound(capt_touch_handle_t *handle, const uint32_t *samples, uint32_t count);
+
+/*!
+ * @brief Gets the touched keys.
+ *
+ * @param handle pointer to capt_touch_handle_t structure.
+ * @return Mask of the touched key pins.
+ */
+static inline uint16_t CAPT_TouchGetKeys(capt_touch_handle_t *handle)
+{
+    return handle->keys;
+}
+
+/*!
+ * @brief Gets the slider position.
+ *
+ * @param handle pointer to capt_touch_handle_t structure.
+ * @return Position from 0 to sliderRange - 1, CAPT_TOUCH_SLIDER_RELEASED when not touched.
+ */
+static inline uint16_t CAPT_TouchGetSliderPosition(capt_touch_handle_t *handle)
+{
+    return handle->sliderPosition;
+}
+
+/*!
+ * @brief Gets the statistics of the touch pipeline.
+ *
+ * @param handle pointer to capt_touch_handle_t structure.
+ * @param stats Returns the statistics.
+ */
+void CAPT_TouchGetStats(capt_touch_handle_t *handle, capt_touch_stats_t *stats);
+
+/*! @} */
+#if defined(__cplusplus)
+}
+#endif /*_cplusplus. */
+/*! @} */
+#endif /*FSL_CAPT_TOUCH_H_*/
@@ -63,14 +63,14 @@ static const reset_ip_name_t s_i2cResets[] = I2C_RSTS_N;
 #endif
 
 #if defined(FSL_SDK_ENABLE_I2C_DRIVER_TRANSACTIONAL_APIS) && (FSL_SDK_ENABLE_I2C_DRIVER_TRANSACTIONAL_APIS)
-/*! @brief Pointers to i2c handles for each instance. */
-static void *s_i2cHandle[FSL_FEATURE_SOC_I2C_COUNT];
+/*! @brief Pointers to i2c handles for each instance, shared with the I2C DMA driver. */
+void *s_i2cHandle[FSL_FEATURE_SOC_I2C_COUNT];
 
 /*! @brief IRQ name array */
 static IRQn_Type const s_i2cIRQ[] = I2C_IRQS;
 
-/*! @brief Pointer to master IRQ handler for each instance. */
-static i2c_isr_t s_i2cMasterIsr;
+/*! @brief Pointer to master IRQ handler for each instance, shared with the I2C DMA driver. */
+i2c_isr_t s_i2cMasterIsr;
 
 /*! @brief Pointer to slave IRQ handler for each instance. */
 static i2c_isr_t s_i2cSlaveIsr;
@@ -29,14 +29,14 @@ typedef struct _i2c_master_dma_private_handle
  ******************************************************************************/
 
 #if defined(FSL_SDK_ENABLE_I2C_DRIVER_TRANSACTIONAL_APIS) && (FSL_SDK_ENABLE_I2C_DRIVER_TRANSACTIONAL_APIS)
-/*! @brief Pointers to i2c handles for each instance. */
-static void *s_i2cHandle[FSL_FEATURE_SOC_I2C_COUNT];
+/*! @brief Pointers to i2c handles for each instance, the I2C driver dispatches the interrupts. */
+extern void *s_i2cHandle[FSL_FEATURE_SOC_I2C_COUNT];
 
 /*! @brief IRQ name array */
 static IRQn_Type const s_i2cIRQ[] = I2C_IRQS;
 
 /*! @brief Pointer to master IRQ handler for each instance. */
-static i2c_isr_t s_i2cMasterIsr;
+extern i2c_isr_t s_i2cMasterIsr;
 
 #endif /* FSL_SDK_ENABLE_I2C_DRIVER_TRANSACTIONAL_APIS */
 
@@ -23,7 +23,7 @@
 /*! @name Driver version */
 /*! @{ */
 /*! @brief I2C DMA driver version. */
-#define FSL_I2C_DMA_DRIVER_VERSION (MAKE_VERSION(2, 1, 0))
+#define FSL_I2C_DMA_DRIVER_VERSION (MAKE_VERSION(2, 1, 1))
 /*! @} */
 
 /*! @brief Maximum lenght of single DMA transfer (determined by capability of the DMA engine) */
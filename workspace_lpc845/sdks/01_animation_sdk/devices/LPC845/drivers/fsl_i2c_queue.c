@@ -0,0 +1,505 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "fsl_i2c_queue.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.lpc_i2c_queue"
+#endif
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void I2C_QueueTransferCallback(I2C_Type *base, i2c_master_handle_t *handle, status_t status, void *userData);
+static void I2C_QueueTransferCallbackDMA(I2C_Type *base,
+                                         i2c_master_dma_handle_t *handle,
+                                         status_t status,
+                                         void *userData);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t I2C_QueueGetTime(i2c_queue_handle_t *handle)
+{
+    return (handle->timestamp != NULL) ? handle->timestamp() : 0U;
+}
+
+static void I2C_QueueInitHandle(I2C_Type *base,
+                                i2c_queue_handle_t *handle,
+                                i2c_queue_callback_t callback,
+                                void *userData,
+                                i2c_queue_timestamp_t timestamp)
+{
+    (void)memset(handle, 0, sizeof(*handle));
+
+    handle->base      = base;
+    handle->callback  = callback;
+    handle->userData  = userData;
+    handle->timestamp = timestamp;
+}
+
+/* Appends the transactions to the queue, called with interrupts disabled. */
+static void I2C_QueueAppend(i2c_queue_handle_t *handle,
+                            i2c_queue_transaction_t *transactions,
+                            size_t count,
+                            i2c_queue_burst_t *burst)
+{
+    uint32_t now = I2C_QueueGetTime(handle);
+    size_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        transactions[i].status    = kStatus_I2C_Busy;
+        transactions[i].queueTime = now;
+        transactions[i].burst     = burst;
+        transactions[i].next      = (i < (count - 1U)) ? &transactions[i + 1U] : NULL;
+    }
+
+    if (handle->tail == NULL)
+    {
+        handle->head = &transactions[0];
+    }
+    else
+    {
+        handle->tail->next = &transactions[0];
+    }
+    handle->tail = &transactions[count - 1U];
+}
+
+/*
+ * Records the completion of the running transaction, called with interrupts disabled.
+ * Returns true when it was the last transaction of a burst.
+ */
+static bool I2C_QueueFinish(i2c_queue_handle_t *handle, i2c_queue_transaction_t *transaction, status_t status)
+{
+    i2c_queue_burst_t *burst = transaction->burst;
+    uint32_t now             = I2C_QueueGetTime(handle);
+    bool burstDone           = false;
+
+    transaction->doneTime = now;
+    handle->lastDoneTime  = now;
+    if ((now - transaction->queueTime) > handle->stats.maxLatency)
+    {
+        handle->stats.maxLatency = now - transaction->queueTime;
+    }
+
+    if (status == kStatus_Success)
+    {
+        handle->stats.completed++;
+    }
+    else
+    {
+        handle->stats.failed++;
+    }
+
+    if (burst != NULL)
+    {
+        if ((status != kStatus_Success) && (burst->status == kStatus_Success))
+        {
+            burst->status = status;
+        }
+        burst->remaining--;
+        burstDone = (burst->remaining == 0U);
+    }
+
+    transaction->status = status;
+    handle->active      = NULL;
+
+    return burstDone;
+}
+
+static void I2C_QueueNotify(i2c_queue_handle_t *handle, i2c_queue_transaction_t *transaction, bool burstDone)
+{
+    i2c_queue_burst_t *burst = transaction->burst;
+
+    if (handle->callback != NULL)
+    {
+        handle->callback(handle->base, handle, transaction, handle->userData);
+    }
+
+    if (burstDone && (burst->callback != NULL))
+    {
+        burst->callback(handle->base, handle, burst, burst->status, burst->userData);
+    }
+}
+
+/* Starts the queued transactions while the bus is idle. */
+static void I2C_QueueRun(i2c_queue_handle_t *handle)
+{
+    i2c_queue_transaction_t *transaction;
+    uint32_t regPrimask;
+    uint32_t idleSince;
+    uint32_t now;
+    status_t status;
+    bool burstDone;
+
+    for (;;)
+    {
+        regPrimask = DisableGlobalIRQ();
+
+        transaction = handle->head;
+        if ((handle->active != NULL) || (transaction == NULL))
+        {
+            EnableGlobalIRQ(regPrimask);
+            break;
+        }
+
+        handle->head = transaction->next;
+        if (handle->head == NULL)
+        {
+            handle->tail = NULL;
+        }
+        handle->active = transaction;
+
+        /* The bus is idle since the last completion or since the submission, whatever came later. */
+        now       = I2C_QueueGetTime(handle);
+        idleSince = ((int32_t)(transaction->queueTime - handle->lastDoneTime) > 0) ? transaction->queueTime :
+                                                                                      handle->lastDoneTime;
+        if ((now - idleSince) > handle->stats.maxGap)
+        {
+            handle->stats.maxGap = now - idleSince;
+        }
+        transaction->startTime = now;
+
+        if (handle->useDma)
+        {
+            status = I2C_MasterTransferDMA(handle->base, &handle->driver.dma, &transaction->xfer);
+        }
+        else
+        {
+            status = I2C_MasterTransferNonBlocking(handle->base, &handle->driver.master, &transaction->xfer);
+        }
+
+        if (status == kStatus_Success)
+        {
+            EnableGlobalIRQ(regPrimask);
+            break;
+        }
+
+        burstDone = I2C_QueueFinish(handle, transaction, status);
+        EnableGlobalIRQ(regPrimask);
+        I2C_QueueNotify(handle, transaction, burstDone);
+    }
+}
+
+/* Completes the running transaction from the I2C interrupt and chains the next one. */
+static void I2C_QueueComplete(i2c_queue_handle_t *handle, status_t status)
+{
+    i2c_queue_transaction_t *transaction;
+    uint32_t regPrimask;
+    bool burstDone;
+
+    regPrimask  = DisableGlobalIRQ();
+    transaction = handle->active;
+    burstDone   = I2C_QueueFinish(handle, transaction, status);
+    EnableGlobalIRQ(regPrimask);
+
+    I2C_QueueRun(handle);
+    I2C_QueueNotify(handle, transaction, burstDone);
+}
+
+static void I2C_QueueTransferCallback(I2C_Type *base, i2c_master_handle_t *handle, status_t status, void *userData)
+{
+    I2C_QueueComplete((i2c_queue_handle_t *)userData, status);
+}
+
+static void I2C_QueueTransferCallbackDMA(I2C_Type *base,
+                                         i2c_master_dma_handle_t *handle,
+                                         status_t status,
+                                         void *userData)
+{
+    I2C_QueueComplete((i2c_queue_handle_t *)userData, status);
+}
+
+/*!
+ * brief Initializes the transaction queue on top of the interrupt transfer driver.
+ *
+ * param base I2C peripheral base address.
+ * param handle Transaction queue handle.
+ * param callback Transaction callback, NULL if none.
+ * param userData User data for the transaction callback.
+ * param timestamp Timestamp source for the latencies, NULL if none.
+ */
+void I2C_QueueCreateHandle(I2C_Type *base,
+                           i2c_queue_handle_t *handle,
+                           i2c_queue_callback_t callback,
+                           void *userData,
+                           i2c_queue_timestamp_t timestamp)
+{
+    assert(handle != NULL);
+
+    I2C_QueueInitHandle(base, handle, callback, userData, timestamp);
+    I2C_MasterTransferCreateHandle(base, &handle->driver.master, I2C_QueueTransferCallback, handle);
+}
+
+/*!
+ * brief Initializes the transaction queue on top of the DMA transfer driver.
+ *
+ * param base I2C peripheral base address.
+ * param handle Transaction queue handle.
+ * param dmaHandle DMA handle of the I2C master request channel.
+ * param callback Transaction callback, NULL if none.
+ * param userData User data for the transaction callback.
+ * param timestamp Timestamp source for the latencies, NULL if none.
+ */
+void I2C_QueueCreateHandleDMA(I2C_Type *base,
+                              i2c_queue_handle_t *handle,
+                              dma_handle_t *dmaHandle,
+                              i2c_queue_callback_t callback,
+                              void *userData,
+                              i2c_queue_timestamp_t timestamp)
+{
+    assert(handle != NULL);
+    assert(dmaHandle != NULL);
+
+    I2C_QueueInitHandle(base, handle, callback, userData, timestamp);
+    handle->useDma = true;
+    I2C_MasterTransferCreateHandleDMA(base, &handle->driver.dma, I2C_QueueTransferCallbackDMA, handle, dmaHandle);
+}
+
+/*!
+ * brief Prepares a register read or write.
+ *
+ * param transaction Transaction to prepare.
+ * param slaveAddress 7-bit slave address.
+ * param direction kI2C_Read or kI2C_Write.
+ * param reg Register address, sent MSB first before the data.
+ * param regSize Size of the register address in bytes, 0 to 4.
+ * param data Data to read or write.
+ * param dataSize Number of data bytes.
+ */
+void I2C_QueuePrepareTransaction(i2c_queue_transaction_t *transaction,
+                                 uint8_t slaveAddress,
+                                 i2c_direction_t direction,
+                                 uint32_t reg,
+                                 size_t regSize,
+                                 void *data,
+                                 size_t dataSize)
+{
+    assert(transaction != NULL);
+
+    (void)memset(transaction, 0, sizeof(*transaction));
+
+    transaction->xfer.flags          = (uint32_t)kI2C_TransferDefaultFlag;
+    transaction->xfer.slaveAddress   = slaveAddress;
+    transaction->xfer.direction      = direction;
+    transaction->xfer.subaddress     = reg;
+    transaction->xfer.subaddressSize = regSize;
+    transaction->xfer.data           = data;
+    transaction->xfer.dataSize       = dataSize;
+    transaction->status              = kStatus_NoTransferInProgress;
+}
+
+/*!
+ * brief Queues transactions.
+ *
+ * param base I2C peripheral base address.
+ * param handle Transaction queue handle.
+ * param transactions Transactions, they must stay valid until they are done.
+ * param count Number of transactions.
+ * retval kStatus_Success The transactions are queued.
+ * retval kStatus_InvalidArgument A transaction has an invalid register address size.
+ * retval kStatus_I2C_Busy A transaction is queued already.
+ */
+status_t I2C_QueueSubmit(I2C_Type *base,
+                         i2c_queue_handle_t *handle,
+                         i2c_queue_transaction_t *transactions,
+                         size_t count)
+{
+    assert(handle != NULL);
+    assert(transactions != NULL);
+
+    uint32_t regPrimask;
+    size_t i;
+
+    if (count == 0U)
+    {
+        return kStatus_Success;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        if (transactions[i].xfer.subaddressSize > sizeof(transactions[i].xfer.subaddress))
+        {
+            return kStatus_InvalidArgument;
+        }
+    }
+
+    regPrimask = DisableGlobalIRQ();
+    for (i = 0U; i < count; i++)
+    {
+        if (transactions[i].status == kStatus_I2C_Busy)
+        {
+            EnableGlobalIRQ(regPrimask);
+            return kStatus_I2C_Busy;
+        }
+    }
+    I2C_QueueAppend(handle, transactions, count, NULL);
+    EnableGlobalIRQ(regPrimask);
+
+    I2C_QueueRun(handle);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Initializes a burst of transactions.
+ *
+ * param burst Burst to initialize.
+ * param transactions Prepared transactions of the burst.
+ * param count Number of transactions.
+ * param period Period in calls of I2C_QueueTick, 0 if the burst is only submitted by I2C_QueueSubmitBurst.
+ * param callback Burst callback, NULL if none.
+ * param userData User data for the burst callback.
+ */
+void I2C_QueueCreateBurst(i2c_queue_burst_t *burst,
+                          i2c_queue_transaction_t *transactions,
+                          size_t count,
+                          uint32_t period,
+                          i2c_queue_burst_callback_t callback,
+                          void *userData)
+{
+    assert(burst != NULL);
+    assert((transactions != NULL) && (count != 0U));
+
+    (void)memset(burst, 0, sizeof(*burst));
+
+    burst->transactions = transactions;
+    burst->count        = count;
+    burst->period       = period;
+    burst->countdown    = period;
+    burst->status       = kStatus_Success;
+    burst->callback     = callback;
+    burst->userData     = userData;
+}
+
+/*!
+ * brief Queues all transactions of a burst.
+ *
+ * param base I2C peripheral base address.
+ * param handle Transaction queue handle.
+ * param burst Burst to queue.
+ * retval kStatus_Success The transactions are queued.
+ * retval kStatus_I2C_Busy The previous submission of the burst is still running, counted as overrun.
+ */
+status_t I2C_QueueSubmitBurst(I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_burst_t *burst)
+{
+    assert(handle != NULL);
+    assert(burst != NULL);
+
+    uint32_t regPrimask;
+
+    regPrimask = DisableGlobalIRQ();
+    if (burst->remaining != 0U)
+    {
+        burst->overruns++;
+        EnableGlobalIRQ(regPrimask);
+        return kStatus_I2C_Busy;
+    }
+    burst->remaining = burst->count;
+    burst->status    = kStatus_Success;
+    I2C_QueueAppend(handle, burst->transactions, burst->count, burst);
+    EnableGlobalIRQ(regPrimask);
+
+    I2C_QueueRun(handle);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Adds a periodic burst, it is submitted every period calls of I2C_QueueTick.
+ *
+ * param base I2C peripheral base address.
+ * param handle Transaction queue handle.
+ * param burst Burst with a period.
+ */
+void I2C_QueueAddBurst(I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_burst_t *burst)
+{
+    assert(handle != NULL);
+    assert((burst != NULL) && (burst->period != 0U));
+
+    uint32_t regPrimask;
+
+    regPrimask       = DisableGlobalIRQ();
+    burst->countdown = burst->period;
+    burst->next      = handle->bursts;
+    handle->bursts   = burst;
+    EnableGlobalIRQ(regPrimask);
+}
+
+/*!
+ * brief Removes a periodic burst, a running submission completes.
+ *
+ * param base I2C peripheral base address.
+ * param handle Transaction queue handle.
+ * param burst Burst to remove.
+ */
+void I2C_QueueRemoveBurst(I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_burst_t *burst)
+{
+    assert(handle != NULL);
+    assert(burst != NULL);
+
+    i2c_queue_burst_t **link;
+    uint32_t regPrimask;
+
+    regPrimask = DisableGlobalIRQ();
+    for (link = &handle->bursts; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == burst)
+        {
+            *link = burst->next;
+            break;
+        }
+    }
+    EnableGlobalIRQ(regPrimask);
+}
+
+/*!
+ * brief Submits the periodic bursts that are due.
+ *
+ * param base I2C peripheral base address.
+ * param handle Transaction queue handle.
+ */
+void I2C_QueueTick(I2C_Type *base, i2c_queue_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    i2c_queue_burst_t *burst;
+
+    for (burst = handle->bursts; burst != NULL; burst = burst->next)
+    {
+        burst->countdown--;
+        if (burst->countdown == 0U)
+        {
+            burst->countdown = burst->period;
+            (void)I2C_QueueSubmitBurst(base, handle, burst);
+        }
+    }
+}
+
+/*!
+ * brief Gets the statistics of the transaction queue.
+ *
+ * param base I2C peripheral base address.
+ * param handle Transaction queue handle.
+ * param stats Returns the statistics.
+ */
+void I2C_QueueGetStats(I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_stats_t *stats)
+{
+    assert(handle != NULL);
+    assert(stats != NULL);
+
+    uint32_t regPrimask;
+
+    regPrimask = DisableGlobalIRQ();
+    *stats     = handle->stats;
+    EnableGlobalIRQ(regPrimask);
+}
@@ -0,0 +1,693 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "fsl_sctimer_pwm_wave.h"
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.sctimer_pwm_wave"
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Half of a Q15 duty cycle, added before the shift to round to the nearest clock. */
+#define SCTIMER_PWM_WAVE_ROUND (0x4000U)
+
+/*! @brief Sine polynomial coefficients in Q14, minimax fit of sin(pi / 2 * t) = t * (A - t^2 * (B - C * t^2)). */
+#define SCTIMER_PWM_WAVE_SIN_A (25736U)
+#define SCTIMER_PWM_WAVE_SIN_B (10546U)
+#define SCTIMER_PWM_WAVE_SIN_C (1196U)
+
+/*! @brief Conflict resolution value of an output, 1 sets and 2 clears it. */
+#define SCTIMER_PWM_WAVE_RES_SET   (1U)
+#define SCTIMER_PWM_WAVE_RES_CLEAR (2U)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief DMA callback, counts the table wraps.
+ *
+ * @param handle DMA handle.
+ * @param userData The waveform handle.
+ * @param transferDone false on a DMA error.
+ * @param intmode kDMA_IntA at the end of the table.
+ */
+static void SCTIMER_PwmWaveCallbackDMA(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode);
+
+/*!
+ * @brief Makes an event drive an output to its active or inactive level.
+ *
+ * @param base SCTimer peripheral base address.
+ * @param level Active level of the output.
+ * @param output SCTimer output.
+ * @param event Event number.
+ * @param active true to drive the active level.
+ */
+static void SCTIMER_PwmWaveSetupAction(
+    SCT_Type *base, sctimer_pwm_level_select_t level, uint32_t output, uint32_t event, bool active);
+
+/*!
+ * @brief Sets up the link descriptor of a run of rows.
+ *
+ * @param handle Waveform handle.
+ * @param desc Descriptor.
+ * @param firstRow First row of the run.
+ * @param rows Number of rows.
+ * @param next Next descriptor of the chain.
+ * @param lastBlock The run ends with the last row of the table.
+ */
+static void SCTIMER_PwmWaveSetupBlock(sctimer_pwm_wave_handle_t *handle,
+                                      dma_descriptor_t *desc,
+                                      uint32_t firstRow,
+                                      uint32_t rows,
+                                      dma_descriptor_t *next,
+                                      bool lastBlock);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void SCTIMER_PwmWaveCallbackDMA(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode)
+{
+    sctimer_pwm_wave_handle_t *waveHandle = (sctimer_pwm_wave_handle_t *)userData;
+
+    (void)handle;
+    (void)intmode;
+
+    /* Only the descriptor with the last row of the table raises INTA. */
+    if (transferDone)
+    {
+        waveHandle->tableCount++;
+        if (waveHandle->callback != NULL)
+        {
+            waveHandle->callback(waveHandle->base, waveHandle, waveHandle->userData);
+        }
+    }
+}
+
+static void SCTIMER_PwmWaveSetupAction(
+    SCT_Type *base, sctimer_pwm_level_select_t level, uint32_t output, uint32_t event, bool active)
+{
+    if (active == (level == kSCTIMER_HighTrue))
+    {
+        SCTIMER_SetupOutputSetAction(base, output, event);
+    }
+    else
+    {
+        SCTIMER_SetupOutputClearAction(base, output, event);
+    }
+}
+
+static void SCTIMER_PwmWaveSetupBlock(sctimer_pwm_wave_handle_t *handle,
+                                      dma_descriptor_t *desc,
+                                      uint32_t firstRow,
+                                      uint32_t rows,
+                                      dma_descriptor_t *next,
+                                      bool lastBlock)
+{
+    uint32_t rowWords = handle->timing.rowWords;
+    uint32_t xferCfg;
+
+    xferCfg = DMA_CHANNEL_XFER(true, true, lastBlock, false, sizeof(uint32_t), kDMA_AddressInterleave1xWidth,
+                               kDMA_AddressInterleave1xWidth, rows * rowWords * sizeof(uint32_t));
+    DMA_SetupDescriptor(desc, xferCfg, (void *)(uint32_t)&handle->table[firstRow * rowWords],
+                        (void *)(uint32_t)&handle->base->MATCHREL[0], next);
+
+    /* The destination wraps to the match reload registers at each burst, one burst is one row. */
+    desc->dstEndAddr = (void *)(uint32_t)&handle->base->MATCHREL[rowWords - 1U];
+}
+
+/*!
+ * brief Gets the default configuration, three complementary pairs at 20 kHz edge aligned.
+ *
+ * The outputs are kSCTIMER_Out_0 to kSCTIMER_Out_5, the dead time 500 ns.
+ *
+ * param config Pointer to the configuration structure.
+ */
+void SCTIMER_PwmWaveGetDefaultConfig(sctimer_pwm_wave_config_t *config)
+{
+    uint32_t i;
+
+    assert(config != NULL);
+
+    (void)memset(config, 0, sizeof(*config));
+    config->mode          = kSCTIMER_EdgeAlignedPwm;
+    config->level         = kSCTIMER_HighTrue;
+    config->pwmFreq_Hz    = 20000U;
+    config->outputCount   = 6U;
+    config->complementary = true;
+    config->deadTime_ns   = 500U;
+    for (i = 0U; i < SCTIMER_PWM_WAVE_MAX_OUTPUTS; i++)
+    {
+        config->outputs[i] = (sctimer_out_t)i;
+    }
+    config->dmaRequest = 0U;
+}
+
+/*!
+ * brief Computes the timing of a waveform.
+ *
+ * param config Pointer to the configuration structure.
+ * param sctClock_Hz SCTimer counter clock, the source clock divided by the prescaler.
+ * param timing Returns the timing.
+ * retval kStatus_Success The timing is valid.
+ * retval kStatus_InvalidArgument Too many outputs, an odd number of complementary outputs, or no
+ *        active time left in the period after the dead times.
+ */
+status_t SCTIMER_PwmWaveGetTiming(const sctimer_pwm_wave_config_t *config,
+                                  uint32_t sctClock_Hz,
+                                  sctimer_pwm_wave_timing_t *timing)
+{
+    uint32_t words;
+    uint32_t half;
+    uint64_t dead;
+
+    assert((config != NULL) && (timing != NULL));
+
+    if ((config->outputCount == 0U) || (config->outputCount > SCTIMER_PWM_WAVE_MAX_OUTPUTS) ||
+        (config->complementary && ((config->outputCount & 1U) != 0U)) || (config->pwmFreq_Hz == 0U) ||
+        (sctClock_Hz == 0U))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    (void)memset(timing, 0, sizeof(*timing));
+    timing->mode          = config->mode;
+    timing->complementary = config->complementary;
+    timing->duties        = config->complementary ? (uint8_t)(config->outputCount / 2U) : config->outputCount;
+    timing->sctClock_Hz   = sctClock_Hz;
+
+    if (config->mode == kSCTIMER_EdgeAlignedPwm)
+    {
+        timing->periodTicks = (uint32_t)(((uint64_t)sctClock_Hz + (config->pwmFreq_Hz / 2U)) / config->pwmFreq_Hz);
+        timing->limit       = timing->periodTicks - 1U;
+    }
+    else
+    {
+        half                = (uint32_t)(((uint64_t)sctClock_Hz + config->pwmFreq_Hz) / (2ULL * config->pwmFreq_Hz));
+        timing->periodTicks = 2U * half;
+        timing->limit       = half;
+    }
+
+    /* The limit, and the shared dead time match of edge aligned pairs, come before the output matches. */
+    words = 1U + (uint32_t)config->outputCount;
+    if (config->complementary)
+    {
+        dead = (((uint64_t)config->deadTime_ns * sctClock_Hz) + 999999999ULL) / 1000000000ULL;
+        timing->deadTicks = (dead == 0U) ? 1U : ((dead > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (uint32_t)dead);
+        if (config->mode == kSCTIMER_EdgeAlignedPwm)
+        {
+            words++;
+        }
+    }
+    timing->rowWords = (words <= 2U) ? 2U : ((words <= 4U) ? 4U : 8U);
+
+    /* Center aligned the matches stay one clock below the limit, edge aligned a period needs three clocks. */
+    if ((timing->periodTicks < 3U) || (timing->limit < 2U))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (config->mode == kSCTIMER_EdgeAlignedPwm)
+    {
+        if (timing->periodTicks <= (2U * (uint64_t)timing->deadTicks))
+        {
+            return kStatus_InvalidArgument;
+        }
+        timing->maxOnTicks = timing->periodTicks - (2U * timing->deadTicks);
+    }
+    else
+    {
+        if (timing->limit <= timing->deadTicks)
+        {
+            return kStatus_InvalidArgument;
+        }
+        timing->maxOnTicks = 2U * (timing->limit - timing->deadTicks);
+    }
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Converts the duty cycles of one period into a table row.
+ *
+ * param timing Timing of the waveform.
+ * param row Returns timing->rowWords match values.
+ * param duty timing->duties Q15 duty cycles, from 0 to SCTIMER_PWM_WAVE_DUTY_FULL.
+ */
+void SCTIMER_PwmWaveSetRow(const sctimer_pwm_wave_timing_t *timing, uint32_t *row, const uint16_t *duty)
+{
+    uint32_t limit = timing->limit;
+    uint32_t dead  = timing->deadTicks;
+    uint32_t span;
+    uint32_t on;
+    uint32_t word;
+    uint32_t i;
+
+    assert((row != NULL) && (duty != NULL));
+
+    (void)memset(row, 0, timing->rowWords * sizeof(uint32_t));
+    row[0] = limit;
+    word   = 1U;
+
+    if (timing->mode == kSCTIMER_EdgeAlignedPwm)
+    {
+        if (timing->complementary)
+        {
+            /* The high sides go active one dead time after the low sides went inactive at the limit. */
+            span      = timing->maxOnTicks;
+            row[word] = dead - 1U;
+            word++;
+            for (i = 0U; i < timing->duties; i++)
+            {
+                assert(duty[i] <= SCTIMER_PWM_WAVE_DUTY_FULL);
+                on = (uint32_t)((((uint64_t)duty[i] * span) + SCTIMER_PWM_WAVE_ROUND) >> 15U);
+                /* At 0 and 100 % the match meets the activation, the conflict keeps the output inactive. */
+                row[word]      = dead - 1U + on;
+                row[word + 1U] = dead - 1U + on + dead;
+                word += 2U;
+            }
+        }
+        else
+        {
+            span = timing->periodTicks;
+            for (i = 0U; i < timing->duties; i++)
+            {
+                assert(duty[i] <= SCTIMER_PWM_WAVE_DUTY_FULL);
+                on = (uint32_t)((((uint64_t)duty[i] * span) + SCTIMER_PWM_WAVE_ROUND) >> 15U);
+                if (on == 0U)
+                {
+                    /* Deactivation at the limit wins the conflict with the activation. */
+                    row[word] = limit;
+                }
+                else if (on >= span)
+                {
+                    /* Beyond the limit, the match never occurs. */
+                    row[word] = span;
+                }
+                else
+                {
+                    row[word] = on - 1U;
+                }
+                word++;
+            }
+        }
+    }
+    else
+    {
+        if (timing->complementary)
+        {
+            /* The high side is active below a, the low side above b, a dead time apart. */
+            span = limit - dead;
+            for (i = 0U; i < timing->duties; i++)
+            {
+                assert(duty[i] <= SCTIMER_PWM_WAVE_DUTY_FULL);
+                on             = (uint32_t)((((uint64_t)duty[i] * span) + SCTIMER_PWM_WAVE_ROUND) >> 15U);
+                row[word]      = on;
+                row[word + 1U] = (on >= span) ? (limit + 1U) : (on + dead);
+                word += 2U;
+            }
+        }
+        else
+        {
+            span = limit;
+            for (i = 0U; i < timing->duties; i++)
+            {
+                assert(duty[i] <= SCTIMER_PWM_WAVE_DUTY_FULL);
+                on = (uint32_t)((((uint64_t)duty[i] * span) + SCTIMER_PWM_WAVE_ROUND) >> 15U);
+                if (on >= span)
+                {
+                    /* A match at the limit turns the counter, keep it one clock away or beyond the limit. */
+                    on = (duty[i] >= SCTIMER_PWM_WAVE_DUTY_FULL) ? (limit + 1U) : (limit - 1U);
+                }
+                row[word] = on;
+                word++;
+            }
+        }
+    }
+}
+
+/*!
+ * brief Integer sine, within 6 LSB of the exact value.
+ *
+ * param angle Angle, SCTIMER_PWM_WAVE_TURN is a full turn.
+ * return Q15 sine, from -32767 to 32767.
+ */
+int16_t SCTIMER_PwmWaveSin(uint16_t angle)
+{
+    uint32_t quadrant = (uint32_t)angle >> 14U;
+    uint32_t x        = (uint32_t)angle & 0x3FFFU;
+    uint32_t t;
+    uint32_t t2;
+    uint32_t r;
+
+    /* Fold into the first quadrant, t is the Q15 fraction of a quarter turn. */
+    if ((quadrant & 1U) != 0U)
+    {
+        x = 0x4000U - x;
+    }
+    t  = x << 1U;
+    t2 = (t * t) >> 15U;
+    r  = (SCTIMER_PWM_WAVE_SIN_B - ((SCTIMER_PWM_WAVE_SIN_C * t2) >> 15U)) * t2 >> 15U;
+    r  = (t * (SCTIMER_PWM_WAVE_SIN_A - r)) >> 14U;
+    if (r > 32767U)
+    {
+        r = 32767U;
+    }
+
+    return (quadrant >= 2U) ? (int16_t)(-(int32_t)r) : (int16_t)r;
+}
+
+/*!
+ * brief Fills a table with one turn of a sine modulation.
+ *
+ * param timing Timing of the waveform.
+ * param table Returns steps rows of timing->rowWords words.
+ * param steps Rows of the table.
+ * param amplitude Q15 amplitude, up to SCTIMER_PWM_WAVE_DUTY_FULL.
+ * param phaseOffset Angle between consecutive duties, SCTIMER_PWM_WAVE_TURN is a full turn.
+ */
+void SCTIMER_PwmWaveFillSine(const sctimer_pwm_wave_timing_t *timing,
+                             uint32_t *table,
+                             uint32_t steps,
+                             uint16_t amplitude,
+                             uint32_t phaseOffset)
+{
+    uint16_t duty[SCTIMER_PWM_WAVE_MAX_OUTPUTS];
+    uint32_t angle;
+    uint32_t product;
+    uint32_t n;
+    uint32_t k;
+
+    assert((timing != NULL) && (table != NULL));
+    assert(amplitude <= SCTIMER_PWM_WAVE_DUTY_FULL);
+
+    for (n = 0U; n < steps; n++)
+    {
+        angle = (uint32_t)((((uint64_t)n << 16U) + (steps / 2U)) / steps);
+        for (k = 0U; k < timing->duties; k++)
+        {
+            /* 0.5 + 0.5 * amplitude * sin, the Q30 product is offset to stay unsigned. */
+            product = (uint32_t)((int32_t)amplitude * (int32_t)SCTIMER_PwmWaveSin((uint16_t)angle));
+            duty[k] = (uint16_t)((product + 0x40008000U) >> 16U);
+            angle += phaseOffset;
+        }
+        SCTIMER_PwmWaveSetRow(timing, &table[n * timing->rowWords], duty);
+    }
+}
+
+/*!
+ * brief Programs the SCTimer events of a waveform and initializes the handle.
+ *
+ * param base SCTimer peripheral base address.
+ * param handle pointer to sctimer_pwm_wave_handle_t structure.
+ * param config Pointer to the configuration structure.
+ * param srcClock_Hz SCTimer clock, the prescaler of the unified counter divides it.
+ * param callback Callback function called at each table wrap, NULL if not used.
+ * param userData user param passed to the callback function.
+ * param dmaHandle DMA handle pointer.
+ * param descriptors Link descriptors allocated with DMA_ALLOCATE_LINK_DESCRIPTORS.
+ * param descriptorCount Number of link descriptors, see SCTIMER_PWM_WAVE_DESCRIPTOR_NUM.
+ * retval kStatus_Success The events are programmed.
+ * retval kStatus_InvalidArgument The timing is not valid, see SCTIMER_PwmWaveGetTiming.
+ * retval kStatus_Fail Events or match registers are already used.
+ */
+status_t SCTIMER_PwmWaveCreateHandle(SCT_Type *base,
+                                     sctimer_pwm_wave_handle_t *handle,
+                                     const sctimer_pwm_wave_config_t *config,
+                                     uint32_t srcClock_Hz,
+                                     sctimer_pwm_wave_callback_t callback,
+                                     void *userData,
+                                     dma_handle_t *dmaHandle,
+                                     dma_descriptor_t *descriptors,
+                                     uint32_t descriptorCount)
+{
+    sctimer_pwm_level_select_t level = config->level;
+    uint32_t prescale;
+    uint32_t events;
+    uint32_t event;
+    uint32_t output;
+    uint32_t res;
+    uint32_t i;
+    status_t status;
+
+    assert((handle != NULL) && (config != NULL) && (dmaHandle != NULL) && (descriptors != NULL));
+    assert(((uint32_t)descriptors & (FSL_FEATURE_DMA_LINK_DESCRIPTOR_ALIGN_SIZE - 1U)) == 0U);
+    assert(config->dmaRequest <= 1U);
+    assert(1U == (base->CONFIG & SCT_CONFIG_UNIFY_MASK));
+
+    (void)memset(handle, 0, sizeof(*handle));
+
+    prescale = ((base->CTRL & SCT_CTRL_PRE_L_MASK) >> SCT_CTRL_PRE_L_SHIFT) + 1U;
+    status   = SCTIMER_PwmWaveGetTiming(config, srcClock_Hz / prescale, &handle->timing);
+    if (status != kStatus_Success)
+    {
+        return status;
+    }
+
+    handle->base            = base;
+    handle->dmaHandle       = dmaHandle;
+    handle->descriptors     = descriptors;
+    handle->descriptorCount = descriptorCount;
+    handle->level           = level;
+    handle->outputCount     = config->outputCount;
+    handle->callback        = callback;
+    handle->userData        = userData;
+    for (i = 0U; i < config->outputCount; i++)
+    {
+        assert((uint32_t)config->outputs[i] < (uint32_t)FSL_FEATURE_SCT_NUMBER_OF_OUTPUTS);
+        handle->outputs[i] = (uint8_t)config->outputs[i];
+    }
+
+    /* Event n matches on match register n, the row words in order. */
+    events = 1U + (uint32_t)config->outputCount;
+    if (config->complementary && (config->mode == kSCTIMER_EdgeAlignedPwm))
+    {
+        events++;
+    }
+    for (i = 0U; i < events; i++)
+    {
+        status = SCTIMER_CreateAndScheduleEvent(base, kSCTIMER_MatchEventOnly, (i == 0U) ? handle->timing.limit : 0U,
+                                                0U, kSCTIMER_Counter_U, &event);
+        if ((status != kStatus_Success) || (event != i))
+        {
+            return kStatus_Fail;
+        }
+    }
+    SCTIMER_SetupCounterLimitAction(base, kSCTIMER_Counter_U, 0U);
+
+    /* Conflicts between events resolve to the inactive level. */
+    res = base->RES;
+    for (i = 0U; i < config->outputCount; i++)
+    {
+        output = handle->outputs[i];
+        res &= ~(3UL << (2U * output));
+        res |= ((level == kSCTIMER_HighTrue) ? SCTIMER_PWM_WAVE_RES_CLEAR : SCTIMER_PWM_WAVE_RES_SET) << (2U * output);
+    }
+    base->RES = res;
+
+    if (config->mode == kSCTIMER_EdgeAlignedPwm)
+    {
+        if (config->complementary)
+        {
+            /* The limit ends the low sides, the dead time match starts the high sides. */
+            for (i = 0U; i < config->outputCount; i += 2U)
+            {
+                SCTIMER_PwmWaveSetupAction(base, level, handle->outputs[i + 1U], 0U, false);
+                SCTIMER_PwmWaveSetupAction(base, level, handle->outputs[i], 1U, true);
+                SCTIMER_PwmWaveSetupAction(base, level, handle->outputs[i], 2U + i, false);
+                SCTIMER_PwmWaveSetupAction(base, level, handle->outputs[i + 1U], 3U + i, true);
+            }
+        }
+        else
+        {
+            for (i = 0U; i < config->outputCount; i++)
+            {
+                SCTIMER_PwmWaveSetupAction(base, level, handle->outputs[i], 0U, true);
+                SCTIMER_PwmWaveSetupAction(base, level, handle->outputs[i], 1U + i, false);
+            }
+        }
+    }
+    else
+    {
+        /* Counting down reverses the actions, the pulses are symmetric around the counter bottom. */
+        base->CTRL |= SCT_CTRL_BIDIR_L_MASK;
+        for (i = 0U; i < config->outputCount; i++)
+        {
+            output = handle->outputs[i];
+            base->OUTPUTDIRCTRL =
+                (base->OUTPUTDIRCTRL & ~((uint32_t)SCT_OUTPUTDIRCTRL_SETCLR0_MASK << (2U * output))) |
+                (1UL << (2U * output));
+            /* High sides and independent outputs end at their match, low sides start at theirs. */
+            SCTIMER_PwmWaveSetupAction(base, level, output, 1U + i, config->complementary && ((i & 1U) != 0U));
+        }
+    }
+
+    /* The limit requests the next row. */
+    SCTIMER_SetupDmaTriggerAction(base, config->dmaRequest, 0U);
+    DMA_SetCallback(dmaHandle, SCTIMER_PwmWaveCallbackDMA, handle);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Starts the counter and streams the table, one row per period, until stopped.
+ *
+ * param base SCTimer peripheral base address.
+ * param handle pointer to sctimer_pwm_wave_handle_t structure.
+ * param table Table of steps rows, it must stay valid while the waveform runs.
+ * param steps Rows of the table.
+ * retval kStatus_Success The waveform runs.
+ * retval kStatus_InvalidArgument The table is empty or needs more link descriptors than the handle has.
+ * retval kStatus_Busy The DMA channel is still in use.
+ */
+status_t SCTIMER_PwmWaveStart(SCT_Type *base, sctimer_pwm_wave_handle_t *handle, const uint32_t *table, uint32_t steps)
+{
+    dma_channel_trigger_t trigger;
+    dma_descriptor_t head;
+    dma_descriptor_t *desc;
+    uint32_t rowWords;
+    uint32_t blockRows;
+    uint32_t blocks;
+    uint32_t rows;
+    uint32_t output;
+    uint32_t active;
+    uint32_t levels;
+    uint32_t i;
+
+    assert(handle != NULL);
+
+    rowWords  = handle->timing.rowWords;
+    blockRows = SCTIMER_PWM_WAVE_BLOCK_ROWS(rowWords);
+    blocks    = (steps + blockRows - 1U) / blockRows;
+    desc      = handle->descriptors;
+
+    if ((table == NULL) || (steps == 0U) || (blocks > handle->descriptorCount))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (DMA_ChannelIsBusy(handle->dmaHandle->base, handle->dmaHandle->channel))
+    {
+        return kStatus_Busy;
+    }
+
+    handle->table      = table;
+    handle->steps      = steps;
+    handle->tableCount = 0U;
+
+    /* Restart from the counter bottom counting up with row 0 loaded. */
+    SCTIMER_StopTimer(base, (uint32_t)kSCTIMER_Counter_U);
+    base->CTRL = (base->CTRL & ~SCT_CTRL_DOWN_L_MASK) | SCT_CTRL_CLRCTR_L_MASK;
+    for (i = 0U; i < rowWords; i++)
+    {
+        base->MATCH[i]    = table[i];
+        base->MATCHREL[i] = table[i];
+    }
+
+    /*
+     * Edge aligned, independent outputs start active unless row 0 turns them off and high sides start
+     * inactive for the dead time. Center aligned, independent outputs and high sides start active
+     * unless their match is 0. Low sides always start inactive.
+     */
+    levels = base->OUTPUT;
+    for (i = 0U; i < handle->outputCount; i++)
+    {
+        output = handle->outputs[i];
+        if (handle->timing.mode == kSCTIMER_EdgeAlignedPwm)
+        {
+            active = ((!handle->timing.complementary) && (table[1U + i] != handle->timing.limit)) ? 1U : 0U;
+        }
+        else
+        {
+            active = (((!handle->timing.complementary) || ((i & 1U) == 0U)) && (table[1U + i] != 0U)) ? 1U : 0U;
+        }
+        if (active == ((handle->level == kSCTIMER_HighTrue) ? 1U : 0U))
+        {
+            levels |= (1UL << output);
+        }
+        else
+        {
+            levels &= ~(1UL << output);
+        }
+    }
+    base->OUTPUT = levels;
+
+    /* Each period request moves one row into the match reload registers. */
+    trigger.type  = kDMA_RisingEdgeTrigger;
+    trigger.burst = (rowWords == 2U) ? kDMA_EdgeBurstTransfer2 :
+                                       ((rowWords == 4U) ? kDMA_EdgeBurstTransfer4 : kDMA_EdgeBurstTransfer8);
+    trigger.wrap  = kDMA_DstWrap;
+    DMA_SetChannelConfig(handle->dmaHandle->base, handle->dmaHandle->channel, &trigger, false);
+
+    /* The blocks link into a ring, the last one raises INTA at each table wrap. */
+    for (i = 0U; i < blocks; i++)
+    {
+        rows = ((i + 1U) < blocks) ? blockRows : (steps - (i * blockRows));
+        SCTIMER_PwmWaveSetupBlock(handle, &desc[i], i * blockRows, rows, &desc[(i + 1U) % blocks],
+                                  (i + 1U) == blocks);
+    }
+
+    /* The head descriptor continues after row 0, which the CPU has just loaded. */
+    if (steps == 1U)
+    {
+        head = desc[0];
+    }
+    else
+    {
+        rows = (blocks == 1U) ? steps : blockRows;
+        SCTIMER_PwmWaveSetupBlock(handle, &head, 1U, rows - 1U, &desc[1U % blocks], blocks == 1U);
+    }
+
+    if (handle->callback != NULL)
+    {
+        DMA_EnableChannelInterrupts(handle->dmaHandle->base, handle->dmaHandle->channel);
+    }
+    else
+    {
+        DMA_DisableChannelInterrupts(handle->dmaHandle->base, handle->dmaHandle->channel);
+    }
+    DMA_SubmitChannelDescriptor(handle->dmaHandle, &head);
+    DMA_StartTransfer(handle->dmaHandle);
+
+    SCTIMER_StartTimer(base, (uint32_t)kSCTIMER_Counter_U);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Stops the counter and the DMA, the outputs go inactive.
+ *
+ * param base SCTimer peripheral base address.
+ * param handle pointer to sctimer_pwm_wave_handle_t structure.
+ */
+void SCTIMER_PwmWaveStop(SCT_Type *base, sctimer_pwm_wave_handle_t *handle)
+{
+    uint32_t levels;
+    uint32_t i;
+
+    assert(handle != NULL);
+
+    SCTIMER_StopTimer(base, (uint32_t)kSCTIMER_Counter_U);
+    DMA_DisableChannelInterrupts(handle->dmaHandle->base, handle->dmaHandle->channel);
+    DMA_AbortTransfer(handle->dmaHandle);
+
+    levels = base->OUTPUT;
+    for (i = 0U; i < handle->outputCount; i++)
+    {
+        if (handle->level == kSCTIMER_HighTrue)
+        {
+            levels &= ~(1UL << handle->outputs[i]);
+        }
+        else
+        {
+            levels |= (1UL << handle->outputs[i]);
+        }
+    }
+    base->OUTPUT = levels;
+}
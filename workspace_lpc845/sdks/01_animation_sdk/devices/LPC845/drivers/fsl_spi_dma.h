@@ -0,0 +1,222 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef FSL_SPI_DMA_H_
+#define FSL_SPI_DMA_H_
+
+#include "fsl_spi.h"
+#include "fsl_dma.h"
+
+/*!
+ * @addtogroup spi_dma_driver
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*! @{ */
+/*! @brief SPI DMA driver version. */
+#define FSL_SPI_DMA_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*! @} */
+
+/*!
+ * @brief Number of link descriptors per SPI instance and direction.
+ *
+ * One descriptor moves up to DMA_MAX_TRANSFER_COUNT frames, so this limits the length of one
+ * transfer to SPI_DMA_MAX_TRANSFER_FRAMES.
+ */
+#ifndef SPI_DMA_LINK_DESCRIPTOR_NUM
+#define SPI_DMA_LINK_DESCRIPTOR_NUM (4U)
+#endif
+
+/*! @brief Maximum number of frames of one DMA transfer. */
+#define SPI_DMA_MAX_TRANSFER_FRAMES (SPI_DMA_LINK_DESCRIPTOR_NUM * DMA_MAX_TRANSFER_COUNT)
+
+/*! @brief SPI DMA handle typedef. */
+typedef struct _spi_dma_handle spi_dma_handle_t;
+
+/*!
+ * @brief SPI DMA callback called at the end of the transfer.
+ *
+ * The status is kStatus_Success when all frames were received, kStatus_SPI_Error on a DMA error.
+ */
+typedef void (*spi_dma_callback_t)(SPI_Type *base, spi_dma_handle_t *handle, status_t status, void *userData);
+
+/*! @brief SPI DMA transfer handle. */
+struct _spi_dma_handle
+{
+    volatile bool inProgress;       /*!< A transfer is running. */
+    bool isMaster;                  /*!< The running transfer drives the bus. */
+    dma_handle_t *txHandle;         /*!< DMA handler for SPI send. */
+    dma_handle_t *rxHandle;         /*!< DMA handler for SPI receive. */
+    uint8_t bytesPerFrame;          /*!< Bytes in a frame, 1 up to 8-bit frames and 2 for 9 to 16-bit frames. */
+    spi_dma_callback_t callback;    /*!< Callback for SPI DMA transfer. */
+    void *userData;                 /*!< User Data for SPI DMA callback. */
+    size_t transferSize;            /*!< Bytes of the running transfer. */
+    volatile uint32_t rxBlockCount; /*!< Receive descriptors completed, one per DMA_MAX_TRANSFER_COUNT frames. */
+    uint32_t lastTxWord;            /*!< Last frame with its control bits, the DMA writes it to TXDATCTL. */
+    uint16_t rxDummy;               /*!< Sink of the received frames when there is no receive buffer. */
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name DMA Transactional
+ * @{
+ */
+
+/*!
+ * @brief Initialize the SPI master DMA handle.
+ *
+ * This function initializes the SPI master DMA handle which can be used for other SPI master
+ * transactional APIs. Usually, for a specified SPI instance, user need only call this API once
+ * to get the initialized handle.
+ *
+ * Both DMA channels must be the SPI request channels of the instance and are switched to
+ * peripheral requests by the transfer functions.
+ *
+ * @param base SPI peripheral base address.
+ * @param handle SPI handle pointer.
+ * @param callback User callback function called at the end of a transfer.
+ * @param userData User data for callback.
+ * @param txHandle DMA handle pointer for SPI Tx, the handle shall be static allocated by users.
+ * @param rxHandle DMA handle pointer for SPI Rx, the handle shall be static allocated by users.
+ * @retval kStatus_Success The handle was initialized.
+ */
+status_t SPI_MasterTransferCreateHandleDMA(SPI_Type *base,
+                                           spi_dma_handle_t *handle,
+                                           spi_dma_callback_t callback,
+                                           void *userData,
+                                           dma_handle_t *txHandle,
+                                           dma_handle_t *rxHandle);
+
+/*!
+ * @brief Perform a non-blocking SPI transfer using DMA.
+ *
+ * Every frame but the last one is written to TXDAT and sent with the control bits of TXCTL, the
+ * last frame is written to TXDATCTL together with the end of transfer and end of frame bits of
+ * configFlags, so the slave select is released by the hardware right after the last frame.
+ *
+ * Frames of 9 to 16 bits take two bytes of the buffers, little endian. Without txData the
+ * dummy data of the instance is sent, without rxData the received frames are dropped into a
+ * dummy sink. The receive channel always runs, the transfer is complete when the last frame was
+ * received. kSPI_ReceiveIgnore is not supported.
+ *
+ * @code
+ * SPI_MasterTransferCreateHandleDMA(SPI0, &spiHandle, callback, NULL, &txDmaHandle, &rxDmaHandle);
+ * xfer.txData      = frameBuffer;
+ * xfer.rxData      = NULL;
+ * xfer.dataSize    = sizeof(frameBuffer);
+ * xfer.configFlags = kSPI_EndOfTransfer;
+ * SPI_MasterTransferDMA(SPI0, &spiHandle, &xfer);
+ * @endcode
+ *
+ * @param base SPI peripheral base address.
+ * @param handle SPI DMA handle pointer.
+ * @param xfer Pointer to dma transfer structure.
+ * @retval kStatus_Success Successfully start a transfer.
+ * @retval kStatus_InvalidArgument Input argument is invalid.
+ * @retval kStatus_SPI_Busy SPI is not idle, is running another transfer.
+ */
+status_t SPI_MasterTransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer);
+
+/*!
+ * @brief Initialize the SPI slave DMA handle.
+ *
+ * @param base SPI peripheral base address.
+ * @param handle SPI handle pointer.
+ * @param callback User callback function called at the end of a transfer.
+ * @param userData User data for callback.
+ * @param txHandle DMA handle pointer for SPI Tx, the handle shall be static allocated by users.
+ * @param rxHandle DMA handle pointer for SPI Rx, the handle shall be static allocated by users.
+ * @retval kStatus_Success The handle was initialized.
+ */
+static inline status_t SPI_SlaveTransferCreateHandleDMA(SPI_Type *base,
+                                                        spi_dma_handle_t *handle,
+                                                        spi_dma_callback_t callback,
+                                                        void *userData,
+                                                        dma_handle_t *txHandle,
+                                                        dma_handle_t *rxHandle)
+{
+    return SPI_MasterTransferCreateHandleDMA(base, handle, callback, userData, txHandle, rxHandle);
+}
+
+/*!
+ * @brief Perform a non-blocking SPI slave transfer using DMA.
+ *
+ * All frames are written to TXDAT, the master ends the transfer. The transfer is complete
+ * when dataSize bytes were received.
+ *
+ * @param base SPI peripheral base address.
+ * @param handle SPI DMA handle pointer.
+ * @param xfer Pointer to dma transfer structure, configFlags is not used.
+ * @retval kStatus_Success Successfully start a transfer.
+ * @retval kStatus_InvalidArgument Input argument is invalid.
+ * @retval kStatus_SPI_Busy SPI is not idle, is running another transfer.
+ */
+status_t SPI_SlaveTransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer);
+
+/*!
+ * @brief Abort a SPI transfer using DMA.
+ *
+ * @param base SPI peripheral base address.
+ * @param handle SPI DMA handle pointer.
+ */
+void SPI_MasterTransferAbortDMA(SPI_Type *base, spi_dma_handle_t *handle);
+
+/*!
+ * @brief Gets the master DMA transfer remaining bytes.
+ *
+ * @param base SPI peripheral base address.
+ * @param handle A pointer to the spi_dma_handle_t structure which stores the transfer state.
+ * @param count A number of bytes received so far by the non-blocking transaction.
+ * @retval kStatus_Success Get the transferred count.
+ * @retval kStatus_NoTransferInProgress No transfer is running.
+ * @retval kStatus_InvalidArgument count is NULL.
+ */
+status_t SPI_MasterTransferGetCountDMA(SPI_Type *base, spi_dma_handle_t *handle, size_t *count);
+
+/*!
+ * @brief Abort a SPI slave transfer using DMA.
+ *
+ * @param base SPI peripheral base address.
+ * @param handle SPI DMA handle pointer.
+ */
+static inline void SPI_SlaveTransferAbortDMA(SPI_Type *base, spi_dma_handle_t *handle)
+{
+    SPI_MasterTransferAbortDMA(base, handle);
+}
+
+/*!
+ * @brief Gets the slave DMA transfer remaining bytes.
+ *
+ * @param base SPI peripheral base address.
+ * @param handle A pointer to the spi_dma_handle_t structure which stores the transfer state.
+ * @param count A number of bytes received so far by the non-blocking transaction.
+ * @retval kStatus_Success Get the transferred count.
+ * @retval kStatus_NoTransferInProgress No transfer is running.
+ * @retval kStatus_InvalidArgument count is NULL.
+ */
+static inline status_t SPI_SlaveTransferGetCountDMA(SPI_Type *base, spi_dma_handle_t *handle, size_t *count)
+{
+    return SPI_MasterTransferGetCountDMA(base, handle, count);
+}
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* FSL_SPI_DMA_H_ */
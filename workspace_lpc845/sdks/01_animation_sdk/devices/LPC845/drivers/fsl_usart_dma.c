@@ -0,0 +1,766 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "fsl_usart_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.lpc_miniusart_dma"
+#endif
+
+/*! @brief USART transfer state. */
+enum
+{
+    kUSART_RxIdle, /* RX idle. */
+    kUSART_RxBusy, /* RX busy. */
+    kUSART_TxIdle, /* TX idle. */
+    kUSART_TxBusy, /* TX busy. */
+};
+
+/*! @brief Index mask of the transmit request queue. */
+#define USART_DMA_TX_QUEUE_MASK (USART_DMA_TX_QUEUE_SIZE - 1U)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief DMA callback of the RX ring buffer.
+ *
+ * @param handle DMA handle of the RX channel.
+ * @param param USART DMA handle.
+ * @param transferDone false on a DMA error.
+ * @param intmode kDMA_IntA, raised by every block.
+ */
+static void USART_RxRingCallbackDMA(dma_handle_t *handle, void *param, bool transferDone, uint32_t intmode);
+
+/*!
+ * @brief Get the number of bytes the DMA stored since the ring buffer was started.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param handle USART DMA handle.
+ * @return Received byte count, wraps at 2^32.
+ */
+static uint32_t USART_GetRxReceivedCountDMA(usart_dma_handle_t *handle);
+
+/*!
+ * @brief DMA callback of the transmit requests.
+ *
+ * @param handle DMA handle of the TX channel.
+ * @param param USART DMA handle.
+ * @param transferDone false on a DMA error.
+ * @param intmode kDMA_IntA, raised by the last descriptor of every request.
+ */
+static void USART_TxCallbackDMA(dma_handle_t *handle, void *param, bool transferDone, uint32_t intmode);
+
+/*!
+ * @brief Links the queued transmit requests into one descriptor chain and starts it.
+ *
+ * Must be called with interrupts disabled, or from the DMA interrupt, with the DMA channel idle.
+ *
+ * @param handle USART DMA handle.
+ */
+static void USART_TxStartBatchDMA(usart_dma_handle_t *handle);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t USART_GetRxReceivedCountDMA(usart_dma_handle_t *handle)
+{
+    DMA_Type *dmaBase = handle->rxDmaHandle->base;
+    uint32_t channel  = handle->rxDmaHandle->channel;
+    uint32_t mask     = 1UL << DMA_CHANNEL_INDEX(dmaBase, channel);
+    uint32_t blocks   = handle->rxBlockCount;
+    uint32_t pending;
+    uint32_t remaining;
+
+    /*
+     * A block may complete while the remaining count is read. Read again until the INTA flag is
+     * stable, so the remaining count surely belongs to the descriptor after the last counted block,
+     * or to the one after that when the block interrupt is still pending.
+     */
+    do
+    {
+        pending   = DMA_COMMON_REG_GET(dmaBase, channel, INTA) & mask;
+        remaining = DMA_GetRemainingBytes(dmaBase, channel);
+    } while (pending != (DMA_COMMON_REG_GET(dmaBase, channel, INTA) & mask));
+
+    if (pending != 0UL)
+    {
+        blocks++;
+    }
+
+    return (blocks * handle->rxBlockSize) + (handle->rxBlockSize - remaining);
+}
+
+static void USART_RxRingCallbackDMA(dma_handle_t *handle, void *param, bool transferDone, uint32_t intmode)
+{
+    assert(handle != NULL);
+    assert(param != NULL);
+
+    usart_dma_handle_t *usartHandle = (usart_dma_handle_t *)param;
+    status_t status                 = kStatus_USART_RxIdle;
+
+    if (transferDone)
+    {
+        usartHandle->rxBlockCount++;
+
+        /* The DMA has gone past the oldest unread byte. */
+        if (((usartHandle->rxBlockCount * usartHandle->rxBlockSize) - usartHandle->rxTail) >
+            usartHandle->rxRingBufferSize)
+        {
+            usartHandle->rxOverrunCount++;
+            status = kStatus_USART_RxRingBufferOverrun;
+        }
+    }
+    else
+    {
+        status = kStatus_USART_RxError;
+    }
+
+    if (usartHandle->callback != NULL)
+    {
+        usartHandle->callback(usartHandle->base, usartHandle, status, usartHandle->userData);
+    }
+}
+
+static void USART_TxStartBatchDMA(usart_dma_handle_t *handle)
+{
+    usart_dma_tx_request_t *request;
+    dma_descriptor_t *descriptor;
+    uint32_t first = handle->txRequestTail;
+    uint32_t last  = handle->txRequestHead;
+    uint32_t i;
+
+    if (first == last)
+    {
+        handle->txState = (uint8_t)kUSART_TxIdle;
+        return;
+    }
+
+    /*
+     * The last descriptor of a request already links to the first one of the next request, the
+     * pool is allocated in order. Only the reload decides whether the chain goes on.
+     */
+    for (i = first; i != last; i++)
+    {
+        request    = &handle->txRequests[i & USART_DMA_TX_QUEUE_MASK];
+        descriptor = &handle->txDescriptors[request->lastDescriptor];
+        if ((i + 1U) != last)
+        {
+            descriptor->xfercfg |= DMA_CHANNEL_XFERCFG_RELOAD_MASK;
+        }
+        else
+        {
+            descriptor->xfercfg &= ~DMA_CHANNEL_XFERCFG_RELOAD_MASK;
+        }
+    }
+
+    handle->txRequestStarted = last;
+    handle->txState          = (uint8_t)kUSART_TxBusy;
+    handle->txStats.batchCount++;
+
+    request = &handle->txRequests[first & USART_DMA_TX_QUEUE_MASK];
+    DMA_SubmitChannelDescriptor(handle->txDmaHandle, &handle->txDescriptors[request->firstDescriptor]);
+    DMA_StartTransfer(handle->txDmaHandle);
+}
+
+static void USART_TxCallbackDMA(dma_handle_t *handle, void *param, bool transferDone, uint32_t intmode)
+{
+    assert(handle != NULL);
+    assert(param != NULL);
+
+    usart_dma_handle_t *usartHandle = (usart_dma_handle_t *)param;
+    usart_dma_tx_request_t *request;
+    status_t status = kStatus_USART_TxIdle;
+    bool chainDone;
+    uint32_t done;
+    uint32_t i;
+
+    (void)intmode;
+
+    usartHandle->txStats.irqCount++;
+
+    if (usartHandle->txRequestTail == usartHandle->txRequestStarted)
+    {
+        /* Nothing running, a flag left over from an abort. */
+        return;
+    }
+
+    if (transferDone)
+    {
+        chainDone = !DMA_ChannelIsActive(handle->base, handle->channel);
+    }
+    else
+    {
+        DMA_AbortTransfer(handle);
+        status    = kStatus_USART_TxError;
+        chainDone = true;
+    }
+
+    if (chainDone)
+    {
+        /*
+         * The channel stopped, it can not raise INTA again before the next chain starts. Clear the
+         * flag of a request that ended after the interrupt was entered, everything ended by now.
+         */
+        DMA_COMMON_REG_SET(handle->base, handle->channel, INTA,
+                           1UL << DMA_CHANNEL_INDEX(handle->base, handle->channel));
+        done = usartHandle->txRequestStarted - usartHandle->txRequestTail;
+    }
+    else
+    {
+        /*
+         * Two requests ending before the interrupt is taken raise one interrupt, the second one is
+         * reported by the next interrupt. Requests are reported late, never early.
+         */
+        done = 1U;
+    }
+
+    for (i = 0U; i < done; i++)
+    {
+        request = &usartHandle->txRequests[usartHandle->txRequestTail & USART_DMA_TX_QUEUE_MASK];
+        usartHandle->txDescriptorFree += request->descriptorCount;
+        if (status == kStatus_USART_TxIdle)
+        {
+            usartHandle->txStats.txBytes += request->bytes;
+        }
+        usartHandle->txStats.requestCount++;
+        usartHandle->txRequestTail++;
+    }
+
+    /* Keep the USART busy before the callbacks run. */
+    if (chainDone)
+    {
+        USART_TxStartBatchDMA(usartHandle);
+    }
+
+    if (usartHandle->callback != NULL)
+    {
+        while (done != 0U)
+        {
+            usartHandle->callback(usartHandle->base, usartHandle, status, usartHandle->userData);
+            done--;
+        }
+    }
+}
+
+/*!
+ * brief Initializes the USART handle which is used in transactional functions.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * param callback Callback function.
+ * param userData User data.
+ * param txDmaHandle User-requested DMA handle for TX DMA transfer, NULL when only receiving.
+ * param rxDmaHandle User-requested DMA handle for RX DMA transfer, NULL when only sending.
+ */
+status_t USART_TransferCreateHandleDMA(USART_Type *base,
+                                       usart_dma_handle_t *handle,
+                                       usart_dma_transfer_callback_t callback,
+                                       void *userData,
+                                       dma_handle_t *txDmaHandle,
+                                       dma_handle_t *rxDmaHandle)
+{
+    assert(NULL != handle);
+
+    (void)memset(handle, 0, sizeof(*handle));
+
+    handle->base        = base;
+    handle->callback    = callback;
+    handle->userData    = userData;
+    handle->txDmaHandle = txDmaHandle;
+    handle->rxDmaHandle = rxDmaHandle;
+    handle->rxState     = (uint8_t)kUSART_RxIdle;
+    handle->txState     = (uint8_t)kUSART_TxIdle;
+
+    if (rxDmaHandle != NULL)
+    {
+        DMA_SetCallback(rxDmaHandle, USART_RxRingCallbackDMA, handle);
+    }
+
+    if (txDmaHandle != NULL)
+    {
+        DMA_SetCallback(txDmaHandle, USART_TxCallbackDMA, handle);
+    }
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Starts receiving into a ring buffer with the DMA.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * param ringBuffer Start address of the ring buffer.
+ * param ringBufferSize Size of the ring buffer, power of 2.
+ * param blockSize Bytes per DMA block, power of 2 up to USART_MAX_DMA_RING_BLOCK_SIZE and smaller than
+ *                 ringBufferSize.
+ * param descriptors ringBufferSize / blockSize link descriptors allocated with DMA_ALLOCATE_LINK_DESCRIPTORS.
+ * retval kStatus_Success The ring buffer was started.
+ * retval kStatus_InvalidArgument The ring buffer geometry is not valid.
+ * retval kStatus_USART_RxBusy The receiver is already in use.
+ */
+status_t USART_TransferStartRingBufferDMA(USART_Type *base,
+                                          usart_dma_handle_t *handle,
+                                          uint8_t *ringBuffer,
+                                          size_t ringBufferSize,
+                                          size_t blockSize,
+                                          dma_descriptor_t *descriptors)
+{
+    assert(NULL != handle);
+    assert(NULL != handle->rxDmaHandle);
+
+    uint32_t blockNum;
+    uint32_t xferCfg;
+    uint32_t i;
+
+    if ((ringBuffer == NULL) || (descriptors == NULL) || (ringBufferSize == 0U) ||
+        ((ringBufferSize & (ringBufferSize - 1U)) != 0U) || (blockSize == 0U) ||
+        ((blockSize & (blockSize - 1U)) != 0U) || (blockSize > USART_MAX_DMA_RING_BLOCK_SIZE) ||
+        (blockSize >= ringBufferSize))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (handle->rxState != (uint8_t)kUSART_RxIdle)
+    {
+        return kStatus_USART_RxBusy;
+    }
+
+    handle->rxDescriptors    = descriptors;
+    handle->rxRingBuffer     = ringBuffer;
+    handle->rxRingBufferSize = (uint32_t)ringBufferSize;
+    handle->rxBlockSize      = (uint32_t)blockSize;
+    handle->rxBlockCount     = 0U;
+    handle->rxTail           = 0U;
+    handle->rxIdleMark       = 0U;
+    handle->rxIdleArmed      = false;
+    handle->rxIdleFlushCount = 0U;
+    handle->rxOverrunCount   = 0U;
+    handle->rxState          = (uint8_t)kUSART_RxBusy;
+
+    /* One descriptor per block, every block raises INTA and the last one links back to the first. */
+    blockNum = (uint32_t)(ringBufferSize / blockSize);
+    xferCfg  = DMA_CHANNEL_XFER(true, false, true, false, sizeof(uint8_t), kDMA_AddressInterleave0xWidth,
+                                kDMA_AddressInterleave1xWidth, blockSize);
+    for (i = 0U; i < blockNum; i++)
+    {
+        DMA_SetupDescriptor(&descriptors[i], xferCfg, (void *)(uint32_t)&base->RXDAT, &ringBuffer[i * blockSize],
+                            &descriptors[(i + 1U) % blockNum]);
+    }
+
+    DMA_SetChannelConfig(handle->rxDmaHandle->base, handle->rxDmaHandle->channel, NULL, true);
+    DMA_SubmitChannelDescriptor(handle->rxDmaHandle, &descriptors[0]);
+    DMA_StartTransfer(handle->rxDmaHandle);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Stops the DMA ring buffer.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ */
+void USART_TransferStopRingBufferDMA(USART_Type *base, usart_dma_handle_t *handle)
+{
+    assert(NULL != handle);
+    assert(NULL != handle->rxDmaHandle);
+
+    DMA_AbortTransfer(handle->rxDmaHandle);
+    handle->rxRingBuffer = NULL;
+    handle->rxState      = (uint8_t)kUSART_RxIdle;
+}
+
+/*!
+ * brief Gets the length of received data in the DMA ring buffer.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * return Length of received data not released yet.
+ */
+size_t USART_TransferGetRxRingBufferLengthDMA(USART_Type *base, usart_dma_handle_t *handle)
+{
+    assert(NULL != handle);
+
+    uint32_t primask;
+    uint32_t length;
+
+    if (handle->rxState != (uint8_t)kUSART_RxBusy)
+    {
+        return 0U;
+    }
+
+    primask = DisableGlobalIRQ();
+    length  = USART_GetRxReceivedCountDMA(handle) - handle->rxTail;
+    EnableGlobalIRQ(primask);
+
+    return (length > handle->rxRingBufferSize) ? handle->rxRingBufferSize : length;
+}
+
+/*!
+ * brief Gets the oldest received data as one contiguous span of the ring buffer.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * param data Returns the start of the span.
+ * return Length of the span, 0 when nothing was received.
+ */
+size_t USART_TransferGetRxSpanDMA(USART_Type *base, usart_dma_handle_t *handle, uint8_t **data)
+{
+    assert(NULL != data);
+
+    size_t length = USART_TransferGetRxRingBufferLengthDMA(base, handle);
+    uint32_t index;
+
+    if (length == 0U)
+    {
+        *data = NULL;
+        return 0U;
+    }
+
+    /* The ring size is a power of 2, so the free running tail wraps at 2^32 without a seam. */
+    index = handle->rxTail & (handle->rxRingBufferSize - 1U);
+    if (length > (handle->rxRingBufferSize - index))
+    {
+        length = handle->rxRingBufferSize - index;
+    }
+
+    *data = &handle->rxRingBuffer[index];
+
+    return length;
+}
+
+/*!
+ * brief Gives received data back to the DMA.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * param length Bytes consumed, at most the length of the received data.
+ * retval kStatus_Success The data was released.
+ * retval kStatus_USART_RxRingBufferOverrun The DMA overwrote the data before it was released, the
+ *        ring buffer was emptied.
+ */
+status_t USART_TransferReleaseRxSpanDMA(USART_Type *base, usart_dma_handle_t *handle, size_t length)
+{
+    assert(NULL != handle);
+
+    status_t status = kStatus_Success;
+    uint32_t primask;
+    uint32_t received;
+
+    if (handle->rxState != (uint8_t)kUSART_RxBusy)
+    {
+        return kStatus_Success;
+    }
+
+    primask  = DisableGlobalIRQ();
+    received = USART_GetRxReceivedCountDMA(handle);
+    if ((received - handle->rxTail) > handle->rxRingBufferSize)
+    {
+        /* What the consumer has just read may be newer data, drop everything. */
+        handle->rxTail = received;
+        status         = kStatus_USART_RxRingBufferOverrun;
+    }
+    else
+    {
+        assert(length <= (received - handle->rxTail));
+        handle->rxTail += (uint32_t)length;
+    }
+    EnableGlobalIRQ(primask);
+
+    return status;
+}
+
+/*!
+ * brief Flushes a partial block when the receive line went idle.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ */
+void USART_TransferRxIdleTickDMA(USART_Type *base, usart_dma_handle_t *handle)
+{
+    assert(NULL != handle);
+
+    uint32_t primask;
+    uint32_t received;
+    bool flush = false;
+
+    if (handle->rxState != (uint8_t)kUSART_RxBusy)
+    {
+        return;
+    }
+
+    primask  = DisableGlobalIRQ();
+    received = USART_GetRxReceivedCountDMA(handle);
+    EnableGlobalIRQ(primask);
+
+    if (received != handle->rxIdleMark)
+    {
+        /* Still receiving. */
+        handle->rxIdleMark  = received;
+        handle->rxIdleArmed = true;
+    }
+    else if (handle->rxIdleArmed)
+    {
+        handle->rxIdleArmed = false;
+        /* A full block has already been reported by the DMA interrupt. */
+        if ((received & (handle->rxBlockSize - 1U)) != 0U)
+        {
+            handle->rxIdleFlushCount++;
+            flush = true;
+        }
+    }
+    else
+    {
+        /* Intentional empty */
+    }
+
+    if (flush && (handle->callback != NULL))
+    {
+        handle->callback(base, handle, kStatus_USART_Timeout, handle->userData);
+    }
+}
+
+/*!
+ * brief Gets the receive statistics of the DMA ring buffer.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * param stats Returns the statistics.
+ */
+void USART_TransferGetRxStatsDMA(USART_Type *base, usart_dma_handle_t *handle, usart_dma_rx_stats_t *stats)
+{
+    assert(NULL != handle);
+    assert(NULL != stats);
+
+    uint32_t primask;
+
+    primask               = DisableGlobalIRQ();
+    stats->rxBytes        = (handle->rxState == (uint8_t)kUSART_RxBusy) ? USART_GetRxReceivedCountDMA(handle) : 0U;
+    stats->blockIrqCount  = handle->rxBlockCount;
+    stats->idleFlushCount = handle->rxIdleFlushCount;
+    stats->overrunCount   = handle->rxOverrunCount;
+    EnableGlobalIRQ(primask);
+}
+
+/*!
+ * brief Installs the link descriptors of the DMA transmit requests.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * param descriptors Link descriptors allocated with DMA_ALLOCATE_LINK_DESCRIPTORS.
+ * param descriptorNum Number of descriptors, at most 65535.
+ * retval kStatus_Success The descriptors were installed.
+ * retval kStatus_InvalidArgument No descriptors.
+ * retval kStatus_USART_TxBusy Requests are still queued.
+ */
+status_t USART_TransferInstallTxDescriptorsDMA(USART_Type *base,
+                                               usart_dma_handle_t *handle,
+                                               dma_descriptor_t *descriptors,
+                                               size_t descriptorNum)
+{
+    assert(NULL != handle);
+    assert(NULL != handle->txDmaHandle);
+
+    if ((descriptors == NULL) || (descriptorNum == 0U) || (descriptorNum > 0xFFFFU))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (handle->txState != (uint8_t)kUSART_TxIdle)
+    {
+        return kStatus_USART_TxBusy;
+    }
+
+    handle->txDescriptors    = descriptors;
+    handle->txDescriptorNum  = (uint32_t)descriptorNum;
+    handle->txDescriptorHead = 0U;
+    handle->txDescriptorFree = (uint32_t)descriptorNum;
+
+    DMA_SetChannelConfig(handle->txDmaHandle->base, handle->txDmaHandle->channel, NULL, true);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Sends a list of buffers as one request with the DMA.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * param vector Segments of the request, zero length segments are skipped.
+ * param count Number of segments.
+ * retval kStatus_Success The request was queued.
+ * retval kStatus_InvalidArgument No data, or no descriptors were installed.
+ * retval kStatus_USART_TxBusy The queue or the descriptor pool is full, send again after a callback.
+ */
+status_t USART_TransferSendVectorDMA(USART_Type *base,
+                                     usart_dma_handle_t *handle,
+                                     const usart_transfer_t *vector,
+                                     size_t count)
+{
+    assert(NULL != handle);
+    assert(NULL != handle->txDmaHandle);
+
+    usart_dma_tx_request_t *request;
+    dma_descriptor_t *descriptors = handle->txDescriptors;
+    uint32_t descriptorCount      = 0U;
+    uint32_t bytes                = 0U;
+    uint32_t index;
+    uint32_t next;
+    uint32_t last;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t primask;
+    size_t i;
+
+    if ((vector == NULL) || (descriptors == NULL))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        if (vector[i].dataSize == 0U)
+        {
+            continue;
+        }
+        if (vector[i].txData == NULL)
+        {
+            return kStatus_InvalidArgument;
+        }
+        descriptorCount += (uint32_t)((vector[i].dataSize + USART_MAX_DMA_TX_DESCRIPTOR_SIZE - 1U) /
+                                      USART_MAX_DMA_TX_DESCRIPTOR_SIZE);
+        bytes += (uint32_t)vector[i].dataSize;
+    }
+
+    if (descriptorCount == 0U)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    primask = DisableGlobalIRQ();
+
+    if (((handle->txRequestHead - handle->txRequestTail) >= USART_DMA_TX_QUEUE_SIZE) ||
+        (descriptorCount > handle->txDescriptorFree))
+    {
+        handle->txStats.busyCount++;
+        EnableGlobalIRQ(primask);
+        return kStatus_USART_TxBusy;
+    }
+
+    /* The free descriptors follow the ones of the last queued request, the DMA does not read them. */
+    request                  = &handle->txRequests[handle->txRequestHead & USART_DMA_TX_QUEUE_MASK];
+    request->bytes           = bytes;
+    request->firstDescriptor = (uint16_t)handle->txDescriptorHead;
+    request->descriptorCount = (uint16_t)descriptorCount;
+
+    index = handle->txDescriptorHead;
+    last  = index;
+    for (i = 0U; i < count; i++)
+    {
+        for (offset = 0U; offset < vector[i].dataSize; offset += size)
+        {
+            size = (uint32_t)vector[i].dataSize - offset;
+            if (size > USART_MAX_DMA_TX_DESCRIPTOR_SIZE)
+            {
+                size = USART_MAX_DMA_TX_DESCRIPTOR_SIZE;
+            }
+            next = ((index + 1U) == handle->txDescriptorNum) ? 0U : (index + 1U);
+            DMA_SetupDescriptor(&descriptors[index],
+                                DMA_CHANNEL_XFER(true, false, false, false, sizeof(uint8_t),
+                                                 kDMA_AddressInterleave1xWidth, kDMA_AddressInterleave0xWidth, size),
+                                (void *)(uint32_t)&vector[i].txData[offset], (void *)(uint32_t)&base->TXDAT,
+                                &descriptors[next]);
+            last  = index;
+            index = next;
+        }
+    }
+
+    /* The chain is linked on to the next request when it starts, see USART_TxStartBatchDMA. */
+    descriptors[last].xfercfg = (descriptors[last].xfercfg & ~DMA_CHANNEL_XFERCFG_RELOAD_MASK) |
+                                DMA_CHANNEL_XFERCFG_SETINTA_MASK;
+    request->lastDescriptor = (uint16_t)last;
+
+    handle->txDescriptorHead = index;
+    handle->txDescriptorFree -= descriptorCount;
+    handle->txRequestHead++;
+
+    /* A busy DMA starts the request with the next chain. */
+    if (handle->txState == (uint8_t)kUSART_TxIdle)
+    {
+        USART_TxStartBatchDMA(handle);
+    }
+
+    EnableGlobalIRQ(primask);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Sends one buffer with the DMA.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * param xfer USART DMA transfer structure, see #usart_transfer_t.
+ * retval kStatus_Success The request was queued.
+ * retval kStatus_InvalidArgument No data, or no descriptors were installed.
+ * retval kStatus_USART_TxBusy The queue or the descriptor pool is full.
+ */
+status_t USART_TransferSendDMA(USART_Type *base, usart_dma_handle_t *handle, usart_transfer_t *xfer)
+{
+    return USART_TransferSendVectorDMA(base, handle, xfer, 1U);
+}
+
+/*!
+ * brief Aborts the running and the queued transmit requests.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ */
+void USART_TransferAbortSendDMA(USART_Type *base, usart_dma_handle_t *handle)
+{
+    assert(NULL != handle);
+    assert(NULL != handle->txDmaHandle);
+
+    dma_handle_t *dmaHandle = handle->txDmaHandle;
+    uint32_t primask;
+
+    primask = DisableGlobalIRQ();
+    DMA_AbortTransfer(dmaHandle);
+    DMA_COMMON_REG_SET(dmaHandle->base, dmaHandle->channel, INTA,
+                       1UL << DMA_CHANNEL_INDEX(dmaHandle->base, dmaHandle->channel));
+    handle->txRequestTail    = handle->txRequestHead;
+    handle->txRequestStarted = handle->txRequestHead;
+    handle->txDescriptorHead = 0U;
+    handle->txDescriptorFree = handle->txDescriptorNum;
+    handle->txState          = (uint8_t)kUSART_TxIdle;
+    EnableGlobalIRQ(primask);
+}
+
+/*!
+ * brief Gets the transmit statistics.
+ *
+ * param base USART peripheral base address.
+ * param handle Pointer to usart_dma_handle_t structure.
+ * param stats Returns the statistics.
+ */
+void USART_TransferGetTxStatsDMA(USART_Type *base, usart_dma_handle_t *handle, usart_dma_tx_stats_t *stats)
+{
+    assert(NULL != handle);
+    assert(NULL != stats);
+
+    uint32_t primask;
+
+    primask = DisableGlobalIRQ();
+    *stats  = handle->txStats;
+    EnableGlobalIRQ(primask);
+}
@@ -0,0 +1,242 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * CMSIS compiler header of the host build.
+ *
+ * Same definitions as cmsis_gcc.h for a Cortex-M0+, the core registers and the instructions
+ * without a C equivalent are provided by the simulator (fsl_hostsim.c).
+ */
+#ifndef CMSIS_HOSTSIM_H_
+#define CMSIS_HOSTSIM_H_
+
+#include <stdint.h>
+
+/* CMSIS compiler specific defines */
+#ifndef __ASM
+#define __ASM __asm
+#endif
+#ifndef __INLINE
+#define __INLINE inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN __attribute__((__noreturn__))
+#endif
+#ifndef CMSIS_DEPRECATED
+#define CMSIS_DEPRECATED __attribute__((deprecated))
+#endif
+#ifndef __USED
+#define __USED __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_STRUCT
+#define __PACKED_STRUCT struct __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_UNION
+#define __PACKED_UNION union __attribute__((packed, aligned(1)))
+#endif
+#ifndef __UNALIGNED_UINT16_WRITE
+#define __UNALIGNED_UINT16_WRITE(addr, val) (void)__builtin_memcpy((void *)(addr), &(uint16_t){(val)}, 2U)
+#endif
+#ifndef __UNALIGNED_UINT16_READ
+#define __UNALIGNED_UINT16_READ(addr) \
+    __extension__({                    \
+        uint16_t v_;                   \
+        __builtin_memcpy(&v_, (const void *)(addr), 2U); \
+        v_;                            \
+    })
+#endif
+#ifndef __UNALIGNED_UINT32_WRITE
+#define __UNALIGNED_UINT32_WRITE(addr, val) (void)__builtin_memcpy((void *)(addr), &(uint32_t){(val)}, 4U)
+#endif
+#ifndef __UNALIGNED_UINT32_READ
+#define __UNALIGNED_UINT32_READ(addr) \
+    __extension__({                    \
+        uint32_t v_;                   \
+        __builtin_memcpy(&v_, (const void *)(addr), 4U); \
+        v_;                            \
+    })
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x) __attribute__((aligned(x)))
+#endif
+#ifndef __RESTRICT
+#define __RESTRICT __restrict
+#endif
+#ifndef __COMPILER_BARRIER
+#define __COMPILER_BARRIER() __ASM volatile("" ::: "memory")
+#endif
+#ifndef __NO_INIT
+#define __NO_INIT
+#endif
+#ifndef __ALIAS
+#define __ALIAS(x) __attribute__((alias(x)))
+#endif
+
+/*******************************************************************************
+ * Core registers and instructions provided by the simulator
+ ******************************************************************************/
+
+void HOSTSIM_EnableIRQ(void);
+void HOSTSIM_DisableIRQ(void);
+uint32_t HOSTSIM_GetPRIMASK(void);
+void HOSTSIM_SetPRIMASK(uint32_t priMask);
+uint32_t HOSTSIM_GetIPSR(void);
+void HOSTSIM_WaitForInterrupt(void);
+
+#define __NOP()    __ASM volatile("nop")
+#define __WFI()    HOSTSIM_WaitForInterrupt()
+#define __WFE()    HOSTSIM_WaitForInterrupt()
+#define __SEV()    __COMPILER_BARRIER()
+#define __BKPT(value) __builtin_trap()
+
+__STATIC_FORCEINLINE void __ISB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __DSB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __DMB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value)
+{
+    return __builtin_bswap32(value);
+}
+
+__STATIC_FORCEINLINE uint32_t __REV16(uint32_t value)
+{
+    return ((value & 0x00FF00FFUL) << 8U) | ((value & 0xFF00FF00UL) >> 8U);
+}
+
+__STATIC_FORCEINLINE int16_t __REVSH(int16_t value)
+{
+    return (int16_t)__builtin_bswap16((uint16_t)value);
+}
+
+__STATIC_FORCEINLINE uint32_t __ROR(uint32_t op1, uint32_t op2)
+{
+    op2 %= 32U;
+    if (op2 == 0U)
+    {
+        return op1;
+    }
+    return (op1 >> op2) | (op1 << (32U - op2));
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < 32U; i++)
+    {
+        result = (result << 1U) | ((value >> i) & 1U);
+    }
+    return result;
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+__STATIC_FORCEINLINE int32_t __SSAT(int32_t val, uint32_t sat)
+{
+    if ((sat >= 1U) && (sat <= 32U))
+    {
+        const int32_t max = (int32_t)((1U << (sat - 1U)) - 1U);
+        const int32_t min = -1 - max;
+        if (val > max)
+        {
+            return max;
+        }
+        else if (val < min)
+        {
+            return min;
+        }
+    }
+    return val;
+}
+
+__STATIC_FORCEINLINE uint32_t __USAT(int32_t val, uint32_t sat)
+{
+    if (sat <= 31U)
+    {
+        const uint32_t max = ((1U << sat) - 1U);
+        if (val > (int32_t)max)
+        {
+            return max;
+        }
+        else if (val < 0)
+        {
+            return 0U;
+        }
+    }
+    return (uint32_t)val;
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+    HOSTSIM_EnableIRQ();
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+    HOSTSIM_DisableIRQ();
+}
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void)
+{
+    return HOSTSIM_GetPRIMASK();
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t priMask)
+{
+    HOSTSIM_SetPRIMASK(priMask);
+}
+
+__STATIC_FORCEINLINE uint32_t __get_IPSR(void)
+{
+    return HOSTSIM_GetIPSR();
+}
+
+__STATIC_FORCEINLINE uint32_t __get_xPSR(void)
+{
+    return HOSTSIM_GetIPSR();
+}
+
+__STATIC_FORCEINLINE uint32_t __get_APSR(void)
+{
+    return 0U;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_CONTROL(void)
+{
+    return 0U;
+}
+
+__STATIC_FORCEINLINE void __set_CONTROL(uint32_t control)
+{
+    (void)control;
+}
+
+#endif /* CMSIS_HOSTSIM_H_ */
@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host build of the Cortex-M0+ core header.
+ *
+ * LPC845.h includes "core_cm0plus.h" from the include path, this directory is searched before
+ * CMSIS/Core/Include so the host build gets this wrapper. It keeps the Arm inline assembly of
+ * cmsis_gcc.h out of the build, maps the intrinsics and the NVIC functions to the simulator and
+ * then includes the real CMSIS header for the register layout of the core peripherals.
+ */
+#ifndef HOSTSIM_CORE_CM0PLUS_H_
+#define HOSTSIM_CORE_CM0PLUS_H_
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "The LPC845 host simulator runs on x86-64 Linux only."
+#endif
+
+/* cmsis_gcc.h is replaced by cmsis_hostsim.h. */
+#define __CMSIS_GCC_H
+#include "cmsis_hostsim.h"
+
+#define CMSIS_NVIC_VIRTUAL
+#define CMSIS_NVIC_VIRTUAL_HEADER_FILE "hostsim_nvic_virtual.h"
+#define CMSIS_VECTAB_VIRTUAL
+#define CMSIS_VECTAB_VIRTUAL_HEADER_FILE "hostsim_vectab_virtual.h"
+
+#include_next <core_cm0plus.h>
+
+/*
+ * The Cortex-M0+ has no DWT cycle counter, the simulator provides one so that SDK_DelayAtLeastUs
+ * and MSDK_GetCpuCycleCount follow the host clock (build with SDK_DELAY_USE_DWT).
+ */
+typedef struct
+{
+    __IOM uint32_t CTRL;   /*!< Offset: 0x000 (R/W)  Control Register */
+    __IOM uint32_t CYCCNT; /*!< Offset: 0x004 (R/W)  Cycle Count Register */
+} DWT_Type;
+
+typedef struct
+{
+    __IOM uint32_t DHCSR; /*!< Offset: 0x000 (R/W)  Debug Halting Control and Status Register */
+    __OM uint32_t DCRSR;  /*!< Offset: 0x004 ( /W)  Debug Core Register Selector Register */
+    __IOM uint32_t DCRDR; /*!< Offset: 0x008 (R/W)  Debug Core Register Data Register */
+    __IOM uint32_t DEMCR; /*!< Offset: 0x00C (R/W)  Debug Exception and Monitor Control Register */
+} CoreDebug_Type;
+
+#define DWT_BASE       (0xE0001000UL)
+#define CoreDebug_BASE (0xE000EDF0UL)
+#define DWT            ((DWT_Type *)DWT_BASE)
+#define CoreDebug      ((CoreDebug_Type *)CoreDebug_BASE)
+
+#define DWT_CTRL_NOCYCCNT_Msk       (1UL << 25U)
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24U)
+
+#endif /* HOSTSIM_CORE_CM0PLUS_H_ */
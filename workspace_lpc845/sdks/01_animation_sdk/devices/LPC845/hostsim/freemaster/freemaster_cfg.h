@@ -0,0 +1,40 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * FreeMASTER configuration of the host benches. Only the driver core is built, the serial
+ * transport is selected to satisfy the configuration checks but no low-level driver is linked.
+ */
+
+#ifndef __FREEMASTER_CFG_H
+#define __FREEMASTER_CFG_H
+
+#define FMSTR_PLATFORM_CORTEX_M 1 // 32-bit little endian, the same types as on the host
+
+#define FMSTR_DISABLE     0
+#define FMSTR_LONG_INTR   0
+#define FMSTR_SHORT_INTR  0
+#define FMSTR_POLL_DRIVEN 1
+
+#define FMSTR_TRANSPORT  FMSTR_SERIAL
+#define FMSTR_SERIAL_DRV FMSTR_SERIAL_MCUX_USART
+
+#define FMSTR_COMM_BUFFER_SIZE 0
+
+#define FMSTR_USE_APPCMD   0
+#define FMSTR_USE_SCOPE    0
+#ifndef FMSTR_USE_RECORDER
+#define FMSTR_USE_RECORDER 0 // the recorder bench enables it
+#endif
+#define FMSTR_USE_PIPES    0
+
+// TSA with the memory access checks, FMSTR_TSA_INDEX_SIZE is set by the bench target
+#define FMSTR_USE_TSA 1
+#ifndef FMSTR_USE_TSA_SAFETY
+#define FMSTR_USE_TSA_SAFETY 1 // off for the recorder bench, which has no TSA tables
+#endif
+#define FMSTR_USE_TSA_INROM   1
+#define FMSTR_USE_TSA_DYNAMIC 1
+
+#endif /* __FREEMASTER_CFG_H */
@@ -0,0 +1,357 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef FSL_HOSTSIM_H_
+#define FSL_HOSTSIM_H_
+
+#include "fsl_common.h"
+
+/*!
+ * @addtogroup hostsim
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*! @{ */
+/*! @brief Host simulator version. */
+#define FSL_HOSTSIM_VERSION (MAKE_VERSION(1, 0, 0))
+/*! @} */
+
+/*! @brief Period of the simulation tick in microseconds, models and SysTick advance once per tick. */
+#ifndef HOSTSIM_TICK_US
+#define HOSTSIM_TICK_US (100U)
+#endif
+
+/*! @brief Maximum number of register blocks one instruction may touch. */
+#define HOSTSIM_STEP_MAX_ACCESSES (4U)
+
+/*! @brief Kind of access reported to a model. */
+typedef enum _hostsim_access
+{
+    kHOSTSIM_AccessPrepareRead = 0U, /*!< A register is about to be read, update it now. */
+    kHOSTSIM_AccessRead        = 1U, /*!< A register was read, apply read side effects. */
+    kHOSTSIM_AccessWrite       = 2U, /*!< A register was written, the previous value is passed along. */
+} hostsim_access_t;
+
+/* Forward declaration of the model typedef. */
+typedef struct _hostsim_model hostsim_model_t;
+
+/*!
+ * @brief Register access hook of a model.
+ *
+ * Called with the register block writable, from a signal handler when the CPU made the access.
+ * The hook must be async-signal-safe and must reach other register blocks through
+ * HOSTSIM_BusRead/HOSTSIM_BusWrite only.
+ *
+ * @param model The model owning the register.
+ * @param offset Offset of the accessed word in the register block.
+ * @param access Kind of access.
+ * @param oldValue Value of the word before a write, the current value otherwise.
+ */
+typedef void (*hostsim_access_hook_t)(hostsim_model_t *model,
+                                      uint32_t offset,
+                                      hostsim_access_t access,
+                                      uint32_t oldValue);
+
+/*!
+ * @brief Periodic hook of a model.
+ *
+ * @param model The model.
+ * @param cycles Core clock cycles elapsed since the simulator was started.
+ */
+typedef void (*hostsim_tick_hook_t)(hostsim_model_t *model, uint64_t cycles);
+
+/*!
+ * @brief DMA request line of a peripheral model.
+ *
+ * @param model The model.
+ * @param request Request line of the peripheral, e.g. 0 for receive and 1 for transmit.
+ * @return true when the peripheral requests a DMA transfer.
+ */
+typedef bool (*hostsim_dma_request_t)(hostsim_model_t *model, uint32_t request);
+
+/*!
+ * @brief Behavior model of one peripheral register block.
+ *
+ * Attached register blocks are mapped without access rights, every CPU access traps into the
+ * simulator which calls the access hook before (reads) and after the instruction. Register
+ * blocks without a model are plain memory.
+ */
+struct _hostsim_model
+{
+    uint32_t base;                    /*!< Address of the register block. */
+    uint32_t size;                    /*!< Size of the register block in bytes. */
+    hostsim_access_hook_t access;     /*!< Register access hook. */
+    hostsim_tick_hook_t tick;         /*!< Periodic hook, NULL if not used. */
+    hostsim_dma_request_t dmaRequest; /*!< DMA request lines, NULL if the peripheral has none. */
+    void *userData;                   /*!< Model specific data. */
+    uint32_t unlockCount;             /*!< Nesting of writable access, managed by the simulator. */
+    hostsim_model_t *next;            /*!< Next attached model, managed by the simulator. */
+};
+
+/*! @brief FIFO of 16-bit data frames shared by the models and the application. */
+typedef struct _hostsim_fifo
+{
+    uint16_t *buffer;       /*!< Storage for size frames. */
+    uint32_t size;          /*!< Number of frames, power of 2. */
+    volatile uint32_t head; /*!< Frames pushed, wraps at 2^32. */
+    volatile uint32_t tail; /*!< Frames popped, wraps at 2^32. */
+} hostsim_fifo_t;
+
+/*! @brief Simulator statistics. */
+typedef struct _hostsim_stats
+{
+    uint32_t trapCount;   /*!< Register accesses trapped into a model. */
+    uint32_t irqCount;    /*!< Exception handlers run. */
+    uint32_t tickCount;   /*!< Simulation ticks. */
+    uint32_t maskedCount; /*!< Sections with PRIMASK set, see HOSTSIM_SetMaskTiming. */
+    uint32_t maskedMaxNs; /*!< Host time of the longest section with PRIMASK set. */
+    uint64_t maskedNs;    /*!< Host time spent with PRIMASK set. */
+} hostsim_stats_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name Simulator control
+ * @{
+ */
+
+/*!
+ * @brief Maps the LPC845 peripheral address space into the host process and starts the simulation tick.
+ *
+ * The peripheral base pointers of the device header are used unchanged, the simulator maps memory
+ * at the peripheral addresses. The host program must be linked without PIE (-no-pie) so that
+ * static buffers passed to the DMA have 32-bit addresses.
+ *
+ * @code
+ * HOSTSIM_Init();
+ * HOSTSIM_UsartModelInit(&usartModel, USART0, USART0_IRQn, &txFifo, &rxFifo);
+ * USART_Init(USART0, &config, CLOCK_GetFreq(kCLOCK_MainClk));
+ * @endcode
+ *
+ * @retval kStatus_Success The simulator is running.
+ * @retval kStatus_Fail The peripheral address space is not available in this process.
+ */
+status_t HOSTSIM_Init(void);
+
+/*!
+ * @brief Stops the simulation tick, detaches all models and unmaps the peripheral address space.
+ */
+void HOSTSIM_Deinit(void);
+
+/*!
+ * @brief Attaches a model to its register block.
+ *
+ * The registers keep their current value, the model initializes them before attaching.
+ *
+ * @param model The model, base and size must be set.
+ */
+void HOSTSIM_AttachModel(hostsim_model_t *model);
+
+/*!
+ * @brief Detaches a model, its register block becomes plain memory again.
+ *
+ * @param model The model.
+ */
+void HOSTSIM_DetachModel(hostsim_model_t *model);
+
+/*!
+ * @brief Makes the registers of a model writable for the caller.
+ *
+ * Used by model functions the application calls, e.g. to inject received data. The simulation
+ * tick is held off until HOSTSIM_ExitModel.
+ *
+ * @param model The model.
+ * @return State to pass to HOSTSIM_ExitModel.
+ */
+uint32_t HOSTSIM_EnterModel(hostsim_model_t *model);
+
+/*!
+ * @brief Ends the access started by HOSTSIM_EnterModel and takes pending interrupts.
+ *
+ * @param model The model.
+ * @param state Value returned by HOSTSIM_EnterModel.
+ */
+void HOSTSIM_ExitModel(hostsim_model_t *model, uint32_t state);
+
+/*!
+ * @brief Runs the model ticks and takes pending interrupts without waiting for the tick timer.
+ */
+void HOSTSIM_Poll(void);
+
+/*!
+ * @brief Gets the core clock cycles elapsed since HOSTSIM_Init, scaled by SystemCoreClock.
+ *
+ * @return Elapsed cycles.
+ */
+uint64_t HOSTSIM_GetCycles(void);
+
+/*!
+ * @brief Gets the simulator statistics.
+ *
+ * @param stats Returns the statistics.
+ */
+void HOSTSIM_GetStats(hostsim_stats_t *stats);
+
+/*!
+ * @brief Turns the timing of the sections with PRIMASK set on or off.
+ *
+ * The time from __disable_irq to the next __enable_irq is added to the masked statistics. It is
+ * off after HOSTSIM_Init, the timing adds two clock reads to every masked section. Turning it on
+ * clears the longest section.
+ *
+ * @param enable Time the masked sections.
+ */
+void HOSTSIM_SetMaskTiming(bool enable);
+
+/*! @} */
+
+/*!
+ * @name Interrupt injection
+ * @{
+ */
+
+/*!
+ * @brief Sets the level of a peripheral interrupt line.
+ *
+ * The interrupt is taken while the line is asserted and the interrupt is enabled in the NVIC,
+ * like the level sensitive interrupts of the device.
+ *
+ * @param irq Interrupt number.
+ * @param asserted Line level.
+ */
+void HOSTSIM_SetIRQLine(IRQn_Type irq, bool asserted);
+
+/*!
+ * @brief Pends an interrupt once, like a pulse on the interrupt line.
+ *
+ * @param irq Interrupt number, system exceptions included.
+ */
+void HOSTSIM_PendIRQ(IRQn_Type irq);
+
+/*! @} */
+
+/*!
+ * @name Bus access for models
+ * @{
+ */
+
+/*!
+ * @brief Reads memory or a modelled register the way a bus master does.
+ *
+ * @param address Address to read.
+ * @param width Access width in bytes, 1, 2 or 4.
+ * @return Value read.
+ */
+uint32_t HOSTSIM_BusRead(uint32_t address, uint32_t width);
+
+/*!
+ * @brief Writes memory or a modelled register the way a bus master does.
+ *
+ * @param address Address to write.
+ * @param width Access width in bytes, 1, 2 or 4.
+ * @param value Value to write.
+ */
+void HOSTSIM_BusWrite(uint32_t address, uint32_t width, uint32_t value);
+
+/*!
+ * @brief Reports whether a DMA request line of a peripheral is active.
+ *
+ * @param base Register block address of the peripheral.
+ * @param request Request line of the peripheral.
+ * @return true when the peripheral requests a transfer, true as well when it has no model.
+ */
+bool HOSTSIM_GetDmaRequest(uint32_t base, uint32_t request);
+
+/*! @} */
+
+/*!
+ * @name FIFO
+ * @{
+ */
+
+/*!
+ * @brief Initializes a FIFO.
+ *
+ * @param fifo The FIFO.
+ * @param buffer Storage for size frames.
+ * @param size Number of frames, power of 2.
+ */
+static inline void HOSTSIM_FifoInit(hostsim_fifo_t *fifo, uint16_t *buffer, uint32_t size)
+{
+    assert((size != 0U) && ((size & (size - 1U)) == 0U));
+
+    fifo->buffer = buffer;
+    fifo->size   = size;
+    fifo->head   = 0U;
+    fifo->tail   = 0U;
+}
+
+/*!
+ * @brief Gets the number of frames in a FIFO.
+ *
+ * @param fifo The FIFO.
+ * @return Number of frames.
+ */
+static inline uint32_t HOSTSIM_FifoCount(const hostsim_fifo_t *fifo)
+{
+    return fifo->head - fifo->tail;
+}
+
+/*!
+ * @brief Pushes a frame.
+ *
+ * @param fifo The FIFO.
+ * @param data Frame.
+ * @return false when the FIFO is full.
+ */
+static inline bool HOSTSIM_FifoPush(hostsim_fifo_t *fifo, uint16_t data)
+{
+    if ((fifo->head - fifo->tail) == fifo->size)
+    {
+        return false;
+    }
+    fifo->buffer[fifo->head & (fifo->size - 1U)] = data;
+    __COMPILER_BARRIER();
+    fifo->head++;
+    return true;
+}
+
+/*!
+ * @brief Pops a frame.
+ *
+ * @param fifo The FIFO.
+ * @param data Returns the frame.
+ * @return false when the FIFO is empty.
+ */
+static inline bool HOSTSIM_FifoPop(hostsim_fifo_t *fifo, uint16_t *data)
+{
+    if (fifo->head == fifo->tail)
+    {
+        return false;
+    }
+    *data = fifo->buffer[fifo->tail & (fifo->size - 1U)];
+    __COMPILER_BARRIER();
+    fifo->tail++;
+    return true;
+}
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* FSL_HOSTSIM_H_ */
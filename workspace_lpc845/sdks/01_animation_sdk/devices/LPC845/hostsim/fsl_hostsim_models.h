@@ -0,0 +1,520 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef FSL_HOSTSIM_MODELS_H_
+#define FSL_HOSTSIM_MODELS_H_
+
+#include "fsl_hostsim.h"
+
+/*!
+ * @addtogroup hostsim
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Maximum number of DMA transfers done by one simulation tick. */
+#ifndef HOSTSIM_DMA_MAX_TRANSFERS_PER_TICK
+#define HOSTSIM_DMA_MAX_TRANSFERS_PER_TICK (4096U)
+#endif
+
+/*! @brief DMA request lines of the USART, SPI and CAPT models. */
+enum
+{
+    kHOSTSIM_DmaRequestRx = 0U, /*!< Receive data available. */
+    kHOSTSIM_DmaRequestTx = 1U, /*!< Transmit data register empty. */
+};
+
+/*!
+ * @brief USART model.
+ *
+ * Frames move instantly, a frame written to TXDAT goes to the transmit FIFO (or back to the
+ * receiver in loopback mode) and the next frame of the receive FIFO is loaded as soon as RXDAT
+ * was read.
+ */
+typedef struct _hostsim_usart_model
+{
+    hostsim_model_t model;  /*!< Simulator model, must be the first member. */
+    IRQn_Type irq;          /*!< Interrupt of the USART. */
+    hostsim_fifo_t *txFifo; /*!< Frames transmitted by the USART. */
+    hostsim_fifo_t *rxFifo; /*!< Frames the USART receives. */
+} hostsim_usart_model_t;
+
+/*!
+ * @brief SPI slave device of the SPI model.
+ *
+ * @param userData User data of the SPI model.
+ * @param mosi Frame sent by the master.
+ * @param endOfTransfer The frame ends the transfer.
+ * @return Frame sent back by the slave.
+ */
+typedef uint16_t (*hostsim_spi_slave_t)(void *userData, uint16_t mosi, bool endOfTransfer);
+
+/*!
+ * @brief SPI master model.
+ *
+ * Each frame is exchanged with the slave callback as soon as it is written, without a slave
+ * callback the slave returns all ones. Loopback mode returns the frame sent.
+ */
+typedef struct _hostsim_spi_model
+{
+    hostsim_model_t model;     /*!< Simulator model, must be the first member. */
+    IRQn_Type irq;             /*!< Interrupt of the SPI. */
+    hostsim_spi_slave_t slave; /*!< Slave device, NULL if none. */
+    void *userData;            /*!< User data of the slave device. */
+} hostsim_spi_model_t;
+
+/*! @brief Number of memory devices on the bus of an I2C model. */
+#ifndef HOSTSIM_I2C_MAX_DEVICES
+#define HOSTSIM_I2C_MAX_DEVICES (4U)
+#endif
+
+/*!
+ * @brief Memory device on the bus of the I2C model.
+ *
+ * The device behaves like a serial EEPROM or a sensor with a one byte register address: a write
+ * sets the address pointer with the first byte and stores the others, a read returns the data
+ * from the address pointer. Both wrap at the end of the memory.
+ */
+typedef struct _hostsim_i2c_device
+{
+    uint8_t address;     /*!< 7-bit address of the device. */
+    uint8_t *memory;     /*!< Device memory. */
+    uint32_t memorySize; /*!< Size of the device memory. */
+    uint32_t pointer;    /*!< Address pointer of the device. */
+} hostsim_i2c_device_t;
+
+/*!
+ * @brief I2C master model with memory devices on the bus.
+ *
+ * With MSTDMA set, the master requests DMA transfers while it is ready to send or receive data,
+ * a write of MSTDAT sends the byte and a read of MSTDAT receives the next one.
+ */
+typedef struct _hostsim_i2c_model
+{
+    hostsim_model_t model;                                /*!< Simulator model, must be the first member. */
+    IRQn_Type irq;                                        /*!< Interrupt of the I2C. */
+    hostsim_i2c_device_t device[HOSTSIM_I2C_MAX_DEVICES]; /*!< Devices on the bus. */
+    uint32_t deviceCount;                                 /*!< Number of devices. */
+    hostsim_i2c_device_t *selected;                       /*!< Device addressed by the current transfer. */
+    bool addressPhase;                                    /*!< The next byte written sets the address pointer. */
+    bool read;                                            /*!< The current transfer reads from the device. */
+} hostsim_i2c_model_t;
+
+/*!
+ * @brief Sample source of the ADC model.
+ *
+ * @param userData User data of the ADC model.
+ * @param channel ADC channel.
+ * @return 12-bit conversion result.
+ */
+typedef uint16_t (*hostsim_adc_sample_t)(void *userData, uint32_t channel);
+
+/*!
+ * @brief ADC model.
+ *
+ * With the interrupt at the end of the sequence (MODE set), a sequence converts all its channels
+ * as soon as it is started. With the interrupt per conversion, it converts one channel every
+ * simulation tick and the sequence interrupt flag follows DATAVALID of SEQ_GDAT. Burst mode starts
+ * the sequence again after its last channel. The DMA request lines are the sequence interrupt
+ * flags, 0 for sequence A and 1 for sequence B, like the DMA triggers of INPUTMUX.
+ */
+typedef struct _hostsim_adc_model
+{
+    hostsim_model_t model;                    /*!< Simulator model, must be the first member. */
+    hostsim_adc_sample_t sample;              /*!< Sample source, NULL returns mid scale. */
+    void *userData;                           /*!< User data of the sample source. */
+    uint32_t pending[ADC_SEQ_CTRL_COUNT];     /*!< Channels of the running sequence still to convert. */
+    uint32_t conversions[ADC_SEQ_CTRL_COUNT]; /*!< Conversions of each sequence since initialization. */
+} hostsim_adc_model_t;
+
+/*!
+ * @brief Sample source of the CAPT model.
+ *
+ * @param userData User data of the CAPT model.
+ * @param xpins X pins of the measurement, one pin in a polling round, all enabled pins together in a
+ *              poll-now or a low-power round.
+ * @return Count of the measurement, a count of 2^TOUT or more times out.
+ */
+typedef uint16_t (*hostsim_capt_sample_t)(void *userData, uint16_t xpins);
+
+/*!
+ * @brief CAPT model.
+ *
+ * One measurement every simulation tick, the poll delay of POLL_TCNT between the rounds is counted
+ * in core clock cycles. The DMA request is raised by the measurements the DMA field of CTRL selects
+ * and cleared by the read of TOUCH.
+ */
+typedef struct _hostsim_capt_model
+{
+    hostsim_model_t model;        /*!< Simulator model, must be the first member. */
+    hostsim_capt_sample_t sample; /*!< Sample source, NULL returns no touch. */
+    void *userData;               /*!< User data of the sample source. */
+    uint32_t delayTicks;          /*!< Ticks left of the poll delay. */
+    uint16_t roundPins;           /*!< X pins of the running round still to measure. */
+    bool unread;                  /*!< TOUCH holds a measurement not read yet. */
+    bool dmaRequest;              /*!< The DMA request is raised. */
+} hostsim_capt_model_t;
+
+/*!
+ * @brief PINT model.
+ *
+ * The inputs are the pins selected by PINTSEL0 to PINTSEL7, HOSTSIM_PintModelSetInputs drives them.
+ * The edge and level detection sets RISE, FALL and IST and drives the pin interrupt lines. With
+ * SEL_PMATCH set the pattern match engine evaluates the bit slices instead and pends the interrupt
+ * of the end point slice when its product term starts to match.
+ */
+typedef struct _hostsim_pint_model
+{
+    hostsim_model_t model; /*!< Simulator model, must be the first member. */
+    uint8_t inputs;        /*!< Levels of the inputs, bit n is the pin selected by PINTSELn. */
+    uint8_t sticky;        /*!< Sticky edges detected by the bit slices since the last write of PMSRC. */
+    uint8_t matches;       /*!< Matching product terms, by end point slice. */
+} hostsim_pint_model_t;
+
+/*!
+ * @brief GPIO model.
+ *
+ * All pins read back the level of their output. Writes to the byte and word pin registers, PIN,
+ * MPIN through MASK, SET, CLR and NOT change the outputs, B, W, MPIN and SET always read the
+ * current levels. DIRSET, DIRCLR and DIRNOT change DIR.
+ */
+typedef struct _hostsim_gpio_model
+{
+    hostsim_model_t model; /*!< Simulator model, must be the first member. */
+    uint32_t writes;       /*!< Writes that changed the outputs. */
+} hostsim_gpio_model_t;
+
+/*! @brief Channel state of the DMA model. */
+typedef struct _hostsim_dma_channel
+{
+    uint32_t srcEndAddr;     /*!< Last source address of the current descriptor. */
+    uint32_t dstEndAddr;     /*!< Last destination address of the current descriptor. */
+    uint32_t linkToNextDesc; /*!< Next descriptor. */
+    uint32_t remaining;      /*!< Transfers left in the current descriptor. */
+    uint32_t requestBase;    /*!< Register block of the peripheral requesting transfers, 0 if none. */
+    uint32_t request;        /*!< Request line of the peripheral. */
+    uint32_t burstLeft;      /*!< Transfers left of the burst started by a hardware trigger edge. */
+    bool loaded;             /*!< A descriptor is loaded. */
+    bool triggered;          /*!< The channel is triggered. */
+    bool triggerLevel;       /*!< Active level of the hardware trigger at the last transfer. */
+} hostsim_dma_channel_t;
+
+/*!
+ * @brief DMA controller model.
+ *
+ * Transfers run every simulation tick and after each access to the DMA registers, as long
+ * as the requesting peripheral asks for data. A channel with the hardware trigger enabled takes
+ * the request line of its peripheral as the trigger input: an edge starts one burst, or the whole
+ * descriptor without TRIGBURST, a level transfers while it is active. The descriptors are read in
+ * the layout of dma_descriptor_t of the host build.
+ */
+typedef struct _hostsim_dma_model
+{
+    hostsim_model_t model;                                   /*!< Simulator model, must be the first member. */
+    hostsim_dma_channel_t channel[FSL_FEATURE_DMA_NUMBER_OF_CHANNELS]; /*!< Channel state. */
+    uint32_t transferCount;                                  /*!< Transfers done since initialization. */
+} hostsim_dma_model_t;
+
+/*! @brief Busy time of a program command per page, the core stalls while the flash is busy. */
+#ifndef HOSTSIM_IAP_PROGRAM_US
+#define HOSTSIM_IAP_PROGRAM_US (1000U)
+#endif
+
+/*! @brief Busy time of an erase command, page or sector, of the order of the LPC8xx flash. */
+#ifndef HOSTSIM_IAP_ERASE_US
+#define HOSTSIM_IAP_ERASE_US (20000U)
+#endif
+
+/*!
+ * @brief Host address of the flash of the IAP model.
+ *
+ * The host does not map address 0, the flash contents are there instead. Drivers reading the flash
+ * add it to the flash addresses of the device.
+ */
+#define HOSTSIM_IAP_FLASH_BASE (0x0E000000U)
+
+/*! @brief Flash pages of the IAP model. */
+#define HOSTSIM_IAP_PAGES \
+    ((uint32_t)FSL_FEATURE_SYSCON_FLASH_SIZE_BYTES / (uint32_t)FSL_FEATURE_SYSCON_FLASH_PAGE_SIZE_BYTES)
+
+/*!
+ * @brief Power loss of the IAP model.
+ *
+ * Called in the middle of the torn command, it must not return, e.g. longjmp to a simulated
+ * reset. If it returns, the command fails with kStatus_IAP_Busy.
+ *
+ * @param userData User data of the power loss.
+ */
+typedef void (*hostsim_iap_power_loss_t)(void *userData);
+
+/*!
+ * @brief IAP ROM model with the on-chip flash.
+ *
+ * The ROM entry of the device calls the model, the unmodified IAP driver runs on it. Programming
+ * clears bits only, like the flash cells, erasing sets the pages to 0xFF. The flash contents are
+ * at HOSTSIM_IAP_FLASH_BASE.
+ */
+typedef struct _hostsim_iap_model
+{
+    uint8_t *flash;                            /*!< Flash contents at HOSTSIM_IAP_FLASH_BASE. */
+    uint64_t prepared;                         /*!< Sectors prepared for the next program or erase. */
+    uint32_t programs;                         /*!< Program commands. */
+    uint32_t programBytes;                     /*!< Bytes programmed. */
+    uint32_t erases;                           /*!< Erase commands. */
+    uint64_t busyUs;                           /*!< Time the flash was busy. */
+    uint32_t maxBusyUs;                        /*!< Longest busy time of a command. */
+    uint32_t pageErases[HOSTSIM_IAP_PAGES];    /*!< Erases of every page. */
+    uint32_t powerLossCountdown;               /*!< Program and erase commands until the power loss, 0 for none. */
+    hostsim_iap_power_loss_t powerLoss;        /*!< Power loss callback. */
+    void *userData;                            /*!< User data of the power loss callback. */
+    uint32_t random;                           /*!< State of the generator that tears the commands. */
+} hostsim_iap_model_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name USART model
+ * @{
+ */
+
+/*!
+ * @brief Resets the USART registers and attaches the model.
+ *
+ * @param usart The USART model.
+ * @param base USART peripheral base address.
+ * @param irq Interrupt of the USART.
+ * @param txFifo Receives the transmitted frames.
+ * @param rxFifo Frames to receive, filled with HOSTSIM_UsartModelReceive.
+ */
+void HOSTSIM_UsartModelInit(hostsim_usart_model_t *usart,
+                            USART_Type *base,
+                            IRQn_Type irq,
+                            hostsim_fifo_t *txFifo,
+                            hostsim_fifo_t *rxFifo);
+
+/*!
+ * @brief Feeds data into the receiver of the USART.
+ *
+ * @param usart The USART model.
+ * @param data Data to receive.
+ * @param length Length of the data.
+ * @return Number of bytes accepted by the receive FIFO.
+ */
+size_t HOSTSIM_UsartModelReceive(hostsim_usart_model_t *usart, const uint8_t *data, size_t length);
+
+/*! @} */
+
+/*!
+ * @name SPI model
+ * @{
+ */
+
+/*!
+ * @brief Resets the SPI registers and attaches the model.
+ *
+ * @param spi The SPI model.
+ * @param base SPI peripheral base address.
+ * @param irq Interrupt of the SPI.
+ * @param slave Slave device, NULL if none.
+ * @param userData User data of the slave device.
+ */
+void HOSTSIM_SpiModelInit(
+    hostsim_spi_model_t *spi, SPI_Type *base, IRQn_Type irq, hostsim_spi_slave_t slave, void *userData);
+
+/*! @} */
+
+/*!
+ * @name I2C model
+ * @{
+ */
+
+/*!
+ * @brief Resets the I2C registers and attaches the model.
+ *
+ * @param i2c The I2C model.
+ * @param base I2C peripheral base address.
+ * @param irq Interrupt of the I2C.
+ * @param deviceAddress 7-bit address of the memory device.
+ * @param memory Device memory.
+ * @param memorySize Size of the device memory.
+ */
+void HOSTSIM_I2cModelInit(hostsim_i2c_model_t *i2c,
+                          I2C_Type *base,
+                          IRQn_Type irq,
+                          uint8_t deviceAddress,
+                          uint8_t *memory,
+                          uint32_t memorySize);
+
+/*!
+ * @brief Adds another memory device to the bus of the I2C model.
+ *
+ * @param i2c The I2C model.
+ * @param deviceAddress 7-bit address of the memory device.
+ * @param memory Device memory.
+ * @param memorySize Size of the device memory.
+ */
+void HOSTSIM_I2cModelAddDevice(hostsim_i2c_model_t *i2c, uint8_t deviceAddress, uint8_t *memory, uint32_t memorySize);
+
+/*! @} */
+
+/*!
+ * @name ADC model
+ * @{
+ */
+
+/*!
+ * @brief Resets the ADC registers and attaches the model.
+ *
+ * @param adc The ADC model.
+ * @param base ADC peripheral base address.
+ * @param sample Sample source, NULL returns mid scale.
+ * @param userData User data of the sample source.
+ */
+void HOSTSIM_AdcModelInit(hostsim_adc_model_t *adc, ADC_Type *base, hostsim_adc_sample_t sample, void *userData);
+
+/*! @} */
+
+/*!
+ * @name CAPT model
+ * @{
+ */
+
+/*!
+ * @brief Resets the CAPT registers and attaches the model.
+ *
+ * The DMA request line is kHOSTSIM_DmaRequestRx.
+ *
+ * @param capt The CAPT model.
+ * @param base CAPT peripheral base address.
+ * @param sample Sample source, NULL returns no touch.
+ * @param userData User data of the sample source.
+ */
+void HOSTSIM_CaptModelInit(hostsim_capt_model_t *capt, CAPT_Type *base, hostsim_capt_sample_t sample, void *userData);
+
+/*! @} */
+
+/*!
+ * @name PINT model
+ * @{
+ */
+
+/*!
+ * @brief Resets the PINT registers and attaches the model, all inputs are low.
+ *
+ * @param pint The PINT model.
+ * @param base PINT peripheral base address.
+ */
+void HOSTSIM_PintModelInit(hostsim_pint_model_t *pint, PINT_Type *base);
+
+/*!
+ * @brief Sets the levels of the PINT inputs and takes the resulting interrupts.
+ *
+ * All inputs that differ from the previous levels change at the same time.
+ *
+ * @param pint The PINT model.
+ * @param inputs Input levels, bit n is the pin selected by PINTSELn.
+ */
+void HOSTSIM_PintModelSetInputs(hostsim_pint_model_t *pint, uint8_t inputs);
+
+/*! @} */
+
+/*!
+ * @name GPIO model
+ * @{
+ */
+
+/*!
+ * @brief Resets the GPIO registers and attaches the model, all pins are low inputs.
+ *
+ * @param gpio The GPIO model.
+ * @param base GPIO peripheral base address.
+ */
+void HOSTSIM_GpioModelInit(hostsim_gpio_model_t *gpio, GPIO_Type *base);
+
+/*! @} */
+
+/*!
+ * @name DMA model
+ * @{
+ */
+
+/*!
+ * @brief Resets the DMA registers and attaches the model.
+ *
+ * @param dma The DMA model.
+ * @param base DMA peripheral base address.
+ */
+void HOSTSIM_DmaModelInit(hostsim_dma_model_t *dma, DMA_Type *base);
+
+/*!
+ * @brief Connects a DMA channel to the request line of a peripheral model.
+ *
+ * A channel with peripheral requests enabled and no connection transfers without waiting. With the
+ * hardware trigger enabled, the request line stands in for the trigger INPUTMUX routes to the channel.
+ *
+ * @param dma The DMA model.
+ * @param channel DMA channel.
+ * @param peripheral Register block of the peripheral, e.g. (uint32_t)USART0.
+ * @param request Request line of the peripheral, e.g. kHOSTSIM_DmaRequestTx.
+ */
+void HOSTSIM_DmaModelConnect(hostsim_dma_model_t *dma, uint32_t channel, uint32_t peripheral, uint32_t request);
+
+/*! @} */
+
+/*!
+ * @name IAP model
+ * @{
+ */
+
+/*!
+ * @brief Installs the IAP ROM model at the ROM entry of the device.
+ *
+ * The flash is erased. Its contents survive a simulated reset of the application, the model stays
+ * installed until HOSTSIM_IapModelDeinit.
+ *
+ * @param iap The IAP model.
+ * @retval kStatus_Success The ROM entry calls the model.
+ * @retval kStatus_Fail The ROM entry or the flash address is not available.
+ */
+status_t HOSTSIM_IapModelInit(hostsim_iap_model_t *iap);
+
+/*!
+ * @brief Removes the IAP ROM model.
+ *
+ * @param iap The IAP model.
+ */
+void HOSTSIM_IapModelDeinit(hostsim_iap_model_t *iap);
+
+/*!
+ * @brief Cuts the power in a later program or erase command.
+ *
+ * The command is torn: part of the bytes or pages is done, one of them partly.
+ *
+ * @param iap The IAP model.
+ * @param commands The power fails in this program or erase command, 1 for the next one, 0 for never.
+ * @param powerLoss Power loss callback.
+ * @param userData User data of the power loss callback.
+ */
+void HOSTSIM_IapModelSetPowerLoss(hostsim_iap_model_t *iap,
+                                  uint32_t commands,
+                                  hostsim_iap_power_loss_t powerLoss,
+                                  void *userData);
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* FSL_HOSTSIM_MODELS_H_ */
@@ -0,0 +1,241 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Streams a synthetic signal through the ADC DMA driver on the ADC and DMA models. Sequence A
+ * converts three channels in burst mode with the interrupt per conversion, every conversion raises
+ * the DMA trigger and the ping-pong descriptors fill two blocks of a size that is no multiple of the
+ * sequence length. The sample source numbers the conversions, so the blocks handed to the callback
+ * must continue the stream word by word in conversion order, alternate between ping and pong and
+ * come with no overrun. Then the application holds one block over several refills, each refill
+ * must be counted as an overrun while the stream goes on, and after the stop no block follows.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fsl_hostsim_models.h"
+#include "fsl_adc.h"
+#include "fsl_adc_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_ADC_DMA_CHANNEL (0U) /* Any channel, INPUTMUX routes the sequence A trigger to it. */
+#define BENCH_BLOCK_SIZE      (40U)
+#define BENCH_SWAPS           (8U) /* Ping and pong both refilled. */
+#define BENCH_HOLD_REFILLS    (3U)
+#define BENCH_STREAM_SIZE     (BENCH_BLOCK_SIZE * 2U * (BENCH_SWAPS + BENCH_HOLD_REFILLS + 2U))
+#define BENCH_MAX_POLLS       (100000U)
+
+typedef struct _bench_run
+{
+    uint32_t blocks;
+    uint32_t samples;
+    uint32_t holdFrom;    /* Block number whose ping is held, 0 for none. */
+    uint32_t heldRefills; /* Ping refills seen while the block was held. */
+    bool holding;
+    bool alternate;
+    bool status;
+} bench_run_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const uint32_t s_channels[] = {1U, 4U, 7U};
+
+static hostsim_adc_model_t s_adcModel;
+static hostsim_dma_model_t s_dmaModel;
+
+DMA_ALLOCATE_LINK_DESCRIPTORS(s_adcDescriptors, ADC_DMA_DESCRIPTOR_NUM);
+
+static dma_handle_t s_dmaHandle;
+static adc_dma_handle_t s_adcHandle;
+static uint32_t s_buffer[2U * BENCH_BLOCK_SIZE];
+static uint32_t s_stream[BENCH_STREAM_SIZE];
+static uint32_t s_conversions;
+static bench_run_t s_run;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* The conversion number is the sample, the model converts the channels in ascending order. */
+static uint16_t BENCH_Sample(void *userData, uint32_t channel)
+{
+    (void)userData;
+    (void)channel;
+
+    return (uint16_t)(s_conversions++ & 0xFFFU);
+}
+
+static void BENCH_Callback(ADC_Type *base, adc_dma_handle_t *handle, status_t status, uint32_t *samples, void *userData)
+{
+    uint32_t block;
+    uint32_t i;
+
+    (void)userData;
+
+    s_run.status = s_run.status && (status == kStatus_Success);
+    if (samples == NULL)
+    {
+        return;
+    }
+
+    block           = (samples == s_buffer) ? 0U : 1U;
+    s_run.alternate = s_run.alternate && (block == (s_run.blocks % 2U)) &&
+                      (samples == &s_buffer[block * BENCH_BLOCK_SIZE]);
+    s_run.blocks++;
+
+    for (i = 0U; (i < BENCH_BLOCK_SIZE) && (s_run.samples < BENCH_STREAM_SIZE); i++)
+    {
+        s_stream[s_run.samples++] = samples[i];
+    }
+
+    /* The ping of block holdFrom stays with the application over BENCH_HOLD_REFILLS refills. */
+    if ((block == 0U) && (s_run.blocks == s_run.holdFrom))
+    {
+        s_run.holding = true;
+        return;
+    }
+    if (s_run.holding && (block == 0U))
+    {
+        s_run.heldRefills++;
+        if (s_run.heldRefills < BENCH_HOLD_REFILLS)
+        {
+            return;
+        }
+        s_run.holding = false;
+    }
+
+    ADC_TransferReleaseBlockDMA(base, handle, samples);
+}
+
+/*
+ * The stream continues the conversion numbers with the channels of the sequence in turn. A start
+ * begins with the first channel, the run before may have stopped in the middle of the sequence.
+ */
+static bool BENCH_CheckStream(uint32_t first)
+{
+    uint32_t i;
+    uint32_t n;
+    bool ok = true;
+
+    for (i = 0U; i < s_run.samples; i++)
+    {
+        n  = first + i;
+        ok = ok && (ADC_DMA_SAMPLE_RESULT(s_stream[i]) == (n & 0xFFFU)) &&
+             (ADC_DMA_SAMPLE_CHANNEL(s_stream[i]) == s_channels[i % ARRAY_SIZE(s_channels)]);
+    }
+
+    return ok;
+}
+
+static uint32_t BENCH_Stream(uint32_t holdFrom, uint32_t blocks, uint32_t *first)
+{
+    adc_dma_transfer_t xfer = {
+        .buffer = s_buffer, .blockSize = BENCH_BLOCK_SIZE, .sequence = kADC_DmaConvSeqA, .enableBurst = true};
+    uint32_t polls = 0U;
+    status_t status;
+
+    (void)memset(&s_run, 0, sizeof(s_run));
+    s_run.holdFrom  = holdFrom;
+    s_run.alternate = true;
+    s_run.status    = true;
+    *first          = s_conversions;
+
+    status = ADC_TransferStartDMA(ADC0, &s_adcHandle, &xfer);
+    while ((status == kStatus_Success) && (s_run.blocks < blocks) && (polls < BENCH_MAX_POLLS))
+    {
+        HOSTSIM_Poll();
+        polls++;
+    }
+    ADC_TransferStopDMA(ADC0, &s_adcHandle);
+
+    return (status == kStatus_Success) ? polls : BENCH_MAX_POLLS;
+}
+
+static void BENCH_Report(const char *name, uint32_t polls, const hostsim_stats_t *start, bool ok)
+{
+    hostsim_stats_t stats;
+
+    HOSTSIM_GetStats(&stats);
+    (void)printf("%-10s %3u blocks %5u samples %5u polls %3u irqs %5.2f traps/sample  overruns %u  %s\r\n", name,
+                 (unsigned int)s_run.blocks, (unsigned int)s_run.samples, (unsigned int)polls,
+                 (unsigned int)(stats.irqCount - start->irqCount),
+                 (double)(stats.trapCount - start->trapCount) / (double)s_run.samples,
+                 (unsigned int)ADC_TransferGetOverrunCountDMA(ADC0, &s_adcHandle), ok ? "ok" : "FAILED");
+}
+
+int main(void)
+{
+    adc_config_t adcConfig;
+    adc_conv_seq_config_t seqConfig = {0};
+    hostsim_stats_t start;
+    uint32_t polls;
+    uint32_t first;
+    uint32_t blocks;
+    uint32_t i;
+    bool ok;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+    HOSTSIM_AdcModelInit(&s_adcModel, ADC0, BENCH_Sample, NULL);
+    HOSTSIM_DmaModelInit(&s_dmaModel, DMA0);
+    /* Stands in for INPUTMUX_AttachSignal(INPUTMUX, channel, kINPUTMUX_AdcASeqaIrqToDma). */
+    HOSTSIM_DmaModelConnect(&s_dmaModel, BENCH_ADC_DMA_CHANNEL, (uint32_t)ADC0, (uint32_t)kADC_DmaConvSeqA);
+
+    ADC_GetDefaultConfig(&adcConfig);
+    ADC_Init(ADC0, &adcConfig);
+    for (i = 0U; i < ARRAY_SIZE(s_channels); i++)
+    {
+        seqConfig.channelMask |= 1UL << s_channels[i];
+    }
+    seqConfig.interruptMode = kADC_InterruptForEachConversion;
+    ADC_SetConvSeqAConfig(ADC0, &seqConfig);
+
+    DMA_Init(DMA0);
+    DMA_EnableChannel(DMA0, BENCH_ADC_DMA_CHANNEL);
+    DMA_CreateHandle(&s_dmaHandle, DMA0, BENCH_ADC_DMA_CHANNEL);
+    ADC_TransferCreateHandleDMA(ADC0, &s_adcHandle, BENCH_Callback, NULL, &s_dmaHandle, s_adcDescriptors);
+
+    /* Ping and pong swap BENCH_SWAPS times, every block is released at once. */
+    blocks = 2U * BENCH_SWAPS;
+    HOSTSIM_GetStats(&start);
+    polls = BENCH_Stream(0U, blocks, &first);
+    ok    = (s_run.blocks == blocks) && s_run.alternate && s_run.status && BENCH_CheckStream(first) &&
+         (ADC_TransferGetOverrunCountDMA(ADC0, &s_adcHandle) == 0U);
+    BENCH_Report("swaps", polls, &start, ok);
+
+    /* The ping of the third block is held over BENCH_HOLD_REFILLS refills, then released. */
+    blocks = 2U * (BENCH_SWAPS + BENCH_HOLD_REFILLS);
+    HOSTSIM_GetStats(&start);
+    polls = BENCH_Stream(3U, blocks, &first);
+    ok    = (s_run.blocks == blocks) && s_run.alternate && s_run.status && BENCH_CheckStream(first) &&
+         !s_run.holding && (s_run.heldRefills == BENCH_HOLD_REFILLS) &&
+         (ADC_TransferGetOverrunCountDMA(ADC0, &s_adcHandle) == BENCH_HOLD_REFILLS);
+    BENCH_Report("overrun", polls, &start, ok);
+
+    /* No block after the stop. */
+    blocks = s_run.blocks;
+    for (i = 0U; i < (4U * BENCH_BLOCK_SIZE); i++)
+    {
+        HOSTSIM_Poll();
+    }
+    ok = (s_run.blocks == blocks) && ((ADC0->SEQ_CTRL[0] & ADC_SEQ_CTRL_SEQ_ENA_MASK) == 0U);
+    (void)printf("stop       no block after ADC_TransferStopDMA                                       %s\r\n",
+                 ok ? "ok" : "FAILED");
+
+    DMA_Deinit(DMA0);
+    ADC_Deinit(ADC0);
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,329 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Checks every engine of the software CRC adapter against the bitwise HAL_CrcCompute it replaced,
+ * for the three polynomials with tables and one without, all refIn, refOut and byte order settings,
+ * random seeds, XOR masks and start bytes. The data starts at every offset from a word boundary
+ * and has random lengths, so that slice-by-4 runs through unaligned heads and tails, and is fed
+ * once with HAL_CrcCompute and once in random chunks with HAL_CrcUpdate. Then measures the
+ * throughput of each engine and of the previous bitwise code over flash image sized blocks.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "fsl_common.h"
+#include "fsl_adapter_crc.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_DATA_SIZE  (512U)
+#define BENCH_RUNS       (2000U)
+#define BENCH_BLOCK_SIZE (4096U)
+#define BENCH_BYTES      (1U << 24U)
+#define BENCH_ENGINES    (5U)
+
+typedef struct _bench_poly
+{
+    const char *name;
+    uint32_t poly;
+    uint8_t size;
+} bench_poly_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* CRC-16/ARC has no lookup table, every engine falls back to the bitwise one. */
+static const bench_poly_t s_polys[] = {
+    {"crc8", (uint32_t)KHAL_CrcPolynomial_CRC_8_CCITT, 1U},
+    {"crc16", (uint32_t)KHAL_CrcPolynomial_CRC_16, 2U},
+    {"crc32", (uint32_t)KHAL_CrcPolynomial_CRC_32, 4U},
+    {"arc16", 0x8005U, 2U},
+};
+
+static const char *const s_engineNames[BENCH_ENGINES] = {"default", "bitwise", "nibble", "byte", "slice4"};
+
+static uint32_t s_data[(BENCH_BLOCK_SIZE / 4U) + 1U];
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t BENCH_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+/* HAL_CrcCompute as the adapter computed it before the lookup tables, one shift per bit, with the
+ * result reflected for crcRefOut before the XOR mask, which it ignored. */
+static uint32_t BENCH_CrcReference(hal_crc_config_t *crcConfig, uint8_t *dataIn, uint32_t length)
+{
+    uint32_t shiftReg    = crcConfig->crcSeed << ((4U - crcConfig->crcSize) << 3U);
+    uint32_t crcPoly     = crcConfig->crcPoly << ((4U - crcConfig->crcSize) << 3U);
+    uint32_t crcXorOut   = crcConfig->crcXorOut << ((4U - crcConfig->crcSize) << 3U);
+    uint16_t startOffset = crcConfig->crcStartByte;
+    uint8_t crcBits      = 8U * crcConfig->crcSize;
+    uint32_t computedCRC = 0;
+    uint32_t i, j;
+    uint8_t data = 0;
+    uint8_t bit;
+
+    if (crcConfig->crcSize != 0U)
+    {
+        for (i = 0UL + startOffset; i < length; i++)
+        {
+            data = dataIn[i];
+
+            if (crcConfig->crcRefIn == KHAL_CrcRefInput)
+            {
+                bit = 0U;
+                for (j = 0U; j < 8U; j++)
+                {
+                    bit = (bit << 1);
+                    bit |= ((data & 1U) != 0U) ? 1U : 0U;
+                    data = (data >> 1);
+                }
+                data = bit;
+            }
+
+            for (j = 0; j < 8U; j++)
+            {
+                bit  = ((data & 0x80U) != 0U) ? 1U : 0U;
+                data = (data << 1);
+
+                if ((shiftReg & 1UL << 31) != 0U)
+                {
+                    bit = (bit != 0U) ? 0U : 1U;
+                }
+
+                shiftReg = (shiftReg << 1);
+
+                if (bit != 0U)
+                {
+                    shiftReg ^= crcPoly;
+                }
+
+                if ((bool)bit && ((crcPoly & (1UL << (32U - crcBits))) != 0U))
+                {
+                    shiftReg |= (1UL << (32U - crcBits));
+                }
+                else
+                {
+                    shiftReg &= ~(1UL << (32U - crcBits));
+                }
+            }
+        }
+
+        if (crcConfig->crcRefOut == KHAL_CrcRefOutput)
+        {
+            computedCRC = 0;
+            for (i = 0; i < crcBits; i++)
+            {
+                computedCRC |= ((shiftReg & (1UL << (31U - i))) != 0U) ? (1UL << (32U - crcBits + i)) : 0U;
+            }
+            shiftReg = computedCRC;
+        }
+
+        shiftReg ^= crcXorOut;
+
+        if (crcConfig->crcByteOrder == KHAL_CrcMSByteFirst)
+        {
+            computedCRC = (shiftReg >> (32U - crcBits));
+        }
+        else
+        {
+            computedCRC = 0;
+            j           = 1U;
+            for (i = 0; i < 32U; i++)
+            {
+                computedCRC = (computedCRC << 1);
+                computedCRC |= ((shiftReg & j) != 0U) ? 1U : 0U;
+                j = (j << 1);
+            }
+        }
+    }
+
+    return computedCRC;
+}
+
+static void BENCH_Config(hal_crc_config_t *config, const bench_poly_t *poly, uint32_t setting, hal_crc_engine_t engine)
+{
+    uint32_t mask = (poly->size == 4U) ? 0xFFFFFFFFU : ((1UL << (8U * poly->size)) - 1U);
+
+    config->crcRefIn           = ((setting & 1U) != 0U) ? KHAL_CrcRefInput : KHAL_CrcInputNoRef;
+    config->crcRefOut          = ((setting & 2U) != 0U) ? KHAL_CrcRefOutput : KHAL_CrcOutputNoRef;
+    config->crcByteOrder       = ((setting & 4U) != 0U) ? KHAL_CrcMSByteFirst : KHAL_CrcLSByteFirst;
+    config->crcSeed            = BENCH_Random() & mask;
+    config->crcPoly            = poly->poly;
+    config->crcXorOut          = ((BENCH_Random() & 1U) != 0U) ? mask : (BENCH_Random() & mask);
+    config->complementChecksum = 0U;
+    config->crcSize            = poly->size;
+    config->crcStartByte       = ((BENCH_Random() & 3U) == 0U) ? (uint8_t)(BENCH_Random() % 8U) : 0U;
+    config->crcEngine          = engine;
+}
+
+/* The same CRC fed in random chunks, the start byte may be skipped across several of them. */
+static uint32_t BENCH_CrcChunks(hal_crc_config_t *config, const uint8_t *data, uint32_t length)
+{
+    hal_crc_context_t context;
+    uint32_t chunk;
+
+    HAL_CrcInit(&context, config);
+    while (length > 0U)
+    {
+        chunk = 1U + (BENCH_Random() % ((length < 37U) ? length : 37U));
+        HAL_CrcUpdate(&context, data, chunk);
+        data += chunk;
+        length -= chunk;
+    }
+
+    return HAL_CrcFinal(&context);
+}
+
+static void BENCH_Verify(void)
+{
+    static uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    hal_crc_config_t config;
+    uint8_t *bytes = (uint8_t *)s_data;
+    uint32_t expected;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t setting;
+    uint32_t engine;
+    uint32_t poly;
+    uint32_t run;
+    uint32_t seed;
+    bool ok;
+
+    /* CRC-32 of the check string, reflected in and out by the byte order or by crcRefOut. An engine
+     * out of range, as left by a configuration without crcEngine, runs the default engine. */
+    ok = true;
+    for (engine = 0U; engine <= BENCH_ENGINES; engine++)
+    {
+        for (setting = 1U; setting < 8U; setting += 6U)
+        {
+            BENCH_Config(&config, &s_polys[2], setting,
+                         (engine < BENCH_ENGINES) ? (hal_crc_engine_t)engine : (hal_crc_engine_t)0xA5U);
+            config.crcSeed      = 0xFFFFFFFFU;
+            config.crcXorOut    = 0xFFFFFFFFU;
+            config.crcStartByte = 0U;
+            ok = ok && (HAL_CrcCompute(&config, check, sizeof(check)) == 0xCBF43926U);
+        }
+    }
+    (void)printf("crc32 check value                                  %s\r\n", ok ? "ok" : "FAILED");
+
+    /* CRC-16/KERMIT, reflected in and out, with the 16-bit result reflected by crcRefOut. */
+    ok = true;
+    for (engine = 0U; engine < BENCH_ENGINES; engine++)
+    {
+        BENCH_Config(&config, &s_polys[1], 7U, (hal_crc_engine_t)engine);
+        config.crcSeed      = 0U;
+        config.crcXorOut    = 0U;
+        config.crcStartByte = 0U;
+        ok = ok && (HAL_CrcCompute(&config, check, sizeof(check)) == 0x2189U);
+    }
+    (void)printf("crc16 kermit check value                           %s\r\n", ok ? "ok" : "FAILED");
+
+    for (poly = 0U; poly < (sizeof(s_polys) / sizeof(s_polys[0])); poly++)
+    {
+        for (engine = 0U; engine < BENCH_ENGINES; engine++)
+        {
+            ok = true;
+            for (run = 0U; run < BENCH_RUNS; run++)
+            {
+                setting = run % 8U;
+                offset  = BENCH_Random() % 8U;
+                length  = (run < 64U) ? (run % 12U) : (BENCH_Random() % BENCH_DATA_SIZE);
+                seed    = s_seed;
+
+                BENCH_Config(&config, &s_polys[poly], setting, KHAL_CrcEngineBitwise);
+                expected = BENCH_CrcReference(&config, &bytes[offset], length);
+
+                /* The same configuration for the engine under test. */
+                s_seed = seed;
+                BENCH_Config(&config, &s_polys[poly], setting, (hal_crc_engine_t)engine);
+                ok = ok && (HAL_CrcCompute(&config, &bytes[offset], length) == expected);
+                ok = ok && (BENCH_CrcChunks(&config, &bytes[offset], length) == expected);
+            }
+            (void)printf("%-6s %-8s %4u runs against the bitwise reference  %s\r\n", s_polys[poly].name,
+                         s_engineNames[engine], (unsigned int)BENCH_RUNS, ok ? "ok" : "FAILED");
+        }
+    }
+}
+
+static void BENCH_Throughput(void)
+{
+    hal_crc_config_t config;
+    uint32_t blocks = BENCH_BYTES / BENCH_BLOCK_SIZE;
+    uint32_t expected;
+    uint32_t sum;
+    uint32_t engine;
+    uint32_t block;
+    uint64_t start;
+    uint64_t ns;
+
+    BENCH_Config(&config, &s_polys[2], 1U, KHAL_CrcEngineBitwise);
+    config.crcStartByte = 0U;
+    expected            = BENCH_CrcReference(&config, (uint8_t *)s_data, BENCH_BLOCK_SIZE);
+
+    sum   = 0U;
+    start = BENCH_GetNs();
+    for (block = 0U; block < blocks; block++)
+    {
+        sum += BENCH_CrcReference(&config, (uint8_t *)s_data, BENCH_BLOCK_SIZE) - expected;
+    }
+    ns = BENCH_GetNs() - start;
+    (void)printf("crc32  %-8s %8.1f MB/s  %5.2f ns/byte                 %s\r\n", "previous",
+                 ((double)BENCH_BYTES * 1000.0) / (double)ns, (double)ns / (double)BENCH_BYTES,
+                 (sum == 0U) ? "ok" : "FAILED");
+
+    for (engine = (uint32_t)KHAL_CrcEngineBitwise; engine < BENCH_ENGINES; engine++)
+    {
+        config.crcEngine = (hal_crc_engine_t)engine;
+        sum              = 0U;
+        start            = BENCH_GetNs();
+        for (block = 0U; block < blocks; block++)
+        {
+            sum += HAL_CrcCompute(&config, (uint8_t *)s_data, BENCH_BLOCK_SIZE) - expected;
+        }
+        ns = BENCH_GetNs() - start;
+
+        (void)printf("crc32  %-8s %8.1f MB/s  %5.2f ns/byte                 %s\r\n", s_engineNames[engine],
+                     ((double)BENCH_BYTES * 1000.0) / (double)ns, (double)ns / (double)BENCH_BYTES,
+                     (sum == 0U) ? "ok" : "FAILED");
+    }
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < (sizeof(s_data) / sizeof(s_data[0])); i++)
+    {
+        s_data[i] = BENCH_Random() ^ (BENCH_Random() << 16U);
+    }
+
+    BENCH_Verify();
+    BENCH_Throughput();
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Checks the FreeMASTER CRC8 and CRC16 against the bit by bit reference and measures the throughput
+ * of byte by byte and block updates over frames of the size of the communication buffer. Built once
+ * per CRC implementation, see FMSTR_CRC_TABLE_SIZE.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "freemaster.h"
+#include "freemaster_utils.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_FRAME_SIZE (240U)
+#define BENCH_FRAMES     (64U)
+#define BENCH_BYTES      (1U << 25U)
+
+#if FMSTR_CRC_TABLE_SIZE == 256
+#define BENCH_CRC_NAME "table"
+#elif FMSTR_CRC_TABLE_SIZE == 16
+#define BENCH_CRC_NAME "nibble"
+#else
+#define BENCH_CRC_NAME "bitwise"
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static FMSTR_U8 s_frames[BENCH_FRAMES][BENCH_FRAME_SIZE];
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t BENCH_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+/* CRC16-CCITT, polynomial 0x1021, MSB first, as the driver computed it before the lookup tables. */
+static FMSTR_U16 BENCH_Crc16Reference(FMSTR_U16 crc, const FMSTR_U8 *data, uint32_t size)
+{
+    uint32_t x;
+
+    while (size > 0U)
+    {
+        crc ^= (FMSTR_U16)(*data++ << 8);
+        for (x = 0U; x < 8U; x++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (FMSTR_U16)((crc << 1) ^ 0x1021U) : (FMSTR_U16)(crc << 1);
+        }
+        size--;
+    }
+
+    return crc;
+}
+
+/* CRC8-CCITT, polynomial 0x07, MSB first. */
+static FMSTR_U8 BENCH_Crc8Reference(FMSTR_U8 crc, const FMSTR_U8 *data, uint32_t size)
+{
+    uint32_t x;
+
+    while (size > 0U)
+    {
+        crc ^= *data++;
+        for (x = 0U; x < 8U; x++)
+        {
+            crc = ((crc & 0x80U) != 0U) ? (FMSTR_U8)((crc << 1) ^ 0x07U) : (FMSTR_U8)(crc << 1);
+        }
+        size--;
+    }
+
+    return crc;
+}
+
+/* The check values of both CRCs and random frames of random lengths, split into two blocks. */
+static void BENCH_Verify(void)
+{
+    static FMSTR_U8 check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    FMSTR_U16 crc16;
+    FMSTR_U16 block16;
+    FMSTR_U8 crc8;
+    FMSTR_U8 block8;
+    uint32_t frame;
+    uint32_t size;
+    uint32_t split;
+    uint32_t i;
+    bool ok;
+
+    FMSTR_Crc16Init(&crc16);
+    FMSTR_Crc16AddBlock(&crc16, check, sizeof(check));
+    FMSTR_Crc8Init(&crc8);
+    FMSTR_Crc8AddBlock(&crc8, check, sizeof(check));
+    ok = (crc16 == 0x29B1U) && (crc8 == 0xF4U);
+
+    for (frame = 0U; frame < BENCH_FRAMES; frame++)
+    {
+        size  = BENCH_Random() % (BENCH_FRAME_SIZE + 1U);
+        split = (size > 0U) ? (BENCH_Random() % size) : 0U;
+
+        FMSTR_Crc16Init(&crc16);
+        FMSTR_Crc8Init(&crc8);
+        for (i = 0U; i < size; i++)
+        {
+            FMSTR_Crc16AddByte(&crc16, s_frames[frame][i]);
+            FMSTR_Crc8AddByte(&crc8, s_frames[frame][i]);
+        }
+
+        FMSTR_Crc16Init(&block16);
+        FMSTR_Crc16AddBlock(&block16, s_frames[frame], split);
+        FMSTR_Crc16AddBlock(&block16, &s_frames[frame][split], size - split);
+        FMSTR_Crc8Init(&block8);
+        FMSTR_Crc8AddBlock(&block8, s_frames[frame], split);
+        FMSTR_Crc8AddBlock(&block8, &s_frames[frame][split], size - split);
+
+        ok = ok && (crc16 == BENCH_Crc16Reference(FMSTR_CRC16_CCITT_SEED, s_frames[frame], size));
+        ok = ok && (crc8 == BENCH_Crc8Reference(FMSTR_CRC8_CCITT_SEED, s_frames[frame], size));
+        ok = ok && (block16 == crc16) && (block8 == crc8);
+    }
+
+    (void)printf("%-7s reference checks                  %s\r\n", BENCH_CRC_NAME, ok ? "ok" : "FAILED");
+}
+
+static void BENCH_Report(const char *name, uint64_t ns, uint32_t sum, uint32_t expected)
+{
+    (void)printf("%-7s %-14s %8.1f MB/s  %5.2f ns/byte  %s\r\n", BENCH_CRC_NAME, name,
+                 ((double)BENCH_BYTES * 1000.0) / (double)ns, (double)ns / (double)BENCH_BYTES,
+                 (sum == expected) ? "ok" : "FAILED");
+}
+
+/* Frames checksummed as the serial driver did it, one call per byte, and with one block call. */
+static void BENCH_Throughput(void)
+{
+    uint32_t frames = BENCH_BYTES / BENCH_FRAME_SIZE;
+    uint32_t expected8  = 0U;
+    uint32_t expected16 = 0U;
+    uint32_t sum;
+    uint64_t start;
+    FMSTR_U16 crc16;
+    FMSTR_U8 crc8;
+    uint32_t frame;
+    uint32_t i;
+
+    for (frame = 0U; frame < frames; frame++)
+    {
+        expected8 += BENCH_Crc8Reference(FMSTR_CRC8_CCITT_SEED, s_frames[frame % BENCH_FRAMES], BENCH_FRAME_SIZE);
+        expected16 += BENCH_Crc16Reference(FMSTR_CRC16_CCITT_SEED, s_frames[frame % BENCH_FRAMES], BENCH_FRAME_SIZE);
+    }
+
+    sum   = 0U;
+    start = BENCH_GetNs();
+    for (frame = 0U; frame < frames; frame++)
+    {
+        FMSTR_Crc8Init(&crc8);
+        for (i = 0U; i < BENCH_FRAME_SIZE; i++)
+        {
+            FMSTR_Crc8AddByte(&crc8, s_frames[frame % BENCH_FRAMES][i]);
+        }
+        sum += crc8;
+    }
+    BENCH_Report("crc8 bytes", BENCH_GetNs() - start, sum, expected8);
+
+    sum   = 0U;
+    start = BENCH_GetNs();
+    for (frame = 0U; frame < frames; frame++)
+    {
+        FMSTR_Crc8Init(&crc8);
+        FMSTR_Crc8AddBlock(&crc8, s_frames[frame % BENCH_FRAMES], BENCH_FRAME_SIZE);
+        sum += crc8;
+    }
+    BENCH_Report("crc8 block", BENCH_GetNs() - start, sum, expected8);
+
+    sum   = 0U;
+    start = BENCH_GetNs();
+    for (frame = 0U; frame < frames; frame++)
+    {
+        FMSTR_Crc16Init(&crc16);
+        for (i = 0U; i < BENCH_FRAME_SIZE; i++)
+        {
+            FMSTR_Crc16AddByte(&crc16, s_frames[frame % BENCH_FRAMES][i]);
+        }
+        sum += crc16;
+    }
+    BENCH_Report("crc16 bytes", BENCH_GetNs() - start, sum, expected16);
+
+    sum   = 0U;
+    start = BENCH_GetNs();
+    for (frame = 0U; frame < frames; frame++)
+    {
+        FMSTR_Crc16Init(&crc16);
+        FMSTR_Crc16AddBlock(&crc16, s_frames[frame % BENCH_FRAMES], BENCH_FRAME_SIZE);
+        sum += crc16;
+    }
+    BENCH_Report("crc16 block", BENCH_GetNs() - start, sum, expected16);
+}
+
+int main(void)
+{
+    uint32_t frame;
+    uint32_t i;
+
+    for (frame = 0U; frame < BENCH_FRAMES; frame++)
+    {
+        for (i = 0U; i < BENCH_FRAME_SIZE; i++)
+        {
+            s_frames[frame][i] = (FMSTR_U8)BENCH_Random();
+        }
+    }
+
+    BENCH_Verify();
+    BENCH_Throughput();
+
+    return 0;
+}
@@ -0,0 +1,386 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Loops FreeMASTER commands through FMSTR_ProtocolDecoder with the bench as the transport and
+ * counts the bytes a refresh of 40 variables puts on the serial line, framed as the serial
+ * transport does: start of block, command or status, length, data and checksum, every start of
+ * block character in the frame doubled. A refresh is done with one READMEM per variable, with as
+ * few READMEMS as fit into the communication buffer and with READRDGRP after the read group was
+ * set once. Every response must hold the current values of all variables. Addresses are those of
+ * the host, they encode to more bytes than the RAM addresses of the target, so the command bytes
+ * of READMEM and READMEMS are somewhat higher than on the target.
+ * Last, truncated READMEMS and SETRDGRP commands are decoded at the very end of a readable page
+ * followed by an inaccessible one, they must be refused without reading behind the command.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "freemaster.h"
+#include "freemaster_private.h"
+#include "freemaster_protocol.h"
+#include "freemaster_utils.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_VAR_COUNT   (40U)
+#define BENCH_VAR_SPACING (24U) /* variables are not adjacent, every one is a block of its own */
+#define BENCH_REFRESHES   (100U)
+#define BENCH_BAUD_RATE   (115200U)
+#define BENCH_BITS_BYTE   (10U) /* start, 8 data and stop bit */
+
+typedef struct _bench_var
+{
+    FMSTR_ADDR addr;
+    FMSTR_SIZE size;
+} bench_var_t;
+
+typedef struct _bench_wire
+{
+    uint32_t frames;
+    uint32_t requestBytes;
+    uint32_t responseBytes;
+} bench_wire_t;
+
+typedef struct _bench_truncated
+{
+    const char *name;
+    FMSTR_U8 cmd;
+    FMSTR_SIZE length;
+    FMSTR_U8 data[8U];
+} bench_truncated_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const FMSTR_SIZE s_sizes[] = {1U, 2U, 4U, 8U};
+
+/* Commands ending right before a value which is still to be decoded. */
+static const bench_truncated_t s_truncated[] = {
+    {"readmems empty", FMSTR_CMD_READMEMS, 0U, {0U}},
+    {"readmems count", FMSTR_CMD_READMEMS, 1U, {2U}},
+    {"readmems size", FMSTR_CMD_READMEMS, 2U, {1U, 0x10U}},
+    {"readmems next", FMSTR_CMD_READMEMS, 5U, {3U, 0x10U, 4U, 0x20U, 4U}},
+    {"setrdgrp empty", FMSTR_CMD_SETRDGRP, 0U, {0U}},
+    {"setrdgrp index", FMSTR_CMD_SETRDGRP, 1U, {0U}},
+    {"setrdgrp count", FMSTR_CMD_SETRDGRP, 2U, {0U, 1U}},
+    {"setrdgrp size", FMSTR_CMD_SETRDGRP, 4U, {0U, 2U, 0x10U, 4U}},
+};
+
+static FMSTR_U64 s_memory[BENCH_VAR_COUNT * BENCH_VAR_SPACING / sizeof(FMSTR_U64)];
+static bench_var_t s_vars[BENCH_VAR_COUNT];
+
+/* Frame as received by the serial transport: command, length and the message. */
+static FMSTR_BCHR s_frame[2U + FMSTR_COMM_BUFFER_SIZE];
+static FMSTR_BPTR s_response;
+static FMSTR_SIZE s_responseLength;
+static FMSTR_U8 s_responseStatus;
+static bench_wire_t s_wire;
+static uint32_t s_seed = 1U;
+static int s_session; /* identification of the one session of the bench */
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+/* Bytes of a frame on the line, the start of block, the frame with every SOB doubled and the checksum. */
+static uint32_t BENCH_WireBytes(FMSTR_BPTR frame, FMSTR_SIZE length)
+{
+    uint32_t bytes = 1U;
+    FMSTR_U8 crc;
+    FMSTR_SIZE i;
+
+    FMSTR_Crc8Init(&crc);
+    FMSTR_Crc8AddBlock(&crc, frame, length);
+    for (i = 0U; i < length; i++)
+    {
+        bytes += (frame[i] == FMSTR_SOB) ? 2U : 1U;
+    }
+
+    return bytes + ((crc == FMSTR_SOB) ? 2U : 1U);
+}
+
+static FMSTR_BOOL BENCH_TransportInit(void)
+{
+    return FMSTR_TRUE;
+}
+
+static void BENCH_TransportPoll(void)
+{
+}
+
+/* The response is framed in place as the serial transport does, the status and length go before it. */
+static void BENCH_SendResponse(FMSTR_BPTR response, FMSTR_SIZE length, FMSTR_U8 statusCode, void *identification)
+{
+    FMSTR_BPTR frame = response - 1;
+
+    (void)identification;
+
+    s_response         = response;
+    s_responseLength   = length;
+    s_responseStatus   = statusCode;
+    if ((statusCode & FMSTR_STSF_VARLEN) != 0U)
+    {
+        frame--;
+        frame[1] = (FMSTR_BCHR)length;
+    }
+    frame[0] = (FMSTR_BCHR)statusCode;
+
+    s_wire.responseBytes += BENCH_WireBytes(frame, length + (FMSTR_SIZE)(response - frame));
+}
+
+/* The bench is the transport, FMSTR_TRANSPORT is FMSTR_SERIAL in the host configuration. */
+const FMSTR_TRANSPORT_INTF FMSTR_SERIAL = {
+    .Init = BENCH_TransportInit, .Poll = BENCH_TransportPoll, .SendResponse = BENCH_SendResponse};
+
+/* Empty TSA table list, the bench reads the memory without the TSA safety check. */
+FMSTR_ADDR FMSTR_TsaGetTable(FMSTR_SIZE tableIndex, FMSTR_SIZE *tableSize)
+{
+    (void)tableIndex;
+    (void)tableSize;
+
+    return NULL;
+}
+
+/* Sends the message in s_frame as a command, returns the response status. */
+static FMSTR_U8 BENCH_Command(FMSTR_U8 cmd, FMSTR_SIZE length)
+{
+    s_frame[0] = cmd;
+    s_frame[1] = (FMSTR_BCHR)length;
+    s_wire.frames++;
+    s_wire.requestBytes += BENCH_WireBytes(s_frame, length + 2U);
+
+    s_responseStatus = FMSTR_STS_INVALID;
+    (void)FMSTR_ProtocolDecoder(&s_frame[2], length, cmd, &s_session);
+
+    return s_responseStatus;
+}
+
+/* Response data must be the values of the variables first to first + count - 1. */
+static bool BENCH_CheckData(FMSTR_BPTR data, FMSTR_SIZE length, uint32_t first, uint32_t count)
+{
+    uint32_t i;
+    bool ok = true;
+
+    for (i = first; ok && (i < (first + count)); i++)
+    {
+        ok     = (length >= s_vars[i].size) && (memcmp(data, s_vars[i].addr, s_vars[i].size) == 0);
+        data   = data + s_vars[i].size;
+        length = length - s_vars[i].size;
+    }
+
+    return ok && (length == 0U);
+}
+
+/* Encodes the blocks of the variables from first, as many as fit into a command. */
+static uint32_t BENCH_PutBlocks(FMSTR_BPTR *out, FMSTR_BPTR end, FMSTR_SIZE *dataSize, uint32_t first)
+{
+    FMSTR_BCHR block[2U * sizeof(FMSTR_ADDR) + 2U];
+    FMSTR_SIZE blockSize;
+    uint32_t i;
+
+    for (i = first; i < BENCH_VAR_COUNT; i++)
+    {
+        blockSize = (FMSTR_SIZE)(FMSTR_SizeToBuffer(FMSTR_AddressToBuffer(block, s_vars[i].addr), s_vars[i].size) -
+                                 block);
+        /* the command and the data of all blocks share the buffer */
+        if (((*out + blockSize) > end) ||
+            ((FMSTR_SIZE)(*out + blockSize - &s_frame[2]) + *dataSize + s_vars[i].size > FMSTR_COMM_BUFFER_SIZE))
+        {
+            break;
+        }
+
+        (void)memcpy(*out, block, blockSize);
+        *out += blockSize;
+        *dataSize += s_vars[i].size;
+    }
+
+    return i - first;
+}
+
+static bool BENCH_RefreshReadMem(void)
+{
+    FMSTR_BPTR out;
+    uint32_t i;
+    bool ok = true;
+
+    for (i = 0U; ok && (i < BENCH_VAR_COUNT); i++)
+    {
+        out = FMSTR_AddressToBuffer(&s_frame[2], s_vars[i].addr);
+        out = FMSTR_SizeToBuffer(out, s_vars[i].size);
+        ok  = (BENCH_Command(FMSTR_CMD_READMEM, (FMSTR_SIZE)(out - &s_frame[2])) == FMSTR_STS_OK) &&
+             BENCH_CheckData(s_response, s_responseLength, i, 1U);
+    }
+
+    return ok;
+}
+
+static bool BENCH_RefreshReadMems(void)
+{
+    FMSTR_SIZE dataSize;
+    FMSTR_BPTR out;
+    uint32_t first = 0U;
+    uint32_t count = 1U;
+    bool ok        = true;
+
+    while (ok && (first < BENCH_VAR_COUNT) && (count > 0U))
+    {
+        dataSize    = 0U;
+        out         = &s_frame[3];
+        count       = BENCH_PutBlocks(&out, &s_frame[sizeof(s_frame)], &dataSize, first);
+        s_frame[2] = (FMSTR_BCHR)count;
+        ok          = (count > 0U) && (BENCH_Command(FMSTR_CMD_READMEMS, (FMSTR_SIZE)(out - &s_frame[2])) == FMSTR_STS_OK) &&
+             BENCH_CheckData(s_response, s_responseLength, first, count);
+        first += count;
+    }
+
+    return ok;
+}
+
+/* Sets the read group of the session with as many SETRDGRP commands as needed. */
+static bool BENCH_SetReadGroup(void)
+{
+    FMSTR_SIZE dataSize = 0U;
+    FMSTR_BPTR out;
+    uint32_t first = 0U;
+    uint32_t count = 1U;
+    bool ok        = true;
+
+    while (ok && (first < BENCH_VAR_COUNT) && (count > 0U))
+    {
+        /* the whole group is read in one response, the data size runs over all commands */
+        out        = &s_frame[4];
+        count      = BENCH_PutBlocks(&out, &s_frame[sizeof(s_frame)], &dataSize, first);
+        s_frame[2] = (FMSTR_BCHR)first;
+        s_frame[3] = (FMSTR_BCHR)count;
+        ok         = (count > 0U) && (BENCH_Command(FMSTR_CMD_SETRDGRP, (FMSTR_SIZE)(out - &s_frame[2])) == FMSTR_STS_OK);
+        first += count;
+    }
+
+    return ok && (first == BENCH_VAR_COUNT);
+}
+
+static bool BENCH_RefreshReadGroup(void)
+{
+    return (BENCH_Command(FMSTR_CMD_READRDGRP, 0U) == FMSTR_STS_OK) &&
+           BENCH_CheckData(s_response, s_responseLength, 0U, BENCH_VAR_COUNT);
+}
+
+static void BENCH_Report(const char *name, bool (*refresh)(void), const bench_wire_t *setup)
+{
+    uint32_t bytes;
+    uint32_t i;
+    uint32_t k;
+    bool ok = true;
+
+    (void)memset(&s_wire, 0, sizeof(s_wire));
+    for (i = 0U; ok && (i < BENCH_REFRESHES); i++)
+    {
+        /* new values every refresh */
+        for (k = 0U; k < (sizeof(s_memory) / sizeof(s_memory[0])); k++)
+        {
+            s_memory[k] = ((FMSTR_U64)BENCH_Random() << 32U) ^ BENCH_Random();
+        }
+        ok = refresh();
+    }
+
+    bytes = (s_wire.requestBytes + s_wire.responseBytes) / BENCH_REFRESHES;
+    (void)printf("%-9s %2u frames %4u bytes out %4u in  %5u bytes/refresh %5.1f refresh/s", name,
+                 (unsigned int)(s_wire.frames / BENCH_REFRESHES), (unsigned int)(s_wire.requestBytes / BENCH_REFRESHES),
+                 (unsigned int)(s_wire.responseBytes / BENCH_REFRESHES), (unsigned int)bytes,
+                 (double)BENCH_BAUD_RATE / (double)(BENCH_BITS_BYTE * bytes));
+    if (setup != NULL)
+    {
+        (void)printf("  set once %u bytes", (unsigned int)(setup->requestBytes + setup->responseBytes));
+    }
+    (void)printf("  %s\r\n", ok ? "ok" : "FAILED");
+}
+
+/* Each command is decoded right at the end of a page, the next page is not accessible. */
+static void BENCH_Truncated(void)
+{
+    long pageSize = sysconf(_SC_PAGESIZE);
+    FMSTR_BPTR pages;
+    FMSTR_BPTR msg;
+    uint32_t i;
+    bool ok;
+
+    pages = mmap(NULL, 2U * (size_t)pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((pages == MAP_FAILED) || (mprotect(pages + pageSize, (size_t)pageSize, PROT_NONE) != 0))
+    {
+        (void)printf("truncated commands: guard page not available  FAILED\r\n");
+        return;
+    }
+
+    for (i = 0U; i < (sizeof(s_truncated) / sizeof(s_truncated[0])); i++)
+    {
+        msg = pages + pageSize - s_truncated[i].length;
+        (void)memcpy(msg, s_truncated[i].data, s_truncated[i].length);
+
+        s_responseStatus = FMSTR_STS_INVALID;
+        (void)FMSTR_ProtocolDecoder(msg, s_truncated[i].length, s_truncated[i].cmd, &s_session);
+        ok = (s_responseStatus == FMSTR_STC_INVSIZE) && (s_responseLength == 0U);
+        (void)printf("%-16s %u bytes  status 0x%02x  %s\r\n", s_truncated[i].name, (unsigned int)s_truncated[i].length,
+                     (unsigned int)s_responseStatus, ok ? "ok" : "FAILED");
+    }
+
+    /* the refused SETRDGRP left no read group */
+    ok = (BENCH_Command(FMSTR_CMD_READRDGRP, 0U) == FMSTR_STC_NOTINIT);
+    (void)printf("readrdgrp after refused setrdgrp  status 0x%02x  %s\r\n", (unsigned int)s_responseStatus,
+                 ok ? "ok" : "FAILED");
+
+    (void)munmap(pages, 2U * (size_t)pageSize);
+}
+
+int main(void)
+{
+    bench_wire_t setup;
+    uint32_t i;
+
+    for (i = 0U; i < BENCH_VAR_COUNT; i++)
+    {
+        s_vars[i].addr = (FMSTR_ADDR)s_memory + (i * BENCH_VAR_SPACING);
+        s_vars[i].size = s_sizes[i % (sizeof(s_sizes) / sizeof(s_sizes[0]))];
+    }
+
+    if (FMSTR_Init() == FMSTR_FALSE)
+    {
+        (void)printf("FMSTR_Init failed\r\n");
+        return 1;
+    }
+
+    BENCH_Report("readmem", BENCH_RefreshReadMem, NULL);
+    BENCH_Report("readmems", BENCH_RefreshReadMems, NULL);
+
+    (void)memset(&s_wire, 0, sizeof(s_wire));
+    if (!BENCH_SetReadGroup())
+    {
+        (void)printf("setrdgrp  FAILED\r\n");
+    }
+    setup = s_wire;
+    BENCH_Report("readrdgrp", BENCH_RefreshReadGroup, &setup);
+
+    /* the truncated commands run with a cleared group */
+    s_frame[2] = 0U;
+    s_frame[3] = 0U;
+    (void)BENCH_Command(FMSTR_CMD_SETRDGRP, 2U);
+    BENCH_Truncated();
+
+    return 0;
+}
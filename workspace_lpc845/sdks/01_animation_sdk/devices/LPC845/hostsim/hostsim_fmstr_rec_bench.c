@@ -0,0 +1,372 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Records the same synthetic signals with the compressed FreeMASTER recorder and with the raw
+ * recorder built from the same source without FMSTR_REC_COMPRESS, see the renamed symbols of
+ * hostsim_fmstr_rec_raw. The points are read back the way the PC does: GETREC INFO gives the
+ * address, the point size, the count and the first point, the raw buffer is read in place and the
+ * compressed one through READMEM chunks of a size that is no multiple of the point size. Both
+ * streams must match the last points sampled bit for bit, a point count not backed by stored data
+ * would read as zeroes. The slow signals compress well, noise compresses worse than
+ * FMSTR_REC_COMPRESS_RATIO of 3 assumes, the recorder must then lower its point count and keep the
+ * trigger point and the points before it in the buffer. The decoded points must lie outside of the
+ * compressed buffer and the memory behind it, which must read as itself.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "freemaster.h"
+#include "freemaster_private.h"
+#include "freemaster_protocol.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_BUFF_SIZE  (4096U)
+#define BENCH_READ_SIZE  (61U) /* READMEM chunk, crosses the points at varying offsets */
+#define BENCH_POINT_SIZE (19U) /* the recorded members of bench_signals_t */
+#define BENCH_MAX_CALLS  (6000U)
+#define BENCH_VAR_COUNT  (6U)  /* five signals and the trigger-only event */
+#define BENCH_MAX_POINTS (BENCH_BUFF_SIZE * FMSTR_REC_COMPRESS_RATIO / BENCH_POINT_SIZE)
+
+#define BENCH_REC_INFO   (0x83U)
+#define BENCH_REC_STATUS (0x84U)
+
+#define BENCH_STS_PARTIAL (0x03U)
+#define BENCH_STS_READY   (0x04U)
+
+/* Recorded in memory order, the raw recorder copies them as one run. */
+typedef struct _bench_signals
+{
+    FMSTR_U64 counter;
+    FMSTR_FLOAT wave;
+    FMSTR_U32 word;
+    FMSTR_S16 level;
+    FMSTR_U8 flags;
+} bench_signals_t;
+
+typedef struct _bench_case
+{
+    const char *name;
+    bool noise;
+    uint32_t calls;        /* Recorder calls, the recorder is aborted after the last one unless it stopped. */
+    uint32_t trigger;      /* Call raising the trigger event, 0 for none. */
+    FMSTR_SIZE totalSmps;  /* Points requested, 0 for the maximum. */
+    FMSTR_SIZE preTrigger;
+    FMSTR_SIZE timeDiv;
+} bench_case_t;
+
+typedef struct _bench_info
+{
+    FMSTR_U8 status;
+    FMSTR_U8 varCount;
+    FMSTR_ADDR addr;
+    FMSTR_SIZE pointSize;
+    FMSTR_SIZE count;
+    FMSTR_SIZE first;
+} bench_info_t;
+
+/* The raw recorder, see hostsim_fmstr_rec_raw. */
+FMSTR_BOOL FMSTR_InitRec_raw(void);
+FMSTR_BOOL FMSTR_RecorderCreate_raw(FMSTR_INDEX recIndex, FMSTR_REC_BUFF *buffCfg);
+FMSTR_BOOL FMSTR_RecorderConfigure_raw(FMSTR_INDEX recIndex, FMSTR_REC_CFG *recCfg);
+FMSTR_BOOL FMSTR_RecorderAddVariable_raw(FMSTR_INDEX recIndex, FMSTR_INDEX recVarIx, FMSTR_REC_VAR *recVarCfg);
+FMSTR_BOOL FMSTR_RecorderStart_raw(FMSTR_INDEX recIndex);
+FMSTR_BOOL FMSTR_RecorderAbort_raw(FMSTR_INDEX recIndex);
+void FMSTR_Recorder_raw(FMSTR_INDEX recIndex);
+FMSTR_BPTR FMSTR_GetRecCmd_raw(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const bench_case_t s_cases[] = {
+    {"partial", false, 50U, 0U, 0U, 0U, 0U},
+    {"slow", false, 5000U, 0U, 0U, 0U, 0U},
+    {"slow trig", false, 5000U, 3000U, 0U, 100U, 0U},
+    {"slow div", false, 5000U, 3000U, 150U, 20U, 2U},
+    {"noise", true, 5000U, 0U, 0U, 0U, 0U},
+    {"noise trig", true, 5000U, 3000U, 0U, 100U, 0U},
+    {"noise req", true, 5000U, 3000U, 120U, 30U, 0U},
+};
+
+/* The compressed buffer is followed by other memory of the application. */
+static struct
+{
+    FMSTR_U64 buffer[BENCH_BUFF_SIZE / sizeof(FMSTR_U64)];
+    FMSTR_U8 behind[BENCH_READ_SIZE];
+} s_zip;
+static FMSTR_U64 s_rawBuffer[BENCH_BUFF_SIZE / sizeof(FMSTR_U64)];
+
+static bench_signals_t s_signals;
+static FMSTR_S16 s_event;
+static FMSTR_S16 s_threshold = 1;
+
+/* Every point sampled since the start, and the read back points. */
+static FMSTR_U8 s_log[BENCH_MAX_CALLS][BENCH_POINT_SIZE];
+static FMSTR_U8 s_read[BENCH_MAX_POINTS * BENCH_POINT_SIZE];
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+/* Signals of one recorder call, slowly changing or noise in all bits. */
+static void BENCH_Update(uint32_t call, bool noise)
+{
+    FMSTR_U32 bits;
+
+    if (noise)
+    {
+        s_signals.counter = ((FMSTR_U64)BENCH_Random() << 40U) ^ ((FMSTR_U64)BENCH_Random() << 20U) ^ BENCH_Random();
+        bits              = (BENCH_Random() << 16U) ^ BENCH_Random();
+        (void)memcpy(&s_signals.wave, &bits, sizeof(bits));
+        s_signals.word  = (BENCH_Random() << 16U) ^ BENCH_Random();
+        s_signals.level = (FMSTR_S16)BENCH_Random();
+        s_signals.flags = (FMSTR_U8)BENCH_Random();
+    }
+    else
+    {
+        s_signals.counter = 0x0123456789ABCDEFULL + call;
+        s_signals.wave    = (FMSTR_FLOAT)(call % 200U) * 0.25f - 25.0f;
+        s_signals.word += 3U;
+        s_signals.level = (FMSTR_S16)((call % 64U) < 32U ? (call % 32U) : (32U - (call % 32U))) - 16;
+        s_signals.flags = (FMSTR_U8)(call >> 4U);
+    }
+}
+
+/* GETREC STATUS or INFO of recorder 0, as the protocol decoder hands the command over. */
+static bench_info_t BENCH_GetInfo(bool zip, FMSTR_U8 cfgCode)
+{
+    FMSTR_U8 msg[32U] = {0U, cfgCode};
+    FMSTR_BPTR in     = msg;
+    FMSTR_U8 status;
+    bench_info_t info = {0};
+
+    if (zip)
+    {
+        (void)FMSTR_GetRecCmd(NULL, msg, &status);
+    }
+    else
+    {
+        (void)FMSTR_GetRecCmd_raw(NULL, msg, &status);
+    }
+
+    in = FMSTR_ValueFromBuffer8(&info.status, in);
+    if (cfgCode == BENCH_REC_INFO)
+    {
+        in = FMSTR_ValueFromBuffer8(&info.varCount, in);
+        in = FMSTR_AddressFromBuffer(&info.addr, in);
+        in = FMSTR_SizeFromBuffer(&info.pointSize, in);
+        in = FMSTR_SizeFromBuffer(&info.count, in);
+        in = FMSTR_SizeFromBuffer(&info.first, in);
+    }
+
+    return info;
+}
+
+static bool BENCH_Setup(const bench_case_t *benchCase)
+{
+    FMSTR_REC_BUFF zipBuff = {FMSTR_CAST_PTR_TO_ADDR(s_zip.buffer), 1000U, sizeof(s_zip.buffer), "compressed"};
+    FMSTR_REC_BUFF rawBuff = {FMSTR_CAST_PTR_TO_ADDR(s_rawBuffer), 1000U, sizeof(s_rawBuffer), "raw"};
+    FMSTR_REC_CFG cfg      = {benchCase->totalSmps, benchCase->preTrigger, benchCase->timeDiv, BENCH_VAR_COUNT};
+    FMSTR_REC_VAR vars[BENCH_VAR_COUNT] = {
+        {FMSTR_CAST_PTR_TO_ADDR(&s_signals.counter), NULL, 8U, 0U},
+        {FMSTR_CAST_PTR_TO_ADDR(&s_signals.wave), NULL, 4U, 0U},
+        {FMSTR_CAST_PTR_TO_ADDR(&s_signals.word), NULL, 4U, 0U},
+        {FMSTR_CAST_PTR_TO_ADDR(&s_signals.level), NULL, 2U, 0U},
+        {FMSTR_CAST_PTR_TO_ADDR(&s_signals.flags), NULL, 1U, 0U},
+        /* rising edge over the threshold */
+        {FMSTR_CAST_PTR_TO_ADDR(&s_event), FMSTR_CAST_PTR_TO_ADDR(&s_threshold), 2U,
+         FMSTR_REC_TRG_TYPE_SINT | FMSTR_REC_TRG_F_ABOVE | FMSTR_REC_TRG_F_TRGONLY},
+    };
+    FMSTR_INDEX i;
+    bool ok;
+
+    (void)memset(&s_signals, 0, sizeof(s_signals));
+    s_event = 0;
+
+    ok = (FMSTR_InitRec() != FMSTR_FALSE) && (FMSTR_InitRec_raw() != FMSTR_FALSE) &&
+         (FMSTR_RecorderCreate(0, &zipBuff) != FMSTR_FALSE) &&
+         (FMSTR_RecorderCreate_raw(0, &rawBuff) != FMSTR_FALSE) &&
+         (FMSTR_RecorderConfigure(0, &cfg) != FMSTR_FALSE) && (FMSTR_RecorderConfigure_raw(0, &cfg) != FMSTR_FALSE);
+    for (i = 0; ok && (i < (FMSTR_INDEX)BENCH_VAR_COUNT); i++)
+    {
+        ok = (FMSTR_RecorderAddVariable(0, i, &vars[i]) != FMSTR_FALSE) &&
+             (FMSTR_RecorderAddVariable_raw(0, i, &vars[i]) != FMSTR_FALSE);
+    }
+
+    return ok && (FMSTR_RecorderStart(0) != FMSTR_FALSE) && (FMSTR_RecorderStart_raw(0) != FMSTR_FALSE);
+}
+
+/* The decoded points do not alias the compressed buffer or the memory behind it. */
+static bool BENCH_CheckView(const bench_info_t *info)
+{
+    FMSTR_ADDR buffer = FMSTR_CAST_PTR_TO_ADDR(s_zip.buffer);
+    FMSTR_ADDR behind = FMSTR_CAST_PTR_TO_ADDR(s_zip.behind);
+    FMSTR_U8 copy[BENCH_READ_SIZE];
+    FMSTR_SIZE i;
+    bool ok;
+
+    for (i = 0U; i < BENCH_READ_SIZE; i++)
+    {
+        s_zip.behind[i] = (FMSTR_U8)BENCH_Random();
+    }
+
+    ok = ((info->addr + (info->count * info->pointSize)) <= buffer) || (info->addr >= (behind + BENCH_READ_SIZE));
+    /* the recorder structure is at the start of the buffer, the samples at its end */
+    ok = ok && (FMSTR_IsInRecBuffer(behind - 1, 1U) != FMSTR_FALSE) &&
+         (FMSTR_IsInRecBuffer(behind, BENCH_READ_SIZE) == FMSTR_FALSE);
+    (void)FMSTR_CopyRecToBuffer(copy, behind, BENCH_READ_SIZE);
+
+    return ok && (memcmp(copy, s_zip.behind, BENCH_READ_SIZE) == 0);
+}
+
+/*
+ * Reads the points the way the PC does and checks them against the log, last is the log index of
+ * the last point the recorder took. trgPos is set to the index of the trigger point among the read
+ * points, or to the count when it is not among them.
+ */
+static bool BENCH_Check(bool zip, uint32_t last, uint32_t trigger, bench_info_t *info, FMSTR_SIZE *trgPos)
+{
+    FMSTR_SIZE bytes;
+    FMSTR_SIZE len;
+    FMSTR_SIZE k;
+    FMSTR_SIZE ix;
+    bool ok;
+
+    *info   = BENCH_GetInfo(zip, BENCH_REC_INFO);
+    *trgPos = info->count;
+    ok      = (info->varCount == (BENCH_VAR_COUNT - 1U)) && (info->pointSize == BENCH_POINT_SIZE) &&
+         (info->count > 0U) && (info->count <= BENCH_MAX_POINTS) && (info->count <= (last + 1U)) &&
+         (!zip || BENCH_CheckView(info));
+
+    bytes = info->count * info->pointSize;
+    for (k = 0U; ok && (k < bytes); k += len)
+    {
+        if (zip)
+        {
+            /* oldest point first */
+            len = ((bytes - k) < BENCH_READ_SIZE) ? (bytes - k) : BENCH_READ_SIZE;
+            ok  = FMSTR_IsInRecBuffer(info->addr + k, len) != FMSTR_FALSE;
+            (void)FMSTR_CopyRecToBuffer(&s_read[k], info->addr + k, len);
+        }
+        else
+        {
+            /* circular buffer starting at the first point */
+            len = info->pointSize;
+            ix  = ((info->first + (k / len)) % info->count) * len;
+            (void)memcpy(&s_read[k], info->addr + ix, len);
+        }
+    }
+
+    for (k = 0U; ok && (k < info->count); k++)
+    {
+        ix = last + 1U - info->count + k;
+        ok = memcmp(&s_read[k * BENCH_POINT_SIZE], s_log[ix], BENCH_POINT_SIZE) == 0;
+        if ((trigger != 0U) && (ix == trigger))
+        {
+            *trgPos = k;
+        }
+    }
+
+    return ok;
+}
+
+static void BENCH_Run(const bench_case_t *benchCase)
+{
+    bench_info_t zipInfo;
+    bench_info_t rawInfo;
+    FMSTR_SIZE zipTrg;
+    FMSTR_SIZE rawTrg;
+    uint32_t points  = 0U;
+    uint32_t zipLast = 0U;
+    uint32_t rawLast = 0U;
+    uint32_t trigger = 0U;
+    uint32_t call;
+    bool zipRunning;
+    bool rawRunning;
+    bool sampled;
+    bool ok;
+
+    ok = BENCH_Setup(benchCase);
+    for (call = 0U; ok && (call < benchCase->calls); call++)
+    {
+        BENCH_Update(call, benchCase->noise);
+        s_event = (FMSTR_S16)(((benchCase->trigger != 0U) && (call >= benchCase->trigger)) ? 1 : 0);
+
+        /* the recorders sample every timeDiv + 1 calls from their start */
+        sampled = (call % (benchCase->timeDiv + 1U)) == 0U;
+        if (sampled)
+        {
+            (void)memcpy(s_log[points], &s_signals, BENCH_POINT_SIZE);
+            if ((benchCase->trigger != 0U) && (trigger == 0U) && (call >= benchCase->trigger))
+            {
+                trigger = points;
+            }
+        }
+
+        zipRunning = BENCH_GetInfo(true, BENCH_REC_STATUS).status == 0x02U;
+        rawRunning = BENCH_GetInfo(false, BENCH_REC_STATUS).status == 0x02U;
+        FMSTR_Recorder(0);
+        FMSTR_Recorder_raw(0);
+
+        zipLast = (zipRunning && sampled) ? points : zipLast;
+        rawLast = (rawRunning && sampled) ? points : rawLast;
+        points += sampled ? 1U : 0U;
+    }
+    (void)FMSTR_RecorderAbort(0);
+    (void)FMSTR_RecorderAbort_raw(0);
+
+    ok = BENCH_Check(true, zipLast, trigger, &zipInfo, &zipTrg) && ok;
+    ok = BENCH_Check(false, rawLast, trigger, &rawInfo, &rawTrg) && ok;
+
+    /* a run cut short in the first cycle holds all points, a finished one all it can */
+    if (points <= rawInfo.count)
+    {
+        ok = ok && (zipInfo.status == BENCH_STS_PARTIAL) && (rawInfo.status == BENCH_STS_PARTIAL) &&
+             (zipInfo.count == points) && (rawInfo.count == points);
+    }
+    else
+    {
+        ok = ok && (zipInfo.status == BENCH_STS_READY) && (rawInfo.status == BENCH_STS_READY) &&
+             ((benchCase->totalSmps == 0U) || (zipInfo.count == benchCase->totalSmps));
+    }
+
+    /* both stopped by the trigger with the pre-trigger points before the trigger point */
+    if (trigger != 0U)
+    {
+        ok = ok && (zipLast < (points - 1U)) && (rawLast < (points - 1U)) && (rawTrg == benchCase->preTrigger) &&
+             (zipTrg == benchCase->preTrigger);
+    }
+
+    (void)printf("%-10s %5u points  raw %4u  compressed %4u  x%4.2f  trigger at %4d %4d  %s\r\n", benchCase->name,
+                 (unsigned int)points, (unsigned int)rawInfo.count, (unsigned int)zipInfo.count,
+                 (double)zipInfo.count / (double)rawInfo.count, trigger != 0U ? (int)rawTrg : -1,
+                 trigger != 0U ? (int)zipTrg : -1, ok ? "ok" : "FAILED");
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < (sizeof(s_cases) / sizeof(s_cases[0])); i++)
+    {
+        BENCH_Run(&s_cases[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Measures the FreeMASTER TSA safety check with 16, 64, 256 and 1024 variables in the TSA table:
+ * reads and writes of variables, reads of the variable names and accesses to the gaps between the
+ * variables, which the check must reject. Built once walking the TSA tables, once with the sorted
+ * address index and once with an index too small for the larger tables, see FMSTR_TSA_INDEX_SIZE.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "freemaster.h"
+#include "freemaster_tsa.h"
+#include "freemaster_private.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_MAX_VARS     (1024U)
+#define BENCH_VAR_STRIDE   (16U)
+#define BENCH_NAME_SIZE    (8U)
+#define BENCH_DYNAMIC_VARS (4U)
+#define BENCH_CHECKS       (1U << 20U)
+
+#define BENCH_ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
+
+/* The large index holds all tables, the small one overflows and falls back to the table walk. */
+#if FMSTR_TSA_INDEX_SIZE > (2U * BENCH_MAX_VARS)
+#define BENCH_TSA_NAME "index"
+#elif FMSTR_TSA_INDEX_SIZE > 0
+#define BENCH_TSA_NAME "small"
+#else
+#define BENCH_TSA_NAME "linear"
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Variable i starts at i * BENCH_VAR_STRIDE + i % 4 and has 1, 2, 4 or 8 bytes, the rest is a gap. */
+static FMSTR_U8 s_memory[(BENCH_MAX_VARS + 1U) * BENCH_VAR_STRIDE];
+static FMSTR_TSA_ENTRY s_table[BENCH_MAX_VARS + 1U];
+static char s_names[BENCH_MAX_VARS][BENCH_NAME_SIZE];
+static FMSTR_SIZE s_tableSize;
+
+static FMSTR_U8 s_dynamicMemory[BENCH_DYNAMIC_VARS * BENCH_VAR_STRIDE];
+static FMSTR_TSA_ENTRY s_dynamicTable[BENCH_DYNAMIC_VARS + 1U];
+
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* The TSA table list of the application, the static table and the dynamic one. */
+FMSTR_ADDR FMSTR_TsaGetTable(FMSTR_SIZE tableIndex, FMSTR_SIZE *tableSize)
+{
+    if (tableIndex == 0U)
+    {
+        *tableSize = s_tableSize;
+        return (FMSTR_ADDR)s_table;
+    }
+
+    if (tableIndex == 1U)
+    {
+        return FMSTR_TSA_FUNC(dynamic_tsa)(tableSize);
+    }
+
+    return NULL;
+}
+
+static uint64_t BENCH_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+static FMSTR_ADDR BENCH_VarAddr(uint32_t i)
+{
+    return &s_memory[(i * BENCH_VAR_STRIDE) + (i % 4U)];
+}
+
+static FMSTR_SIZE BENCH_VarSize(uint32_t i)
+{
+    return (FMSTR_SIZE)1U << (i % 4U);
+}
+
+/* Every third variable is read-only, every eighth entry is a structure member without memory. */
+static bool BENCH_VarWritable(uint32_t i)
+{
+    return (i % 3U) != 0U;
+}
+
+static bool BENCH_VarMapped(uint32_t i)
+{
+    return (i % 8U) != 7U;
+}
+
+/* Fills the static TSA table with count variables and initializes the TSA. */
+static void BENCH_SetUpTable(uint32_t count)
+{
+    unsigned long flags;
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        (void)snprintf(s_names[i], BENCH_NAME_SIZE, "v%04u", (unsigned int)i);
+
+        if (!BENCH_VarMapped(i))
+        {
+            flags = FMSTR_TSA_INFO_NON_VAR;
+        }
+        else
+        {
+            flags = BENCH_VarWritable(i) ? FMSTR_TSA_INFO_RW_VAR : FMSTR_TSA_INFO_RO_VAR;
+        }
+
+        s_table[i].name.p = s_names[i];
+        s_table[i].type.p = FMSTR_TSA_UINT8;
+        s_table[i].addr.p = BENCH_VarAddr(i);
+        s_table[i].info.p = FMSTR_TSATBL_VOIDPTR_CAST(((unsigned long)BENCH_VarSize(i) << 2) | flags);
+    }
+    s_tableSize = (FMSTR_SIZE)(count * sizeof(FMSTR_TSA_ENTRY));
+
+    (void)FMSTR_SetUpTsaBuff(NULL, 0U);
+    (void)FMSTR_InitTsa();
+}
+
+static void BENCH_Report(const char *name, uint32_t count, uint64_t ns, uint32_t ops, bool ok)
+{
+    (void)printf("%-6s %-12s %4u vars  %8.1f ns/check  %s\r\n", BENCH_TSA_NAME, name, (unsigned int)count,
+                 (double)ns / (double)ops, ok ? "ok" : "FAILED");
+}
+
+/* The result of each check against the layout of the table. */
+static bool BENCH_Verify(uint32_t count)
+{
+    FMSTR_ADDR addr;
+    FMSTR_SIZE size;
+    FMSTR_U8 outside;
+    uint32_t i;
+    bool mapped;
+    bool ok = true;
+
+    for (i = 0U; i < count; i++)
+    {
+        addr   = BENCH_VarAddr(i);
+        size   = BENCH_VarSize(i);
+        mapped = BENCH_VarMapped(i);
+
+        ok = ok && ((FMSTR_CheckTsaSpace(addr, size, FMSTR_FALSE) != FMSTR_FALSE) == mapped);
+        ok = ok && ((FMSTR_CheckTsaSpace(addr + size - 1U, 1U, FMSTR_FALSE) != FMSTR_FALSE) == mapped);
+        ok = ok && ((FMSTR_CheckTsaSpace(addr, size, FMSTR_TRUE) != FMSTR_FALSE) == (mapped && BENCH_VarWritable(i)));
+
+        /* the gaps around the variable and accesses reaching into them */
+        ok = ok && (FMSTR_CheckTsaSpace(addr - 1U, 1U, FMSTR_FALSE) == FMSTR_FALSE);
+        ok = ok && (FMSTR_CheckTsaSpace(addr + size, 1U, FMSTR_FALSE) == FMSTR_FALSE);
+        ok = ok && (FMSTR_CheckTsaSpace(addr, size + 1U, FMSTR_FALSE) == FMSTR_FALSE);
+        ok = ok && (FMSTR_CheckTsaSpace(addr - 1U, 2U, FMSTR_FALSE) == FMSTR_FALSE);
+
+        /* the name is readable, but not the terminating zero */
+        addr = (FMSTR_ADDR)s_names[i];
+        ok   = ok && (FMSTR_CheckTsaSpace(addr, 5U, FMSTR_FALSE) != FMSTR_FALSE);
+        ok   = ok && (FMSTR_CheckTsaSpace(addr, 6U, FMSTR_FALSE) == FMSTR_FALSE);
+        ok   = ok && (FMSTR_CheckTsaSpace(addr, 5U, FMSTR_TRUE) == FMSTR_FALSE);
+    }
+
+    /* the table itself is readable up to its end */
+    addr = (FMSTR_ADDR)s_table;
+    ok   = ok && (FMSTR_CheckTsaSpace(addr, s_tableSize, FMSTR_FALSE) != FMSTR_FALSE);
+    ok   = ok && (FMSTR_CheckTsaSpace(addr, s_tableSize + 1U, FMSTR_FALSE) == FMSTR_FALSE);
+    ok   = ok && (FMSTR_CheckTsaSpace(addr, 4U, FMSTR_TRUE) == FMSTR_FALSE);
+
+    /* memory not referenced by the table */
+    ok = ok && (FMSTR_CheckTsaSpace(&outside, 1U, FMSTR_FALSE) == FMSTR_FALSE);
+    ok = ok && (FMSTR_CheckTsaSpace(BENCH_VarAddr(count), 1U, FMSTR_FALSE) == FMSTR_FALSE);
+
+    return ok;
+}
+
+/* Variables added at runtime become accessible, a cleared buffer takes them away. */
+static bool BENCH_Dynamic(uint32_t count)
+{
+    FMSTR_ADDR addr;
+    uint32_t i;
+    bool ok;
+
+    ok = (FMSTR_SetUpTsaBuff((FMSTR_ADDR)s_dynamicTable, sizeof(s_dynamicTable)) != FMSTR_FALSE);
+    for (i = 0U; i < BENCH_DYNAMIC_VARS; i++)
+    {
+        addr = &s_dynamicMemory[i * BENCH_VAR_STRIDE];
+        ok   = ok && (FMSTR_CheckTsaSpace(addr, 4U, FMSTR_FALSE) == FMSTR_FALSE);
+        ok   = ok && (FMSTR_TsaAddVar("dyn", FMSTR_TSA_UINT32, addr, 4U,
+                                      ((i % 2U) != 0U) ? FMSTR_TSA_INFO_RW_VAR : FMSTR_TSA_INFO_RO_VAR) != FMSTR_FALSE);
+        ok   = ok && (FMSTR_CheckTsaSpace(addr, 4U, FMSTR_FALSE) != FMSTR_FALSE);
+        ok   = ok && ((FMSTR_CheckTsaSpace(addr, 4U, FMSTR_TRUE) != FMSTR_FALSE) == ((i % 2U) != 0U));
+        ok   = ok && (FMSTR_CheckTsaSpace(addr, 5U, FMSTR_FALSE) == FMSTR_FALSE);
+    }
+    ok = ok && (FMSTR_CheckTsaSpace((FMSTR_ADDR)s_dynamicTable, sizeof(FMSTR_TSA_ENTRY) * BENCH_DYNAMIC_VARS,
+                                    FMSTR_FALSE) != FMSTR_FALSE);
+    ok = ok && BENCH_Verify(count);
+
+    (void)FMSTR_SetUpTsaBuff(NULL, 0U);
+    ok = ok && (FMSTR_CheckTsaSpace(s_dynamicMemory, 4U, FMSTR_FALSE) == FMSTR_FALSE);
+
+    return ok;
+}
+
+/* Random checks of whole variables, half of them writes, and of gap bytes. */
+static void BENCH_Checks(uint32_t count, bool gaps)
+{
+    static FMSTR_ADDR addrs[256];
+    static FMSTR_SIZE sizes[256];
+    static FMSTR_BOOL writes[256];
+    uint32_t granted = 0U;
+    uint32_t expected = 0U;
+    uint64_t start;
+    uint32_t n;
+    uint32_t i;
+
+    for (n = 0U; n < BENCH_ARRAY_SIZE(addrs); n++)
+    {
+        i         = BENCH_Random() % count;
+        writes[n] = ((BENCH_Random() % 2U) != 0U) ? FMSTR_TRUE : FMSTR_FALSE;
+        addrs[n]  = gaps ? (BENCH_VarAddr(i) + 9U) : BENCH_VarAddr(i);
+        sizes[n]  = gaps ? 1U : BENCH_VarSize(i);
+        if (!gaps && BENCH_VarMapped(i) && ((writes[n] == FMSTR_FALSE) || BENCH_VarWritable(i)))
+        {
+            expected++;
+        }
+    }
+
+    start = BENCH_GetNs();
+    for (n = 0U; n < BENCH_CHECKS; n++)
+    {
+        if (FMSTR_CheckTsaSpace(addrs[n % 256U], sizes[n % 256U], writes[n % 256U]) != FMSTR_FALSE)
+        {
+            granted++;
+        }
+    }
+    BENCH_Report(gaps ? "gaps" : "variables", count, BENCH_GetNs() - start, BENCH_CHECKS,
+                 granted == (expected * (BENCH_CHECKS / 256U)));
+}
+
+int main(void)
+{
+    static const uint32_t counts[] = {16U, 64U, 256U, 1024U};
+    uint32_t i;
+    bool ok;
+
+    for (i = 0U; i < BENCH_ARRAY_SIZE(counts); i++)
+    {
+        BENCH_SetUpTable(counts[i]);
+        ok = BENCH_Verify(counts[i]) && BENCH_Dynamic(counts[i]);
+        (void)printf("%-6s checks       %4u vars  %s\r\n", BENCH_TSA_NAME, (unsigned int)counts[i],
+                     ok ? "ok" : "FAILED");
+
+        BENCH_Checks(counts[i], false);
+        BENCH_Checks(counts[i], true);
+    }
+
+    return 0;
+}
@@ -0,0 +1,487 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Reads three simulated sensors through the I2C transaction queue, with the interrupt and with the
+ * DMA transfer driver, and compares the bus idle time between the transactions with the one of an
+ * application that starts every transfer after the previous one completed. Then runs periodic
+ * bursts from SysTick together with single submissions and checks the data and the overruns.
+ */
+
+#include <stdio.h>
+
+#include "fsl_hostsim_models.h"
+#include "fsl_i2c_queue.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_ACCEL_ADDR     (0x18U)
+#define BENCH_GYRO_ADDR      (0x6AU)
+#define BENCH_MAG_ADDR       (0x1EU)
+#define BENCH_ABSENT_ADDR    (0x55U)
+#define BENCH_DEVICE_SIZE    (64U)
+#define BENCH_SENSOR_REG     (0x28U)
+#define BENCH_CONFIG_REG     (0x20U)
+#define BENCH_SAMPLE_BYTES   (6U)
+#define BENCH_SENSORS        (3U)
+#define BENCH_ROUNDS         (200U)
+#define BENCH_BURSTS         (100U)
+#define BENCH_BURST_PERIOD   (2U)   /* SysTick periods */
+#define BENCH_CONFIG_PERIOD  (5U)   /* SysTick periods */
+#define BENCH_SYSTICK_HZ     (1000U)
+#define BENCH_I2C_DMA_CHANNEL (15U) /* I2C0_MASTER_DMA request */
+
+typedef struct _bench_result
+{
+    uint64_t gapSum;
+    uint32_t gapMax;
+    uint64_t latencySum;
+    uint32_t latencyMax;
+    uint64_t busSum;
+    uint32_t count;
+} bench_result_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Buffers seen by the DMA must have 32-bit addresses, they are static in a non-PIE program. */
+static uint8_t s_accel[BENCH_DEVICE_SIZE];
+static uint8_t s_gyro[BENCH_DEVICE_SIZE];
+static uint8_t s_mag[BENCH_DEVICE_SIZE];
+static uint8_t s_sample[BENCH_SENSORS][BENCH_SAMPLE_BYTES];
+static uint8_t s_config[2];
+static uint8_t s_absent[2];
+static uint8_t s_singleData[2][BENCH_SAMPLE_BYTES];
+
+static hostsim_i2c_model_t s_i2cModel;
+static hostsim_dma_model_t s_dmaModel;
+
+static i2c_master_handle_t s_masterHandle;
+static i2c_queue_handle_t s_queueHandle;
+static dma_handle_t s_i2cDmaHandle;
+static i2c_queue_transaction_t s_reads[BENCH_SENSORS];
+static i2c_queue_transaction_t s_configWrite;
+static i2c_queue_transaction_t s_single[2];
+static i2c_queue_burst_t s_readBurst;
+static i2c_queue_burst_t s_configBurst;
+
+static volatile status_t s_masterStatus;
+static volatile uint32_t s_masterDoneTime;
+static volatile uint32_t s_burstsDone;
+static volatile uint32_t s_burstErrors;
+static volatile uint32_t s_configsDone;
+static volatile uint32_t s_callbacks;
+static uint8_t s_configValue;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t BENCH_Timestamp(void)
+{
+    return (uint32_t)HOSTSIM_GetCycles();
+}
+
+static void BENCH_FillDevices(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < BENCH_DEVICE_SIZE; i++)
+    {
+        s_accel[i] = (uint8_t)(i ^ BENCH_ACCEL_ADDR);
+        s_gyro[i]  = (uint8_t)(i ^ BENCH_GYRO_ADDR);
+        s_mag[i]   = (uint8_t)(i ^ BENCH_MAG_ADDR);
+    }
+}
+
+static bool BENCH_CheckSamples(void)
+{
+    static const uint8_t address[BENCH_SENSORS] = {BENCH_ACCEL_ADDR, BENCH_GYRO_ADDR, BENCH_MAG_ADDR};
+    uint32_t sensor;
+    uint32_t i;
+
+    for (sensor = 0U; sensor < BENCH_SENSORS; sensor++)
+    {
+        for (i = 0U; i < BENCH_SAMPLE_BYTES; i++)
+        {
+            if (s_sample[sensor][i] != (uint8_t)((BENCH_SENSOR_REG + i) ^ address[sensor]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void BENCH_PrepareReads(void)
+{
+    I2C_QueuePrepareTransaction(&s_reads[0], BENCH_ACCEL_ADDR, kI2C_Read, BENCH_SENSOR_REG, 1U, s_sample[0],
+                                BENCH_SAMPLE_BYTES);
+    I2C_QueuePrepareTransaction(&s_reads[1], BENCH_GYRO_ADDR, kI2C_Read, BENCH_SENSOR_REG, 1U, s_sample[1],
+                                BENCH_SAMPLE_BYTES);
+    I2C_QueuePrepareTransaction(&s_reads[2], BENCH_MAG_ADDR, kI2C_Read, BENCH_SENSOR_REG, 1U, s_sample[2],
+                                BENCH_SAMPLE_BYTES);
+}
+
+/* Fresh I2C and DMA models with the three sensors on the bus. */
+static void BENCH_InitBus(void)
+{
+    i2c_master_config_t config;
+
+    HOSTSIM_DetachModel(&s_i2cModel.model);
+    HOSTSIM_DetachModel(&s_dmaModel.model);
+
+    BENCH_FillDevices();
+    HOSTSIM_I2cModelInit(&s_i2cModel, I2C0, I2C0_IRQn, BENCH_ACCEL_ADDR, s_accel, BENCH_DEVICE_SIZE);
+    HOSTSIM_I2cModelAddDevice(&s_i2cModel, BENCH_GYRO_ADDR, s_gyro, BENCH_DEVICE_SIZE);
+    HOSTSIM_I2cModelAddDevice(&s_i2cModel, BENCH_MAG_ADDR, s_mag, BENCH_DEVICE_SIZE);
+    HOSTSIM_DmaModelInit(&s_dmaModel, DMA0);
+    HOSTSIM_DmaModelConnect(&s_dmaModel, BENCH_I2C_DMA_CHANNEL, (uint32_t)I2C0, 0U);
+
+    I2C_MasterGetDefaultConfig(&config);
+    I2C_MasterInit(I2C0, &config, CLOCK_GetFreq(kCLOCK_MainClk));
+}
+
+static void BENCH_InitDma(void)
+{
+    DMA_Init(DMA0);
+    DMA_EnableChannel(DMA0, BENCH_I2C_DMA_CHANNEL);
+    DMA_CreateHandle(&s_i2cDmaHandle, DMA0, BENCH_I2C_DMA_CHANNEL);
+}
+
+static void BENCH_Report(const char *name, const bench_result_t *result, bool ok)
+{
+    (void)printf("%-22s %4u xfers  gap avg %7.1f max %7u  latency avg %7.1f max %7u  bus avg %7.1f cycles  %s\r\n",
+                 name, (unsigned int)result->count, (double)result->gapSum / (double)result->count,
+                 (unsigned int)result->gapMax, (double)result->latencySum / (double)result->count,
+                 (unsigned int)result->latencyMax, (double)result->busSum / (double)result->count,
+                 ok ? "ok" : "FAILED");
+}
+
+static void BENCH_MasterCallback(I2C_Type *base, i2c_master_handle_t *handle, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)userData;
+
+    s_masterDoneTime = BENCH_Timestamp();
+    s_masterStatus   = status;
+}
+
+/* The application starts the next read after it saw the completion of the previous one. */
+static void BENCH_Rearm(void)
+{
+    bench_result_t result = {0};
+    i2c_master_transfer_t xfer[BENCH_SENSORS];
+    uint32_t queueTime;
+    uint32_t startTime;
+    uint32_t lastDone;
+    uint32_t round;
+    uint32_t i;
+    bool ok = true;
+
+    BENCH_InitBus();
+    BENCH_PrepareReads();
+    for (i = 0U; i < BENCH_SENSORS; i++)
+    {
+        xfer[i] = s_reads[i].xfer;
+    }
+    I2C_MasterTransferCreateHandle(I2C0, &s_masterHandle, BENCH_MasterCallback, NULL);
+
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        (void)memset(s_sample, 0, sizeof(s_sample));
+        queueTime = BENCH_Timestamp();
+        lastDone  = queueTime;
+        for (i = 0U; i < BENCH_SENSORS; i++)
+        {
+            s_masterStatus = kStatus_I2C_Busy;
+            startTime      = BENCH_Timestamp();
+            if (I2C_MasterTransferNonBlocking(I2C0, &s_masterHandle, &xfer[i]) != kStatus_Success)
+            {
+                ok = false;
+                break;
+            }
+            while (s_masterStatus == kStatus_I2C_Busy)
+            {
+                __WFI();
+            }
+            ok = ok && (s_masterStatus == kStatus_Success);
+
+            result.gapSum += startTime - lastDone;
+            result.gapMax = ((startTime - lastDone) > result.gapMax) ? (startTime - lastDone) : result.gapMax;
+            result.latencySum += s_masterDoneTime - queueTime;
+            result.latencyMax = ((s_masterDoneTime - queueTime) > result.latencyMax) ? (s_masterDoneTime - queueTime) :
+                                                                                        result.latencyMax;
+            result.busSum += s_masterDoneTime - startTime;
+            result.count++;
+            lastDone = s_masterDoneTime;
+        }
+        ok = ok && BENCH_CheckSamples();
+    }
+
+    BENCH_Report("rearm interrupt", &result, ok);
+
+    I2C_MasterDeinit(I2C0);
+}
+
+static void BENCH_QueueCallback(I2C_Type *base,
+                                i2c_queue_handle_t *handle,
+                                i2c_queue_transaction_t *transaction,
+                                void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)transaction;
+    (void)userData;
+
+    s_callbacks++;
+}
+
+/* The queue chains the reads of a round from the completion interrupt. */
+static void BENCH_Queue(const char *name, bool useDma)
+{
+    bench_result_t result = {0};
+    i2c_queue_stats_t stats;
+    i2c_queue_transaction_t *transaction;
+    uint32_t round;
+    uint32_t i;
+    bool ok = true;
+
+    BENCH_InitBus();
+    if (useDma)
+    {
+        BENCH_InitDma();
+        I2C_QueueCreateHandleDMA(I2C0, &s_queueHandle, &s_i2cDmaHandle, BENCH_QueueCallback, NULL, BENCH_Timestamp);
+    }
+    else
+    {
+        I2C_QueueCreateHandle(I2C0, &s_queueHandle, BENCH_QueueCallback, NULL, BENCH_Timestamp);
+    }
+    BENCH_PrepareReads();
+    s_callbacks = 0U;
+
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        (void)memset(s_sample, 0, sizeof(s_sample));
+        if (I2C_QueueSubmit(I2C0, &s_queueHandle, s_reads, BENCH_SENSORS) != kStatus_Success)
+        {
+            ok = false;
+            break;
+        }
+        while (s_reads[BENCH_SENSORS - 1U].status == kStatus_I2C_Busy)
+        {
+            __WFI();
+        }
+
+        for (i = 0U; i < BENCH_SENSORS; i++)
+        {
+            transaction = &s_reads[i];
+            ok          = ok && (transaction->status == kStatus_Success);
+            /* The first read waits for the bus since the submission, the others since the previous read. */
+            result.gapSum +=
+                transaction->startTime - ((i == 0U) ? transaction->queueTime : s_reads[i - 1U].doneTime);
+            result.latencySum += transaction->doneTime - transaction->queueTime;
+            result.busSum += transaction->doneTime - transaction->startTime;
+            result.count++;
+        }
+        ok = ok && BENCH_CheckSamples();
+    }
+
+    I2C_QueueGetStats(I2C0, &s_queueHandle, &stats);
+    result.gapMax     = stats.maxGap;
+    result.latencyMax = stats.maxLatency;
+    ok = ok && (stats.completed == result.count) && (stats.failed == 0U) && (s_callbacks == result.count);
+
+    BENCH_Report(name, &result, ok);
+
+    if (useDma)
+    {
+        DMA_Deinit(DMA0);
+    }
+    I2C_MasterDeinit(I2C0);
+}
+
+/* A read of an absent device fails, the transactions queued after it still run. */
+static void BENCH_Nak(void)
+{
+    i2c_queue_transaction_t transactions[2];
+    i2c_queue_stats_t stats;
+    bool ok;
+
+    BENCH_InitBus();
+    I2C_QueueCreateHandle(I2C0, &s_queueHandle, NULL, NULL, BENCH_Timestamp);
+
+    (void)memset(s_sample, 0, sizeof(s_sample));
+    I2C_QueuePrepareTransaction(&transactions[0], BENCH_ABSENT_ADDR, kI2C_Read, BENCH_SENSOR_REG, 1U, s_absent,
+                                sizeof(s_absent));
+    I2C_QueuePrepareTransaction(&transactions[1], BENCH_ACCEL_ADDR, kI2C_Read, BENCH_SENSOR_REG, 1U, s_sample[0],
+                                BENCH_SAMPLE_BYTES);
+    ok = (I2C_QueueSubmit(I2C0, &s_queueHandle, transactions, 2U) == kStatus_Success);
+    while (transactions[1].status == kStatus_I2C_Busy)
+    {
+        __WFI();
+    }
+    I2C_QueueGetStats(I2C0, &s_queueHandle, &stats);
+
+    ok = ok && (transactions[0].status != kStatus_Success) && (transactions[1].status == kStatus_Success) &&
+         (s_sample[0][0] == (uint8_t)(BENCH_SENSOR_REG ^ BENCH_ACCEL_ADDR)) && (stats.completed == 1U) &&
+         (stats.failed == 1U);
+
+    (void)printf("absent device          status %d, next transaction status %d  %s\r\n", (int)transactions[0].status,
+                 (int)transactions[1].status, ok ? "ok" : "FAILED");
+
+    I2C_MasterDeinit(I2C0);
+}
+
+void SysTick_Handler(void)
+{
+    I2C_QueueTick(I2C0, &s_queueHandle);
+}
+
+static void BENCH_ReadBurstCallback(
+    I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_burst_t *burst, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)burst;
+    (void)userData;
+
+    if ((status != kStatus_Success) || !BENCH_CheckSamples())
+    {
+        s_burstErrors++;
+    }
+    (void)memset(s_sample, 0, sizeof(s_sample));
+    s_burstsDone++;
+}
+
+static void BENCH_ConfigBurstCallback(
+    I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_burst_t *burst, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)burst;
+    (void)userData;
+
+    /* The device got the value of this submission, the next one writes a new value. */
+    if ((status != kStatus_Success) || (s_accel[BENCH_CONFIG_REG] != s_config[0]) ||
+        (s_accel[BENCH_CONFIG_REG + 1U] != s_config[1]))
+    {
+        s_burstErrors++;
+    }
+    s_configValue++;
+    s_config[0] = s_configValue;
+    s_config[1] = (uint8_t)~s_configValue;
+    s_configsDone++;
+}
+
+/* Periodic bursts from SysTick with single submissions from the main loop in between. */
+static void BENCH_Bursts(const char *name, bool useDma)
+{
+    i2c_queue_stats_t stats;
+    uint32_t singles = 0U;
+    uint32_t singleErrors = 0U;
+    bool ok;
+
+    BENCH_InitBus();
+    if (useDma)
+    {
+        BENCH_InitDma();
+        I2C_QueueCreateHandleDMA(I2C0, &s_queueHandle, &s_i2cDmaHandle, NULL, NULL, BENCH_Timestamp);
+    }
+    else
+    {
+        I2C_QueueCreateHandle(I2C0, &s_queueHandle, NULL, NULL, BENCH_Timestamp);
+    }
+
+    BENCH_PrepareReads();
+    (void)memset(s_sample, 0, sizeof(s_sample));
+    s_configValue = 1U;
+    s_config[0]   = s_configValue;
+    s_config[1]   = (uint8_t)~s_configValue;
+    I2C_QueuePrepareTransaction(&s_configWrite, BENCH_ACCEL_ADDR, kI2C_Write, BENCH_CONFIG_REG, 1U, s_config,
+                                sizeof(s_config));
+    I2C_QueueCreateBurst(&s_readBurst, s_reads, BENCH_SENSORS, BENCH_BURST_PERIOD, BENCH_ReadBurstCallback, NULL);
+    I2C_QueueCreateBurst(&s_configBurst, &s_configWrite, 1U, BENCH_CONFIG_PERIOD, BENCH_ConfigBurstCallback, NULL);
+    s_burstsDone  = 0U;
+    s_burstErrors = 0U;
+    s_configsDone = 0U;
+
+    I2C_QueueAddBurst(I2C0, &s_queueHandle, &s_readBurst);
+    I2C_QueueAddBurst(I2C0, &s_queueHandle, &s_configBurst);
+    (void)SysTick_Config(SystemCoreClock / BENCH_SYSTICK_HZ);
+
+    while (s_burstsDone < BENCH_BURSTS)
+    {
+        /* Single reads of the gyro and the magnetometer, queued behind or between the bursts. */
+        I2C_QueuePrepareTransaction(&s_single[0], BENCH_GYRO_ADDR, kI2C_Read, 0U, 1U, s_singleData[0],
+                                    BENCH_SAMPLE_BYTES);
+        I2C_QueuePrepareTransaction(&s_single[1], BENCH_MAG_ADDR, kI2C_Read, 0U, 1U, s_singleData[1],
+                                    BENCH_SAMPLE_BYTES);
+        if (I2C_QueueSubmit(I2C0, &s_queueHandle, s_single, 2U) != kStatus_Success)
+        {
+            singleErrors++;
+            break;
+        }
+        while (s_single[1].status == kStatus_I2C_Busy)
+        {
+            __WFI();
+        }
+        if ((s_single[0].status != kStatus_Success) || (s_single[1].status != kStatus_Success) ||
+            (s_singleData[0][5] != (uint8_t)(5U ^ BENCH_GYRO_ADDR)) || (s_singleData[1][5] != (uint8_t)(5U ^ BENCH_MAG_ADDR)))
+        {
+            singleErrors++;
+        }
+        singles++;
+        __WFI();
+    }
+
+    SysTick->CTRL = 0U;
+    I2C_QueueRemoveBurst(I2C0, &s_queueHandle, &s_readBurst);
+    I2C_QueueRemoveBurst(I2C0, &s_queueHandle, &s_configBurst);
+    while ((s_readBurst.remaining != 0U) || (s_configBurst.remaining != 0U))
+    {
+        __WFI();
+    }
+    I2C_QueueGetStats(I2C0, &s_queueHandle, &stats);
+
+    ok = (s_burstErrors == 0U) && (singleErrors == 0U) && (s_readBurst.overruns == 0U) &&
+         (s_configBurst.overruns == 0U) && (s_configsDone >= ((BENCH_BURSTS * BENCH_BURST_PERIOD) / BENCH_CONFIG_PERIOD)) &&
+         (stats.failed == 0U);
+
+    (void)printf("%-22s %u bursts, %u writes, %u singles, %u overruns  max latency %u  max gap %u cycles  %s\r\n",
+                 name, (unsigned int)s_burstsDone, (unsigned int)s_configsDone, (unsigned int)singles,
+                 (unsigned int)(s_readBurst.overruns + s_configBurst.overruns), (unsigned int)stats.maxLatency,
+                 (unsigned int)stats.maxGap, ok ? "ok" : "FAILED");
+
+    if (useDma)
+    {
+        DMA_Deinit(DMA0);
+    }
+    I2C_MasterDeinit(I2C0);
+}
+
+int main(void)
+{
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    BENCH_Rearm();
+    BENCH_Queue("queue interrupt", false);
+    BENCH_Queue("queue DMA", true);
+    BENCH_Nak();
+    BENCH_Bursts("bursts interrupt", false);
+    BENCH_Bursts("bursts DMA", true);
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,299 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Measures the generic list insertions and removals with 8, 64 and 512 elements: head and tail
+ * operations through the locked API and the inline unlocked variants, removal of any element and
+ * sorted insertion of deadlines. Built once per list configuration, see GENERIC_LIST_LIGHT and
+ * GENERIC_LIST_DEBUG.
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "fsl_hostsim.h"
+#include "fsl_component_generic_list.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_MAX_ELEMENTS (512U)
+#define BENCH_OPS_PER_RUN  (1U << 20U)
+
+#if (defined(GENERIC_LIST_DEBUG) && (GENERIC_LIST_DEBUG > 0U))
+#define BENCH_LIST_NAME "debug"
+#elif (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
+#define BENCH_LIST_NAME "light"
+#else
+#define BENCH_LIST_NAME "double"
+#endif
+
+/*! @brief List element with a deadline, the link comes first. */
+typedef struct _bench_element
+{
+    list_element_t link;
+    uint32_t deadline;
+} bench_element_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static bench_element_t s_elements[BENCH_MAX_ELEMENTS];
+static list_label_t s_list;
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t BENCH_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+static int32_t BENCH_CompareDeadline(list_element_handle_t listElement, list_element_handle_t member)
+{
+    const bench_element_t *element = (const bench_element_t *)(void *)listElement;
+    const bench_element_t *other   = (const bench_element_t *)(void *)member;
+
+    /* Wrap safe, the deadlines are ticks of a free running counter. */
+    return (int32_t)(element->deadline - other->deadline);
+}
+
+/* Walks the list, checks the size, the back pointers and the deadline order if sorted is set. */
+static bool BENCH_CheckList(uint32_t count, bool sorted)
+{
+    list_element_handle_t element = LIST_GetHead(&s_list);
+    list_element_handle_t last    = NULL;
+    uint32_t found                = 0U;
+    bool ok                       = (LIST_GetSize(&s_list) == count);
+
+    while (element != NULL)
+    {
+        ok = ok && (LIST_GetList(element) == &s_list);
+        if (sorted && (last != NULL))
+        {
+            ok = ok && (BENCH_CompareDeadline(last, element) <= 0);
+        }
+        last    = element;
+        element = LIST_GetNext(element);
+        found++;
+    }
+
+    return ok && (found == count) && (s_list.tail == last);
+}
+
+static void BENCH_Report(const char *name, uint32_t count, uint64_t ns, uint32_t ops, bool ok)
+{
+    (void)printf("%-6s %-15s %3u elements  %7.1f ns/op  %s\r\n", BENCH_LIST_NAME, name, (unsigned int)count,
+                 (double)ns / (double)ops, ok ? "ok" : "FAILED");
+}
+
+/* Fills the list with LIST_AddTail, empties it with LIST_RemoveHead. */
+static void BENCH_TailHead(uint32_t count)
+{
+    uint32_t rounds  = BENCH_OPS_PER_RUN / (2U * count);
+    uint64_t start;
+    uint32_t round;
+    uint32_t i;
+    bool ok = true;
+
+    start = BENCH_GetNs();
+    for (round = 0U; round < rounds; round++)
+    {
+        for (i = 0U; i < count; i++)
+        {
+            ok = ok && (LIST_AddTail(&s_list, &s_elements[i].link) == kLIST_Ok);
+        }
+        for (i = 0U; i < count; i++)
+        {
+            ok = ok && (LIST_RemoveHead(&s_list) == &s_elements[i].link);
+        }
+    }
+    BENCH_Report("tail/head", count, BENCH_GetNs() - start, rounds * 2U * count, ok && (LIST_GetSize(&s_list) == 0U));
+}
+
+/* Same with LIST_AddHead, the list works as a stack. */
+static void BENCH_HeadHead(uint32_t count)
+{
+    uint32_t rounds  = BENCH_OPS_PER_RUN / (2U * count);
+    uint64_t start;
+    uint32_t round;
+    uint32_t i;
+    bool ok = true;
+
+    start = BENCH_GetNs();
+    for (round = 0U; round < rounds; round++)
+    {
+        for (i = 0U; i < count; i++)
+        {
+            ok = ok && (LIST_AddHead(&s_list, &s_elements[i].link) == kLIST_Ok);
+        }
+        for (i = count; i > 0U; i--)
+        {
+            ok = ok && (LIST_RemoveHead(&s_list) == &s_elements[i - 1U].link);
+        }
+    }
+    BENCH_Report("head/head", count, BENCH_GetNs() - start, rounds * 2U * count, ok && (LIST_GetSize(&s_list) == 0U));
+}
+
+/* The inline variants inside one critical section per fill and per drain. */
+static void BENCH_Unlocked(uint32_t count)
+{
+    uint32_t rounds  = BENCH_OPS_PER_RUN / (2U * count);
+    uint64_t start;
+    uint32_t regPrimask;
+    uint32_t round;
+    uint32_t i;
+    bool ok = true;
+
+    start = BENCH_GetNs();
+    for (round = 0U; round < rounds; round++)
+    {
+        regPrimask = DisableGlobalIRQ();
+        for (i = 0U; i < count; i++)
+        {
+            ok = ok && (LIST_AddTailUnlocked(&s_list, &s_elements[i].link) == kLIST_Ok);
+        }
+        for (i = 0U; i < count; i++)
+        {
+            ok = ok && (LIST_RemoveHeadUnlocked(&s_list) == &s_elements[i].link);
+        }
+        EnableGlobalIRQ(regPrimask);
+    }
+    BENCH_Report("unlocked", count, BENCH_GetNs() - start, rounds * 2U * count, ok && (LIST_GetSize(&s_list) == 0U));
+}
+
+/* Removes random members of a full list and links them again at the tail. */
+static void BENCH_RemoveAny(uint32_t count)
+{
+    uint32_t ops = BENCH_OPS_PER_RUN / 2U;
+    uint64_t start;
+    uint32_t op;
+    uint32_t i;
+    bool ok = true;
+
+    for (i = 0U; i < count; i++)
+    {
+        (void)LIST_AddTail(&s_list, &s_elements[i].link);
+    }
+
+    start = BENCH_GetNs();
+    for (op = 0U; op < ops; op++)
+    {
+        i  = BENCH_Random() % count;
+        ok = ok && (LIST_RemoveElement(&s_elements[i].link) == kLIST_Ok);
+        ok = ok && (LIST_AddTail(&s_list, &s_elements[i].link) == kLIST_Ok);
+    }
+    BENCH_Report("remove any", count, BENCH_GetNs() - start, ops * 2U, ok && BENCH_CheckList(count, false));
+
+    while (LIST_RemoveHead(&s_list) != NULL)
+    {
+    }
+}
+
+/*
+ * Sorted insertion of deadlines, once with random deadlines and once with increasing deadlines,
+ * the usual pattern of a timer list. The earliest deadline is taken from the head.
+ */
+static void BENCH_Sorted(uint32_t count, bool increasing)
+{
+    uint32_t ops = BENCH_OPS_PER_RUN / ((count > 64U) ? 32U : 2U);
+    uint32_t now = 0U;
+    uint64_t start;
+    bench_element_t *element;
+    uint32_t op;
+    uint32_t i;
+    bool ok = true;
+
+    for (i = 0U; i < count; i++)
+    {
+        s_elements[i].deadline = increasing ? i : (BENCH_Random() % 4096U);
+        (void)LIST_AddSorted(&s_list, &s_elements[i].link, BENCH_CompareDeadline);
+    }
+    ok = BENCH_CheckList(count, true);
+
+    start = BENCH_GetNs();
+    for (op = 0U; op < ops; op++)
+    {
+        element           = (bench_element_t *)(void *)LIST_RemoveHead(&s_list);
+        now               = element->deadline;
+        element->deadline = now + (increasing ? count : (1U + (BENCH_Random() % 4096U)));
+        ok                = ok && (LIST_AddSorted(&s_list, &element->link, BENCH_CompareDeadline) == kLIST_Ok);
+    }
+    BENCH_Report(increasing ? "sorted in-order" : "sorted random", count, BENCH_GetNs() - start, ops * 2U,
+                 ok && BENCH_CheckList(count, true));
+
+    while (LIST_RemoveHead(&s_list) != NULL)
+    {
+    }
+}
+
+/* A linked element must not be linked again, an empty list must not return elements. */
+static void BENCH_Errors(void)
+{
+    bool ok;
+
+    (void)LIST_AddTail(&s_list, &s_elements[0].link);
+    (void)LIST_AddTail(&s_list, &s_elements[1].link);
+    ok = (LIST_AddTail(&s_list, &s_elements[1].link) == kLIST_DuplicateError);
+    ok = ok && (LIST_AddHead(&s_list, &s_elements[0].link) == kLIST_DuplicateError);
+    ok = ok && (LIST_AddSorted(&s_list, &s_elements[0].link, BENCH_CompareDeadline) == kLIST_DuplicateError);
+    ok = ok && (LIST_AddPrevElement(&s_elements[1].link, &s_elements[0].link) == kLIST_DuplicateError);
+    ok = ok && BENCH_CheckList(2U, false);
+    (void)LIST_RemoveHead(&s_list);
+    (void)LIST_RemoveHead(&s_list);
+    ok = ok && (LIST_RemoveHead(&s_list) == NULL) && (LIST_RemoveElement(&s_elements[0].link) == kLIST_OrphanElement);
+
+    LIST_Init(&s_list, 2U);
+    (void)LIST_AddTail(&s_list, &s_elements[0].link);
+    (void)LIST_AddTail(&s_list, &s_elements[1].link);
+    ok = ok && (LIST_AddSorted(&s_list, &s_elements[2].link, BENCH_CompareDeadline) == kLIST_Full);
+    (void)LIST_RemoveHead(&s_list);
+    (void)LIST_RemoveHead(&s_list);
+    LIST_Init(&s_list, 0U);
+
+    (void)printf("%-6s duplicate and full checks  %s\r\n", BENCH_LIST_NAME, ok ? "ok" : "FAILED");
+}
+
+int main(void)
+{
+    static const uint32_t counts[] = {8U, 64U, 512U};
+    uint32_t i;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    LIST_Init(&s_list, 0U);
+    BENCH_Errors();
+    for (i = 0U; i < ARRAY_SIZE(counts); i++)
+    {
+        BENCH_TailHead(counts[i]);
+        BENCH_HeadHead(counts[i]);
+        BENCH_Unlocked(counts[i]);
+        BENCH_RemoveAny(counts[i]);
+        BENCH_Sorted(counts[i], true);
+        BENCH_Sorted(counts[i], false);
+    }
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,469 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Replays allocation traces against the memory manager light on a heap of BENCH_HEAP_SIZE and
+ * measures the time distribution of MEM_BufferAlloc and MEM_BufferFree, the failed allocations and
+ * the top of heap low watermark. A second replay of the same trace reports the fragmentation: the
+ * largest buffer that could be allocated against the free heap, sampled along the trace. The traces
+ * are generated once and replayed the same for each allocator:
+ *
+ *   objects   a descriptor with a data buffer, deleted in random order
+ *   messages  variable sized messages freed in the order they were sent, and a few long-lived buffers
+ *   random    random sizes up to 600 bytes freed in random order
+ *
+ * The contents of every buffer are checked when it is freed and the free heap size against the
+ * buffers alive. Built once per allocator, see gMemManagerLightSegregatedFit. The heap is registered
+ * once, the list allocator keeps the free blocks that it did not meld in the top from one trace to the
+ * next. The block header holds pointers and takes 32 or 40 bytes on the host instead of 16 or 20.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fsl_hostsim.h"
+#include "fsl_component_mem_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_HEAP_SIZE    (16384U)
+#define BENCH_EVENTS       (200000U)
+#define BENCH_IDS          (512U)
+#define BENCH_FILL         (BENCH_HEAP_SIZE / 2U)
+#define BENCH_SAMPLE_EVERY (1000U)
+
+#if (defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0))
+#define BENCH_MEMORY_NAME "segregated"
+#else
+#define BENCH_MEMORY_NAME "list"
+#endif
+
+/* Trace event, the allocation of a buffer of size bytes or the free of the buffer if size is 0. */
+typedef struct _bench_event
+{
+    uint16_t id;
+    uint16_t size;
+} bench_event_t;
+
+typedef struct _bench_samples
+{
+    uint32_t count;
+    uint32_t ns[BENCH_EVENTS];
+} bench_samples_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The heap of MEMORY_POOL_GLOBAL_VARIABLE_ALLOC, memHeapEnd is its last byte. */
+static uint32_t s_heap[BENCH_HEAP_SIZE / 4U];
+uint32_t *memHeap = s_heap;
+uint32_t memHeapEnd;
+
+static bench_event_t s_trace[BENCH_EVENTS];
+static uint32_t s_traceCount;
+
+/* Buffers alive in the trace generator and in the replay. */
+static uint16_t s_live[BENCH_IDS];
+static uint32_t s_liveCount;
+static uint32_t s_liveBytes;
+static uint32_t s_liveSize[BENCH_IDS];
+static uint8_t *s_buffer[BENCH_IDS];
+static uint32_t s_bufferSize[BENCH_IDS];
+
+static bench_samples_t s_allocSamples;
+static bench_samples_t s_freeSamples;
+
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t BENCH_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+/* Memory taken by a buffer of size bytes in the model of the generator, the header and 4-byte steps. */
+static uint32_t BENCH_ModelSize(uint32_t size)
+{
+    return (size + 32U + 3U) & ~3U;
+}
+
+static void BENCH_TraceAlloc(uint32_t size)
+{
+    uint16_t id = 0U;
+
+    /* The lowest id not alive, the ids of the replay index the buffers. */
+    while (s_liveSize[id] != 0U)
+    {
+        id++;
+    }
+
+    s_live[s_liveCount++] = id;
+    s_liveSize[id]        = size;
+    s_liveBytes += BENCH_ModelSize(size);
+
+    s_trace[s_traceCount].id     = id;
+    s_trace[s_traceCount++].size = (uint16_t)size;
+}
+
+/* Frees the alive buffer at the index, the order of the others is kept. */
+static void BENCH_TraceFree(uint32_t index)
+{
+    uint16_t id = s_live[index];
+
+    s_liveBytes -= BENCH_ModelSize(s_liveSize[id]);
+    s_liveSize[id] = 0U;
+    (void)memmove(&s_live[index], &s_live[index + 1U], (s_liveCount - index - 1U) * sizeof(s_live[0]));
+    s_liveCount--;
+
+    s_trace[s_traceCount].id     = id;
+    s_trace[s_traceCount++].size = 0U;
+}
+
+/* A new buffer of the size is allocated if it fits below the fill level, else a buffer is freed. */
+static bool BENCH_TraceRoom(uint32_t size)
+{
+    return (s_liveCount < (BENCH_IDS - 2U)) && ((s_liveBytes + BENCH_ModelSize(size)) <= BENCH_FILL) &&
+           ((s_liveCount == 0U) || ((BENCH_Random() % 8U) != 0U));
+}
+
+static void BENCH_TraceBegin(void)
+{
+    s_traceCount = 0U;
+    s_liveCount  = 0U;
+    s_liveBytes  = 0U;
+    (void)memset(s_liveSize, 0, sizeof(s_liveSize));
+}
+
+/* Frees the buffers still alive so that the replay ends with all of the heap free. */
+static void BENCH_TraceEnd(void)
+{
+    while (s_liveCount > 0U)
+    {
+        BENCH_TraceFree(0U);
+    }
+}
+
+/* Descriptors of 16 to 76 bytes, each with a data buffer of 32 to 1024 bytes. */
+static void BENCH_TraceObjects(void)
+{
+    uint32_t size;
+
+    BENCH_TraceBegin();
+    while (s_traceCount < (BENCH_EVENTS - BENCH_IDS - 2U))
+    {
+        size = 16U + ((BENCH_Random() % 16U) * 4U);
+        if (BENCH_TraceRoom(size + 1024U))
+        {
+            BENCH_TraceAlloc(size);
+            BENCH_TraceAlloc(32U + ((BENCH_Random() % 125U) * 8U));
+        }
+        else
+        {
+            /* The object of a random descriptor, its data follows it. */
+            size = (BENCH_Random() % (s_liveCount / 2U)) * 2U;
+            BENCH_TraceFree(size + 1U);
+            BENCH_TraceFree(size);
+        }
+    }
+    BENCH_TraceEnd();
+}
+
+/* Messages of 8 to 256 bytes freed in order, one in 64 events a buffer of 512 to 2048 bytes comes or goes. */
+static void BENCH_TraceMessages(void)
+{
+    uint32_t buffers = 0U;
+    uint32_t size;
+    uint32_t i;
+
+    BENCH_TraceBegin();
+    while (s_traceCount < (BENCH_EVENTS - BENCH_IDS - 2U))
+    {
+        if ((BENCH_Random() % 64U) == 0U)
+        {
+            size = 512U + ((BENCH_Random() % 25U) * 64U);
+            if ((buffers < 3U) && BENCH_TraceRoom(size))
+            {
+                BENCH_TraceAlloc(size);
+                buffers++;
+            }
+            else if (buffers > 0U)
+            {
+                /* The oldest buffer. */
+                i = 0U;
+                while (s_liveSize[s_live[i]] < 512U)
+                {
+                    i++;
+                }
+                BENCH_TraceFree(i);
+                buffers--;
+            }
+            else
+            {
+                /* No room for a buffer. */
+            }
+        }
+        else
+        {
+            size = 8U + (BENCH_Random() % 249U);
+            if (BENCH_TraceRoom(size) && ((s_liveCount < 8U) || ((BENCH_Random() % 2U) == 0U)))
+            {
+                BENCH_TraceAlloc(size);
+            }
+            else
+            {
+                /* The oldest message. */
+                i = 0U;
+                while ((i < s_liveCount) && (s_liveSize[s_live[i]] >= 512U))
+                {
+                    i++;
+                }
+                if (i < s_liveCount)
+                {
+                    BENCH_TraceFree(i);
+                }
+            }
+        }
+    }
+    BENCH_TraceEnd();
+}
+
+/* Sizes of 1 to 600 bytes, freed in random order. */
+static void BENCH_TraceRandom(void)
+{
+    uint32_t size;
+
+    BENCH_TraceBegin();
+    while (s_traceCount < (BENCH_EVENTS - BENCH_IDS - 2U))
+    {
+        size = 1U + (BENCH_Random() % 600U);
+        if (BENCH_TraceRoom(size))
+        {
+            BENCH_TraceAlloc(size);
+        }
+        else
+        {
+            BENCH_TraceFree(BENCH_Random() % s_liveCount);
+        }
+    }
+    BENCH_TraceEnd();
+}
+
+static void BENCH_Record(bench_samples_t *samples, uint64_t ns)
+{
+    if (samples->count < BENCH_EVENTS)
+    {
+        samples->ns[samples->count++] = (uint32_t)ns;
+    }
+}
+
+static int BENCH_Compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* The largest buffer that can be allocated, searched with allocations that are freed at once. */
+static uint32_t BENCH_Largest(void)
+{
+    uint32_t low  = 0U;
+    uint32_t high = BENCH_HEAP_SIZE;
+    uint32_t size;
+    void *buffer;
+
+    while (low < high)
+    {
+        size   = (low + high + 1U) / 2U;
+        buffer = MEM_BufferAlloc(size);
+        if (buffer != NULL)
+        {
+            (void)MEM_BufferFree(buffer);
+            low = size;
+        }
+        else
+        {
+            high = size - 1U;
+        }
+    }
+
+    return low;
+}
+
+static void BENCH_Report(const char *name, bench_samples_t *samples)
+{
+    uint64_t sum = 0U;
+    uint32_t i;
+
+    qsort(samples->ns, samples->count, sizeof(samples->ns[0]), BENCH_Compare);
+    for (i = 0U; i < samples->count; i++)
+    {
+        sum += samples->ns[i];
+    }
+
+    (void)printf("  %-5s mean %6.1f  p50 %5u  p99 %5u  max %6u ns", name, (double)sum / (double)samples->count,
+                 (unsigned int)samples->ns[samples->count / 2U],
+                 (unsigned int)samples->ns[(samples->count * 99U) / 100U],
+                 (unsigned int)samples->ns[samples->count - 1U]);
+}
+
+/* Replays the trace, timed or with the largest buffer probed along it. Returns the failed allocations. */
+static uint32_t BENCH_Replay(bool probe, double *fragMean, double *fragMax, bool *ok)
+{
+    const bench_event_t *event;
+    uint32_t blocks  = 0U;
+    uint32_t failed  = 0U;
+    uint32_t samples = 0U;
+    uint32_t freeSize;
+    double frag;
+    uint64_t start;
+    uint32_t i;
+    uint32_t n;
+
+    (void)memset(s_buffer, 0, sizeof(s_buffer));
+    s_allocSamples.count = 0U;
+    s_freeSamples.count  = 0U;
+    *fragMean            = 0.0;
+    *fragMax             = 0.0;
+
+    for (i = 0U; i < s_traceCount; i++)
+    {
+        event = &s_trace[i];
+        if (event->size != 0U)
+        {
+            start               = BENCH_GetNs();
+            s_buffer[event->id] = MEM_BufferAlloc(event->size);
+            BENCH_Record(&s_allocSamples, BENCH_GetNs() - start);
+
+            if (s_buffer[event->id] != NULL)
+            {
+                *ok = *ok && (((uintptr_t)s_buffer[event->id] & 3U) == 0U) &&
+                      (((uintptr_t)s_buffer[event->id] + event->size) <= ((uintptr_t)memHeapEnd + 1U));
+                (void)memset(s_buffer[event->id], (int)event->id, event->size);
+                s_bufferSize[event->id] = event->size;
+                blocks++;
+            }
+            else
+            {
+                failed++;
+            }
+        }
+        else if (s_buffer[event->id] != NULL)
+        {
+            for (n = 0U; n < s_bufferSize[event->id]; n++)
+            {
+                *ok = *ok && (s_buffer[event->id][n] == (uint8_t)event->id);
+            }
+
+            start = BENCH_GetNs();
+            *ok   = (MEM_BufferFree(s_buffer[event->id]) == kStatus_MemSuccess) && *ok;
+            BENCH_Record(&s_freeSamples, BENCH_GetNs() - start);
+
+            s_buffer[event->id] = NULL;
+            blocks--;
+        }
+        else
+        {
+            /* The allocation failed. */
+        }
+
+        if (probe && ((i % BENCH_SAMPLE_EVERY) == 0U) && (blocks > 0U))
+        {
+            freeSize = MEM_GetFreeHeapSize();
+            frag     = 1.0 - ((double)BENCH_Largest() / (double)freeSize);
+            /* The probe frees what it takes, the list allocator may meld more free blocks in the top. */
+            *ok = *ok && (MEM_GetFreeHeapSize() >= freeSize);
+            *fragMean += frag;
+            *fragMax = (frag > *fragMax) ? frag : *fragMax;
+            samples++;
+        }
+    }
+    *fragMean = (samples > 0U) ? (*fragMean / (double)samples) : 0.0;
+    *ok       = *ok && (blocks == 0U);
+
+    return failed;
+}
+
+static void BENCH_Trace(const char *name, uint32_t heapFree)
+{
+    uint32_t failed;
+    uint32_t lowWatermark;
+    uint32_t freeSize;
+    double fragMean;
+    double fragMax;
+    bool ok = true;
+
+    (void)MEM_ResetFreeHeapSizeLowWaterMark();
+    failed       = BENCH_Replay(false, &fragMean, &fragMax, &ok);
+    lowWatermark = MEM_GetFreeHeapSizeLowWaterMark();
+    freeSize     = MEM_GetFreeHeapSize();
+#if (defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0))
+    /* Every free block melds with its neighbours, all of the heap is free again. */
+    ok = ok && (freeSize == heapFree);
+#endif
+
+    (void)printf("%-10s %-8s", BENCH_MEMORY_NAME, name);
+    BENCH_Report("alloc", &s_allocSamples);
+    BENCH_Report("free", &s_freeSamples);
+    (void)printf("  %s\r\n", ok ? "ok" : "FAILED");
+
+    ok = true;
+    (void)BENCH_Replay(true, &fragMean, &fragMax, &ok);
+    (void)printf(
+        "%-10s %-8s  failed %5u  low watermark %5u  free after %5u of %5u  fragmentation mean %4.1f %%  max %4.1f %%"
+        "  %s\r\n",
+        BENCH_MEMORY_NAME, name, (unsigned int)failed, (unsigned int)lowWatermark, (unsigned int)freeSize,
+        (unsigned int)heapFree, fragMean * 100.0, fragMax * 100.0, ok ? "ok" : "FAILED");
+}
+
+int main(void)
+{
+    uint32_t heapFree;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    memHeapEnd = (uint32_t)(uintptr_t)&s_heap[BENCH_HEAP_SIZE / 4U] - 1U;
+    if (MEM_Init() != kStatus_MemSuccess)
+    {
+        (void)printf("%-10s MEM_Init  FAILED\r\n", BENCH_MEMORY_NAME);
+        return 1;
+    }
+    heapFree = MEM_GetFreeHeapSize();
+
+    BENCH_TraceObjects();
+    BENCH_Trace("objects", heapFree);
+    BENCH_TraceMessages();
+    BENCH_Trace("messages", heapFree);
+    BENCH_TraceRandom();
+    BENCH_Trace("random", heapFree);
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,390 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Feeds a synthetic edge stream of a tachometer and a quadrature encoder through the PINT model. The
+ * PINT driver callbacks, decoding every edge in the interrupt, run against the capture ring drained
+ * in batches and against the quadrature decoding of the pattern match engine. Reports the handler
+ * and drain cycles per edge, the edge rate the core sustains with them, and checks the tachometer
+ * frequency and the encoder position against the stream. A last run drains too late for the ring
+ * and checks that the dropped edges are reported.
+ */
+
+#include <stdio.h>
+
+#include "fsl_hostsim_models.h"
+#include "fsl_pint_capture.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_COUNTER_HZ     (12000000U) /* SCTimer counter, the core clock */
+#define BENCH_STEP           (600U)      /* Ticks between two points of the stream */
+#define BENCH_TACH_HALF      (3000U)     /* Ticks of a tachometer half period, 2 kHz */
+#define BENCH_ENCODER_STEP   (1200U)     /* Ticks of a quadrature state, 2.5 kHz */
+#define BENCH_FORWARD_STEPS  (4000U)     /* Quadrature states forward, then the same time reverse */
+#define BENCH_REVERSE_STEPS  (1600U)
+#define BENCH_POINTS         (((BENCH_FORWARD_STEPS + BENCH_REVERSE_STEPS) * BENCH_ENCODER_STEP) / BENCH_STEP)
+#define BENCH_TACH_INPUT     (1U << 0U)  /* PINTSEL0 */
+#define BENCH_PHASE_A_INPUT  (1U << 1U)  /* PINTSEL1 */
+#define BENCH_PHASE_B_INPUT  (1U << 2U)  /* PINTSEL2 */
+#define BENCH_RING_SIZE      (64U)
+#define BENCH_BATCH          (32U)       /* Events drained at a time */
+#define BENCH_LATE_POINTS    (128U)      /* Points between the drains of the late run, about 77 edges */
+#define BENCH_TACH_MHZ       ((BENCH_COUNTER_HZ * 1000ULL) / (2U * BENCH_TACH_HALF))
+
+typedef struct _bench_result
+{
+    uint32_t edges;
+    uint32_t events;
+    uint64_t handlerCycles;
+    uint64_t drainCycles;
+    uint32_t traps;
+    uint32_t irqs;
+    uint32_t frequency;
+    int32_t position;
+    int32_t expected;
+    uint32_t overflows;
+} bench_result_t;
+
+typedef enum _bench_mode
+{
+    kBENCH_ModeCallback,
+    kBENCH_ModeCapture,
+    kBENCH_ModePattern,
+} bench_mode_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Quadrature states in forward order, A leads B. */
+static const uint8_t s_quadrature[4] = {0U, BENCH_PHASE_A_INPUT, BENCH_PHASE_A_INPUT | BENCH_PHASE_B_INPUT,
+                                        BENCH_PHASE_B_INPUT};
+
+static uint8_t s_stream[BENCH_POINTS];
+static hostsim_pint_model_t s_pintModel;
+
+static pint_capture_event_t s_ring[BENCH_RING_SIZE];
+static pint_capture_handle_t s_handle;
+
+static volatile bench_mode_t s_mode;
+static uint64_t s_handlerCycles;
+
+/* State of the callback decoding. */
+static uint32_t s_cbLastTimestamp;
+static uint32_t s_cbPeriodSum;
+static uint32_t s_cbPeriodCount;
+static bool s_cbHasTimestamp;
+static uint8_t s_cbLevels;
+static int32_t s_cbPosition;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* The inputs at each point of the stream: the tachometer toggles, the encoder turns forward and back. */
+static void BENCH_RecordStream(void)
+{
+    uint32_t point;
+    uint32_t ticks;
+    uint32_t step;
+    uint32_t state;
+    uint8_t inputs;
+
+    for (point = 0U; point < BENCH_POINTS; point++)
+    {
+        ticks  = (point + 1U) * BENCH_STEP;
+        step   = ticks / BENCH_ENCODER_STEP;
+        state  = (step <= BENCH_FORWARD_STEPS) ? step : ((2U * BENCH_FORWARD_STEPS) - step);
+        inputs = s_quadrature[state & 3U];
+        if (((ticks / BENCH_TACH_HALF) & 1U) != 0U)
+        {
+            inputs |= (uint8_t)BENCH_TACH_INPUT;
+        }
+        s_stream[point] = inputs;
+    }
+}
+
+/* Edges of the stream on the captured inputs. */
+static uint32_t BENCH_CountEdges(uint8_t inputs)
+{
+    uint32_t edges = 0U;
+    uint8_t last   = 0U;
+    uint32_t point;
+
+    for (point = 0U; point < BENCH_POINTS; point++)
+    {
+        edges += (uint32_t)__builtin_popcount((s_stream[point] ^ last) & inputs);
+        last = s_stream[point];
+    }
+
+    return edges;
+}
+
+/* The driver callback of the application that decodes every edge in the interrupt. */
+static void BENCH_Callback(pint_pin_int_t pintr, uint32_t pmatchStatus)
+{
+    uint32_t timestamp = SCT0->COUNT;
+    uint8_t levels;
+    uint8_t changed;
+
+    (void)pmatchStatus;
+
+    if (pintr == kPINT_PinInt0)
+    {
+        if (s_cbHasTimestamp)
+        {
+            s_cbPeriodSum += timestamp - s_cbLastTimestamp;
+            s_cbPeriodCount++;
+        }
+        s_cbLastTimestamp = timestamp;
+        s_cbHasTimestamp  = true;
+        return;
+    }
+
+    /* The edge flags give the new level of the phase. */
+    levels  = s_cbLevels;
+    changed = (uint8_t)(1U << (uint32_t)pintr);
+    if ((PINT->RISE & changed) != 0U)
+    {
+        levels |= changed;
+    }
+    else
+    {
+        levels &= (uint8_t)~changed;
+    }
+
+    if (pintr == kPINT_PinInt1)
+    {
+        s_cbPosition += (((levels >> 1U) & 1U) != ((levels >> 2U) & 1U)) ? 1 : -1;
+    }
+    else
+    {
+        s_cbPosition += (((levels >> 1U) & 1U) == ((levels >> 2U) & 1U)) ? 1 : -1;
+    }
+    s_cbLevels = levels;
+}
+
+void PIN_INT0_DriverIRQHandler(void);
+void PIN_INT1_DriverIRQHandler(void);
+void PIN_INT2_DriverIRQHandler(void);
+
+static void BENCH_HandleIRQ(pint_pin_int_t pintr)
+{
+    uint64_t start = HOSTSIM_GetCycles();
+
+    if (s_mode == kBENCH_ModeCallback)
+    {
+        switch (pintr)
+        {
+            case kPINT_PinInt0:
+                PIN_INT0_DriverIRQHandler();
+                break;
+            case kPINT_PinInt1:
+                PIN_INT1_DriverIRQHandler();
+                break;
+            default:
+                PIN_INT2_DriverIRQHandler();
+                break;
+        }
+    }
+    else
+    {
+        PINT_CaptureHandleIRQ(PINT, &s_handle, pintr);
+    }
+    s_handlerCycles += HOSTSIM_GetCycles() - start;
+}
+
+void PIN_INT0_IRQHandler(void)
+{
+    BENCH_HandleIRQ(kPINT_PinInt0);
+}
+
+void PIN_INT1_IRQHandler(void)
+{
+    BENCH_HandleIRQ(kPINT_PinInt1);
+}
+
+void PIN_INT2_IRQHandler(void)
+{
+    BENCH_HandleIRQ(kPINT_PinInt2);
+}
+
+void PIN_INT3_IRQHandler(void)
+{
+    BENCH_HandleIRQ(kPINT_PinInt3);
+}
+
+/* Fresh PINT model, the SCTimer counter is plain memory written with the time of each point. */
+static void BENCH_InitPint(bench_mode_t mode)
+{
+    HOSTSIM_DetachModel(&s_pintModel.model);
+    HOSTSIM_PintModelInit(&s_pintModel, PINT);
+    PINT_Init(PINT);
+
+    SCT0->COUNT       = 0U;
+    s_mode            = mode;
+    s_handlerCycles   = 0U;
+    s_cbHasTimestamp  = false;
+    s_cbPeriodSum     = 0U;
+    s_cbPeriodCount   = 0U;
+    s_cbLevels        = 0U;
+    s_cbPosition      = 0;
+}
+
+/* Plays the stream, the capture runs drain every batch events or every drainPoints points. */
+static void BENCH_Play(bench_result_t *result, uint32_t batch, uint32_t drainPoints)
+{
+    uint64_t start;
+    uint32_t point;
+
+    for (point = 0U; point < BENCH_POINTS; point++)
+    {
+        SCT0->COUNT = (point + 1U) * BENCH_STEP;
+        HOSTSIM_PintModelSetInputs(&s_pintModel, s_stream[point]);
+
+        if ((s_mode != kBENCH_ModeCallback) &&
+            ((drainPoints != 0U) ? (((point + 1U) % drainPoints) == 0U) : (PINT_CaptureGetCount(&s_handle) >= batch)))
+        {
+            start = HOSTSIM_GetCycles();
+            result->events += PINT_CaptureProcess(&s_handle);
+            result->drainCycles += HOSTSIM_GetCycles() - start;
+        }
+    }
+
+    if (s_mode != kBENCH_ModeCallback)
+    {
+        start = HOSTSIM_GetCycles();
+        result->events += PINT_CaptureProcess(&s_handle);
+        result->drainCycles += HOSTSIM_GetCycles() - start;
+    }
+}
+
+static void BENCH_Report(const char *name, bench_result_t *result, const hostsim_stats_t *start)
+{
+    hostsim_stats_t stats;
+    double handler;
+    double drain;
+
+    HOSTSIM_GetStats(&stats);
+    result->handlerCycles = s_handlerCycles;
+    result->traps         = stats.trapCount - start->trapCount;
+    result->irqs          = stats.irqCount - start->irqCount;
+    handler               = (double)result->handlerCycles / (double)result->edges;
+    drain                 = (double)result->drainCycles / (double)result->edges;
+
+    /* The sustained rate spends all cycles in the handler and the drain, a burst only in the handler. */
+    (void)printf("%-16s %6u edges %6.1f irq + %5.1f drain cycles/edge %5.2f traps/edge  "
+                 "burst %5.0f kHz sustained %5.0f kHz  tach %7u mHz  position %5d/%5d  lost %4u  %s\r\n",
+                 name, (unsigned int)result->edges, handler, drain, (double)result->traps / (double)result->edges,
+                 (double)SystemCoreClock / handler / 1000.0, (double)SystemCoreClock / (handler + drain) / 1000.0,
+                 (unsigned int)result->frequency, (int)result->position, (int)result->expected,
+                 (unsigned int)result->overflows,
+                 ((result->frequency == (uint32_t)BENCH_TACH_MHZ) && (result->position == result->expected)) ?
+                     "ok" :
+                     ((result->overflows != 0U) ? "dropped" : "errors"));
+}
+
+static void BENCH_Callbacks(void)
+{
+    bench_result_t result = {0};
+    hostsim_stats_t start;
+
+    BENCH_InitPint(kBENCH_ModeCallback);
+    PINT_PinInterruptConfig(PINT, kPINT_PinInt0, kPINT_PinIntEnableRiseEdge, BENCH_Callback);
+    PINT_PinInterruptConfig(PINT, kPINT_PinInt1, kPINT_PinIntEnableBothEdges, BENCH_Callback);
+    PINT_PinInterruptConfig(PINT, kPINT_PinInt2, kPINT_PinIntEnableBothEdges, BENCH_Callback);
+    PINT_EnableCallback(PINT);
+
+    HOSTSIM_GetStats(&start);
+    BENCH_Play(&result, 0U, 0U);
+
+    PINT_DisableCallback(PINT);
+    result.edges =
+        BENCH_CountEdges(BENCH_PHASE_A_INPUT | BENCH_PHASE_B_INPUT) + (BENCH_CountEdges(BENCH_TACH_INPUT) / 2U);
+    result.frequency = (uint32_t)(((uint64_t)s_cbPeriodCount * BENCH_COUNTER_HZ * 1000U) / s_cbPeriodSum);
+    result.position  = s_cbPosition;
+    result.expected  = (int32_t)BENCH_FORWARD_STEPS - (int32_t)BENCH_REVERSE_STEPS;
+    BENCH_Report("callbacks", &result, &start);
+    PINT_Deinit(PINT);
+}
+
+static void BENCH_Capture(const char *name, uint32_t drainPoints)
+{
+    bench_result_t result = {0};
+    pint_capture_config_t config;
+    pint_capture_stats_t stats;
+    hostsim_stats_t start;
+
+    BENCH_InitPint(kBENCH_ModeCapture);
+    PINT_CaptureGetDefaultConfig(&config);
+    (void)PINT_CaptureCreateHandle(PINT, &s_handle, &config, s_ring, BENCH_RING_SIZE);
+    (void)PINT_CaptureConfigPeriod(PINT, &s_handle, kPINT_PinInt0);
+    (void)PINT_CaptureConfigQuadrature(PINT, &s_handle, kPINT_PinInt1, kPINT_PinInt2, 0U);
+
+    HOSTSIM_GetStats(&start);
+    BENCH_Play(&result, BENCH_BATCH, drainPoints);
+
+    PINT_CaptureDisableChannel(PINT, &s_handle, kPINT_PinInt0);
+    PINT_CaptureDisableChannel(PINT, &s_handle, kPINT_PinInt1);
+    PINT_CaptureDisableChannel(PINT, &s_handle, kPINT_PinInt2);
+    PINT_CaptureGetStats(&s_handle, &stats);
+    result.edges =
+        BENCH_CountEdges(BENCH_PHASE_A_INPUT | BENCH_PHASE_B_INPUT) + (BENCH_CountEdges(BENCH_TACH_INPUT) / 2U);
+    result.frequency = PINT_CaptureGetFrequency(&s_handle, kPINT_PinInt0, BENCH_COUNTER_HZ);
+    result.position  = PINT_CaptureGetPosition(&s_handle);
+    result.expected  = (int32_t)BENCH_FORWARD_STEPS - (int32_t)BENCH_REVERSE_STEPS;
+    result.overflows = stats.overflows;
+    BENCH_Report(name, &result, &start);
+    PINT_Deinit(PINT);
+}
+
+static void BENCH_Pattern(void)
+{
+    bench_result_t result = {0};
+    pint_capture_config_t config;
+    pint_capture_stats_t stats;
+    hostsim_stats_t start;
+
+    BENCH_InitPint(kBENCH_ModePattern);
+    PINT_CaptureGetDefaultConfig(&config);
+    (void)PINT_CaptureCreateHandle(PINT, &s_handle, &config, s_ring, BENCH_RING_SIZE);
+    PINT_CaptureConfigQuadraturePattern(PINT, &s_handle, kPINT_PatternMatchInp1Src, kPINT_PatternMatchInp2Src);
+
+    HOSTSIM_GetStats(&start);
+    BENCH_Play(&result, BENCH_BATCH, 0U);
+
+    PINT_CaptureGetStats(&s_handle, &stats);
+    PINT_PatternMatchDisable(PINT);
+    /* The interrupts are the rising edges of phase A, the tachometer is not captured. */
+    result.edges     = BENCH_CountEdges(BENCH_PHASE_A_INPUT) / 2U;
+    result.frequency = (uint32_t)BENCH_TACH_MHZ;
+    result.position  = PINT_CaptureGetPosition(&s_handle);
+    result.expected  = ((int32_t)BENCH_FORWARD_STEPS - (int32_t)BENCH_REVERSE_STEPS) / 4;
+    result.overflows = stats.overflows;
+    BENCH_Report("pattern match", &result, &start);
+    PINT_Deinit(PINT);
+}
+
+int main(void)
+{
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    BENCH_RecordStream();
+
+    BENCH_Callbacks();
+    BENCH_Capture("capture ring", 0U);
+    BENCH_Pattern();
+    BENCH_Capture("capture late", BENCH_LATE_POINTS);
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
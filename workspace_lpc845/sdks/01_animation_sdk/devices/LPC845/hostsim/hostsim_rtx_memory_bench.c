@@ -0,0 +1,584 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Replays allocation traces against the RTX dynamic memory of OS_DYNAMIC_MEM_SIZE and measures the
+ * time distribution of osRtxMemoryAlloc and osRtxMemoryFree, then reports the fragmentation: the
+ * failed allocations and the largest block that could be allocated against the free memory, sampled
+ * along the trace. The traces are generated once and replayed the same for each allocator:
+ *
+ *   objects   kernel objects, a control block with a stack or queue data, deleted in random order
+ *   messages  variable sized messages freed in the order they were sent, and a few long-lived buffers
+ *   random    random sizes up to 2 KiB freed in random order
+ *
+ * The contents of every block are checked when it is freed, the used and max used statistics against
+ * the blocks alive. The kernel then creates and deletes threads and message queues in the dynamic
+ * memory. Built once per allocator, see OS_MEMORY_TLSF. The first-fit block header holds a pointer and
+ * takes 16 bytes on the host instead of 8, its used memory is higher than on the target.
+ *
+ * The bench acts as the running thread, see rtx/rtx_core_host.h.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fsl_hostsim.h"
+#include "cmsis_os2.h"
+#include "rtx_os.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_POOL_SIZE    (32768U)
+#define BENCH_EVENTS       (200000U)
+#define BENCH_IDS          (1024U)
+#define BENCH_FILL         ((BENCH_POOL_SIZE * 7U) / 10U)
+#define BENCH_SAMPLE_EVERY (1000U)
+#define BENCH_KERNEL_OPS   (4000U)
+#define BENCH_KERNEL_SLOTS (8U)
+
+/*
+ * Max used memory, the info word of the last block header. The first-fit header links the blocks with a
+ * pointer and takes 16 bytes on the host instead of 8, the TLSF header links them with offsets.
+ */
+#if (defined(OS_MEMORY_TLSF) && (OS_MEMORY_TLSF != 0))
+#define BENCH_MEMORY_NAME "tlsf"
+#define BENCH_MAX_USED(mem, size) ((uint32_t *)(void *)((uint8_t *)(mem) + (size) - 4U))
+#else
+#define BENCH_MEMORY_NAME "first"
+#define BENCH_MAX_USED(mem, size) ((uint32_t *)(void *)((uint8_t *)(mem) + (size) - sizeof(void *)))
+#endif
+
+/* Trace event, the allocation of a block of size bytes or the free of the block if size is 0. */
+typedef struct _bench_event
+{
+    uint16_t id;
+    uint16_t type;
+    uint32_t size;
+} bench_event_t;
+
+typedef struct _bench_samples
+{
+    uint32_t count;
+    uint32_t ns[BENCH_EVENTS];
+} bench_samples_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/* Memory functions of rtx_lib.h, the first-fit ones of rtx_memory.c or the TLSF ones. */
+extern uint32_t osRtxMemoryInit(void *mem, uint32_t size);
+extern void *osRtxMemoryAlloc(void *mem, uint32_t size, uint32_t type);
+extern uint32_t osRtxMemoryFree(void *mem, void *block);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static uint64_t s_pool[BENCH_POOL_SIZE / 8U];
+
+static bench_event_t s_trace[BENCH_EVENTS];
+static uint32_t s_traceCount;
+
+/* Blocks alive in the trace generator and in the replay. */
+static uint16_t s_live[BENCH_IDS];
+static uint32_t s_liveCount;
+static uint32_t s_liveBytes;
+static uint32_t s_liveSize[BENCH_IDS];
+static uint8_t *s_block[BENCH_IDS];
+static uint32_t s_blockSize[BENCH_IDS];
+
+static bench_samples_t s_allocSamples;
+static bench_samples_t s_freeSamples;
+
+static uint32_t s_errors;
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t BENCH_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+/* Called by the kernel instead of the endless loop of RTX_Config.c. */
+uint32_t osRtxErrorNotify(uint32_t code, void *object_id)
+{
+    (void)code;
+    (void)object_id;
+
+    s_errors++;
+
+    return 0U;
+}
+
+static void BENCH_Thread(void *argument)
+{
+    (void)argument;
+}
+
+/* Used memory, the second word of the pool header of both allocators. */
+static uint32_t BENCH_Used(const void *mem)
+{
+    return ((const uint32_t *)mem)[1];
+}
+
+/* Memory taken by a block of size bytes in the model of the generator, the header and 8-byte steps. */
+static uint32_t BENCH_ModelSize(uint32_t size)
+{
+    return (size + 8U + 7U) & ~7U;
+}
+
+static void BENCH_TraceAlloc(uint32_t size, uint32_t type)
+{
+    uint16_t id = 0U;
+
+    /* The lowest id not alive, the ids of the replay index the blocks. */
+    while (s_liveSize[id] != 0U)
+    {
+        id++;
+    }
+
+    s_live[s_liveCount++] = id;
+    s_liveSize[id]        = size;
+    s_liveBytes += BENCH_ModelSize(size);
+
+    s_trace[s_traceCount].id     = id;
+    s_trace[s_traceCount].type   = (uint16_t)type;
+    s_trace[s_traceCount++].size = size;
+}
+
+/* Frees the alive block at the index, the order of the others is kept. */
+static void BENCH_TraceFree(uint32_t index)
+{
+    uint16_t id = s_live[index];
+
+    s_liveBytes -= BENCH_ModelSize(s_liveSize[id]);
+    s_liveSize[id] = 0U;
+    (void)memmove(&s_live[index], &s_live[index + 1U], (s_liveCount - index - 1U) * sizeof(s_live[0]));
+    s_liveCount--;
+
+    s_trace[s_traceCount].id     = id;
+    s_trace[s_traceCount].type   = 0U;
+    s_trace[s_traceCount++].size = 0U;
+}
+
+/* A new block of the size is allocated if it fits below the fill level, else a block is freed. */
+static bool BENCH_TraceRoom(uint32_t size)
+{
+    return (s_liveCount < (BENCH_IDS - 2U)) && ((s_liveBytes + BENCH_ModelSize(size)) <= BENCH_FILL) &&
+           ((s_liveCount == 0U) || ((BENCH_Random() % 8U) != 0U));
+}
+
+static void BENCH_TraceBegin(void)
+{
+    s_traceCount = 0U;
+    s_liveCount  = 0U;
+    s_liveBytes  = 0U;
+    (void)memset(s_liveSize, 0, sizeof(s_liveSize));
+}
+
+/* Frees the blocks still alive so that the replay ends with the pool as initialized. */
+static void BENCH_TraceEnd(void)
+{
+    while (s_liveCount > 0U)
+    {
+        BENCH_TraceFree(0U);
+    }
+}
+
+/* Control blocks of 40 to 100 bytes, a stack of 256 to 1536 bytes or queue data of 64 to 512 bytes. */
+static void BENCH_TraceObjects(void)
+{
+    uint32_t size;
+
+    BENCH_TraceBegin();
+    while (s_traceCount < (BENCH_EVENTS - BENCH_IDS - 2U))
+    {
+        size = 40U + ((BENCH_Random() % 16U) * 4U);
+        if (BENCH_TraceRoom(size + 1536U))
+        {
+            BENCH_TraceAlloc(size, 1U);
+            size = ((BENCH_Random() % 2U) == 0U) ? (256U + ((BENCH_Random() % 11U) * 128U)) :
+                                                   (64U + ((BENCH_Random() % 57U) * 8U));
+            BENCH_TraceAlloc(size, 0U);
+        }
+        else
+        {
+            /* The object of a random control block, its data follows it. */
+            size = (BENCH_Random() % (s_liveCount / 2U)) * 2U;
+            BENCH_TraceFree(size + 1U);
+            BENCH_TraceFree(size);
+        }
+    }
+    BENCH_TraceEnd();
+}
+
+/* Messages of 8 to 256 bytes freed in order, one in 64 events a buffer of 1 to 4 KiB comes or goes. */
+static void BENCH_TraceMessages(void)
+{
+    uint32_t buffers = 0U;
+    uint32_t size;
+    uint32_t i;
+
+    BENCH_TraceBegin();
+    while (s_traceCount < (BENCH_EVENTS - BENCH_IDS - 2U))
+    {
+        if ((BENCH_Random() % 64U) == 0U)
+        {
+            size = 1024U + ((BENCH_Random() % 25U) * 128U);
+            if ((buffers < 4U) && BENCH_TraceRoom(size))
+            {
+                BENCH_TraceAlloc(size, 0U);
+                buffers++;
+            }
+            else if (buffers > 0U)
+            {
+                /* The oldest buffer. */
+                i = 0U;
+                while (s_liveSize[s_live[i]] < 1024U)
+                {
+                    i++;
+                }
+                BENCH_TraceFree(i);
+                buffers--;
+            }
+            else
+            {
+                /* No room for a buffer. */
+            }
+        }
+        else
+        {
+            size = 8U + (BENCH_Random() % 249U);
+            if (BENCH_TraceRoom(size) && ((s_liveCount < 8U) || ((BENCH_Random() % 2U) == 0U)))
+            {
+                BENCH_TraceAlloc(size, 0U);
+            }
+            else
+            {
+                /* The oldest message. */
+                i = 0U;
+                while ((i < s_liveCount) && (s_liveSize[s_live[i]] >= 1024U))
+                {
+                    i++;
+                }
+                if (i < s_liveCount)
+                {
+                    BENCH_TraceFree(i);
+                }
+            }
+        }
+    }
+    BENCH_TraceEnd();
+}
+
+/* Sizes of 1 to 2048 bytes, small ones more likely, freed in random order. */
+static void BENCH_TraceRandom(void)
+{
+    uint32_t size;
+
+    BENCH_TraceBegin();
+    while (s_traceCount < (BENCH_EVENTS - BENCH_IDS - 2U))
+    {
+        size = 1U + (BENCH_Random() % (8U << (BENCH_Random() % 9U)));
+        if (BENCH_TraceRoom(size))
+        {
+            BENCH_TraceAlloc(size, 0U);
+        }
+        else
+        {
+            BENCH_TraceFree(BENCH_Random() % s_liveCount);
+        }
+    }
+    BENCH_TraceEnd();
+}
+
+static void BENCH_Record(bench_samples_t *samples, uint64_t ns)
+{
+    if (samples->count < BENCH_EVENTS)
+    {
+        samples->ns[samples->count++] = (uint32_t)ns;
+    }
+}
+
+static int BENCH_Compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* The largest block that can be allocated, searched with allocations that are freed at once. */
+static uint32_t BENCH_Largest(void)
+{
+    uint32_t maxUsed = *BENCH_MAX_USED(s_pool, BENCH_POOL_SIZE);
+    uint32_t low     = 0U;
+    uint32_t high    = BENCH_POOL_SIZE;
+    uint32_t size;
+    void *block;
+
+    while (low < high)
+    {
+        size  = (low + high + 1U) / 2U;
+        block = osRtxMemoryAlloc(s_pool, size, 0U);
+        if (block != NULL)
+        {
+            (void)osRtxMemoryFree(s_pool, block);
+            low = size;
+        }
+        else
+        {
+            high = size - 1U;
+        }
+    }
+    *BENCH_MAX_USED(s_pool, BENCH_POOL_SIZE) = maxUsed;
+
+    return low;
+}
+
+static void BENCH_Report(const char *name, bench_samples_t *samples)
+{
+    uint64_t sum = 0U;
+    uint32_t i;
+
+    qsort(samples->ns, samples->count, sizeof(samples->ns[0]), BENCH_Compare);
+    for (i = 0U; i < samples->count; i++)
+    {
+        sum += samples->ns[i];
+    }
+
+    (void)printf("  %-5s mean %6.1f  p50 %5u  p99 %5u  max %6u ns", name, (double)sum / (double)samples->count,
+                 (unsigned int)samples->ns[samples->count / 2U],
+                 (unsigned int)samples->ns[(samples->count * 99U) / 100U],
+                 (unsigned int)samples->ns[samples->count - 1U]);
+}
+
+static void BENCH_Replay(const char *name)
+{
+    const bench_event_t *event;
+    uint32_t used;
+    uint32_t peak;
+    uint32_t blocks = 0U;
+    uint32_t failed = 0U;
+    uint32_t samples = 0U;
+    uint32_t unused;
+    double frag;
+    double fragSum = 0.0;
+    double fragMax = 0.0;
+    uint64_t start;
+    uint32_t i;
+    uint32_t n;
+    bool ok;
+
+    ok   = (osRtxMemoryInit(s_pool, BENCH_POOL_SIZE) == 1U);
+    used = BENCH_Used(s_pool);
+    peak = used;
+    (void)memset(s_block, 0, sizeof(s_block));
+    s_allocSamples.count = 0U;
+    s_freeSamples.count  = 0U;
+
+    for (i = 0U; i < s_traceCount; i++)
+    {
+        event = &s_trace[i];
+        if (event->size != 0U)
+        {
+            start = BENCH_GetNs();
+            s_block[event->id] = osRtxMemoryAlloc(s_pool, event->size, event->type);
+            BENCH_Record(&s_allocSamples, BENCH_GetNs() - start);
+
+            if (s_block[event->id] != NULL)
+            {
+                ok = ok && (((uintptr_t)s_block[event->id] & 7U) == 0U);
+                (void)memset(s_block[event->id], (int)event->id, event->size);
+                s_blockSize[event->id] = event->size;
+                blocks++;
+            }
+            else
+            {
+                failed++;
+            }
+        }
+        else if (s_block[event->id] != NULL)
+        {
+            for (n = 0U; n < s_blockSize[event->id]; n++)
+            {
+                ok = ok && (s_block[event->id][n] == (uint8_t)event->id);
+            }
+
+            start = BENCH_GetNs();
+            ok    = (osRtxMemoryFree(s_pool, s_block[event->id]) == 1U) && ok;
+            BENCH_Record(&s_freeSamples, BENCH_GetNs() - start);
+
+            s_block[event->id] = NULL;
+            blocks--;
+        }
+        else
+        {
+            /* The allocation failed. */
+        }
+
+        peak = (BENCH_Used(s_pool) > peak) ? BENCH_Used(s_pool) : peak;
+        if (((i % BENCH_SAMPLE_EVERY) == 0U) && (blocks > 0U))
+        {
+            unused = BENCH_POOL_SIZE - BENCH_Used(s_pool);
+            frag   = 1.0 - ((double)(BENCH_Largest() + 8U) / (double)unused);
+            fragSum += frag;
+            fragMax = (frag > fragMax) ? frag : fragMax;
+            samples++;
+        }
+    }
+
+    /* All blocks freed, the pool is as initialized and the max used memory is the peak. */
+    ok = ok && (blocks == 0U) && (BENCH_Used(s_pool) == used) && (*BENCH_MAX_USED(s_pool, BENCH_POOL_SIZE) == peak);
+
+    (void)printf("%-5s %-8s", BENCH_MEMORY_NAME, name);
+    BENCH_Report("alloc", &s_allocSamples);
+    BENCH_Report("free", &s_freeSamples);
+    (void)printf("  %s\r\n", ok ? "ok" : "FAILED");
+    (void)printf("%-5s %-8s  failed %5u  max used %5u of %5u  fragmentation mean %4.1f %%  max %4.1f %%\r\n",
+                 BENCH_MEMORY_NAME, name, (unsigned int)failed, (unsigned int)peak, (unsigned int)BENCH_POOL_SIZE,
+                 (fragSum * 100.0) / (double)samples, fragMax * 100.0);
+}
+
+/* Parameter checks that do not depend on the allocator. */
+static void BENCH_Checks(void)
+{
+    static uint64_t outside[4];
+    uint32_t used;
+    void *first;
+    void *block;
+    bool ok;
+
+    ok = (osRtxMemoryInit(s_pool, 12U) == 0U) && (osRtxMemoryInit(&((uint8_t *)s_pool)[4], 4096U) == 0U);
+    ok = ok && (osRtxMemoryInit(s_pool, BENCH_POOL_SIZE) == 1U);
+    used = BENCH_Used(s_pool);
+
+    ok    = ok && (osRtxMemoryAlloc(s_pool, 0U, 0U) == NULL) && (osRtxMemoryAlloc(s_pool, 8U, 4U) == NULL);
+    ok    = ok && (osRtxMemoryAlloc(s_pool, BENCH_POOL_SIZE, 0U) == NULL);
+    first = osRtxMemoryAlloc(s_pool, 100U, 0U);
+    block = osRtxMemoryAlloc(s_pool, 1U, 1U);
+    ok    = ok && (first != NULL) && (block != NULL) && (osRtxMemoryFree(s_pool, &outside[2]) == 0U);
+    ok    = ok && (osRtxMemoryFree(s_pool, (uint8_t *)block + 8U) == 0U);
+
+    /* A block freed twice, the first block of the first-fit list stays in it and is not checked. */
+    ok = ok && (osRtxMemoryFree(s_pool, block) == 1U) && (osRtxMemoryFree(s_pool, block) == 0U);
+    ok = ok && (osRtxMemoryFree(s_pool, first) == 1U);
+    ok = ok && (BENCH_Used(s_pool) == used) && (osRtxMemoryFree(s_pool, NULL) == 0U);
+
+    (void)printf("%-5s parameter checks  %s\r\n", BENCH_MEMORY_NAME, ok ? "ok" : "FAILED");
+}
+
+/* Threads with their stacks and message queues created and deleted in the dynamic memory. */
+static void BENCH_Kernel(void)
+{
+    osThreadAttr_t attr = {0};
+    osThreadId_t thread[BENCH_KERNEL_SLOTS] = {NULL};
+    osMessageQueueId_t mq[BENCH_KERNEL_SLOTS] = {NULL};
+    uint32_t used;
+    uint32_t op;
+    uint32_t slot;
+    bool ok;
+
+    (void)osKernelInitialize();
+    attr.priority = osPriorityHigh;
+    (void)osThreadNew(BENCH_Thread, NULL, &attr);
+    (void)osKernelStart();
+    used = BENCH_Used(osRtxInfo.mem.common);
+    ok   = (osRtxInfo.mem.common != NULL);
+
+    attr.priority = osPriorityLow;
+    for (op = 0U; op < BENCH_KERNEL_OPS; op++)
+    {
+        slot = BENCH_Random() % BENCH_KERNEL_SLOTS;
+        if ((BENCH_Random() % 2U) == 0U)
+        {
+            if (thread[slot] == NULL)
+            {
+                attr.stack_size = 256U + ((BENCH_Random() % 8U) * 128U);
+                thread[slot]    = osThreadNew(BENCH_Thread, NULL, &attr);
+                ok              = ok && (thread[slot] != NULL);
+            }
+            else
+            {
+                ok           = ok && (osThreadTerminate(thread[slot]) == osOK);
+                thread[slot] = NULL;
+            }
+        }
+        else
+        {
+            if (mq[slot] == NULL)
+            {
+                mq[slot] = osMessageQueueNew(1U + (BENCH_Random() % 8U), 4U + (BENCH_Random() % 32U), NULL);
+                ok       = ok && (mq[slot] != NULL);
+            }
+            else
+            {
+                ok       = ok && (osMessageQueueDelete(mq[slot]) == osOK);
+                mq[slot] = NULL;
+            }
+        }
+    }
+    for (slot = 0U; slot < BENCH_KERNEL_SLOTS; slot++)
+    {
+        if (thread[slot] != NULL)
+        {
+            (void)osThreadTerminate(thread[slot]);
+        }
+        if (mq[slot] != NULL)
+        {
+            (void)osMessageQueueDelete(mq[slot]);
+        }
+    }
+    ok = ok && (BENCH_Used(osRtxInfo.mem.common) == used);
+
+    (void)printf("%-5s kernel objects    %s\r\n", BENCH_MEMORY_NAME, ok ? "ok" : "FAILED");
+}
+
+int main(void)
+{
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    BENCH_Checks();
+
+    BENCH_TraceObjects();
+    BENCH_Replay("objects");
+    BENCH_TraceMessages();
+    BENCH_Replay("messages");
+    BENCH_TraceRandom();
+    BENCH_Replay("random");
+
+    BENCH_Kernel();
+
+    (void)printf("%-5s kernel errors %-6u  %s\r\n", BENCH_MEMORY_NAME, (unsigned int)s_errors,
+                 (s_errors == 0U) ? "ok" : "FAILED");
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,369 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Runs the RTX kernel on the host and measures the thread switches and wakeups with 4 to 64 ready
+ * threads of the same priority: resuming one more thread of that priority, round-robin yield
+ * between them and a semaphore handing over to a higher priority thread and back. Random resume,
+ * suspend and priority changes are checked against the ready list order of the list walk. Built
+ * once per ready list, see OS_THREAD_READY_BITMAP.
+ *
+ * The bench acts as the running thread, after a service call that switched threads it continues
+ * as the new running thread, see rtx/rtx_core_host.h. The thread functions never run.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "fsl_hostsim.h"
+#include "cmsis_os2.h"
+#include "rtx_os.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_READY_MAX     (64U)
+#define BENCH_CHECK_THREADS (24U)
+#define BENCH_CHECK_OPS     (20000U)
+#define BENCH_ITERATIONS    (200000U)
+#define BENCH_STACK_SIZE    (256U)
+#define BENCH_THREADS       (BENCH_READY_MAX + BENCH_CHECK_THREADS + 3U)
+
+#if (defined(OS_THREAD_READY_BITMAP) && (OS_THREAD_READY_BITMAP != 0))
+#define BENCH_READY_NAME "bitmap"
+#else
+#define BENCH_READY_NAME "list"
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static osRtxThread_t s_threadCb[BENCH_THREADS];
+static uint64_t s_threadStack[BENCH_THREADS][BENCH_STACK_SIZE / 8U];
+static uint32_t s_threadCount;
+
+static osThreadId_t s_ctrl;
+static osThreadId_t s_high;
+static osThreadId_t s_target;
+static osThreadId_t s_ready[BENCH_READY_MAX];
+static uint32_t s_readyCount;
+static osThreadId_t s_check[BENCH_CHECK_THREADS];
+static osSemaphoreId_t s_handover;
+
+/* Expected ready list, the threads plus the idle thread. */
+static osRtxThread_t *s_model[BENCH_THREADS + 1U];
+static uint32_t s_modelCount;
+
+static uint32_t s_errors;
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t BENCH_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+/* Called by the kernel instead of the endless loop of RTX_Config.c. */
+uint32_t osRtxErrorNotify(uint32_t code, void *object_id)
+{
+    (void)code;
+    (void)object_id;
+
+    s_errors++;
+
+    return 0U;
+}
+
+static void BENCH_Thread(void *argument)
+{
+    (void)argument;
+}
+
+static osThreadId_t BENCH_NewThread(const char *name, osPriority_t priority)
+{
+    osThreadAttr_t attr = {0};
+
+    attr.name       = name;
+    attr.cb_mem     = &s_threadCb[s_threadCount];
+    attr.cb_size    = sizeof(s_threadCb[0]);
+    attr.stack_mem  = s_threadStack[s_threadCount];
+    attr.stack_size = sizeof(s_threadStack[0]);
+    attr.priority   = priority;
+    s_threadCount++;
+
+    return osThreadNew(BENCH_Thread, NULL, &attr);
+}
+
+/* Linked both ways, all threads ready and sorted by priority, highest first. */
+static bool BENCH_ReadyListValid(void)
+{
+    osRtxThread_t *root = (osRtxThread_t *)(void *)&osRtxInfo.thread.ready;
+    osRtxThread_t *prev = root;
+    osRtxThread_t *thread;
+
+    for (thread = osRtxInfo.thread.ready.thread_list; thread != NULL; thread = thread->thread_next)
+    {
+        if ((thread->thread_prev != prev) || (thread->state != osRtxThreadReady) ||
+            ((prev != root) && (prev->priority < thread->priority)))
+        {
+            return false;
+        }
+        prev = thread;
+    }
+
+    return true;
+}
+
+static void BENCH_ModelLoad(void)
+{
+    osRtxThread_t *thread;
+
+    s_modelCount = 0U;
+    for (thread = osRtxInfo.thread.ready.thread_list; thread != NULL; thread = thread->thread_next)
+    {
+        s_model[s_modelCount++] = thread;
+    }
+}
+
+/* The thread goes behind all ready threads of the same or higher priority. */
+static void BENCH_ModelPut(osRtxThread_t *thread)
+{
+    uint32_t index = 0U;
+    uint32_t i;
+
+    while ((index < s_modelCount) && (s_model[index]->priority >= thread->priority))
+    {
+        index++;
+    }
+    for (i = s_modelCount; i > index; i--)
+    {
+        s_model[i] = s_model[i - 1U];
+    }
+    s_model[index] = thread;
+    s_modelCount++;
+}
+
+static void BENCH_ModelRemove(osRtxThread_t *thread)
+{
+    uint32_t index = 0U;
+
+    while ((index < s_modelCount) && (s_model[index] != thread))
+    {
+        index++;
+    }
+    for (; (index + 1U) < s_modelCount; index++)
+    {
+        s_model[index] = s_model[index + 1U];
+    }
+    s_modelCount--;
+}
+
+static bool BENCH_ModelMatches(void)
+{
+    osRtxThread_t *thread = osRtxInfo.thread.ready.thread_list;
+    uint32_t i;
+
+    for (i = 0U; i < s_modelCount; i++)
+    {
+        if (thread != s_model[i])
+        {
+            return false;
+        }
+        thread = thread->thread_next;
+    }
+
+    return (thread == NULL);
+}
+
+/* Hands over to the high priority thread and back, the control thread is preempted once. */
+static bool BENCH_Handover(void)
+{
+    bool ok;
+
+    (void)osSemaphoreRelease(s_handover);
+    ok = (osThreadGetId() == s_high) && (osRtxInfo.thread.ready.thread_list == (osRtxThread_t *)s_ctrl);
+    (void)osSemaphoreAcquire(s_handover, osWaitForever);
+
+    return ok && (osThreadGetId() == s_ctrl);
+}
+
+/* Random resume, suspend and priority changes of threads between low and high priority. */
+static void BENCH_Check(void)
+{
+    osRtxThread_t *thread;
+    osPriority_t priority;
+    uint32_t op;
+    uint32_t i;
+    bool ok;
+
+    BENCH_ModelLoad();
+    for (i = 0U; i < BENCH_CHECK_THREADS; i++)
+    {
+        s_check[i] = BENCH_NewThread("check", osPriorityLow + (BENCH_Random() % (osPriorityHigh - osPriorityLow + 1)));
+        BENCH_ModelPut((osRtxThread_t *)s_check[i]);
+    }
+    ok = BENCH_ReadyListValid() && BENCH_ModelMatches();
+
+    for (op = 0U; op < BENCH_CHECK_OPS; op++)
+    {
+        thread   = (osRtxThread_t *)s_check[BENCH_Random() % BENCH_CHECK_THREADS];
+        priority = osPriorityLow + (BENCH_Random() % (osPriorityHigh - osPriorityLow + 1));
+
+        switch (BENCH_Random() % 4U)
+        {
+            case 0U:
+                if (osThreadGetState(thread) == osThreadBlocked)
+                {
+                    (void)osThreadResume(thread);
+                    BENCH_ModelPut(thread);
+                }
+                break;
+            case 1U:
+                if (osThreadGetState(thread) == osThreadReady)
+                {
+                    (void)osThreadSuspend(thread);
+                    BENCH_ModelRemove(thread);
+                }
+                break;
+            case 2U:
+                if ((osThreadGetState(thread) == osThreadReady) && (priority != thread->priority))
+                {
+                    BENCH_ModelRemove(thread);
+                    (void)osThreadSetPriority(thread, priority);
+                    BENCH_ModelPut(thread);
+                }
+                else
+                {
+                    (void)osThreadSetPriority(thread, priority);
+                }
+                break;
+            default:
+                ok = ok && BENCH_Handover();
+                break;
+        }
+        ok = ok && BENCH_ReadyListValid() && BENCH_ModelMatches();
+    }
+
+    for (i = 0U; i < BENCH_CHECK_THREADS; i++)
+    {
+        (void)osThreadTerminate(s_check[i]);
+    }
+
+    (void)printf("%-6s ready list checks                   %s\r\n", BENCH_READY_NAME, ok ? "ok" : "FAILED");
+}
+
+static void BENCH_Report(const char *name, uint32_t ready, uint64_t ns, bool ok)
+{
+    (void)printf("%-6s %-8s %2u ready  %7.1f ns/op  %s\r\n", BENCH_READY_NAME, name, (unsigned int)ready,
+                 (double)ns / (double)BENCH_ITERATIONS, ok ? "ok" : "FAILED");
+}
+
+static void BENCH_Switch(uint32_t ready)
+{
+    osRtxThread_t *target = (osRtxThread_t *)s_target;
+    uint64_t start;
+    uint32_t i;
+    bool ok;
+
+    /*
+     * Ready threads of normal priority, only the target is suspended so that the wait list walk
+     * of osThreadSuspend costs the same for all counts.
+     */
+    while (s_readyCount < ready)
+    {
+        s_ready[s_readyCount++] = BENCH_NewThread("ready", osPriorityNormal);
+    }
+
+    /* Wakeup of one more thread of the same priority, it goes behind the others. */
+    (void)osThreadResume(s_target);
+    ok = (target->thread_prev->priority == osPriorityNormal) &&
+         (target->thread_next == (osRtxThread_t *)osRtxInfo.thread.idle);
+    (void)osThreadSuspend(s_target);
+    start = BENCH_GetNs();
+    for (i = 0U; i < BENCH_ITERATIONS; i++)
+    {
+        (void)osThreadResume(s_target);
+        (void)osThreadSuspend(s_target);
+    }
+    BENCH_Report("resume", ready, BENCH_GetNs() - start, ok && BENCH_ReadyListValid());
+
+    /* Round-robin between the ready threads in list order, the control thread steps aside. */
+    BENCH_ModelLoad();
+    (void)osThreadSuspend(s_ctrl);
+    ok    = (osThreadGetId() == s_model[0]);
+    start = BENCH_GetNs();
+    for (i = 1U; i <= BENCH_ITERATIONS; i++)
+    {
+        (void)osThreadYield();
+        ok = ok && (osThreadGetId() == s_model[i % ready]);
+    }
+    BENCH_Report("yield", ready, BENCH_GetNs() - start, ok && BENCH_ReadyListValid());
+    (void)osThreadResume(s_ctrl);
+
+    /* Hand over to the high priority thread and back. */
+    ok    = (osThreadGetId() == s_ctrl);
+    start = BENCH_GetNs();
+    for (i = 0U; i < BENCH_ITERATIONS; i++)
+    {
+        ok = BENCH_Handover() && ok;
+    }
+    BENCH_Report("handover", ready, BENCH_GetNs() - start, ok && BENCH_ReadyListValid());
+}
+
+int main(void)
+{
+    bool ok;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    (void)osKernelInitialize();
+    s_ctrl = BENCH_NewThread("ctrl", osPriorityRealtime);
+    (void)osKernelStart();
+    ok = (osThreadGetId() == s_ctrl);
+
+    /* The high priority thread runs at once and waits for the handover. */
+    s_handover = osSemaphoreNew(1U, 0U, NULL);
+    s_high     = BENCH_NewThread("high", osPriorityRealtime7);
+    ok         = ok && (osThreadGetId() == s_high);
+    (void)osSemaphoreAcquire(s_handover, osWaitForever);
+    ok = ok && (osThreadGetId() == s_ctrl);
+
+    s_target = BENCH_NewThread("target", osPriorityNormal);
+    (void)osThreadSuspend(s_target);
+    ok = ok && BENCH_ReadyListValid();
+    (void)printf("%-6s kernel start                        %s\r\n", BENCH_READY_NAME, ok ? "ok" : "FAILED");
+
+    BENCH_Check();
+    BENCH_Switch(4U);
+    BENCH_Switch(16U);
+    BENCH_Switch(64U);
+
+    (void)printf("%-6s kernel errors %-6u                %s\r\n", BENCH_READY_NAME, (unsigned int)s_errors,
+                 (s_errors == 0U) ? "ok" : "FAILED");
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,650 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Checks the SCTimer PWM waveform tables. The timing math runs against the exact values, the
+ * integer sine against libm. The events the waveform programs are evaluated clock by clock from
+ * the SCT registers for a set of duty cycles and for every row of a three-phase sine table, the
+ * active and dead times are compared with the requested ones. The DMA model has no hardware
+ * triggers, the descriptor ring is walked in software burst by burst like the DMA with destination
+ * wrap would. Reports the CPU work per PWM period of the sctimer_multi_channel_pwm way of updating
+ * the duty cycles against the table streamed by the DMA.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fsl_hostsim.h"
+#include "fsl_sctimer_pwm_wave.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_SCT_CLOCK      (30000000U)
+#define BENCH_DMA_CHANNEL    (1U) /* Any channel, INPUTMUX routes SCT DMA request 0 to it. */
+#define BENCH_RANDOM_DUTIES  (200U)
+#define BENCH_SIM_PERIODS    (3U)
+#define BENCH_MAX_TICKS      (4096U) /* Counter clocks of the longest simulated period. */
+#define BENCH_SINE_TOLERANCE (6)     /* Q15 LSB */
+#define BENCH_TABLE_STEPS    (300U)  /* Three link descriptors of 128 rows. */
+#define BENCH_AMPLITUDE      (29491U) /* 0.9 in Q15 */
+#define BENCH_UPDATE_PERIODS (2000U)
+
+typedef struct _bench_case
+{
+    const char *name;
+    sctimer_pwm_mode_t mode;
+    sctimer_pwm_level_select_t level;
+    uint32_t pwmFreq_Hz;
+    uint8_t outputCount;
+    bool complementary;
+    uint32_t deadTime_ns;
+    uint32_t prescale;
+    /* Expected timing. */
+    uint32_t periodTicks;
+    uint32_t deadTicks;
+    uint8_t rowWords;
+} bench_case_t;
+
+typedef struct _bench_result
+{
+    uint32_t rows;
+    uint32_t errors;
+    uint32_t maxError; /* Ticks of active time against the requested duty cycle. */
+    uint32_t minDead;
+} bench_result_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const bench_case_t s_cases[] = {
+    {"edge 3 pairs", kSCTIMER_EdgeAlignedPwm, kSCTIMER_HighTrue, 20000U, 6U, true, 500U, 0U, 1500U, 15U, 8U},
+    {"edge 6 single", kSCTIMER_EdgeAlignedPwm, kSCTIMER_LowTrue, 25000U, 6U, false, 0U, 0U, 1200U, 0U, 8U},
+    {"center 3 pairs", kSCTIMER_CenterAlignedPwm, kSCTIMER_HighTrue, 16000U, 6U, true, 1000U, 0U, 1876U, 30U, 8U},
+    {"center 3 single", kSCTIMER_CenterAlignedPwm, kSCTIMER_LowTrue, 10000U, 3U, false, 0U, 1U, 3000U, 0U, 4U},
+    {"edge 1 pair short", kSCTIMER_EdgeAlignedPwm, kSCTIMER_HighTrue, 750000U, 2U, true, 90U, 0U, 40U, 3U, 4U},
+    {"edge 1 single", kSCTIMER_EdgeAlignedPwm, kSCTIMER_HighTrue, 1000000U, 1U, false, 0U, 0U, 30U, 0U, 2U},
+};
+
+static const uint16_t s_edgeDuties[] = {0U, SCTIMER_PWM_WAVE_DUTY_FULL, 1U, 0x7FFFU, 0x4000U, 0x0010U, 0x7FF0U};
+
+DMA_ALLOCATE_LINK_DESCRIPTORS(s_descriptors, SCTIMER_PWM_WAVE_DESCRIPTOR_NUM(BENCH_TABLE_STEPS, 8U));
+
+static uint32_t s_table[BENCH_TABLE_STEPS * 8U];
+static uint32_t s_walked[8U];
+static uint8_t s_levels[BENCH_MAX_TICKS][SCTIMER_PWM_WAVE_MAX_OUTPUTS];
+
+static dma_handle_t s_dmaHandle;
+static sctimer_pwm_wave_handle_t s_waveHandle;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t BENCH_Random(uint32_t *state)
+{
+    *state = (*state * 1103515245U) + 12345U;
+    return *state >> 8U;
+}
+
+static uint32_t BENCH_Diff(uint32_t a, uint32_t b)
+{
+    return (a > b) ? (a - b) : (b - a);
+}
+
+static void BENCH_FillConfig(const bench_case_t *bench, sctimer_pwm_wave_config_t *config)
+{
+    SCTIMER_PwmWaveGetDefaultConfig(config);
+    config->mode          = bench->mode;
+    config->level         = bench->level;
+    config->pwmFreq_Hz    = bench->pwmFreq_Hz;
+    config->outputCount   = bench->outputCount;
+    config->complementary = bench->complementary;
+    config->deadTime_ns   = bench->deadTime_ns;
+}
+
+/* A fresh SCT and DMA, the registers without a model keep their values across SCTIMER_Init. */
+static status_t BENCH_CreateWave(const bench_case_t *bench)
+{
+    sctimer_config_t sctConfig;
+    sctimer_pwm_wave_config_t config;
+
+    (void)memset((void *)SCT0, 0, sizeof(SCT_Type));
+    SCTIMER_GetDefaultConfig(&sctConfig);
+    sctConfig.prescale_l = (uint8_t)bench->prescale;
+    (void)SCTIMER_Init(SCT0, &sctConfig);
+
+    DMA_Init(DMA0);
+    DMA_EnableChannel(DMA0, BENCH_DMA_CHANNEL);
+    DMA_CreateHandle(&s_dmaHandle, DMA0, BENCH_DMA_CHANNEL);
+
+    BENCH_FillConfig(bench, &config);
+    return SCTIMER_PwmWaveCreateHandle(SCT0, &s_waveHandle, &config, BENCH_SCT_CLOCK * (bench->prescale + 1U), NULL,
+                                       NULL, &s_dmaHandle, s_descriptors, ARRAY_SIZE(s_descriptors));
+}
+
+/*
+ * Runs the counter from the registers one clock at a time. The events at a counter value change the
+ * outputs from the next clock on, counting down reverses the actions of the outputs selected in
+ * OUTPUTDIRCTRL, RES resolves a set and a clear at the same clock. The counter bottom and the limit
+ * count as counting up.
+ */
+static uint32_t BENCH_Simulate(uint32_t periods)
+{
+    SCT_Type *base  = SCT0;
+    bool bidir      = ((base->CTRL & SCT_CTRL_BIDIR_L_MASK) != 0U);
+    uint32_t limit  = base->MATCH[0];
+    uint32_t period = bidir ? (2U * limit) : (limit + 1U);
+    uint32_t end    = periods * period;
+    uint32_t output = base->OUTPUT;
+    uint32_t ticks  = 0U;
+    uint32_t count  = 0U;
+    bool down       = false;
+    uint32_t set;
+    uint32_t clear;
+    uint32_t ev;
+    uint32_t o;
+    uint32_t res;
+
+    while (ticks < end)
+    {
+        if ((ticks / period) == (periods - 1U))
+        {
+            for (o = 0U; o < s_waveHandle.outputCount; o++)
+            {
+                s_levels[ticks % period][o] = (uint8_t)((output >> s_waveHandle.outputs[o]) & 1U);
+            }
+        }
+
+        set   = 0U;
+        clear = 0U;
+        for (ev = 0U; ev < FSL_FEATURE_SCT_NUMBER_OF_EVENTS; ev++)
+        {
+            if (((base->EV[ev].STATE & 1U) != 0U) &&
+                (base->MATCH[base->EV[ev].CTRL & SCT_EV_CTRL_MATCHSEL_MASK] == count))
+            {
+                for (o = 0U; o < FSL_FEATURE_SCT_NUMBER_OF_OUTPUTS; o++)
+                {
+                    bool reverse = down && (((base->OUTPUTDIRCTRL >> (2U * o)) & 3U) == 1U);
+                    if ((base->OUT[o].SET & (1UL << ev)) != 0U)
+                    {
+                        *(reverse ? &clear : &set) |= (1UL << o);
+                    }
+                    if ((base->OUT[o].CLR & (1UL << ev)) != 0U)
+                    {
+                        *(reverse ? &set : &clear) |= (1UL << o);
+                    }
+                }
+            }
+        }
+        for (o = 0U; o < FSL_FEATURE_SCT_NUMBER_OF_OUTPUTS; o++)
+        {
+            if ((((set & clear) >> o) & 1U) != 0U)
+            {
+                res = (base->RES >> (2U * o)) & 3U;
+                set &= ~(1UL << o);
+                clear &= ~(1UL << o);
+                if (res == 1U)
+                {
+                    set |= (1UL << o);
+                }
+                else if (res == 2U)
+                {
+                    clear |= (1UL << o);
+                }
+                else if (res == 3U)
+                {
+                    *((((output >> o) & 1U) != 0U) ? &clear : &set) |= (1UL << o);
+                }
+                else
+                {
+                    /* No change. */
+                }
+            }
+        }
+        output = (output | set) & ~clear;
+
+        ticks++;
+        if (!bidir)
+        {
+            count = (count == limit) ? 0U : (count + 1U);
+        }
+        else if (!down)
+        {
+            down  = (count == limit);
+            count = down ? (limit - 1U) : (count + 1U);
+        }
+        else
+        {
+            count--;
+            down = (count != 0U);
+        }
+    }
+
+    return period;
+}
+
+/* Plays one row from a fresh start and checks the last period against the duty cycles. */
+static void BENCH_CheckRow(const uint32_t *row, const uint16_t *duty, bench_result_t *result)
+{
+    const sctimer_pwm_wave_timing_t *timing = &s_waveHandle.timing;
+    uint32_t period;
+    uint32_t active[SCTIMER_PWM_WAVE_MAX_OUTPUTS];
+    uint32_t firstActive[SCTIMER_PWM_WAVE_MAX_OUTPUTS];
+    uint32_t activeLevel = (s_waveHandle.level == kSCTIMER_HighTrue) ? 1U : 0U;
+    uint32_t ideal;
+    uint32_t error;
+    uint32_t tolerance = (timing->mode == kSCTIMER_EdgeAlignedPwm) ? 1U : 2U;
+    uint32_t o;
+    uint32_t k;
+    uint32_t t;
+    uint32_t run;
+    uint32_t dead;
+    bool rowError = false;
+
+    if (SCTIMER_PwmWaveStart(SCT0, &s_waveHandle, row, 1U) != kStatus_Success)
+    {
+        result->errors++;
+        return;
+    }
+    SCTIMER_StopTimer(SCT0, (uint32_t)kSCTIMER_Counter_U);
+
+    /* The first period plays like the steady state, no glitch at the start. */
+    period = BENCH_Simulate(1U);
+    for (o = 0U; o < s_waveHandle.outputCount; o++)
+    {
+        firstActive[o] = 0U;
+        for (t = 0U; t < period; t++)
+        {
+            firstActive[o] += (s_levels[t][o] == activeLevel) ? 1U : 0U;
+        }
+    }
+    (void)SCTIMER_PwmWaveStart(SCT0, &s_waveHandle, row, 1U);
+    SCTIMER_StopTimer(SCT0, (uint32_t)kSCTIMER_Counter_U);
+    period = BENCH_Simulate(BENCH_SIM_PERIODS);
+    if (period != timing->periodTicks)
+    {
+        rowError = true;
+    }
+
+    for (o = 0U; o < s_waveHandle.outputCount; o++)
+    {
+        active[o] = 0U;
+        for (t = 0U; t < period; t++)
+        {
+            active[o] += (s_levels[t][o] == activeLevel) ? 1U : 0U;
+        }
+        if (active[o] != firstActive[o])
+        {
+            rowError = true;
+        }
+    }
+
+    for (k = 0U; k < timing->duties; k++)
+    {
+        o     = timing->complementary ? (2U * k) : k;
+        ideal = (uint32_t)(((uint64_t)duty[k] * timing->maxOnTicks + 0x4000U) >> 15U);
+        error = BENCH_Diff(active[o], ideal);
+        if ((duty[k] == 0U) || (duty[k] == SCTIMER_PWM_WAVE_DUTY_FULL))
+        {
+            /* Exactly off or on, the high side keeps its dead times. */
+            tolerance = 0U;
+        }
+        if (error > tolerance)
+        {
+            rowError = true;
+        }
+        if (error > result->maxError)
+        {
+            result->maxError = error;
+        }
+        tolerance = (timing->mode == kSCTIMER_EdgeAlignedPwm) ? 1U : 2U;
+
+        if (timing->complementary)
+        {
+            /* The low side fills the rest of the period but two dead times, never together with the high side. */
+            if ((active[o] + active[o + 1U]) != timing->maxOnTicks)
+            {
+                rowError = true;
+            }
+            dead = 0U;
+            run  = 0U;
+            for (t = 0U; t < (2U * period); t++)
+            {
+                uint8_t high = s_levels[t % period][o];
+                uint8_t low  = s_levels[t % period][o + 1U];
+                if ((high == activeLevel) && (low == activeLevel))
+                {
+                    rowError = true;
+                }
+                if ((high != activeLevel) && (low != activeLevel))
+                {
+                    run++;
+                }
+                else
+                {
+                    /* Runs of the second lap, complete on both ends. */
+                    if ((t >= period) && (run != 0U) && (run < timing->deadTicks))
+                    {
+                        rowError = true;
+                    }
+                    if ((t >= period) && (run != 0U) && ((result->minDead == 0U) || (run < result->minDead)))
+                    {
+                        result->minDead = run;
+                    }
+                    run = 0U;
+                }
+                if ((t < period) && (high != activeLevel) && (low != activeLevel))
+                {
+                    dead++;
+                }
+            }
+            if (dead != (2U * timing->deadTicks))
+            {
+                rowError = true;
+            }
+        }
+    }
+
+    result->rows++;
+    if (rowError)
+    {
+        result->errors++;
+    }
+}
+
+static void BENCH_Timing(void)
+{
+    sctimer_pwm_wave_config_t config;
+    sctimer_pwm_wave_timing_t timing;
+    uint32_t errors = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < ARRAY_SIZE(s_cases); i++)
+    {
+        BENCH_FillConfig(&s_cases[i], &config);
+        if ((SCTIMER_PwmWaveGetTiming(&config, BENCH_SCT_CLOCK, &timing) != kStatus_Success) ||
+            (timing.periodTicks != s_cases[i].periodTicks) || (timing.deadTicks != s_cases[i].deadTicks) ||
+            (timing.rowWords != s_cases[i].rowWords))
+        {
+            errors++;
+        }
+    }
+
+    /* Seven outputs, an odd number of pair outputs, dead times filling the period, no frequency. */
+    SCTIMER_PwmWaveGetDefaultConfig(&config);
+    config.outputCount = 7U;
+    errors += (SCTIMER_PwmWaveGetTiming(&config, BENCH_SCT_CLOCK, &timing) == kStatus_InvalidArgument) ? 0U : 1U;
+    SCTIMER_PwmWaveGetDefaultConfig(&config);
+    config.outputCount = 5U;
+    errors += (SCTIMER_PwmWaveGetTiming(&config, BENCH_SCT_CLOCK, &timing) == kStatus_InvalidArgument) ? 0U : 1U;
+    SCTIMER_PwmWaveGetDefaultConfig(&config);
+    config.pwmFreq_Hz  = 1000000U;
+    config.deadTime_ns = 500U;
+    errors += (SCTIMER_PwmWaveGetTiming(&config, BENCH_SCT_CLOCK, &timing) == kStatus_InvalidArgument) ? 0U : 1U;
+    config.mode = kSCTIMER_CenterAlignedPwm;
+    errors += (SCTIMER_PwmWaveGetTiming(&config, BENCH_SCT_CLOCK, &timing) == kStatus_InvalidArgument) ? 0U : 1U;
+    SCTIMER_PwmWaveGetDefaultConfig(&config);
+    config.pwmFreq_Hz = 0U;
+    errors += (SCTIMER_PwmWaveGetTiming(&config, BENCH_SCT_CLOCK, &timing) == kStatus_InvalidArgument) ? 0U : 1U;
+
+    (void)printf("%-20s %2u configurations, 5 invalid ones rejected  %s\r\n", "timing",
+                 (unsigned int)ARRAY_SIZE(s_cases), (errors == 0U) ? "ok" : "errors");
+}
+
+static void BENCH_Sine(void)
+{
+    uint32_t maxError = 0U;
+    uint32_t angle;
+    int32_t exact;
+    int32_t value;
+
+    for (angle = 0U; angle < SCTIMER_PWM_WAVE_TURN; angle++)
+    {
+        exact = (int32_t)lround(32768.0 * sin(2.0 * M_PI * (double)angle / (double)SCTIMER_PWM_WAVE_TURN));
+        value = SCTIMER_PwmWaveSin((uint16_t)angle);
+        if ((uint32_t)abs(value - exact) > maxError)
+        {
+            maxError = (uint32_t)abs(value - exact);
+        }
+    }
+
+    (void)printf("%-20s %5u angles max error %u LSB  %s\r\n", "sine", (unsigned int)SCTIMER_PWM_WAVE_TURN,
+                 (unsigned int)maxError, (maxError <= (uint32_t)BENCH_SINE_TOLERANCE) ? "ok" : "errors");
+}
+
+static void BENCH_Rows(const bench_case_t *bench)
+{
+    bench_result_t result = {0};
+    uint16_t duty[SCTIMER_PWM_WAVE_MAX_OUTPUTS];
+    uint32_t row[8];
+    uint32_t seed = 1U;
+    uint32_t v;
+    uint32_t k;
+
+    if (BENCH_CreateWave(bench) != kStatus_Success)
+    {
+        (void)printf("%-20s create failed  errors\r\n", bench->name);
+        return;
+    }
+
+    for (v = 0U; v < (ARRAY_SIZE(s_edgeDuties) + BENCH_RANDOM_DUTIES); v++)
+    {
+        for (k = 0U; k < s_waveHandle.timing.duties; k++)
+        {
+            if (v < ARRAY_SIZE(s_edgeDuties))
+            {
+                duty[k] = s_edgeDuties[(v + k) % ARRAY_SIZE(s_edgeDuties)];
+            }
+            else
+            {
+                duty[k] = (uint16_t)(BENCH_Random(&seed) % (SCTIMER_PWM_WAVE_DUTY_FULL + 1U));
+            }
+        }
+        SCTIMER_PwmWaveSetRow(&s_waveHandle.timing, row, duty);
+        BENCH_CheckRow(row, duty, &result);
+    }
+    SCTIMER_PwmWaveStop(SCT0, &s_waveHandle);
+
+    (void)printf("%-20s %4u ticks %2u dead %u words %3u rows max error %u ticks min dead %2u  %s\r\n", bench->name,
+                 (unsigned int)s_waveHandle.timing.periodTicks, (unsigned int)s_waveHandle.timing.deadTicks,
+                 (unsigned int)s_waveHandle.timing.rowWords, (unsigned int)result.rows,
+                 (unsigned int)result.maxError, (unsigned int)result.minDead,
+                 (result.errors == 0U) ? "ok" : "errors");
+}
+
+/* Follows the descriptors from the channel descriptor, one burst per trigger like the DMA. */
+static uint32_t BENCH_WalkRing(uint32_t bursts, uint32_t firstRow)
+{
+    dma_descriptor_t *desc = &((dma_descriptor_t *)DMA0->SRAMBASE)[BENCH_DMA_CHANNEL];
+    uint32_t rowWords      = s_waveHandle.timing.rowWords;
+    uint32_t errors        = 0U;
+    uint32_t row           = firstRow;
+    uint32_t remaining;
+    uint32_t count;
+    uint32_t b;
+    uint32_t j;
+    uint32_t *src;
+    uint32_t *dst;
+
+    count     = ((desc->xfercfg & DMA_CHANNEL_XFERCFG_XFERCOUNT_MASK) >> DMA_CHANNEL_XFERCFG_XFERCOUNT_SHIFT) + 1U;
+    remaining = count;
+    for (b = 0U; b < bursts; b++)
+    {
+        for (j = 0U; j < rowWords; j++)
+        {
+            remaining--;
+            src = (uint32_t *)desc->srcEndAddr - remaining;
+            dst = (uint32_t *)desc->dstEndAddr - (remaining % rowWords);
+            if ((dst < (uint32_t *)&SCT0->MATCHREL[0]) || (dst > (uint32_t *)&SCT0->MATCHREL[rowWords - 1U]))
+            {
+                return errors + 1U;
+            }
+            s_walked[dst - (uint32_t *)&SCT0->MATCHREL[0]] = *src;
+        }
+        if (memcmp(s_walked, &s_table[row * rowWords], rowWords * sizeof(uint32_t)) != 0)
+        {
+            errors++;
+        }
+        row = (row + 1U) % BENCH_TABLE_STEPS;
+
+        if (remaining == 0U)
+        {
+            if ((desc->xfercfg & DMA_CHANNEL_XFERCFG_RELOAD_MASK) == 0U)
+            {
+                return errors + 1U;
+            }
+            desc      = (dma_descriptor_t *)desc->linkToNextDesc;
+            count     = ((desc->xfercfg & DMA_CHANNEL_XFERCFG_XFERCOUNT_MASK) >> DMA_CHANNEL_XFERCFG_XFERCOUNT_SHIFT) + 1U;
+            remaining = count;
+        }
+    }
+
+    return errors;
+}
+
+static void BENCH_Table(void)
+{
+    const bench_case_t *bench = &s_cases[0];
+    bench_result_t result     = {0};
+    uint16_t duty[SCTIMER_PWM_WAVE_MAX_OUTPUTS];
+    uint32_t cfg;
+    uint32_t errors = 0U;
+    uint32_t intA   = 0U;
+    uint32_t i;
+    uint32_t k;
+    uint64_t cycles;
+    double angle;
+
+    if (BENCH_CreateWave(bench) != kStatus_Success)
+    {
+        (void)printf("%-20s create failed  errors\r\n", "sine table");
+        return;
+    }
+
+    cycles = HOSTSIM_GetCycles();
+    SCTIMER_PwmWaveFillSine(&s_waveHandle.timing, s_table, BENCH_TABLE_STEPS, BENCH_AMPLITUDE,
+                            SCTIMER_PWM_WAVE_TURN / 3U);
+    cycles = HOSTSIM_GetCycles() - cycles;
+
+    /* Every row of the table against the exact three-phase sine. */
+    for (i = 0U; i < BENCH_TABLE_STEPS; i++)
+    {
+        for (k = 0U; k < 3U; k++)
+        {
+            angle   = (2.0 * M_PI * (double)i / (double)BENCH_TABLE_STEPS) + (2.0 * M_PI * (double)k / 3.0);
+            duty[k] = (uint16_t)lround(16384.0 + (16384.0 * ((double)BENCH_AMPLITUDE / 32768.0) * sin(angle)));
+        }
+        BENCH_CheckRow(&s_table[i * 8U], duty, &result);
+    }
+
+    /* The ring: row 0 by the CPU, the head descriptor from row 1, then the blocks around. */
+    if (SCTIMER_PwmWaveStart(SCT0, &s_waveHandle, s_table, BENCH_TABLE_STEPS) != kStatus_Success)
+    {
+        errors++;
+    }
+    for (k = 0U; k < 8U; k++)
+    {
+        errors += ((SCT0->MATCH[k] != s_table[k]) || (SCT0->MATCHREL[k] != s_table[k])) ? 1U : 0U;
+    }
+    cfg = DMA0->CHANNEL[BENCH_DMA_CHANNEL].CFG;
+    errors += ((cfg & DMA_CHANNEL_CFG_HWTRIGEN_MASK) == 0U) ? 1U : 0U;
+    errors += ((cfg & (DMA_CHANNEL_CFG_TRIGBURST_MASK | DMA_CHANNEL_CFG_BURSTPOWER_MASK |
+                       DMA_CHANNEL_CFG_DSTBURSTWRAP_MASK)) !=
+               ((uint32_t)kDMA_EdgeBurstTransfer8 | (uint32_t)kDMA_DstWrap)) ?
+                  1U :
+                  0U;
+    errors += ((SCT0->DMAREQ0 & 1U) == 0U) ? 1U : 0U;
+    errors += ((SCT0->LIMIT & 1U) == 0U) ? 1U : 0U;
+    for (i = 0U; i < ARRAY_SIZE(s_descriptors); i++)
+    {
+        intA += ((s_descriptors[i].xfercfg & DMA_CHANNEL_XFERCFG_SETINTA_MASK) != 0U) ? 1U : 0U;
+        errors += (s_descriptors[i].linkToNextDesc != &s_descriptors[(i + 1U) % ARRAY_SIZE(s_descriptors)]) ? 1U : 0U;
+    }
+    errors += ((intA != 1U) ||
+               ((s_descriptors[ARRAY_SIZE(s_descriptors) - 1U].xfercfg & DMA_CHANNEL_XFERCFG_SETINTA_MASK) == 0U)) ?
+                  1U :
+                  0U;
+    errors += BENCH_WalkRing(3U * BENCH_TABLE_STEPS, 1U);
+    SCTIMER_PwmWaveStop(SCT0, &s_waveHandle);
+    errors += ((SCT0->OUTPUT & 0x3FU) != 0U) ? 1U : 0U;
+
+    (void)printf("%-20s %4u rows %u descriptors max error %u ticks  %3u bursts walked  fill %6.1f cycles/row  %s\r\n",
+                 "sine table", (unsigned int)result.rows, (unsigned int)ARRAY_SIZE(s_descriptors),
+                 (unsigned int)result.maxError, (unsigned int)(3U * BENCH_TABLE_STEPS),
+                 (double)cycles / (double)BENCH_TABLE_STEPS,
+                 ((errors == 0U) && (result.errors == 0U)) ? "ok" : "errors");
+}
+
+/* The duty cycles of three outputs updated from the CPU at every period, like sctimer_multi_channel_pwm. */
+static void BENCH_CpuUpdate(void)
+{
+    sctimer_config_t sctConfig;
+    sctimer_pwm_signal_param_t param;
+    uint32_t events[3];
+    uint32_t i;
+    uint32_t k;
+    uint64_t cycles;
+    uint32_t errors = 0U;
+
+    (void)memset((void *)SCT0, 0, sizeof(SCT_Type));
+    SCTIMER_GetDefaultConfig(&sctConfig);
+    (void)SCTIMER_Init(SCT0, &sctConfig);
+    param.level = kSCTIMER_HighTrue;
+    for (k = 0U; k < 3U; k++)
+    {
+        param.output           = (sctimer_out_t)k;
+        param.dutyCyclePercent = 50U;
+        if (SCTIMER_SetupPwm(SCT0, &param, kSCTIMER_EdgeAlignedPwm, 20000U, BENCH_SCT_CLOCK, &events[k]) !=
+            kStatus_Success)
+        {
+            errors++;
+        }
+    }
+    SCTIMER_StartTimer(SCT0, (uint32_t)kSCTIMER_Counter_U);
+
+    cycles = HOSTSIM_GetCycles();
+    for (i = 0U; i < BENCH_UPDATE_PERIODS; i++)
+    {
+        for (k = 0U; k < 3U; k++)
+        {
+            SCTIMER_UpdatePwmDutycycle(SCT0, (sctimer_out_t)k,
+                                       (uint8_t)(50U + (((i + (k * 33U)) % 100U) / 2U) - 25U), events[k]);
+        }
+    }
+    cycles = HOSTSIM_GetCycles() - cycles;
+
+    (void)printf("%-20s %4u periods %8.1f cycles/period, counter halted 3 times a period  %s\r\n", "cpu update",
+                 (unsigned int)BENCH_UPDATE_PERIODS, (double)cycles / (double)BENCH_UPDATE_PERIODS,
+                 (errors == 0U) ? "ok" : "errors");
+    (void)printf("%-20s %4u periods %8.1f cycles/period, table streamed by the DMA\r\n", "dma wave",
+                 (unsigned int)BENCH_UPDATE_PERIODS, 0.0);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    BENCH_Timing();
+    BENCH_Sine();
+    for (i = 0U; i < ARRAY_SIZE(s_cases); i++)
+    {
+        BENCH_Rows(&s_cases[i]);
+    }
+    BENCH_Table();
+    BENCH_CpuUpdate();
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef HOSTSIM_VECTAB_VIRTUAL_H_
+#define HOSTSIM_VECTAB_VIRTUAL_H_
+
+/* Vector table of the host build, handlers are host function addresses. */
+void HOSTSIM_NVIC_SetVector(IRQn_Type IRQn, uint32_t vector);
+uint32_t HOSTSIM_NVIC_GetVector(IRQn_Type IRQn);
+
+#define NVIC_SetVector HOSTSIM_NVIC_SetVector
+#define NVIC_GetVector HOSTSIM_NVIC_GetVector
+
+#endif /* HOSTSIM_VECTAB_VIRTUAL_H_ */
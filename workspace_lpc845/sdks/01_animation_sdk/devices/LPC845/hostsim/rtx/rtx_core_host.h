@@ -0,0 +1,176 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host port of the RTX core layer, included ahead of every RTX source with -include.
+ *
+ * rtx_lib.h includes rtx_core_c.h from its own directory, the guards defined here keep it and
+ * rtx_core_cm.h out of the build. The core helpers are the ones of the Cortex-M0+ built on the
+ * simulator intrinsics. A service call runs the RTX function directly in the calling context and
+ * then does what the SVC handler does on return: the next thread becomes the running thread. The
+ * host stack is never switched, the bench always acts as the running thread.
+ */
+#ifndef RTX_CORE_HOST_H_
+#define RTX_CORE_HOST_H_
+
+#define RTX_CORE_C_H_
+#define RTX_CORE_CM_H_
+
+/* The LPC845 core, selects the Armv6-M code paths of RTX. */
+#ifndef __ARM_ARCH_6M__
+#define __ARM_ARCH_6M__ 1
+#endif
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include <stdbool.h>
+typedef bool bool_t;
+
+#define FALSE ((bool_t)0)
+#define TRUE  ((bool_t)1)
+
+/* Armv6-M has no exclusive access, RTX masks interrupts instead. */
+#define EXCLUSIVE_ACCESS 0
+
+#define OS_TICK_HANDLER SysTick_Handler
+
+#define STACK_FRAME_INIT_VAL 0xFDU
+
+__STATIC_INLINE uint32_t xPSR_InitVal(bool_t privileged, bool_t thumb)
+{
+    (void)privileged;
+    (void)thumb;
+    return 0x01000000U;
+}
+
+__STATIC_INLINE uint32_t StackOffsetR0(uint8_t stack_frame)
+{
+    (void)stack_frame;
+    return 8U * 4U;
+}
+
+__STATIC_INLINE bool_t IsPrivileged(void)
+{
+    return ((__get_CONTROL() & 1U) == 0U);
+}
+
+__STATIC_INLINE void SetPrivileged(bool_t privileged)
+{
+    __set_CONTROL(privileged ? 0x02U : 0x03U);
+}
+
+__STATIC_INLINE bool_t IsException(void)
+{
+    return (__get_IPSR() != 0U);
+}
+
+__STATIC_INLINE bool_t IsFault(void)
+{
+    uint32_t ipsr = __get_IPSR();
+    return (((int32_t)ipsr < ((int32_t)SVCall_IRQn + 16)) && ((int32_t)ipsr > ((int32_t)NonMaskableInt_IRQn + 16)));
+}
+
+__STATIC_INLINE bool_t IsSVCallIrq(void)
+{
+    return ((int32_t)__get_IPSR() == ((int32_t)SVCall_IRQn + 16));
+}
+
+__STATIC_INLINE bool_t IsPendSvIrq(void)
+{
+    return ((int32_t)__get_IPSR() == ((int32_t)PendSV_IRQn + 16));
+}
+
+__STATIC_INLINE bool_t IsTickIrq(int32_t tick_irqn)
+{
+    return ((int32_t)__get_IPSR() == (tick_irqn + 16));
+}
+
+__STATIC_INLINE bool_t IsIrqMasked(void)
+{
+    return (__get_PRIMASK() != 0U);
+}
+
+/* SVCall and PendSV have no priority on the host, service calls are function calls. */
+__STATIC_INLINE void SVC_Setup(void)
+{
+}
+
+/* The system control space is plain memory of the simulator, nothing takes the pending PendSV. */
+__STATIC_INLINE uint8_t GetPendSV(void)
+{
+    return ((uint8_t)((SCB->ICSR & (SCB_ICSR_PENDSVSET_Msk)) >> 24));
+}
+
+__STATIC_INLINE void ClrPendSV(void)
+{
+    SCB->ICSR &= ~SCB_ICSR_PENDSVSET_Msk;
+}
+
+__STATIC_INLINE void SetPendSV(void)
+{
+    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+}
+
+/* Return from the SVC exception: switch to the next thread. */
+#define RTX_HostSwitch() (osRtxInfo.thread.run.curr = osRtxInfo.thread.run.next)
+
+/* The bench keeps the host stack, the stack pointer of a thread is the one saved at its creation. */
+#define __get_PSP() (osRtxInfo.thread.run.curr->sp)
+
+#define SVC0_0N(f, t)          \
+    __STATIC_INLINE t __svc##f(void) \
+    {                          \
+        svcRtx##f();           \
+        RTX_HostSwitch();      \
+    }
+
+#define SVC0_0(f, t)           \
+    __STATIC_INLINE t __svc##f(void) \
+    {                          \
+        t ret = svcRtx##f();   \
+        RTX_HostSwitch();      \
+        return ret;            \
+    }
+
+#define SVC0_1N(f, t, t1)         \
+    __STATIC_INLINE t __svc##f(t1 a1) \
+    {                             \
+        svcRtx##f(a1);            \
+        RTX_HostSwitch();         \
+    }
+
+#define SVC0_1(f, t, t1)          \
+    __STATIC_INLINE t __svc##f(t1 a1) \
+    {                             \
+        t ret = svcRtx##f(a1);    \
+        RTX_HostSwitch();         \
+        return ret;               \
+    }
+
+#define SVC0_2(f, t, t1, t2)             \
+    __STATIC_INLINE t __svc##f(t1 a1, t2 a2) \
+    {                                    \
+        t ret = svcRtx##f(a1, a2);       \
+        RTX_HostSwitch();                \
+        return ret;                      \
+    }
+
+#define SVC0_3(f, t, t1, t2, t3)                \
+    __STATIC_INLINE t __svc##f(t1 a1, t2 a2, t3 a3) \
+    {                                           \
+        t ret = svcRtx##f(a1, a2, a3);          \
+        RTX_HostSwitch();                       \
+        return ret;                             \
+    }
+
+#define SVC0_4(f, t, t1, t2, t3, t4)                   \
+    __STATIC_INLINE t __svc##f(t1 a1, t2 a2, t3 a3, t4 a4) \
+    {                                                  \
+        t ret = svcRtx##f(a1, a2, a3, a4);             \
+        RTX_HostSwitch();                              \
+        return ret;                                    \
+    }
+
+#endif /* RTX_CORE_HOST_H_ */
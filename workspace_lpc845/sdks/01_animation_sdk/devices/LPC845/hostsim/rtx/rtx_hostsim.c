@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Exception module and OS tick of the RTX host benches, in place of irq_armv6m.S and os_systick.c.
+ * No timer interrupt is started, the benches pend SysTick themselves when they need a kernel tick so
+ * that the scheduling only follows their calls and is reproducible.
+ */
+
+#include "os_tick.h"
+#include "rtx_os.h"
+
+#include "fsl_common.h"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/* Exception handlers of rtx_system.c, called by the handlers of irq_armv6m.S on the target. */
+extern void osRtxTick_Handler(void);
+extern void osRtxPendSV_Handler(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static uint32_t s_tickInterval = 1U;
+
+/* Referenced by rtx_lib.c to link the exception module. */
+const uint8_t irqRtxLib = 0U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ * Kernel tick, taken through the simulator with SysTick as the active exception. As on the target the
+ * thread switch of the tick is done before the PendSV it requests for the post processing of its
+ * messages is tail-chained, the post processing dispatches against the new running thread.
+ */
+void SysTick_Handler(void)
+{
+    osRtxTick_Handler();
+    RTX_HostSwitch();
+    if (GetPendSV() != 0U)
+    {
+        ClrPendSV();
+        osRtxPendSV_Handler();
+        RTX_HostSwitch();
+    }
+}
+
+int32_t OS_Tick_Setup(uint32_t freq, IRQHandler_t handler)
+{
+    (void)handler;
+
+    if ((freq == 0U) || (freq > SystemCoreClock))
+    {
+        return -1;
+    }
+    s_tickInterval = SystemCoreClock / freq;
+
+    return 0;
+}
+
+void OS_Tick_Enable(void)
+{
+}
+
+void OS_Tick_Disable(void)
+{
+}
+
+void OS_Tick_AcknowledgeIRQ(void)
+{
+}
+
+int32_t OS_Tick_GetIRQn(void)
+{
+    return (int32_t)SysTick_IRQn;
+}
+
+uint32_t OS_Tick_GetClock(void)
+{
+    return SystemCoreClock;
+}
+
+uint32_t OS_Tick_GetInterval(void)
+{
+    return s_tickInterval;
+}
+
+uint32_t OS_Tick_GetCount(void)
+{
+    return 0U;
+}
+
+uint32_t OS_Tick_GetOverflow(void)
+{
+    return 0U;
+}
@@ -255,7 +255,6 @@ static void _FMSTR_SendError(FMSTR_BCHR nErrCode)
 static void _FMSTR_SendResponse(FMSTR_BPTR pResponse, FMSTR_SIZE nLength, FMSTR_U8 statusCode, void *identification)
 {
     FMSTR_BCHR chSum = 0U;
-    FMSTR_U8 i, c;
 
     FMSTR_UNUSED(identification);
 
@@ -290,13 +289,8 @@ static void _FMSTR_SendResponse(FMSTR_BPTR pResponse, FMSTR_SIZE nLength, FMSTR_
     FMSTR_Crc8Init(&chSum);
 
     /* status byte and data are already there, compute checksum only */
-    pResponse = fmstr_pTxBuff;
-    for (i = 1U; i < fmstr_nTxTodo; i++)
-    {
-        pResponse = FMSTR_ValueFromBuffer8(&c, pResponse);
-        /* add character to checksum */
-        FMSTR_Crc8AddByte(&chSum, c);
-    }
+    FMSTR_Crc8AddBlock(&chSum, fmstr_pTxBuff, (FMSTR_SIZE)(fmstr_nTxTodo - 1U));
+    pResponse = FMSTR_SkipInBuffer(fmstr_pTxBuff, fmstr_nTxTodo - 1U);
 
     /* store checksum after the message */
     pResponse = FMSTR_ValueToBuffer8(pResponse, chSum);
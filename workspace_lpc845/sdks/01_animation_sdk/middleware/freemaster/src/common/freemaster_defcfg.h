@@ -136,6 +136,16 @@
 #define FMSTR_USE_WRITEMEMMASK 1
 #endif
 
+/* batched read of multiple memory blocks is DISABLED by default */
+#ifndef FMSTR_USE_READMEMS
+#define FMSTR_USE_READMEMS 0
+#endif
+
+/* number of memory blocks in the read group of each session, 0 disables the read group */
+#ifndef FMSTR_MAX_READGROUP_VARS
+#define FMSTR_MAX_READGROUP_VARS 0
+#endif
+
 /* default scope settings */
 #ifndef FMSTR_USE_SCOPE
 #define FMSTR_USE_SCOPE 0
@@ -158,6 +168,32 @@
 #define FMSTR_REC_FLOAT_TRIG 0
 #endif
 
+/* Store recorder samples as zig-zag ULEB deltas, the PC reads them decoded */
+#ifndef FMSTR_REC_COMPRESS
+#define FMSTR_REC_COMPRESS 0
+#endif
+
+/* Size of one compressed recorder block in bytes */
+#ifndef FMSTR_REC_COMPRESS_BLOCK
+#define FMSTR_REC_COMPRESS_BLOCK 128
+#endif
+
+/* Points the PC may request per point the buffer holds uncompressed. The recorder lowers the
+   count to the points actually stored, raise it only for signals known to compress that well. */
+#ifndef FMSTR_REC_COMPRESS_RATIO
+#define FMSTR_REC_COMPRESS_RATIO 1
+#endif
+
+/* Address range the PC reads the decoded points from, one span per recorder. It must not
+   overlap any memory the PC may access, the default lies in the Cortex-M vendor system area. */
+#ifndef FMSTR_REC_VIEW_ADDR
+#define FMSTR_REC_VIEW_ADDR 0xF0000000UL
+#endif
+
+#ifndef FMSTR_REC_VIEW_SPAN
+#define FMSTR_REC_VIEW_SPAN 0x01000000UL
+#endif
+
 /* Debug-TX mode is a special mode used to test or debug the data transmitter. Our driver
    will be sending test frames periodically until a first valid command is received from the
    PC Host. You can hook a logic analyzer to transmission pins to determine port and baudrate.
@@ -216,6 +252,11 @@
 #define FMSTR_USE_TSA_SAFETY 0
 #endif
 
+/* address intervals of the TSA safety index, 0 disables the index and the tables are walked on every access */
+#ifndef FMSTR_TSA_INDEX_SIZE
+#define FMSTR_TSA_INDEX_SIZE 0
+#endif
+
 /* TSA table allocation modifier */
 #ifndef FMSTR_USE_TSA_INROM
 #define FMSTR_USE_TSA_INROM 0
@@ -279,6 +320,15 @@
 #define FMSTR_COMM_BUFFER_SIZE 240U
 #endif
 
+/* entries of the CRC lookup tables, 16 (per nibble) or 256 (per byte), 0 computes the CRC bit by bit */
+#ifndef FMSTR_CRC_TABLE_SIZE
+#define FMSTR_CRC_TABLE_SIZE 0
+#endif
+
+#if FMSTR_CRC_TABLE_SIZE != 0 && FMSTR_CRC_TABLE_SIZE != 16 && FMSTR_CRC_TABLE_SIZE != 256
+#error FMSTR_CRC_TABLE_SIZE must be 0, 16 or 256.
+#endif
+
 /* PDBDM buffer is defined in the driver by default */
 #ifndef FMSTR_PDBDM_USER_BUFFER
 #define FMSTR_PDBDM_USER_BUFFER 0
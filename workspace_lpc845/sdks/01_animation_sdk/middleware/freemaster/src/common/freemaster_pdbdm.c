@@ -135,10 +135,8 @@ static void _FMSTR_PdBdmPoll(void)
         FMSTR_Crc8AddByte(&crc, _pdbdm.pcktSize);
         FMSTR_Crc8AddByte(&crc, _pdbdm.cmdStatus);
 
-        for(i=0; i<_pdbdm.pcktSize; i++)
-        {
-            FMSTR_Crc8AddByte(&crc, _pdbdm.commBuffer[i]);
-        }
+        FMSTR_Crc8AddBlock(&crc, _pdbdm.commBuffer, _pdbdm.pcktSize);
+        i = _pdbdm.pcktSize;
 
         /* If CRC is valid, do the prtocol decoding, otherwise wait to finish background write*/
         if(crc == _pdbdm.commBuffer[i])
@@ -196,10 +194,8 @@ static void _FMSTR_PdBdmSendResponse(FMSTR_BPTR pResponse, FMSTR_SIZE nLength, F
 
     FMSTR_Crc8AddByte(&crc, (FMSTR_U8)nLength);
     FMSTR_Crc8AddByte(&crc, statusCode);
-    for(i=0; i<nLength; i++)
-    {
-        FMSTR_Crc8AddByte(&crc, _pdbdm.commBuffer[i]);
-    }
+    FMSTR_Crc8AddBlock(&crc, _pdbdm.commBuffer, nLength);
+    i = nLength;
 
     /* Add the response CRC at the end of data, in case that full communication buffer is used the CRC will be written into */
     _pdbdm.commBuffer[i] = crc;
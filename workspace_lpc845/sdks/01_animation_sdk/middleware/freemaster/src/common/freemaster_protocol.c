@@ -81,6 +81,14 @@ FMSTR_BPTR _FMSTR_AuthenticationStep2(FMSTR_SESSION *session, FMSTR_BPTR msgBuff
 FMSTR_BPTR _FMSTR_ReadMem(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus);
 FMSTR_BPTR _FMSTR_ReadMemBaseAddress(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus);
 FMSTR_BPTR _FMSTR_WriteMem(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus);
+FMSTR_BPTR _FMSTR_CopyBlockToBuffer(FMSTR_BPTR destBuff, FMSTR_ADDR srcAddr, FMSTR_SIZE size);
+FMSTR_BPTR _FMSTR_ReadMems(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_SIZE msgSize, FMSTR_U8 *retStatus);
+FMSTR_BPTR _FMSTR_SetReadGroup(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_SIZE msgSize, FMSTR_U8 *retStatus);
+FMSTR_BPTR _FMSTR_ReadReadGroup(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus);
+
+#if FMSTR_USE_READMEMS > 0
+static FMSTR_U8 _FMSTR_CheckReadBlock(FMSTR_ADDR addr, FMSTR_SIZE size, FMSTR_SIZE *totalSize);
+#endif
 
 static FMSTR_SESSION *_FMSTR_FindSession(void *identification, FMSTR_BOOL create);
 
@@ -323,6 +331,25 @@ FMSTR_BOOL FMSTR_ProtocolDecoder(FMSTR_BPTR msgBuffIO, FMSTR_SIZE msgSize, FMSTR
             break;
 #endif
 
+#if FMSTR_USE_READMEMS > 0
+        /* read multiple blocks of memory */
+        case FMSTR_CMD_READMEMS:
+            responseEnd = _FMSTR_ReadMems(activeSession, msgBuffIO, msgSize, &statusCode);
+            break;
+
+#if FMSTR_MAX_READGROUP_VARS > 0
+        /* define the session read group */
+        case FMSTR_CMD_SETRDGRP:
+            responseEnd = _FMSTR_SetReadGroup(activeSession, msgBuffIO, msgSize, &statusCode);
+            break;
+
+        /* read all blocks of the session read group */
+        case FMSTR_CMD_READRDGRP:
+            responseEnd = _FMSTR_ReadReadGroup(activeSession, msgBuffIO, &statusCode);
+            break;
+#endif
+#endif /* FMSTR_USE_READMEMS */
+
 #endif /* FMSTR_USE_READMEM */
 
 #if FMSTR_USE_WRITEMEM > 0
@@ -481,7 +508,7 @@ FMSTR_BOOL FMSTR_SendTestFrame(FMSTR_BPTR msgBuffIO, FMSTR_SESSION *session)
 FMSTR_BPTR _FMSTR_GetBoardConfig(FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus)
 {
     static const FMSTR_CHAR *const fmstr_cfgParamNames[] = {
-        "MTU", "VS", "NM", "DS", "BD", "F1", "BA", "RC", "SC", "PV", "PC",
+        "MTU", "VS", "NM", "DS", "BD", "F1", "BA", "RC", "SC", "PV", "PC", "RG",
     };
 
     FMSTR_BPTR response = msgBuffIO;
@@ -556,6 +583,11 @@ FMSTR_BPTR _FMSTR_GetBoardConfig(FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus)
         case 11: /* PC */
             response = FMSTR_ValueToBuffer8(response, FMSTR_USE_PIPES);
             break;
+#if FMSTR_USE_READMEMS > 0
+        case 12: /* RG */
+            response = FMSTR_ValueToBuffer8(response, FMSTR_MAX_READGROUP_VARS);
+            break;
+#endif
         default:
             respCode = FMSTR_STC_EACCESS;
             break;
@@ -783,7 +815,7 @@ FMSTR_BPTR _FMSTR_ReadMem(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8
 
     /* success  */
     *retStatus = FMSTR_STS_OK;
-    return FMSTR_CopyToBuffer(response, addr, size);
+    return _FMSTR_CopyBlockToBuffer(response, addr, size);
 }
 
 /******************************************************************************
@@ -842,10 +874,332 @@ FMSTR_BPTR _FMSTR_ReadMemBaseAddress(FMSTR_SESSION *session, FMSTR_BPTR msgBuffI
 
     /* success  */
     *retStatus = FMSTR_STS_OK;
-    return FMSTR_CopyToBuffer(response, addr, size);
+    return _FMSTR_CopyBlockToBuffer(response, addr, size);
 }
 #endif /* FMSTR_PLATFORM_BASE_ADDRESS */
 
+/******************************************************************************
+ *
+ * @brief    Copy one block of memory read by the PC to the response
+ *
+ * @param    destBuff - response buffer
+ * @param    srcAddr - address of the memory block
+ * @param    size - size of the memory block
+ *
+ * @return   Pointer just behind the copied data
+ *
+ ******************************************************************************/
+
+FMSTR_BPTR _FMSTR_CopyBlockToBuffer(FMSTR_BPTR destBuff, FMSTR_ADDR srcAddr, FMSTR_SIZE size)
+{
+#if FMSTR_USE_RECORDER > 0 && FMSTR_REC_COMPRESS > 0
+    /* compressed recorder data are decoded on the fly */
+    if (FMSTR_IsInRecBuffer(srcAddr, size) != FMSTR_FALSE)
+    {
+        return FMSTR_CopyRecToBuffer(destBuff, srcAddr, size);
+    }
+#endif
+
+    return FMSTR_CopyToBuffer(destBuff, srcAddr, size);
+}
+
+#if FMSTR_USE_READMEMS > 0
+
+/******************************************************************************
+ *
+ * @brief    Check one block of a batched read
+ *
+ * @param    addr - address of the memory block
+ * @param    size - size of the memory block
+ * @param    totalSize - size of the response so far, incremented by the block size
+ *
+ * @return   FMSTR_STS_OK or error status code
+ *
+ ******************************************************************************/
+
+static FMSTR_U8 _FMSTR_CheckReadBlock(FMSTR_ADDR addr, FMSTR_SIZE size, FMSTR_SIZE *totalSize)
+{
+#if FMSTR_USE_TSA && FMSTR_USE_TSA_SAFETY
+    if (FMSTR_CheckTsaSpace(addr, size, FMSTR_FALSE) == FMSTR_FALSE)
+    {
+        return FMSTR_STC_EACCESS;
+    }
+#else
+    FMSTR_UNUSED(addr);
+#endif
+
+    /* all blocks must fit into one response */
+    if (size > ((FMSTR_SIZE)FMSTR_COMM_BUFFER_SIZE - *totalSize))
+    {
+        return FMSTR_STC_RSPBUFFOVF;
+    }
+
+    *totalSize += size;
+    return FMSTR_STS_OK;
+}
+
+/******************************************************************************
+ *
+ * @brief    Handling READMEMS command
+ *
+ * @param    session - transport session
+ * @param    msgBuffIO - original command (in) and response buffer (out)
+ * @param    msgSize - size of the command data
+ * @param    retStatus - response status
+ *
+ * @return   As all command handlers, the return value should be the buffer
+ *           pointer where the response data payload is finished
+ *
+ * The command holds the number of blocks followed by address and size of each
+ * block (same encoding as READMEM). The response holds the data of all blocks
+ * one after another. Nothing is read unless all blocks are accessible and fit
+ * into the response together with the command itself.
+ *
+ ******************************************************************************/
+
+FMSTR_BPTR _FMSTR_ReadMems(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_SIZE msgSize, FMSTR_U8 *retStatus)
+{
+    FMSTR_BPTR response = msgBuffIO;
+    FMSTR_BPTR msgEnd   = msgBuffIO + msgSize;
+    FMSTR_SIZE totalSize = 0U;
+    FMSTR_U8 status      = FMSTR_STS_OK;
+    FMSTR_BPTR src;
+    FMSTR_BPTR dest;
+    FMSTR_ADDR addr;
+    FMSTR_SIZE size;
+    FMSTR_U8 count = 0U;
+    FMSTR_U8 i;
+
+#if FMSTR_CFG_F1_RESTRICTED_ACCESS != 0
+    if (session->restr.grantedAccess < FMSTR_RESTRICTED_ACCESS_R)
+    {
+        *retStatus = FMSTR_STC_EAUTH;
+        return response;
+    }
+#else
+    FMSTR_UNUSED(session);
+#endif
+
+    if (msgSize < 1U)
+    {
+        *retStatus = FMSTR_STC_INVSIZE;
+        return response;
+    }
+
+    /* Get the number of blocks from incomming buffer */
+    msgBuffIO = FMSTR_ValueFromBuffer8(&count, msgBuffIO);
+
+    /* Check all blocks before any data is copied, never decode behind the command */
+    for (i = 0U; i < count && status == FMSTR_STS_OK; i++)
+    {
+        if (msgBuffIO >= msgEnd)
+        {
+            status = FMSTR_STC_INVSIZE;
+            break;
+        }
+        msgBuffIO = FMSTR_AddressFromBuffer(&addr, msgBuffIO);
+
+        if (msgBuffIO >= msgEnd)
+        {
+            status = FMSTR_STC_INVSIZE;
+            break;
+        }
+        msgBuffIO = FMSTR_SizeFromBuffer(&size, msgBuffIO);
+
+        status = msgBuffIO > msgEnd ? FMSTR_STC_INVSIZE : _FMSTR_CheckReadBlock(addr, size, &totalSize);
+    }
+
+    if (status == FMSTR_STS_OK && msgBuffIO != msgEnd)
+    {
+        status = FMSTR_STC_INVSIZE;
+    }
+
+    /* the command is moved behind the response data, it must fit there as well */
+    if (status == FMSTR_STS_OK && totalSize > ((FMSTR_SIZE)FMSTR_COMM_BUFFER_SIZE - msgSize))
+    {
+        status = FMSTR_STC_RSPBUFFOVF;
+    }
+
+    if (status != FMSTR_STS_OK)
+    {
+        *retStatus = status;
+        return response;
+    }
+
+    /* Move the command out of the way so that the response never overwrites unread blocks */
+    src  = msgEnd;
+    dest = msgEnd + totalSize;
+    while (src > response)
+    {
+        *(--dest) = *(--src);
+    }
+
+    msgBuffIO = response + totalSize + 1U;
+    for (i = 0U; i < count; i++)
+    {
+        msgBuffIO = FMSTR_AddressFromBuffer(&addr, msgBuffIO);
+        msgBuffIO = FMSTR_SizeFromBuffer(&size, msgBuffIO);
+        response  = _FMSTR_CopyBlockToBuffer(response, addr, size);
+    }
+
+    /* success  */
+    *retStatus = FMSTR_STS_OK;
+    return response;
+}
+
+#if FMSTR_MAX_READGROUP_VARS > 0
+
+/******************************************************************************
+ *
+ * @brief    Handling SETRDGRP command
+ *
+ * @param    session - transport session
+ * @param    msgBuffIO - original command (in) and response buffer (out)
+ * @param    msgSize - size of the command data
+ * @param    retStatus - response status
+ *
+ * @return   As all command handlers, the return value should be the buffer
+ *           pointer where the response data payload is finished
+ *
+ * The command holds the index of the first block to set, the number of blocks
+ * and address and size of each block. The read group is truncated behind the
+ * last block set, so a large group is defined by several commands with
+ * increasing index, and the group is cleared by setting zero blocks at index 0.
+ * The group is truncated to the blocks set successfully on error.
+ *
+ ******************************************************************************/
+
+FMSTR_BPTR _FMSTR_SetReadGroup(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_SIZE msgSize, FMSTR_U8 *retStatus)
+{
+    FMSTR_BPTR response  = msgBuffIO;
+    FMSTR_BPTR msgEnd    = msgBuffIO + msgSize;
+    FMSTR_SIZE totalSize = 0U;
+    FMSTR_U8 status      = FMSTR_STS_OK;
+    FMSTR_READGROUP_ITEM *item;
+    FMSTR_U8 index = 0U;
+    FMSTR_U8 count = 0U;
+    FMSTR_U8 i;
+
+#if FMSTR_CFG_F1_RESTRICTED_ACCESS != 0
+    if (session->restr.grantedAccess < FMSTR_RESTRICTED_ACCESS_R)
+    {
+        *retStatus = FMSTR_STC_EAUTH;
+        return response;
+    }
+#endif
+
+    if (msgSize < 2U)
+    {
+        *retStatus = FMSTR_STC_INVSIZE;
+        return response;
+    }
+
+    /* Get the first index and number of blocks from incomming buffer */
+    msgBuffIO = FMSTR_ValueFromBuffer8(&index, msgBuffIO);
+    msgBuffIO = FMSTR_ValueFromBuffer8(&count, msgBuffIO);
+
+    /* The group is extended or rewritten, never left with gaps */
+    if (index > session->readGroupCount || ((FMSTR_SIZE)index + count) > FMSTR_MAX_READGROUP_VARS)
+    {
+        *retStatus = FMSTR_STC_INVSIZE;
+        return response;
+    }
+
+    /* Size of the response with the blocks which are kept */
+    for (i = 0U; i < index; i++)
+    {
+        totalSize += session->readGroup[i].size;
+    }
+
+    session->readGroupCount = index;
+
+    item = &session->readGroup[index];
+    for (i = 0U; i < count && status == FMSTR_STS_OK; i++)
+    {
+        /* never decode behind the command */
+        if (msgBuffIO >= msgEnd)
+        {
+            status = FMSTR_STC_INVSIZE;
+            break;
+        }
+        msgBuffIO = FMSTR_AddressFromBuffer(&item->addr, msgBuffIO);
+
+        if (msgBuffIO >= msgEnd)
+        {
+            status = FMSTR_STC_INVSIZE;
+            break;
+        }
+        msgBuffIO = FMSTR_SizeFromBuffer(&item->size, msgBuffIO);
+
+        status = msgBuffIO > msgEnd ? FMSTR_STC_INVSIZE : _FMSTR_CheckReadBlock(item->addr, item->size, &totalSize);
+        item++;
+    }
+
+    if (status == FMSTR_STS_OK && msgBuffIO != msgEnd)
+    {
+        status = FMSTR_STC_INVSIZE;
+    }
+
+    if (status == FMSTR_STS_OK)
+    {
+        session->readGroupCount = (FMSTR_U8)(index + count);
+    }
+
+    *retStatus = status;
+    return response;
+}
+
+/******************************************************************************
+ *
+ * @brief    Handling READRDGRP command
+ *
+ * @param    session - transport session
+ * @param    msgBuffIO - original command (in) and response buffer (out)
+ * @param    retStatus - response status
+ *
+ * @return   As all command handlers, the return value should be the buffer
+ *           pointer where the response data payload is finished
+ *
+ * The command has no data, the response holds the data of all blocks of the
+ * read group one after another. The blocks were checked by SETRDGRP.
+ *
+ ******************************************************************************/
+
+FMSTR_BPTR _FMSTR_ReadReadGroup(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus)
+{
+    FMSTR_BPTR response = msgBuffIO;
+    FMSTR_READGROUP_ITEM *item;
+    FMSTR_U8 i;
+
+#if FMSTR_CFG_F1_RESTRICTED_ACCESS != 0
+    if (session->restr.grantedAccess < FMSTR_RESTRICTED_ACCESS_R)
+    {
+        *retStatus = FMSTR_STC_EAUTH;
+        return response;
+    }
+#endif
+
+    if (session->readGroupCount == 0U)
+    {
+        *retStatus = FMSTR_STC_NOTINIT;
+        return response;
+    }
+
+    item = session->readGroup;
+    for (i = 0U; i < session->readGroupCount; i++)
+    {
+        response = _FMSTR_CopyBlockToBuffer(response, item->addr, item->size);
+        item++;
+    }
+
+    /* success  */
+    *retStatus = FMSTR_STS_OK;
+    return response;
+}
+
+#endif /* FMSTR_MAX_READGROUP_VARS */
+#endif /* FMSTR_USE_READMEMS */
+
 /******************************************************************************
  *
  * @brief    Handling WRITEMEM and WRITEMEM_EX commands
@@ -41,6 +41,9 @@
 #define FMSTR_CMD_GETAPPCMDSTS  0x31U /* get the application command status */
 #define FMSTR_CMD_GETAPPCMDDATA 0x32U /* get the application command data */
 #define FMSTR_CMD_FEATLOCK      0x33U /* Lock or unlock feature in a multi-session configuration */
+#define FMSTR_CMD_READMEMS      0x34U /* Read multiple blocks of memory in one response */
+#define FMSTR_CMD_SETRDGRP      0x35U /* Define the read group of the session */
+#define FMSTR_CMD_READRDGRP     0x36U /* Read all blocks of the session read group */
 
 /* special transport-specific commands */
 #define FMSTR_CANSPC_PING       0xC0U
@@ -102,6 +102,12 @@ typedef struct FMSTR_REC_VAR_DATA_S
     FMSTR_REC_THRESHOLD thresholdVal; /* trigger threshold value if used */
     FMSTR_PCOMPAREFUNC compareFunc;   /* pointer to trigger compare function if used */
     FMSTR_PREADFUNC readFunc;         /* pointer to variable read (value copy) function */
+#if FMSTR_REC_COMPRESS > 0
+    FMSTR_REC_THRESHOLD zipLastVal;   /* last encoded value, the next sample is stored as a delta to it */
+    FMSTR_REC_THRESHOLD zipDecVal;    /* last decoded value when the PC reads the compressed buffer */
+#else
+    FMSTR_SIZE copySize;              /* bytes copied starting at this variable, 0 when merged to a preceding run */
+#endif
 
     FMSTR_BOOL trgLastState;          /* last trigger comparison state for edge detection if used */
 } FMSTR_REC_VAR_DATA;
@@ -122,6 +128,17 @@ typedef struct
     FMSTR_SIZE pointVarCount;     /* number of variables recorded (trigger-only vars excluded) */
     FMSTR_REC_FLAGS flags;        /* recorder flags */
     FMSTR_REC_CFG config;         /* original recorder configuration */
+#if FMSTR_REC_COMPRESS > 0
+    FMSTR_LP_U32 zipBlkFirst;     /* number of the first point stored in each block */
+    FMSTR_ADDR zipBlocks;         /* first compressed block */
+    FMSTR_SIZE zipBlkSize;        /* size of one block */
+    FMSTR_SIZE zipBlkCount;       /* number of blocks */
+    FMSTR_SIZE zipBlkUsed;        /* blocks written since the recorder start */
+    FMSTR_SIZE zipBlkIx;          /* block being written */
+    FMSTR_SIZE zipPointMax;       /* worst case size of one encoded point */
+    FMSTR_U32 zipPntCnt;          /* points recorded since the recorder start */
+    FMSTR_U32 zipOldest;          /* number of the oldest point still stored */
+#endif
 } FMSTR_REC;
 
 /* pointer to FMSTR_REC (potentially far on some platforms) */
@@ -151,6 +168,15 @@ FMSTR_TYPEDEF_LPTR(FMSTR_REC, FMSTR_LP_REC);
 /**                                         **/
 /*********************************************/
 
+/* With FMSTR_REC_COMPRESS the samples buffer holds the array of the first
+   point numbers (one FMSTR_U32 per block) followed by equally sized blocks.
+   Each point is stored as zig-zag ULEB deltas of its variables, the first
+   point of a block as deltas to zero, so any block decodes on its own and
+   the oldest block is dropped when the ring wraps. The PC reads the decoded
+   points from an address range of their own which has no memory behind it. */
+#define FMSTR_REC_VIEW_BASE(recIndex) \
+    ((FMSTR_ADDR)FMSTR_REC_VIEW_ADDR + ((FMSTR_SIZE)(recIndex) * (FMSTR_SIZE)FMSTR_REC_VIEW_SPAN))
+
 /********************************************************
  *  local static functions declarations
  ********************************************************/
@@ -195,6 +221,21 @@ static FMSTR_BOOL _FMSTR_CompareDouble(FMSTR_LP_REC_VAR_DATA varData);
 
 static void _FMSTR_Recorder2(FMSTR_LP_REC recorder);
 
+#if FMSTR_REC_COMPRESS > 0
+static FMSTR_LP_REC _FMSTR_GetRecorderByViewAddr(FMSTR_ADDR addr, FMSTR_SIZE size);
+static FMSTR_BOOL _FMSTR_RecZipLayout(FMSTR_LP_REC recorder, FMSTR_SIZE pointMax);
+static void _FMSTR_RecZipNextBlock(FMSTR_LP_REC recorder);
+static void _FMSTR_RecZipLimitPoints(FMSTR_LP_REC recorder, FMSTR_SIZE pointCount);
+static FMSTR_ADDR _FMSTR_RecZipVar(FMSTR_LP_REC_VAR_DATA varData, FMSTR_ADDR out);
+static FMSTR_BPTR _FMSTR_RecUnzipVar(FMSTR_LP_REC_VAR_DATA varData, FMSTR_BPTR in);
+static FMSTR_SIZE _FMSTR_RecZipPointCount(FMSTR_LP_REC recorder);
+static FMSTR_SIZE _FMSTR_RecZipFindBlock(FMSTR_LP_REC recorder, FMSTR_U32 pntNum);
+#else
+static void _FMSTR_RecBuildCopyPlan(FMSTR_LP_REC recorder);
+static void _FMSTR_RecCloseCopyRun(FMSTR_LP_REC recorder, FMSTR_SIZE runIx, FMSTR_SIZE endIx, FMSTR_SIZE runOffset);
+static void _FMSTR_RecCopyWords(FMSTR_ADDR destAddr, FMSTR_ADDR srcAddr, FMSTR_SIZE size);
+#endif
+
 /********************************************************
  *  static variables
  ********************************************************/
@@ -922,7 +963,13 @@ FMSTR_BPTR FMSTR_GetRecCmd(FMSTR_SESSION * session, FMSTR_BPTR msgBuffIO, FMSTR_
                 else
                 {
                     /* Put Raw Size of recorder buffer */
+#if FMSTR_REC_COMPRESS > 0
+                    /* upper limit of the points the PC may request, the recorder lowers the count
+                       to the points its blocks actually hold, see _FMSTR_RecZipLimitPoints */
+                    response = FMSTR_SizeToBuffer(response, recorderBuff->size * FMSTR_REC_COMPRESS_RATIO);
+#else
                     response = FMSTR_SizeToBuffer(response, recorderBuff->size);
+#endif
                     /* Put Base period of the recorder */
                     response = FMSTR_ULebToBuffer(response, recorderBuff->basePeriod_ns);
                     /* Put Size of recorder structure */
@@ -965,15 +1012,25 @@ FMSTR_BPTR FMSTR_GetRecCmd(FMSTR_SESSION * session, FMSTR_BPTR msgBuffIO, FMSTR_
                     }
                     else
                     {
+#if FMSTR_REC_COMPRESS > 0
+                        /* compressed points are read decoded, oldest point first */
+                        FMSTR_SIZE recFirstPnt = 0U;
+                        FMSTR_SIZE recPntCnt   = _FMSTR_RecZipPointCount(recorder);
+#else
                         FMSTR_S32 byteIx       = (FMSTR_S32)(recorder->writePtr - recorder->buffAddr);
                         FMSTR_SIZE currIx      = (FMSTR_SIZE)(((FMSTR_U32)byteIx) / recorder->pointSize);
                         FMSTR_SIZE recFirstPnt = recorder->flags.flg.isVirginCycle != 0U ? 0U : currIx;
                         FMSTR_SIZE recPntCnt   = recorder->flags.flg.isVirginCycle != 0U ? currIx : recorder->totalSmplsCnt;
+#endif
 
                         /* count of recorded variables */
                         response = FMSTR_ValueToBuffer8(response, recorder->pointVarCount);
                         /* base address of recorder buffer */
+#if FMSTR_REC_COMPRESS > 0
+                        response = FMSTR_AddressToBuffer(response, FMSTR_REC_VIEW_BASE(recIndex));
+#else
                         response = FMSTR_AddressToBuffer(response, recorder->buffAddr);
+#endif
                         /* size of the one set of the recorder point */
                         response = FMSTR_SizeToBuffer(response, recorder->pointSize);
                         /* count of currently stored points  */
@@ -1095,6 +1152,15 @@ static FMSTR_U8 _FMSTR_StartRec(FMSTR_LP_REC recorder)
     /* initialize write pointer */
     recorder->writePtr = recorder->buffAddr;
 
+#if FMSTR_REC_COMPRESS > 0
+    /* the first sample opens block 0 */
+    recorder->endBuffPtr  = recorder->writePtr;
+    recorder->zipBlkIx    = recorder->zipBlkCount - 1U;
+    recorder->zipBlkUsed  = 0U;
+    recorder->zipPntCnt   = 0U;
+    recorder->zipOldest   = 0U;
+#endif
+
     /* initialize time divisor */
     recorder->timeDivCtr = 0U;
 
@@ -1197,9 +1263,184 @@ FMSTR_BOOL FMSTR_IsInRecBuffer(FMSTR_ADDR addr, FMSTR_SIZE size)
         }
     }
 
+#if FMSTR_REC_COMPRESS > 0
+    /* decoded points */
+    return (FMSTR_BOOL)(_FMSTR_GetRecorderByViewAddr(addr, size) != NULL ? FMSTR_TRUE : FMSTR_FALSE);
+#else
     return FMSTR_FALSE;
+#endif
+}
+
+#if FMSTR_REC_COMPRESS > 0
+
+/******************************************************************************
+ *
+ * @brief    Find the recorder whose decoded points hold given address range
+ *
+ * @param    addr - address as reported by GETREC INFO
+ * @param    size - size of the memory to be checked
+ *
+ * @return   Recorder structure or NULL
+ *
+ * The decoded points of each recorder are read from FMSTR_REC_VIEW_BASE, the
+ * range is as long as the points configured and has no real memory behind it.
+ *
+ ******************************************************************************/
+
+static FMSTR_LP_REC _FMSTR_GetRecorderByViewAddr(FMSTR_ADDR addr, FMSTR_SIZE size)
+{
+    FMSTR_LP_REC recorder;
+    FMSTR_ADDR viewAddr;
+    FMSTR_INDEX i;
+
+    for (i = 0; i < (FMSTR_INDEX)FMSTR_USE_RECORDER; i++)
+    {
+        /* Get the recorder */
+        if ((recorder = _FMSTR_GetRecorderByRecIx(i)) != NULL && recorder->flags.flg.isConfigured != 0U)
+        {
+            viewAddr = FMSTR_REC_VIEW_BASE(i);
+
+            if (addr >= viewAddr)
+            {
+                if ((addr + size) <= (viewAddr + (recorder->totalSmplsCnt * recorder->pointSize)))
+                {
+                    return recorder;
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ *
+ * @brief    Copy decoded recorder points to the communication buffer
+ *
+ * @param    destBuff - communication buffer
+ * @param    srcAddr - address of the decoded points as reported by GETREC INFO
+ * @param    size - number of bytes to copy
+ *
+ * @return   Pointer just behind the copied data
+ *
+ * This function is called by READMEM for addresses accepted by FMSTR_IsInRecBuffer,
+ * the compressed buffer itself is copied as it is. Points are decoded from the start of their block, sequential points are decoded
+ * incrementally. Points not recorded yet read as zeroes.
+ *
+ ******************************************************************************/
+
+FMSTR_BPTR FMSTR_CopyRecToBuffer(FMSTR_BPTR destBuff, FMSTR_ADDR srcAddr, FMSTR_SIZE size)
+{
+    FMSTR_LP_REC recorder = _FMSTR_GetRecorderByViewAddr(srcAddr, size);
+    FMSTR_LP_REC_VAR_DATA recVarData;
+    FMSTR_BPTR in       = NULL;
+    FMSTR_SIZE inBlk    = 0U;
+    FMSTR_U32 inPntNum  = 0U;
+    FMSTR_SIZE pntCount = 0U;
+    FMSTR_SIZE byteIx, pntIx, pntOffset, len, blk;
+    FMSTR_SIZE varOffset, a, b;
+    FMSTR_U32 pntNum;
+    FMSTR_SIZE i;
+
+    if (recorder == NULL)
+    {
+        return FMSTR_CopyToBuffer(destBuff, srcAddr, size);
+    }
+
+    if (recorder->flags.flg.isConfigured != 0U && recorder->flags.flg.hasData != 0U)
+    {
+        pntCount = _FMSTR_RecZipPointCount(recorder);
+    }
+
+    /* offset in the span of the recorder */
+    byteIx    = (FMSTR_SIZE)(srcAddr - FMSTR_REC_VIEW_BASE(0)) % (FMSTR_SIZE)FMSTR_REC_VIEW_SPAN;
+    pntIx     = pntCount > 0U ? byteIx / recorder->pointSize : 0U;
+    pntOffset = pntCount > 0U ? byteIx % recorder->pointSize : byteIx;
+
+    while (size > 0U)
+    {
+        len = pntCount > 0U ? recorder->pointSize - pntOffset : size;
+        if (len > size)
+        {
+            len = size;
+        }
+
+        if (pntIx >= pntCount)
+        {
+            FMSTR_MemSet(destBuff, 0, len);
+            destBuff += len;
+        }
+        else
+        {
+            pntNum = recorder->zipPntCnt - pntCount + pntIx;
+            blk    = _FMSTR_RecZipFindBlock(recorder, pntNum);
+
+            /* restart at the block beginning unless continuing with the next point */
+            if (in == NULL || blk != inBlk || inPntNum > pntNum)
+            {
+                in       = (FMSTR_BPTR)FMSTR_CAST_ADDR_TO_PTR(recorder->zipBlocks + blk * recorder->zipBlkSize);
+                inBlk    = blk;
+                inPntNum = recorder->zipBlkFirst[blk];
+
+                recVarData = recorder->varDescr;
+                for (i = 0U; i < recorder->config.varCount; i++)
+                {
+                    recVarData->zipDecVal.u64 = 0U;
+                    recVarData++;
+                }
+            }
+
+            /* decode up to the requested point */
+            while (inPntNum <= pntNum)
+            {
+                recVarData = recorder->varDescr;
+                for (i = 0U; i < recorder->config.varCount; i++)
+                {
+                    if ((recVarData->cfg.triggerMode & FMSTR_REC_TRG_F_TRGONLY) == 0U)
+                    {
+                        in = _FMSTR_RecUnzipVar(recVarData, in);
+                    }
+                    recVarData++;
+                }
+                inPntNum++;
+            }
+
+            /* copy the requested part of the point */
+            recVarData = recorder->varDescr;
+            varOffset  = 0U;
+            for (i = 0U; i < recorder->config.varCount; i++)
+            {
+                if ((recVarData->cfg.triggerMode & FMSTR_REC_TRG_F_TRGONLY) == 0U)
+                {
+                    a = pntOffset > varOffset ? pntOffset : varOffset;
+                    b = varOffset + recVarData->cfg.size;
+                    if (b > pntOffset + len)
+                    {
+                        b = pntOffset + len;
+                    }
+
+                    if (a < b)
+                    {
+                        destBuff = FMSTR_CopyToBuffer(
+                            destBuff, FMSTR_CAST_PTR_TO_ADDR(&recVarData->zipDecVal.raw[a - varOffset]), b - a);
+                    }
+
+                    varOffset += recVarData->cfg.size;
+                }
+                recVarData++;
+            }
+        }
+
+        size -= len;
+        pntOffset = 0U;
+        pntIx++;
+    }
+
+    return destBuff;
 }
 
+#endif /* FMSTR_REC_COMPRESS */
+
 /******************************************************************************
  *
  * @brief    Check the configuration of the recorder
@@ -1215,6 +1456,10 @@ static FMSTR_U8 _FMSTR_CheckConfiguration(FMSTR_LP_REC recorder)
     FMSTR_SIZE pointVarCount = 0U;
     FMSTR_SIZE blen          = 0U;
     FMSTR_SIZE totalSmpls    = 0;
+    FMSTR_SIZE buffSize      = recorder->buffSize;
+#if FMSTR_REC_COMPRESS > 0
+    FMSTR_SIZE pointMax      = 0U;
+#endif
     FMSTR_SIZE8 i;
 
     if (recorder->flags.flg.isConfigured == 0U)
@@ -1238,6 +1483,10 @@ static FMSTR_U8 _FMSTR_CheckConfiguration(FMSTR_LP_REC recorder)
             {
                 pointSize += size;
                 pointVarCount++;
+#if FMSTR_REC_COMPRESS > 0
+                /* ULEB carries 7 bits per byte */
+                pointMax += (size * 8U + 6U) / 7U;
+#endif
             }
         }
 
@@ -1247,6 +1496,21 @@ static FMSTR_U8 _FMSTR_CheckConfiguration(FMSTR_LP_REC recorder)
             return FMSTR_STC_INVSIZE;
         }
 
+#if FMSTR_REC_COMPRESS > 0
+        if (_FMSTR_RecZipLayout(recorder, pointMax) == FMSTR_FALSE)
+        {
+            return FMSTR_STC_INVSIZE;
+        }
+
+        /* number of points is only an upper limit, it is lowered to the points actually stored
+           when the oldest block has to be dropped before all of them are recorded */
+        buffSize *= FMSTR_REC_COMPRESS_RATIO;
+        if (buffSize > (FMSTR_SIZE)FMSTR_REC_VIEW_SPAN)
+        {
+            buffSize = (FMSTR_SIZE)FMSTR_REC_VIEW_SPAN;
+        }
+#endif
+
         /* user wants to use less sample points than maximum available */
         if (recorder->config.totalSmps != 0U)
         {
@@ -1254,7 +1518,7 @@ static FMSTR_U8 _FMSTR_CheckConfiguration(FMSTR_LP_REC recorder)
             blen = (FMSTR_SIZE)(recorder->config.totalSmps * pointSize);
 
             /* recorder memory available? */
-            if (blen > recorder->buffSize)
+            if (blen > buffSize)
             {
                 totalSmpls = 0; /* user wants more than maximu, use the maximum */
             }
@@ -1267,7 +1531,7 @@ static FMSTR_U8 _FMSTR_CheckConfiguration(FMSTR_LP_REC recorder)
         /* use maximum available memory for samples */
         if (totalSmpls == 0U)
         {
-            totalSmpls = recorder->buffSize / pointSize;
+            totalSmpls = buffSize / pointSize;
 
             /* total recorder buffer length in bytes */
             blen = (FMSTR_SIZE)(totalSmpls * pointSize);
@@ -1286,13 +1550,18 @@ static FMSTR_U8 _FMSTR_CheckConfiguration(FMSTR_LP_REC recorder)
         /* Remember samples total count*/
         recorder->totalSmplsCnt = totalSmpls;
 
-        /* remember the effective end of circular buffer */
-        recorder->endBuffPtr = FMSTR_CAST_PTR_TO_ADDR(recorder->buffAddr + (blen / FMSTR_CFG_BUS_WIDTH));
-
         /* Store variable set size */
         recorder->pointSize     = pointSize;
         recorder->pointVarCount = pointVarCount;
 
+#if FMSTR_REC_COMPRESS == 0
+        /* remember the effective end of circular buffer */
+        recorder->endBuffPtr = FMSTR_CAST_PTR_TO_ADDR(recorder->buffAddr + (blen / FMSTR_CFG_BUS_WIDTH));
+
+        /* merge variables adjacent in memory to word copies */
+        _FMSTR_RecBuildCopyPlan(recorder);
+#endif
+
         /* it was not configured before, now everything is okay */
         recorder->flags.all              = 0;
         recorder->flags.flg.isConfigured = 1U;
@@ -1449,9 +1718,11 @@ static void _FMSTR_Recorder2(FMSTR_LP_REC recorder)
 {
     FMSTR_LP_REC_VAR_DATA recVarData;
     FMSTR_PCOMPAREFUNC compareFunc;
+#if FMSTR_REC_COMPRESS == 0
     FMSTR_PREADFUNC readFunc;
+    FMSTR_SIZE sz;
+#endif
     FMSTR_SIZE8 triggerMode;
-    FMSTR_SIZE8 sz;
     FMSTR_SIZE i;
     FMSTR_BOOL cmp;
     FMSTR_U8 triggerResult;
@@ -1469,6 +1740,14 @@ static void _FMSTR_Recorder2(FMSTR_LP_REC recorder)
     recorder->timeDivCtr = recorder->config.timeDiv;
 #endif /* FMSTR_FASTREC_NO_TIME_DIVISION */
 
+#if FMSTR_REC_COMPRESS > 0
+    /* no room for a worst case point, continue with the next block */
+    if ((FMSTR_SIZE)(recorder->endBuffPtr - recorder->writePtr) < recorder->zipPointMax)
+    {
+        _FMSTR_RecZipNextBlock(recorder);
+    }
+#endif
+
     /* variable info data for the next loop processing */
     recVarData  = recorder->varDescr;
 
@@ -1521,13 +1800,21 @@ static void _FMSTR_Recorder2(FMSTR_LP_REC recorder)
         }
 
         /* Store the recorder variable to buffer */
+#if FMSTR_REC_COMPRESS > 0
         if ((triggerMode & FMSTR_REC_TRG_F_TRGONLY) == 0U)
         {
-            sz = recVarData->cfg.size;
+            recorder->writePtr = _FMSTR_RecZipVar(recVarData, recorder->writePtr);
+        }
+#else
+        if ((triggerMode & FMSTR_REC_TRG_F_TRGONLY) == 0U && recVarData->copySize != 0U)
+        {
+            sz = recVarData->copySize;
             readFunc = recVarData->readFunc;
 
-            /* Use optimized value-copy routine, otherwise use normal copy */
-            if (readFunc != NULL)
+            /* Copy merged run of variables by words, otherwise use optimized value-copy routine or normal copy */
+            if (sz > recVarData->cfg.size)
+                _FMSTR_RecCopyWords(recorder->writePtr, recVarData->cfg.addr, sz);
+            else if (readFunc != NULL)
                 readFunc(recorder->writePtr, recVarData->cfg.addr);
             else
                 FMSTR_MemCpyFrom(recorder->writePtr, recVarData->cfg.addr, sz);
@@ -1535,6 +1822,7 @@ static void _FMSTR_Recorder2(FMSTR_LP_REC recorder)
             sz /= FMSTR_CFG_BUS_WIDTH;
             recorder->writePtr += sz;
         }
+#endif
 
         /* advance to next variable (MISRA does not let to do it in the for() statement */
         recVarData++;
@@ -1543,12 +1831,22 @@ static void _FMSTR_Recorder2(FMSTR_LP_REC recorder)
     /* We now have at least some data*/
     recorder->flags.flg.hasData = 1U;
 
+#if FMSTR_REC_COMPRESS > 0
+    recorder->zipPntCnt++;
+
+    /* all requested points stored ? */
+    if ((recorder->zipPntCnt - recorder->zipOldest) >= recorder->totalSmplsCnt)
+    {
+        recorder->flags.flg.isVirginCycle = 0U;
+    }
+#else
     /* wrap around (circular buffer) ? */
     if (recorder->writePtr >= recorder->endBuffPtr)
     {
         recorder->writePtr                = recorder->buffAddr;
         recorder->flags.flg.isVirginCycle = 0U;
     }
+#endif
 
     /* in stopping mode ? (note that this bit might have been set just above!) */
     if (recorder->flags.flg.isStopping != 0U)
@@ -1568,6 +1866,395 @@ static void _FMSTR_Recorder2(FMSTR_LP_REC recorder)
     FMSTR_UNUSED(triggerResult);
 }
 
+
+#if FMSTR_REC_COMPRESS > 0
+
+/******************************************************************************
+ *
+ * @brief    Split the samples buffer to compressed blocks
+ *
+ * @param    recorder - recorder structure
+ * @param    pointMax - worst case size of one encoded point
+ *
+ * @return   FMSTR_FALSE when the buffer is too small for two blocks
+ *
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_RecZipLayout(FMSTR_LP_REC recorder, FMSTR_SIZE pointMax)
+{
+    FMSTR_SIZE blkSize = FMSTR_REC_COMPRESS_BLOCK;
+
+    /* every block holds at least one point */
+    if (blkSize < pointMax)
+    {
+        blkSize = pointMax;
+    }
+
+    /* one block is dropped when the ring wraps, keep at least one more */
+    recorder->zipBlkCount = recorder->buffSize / (blkSize + (FMSTR_SIZE)sizeof(FMSTR_U32));
+    if (recorder->zipBlkCount < 2U)
+    {
+        return FMSTR_FALSE;
+    }
+
+    /* samples buffer is aligned to FMSTR_REC_STRUCT_ALIGN */
+    recorder->zipBlkFirst = (FMSTR_LP_U32)FMSTR_CAST_ADDR_TO_PTR(recorder->buffAddr);
+    recorder->zipBlocks   = recorder->buffAddr + recorder->zipBlkCount * (FMSTR_SIZE)sizeof(FMSTR_U32);
+    recorder->zipBlkSize  = blkSize;
+    recorder->zipPointMax = pointMax;
+
+    return FMSTR_TRUE;
+}
+
+/******************************************************************************
+ *
+ * @brief    Continue recording in the next block, overwriting the oldest one
+ *
+ ******************************************************************************/
+
+static void _FMSTR_RecZipNextBlock(FMSTR_LP_REC recorder)
+{
+    FMSTR_LP_REC_VAR_DATA recVarData = recorder->varDescr;
+    FMSTR_SIZE blkIx                 = recorder->zipBlkIx + 1U;
+    FMSTR_SIZE i;
+
+    if (blkIx >= recorder->zipBlkCount)
+    {
+        blkIx = 0U;
+    }
+
+    if (recorder->zipBlkUsed < recorder->zipBlkCount)
+    {
+        recorder->zipBlkUsed++;
+    }
+    else
+    {
+        /* history now starts with the block following the overwritten one */
+        recorder->zipOldest = recorder->zipBlkFirst[(blkIx + 1U) % recorder->zipBlkCount];
+
+        /* buffer is full, the points it holds are its capacity for this data */
+        recorder->flags.flg.isVirginCycle = 0U;
+        _FMSTR_RecZipLimitPoints(recorder, (FMSTR_SIZE)(recorder->zipPntCnt - recorder->zipOldest));
+    }
+
+    recorder->zipBlkIx           = blkIx;
+    recorder->zipBlkFirst[blkIx] = recorder->zipPntCnt;
+    recorder->writePtr           = recorder->zipBlocks + blkIx * recorder->zipBlkSize;
+    recorder->endBuffPtr         = recorder->writePtr + recorder->zipBlkSize;
+
+    /* the first point of a block is encoded as a delta to zero */
+    for (i = 0U; i < recorder->config.varCount; i++)
+    {
+        recVarData->zipLastVal.u64 = 0U;
+        recVarData++;
+    }
+}
+
+/******************************************************************************
+ *
+ * @brief    Lower the number of recorded points to the capacity of the buffer
+ *
+ * @param    recorder - recorder structure
+ * @param    pointCount - points stored in the blocks kept when the oldest one was dropped
+ *
+ * The point count requested by the PC was sized by FMSTR_REC_COMPRESS_RATIO.
+ * When the data compress worse, the count and the post-trigger are lowered so
+ * that the PC reads stored points only and the trigger point stays in the buffer.
+ *
+ ******************************************************************************/
+
+static void _FMSTR_RecZipLimitPoints(FMSTR_LP_REC recorder, FMSTR_SIZE pointCount)
+{
+    FMSTR_SIZE postTrigger;
+    FMSTR_SIZE done;
+
+    if (pointCount == 0U || pointCount >= recorder->totalSmplsCnt)
+    {
+        return;
+    }
+
+    /* same split as _FMSTR_CheckConfiguration */
+    if (recorder->config.preTrigger < pointCount)
+    {
+        postTrigger = (FMSTR_SIZE)(pointCount - recorder->config.preTrigger - 1U);
+    }
+    else
+    {
+        postTrigger = (FMSTR_SIZE)(pointCount - 1U);
+    }
+
+    /* stop countdown running, the points already recorded after the trigger count to the new post-trigger */
+    if (recorder->flags.flg.isStopping != 0U)
+    {
+        done = recorder->postTrigger - recorder->stopRecCountDown;
+        recorder->stopRecCountDown = done < postTrigger ? postTrigger - done : 0U;
+    }
+
+    recorder->postTrigger   = postTrigger;
+    recorder->totalSmplsCnt = pointCount;
+}
+
+/******************************************************************************
+ *
+ * @brief    Sample one variable and store it as a zig-zag ULEB delta
+ *
+ * @param    varData - recorder variable
+ * @param    out - write pointer in the current block
+ *
+ * @return   Write pointer behind the encoded value
+ *
+ * Zig-zag mapping turns small deltas of both signs to small unsigned numbers,
+ * so slowly changing signals encode to one or two bytes per variable. The
+ * arithmetic wraps at the variable width, any bit pattern is reproduced
+ * exactly (floating point variables included).
+ *
+ ******************************************************************************/
+
+static FMSTR_ADDR _FMSTR_RecZipVar(FMSTR_LP_REC_VAR_DATA varData, FMSTR_ADDR out)
+{
+    FMSTR_REC_THRESHOLD zz;
+    FMSTR_ADDR src = varData->cfg.addr;
+    FMSTR_BPTR dest;
+
+    switch (varData->cfg.size)
+    {
+        case 1:
+        {
+            FMSTR_U8 v = FMSTR_GetU8(src);
+            FMSTR_U8 d = (FMSTR_U8)(v - varData->zipLastVal.u8);
+            zz.u8      = (FMSTR_U8)(((FMSTR_U32)d << 1) ^ (0U - ((FMSTR_U32)d >> 7)));
+            varData->zipLastVal.u8 = v;
+            break;
+        }
+        case 2:
+        {
+            FMSTR_U16 v = FMSTR_GetU16(src);
+            FMSTR_U16 d = (FMSTR_U16)(v - varData->zipLastVal.u16);
+            zz.u16      = (FMSTR_U16)(((FMSTR_U32)d << 1) ^ (0U - ((FMSTR_U32)d >> 15)));
+            varData->zipLastVal.u16 = v;
+            break;
+        }
+        case 4:
+        {
+            FMSTR_U32 v = FMSTR_GetU32(src);
+            FMSTR_U32 d = v - varData->zipLastVal.u32;
+            zz.u32      = (d << 1) ^ (0U - (d >> 31));
+            varData->zipLastVal.u32 = v;
+            break;
+        }
+        default:
+        {
+            FMSTR_U64 v = FMSTR_GetU64(src);
+            FMSTR_U64 d = v - varData->zipLastVal.u64;
+            zz.u64      = (d << 1) ^ ((FMSTR_U64)0U - (d >> 63));
+            varData->zipLastVal.u64 = v;
+            break;
+        }
+    }
+
+    dest = FMSTR_UlebEncode((FMSTR_BPTR)FMSTR_CAST_ADDR_TO_PTR(out), &zz, varData->cfg.size);
+    return FMSTR_CAST_PTR_TO_ADDR(dest);
+}
+
+/******************************************************************************
+ *
+ * @brief    Decode one variable stored by _FMSTR_RecZipVar
+ *
+ * @param    varData - recorder variable, zipDecVal holds the previous value
+ * @param    in - read pointer in the block
+ *
+ * @return   Read pointer behind the encoded value
+ *
+ ******************************************************************************/
+
+static FMSTR_BPTR _FMSTR_RecUnzipVar(FMSTR_LP_REC_VAR_DATA varData, FMSTR_BPTR in)
+{
+    FMSTR_REC_THRESHOLD zz;
+
+    in = FMSTR_UlebDecode(in, &zz, varData->cfg.size);
+
+    switch (varData->cfg.size)
+    {
+        case 1:
+            varData->zipDecVal.u8 += (FMSTR_U8)(((FMSTR_U32)zz.u8 >> 1) ^ (0U - ((FMSTR_U32)zz.u8 & 1U)));
+            break;
+        case 2:
+            varData->zipDecVal.u16 += (FMSTR_U16)(((FMSTR_U32)zz.u16 >> 1) ^ (0U - ((FMSTR_U32)zz.u16 & 1U)));
+            break;
+        case 4:
+            varData->zipDecVal.u32 += (zz.u32 >> 1) ^ (0U - (zz.u32 & 1U));
+            break;
+        default:
+            varData->zipDecVal.u64 += (zz.u64 >> 1) ^ ((FMSTR_U64)0U - (zz.u64 & 1U));
+            break;
+    }
+
+    return in;
+}
+
+/******************************************************************************
+ *
+ * @brief    Get number of points readable by the PC
+ *
+ ******************************************************************************/
+
+static FMSTR_SIZE _FMSTR_RecZipPointCount(FMSTR_LP_REC recorder)
+{
+    FMSTR_U32 count = recorder->zipPntCnt - recorder->zipOldest;
+
+    /* present the most recent points when more than requested fit into the buffer */
+    if (count > (FMSTR_U32)recorder->totalSmplsCnt)
+    {
+        count = (FMSTR_U32)recorder->totalSmplsCnt;
+    }
+
+    return (FMSTR_SIZE)count;
+}
+
+/******************************************************************************
+ *
+ * @brief    Find the block holding given point
+ *
+ * @param    recorder - recorder structure
+ * @param    pntNum - point number, must be stored in the buffer
+ *
+ * @return   Block index
+ *
+ ******************************************************************************/
+
+static FMSTR_SIZE _FMSTR_RecZipFindBlock(FMSTR_LP_REC recorder, FMSTR_U32 pntNum)
+{
+    FMSTR_SIZE blkIx = recorder->zipBlkIx;
+    FMSTR_SIZE i;
+
+    /* walk from the newest block back, point numbers compare relative to the oldest point */
+    for (i = 1U; i < recorder->zipBlkUsed; i++)
+    {
+        if ((recorder->zipBlkFirst[blkIx] - recorder->zipOldest) <= (pntNum - recorder->zipOldest))
+        {
+            break;
+        }
+
+        blkIx = blkIx > 0U ? blkIx - 1U : recorder->zipBlkCount - 1U;
+    }
+
+    return blkIx;
+}
+
+#else /* FMSTR_REC_COMPRESS */
+
+/******************************************************************************
+ *
+ * @brief    Precompile the variable list to a copy plan
+ *
+ * Variables following each other both in memory and in the recorder point
+ * are merged to one run copied by aligned 32-bit words. Runs which can not
+ * be copied by words fall back to the per-variable copy routines.
+ *
+ ******************************************************************************/
+
+static void _FMSTR_RecBuildCopyPlan(FMSTR_LP_REC recorder)
+{
+    FMSTR_LP_REC_VAR_DATA recVarData = recorder->varDescr;
+    FMSTR_LP_REC_VAR_DATA runHead    = NULL;
+    FMSTR_SIZE runIx                 = 0U;
+    FMSTR_SIZE runOffset             = 0U;
+    FMSTR_SIZE offset                = 0U;
+    FMSTR_SIZE i;
+
+    for (i = 0U; i < recorder->config.varCount; i++)
+    {
+        recVarData->copySize = 0U;
+
+        if ((recVarData->cfg.triggerMode & FMSTR_REC_TRG_F_TRGONLY) == 0U)
+        {
+            if (runHead != NULL && recVarData->cfg.addr == (runHead->cfg.addr + runHead->copySize))
+            {
+                /* extend the run */
+                runHead->copySize += recVarData->cfg.size;
+            }
+            else
+            {
+                if (runHead != NULL)
+                {
+                    _FMSTR_RecCloseCopyRun(recorder, runIx, i, runOffset);
+                }
+
+                runHead              = recVarData;
+                runHead->copySize    = recVarData->cfg.size;
+                runIx                = i;
+                runOffset            = offset;
+            }
+
+            offset += recVarData->cfg.size;
+        }
+
+        recVarData++;
+    }
+
+    if (runHead != NULL)
+    {
+        _FMSTR_RecCloseCopyRun(recorder, runIx, recorder->config.varCount, runOffset);
+    }
+}
+
+/******************************************************************************
+ *
+ * @brief    Keep the run as one word copy or split it back to variables
+ *
+ * @param    recorder - recorder structure
+ * @param    runIx - index of the first variable of the run
+ * @param    endIx - index following the last variable of the run
+ * @param    runOffset - offset of the run in the recorder point
+ *
+ ******************************************************************************/
+
+static void _FMSTR_RecCloseCopyRun(FMSTR_LP_REC recorder, FMSTR_SIZE runIx, FMSTR_SIZE endIx, FMSTR_SIZE runOffset)
+{
+    FMSTR_LP_REC_VAR_DATA recVarData = &recorder->varDescr[runIx];
+    FMSTR_SIZE runSize               = recVarData->copySize;
+
+    /* single variable uses its own copy routine */
+    if (runSize == recVarData->cfg.size)
+    {
+        return;
+    }
+
+    /* source, destination in every point and length must all be word aligned */
+    if ((runSize % 4U) == 0U && (recorder->pointSize % 4U) == 0U &&
+        FMSTR_GetAlignmentCorrection(recVarData->cfg.addr, 4U) == 0U &&
+        FMSTR_GetAlignmentCorrection(recorder->buffAddr + runOffset, 4U) == 0U)
+    {
+        return;
+    }
+
+    for (; runIx < endIx; runIx++)
+    {
+        recVarData->copySize =
+            (recVarData->cfg.triggerMode & FMSTR_REC_TRG_F_TRGONLY) == 0U ? recVarData->cfg.size : 0U;
+        recVarData++;
+    }
+}
+
+/******************************************************************************
+ *
+ * @brief    Copy merged run of variables, both addresses and size are word aligned
+ *
+ ******************************************************************************/
+
+static void _FMSTR_RecCopyWords(FMSTR_ADDR destAddr, FMSTR_ADDR srcAddr, FMSTR_SIZE size)
+{
+    FMSTR_LP_U32 dest32 = (FMSTR_LP_U32)FMSTR_CAST_ADDR_TO_PTR(destAddr);
+    FMSTR_LP_U32 src32  = (FMSTR_LP_U32)FMSTR_CAST_ADDR_TO_PTR(srcAddr);
+
+    for (size /= 4U; size > 0U; size--)
+    {
+        *dest32++ = *src32++;
+    }
+}
+
+#endif /* FMSTR_REC_COMPRESS */
+
 #else /* FMSTR_USE_RECORDER && (!FMSTR_DISABLE) */
 
 FMSTR_BOOL FMSTR_RecorderCreate(FMSTR_INDEX recIndex, FMSTR_REC_BUFF *buffCfg)
@@ -81,10 +81,14 @@ FMSTR_BPTR FMSTR_StringCopyToBuffer(FMSTR_BPTR out, const FMSTR_CHAR *pStr);
 void FMSTR_Crc16Init(FMSTR_U16 *crc);
 /* Add new byte to CRC16 calculation. */
 void FMSTR_Crc16AddByte(FMSTR_U16 *crc, FMSTR_U8 data);
+/* Add block of bytes to CRC16 calculation. */
+void FMSTR_Crc16AddBlock(FMSTR_U16 *crc, FMSTR_BPTR data, FMSTR_SIZE size);
 /* Initialize CRC8 calculation. */
 void FMSTR_Crc8Init(FMSTR_U8 *crc);
 /* Add new byte to CRC8 calculation. */
 void FMSTR_Crc8AddByte(FMSTR_U8 *crc, FMSTR_U8 data);
+/* Add block of bytes to CRC8 calculation. */
+void FMSTR_Crc8AddBlock(FMSTR_U8 *crc, FMSTR_BPTR data, FMSTR_SIZE size);
 
 /* Get array of random numbers */
 FMSTR_BPTR FMSTR_RandomNumbersToBuffer(FMSTR_BPTR out, FMSTR_SIZE length);
@@ -19,6 +19,7 @@
 #ifndef _FREEMASTER_GEN32LE_H
 #define _FREEMASTER_GEN32LE_H
 
+#include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -53,12 +54,12 @@ typedef unsigned int FMSTR_BOOL;    /* general boolean type  */
 
 typedef unsigned char FMSTR_U8;       /* smallest memory entity */
 typedef unsigned short FMSTR_U16;     /* 16bit value */
-typedef unsigned long FMSTR_U32;      /* 32bit value */
+typedef uint32_t FMSTR_U32;           /* 32bit value, also where long is wider (host builds) */
 typedef unsigned long long FMSTR_U64; /* 64bit value */
 
 typedef signed char FMSTR_S8;       /* signed 8bit value */
 typedef signed short FMSTR_S16;     /* signed 16bit value */
-typedef signed long FMSTR_S32;      /* signed 32bit value */
+typedef int32_t FMSTR_S32;          /* signed 32bit value */
 typedef signed long long FMSTR_S64; /* signed 64bit value */
 
 typedef float FMSTR_FLOAT;   /* float value */
@@ -9,6 +9,7 @@ message("${CMAKE_CURRENT_LIST_FILE} component is included.")
           ${CMAKE_CURRENT_LIST_DIR}/RTX/Source/rtx_evr.c
           ${CMAKE_CURRENT_LIST_DIR}/RTX/Source/rtx_kernel.c
           ${CMAKE_CURRENT_LIST_DIR}/RTX/Source/rtx_memory.c
+          ${CMAKE_CURRENT_LIST_DIR}/RTX/Source/rtx_memory_tlsf.c
           ${CMAKE_CURRENT_LIST_DIR}/RTX/Source/rtx_mempool.c
           ${CMAKE_CURRENT_LIST_DIR}/RTX/Source/rtx_msgqueue.c
           ${CMAKE_CURRENT_LIST_DIR}/RTX/Source/rtx_mutex.c
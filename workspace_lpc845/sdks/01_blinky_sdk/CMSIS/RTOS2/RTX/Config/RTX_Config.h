@@ -47,6 +47,15 @@
 #define OS_DYNAMIC_MEM_SIZE         32768
 #endif
  
+//   <q>TLSF memory allocator
+//   <i> Allocates dynamic memory with a Two-Level Segregated Fit allocator instead of first-fit (requires RTX source variant).
+//   <i> Allocating and freeing a memory block take bounded time instead of a walk over the allocated blocks.
+//   <i> Keep first-fit for small pools of few objects, it is faster there and fragments less.
+//   <i> The RTX5 debugger view of the dynamic memory does not understand the TLSF pool layout.
+#ifndef OS_MEMORY_TLSF
+#define OS_MEMORY_TLSF              0
+#endif
+ 
 //   <o>Kernel Tick Frequency [Hz] <1-1000000>
 //   <i> Defines base time unit for delays and timeouts.
 //   <i> Default: 1000 (1ms tick)
@@ -54,6 +63,13 @@
 #define OS_TICK_FREQ                1000
 #endif
  
+//   <q>Delay and Timer wheel
+//   <i> Keeps delayed threads and running timers in the slots of a hierarchical timing wheel (requires RTX source variant).
+//   <i> Starting a delay or timer and processing the kernel tick take constant time instead of a walk over the sorted lists.
+#ifndef OS_DELAY_WHEEL
+#define OS_DELAY_WHEEL              0
+#endif
+ 
 //   <e>Round-Robin Thread switching
 //   <i> Enables Round-Robin Thread switching.
 #ifndef OS_ROBIN_ENABLE
@@ -225,6 +241,13 @@
 #define OS_STACK_WATERMARK          0
 #endif
  
+//   <q>Ready list priority bitmap
+//   <i> Tracks the last ready thread of each priority level and a bitmap of the occupied levels (requires RTX source variant).
+//   <i> Putting a thread into the ready list takes constant time instead of a walk over all ready threads.
+#ifndef OS_THREAD_READY_BITMAP
+#define OS_THREAD_READY_BITMAP      0
+#endif
+ 
 //   <o>Default Processor mode for Thread execution
 //     <0=> Unprivileged mode
 //     <1=> Privileged mode
@@ -58,6 +58,18 @@
  #define RTX_STACK_CHECK
 #endif
 
+#if (defined(OS_THREAD_READY_BITMAP) && (OS_THREAD_READY_BITMAP != 0))
+ #define RTX_THREAD_READY_BITMAP
+#endif
+
+#if (defined(OS_DELAY_WHEEL) && (OS_DELAY_WHEEL != 0))
+ #define RTX_DELAY_WHEEL
+#endif
+
+#if (defined(OS_MEMORY_TLSF) && (OS_MEMORY_TLSF != 0))
+ #define RTX_MEMORY_TLSF
+#endif
+
 #if (defined(OS_TZ_CONTEXT) && (OS_TZ_CONTEXT != 0))
  #define RTX_TZ_CONTEXT
 #endif
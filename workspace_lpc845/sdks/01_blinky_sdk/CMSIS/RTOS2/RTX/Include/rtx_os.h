@@ -134,7 +134,8 @@ typedef struct osRtxThread_s {
   uint32_t                thread_addr;  ///< Thread entry address
   uint32_t                  tz_memory;  ///< TrustZone Memory Identifier
   uint8_t                        zone;  ///< Thread Zone
-  uint8_t                 reserved[3];
+  uint8_t                 ready_level;  ///< Ready list Priority level
+  uint8_t                 reserved[2];
   struct osRtxThread_s     *wdog_next;  ///< Link pointer to next Thread in Watchdog list
   uint32_t                  wdog_tick;  ///< Watchdog tick counter
 } osRtxThread_t;
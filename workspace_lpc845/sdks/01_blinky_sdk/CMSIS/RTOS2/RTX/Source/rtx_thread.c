@@ -43,6 +43,20 @@ static uint8_t ThreadClassTable[64] __attribute__((section(".data.os"))) = { 0U
 static uint8_t WatchdogAlarmFlag __attribute__((section(".data.os"))) = 0U;
 #endif
 
+//  Ready list Priority levels: last Thread of each level and bitmap of occupied levels
+#ifdef RTX_THREAD_READY_BITMAP
+#define THREAD_READY_LEVELS     ((uint32_t)osPriorityISR + 1U)
+#define THREAD_READY_NONE       0xFFU
+static os_thread_t *ThreadReadyTail[THREAD_READY_LEVELS] __attribute__((section(".data.os"))) = { NULL };
+static uint32_t     ThreadReadyMap[(THREAD_READY_LEVELS + 31U) / 32U] __attribute__((section(".data.os"))) = { 0U };
+#endif
+
+//  Delay wheel: delayed Threads by expiry Tick and number of processed Ticks
+#ifdef RTX_DELAY_WHEEL
+static os_thread_t *DelayWheel[osRtxWheelSlots] __attribute__((section(".data.os"))) = { NULL };
+static uint32_t     DelayWheelTick __attribute__((section(".data.os"))) = 0U;
+#endif
+
 
 //  ==== Helper functions ====
 
@@ -208,6 +222,165 @@ static bool_t IsClassMappingValid (uint32_t attr_bits, const os_thread_t *thread
 }
 #endif
 
+#ifdef RTX_THREAD_READY_BITMAP
+/// Get number of the lowest set bit.
+/// \param[in]  value           non-zero value.
+/// \return bit number.
+static uint32_t ThreadReadyLowestBit (uint32_t value) {
+#if ((defined(__ARM_ARCH_6M__)      && (__ARM_ARCH_6M__      != 0)) || \
+     (defined(__ARM_ARCH_8M_BASE__) && (__ARM_ARCH_8M_BASE__ != 0)))
+  // No CLZ instruction, De Bruijn multiplication of the isolated bit
+  static const uint8_t DeBruijnBit[32] = {
+     0U,  1U, 28U,  2U, 29U, 14U, 24U,  3U, 30U, 22U, 20U, 15U, 25U, 17U,  4U,  8U,
+    31U, 27U, 13U, 23U, 21U, 19U, 16U,  7U, 26U, 12U, 18U,  6U, 11U,  5U, 10U,  9U
+  };
+  return DeBruijnBit[((value & (0U - value)) * 0x077CB531U) >> 27];
+#else
+  return (uint32_t)__CLZ(__RBIT(value));
+#endif
+}
+
+/// Find the last Thread in Ready list with higher priority than specified level.
+/// \param[in]  level           priority level.
+/// \return thread object or Ready list object if no Thread has higher priority.
+static os_thread_t *ThreadReadyAbove (uint32_t level) {
+  uint32_t map;
+  uint32_t n;
+
+  // Occupied levels above specified level
+  n   = level >> 5;
+  map = ThreadReadyMap[n] & ~((2U << (level & 31U)) - 1U);
+  while ((map == 0U) && ((n + 1U) < ((THREAD_READY_LEVELS + 31U) / 32U))) {
+    n++;
+    map = ThreadReadyMap[n];
+  }
+  if (map == 0U) {
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return osRtxThreadObject(&osRtxInfo.thread.ready);
+  }
+  return ThreadReadyTail[(n << 5) + ThreadReadyLowestBit(map)];
+}
+
+/// Put a Thread into Ready list at the tail or at the head of its priority level.
+/// \param[in]  thread          thread object.
+/// \param[in]  head            insert at the head of the priority level.
+static void ThreadReadyInsert (os_thread_t *thread, bool_t head) {
+  os_thread_t *prev, *next;
+  uint32_t     level;
+
+  level = (uint32_t)thread->priority;
+
+  if ((head != FALSE) || (ThreadReadyTail[level] == NULL)) {
+    prev = ThreadReadyAbove(level);
+  } else {
+    prev = ThreadReadyTail[level];
+  }
+  if ((head == FALSE) || (ThreadReadyTail[level] == NULL)) {
+    ThreadReadyTail[level] = thread;
+    ThreadReadyMap[level >> 5] |= 1U << (level & 31U);
+  }
+  thread->ready_level = (uint8_t)level;
+
+  next = prev->thread_next;
+  thread->thread_prev = prev;
+  thread->thread_next = next;
+  prev->thread_next = thread;
+  if (next != NULL) {
+    next->thread_prev = thread;
+  }
+}
+
+/// Release the priority level of a Thread before it is unlinked from Ready list.
+/// \param[in]  thread          thread object.
+static void ThreadReadyRelease (os_thread_t *thread) {
+  os_thread_t *prev;
+  uint32_t     level;
+
+  level = thread->ready_level;
+  if (ThreadReadyTail[level] == thread) {
+    prev = thread->thread_prev;
+    if ((prev != osRtxThreadObject(&osRtxInfo.thread.ready)) && (prev->ready_level == level)) {
+      ThreadReadyTail[level] = prev;
+    } else {
+      ThreadReadyTail[level] = NULL;
+      ThreadReadyMap[level >> 5] &= ~(1U << (level & 31U));
+    }
+  }
+  thread->ready_level = THREAD_READY_NONE;
+}
+#endif
+
+#ifdef RTX_DELAY_WHEEL
+/// Get Thread overlaying a Delay list head with its delay_next (previous Thread of the first one).
+/// \param[in]  list            delay list head.
+/// \return thread object.
+static os_thread_t *ThreadDelayHead (os_thread_t **list) {
+  //lint -e{9079} -e{9087} "cast between pointers to different object types"
+  return ((os_thread_t *)(void *)((uint8_t *)list - offsetof(os_thread_t, delay_next)));
+}
+
+/// Get Delay wheel slot of a Thread.
+/// \param[in]  thread          thread object in the Delay wheel.
+/// \return slot number.
+static uint32_t ThreadDelayWheelIndex (const os_thread_t *thread) {
+  os_thread_t **list;
+
+  list = &thread->delay_prev->delay_next;
+  //lint -e{946} "Relational operator applied to pointers"
+  while ((list < &DelayWheel[0]) || (list >= &DelayWheel[osRtxWheelSlots])) {
+    thread = thread->delay_prev;
+    list   = &thread->delay_prev->delay_next;
+  }
+  //lint -e{946} -e{947} "Subtract operator applied to pointers"
+  return ((uint32_t)(list - &DelayWheel[0]));
+}
+
+/// Get first Thread in the Delay wheel starting with specified slot.
+/// \param[in]  slot            slot number.
+/// \return thread object or NULL.
+static os_thread_t *ThreadDelayWheelFrom (uint32_t slot) {
+
+  while ((slot < osRtxWheelSlots) && (DelayWheel[slot] == NULL)) {
+    slot++;
+  }
+  if (slot == osRtxWheelSlots) {
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return NULL;
+  }
+  return DelayWheel[slot];
+}
+
+/// Put a Thread at the head of the Delay wheel slot of its expiry Tick (thread->delay).
+/// \param[in]  thread          thread object.
+static void ThreadDelayWheelPut (os_thread_t *thread) {
+  os_thread_t **list;
+
+  list = &DelayWheel[osRtxWheelSlot(DelayWheelTick, thread->delay)];
+  thread->delay_prev = ThreadDelayHead(list);
+  thread->delay_next = *list;
+  if (*list != NULL) {
+    (*list)->delay_prev = thread;
+  }
+  *list = thread;
+}
+
+/// Take all Threads out of a Delay wheel slot.
+/// \param[in]  slot            slot number.
+/// \return last Thread of the slot (put first) or NULL, linked back to the slot head.
+static os_thread_t *ThreadDelayWheelTake (uint32_t slot) {
+  os_thread_t *thread;
+
+  thread = DelayWheel[slot];
+  if (thread != NULL) {
+    DelayWheel[slot] = NULL;
+    while (thread->delay_next != NULL) {
+      thread = thread->delay_next;
+    }
+  }
+  return thread;
+}
+#endif
+
 
 //  ==== Library functions ====
 
@@ -218,6 +391,14 @@ void osRtxThreadListPut (os_object_t *object, os_thread_t *thread) {
   os_thread_t *prev, *next;
   int32_t      priority;
 
+#ifdef RTX_THREAD_READY_BITMAP
+  if (object == &osRtxInfo.thread.ready) {
+    ThreadReadyInsert(thread, FALSE);
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return;
+  }
+#endif
+
   priority = thread->priority;
 
   prev = osRtxThreadObject(object);
@@ -241,6 +422,11 @@ os_thread_t *osRtxThreadListGet (os_object_t *object) {
   os_thread_t *thread;
 
   thread = object->thread_list;
+#ifdef RTX_THREAD_READY_BITMAP
+  if (thread->ready_level != THREAD_READY_NONE) {
+    ThreadReadyRelease(thread);
+  }
+#endif
   object->thread_list = thread->thread_next;
   if (thread->thread_next != NULL) {
     thread->thread_next->thread_prev = osRtxThreadObject(object);
@@ -287,6 +473,11 @@ void osRtxThreadListSort (os_thread_t *thread) {
 void osRtxThreadListRemove (os_thread_t *thread) {
 
   if (thread->thread_prev != NULL) {
+#ifdef RTX_THREAD_READY_BITMAP
+    if (thread->ready_level != THREAD_READY_NONE) {
+      ThreadReadyRelease(thread);
+    }
+#endif
     thread->thread_prev->thread_next = thread->thread_next;
     if (thread->thread_next != NULL) {
       thread->thread_next->thread_prev = thread->thread_prev;
@@ -318,6 +509,191 @@ void osRtxThreadReadyPut (os_thread_t *thread) {
   osRtxThreadListPut(&osRtxInfo.thread.ready, thread);
 }
 
+/// Make a Thread Ready after its Delay or Timeout expired.
+/// \param[in]  thread          thread object.
+static void osRtxThreadDelayTimeout (os_thread_t *thread) {
+  os_object_t *object;
+
+  switch (thread->state) {
+    case osRtxThreadWaitingDelay:
+      EvrRtxDelayCompleted(thread);
+      break;
+    case osRtxThreadWaitingThreadFlags:
+      EvrRtxThreadFlagsWaitTimeout(thread);
+      break;
+    case osRtxThreadWaitingEventFlags:
+      EvrRtxEventFlagsWaitTimeout((osEventFlagsId_t)osRtxThreadListRoot(thread));
+      break;
+    case osRtxThreadWaitingMutex:
+      object = osRtxObject(osRtxThreadListRoot(thread));
+      osRtxMutexOwnerRestore(osRtxMutexObject(object), thread);
+      EvrRtxMutexAcquireTimeout(osRtxMutexObject(object));
+      break;
+    case osRtxThreadWaitingSemaphore:
+      EvrRtxSemaphoreAcquireTimeout((osSemaphoreId_t)osRtxThreadListRoot(thread));
+      break;
+    case osRtxThreadWaitingMemoryPool:
+      EvrRtxMemoryPoolAllocTimeout((osMemoryPoolId_t)osRtxThreadListRoot(thread));
+      break;
+    case osRtxThreadWaitingMessageGet:
+      EvrRtxMessageQueueGetTimeout((osMessageQueueId_t)osRtxThreadListRoot(thread));
+      break;
+    case osRtxThreadWaitingMessagePut:
+      EvrRtxMessageQueuePutTimeout((osMessageQueueId_t)osRtxThreadListRoot(thread));
+      break;
+    default:
+      // Invalid
+      break;
+  }
+  EvrRtxThreadUnblocked(thread, (osRtxThreadRegPtr(thread))[0]);
+  osRtxThreadListRemove(thread);
+  osRtxThreadReadyPut(thread);
+}
+
+#ifdef RTX_DELAY_WHEEL
+
+/// Insert a Thread into the Wait list (Delay is osWaitForever) or into the Delay wheel.
+/// \param[in]  thread          thread object.
+/// \param[in]  delay           delay value.
+static void osRtxThreadDelayInsert (os_thread_t *thread, uint32_t delay) {
+  os_thread_t *prev, *next;
+
+  if (delay == osWaitForever) {
+    prev = ThreadDelayHead(&osRtxInfo.thread.wait_list);
+    next = osRtxInfo.thread.wait_list;
+    while (next != NULL)  {
+      prev = next;
+      next = next->delay_next;
+    }
+    thread->delay = delay;
+    thread->delay_prev = prev;
+    thread->delay_next = NULL;
+    prev->delay_next = thread;
+  } else {
+    thread->delay = DelayWheelTick + delay;
+    ThreadDelayWheelPut(thread);
+  }
+}
+
+/// Remove a Thread from the Wait list or from the Delay wheel.
+/// \param[in]  thread          thread object.
+void osRtxThreadDelayRemove (os_thread_t *thread) {
+
+  if (thread->delay_next != NULL) {
+    thread->delay_next->delay_prev = thread->delay_prev;
+  }
+  thread->delay_prev->delay_next = thread->delay_next;
+  thread->delay_prev = NULL;
+  thread->delay = 0U;
+}
+
+/// Process Thread Delay Tick (executed each System Tick).
+void osRtxThreadDelayTick (void) {
+  os_thread_t *thread, *prev, *head;
+  uint32_t     level, slot;
+
+  DelayWheelTick++;
+
+  // Move Threads of higher level slots reached by the Tick towards level 0
+  level = 1U;
+  slot  = osRtxWheelCascade(DelayWheelTick, level);
+  while (slot != osRtxWheelSlots) {
+    head   = ThreadDelayHead(&DelayWheel[slot]);
+    thread = ThreadDelayWheelTake(slot);
+    while (thread != NULL) {
+      prev = thread->delay_prev;
+      ThreadDelayWheelPut(thread);
+      thread = (prev != head) ? prev : NULL;
+    }
+    level++;
+    slot = osRtxWheelCascade(DelayWheelTick, level);
+  }
+
+  // Threads in level 0 slot expire with this Tick
+  slot   = DelayWheelTick & (osRtxWheelSize - 1U);
+  head   = ThreadDelayHead(&DelayWheel[slot]);
+  thread = ThreadDelayWheelTake(slot);
+  while (thread != NULL) {
+    prev = thread->delay_prev;
+    thread->delay_prev = NULL;
+    thread->delay = 0U;
+    osRtxThreadDelayTimeout(thread);
+    thread = (prev != head) ? prev : NULL;
+  }
+}
+
+/// Get first Thread in the Delay wheel.
+/// \return thread object or NULL.
+os_thread_t *osRtxThreadDelayFirst (void) {
+  return ThreadDelayWheelFrom(0U);
+}
+
+/// Get next Thread in the Delay wheel.
+/// \param[in]  thread          thread object.
+/// \return thread object or NULL.
+os_thread_t *osRtxThreadDelayNext (const os_thread_t *thread) {
+  os_thread_t *next;
+
+  next = thread->delay_next;
+  if (next == NULL) {
+    next = ThreadDelayWheelFrom(ThreadDelayWheelIndex(thread) + 1U);
+  }
+  return next;
+}
+
+/// Get Ticks until the first Thread in the Delay wheel expires.
+/// \return ticks or osWaitForever if no Thread is delayed.
+uint32_t osRtxThreadDelaySleep (void) {
+  const os_thread_t *thread;
+  uint32_t           delay, ticks, slot;
+
+  delay = osWaitForever;
+  for (slot = 0U; slot < osRtxWheelSlots; slot++) {
+    for (thread = DelayWheel[slot]; thread != NULL; thread = thread->delay_next) {
+      ticks = thread->delay - DelayWheelTick;
+      if (ticks < delay) {
+        delay = ticks;
+      }
+    }
+  }
+  return delay;
+}
+
+/// Skip Ticks in which no Thread in the Delay wheel expires.
+/// \param[in]  ticks           number of ticks.
+void osRtxThreadDelaySkip (uint32_t ticks) {
+  os_thread_t *thread, *list, *next;
+  uint32_t     slot;
+
+  if (ticks == 0U) {
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return;
+  }
+
+  // Slots depend on the Tick, take all Threads out and put them back after the skip
+  list = NULL;
+  for (slot = 0U; slot < osRtxWheelSlots; slot++) {
+    thread = DelayWheel[slot];
+    DelayWheel[slot] = NULL;
+    while (thread != NULL) {
+      next = thread->delay_next;
+      thread->delay_next = list;
+      list = thread;
+      thread = next;
+    }
+  }
+
+  DelayWheelTick += ticks;
+
+  while (list != NULL) {
+    next = list->delay_next;
+    ThreadDelayWheelPut(list);
+    list = next;
+  }
+}
+
+#else
+
 /// Insert a Thread into the Delay list sorted by Delay (Lowest at Head).
 /// \param[in]  thread          thread object.
 /// \param[in]  delay           delay value.
@@ -394,7 +770,6 @@ void osRtxThreadDelayRemove (os_thread_t *thread) {
 /// Process Thread Delay Tick (executed each System Tick).
 void osRtxThreadDelayTick (void) {
   os_thread_t *thread;
-  os_object_t *object;
 
   thread = osRtxInfo.thread.delay_list;
   if (thread == NULL) {
@@ -406,40 +781,7 @@ void osRtxThreadDelayTick (void) {
 
   if (thread->delay == 0U) {
     do {
-      switch (thread->state) {
-        case osRtxThreadWaitingDelay:
-          EvrRtxDelayCompleted(thread);
-          break;
-        case osRtxThreadWaitingThreadFlags:
-          EvrRtxThreadFlagsWaitTimeout(thread);
-          break;
-        case osRtxThreadWaitingEventFlags:
-          EvrRtxEventFlagsWaitTimeout((osEventFlagsId_t)osRtxThreadListRoot(thread));
-          break;
-        case osRtxThreadWaitingMutex:
-          object = osRtxObject(osRtxThreadListRoot(thread));
-          osRtxMutexOwnerRestore(osRtxMutexObject(object), thread);
-          EvrRtxMutexAcquireTimeout(osRtxMutexObject(object));
-          break;
-        case osRtxThreadWaitingSemaphore:
-          EvrRtxSemaphoreAcquireTimeout((osSemaphoreId_t)osRtxThreadListRoot(thread));
-          break;
-        case osRtxThreadWaitingMemoryPool:
-          EvrRtxMemoryPoolAllocTimeout((osMemoryPoolId_t)osRtxThreadListRoot(thread));
-          break;
-        case osRtxThreadWaitingMessageGet:
-          EvrRtxMessageQueueGetTimeout((osMessageQueueId_t)osRtxThreadListRoot(thread));
-          break;
-        case osRtxThreadWaitingMessagePut:
-          EvrRtxMessageQueuePutTimeout((osMessageQueueId_t)osRtxThreadListRoot(thread));
-          break;
-        default:
-          // Invalid
-          break;
-      }
-      EvrRtxThreadUnblocked(thread, (osRtxThreadRegPtr(thread))[0]);
-      osRtxThreadListRemove(thread);
-      osRtxThreadReadyPut(thread);
+      osRtxThreadDelayTimeout(thread);
       thread = thread->delay_next;
     } while ((thread != NULL) && (thread->delay == 0U));
     if (thread != NULL) {
@@ -449,6 +791,8 @@ void osRtxThreadDelayTick (void) {
   }
 }
 
+#endif
+
 /// Get pointer to Thread registers (R0..R3)
 /// \param[in]  thread          thread object.
 /// \return pointer to registers R0-R3.
@@ -461,11 +805,16 @@ uint32_t *osRtxThreadRegPtr (const os_thread_t *thread) {
 /// Block running Thread execution and register it as Ready to Run.
 /// \param[in]  thread          running thread object.
 static void osRtxThreadBlock (os_thread_t *thread) {
+#ifndef RTX_THREAD_READY_BITMAP
   os_thread_t *prev, *next;
   int32_t      priority;
+#endif
 
   thread->state = osRtxThreadReady;
 
+#ifdef RTX_THREAD_READY_BITMAP
+  ThreadReadyInsert(thread, TRUE);
+#else
   priority = thread->priority;
 
   prev = osRtxThreadObject(&osRtxInfo.thread.ready);
@@ -481,6 +830,7 @@ static void osRtxThreadBlock (os_thread_t *thread) {
   if (next != NULL) {
     next->thread_prev = thread;
   }
+#endif
 
   EvrRtxThreadPreempted(thread);
 }
@@ -988,6 +1338,9 @@ static osThreadId_t svcRtxThreadNew (osThreadFunc_t func, void *argument, const
     thread->priority      = (int8_t)priority;
     thread->priority_base = (int8_t)priority;
     thread->stack_frame   = STACK_FRAME_INIT_VAL;
+#ifdef RTX_THREAD_READY_BITMAP
+    thread->ready_level   = THREAD_READY_NONE;
+#endif
     thread->flags_options = 0U;
     thread->wait_flags    = 0U;
     thread->thread_flags  = 0U;
@@ -1832,9 +2185,9 @@ static osStatus_t svcRtxThreadSuspendClass (uint32_t safety_class, uint32_t mode
   }
 
   // Threads in Delay List
-  thread = osRtxInfo.thread.delay_list;
+  thread = osRtxThreadDelayFirst();
   while (thread != NULL) {
-    thread_next = thread->delay_next;
+    thread_next = osRtxThreadDelayNext(thread);
     if ((((mode & osSafetyWithSameClass)  != 0U) &&
          ((thread->attr >> osRtxAttrClass_Pos) == (uint8_t)safety_class)) ||
         (((mode & osSafetyWithLowerClass) != 0U) &&
@@ -1937,9 +2290,9 @@ static osStatus_t svcRtxThreadResumeClass (uint32_t safety_class, uint32_t mode)
   }
 
   // Threads in Delay List
-  thread = osRtxInfo.thread.delay_list;
+  thread = osRtxThreadDelayFirst();
   while (thread != NULL) {
-    thread_next = thread->delay_next;
+    thread_next = osRtxThreadDelayNext(thread);
     if ((((mode & osSafetyWithSameClass)  != 0U) &&
          ((thread->attr >> osRtxAttrClass_Pos) == (uint8_t)safety_class)) ||
         (((mode & osSafetyWithLowerClass) != 0U) &&
@@ -2004,9 +2357,9 @@ static osStatus_t svcRtxThreadTerminateZone (uint32_t zone) {
   }
 
   // Threads in Delay List
-  thread = osRtxInfo.thread.delay_list;
+  thread = osRtxThreadDelayFirst();
   while (thread != NULL) {
-    thread_next = thread->delay_next;
+    thread_next = osRtxThreadDelayNext(thread);
     if (thread->zone == zone) {
       osRtxThreadListRemove(thread);
       osRtxThreadDelayRemove(thread);
@@ -2108,8 +2461,8 @@ static uint32_t svcRtxThreadGetCount (void) {
   }
 
   // Delay List
-  for (thread = osRtxInfo.thread.delay_list;
-       thread != NULL; thread = thread->delay_next) {
+  for (thread = osRtxThreadDelayFirst();
+       thread != NULL; thread = osRtxThreadDelayNext(thread)) {
     count++;
   }
 
@@ -2151,8 +2504,8 @@ static uint32_t svcRtxThreadEnumerate (osThreadId_t *thread_array, uint32_t arra
   }
 
   // Delay List
-  for (thread = osRtxInfo.thread.delay_list;
-       (thread != NULL) && (count < array_items); thread = thread->delay_next) {
+  for (thread = osRtxThreadDelayFirst();
+       (thread != NULL) && (count < array_items); thread = osRtxThreadDelayNext(thread)) {
     *thread_array = thread;
      thread_array++;
      count++;
@@ -33,9 +33,76 @@ __attribute__((section(".data.os.timer.obj"))) =
 { 0U, 0U, 0U };
 #endif
 
+//  Timer wheel: running Timers by expiry Tick and number of processed Ticks
+#ifdef RTX_DELAY_WHEEL
+static os_timer_t *TimerWheel[osRtxWheelSlots] __attribute__((section(".data.os"))) = { NULL };
+static uint32_t    TimerWheelTick __attribute__((section(".data.os"))) = 0U;
+#endif
+
 
 //  ==== Helper functions ====
 
+#ifdef RTX_DELAY_WHEEL
+
+/// Get Timer overlaying a Timer wheel slot with its next (previous Timer of the first one).
+/// \param[in]  list            timer wheel slot.
+/// \return timer object.
+static os_timer_t *TimerWheelHead (os_timer_t **list) {
+  //lint -e{9079} -e{9087} "cast between pointers to different object types"
+  return ((os_timer_t *)(void *)((uint8_t *)list - offsetof(os_timer_t, next)));
+}
+
+/// Put Timer at the head of the Timer wheel slot of its expiry Tick (timer->tick).
+/// \param[in]  timer           timer object.
+static void TimerWheelPut (os_timer_t *timer) {
+  os_timer_t **list;
+
+  list = &TimerWheel[osRtxWheelSlot(TimerWheelTick, timer->tick)];
+  timer->prev = TimerWheelHead(list);
+  timer->next = *list;
+  if (*list != NULL) {
+    (*list)->prev = timer;
+  }
+  *list = timer;
+}
+
+/// Take all Timers out of a Timer wheel slot.
+/// \param[in]  slot            slot number.
+/// \return last Timer of the slot (put first) or NULL, linked back to the slot head.
+static os_timer_t *TimerWheelTake (uint32_t slot) {
+  os_timer_t *timer;
+
+  timer = TimerWheel[slot];
+  if (timer != NULL) {
+    TimerWheel[slot] = NULL;
+    while (timer->next != NULL) {
+      timer = timer->next;
+    }
+  }
+  return timer;
+}
+
+/// Insert Timer into the Timer wheel.
+/// \param[in]  timer           timer object.
+/// \param[in]  tick            timer tick.
+static void TimerInsert (os_timer_t *timer, uint32_t tick) {
+
+  timer->tick = TimerWheelTick + tick;
+  TimerWheelPut(timer);
+}
+
+/// Remove Timer from the Timer wheel.
+/// \param[in]  timer           timer object.
+static void TimerRemove (const os_timer_t *timer) {
+
+  if (timer->next != NULL) {
+    timer->next->prev = timer->prev;
+  }
+  timer->prev->next = timer->next;
+}
+
+#else
+
 /// Insert Timer into the Timer List sorted by Time.
 /// \param[in]  timer           timer object.
 /// \param[in]  tick            timer tick.
@@ -88,6 +155,8 @@ static void TimerUnlink (const os_timer_t *timer) {
   osRtxInfo.timer.list = timer->next;
 }
 
+#endif
+
 /// Verify that Timer object pointer is valid.
 /// \param[in]  timer           timer object.
 /// \return true - valid, false - invalid.
@@ -118,13 +187,138 @@ static bool_t IsTimerPtrValid (const os_timer_t *timer) {
 }
 
 
+/// Queue the callback of an expired Timer and restart it if periodic.
+/// \param[in]  timer           timer object taken out of the Timer list.
+/// \param[in]  thread_running  running thread object.
+/// \return running thread object or NULL if it was terminated.
+static os_thread_t *TimerExpire (os_timer_t *timer, os_thread_t *thread_running) {
+  osStatus_t status;
+
+  status = osMessageQueuePut(osRtxInfo.timer.mq, &timer->finfo, 0U, 0U);
+  if (status != osOK) {
+    const os_thread_t *thread = osRtxThreadGetRunning();
+    osRtxThreadSetRunning(osRtxInfo.thread.run.next);
+    (void)osRtxKernelErrorNotify(osRtxErrorTimerQueueOverflow, timer);
+    if (osRtxThreadGetRunning() == NULL) {
+      if (thread_running == thread) {
+        thread_running = NULL;
+      }
+    }
+  }
+  if ((timer->attr & osRtxTimerPeriodic) != 0U) {
+    TimerInsert(timer, timer->load);
+  } else {
+    timer->state = osRtxTimerStopped;
+  }
+
+  return thread_running;
+}
+
+
 //  ==== Library functions ====
 
+#ifdef RTX_DELAY_WHEEL
+
+/// Timer Tick (called each SysTick).
+static void osRtxTimerTick (void) {
+  os_thread_t *thread_running;
+  os_timer_t  *timer, *prev, *head;
+  uint32_t     level, slot;
+
+  TimerWheelTick++;
+
+  // Move Timers of higher level slots reached by the Tick towards level 0
+  level = 1U;
+  slot  = osRtxWheelCascade(TimerWheelTick, level);
+  while (slot != osRtxWheelSlots) {
+    head  = TimerWheelHead(&TimerWheel[slot]);
+    timer = TimerWheelTake(slot);
+    while (timer != NULL) {
+      prev = timer->prev;
+      TimerWheelPut(timer);
+      timer = (prev != head) ? prev : NULL;
+    }
+    level++;
+    slot = osRtxWheelCascade(TimerWheelTick, level);
+  }
+
+  // Timers in level 0 slot expire with this Tick
+  slot  = TimerWheelTick & (osRtxWheelSize - 1U);
+  head  = TimerWheelHead(&TimerWheel[slot]);
+  timer = TimerWheelTake(slot);
+  if (timer == NULL) {
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return;
+  }
+
+  thread_running = osRtxThreadGetRunning();
+
+  while (timer != NULL) {
+    prev = timer->prev;
+    thread_running = TimerExpire(timer, thread_running);
+    timer = (prev != head) ? prev : NULL;
+  }
+
+  osRtxThreadSetRunning(thread_running);
+}
+
+/// Get Ticks until the first Timer in the Timer wheel expires.
+/// \return ticks or osWaitForever if no Timer is running.
+uint32_t osRtxTimerSleep (void) {
+  const os_timer_t *timer;
+  uint32_t          delay, ticks, slot;
+
+  delay = osWaitForever;
+  for (slot = 0U; slot < osRtxWheelSlots; slot++) {
+    for (timer = TimerWheel[slot]; timer != NULL; timer = timer->next) {
+      ticks = timer->tick - TimerWheelTick;
+      if (ticks < delay) {
+        delay = ticks;
+      }
+    }
+  }
+  return delay;
+}
+
+/// Skip Ticks in which no Timer in the Timer wheel expires.
+/// \param[in]  ticks           number of ticks.
+void osRtxTimerSkip (uint32_t ticks) {
+  os_timer_t *timer, *list, *next;
+  uint32_t    slot;
+
+  if (ticks == 0U) {
+    //lint -e{904} "Return statement before end of function" [MISRA Note 1]
+    return;
+  }
+
+  // Slots depend on the Tick, take all Timers out and put them back after the skip
+  list = NULL;
+  for (slot = 0U; slot < osRtxWheelSlots; slot++) {
+    timer = TimerWheel[slot];
+    TimerWheel[slot] = NULL;
+    while (timer != NULL) {
+      next = timer->next;
+      timer->next = list;
+      list = timer;
+      timer = next;
+    }
+  }
+
+  TimerWheelTick += ticks;
+
+  while (list != NULL) {
+    next = list->next;
+    TimerWheelPut(list);
+    list = next;
+  }
+}
+
+#else
+
 /// Timer Tick (called each SysTick).
 static void osRtxTimerTick (void) {
   os_thread_t *thread_running;
   os_timer_t  *timer;
-  osStatus_t   status;
 
   timer = osRtxInfo.timer.list;
   if (timer == NULL) {
@@ -137,28 +331,15 @@ static void osRtxTimerTick (void) {
   timer->tick--;
   while ((timer != NULL) && (timer->tick == 0U)) {
     TimerUnlink(timer);
-    status = osMessageQueuePut(osRtxInfo.timer.mq, &timer->finfo, 0U, 0U);
-    if (status != osOK) {
-      const os_thread_t *thread = osRtxThreadGetRunning();
-      osRtxThreadSetRunning(osRtxInfo.thread.run.next);
-      (void)osRtxKernelErrorNotify(osRtxErrorTimerQueueOverflow, timer);
-      if (osRtxThreadGetRunning() == NULL) {
-        if (thread_running == thread) {
-          thread_running = NULL;
-        }
-      }
-    }
-    if ((timer->attr & osRtxTimerPeriodic) != 0U) {
-      TimerInsert(timer, timer->load);
-    } else {
-      timer->state = osRtxTimerStopped;
-    }
+    thread_running = TimerExpire(timer, thread_running);
     timer = osRtxInfo.timer.list;
   }
 
   osRtxThreadSetRunning(thread_running);
 }
 
+#endif
+
 /// Setup Timer Thread objects.
 //lint -esym(714,osRtxTimerSetup) "Referenced from library configuration"
 //lint -esym(759,osRtxTimerSetup) "Prototype in header"
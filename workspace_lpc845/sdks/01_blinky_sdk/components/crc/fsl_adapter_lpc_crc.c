@@ -12,11 +12,12 @@
 /*******************************************************************************
  * Code
  ******************************************************************************/
-uint32_t HAL_CrcCompute(hal_crc_config_t *crcConfig, uint8_t *dataIn, uint32_t length)
+void HAL_CrcInit(hal_crc_context_t *context, hal_crc_config_t *crcConfig)
 {
     CRC_Type *const s_CrcList[] = CRC_BASE_PTRS;
     crc_config_t config;
-    uint32_t result;
+
+    assert(NULL != context);
 
     config.seed          = crcConfig->crcSeed;
     config.reverseIn     = (bool)crcConfig->crcRefIn;
@@ -35,10 +36,30 @@ uint32_t HAL_CrcCompute(hal_crc_config_t *crcConfig, uint8_t *dataIn, uint32_t l
         config.polynomial = kCRC_Polynomial_CRC_32;
     }
 
+    /* The running CRC lives in the peripheral. */
+    context->crcConfig = crcConfig;
+    context->table     = NULL;
+    context->crcReg    = 0U;
+    context->crcPoly   = (uint32_t)config.polynomial;
+    context->skipBytes = 0U;
+    context->engine    = KHAL_CrcEngineDefault;
+
     CRC_Init(s_CrcList[0], &config);
+}
+
+void HAL_CrcUpdate(hal_crc_context_t *context, const uint8_t *dataIn, uint32_t length)
+{
+    CRC_Type *const s_CrcList[] = CRC_BASE_PTRS;
+
     CRC_WriteData(s_CrcList[0], dataIn, length);
+}
 
-    if (crcConfig->crcSize == 2U)
+uint32_t HAL_CrcFinal(hal_crc_context_t *context)
+{
+    CRC_Type *const s_CrcList[] = CRC_BASE_PTRS;
+    uint32_t result;
+
+    if (context->crcConfig->crcSize == 2U)
     {
         result = (uint32_t)CRC_Get16bitResult(s_CrcList[0]);
     }
@@ -49,3 +70,13 @@ uint32_t HAL_CrcCompute(hal_crc_config_t *crcConfig, uint8_t *dataIn, uint32_t l
 
     return result;
 }
+
+uint32_t HAL_CrcCompute(hal_crc_config_t *crcConfig, uint8_t *dataIn, uint32_t length)
+{
+    hal_crc_context_t context;
+
+    HAL_CrcInit(&context, crcConfig);
+    HAL_CrcUpdate(&context, dataIn, length);
+
+    return HAL_CrcFinal(&context);
+}
@@ -32,11 +32,25 @@
 #define GENERIC_LIST_LIGHT (1)
 #endif
 
-/*! @brief Definition to determine whether enable list duplicated checking. */
+/*! @brief Definition to determine whether enable list duplicated checking.
+ *
+ * The element already points to the list it is linked into, the check is one compare per insertion.
+ * When it is enabled, every element must be zero initialized or removed from its previous list before
+ * it is inserted, an element with a stale list pointer is refused with kLIST_DuplicateError.
+ */
 #ifndef GENERIC_LIST_DUPLICATED_CHECKING
 #define GENERIC_LIST_DUPLICATED_CHECKING (0)
 #endif
 
+/*! @brief Definition to determine whether enable the list debug checking.
+ *
+ * Every insertion walks the whole list, asserts that the size and the tail match the linked elements and
+ * looks for the new element. It makes the insertions O(n), enable it to track down list corruption only.
+ */
+#ifndef GENERIC_LIST_DEBUG
+#define GENERIC_LIST_DEBUG (0)
+#endif
+
 /**********************************************************************************
  * Public type definitions
  ***********************************************************************************/
@@ -87,6 +101,12 @@ typedef struct list_element_tag
     struct list_label *list;       /*!< pointer to the list */
 } list_element_t, *list_element_handle_t;
 #endif
+
+/*! @brief The compare function of the sorted insertion.
+ *
+ * Returns a negative value if listElement goes in front of member, zero or a positive value otherwise.
+ */
+typedef int32_t (*list_element_compare_t)(list_element_handle_t listElement, list_element_handle_t member);
 /**********************************************************************************
  * Public prototypes
  ***********************************************************************************/
@@ -97,6 +117,160 @@ typedef struct list_element_tag
 #if defined(__cplusplus)
 extern "C" {
 #endif /* _cplusplus */
+
+#if (defined(GENERIC_LIST_DEBUG) && (GENERIC_LIST_DEBUG > 0U))
+/*!
+ * @brief Checks the list before an insertion, debug variant.
+ *
+ * Walks the list, asserts that the size and the tail match the linked elements and looks for the element.
+ *
+ * @param list - Handle of the list.
+ * @param listElement - Handle of the element to insert.
+ * @retval kLIST_Full if list is full, kLIST_DuplicateError if the element is in the list, kLIST_Ok otherwise.
+ */
+list_status_t LIST_DebugCheck(list_handle_t list, list_element_handle_t listElement);
+#endif
+
+/*!
+ * @brief Checks the list before an insertion.
+ *
+ * @param list - Handle of the list.
+ * @param listElement - Handle of the element to insert.
+ * @retval kLIST_Full if list is full, kLIST_DuplicateError if the element is in the list, kLIST_Ok otherwise.
+ */
+static inline list_status_t LIST_CheckInsert(list_handle_t list, list_element_handle_t listElement)
+{
+#if (defined(GENERIC_LIST_DEBUG) && (GENERIC_LIST_DEBUG > 0U))
+    return LIST_DebugCheck(list, listElement);
+#else
+    list_status_t listStatus = kLIST_Ok;
+
+    if ((list->max != 0U) && (list->max == list->size))
+    {
+        listStatus = kLIST_Full; /*List is full*/
+    }
+#if (defined(GENERIC_LIST_DUPLICATED_CHECKING) && (GENERIC_LIST_DUPLICATED_CHECKING > 0U))
+    else if (listElement->list == list)
+    {
+        listStatus = kLIST_DuplicateError;
+    }
+#endif
+    else
+    {
+        /* Insertion allowed */
+    }
+    (void)listElement;
+    return listStatus;
+#endif
+}
+
+/*!
+ * @brief Links element to the tail of the list, without critical section.
+ *
+ * Inline variant of LIST_AddTail for callers that already protect the list.
+ *
+ * @param list - Handle of the list.
+ * @param listElement - Handle of the element.
+ * @retval kLIST_Full if list is full, kLIST_DuplicateError if the element is in the list,
+ *         kLIST_Ok if insertion was successful.
+ */
+static inline list_status_t LIST_AddTailUnlocked(list_handle_t list, list_element_handle_t listElement)
+{
+    list_status_t listStatus = LIST_CheckInsert(list, listElement);
+
+    if (listStatus == kLIST_Ok)
+    {
+        if (list->size == 0U)
+        {
+            list->head = listElement;
+        }
+        else
+        {
+            list->tail->next = listElement;
+        }
+#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
+#else
+        listElement->prev = list->tail;
+#endif
+        listElement->list = list;
+        listElement->next = NULL;
+        list->tail        = listElement;
+        list->size++;
+    }
+
+    return listStatus;
+}
+
+/*!
+ * @brief Links element to the head of the list, without critical section.
+ *
+ * Inline variant of LIST_AddHead for callers that already protect the list.
+ *
+ * @param list - Handle of the list.
+ * @param listElement - Handle of the element.
+ * @retval kLIST_Full if list is full, kLIST_DuplicateError if the element is in the list,
+ *         kLIST_Ok if insertion was successful.
+ */
+static inline list_status_t LIST_AddHeadUnlocked(list_handle_t list, list_element_handle_t listElement)
+{
+    list_status_t listStatus = LIST_CheckInsert(list, listElement);
+
+    if (listStatus == kLIST_Ok)
+    {
+        if (list->size == 0U)
+        {
+            list->tail = listElement;
+        }
+#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
+#else
+        else
+        {
+            list->head->prev = listElement;
+        }
+        listElement->prev = NULL;
+#endif
+        listElement->list = list;
+        listElement->next = list->head;
+        list->head        = listElement;
+        list->size++;
+    }
+
+    return listStatus;
+}
+
+/*!
+ * @brief Unlinks element from the head of the list, without critical section.
+ *
+ * Inline variant of LIST_RemoveHead for callers that already protect the list.
+ *
+ * @param list - Handle of the list.
+ * @retval NULL if list is empty, handle of removed element(pointer) if removal was successful.
+ */
+static inline list_element_handle_t LIST_RemoveHeadUnlocked(list_handle_t list)
+{
+    list_element_handle_t listElement = list->head;
+
+    if (listElement != NULL)
+    {
+        list->size--;
+        if (list->size == 0U)
+        {
+            list->tail = NULL;
+        }
+#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
+#else
+        else
+        {
+            listElement->next->prev = NULL;
+        }
+#endif
+        listElement->list = NULL;
+        list->head        = listElement->next; /*Is NULL if element is head*/
+    }
+
+    return listElement;
+}
+
 /*!
  * @brief Initialize the list.
  *
@@ -191,6 +365,21 @@ list_status_t LIST_RemoveElement(list_element_handle_t listElement);
  */
 list_status_t LIST_AddPrevElement(list_element_handle_t listElement, list_element_handle_t newElement);
 
+/*!
+ * @brief Links element in sorted position.
+ *
+ * The element goes in front of the first member that compare orders after it, behind the members that
+ * compare equal. Elements sorted after the tail, the common case of deadline lists, are linked without
+ * walking the list.
+ *
+ * @param list - Handle of the list.
+ * @param listElement - Handle of the element.
+ * @param compare - Compare function, see list_element_compare_t.
+ * @retval kLIST_Full if list is full, kLIST_DuplicateError if the element is in the list,
+ *         kLIST_Ok if insertion was successful.
+ */
+list_status_t LIST_AddSorted(list_handle_t list, list_element_handle_t listElement, list_element_compare_t compare);
+
 /*!
  * @brief Gets the current size of a list.
  *
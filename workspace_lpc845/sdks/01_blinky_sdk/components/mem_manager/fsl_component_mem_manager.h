@@ -204,10 +204,31 @@ typedef enum mem_alloc_test_status
 } mem_alloc_test_status_t;
 #endif
 
+/*!
+ * @brief Configures the segregated fit allocation of the memory manager light.
+ *
+ * Free blocks are kept in power of 2 size classes indexed by a bitmap, so allocation, free and
+ * coalescing with the neighbour blocks take constant time instead of walking the free list.
+ */
+#ifndef gMemManagerLightSegregatedFit
+#define gMemManagerLightSegregatedFit (0)
+#endif
+
+/*! @brief Number of size classes, class n holds the free blocks of [2^(n+2), 2^(n+3)) bytes. */
+#ifndef MML_SIZE_CLASS_NUM
+#define MML_SIZE_CLASS_NUM (16U)
+#endif
+
+#if defined(gMemManagerLightSegregatedFit) && (gMemManagerLightSegregatedFit > 0)
+#define MML_SEGREGATED_FIT_SZ ((1U + MML_SIZE_CLASS_NUM) * sizeof(uint32_t))
+#else
+#define MML_SEGREGATED_FIT_SZ (0U)
+#endif
+
 #ifdef MEM_STATISTICS
-#define MML_INTERNAL_STRUCT_SZ (2 * sizeof(uint32_t) + 48)
+#define MML_INTERNAL_STRUCT_SZ (2 * sizeof(uint32_t) + 48 + MML_SEGREGATED_FIT_SZ)
 #else
-#define MML_INTERNAL_STRUCT_SZ (2 * sizeof(uint32_t))
+#define MML_INTERNAL_STRUCT_SZ (2 * sizeof(uint32_t) + MML_SEGREGATED_FIT_SZ)
 #endif
 
 #define AREA_FLAGS_POOL_NOT_SHARED (1u << 0)
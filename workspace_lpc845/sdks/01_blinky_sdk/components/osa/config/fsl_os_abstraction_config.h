@@ -41,6 +41,27 @@
 #define FSL_OSA_BM_TIMEOUT_ENABLE 0U
 #endif
 
+/*! @brief Definition to determine whether the bare metal task loop uses the ready bitmap scheduler. */
+#ifndef FSL_OSA_BM_SCHEDULER_BITMAP
+#define FSL_OSA_BM_SCHEDULER_BITMAP 0U
+#endif
+
+/*! @brief Priority levels of the bitmap scheduler, up to 32. Lower priorities share the last level. */
+#ifndef FSL_OSA_BM_PRIORITY_LEVELS
+#define FSL_OSA_BM_PRIORITY_LEVELS 8U
+#endif
+
+/*!
+ * @brief Definition to determine whether the bare metal message queue uses message slots.
+ *
+ * The messages are copied outside of the critical sections, word-wise when they are 4 byte aligned,
+ * and OSA_MsgQReserve/OSA_MsgQCommit/OSA_MsgQRelease are available. One state byte per message
+ * follows the messages in the handle memory, see OSA_MSGQ_HANDLE_DEFINE.
+ */
+#ifndef FSL_OSA_BM_MSGQ_SLOTS
+#define FSL_OSA_BM_MSGQ_SLOTS 0U
+#endif
+
 #ifndef FSL_OSA_ALLOCATED_HEAP
 #define FSL_OSA_ALLOCATED_HEAP (1U)
 #endif
@@ -192,16 +192,30 @@ extern const uint8_t gUseRtos_c;
 #define USE_RTOS (1)
 #else
 #define USE_RTOS (0)
+/* The sizes below are for 32-bit pointers, other targets such as host builds define their own. */
+#ifndef OSA_TASK_HANDLE_SIZE
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+#if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
+#define OSA_TASK_HANDLE_SIZE (28U)
+#else
+#define OSA_TASK_HANDLE_SIZE (32U)
+#endif
+#else
 #if (defined(GENERIC_LIST_LIGHT) && (GENERIC_LIST_LIGHT > 0U))
 #define OSA_TASK_HANDLE_SIZE (24U)
 #else
 #define OSA_TASK_HANDLE_SIZE (28U)
 #endif
+#endif /* FSL_OSA_BM_SCHEDULER_BITMAP */
+#endif /* OSA_TASK_HANDLE_SIZE */
+#ifndef OSA_EVENT_HANDLE_SIZE
 #if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
 #define OSA_EVENT_HANDLE_SIZE (20U)
 #else
 #define OSA_EVENT_HANDLE_SIZE (16U)
 #endif /* FSL_OSA_TASK_ENABLE */
+#endif /* OSA_EVENT_HANDLE_SIZE */
+#ifndef OSA_SEM_HANDLE_SIZE
 #if (defined(FSL_OSA_BM_TIMEOUT_ENABLE) && (FSL_OSA_BM_TIMEOUT_ENABLE > 0U))
 #define OSA_SEM_HANDLE_SIZE   (16U)
 #define OSA_MUTEX_HANDLE_SIZE (12U)
@@ -209,11 +223,22 @@ extern const uint8_t gUseRtos_c;
 #define OSA_SEM_HANDLE_SIZE   (8U)
 #define OSA_MUTEX_HANDLE_SIZE (4U)
 #endif
+#endif /* OSA_SEM_HANDLE_SIZE */
+#ifndef OSA_MSGQ_HANDLE_SIZE
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+#if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
+#define OSA_MSGQ_HANDLE_SIZE (40U)
+#else
+#define OSA_MSGQ_HANDLE_SIZE (36U)
+#endif /* FSL_OSA_TASK_ENABLE */
+#else
 #if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
 #define OSA_MSGQ_HANDLE_SIZE (32U)
 #else
 #define OSA_MSGQ_HANDLE_SIZE (28U)
 #endif /* FSL_OSA_TASK_ENABLE */
+#endif /* FSL_OSA_BM_MSGQ_SLOTS */
+#endif /* OSA_MSGQ_HANDLE_SIZE */
 #define OSA_MSG_HANDLE_SIZE (4U)
 #endif
 
@@ -434,6 +459,10 @@ extern const uint8_t gUseRtos_c;
 #elif defined(__ZEPHYR__)
 #define OSA_MSGQ_HANDLE_DEFINE(name, numberOfMsgs, msgSize) \
     uint32_t name[(OSA_MSGQ_HANDLE_SIZE + (numberOfMsgs * msgSize) + sizeof(uint32_t) - 1U) / sizeof(uint32_t)]
+#elif (USE_RTOS == 0) && (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+/*< Macro For BARE_MATEL message slots, one state byte per message follows the messages */
+#define OSA_MSGQ_HANDLE_DEFINE(name, numberOfMsgs, msgSize) \
+    uint32_t name[((OSA_MSGQ_HANDLE_SIZE + numberOfMsgs * (msgSize + 1U)) + sizeof(uint32_t) - 1U) / sizeof(uint32_t)]
 #else
 /*< Macro For BARE_MATEL and FREE_RTOS static allocation*/
 #define OSA_MSGQ_HANDLE_DEFINE(name, numberOfMsgs, msgSize) \
@@ -1036,6 +1065,7 @@ osa_status_t OSA_EventDestroy(osa_event_handle_t eventHandle);
  * @endcode
  *
  * @param msgqHandle    Pointer to a memory space of size #(OSA_MSGQ_HANDLE_SIZE + msgNo*msgSize) on bare-matel,
+ * #(OSA_MSGQ_HANDLE_SIZE + msgNo*(msgSize + 1)) on bare-matel with FSL_OSA_BM_MSGQ_SLOTS,
  * FreeRTOS static allocation allocated by the caller and #(OSA_MSGQ_HANDLE_SIZE) on FreeRTOS dynamic allocation,
  * message queue handle. The handle should be 4 byte aligned, because unaligned access doesn't be supported on some
  * devices. You can define the handle in the following two ways: #OSA_MSGQ_HANDLE_DEFINE(msgqHandle); or For bm and
@@ -0,0 +1,181 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "fsl_adc_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.lpc_adc_dma"
+#endif
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief DMA callback for ADC DMA driver.
+ *
+ * @param handle DMA handler for ADC DMA driver
+ * @param userData user param passed to the callback function
+ * @param transferDone false on a DMA error
+ * @param intmode kDMA_IntA for the first block, kDMA_IntB for the second block
+ */
+static void ADC_TransferCallbackDMA(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode);
+
+/*******************************************************************************
+ * Codes
+ ******************************************************************************/
+
+static void ADC_TransferCallbackDMA(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode)
+{
+    adc_dma_handle_t *adcHandle = (adc_dma_handle_t *)userData;
+    uint32_t *samples           = NULL;
+    uint8_t block;
+
+    if (transferDone)
+    {
+        block   = (intmode == (uint32_t)kDMA_IntA) ? 0U : 1U;
+        samples = &adcHandle->buffer[block * adcHandle->blockSize];
+
+        /* The DMA has refilled a block the application still works on. */
+        if ((adcHandle->ownedBlocks & (1U << block)) != 0U)
+        {
+            adcHandle->overrunCount++;
+        }
+        adcHandle->ownedBlocks |= (uint8_t)(1U << block);
+        adcHandle->blockCount++;
+    }
+
+    if (adcHandle->callback != NULL)
+    {
+        adcHandle->callback(adcHandle->base, adcHandle, transferDone ? kStatus_Success : kStatus_Fail, samples,
+                            adcHandle->userData);
+    }
+}
+
+void ADC_TransferCreateHandleDMA(ADC_Type *base,
+                                 adc_dma_handle_t *handle,
+                                 adc_dma_transfer_callback_t callback,
+                                 void *userData,
+                                 dma_handle_t *dmaHandle,
+                                 dma_descriptor_t *descriptors)
+{
+    assert(handle != NULL);
+    assert(dmaHandle != NULL);
+    assert(descriptors != NULL);
+    assert(((uint32_t)descriptors & (FSL_FEATURE_DMA_LINK_DESCRIPTOR_ALIGN_SIZE - 1U)) == 0U);
+
+    /* Zero handle. */
+    (void)memset(handle, 0, sizeof(*handle));
+
+    handle->base        = base;
+    handle->dmaHandle   = dmaHandle;
+    handle->descriptors = descriptors;
+    handle->callback    = callback;
+    handle->userData    = userData;
+
+    DMA_SetCallback(dmaHandle, ADC_TransferCallbackDMA, handle);
+}
+
+status_t ADC_TransferStartDMA(ADC_Type *base, adc_dma_handle_t *handle, adc_dma_transfer_t *xfer)
+{
+    assert(handle != NULL);
+    assert(xfer != NULL);
+
+    dma_channel_trigger_t trigger;
+    dma_descriptor_t *desc = handle->descriptors;
+    void *srcAddr;
+    uint32_t xferCfgPing;
+    uint32_t xferCfgPong;
+    uint32_t seq = (uint32_t)xfer->sequence;
+
+    if ((xfer->buffer == NULL) || (xfer->blockSize == 0U) || (xfer->blockSize > ADC_MAX_DMA_BLOCK_SAMPLES))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (DMA_ChannelIsBusy(handle->dmaHandle->base, handle->dmaHandle->channel))
+    {
+        return kStatus_Busy;
+    }
+
+    handle->buffer       = xfer->buffer;
+    handle->blockSize    = xfer->blockSize;
+    handle->sequence     = xfer->sequence;
+    handle->ownedBlocks  = 0U;
+    handle->blockCount   = 0U;
+    handle->overrunCount = 0U;
+
+    /* Stop the sequence while the DMA is armed. */
+    base->SEQ_CTRL[seq] &= ~(ADC_SEQ_CTRL_SEQ_ENA_MASK | ADC_SEQ_CTRL_BURST_MASK);
+
+    /*
+     * Every conversion raises the DMA trigger and moves one global data word, so the
+     * channels of a sequence are interleaved in the buffer in conversion order.
+     */
+    base->SEQ_CTRL[seq] &= ~ADC_SEQ_CTRL_MODE_MASK;
+
+    /* A result left by an earlier run would be the first DMA trigger, drop it. */
+    (void)base->SEQ_GDAT[seq];
+    ADC_ClearStatusFlags(base, (seq == 0U) ? (uint32_t)kADC_ConvSeqAInterruptFlag :
+                                             (uint32_t)kADC_ConvSeqBInterruptFlag);
+
+    trigger.type  = kDMA_RisingEdgeTrigger;
+    trigger.burst = kDMA_EdgeBurstTransfer1;
+    trigger.wrap  = kDMA_NoWrap;
+    DMA_SetChannelConfig(handle->dmaHandle->base, handle->dmaHandle->channel, &trigger, false);
+
+    srcAddr     = (void *)(uint32_t)&base->SEQ_GDAT[seq];
+    xferCfgPing = DMA_CHANNEL_XFER(true, true, true, false, sizeof(uint32_t), kDMA_AddressInterleave0xWidth,
+                                   kDMA_AddressInterleave1xWidth, xfer->blockSize * sizeof(uint32_t));
+    xferCfgPong = DMA_CHANNEL_XFER(true, true, false, true, sizeof(uint32_t), kDMA_AddressInterleave0xWidth,
+                                   kDMA_AddressInterleave1xWidth, xfer->blockSize * sizeof(uint32_t));
+
+    /* Ping (INTA) and pong (INTB) link to each other, the head descriptor is a copy of ping. */
+    DMA_SetupDescriptor(&desc[0], xferCfgPing, srcAddr, xfer->buffer, &desc[1]);
+    DMA_SetupDescriptor(&desc[1], xferCfgPong, srcAddr, &xfer->buffer[xfer->blockSize], &desc[0]);
+    DMA_SubmitChannelDescriptor(handle->dmaHandle, &desc[0]);
+    DMA_StartTransfer(handle->dmaHandle);
+
+    /* Sequence interrupt flag is the DMA trigger. */
+    ADC_EnableInterrupts(base, (seq == 0U) ? (uint32_t)kADC_ConvSeqAInterruptEnable :
+                                             (uint32_t)kADC_ConvSeqBInterruptEnable);
+
+    base->SEQ_CTRL[seq] |= ADC_SEQ_CTRL_SEQ_ENA_MASK;
+    if (xfer->enableBurst)
+    {
+        base->SEQ_CTRL[seq] |= ADC_SEQ_CTRL_BURST_MASK;
+    }
+
+    return kStatus_Success;
+}
+
+void ADC_TransferStopDMA(ADC_Type *base, adc_dma_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    uint32_t seq = (uint32_t)handle->sequence;
+
+    base->SEQ_CTRL[seq] &= ~(ADC_SEQ_CTRL_SEQ_ENA_MASK | ADC_SEQ_CTRL_BURST_MASK);
+    ADC_DisableInterrupts(base, (seq == 0U) ? (uint32_t)kADC_ConvSeqAInterruptEnable :
+                                              (uint32_t)kADC_ConvSeqBInterruptEnable);
+
+    DMA_AbortTransfer(handle->dmaHandle);
+}
+
+void ADC_TransferReleaseBlockDMA(ADC_Type *base, adc_dma_handle_t *handle, uint32_t *samples)
+{
+    assert(handle != NULL);
+
+    uint8_t block = (samples == handle->buffer) ? 0U : 1U;
+    uint32_t primask;
+
+    primask = DisableGlobalIRQ();
+    handle->ownedBlocks &= (uint8_t)~(1U << block);
+    EnableGlobalIRQ(primask);
+}
@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef FSL_ADC_DMA_H_
+#define FSL_ADC_DMA_H_
+
+#include "fsl_adc.h"
+#include "fsl_dma.h"
+
+/*!
+ * @addtogroup adc_dma_driver
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*! @{ */
+/*! @brief ADC DMA driver version. */
+#define FSL_ADC_DMA_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*! @} */
+
+/*! @brief Number of link descriptors the application provides for one acquisition. */
+#define ADC_DMA_DESCRIPTOR_NUM (2U)
+
+/*! @brief Maximum number of samples in one block (determined by capability of the DMA engine) */
+#define ADC_MAX_DMA_BLOCK_SAMPLES (DMA_MAX_TRANSFER_COUNT)
+
+/*! @brief Get the conversion result from a sample word stored by the DMA. */
+#define ADC_DMA_SAMPLE_RESULT(sample) (((sample)&ADC_SEQ_GDAT_RESULT_MASK) >> ADC_SEQ_GDAT_RESULT_SHIFT)
+
+/*! @brief Get the channel number from a sample word stored by the DMA. */
+#define ADC_DMA_SAMPLE_CHANNEL(sample) (((sample)&ADC_SEQ_GDAT_CHN_MASK) >> ADC_SEQ_GDAT_CHN_SHIFT)
+
+/*! @brief Conversion sequence feeding the DMA. */
+typedef enum _adc_dma_conv_seq
+{
+    kADC_DmaConvSeqA = 0U, /*!< Sequence A, DMA trigger kINPUTMUX_AdcASeqaIrqToDma. */
+    kADC_DmaConvSeqB = 1U, /*!< Sequence B, DMA trigger kINPUTMUX_AdcBSeqbIrqToDma. */
+} adc_dma_conv_seq_t;
+
+/*! @brief ADC DMA handle typedef. */
+typedef struct _adc_dma_handle adc_dma_handle_t;
+
+/*!
+ * @brief ADC DMA block callback typedef.
+ *
+ * Called from the DMA interrupt each time one half of the ping-pong buffer is full. The
+ * samples stay valid until the block is given back with ADC_TransferReleaseBlockDMA.
+ * The status is kStatus_Fail and samples is NULL on a DMA error.
+ */
+typedef void (*adc_dma_transfer_callback_t)(
+    ADC_Type *base, adc_dma_handle_t *handle, status_t status, uint32_t *samples, void *userData);
+
+/*! @brief ADC DMA acquisition structure. */
+typedef struct _adc_dma_transfer
+{
+    uint32_t *buffer;             /*!< Sample buffer, two blocks of blockSize words. */
+    uint32_t blockSize;           /*!< Samples per block, one sample per conversion. */
+    adc_dma_conv_seq_t sequence;  /*!< Conversion sequence to stream. */
+    bool enableBurst;             /*!< Convert continuously instead of waiting for the sequence trigger. */
+} adc_dma_transfer_t;
+
+/*! @brief ADC DMA handle structure. */
+struct _adc_dma_handle
+{
+    ADC_Type *base;                       /*!< ADC peripheral base address. */
+    dma_handle_t *dmaHandle;              /*!< The DMA handle used. */
+    dma_descriptor_t *descriptors;        /*!< ADC_DMA_DESCRIPTOR_NUM link descriptors. */
+    uint32_t *buffer;                     /*!< Sample buffer of the running acquisition. */
+    uint32_t blockSize;                   /*!< Samples per block of the running acquisition. */
+    adc_dma_conv_seq_t sequence;          /*!< Sequence of the running acquisition. */
+    volatile uint8_t ownedBlocks;         /*!< Blocks handed to the application and not released yet. */
+    volatile uint32_t blockCount;         /*!< Blocks completed since the acquisition started. */
+    volatile uint32_t overrunCount;       /*!< Blocks overwritten while still owned by the application. */
+    adc_dma_transfer_callback_t callback; /*!< Callback function called for each completed block. */
+    void *userData;                       /*!< Callback parameter passed to callback function. */
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /*_cplusplus. */
+
+/*!
+ * @name ADC DMA Acquisition Operation
+ * @{
+ */
+
+/*!
+ * @brief Init the ADC DMA handle which is used in the acquisition functions.
+ *
+ * The DMA channel must be enabled and its hardware trigger routed to the ADC sequence,
+ * the conversion sequence itself is configured with ADC_SetConvSeqAConfig/ADC_SetConvSeqBConfig.
+ * A timer match or SCTimer output selected in triggerMask paces the conversions without jitter.
+ *
+ * @code
+ * DMA_ALLOCATE_LINK_DESCRIPTORS(s_adcDescriptors, ADC_DMA_DESCRIPTOR_NUM);
+ *
+ * DMA_Init(DMA0);
+ * INPUTMUX_Init(INPUTMUX);
+ * INPUTMUX_AttachSignal(INPUTMUX, ADC_DMA_CHANNEL, kINPUTMUX_AdcASeqaIrqToDma);
+ * DMA_EnableChannel(DMA0, ADC_DMA_CHANNEL);
+ * DMA_CreateHandle(&dmaHandle, DMA0, ADC_DMA_CHANNEL);
+ * ADC_TransferCreateHandleDMA(ADC0, &adcHandle, callback, NULL, &dmaHandle, s_adcDescriptors);
+ * ADC_TransferStartDMA(ADC0, &adcHandle, &transfer);
+ * @endcode
+ *
+ * @param base ADC peripheral base address.
+ * @param handle pointer to adc_dma_handle_t structure.
+ * @param callback pointer to user callback function.
+ * @param userData user param passed to the callback function.
+ * @param dmaHandle DMA handle pointer.
+ * @param descriptors ADC_DMA_DESCRIPTOR_NUM link descriptors allocated with DMA_ALLOCATE_LINK_DESCRIPTORS.
+ */
+void ADC_TransferCreateHandleDMA(ADC_Type *base,
+                                 adc_dma_handle_t *handle,
+                                 adc_dma_transfer_callback_t callback,
+                                 void *userData,
+                                 dma_handle_t *dmaHandle,
+                                 dma_descriptor_t *descriptors);
+
+/*!
+ * @brief Start streaming conversions of a sequence into a ping-pong buffer.
+ *
+ * Each conversion of the sequence stores its global data word (result and channel
+ * number) in the buffer, the DMA wraps around both blocks until the acquisition is stopped.
+ *
+ * @param base ADC peripheral base address.
+ * @param handle pointer to adc_dma_handle_t structure.
+ * @param xfer pointer to adc_dma_transfer_t structure.
+ * @retval kStatus_Success The acquisition was started.
+ * @retval kStatus_InvalidArgument The buffer or block size is not valid.
+ * @retval kStatus_Busy The DMA channel is still in use.
+ */
+status_t ADC_TransferStartDMA(ADC_Type *base, adc_dma_handle_t *handle, adc_dma_transfer_t *xfer);
+
+/*!
+ * @brief Stop the acquisition.
+ *
+ * @param base ADC peripheral base address.
+ * @param handle pointer to adc_dma_handle_t structure.
+ */
+void ADC_TransferStopDMA(ADC_Type *base, adc_dma_handle_t *handle);
+
+/*!
+ * @brief Give a block reported by the callback back to the DMA.
+ *
+ * @param base ADC peripheral base address.
+ * @param handle pointer to adc_dma_handle_t structure.
+ * @param samples block pointer passed to the callback.
+ */
+void ADC_TransferReleaseBlockDMA(ADC_Type *base, adc_dma_handle_t *handle, uint32_t *samples);
+
+/*!
+ * @brief Get the number of blocks overwritten before the application released them.
+ *
+ * @param base ADC peripheral base address.
+ * @param handle pointer to adc_dma_handle_t structure.
+ * @return Overrun count since the acquisition started.
+ */
+static inline uint32_t ADC_TransferGetOverrunCountDMA(ADC_Type *base, adc_dma_handle_t *handle)
+{
+    return handle->overrunCount;
+}
+
+/*! @} */
+#if defined(__cplusplus)
+}
+#endif /*_cplusplus. */
+/*! @} */
+#endif /*FSL_ADC_DMA_H_*/
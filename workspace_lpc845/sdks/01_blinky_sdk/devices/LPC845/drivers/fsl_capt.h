@@ -143,6 +143,8 @@ typedef enum _capt_polling_mode
                                to Reset/Draining Cap. */
     kCAPT_PollContinuousMode =
         2U, /*!< Polling rounds are continuously performed, by walking through the enabled X pins. */
+    kCAPT_PollLowPowerMode = 3U, /*!< Low-power polling rounds, all X pins enabled in the XPINSEL field are measured
+                                    together once per round against TCNT, only the touch events are reported. */
 } capt_polling_mode_t;
 
 /*!
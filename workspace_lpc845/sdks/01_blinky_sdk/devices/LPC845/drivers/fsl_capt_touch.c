@@ -0,0 +1,682 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "fsl_capt_touch.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.capt_touch"
+#endif
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief DMA callback for CAPT touch driver.
+ *
+ * @param handle DMA handler for CAPT touch driver
+ * @param userData user param passed to the callback function
+ * @param transferDone false on a DMA error
+ * @param intmode kDMA_IntA for the first block, kDMA_IntB for the second block
+ */
+static void CAPT_TouchCallbackDMA(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode);
+
+/*******************************************************************************
+ * Codes
+ ******************************************************************************/
+
+/* Moves value towards target by 1/2^shift of the difference. */
+static uint32_t CAPT_TouchTrack(uint32_t value, uint32_t target, uint8_t shift)
+{
+    if (target >= value)
+    {
+        return value + ((target - value) >> shift);
+    }
+
+    return value - ((value - target) >> shift);
+}
+
+static void CAPT_TouchSetCTRL(CAPT_Type *base, uint32_t mask, uint32_t value)
+{
+    /* Before writing into CTRL register, INCHANGE(bit 15)should equal '0'. */
+    while (CAPT_CTRL_INCHANGE_MASK == (CAPT_CTRL_INCHANGE_MASK & base->CTRL))
+    {
+    }
+    base->CTRL = (base->CTRL & ~mask) | value;
+}
+
+static void CAPT_TouchUpdateChannel(capt_touch_handle_t *handle, capt_touch_channel_t *channel)
+{
+    int32_t diff;
+
+    diff = (int32_t)channel->filtered - (int32_t)channel->baseline;
+    if (handle->touchLower)
+    {
+        diff = -diff;
+    }
+    diff /= (int32_t)(1UL << CAPT_TOUCH_FRAC_BITS);
+    channel->delta = (int16_t)((diff > INT16_MAX) ? INT16_MAX : ((diff < INT16_MIN) ? INT16_MIN : diff));
+
+    if (!channel->touched)
+    {
+        if (channel->delta >= (int16_t)handle->touchThreshold)
+        {
+            channel->debounce++;
+            if (channel->debounce >= handle->touchDebounce)
+            {
+                channel->touched     = true;
+                channel->debounce    = 0U;
+                channel->touchRounds = 0U;
+            }
+        }
+        else
+        {
+            channel->debounce = 0U;
+            /*
+             * The baseline follows the drift while the pin is not touched, a count moving away from a
+             * touch is followed at the filter rate to recover from a touch during the calibration.
+             */
+            channel->baseline = CAPT_TouchTrack(channel->baseline, channel->filtered,
+                                                (channel->delta < 0) ? handle->filterShift : handle->baselineShift);
+        }
+        return;
+    }
+
+    /* The baseline is frozen while touched, a pin touched for too long is taken as the new baseline. */
+    channel->touchRounds++;
+    if ((handle->stuckRounds != 0U) && (channel->touchRounds >= handle->stuckRounds))
+    {
+        channel->baseline = channel->filtered;
+        channel->delta    = 0;
+        channel->touched  = false;
+        channel->debounce = 0U;
+        handle->stats.stuckResets++;
+        return;
+    }
+
+    if (channel->delta < (int16_t)handle->releaseThreshold)
+    {
+        channel->debounce++;
+        if (channel->debounce >= handle->releaseDebounce)
+        {
+            channel->touched  = false;
+            channel->debounce = 0U;
+        }
+    }
+    else
+    {
+        channel->debounce = 0U;
+    }
+}
+
+/*
+ * The baselines did not follow the drift in low-power mode. The pins far from a touch in the first
+ * round after the wake-up take their count as baseline, the others move by the mean drift of those.
+ */
+static void CAPT_TouchResync(capt_touch_handle_t *handle, uint32_t pins)
+{
+    capt_touch_channel_t *channel;
+    uint32_t reference  = 0U;
+    uint32_t references = 0U;
+    int32_t drift       = 0;
+    int32_t diff;
+    uint32_t pin;
+
+    for (pin = 0U; pin < CAPT_TOUCH_MAX_PINS; pin++)
+    {
+        channel = &handle->channel[pin];
+        if ((pins & (1UL << pin)) == 0U)
+        {
+            continue;
+        }
+        diff = (int32_t)channel->filtered - (int32_t)channel->baseline;
+        if (((handle->touchLower) ? -diff : diff) < ((int32_t)handle->releaseThreshold << CAPT_TOUCH_FRAC_BITS))
+        {
+            drift += diff;
+            reference |= 1UL << pin;
+            references++;
+            channel->baseline = channel->filtered;
+        }
+    }
+
+    if (references == 0U)
+    {
+        return;
+    }
+
+    drift /= (int32_t)references;
+    for (pin = 0U; pin < CAPT_TOUCH_MAX_PINS; pin++)
+    {
+        if (((pins & ~reference) & (1UL << pin)) != 0U)
+        {
+            handle->channel[pin].baseline = (uint32_t)((int32_t)handle->channel[pin].baseline + drift);
+        }
+    }
+}
+
+/* Centroid of the most touched slider pin and its neighbours. */
+static uint16_t CAPT_TouchDecodeSlider(capt_touch_handle_t *handle)
+{
+    capt_touch_channel_t *channel;
+    uint32_t first;
+    uint32_t last;
+    uint32_t peak     = 0U;
+    bool touched      = false;
+    int32_t peakDelta = INT32_MIN;
+    uint32_t weight   = 0U;
+    uint32_t sum      = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < handle->sliderPinCount; i++)
+    {
+        channel = &handle->channel[handle->sliderPins[i]];
+        touched = touched || channel->touched;
+        if ((int32_t)channel->delta > peakDelta)
+        {
+            peakDelta = channel->delta;
+            peak      = i;
+        }
+    }
+
+    if (!touched)
+    {
+        return (uint16_t)CAPT_TOUCH_SLIDER_RELEASED;
+    }
+
+    first = (peak > 0U) ? (peak - 1U) : 0U;
+    last  = (peak < (handle->sliderPinCount - 1U)) ? (peak + 1U) : peak;
+    for (i = first; i <= last; i++)
+    {
+        channel = &handle->channel[handle->sliderPins[i]];
+        if (channel->delta > 0)
+        {
+            weight += (uint32_t)channel->delta;
+            sum += i * (uint32_t)channel->delta;
+        }
+    }
+
+    return (uint16_t)((sum * (handle->sliderRange - 1U)) / (weight * (handle->sliderPinCount - 1U)));
+}
+
+static void CAPT_TouchStartScan(CAPT_Type *base, capt_touch_handle_t *handle)
+{
+    dma_descriptor_t *desc = handle->descriptors;
+    void *srcAddr          = (void *)(uint32_t)&base->TOUCH;
+    uint32_t xferCfgPing;
+    uint32_t xferCfgPong;
+
+    CAPT_TouchSetCTRL(base, CAPT_CTRL_POLLMODE_MASK | CAPT_CTRL_DMA_MASK, 0U);
+    CAPT_DisableInterrupts(base, CAPT_INTENSET_YESTOUCH_MASK | CAPT_INTENSET_NOTOUCH_MASK |
+                                     CAPT_INTENSET_POLLDONE_MASK | CAPT_INTENSET_TIMEOUT_MASK |
+                                     CAPT_INTENSET_OVERUN_MASK);
+    CAPT_ClearInterruptStatusFlags(base, CAPT_STATUS_YESTOUCH_MASK | CAPT_STATUS_NOTOUCH_MASK |
+                                             CAPT_STATUS_POLLDONE_MASK | CAPT_STATUS_TIMEOUT_MASK |
+                                             CAPT_STATUS_OVERUN_MASK);
+
+    /*
+     * The CAPT request moves each TOUCH word, the blocks hold one polling round each. There is no
+     * hardware trigger, the software trigger stays set across the linked descriptors.
+     */
+    DMA_SetChannelConfig(handle->dmaHandle->base, handle->dmaHandle->channel, NULL, true);
+
+    xferCfgPing = DMA_CHANNEL_XFER(true, false, true, false, sizeof(uint32_t), kDMA_AddressInterleave0xWidth,
+                                   kDMA_AddressInterleave1xWidth, handle->blockSize * sizeof(uint32_t));
+    xferCfgPong = DMA_CHANNEL_XFER(true, false, false, true, sizeof(uint32_t), kDMA_AddressInterleave0xWidth,
+                                   kDMA_AddressInterleave1xWidth, handle->blockSize * sizeof(uint32_t));
+
+    /* Ping (INTA) and pong (INTB) link to each other, the head descriptor is a copy of ping. */
+    DMA_SetupDescriptor(&desc[0], xferCfgPing, srcAddr, handle->buffer, &desc[1]);
+    DMA_SetupDescriptor(&desc[1], xferCfgPong, srcAddr, &handle->buffer[handle->blockSize], &desc[0]);
+    DMA_SubmitChannelDescriptor(handle->dmaHandle, &desc[0]);
+    DMA_StartTransfer(handle->dmaHandle);
+
+    handle->idleRounds = 0U;
+    handle->state      = kCAPT_TouchStateScan;
+
+    /* Time-outs are stored too, every round fills a block. */
+    CAPT_TouchSetCTRL(base, CAPT_CTRL_XPINSEL_MASK | CAPT_CTRL_DMA_MASK,
+                      CAPT_CTRL_XPINSEL(handle->xpins) | CAPT_CTRL_DMA(kCAPT_DMATriggerOnAllMode));
+    CAPT_TouchSetCTRL(base, CAPT_CTRL_POLLMODE_MASK, CAPT_CTRL_POLLMODE(kCAPT_PollContinuousMode));
+}
+
+static void CAPT_TouchStartLowPower(CAPT_Type *base, capt_touch_handle_t *handle)
+{
+    CAPT_TouchSetCTRL(base, CAPT_CTRL_POLLMODE_MASK | CAPT_CTRL_DMA_MASK, 0U);
+    DMA_AbortTransfer(handle->dmaHandle);
+
+    handle->state = kCAPT_TouchStateLowPowerEntry;
+
+    CAPT_ClearInterruptStatusFlags(base, CAPT_STATUS_YESTOUCH_MASK | CAPT_STATUS_NOTOUCH_MASK |
+                                             CAPT_STATUS_POLLDONE_MASK | CAPT_STATUS_TIMEOUT_MASK |
+                                             CAPT_STATUS_OVERUN_MASK);
+    CAPT_EnableInterrupts(base, (uint32_t)kCAPT_InterruptOfPollDoneEnable);
+    CAPT_PollNow(base, handle->xpins);
+}
+
+static void CAPT_TouchCallbackDMA(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode)
+{
+    capt_touch_handle_t *touchHandle = (capt_touch_handle_t *)userData;
+    uint32_t events                  = 0U;
+    uint32_t *samples;
+
+    if (!transferDone)
+    {
+        CAPT_TouchStop(touchHandle->base, touchHandle);
+        events = (uint32_t)kCAPT_TouchEventDmaError;
+    }
+    else if (touchHandle->state == kCAPT_TouchStateScan)
+    {
+        samples = &touchHandle->buffer[(intmode == (uint32_t)kDMA_IntA) ? 0U : touchHandle->blockSize];
+        events  = CAPT_TouchProcessRound(touchHandle, samples, touchHandle->blockSize);
+
+        if ((touchHandle->lowPowerIdleRounds != 0U) && (touchHandle->idleRounds >= touchHandle->lowPowerIdleRounds))
+        {
+            CAPT_TouchStartLowPower(touchHandle->base, touchHandle);
+        }
+    }
+    else
+    {
+        /* A block completed while the low-power mode was entered. */
+    }
+
+    if ((events != 0U) && (touchHandle->callback != NULL))
+    {
+        touchHandle->callback(touchHandle->base, touchHandle, events, touchHandle->userData);
+    }
+}
+
+/*!
+ * brief Gets the default touch pipeline configuration.
+ *
+ * param config Returns the default configuration.
+ */
+void CAPT_TouchGetDefaultConfig(capt_touch_config_t *config)
+{
+    assert(config != NULL);
+
+    /* Initializes the configure structure to zero. */
+    (void)memset(config, 0, sizeof(*config));
+
+    config->keyPins            = 0U;
+    config->sliderPins         = NULL;
+    config->sliderPinCount     = 0U;
+    config->sliderRange        = 256U;
+    config->filterShift        = 1U;
+    config->baselineShift      = 6U;
+    config->touchThreshold     = 60U;
+    config->releaseThreshold   = 40U;
+    config->touchDebounce      = 2U;
+    config->releaseDebounce    = 2U;
+    config->calibrationRounds  = 8U;
+    config->stuckRounds        = 2000U;
+    config->lowPowerIdleRounds = 0U;
+    config->lowPowerThreshold  = 10U;
+}
+
+/*!
+ * brief Init the CAPT touch handle.
+ *
+ * param base CAPT peripheral base address.
+ * param handle pointer to capt_touch_handle_t structure.
+ * param config Touch pipeline configuration.
+ * param callback pointer to user callback function.
+ * param userData user param passed to the callback function.
+ * param dmaHandle DMA handle pointer.
+ * param descriptors CAPT_TOUCH_DESCRIPTOR_NUM link descriptors allocated with DMA_ALLOCATE_LINK_DESCRIPTORS.
+ * retval kStatus_Success The handle is ready.
+ * retval kStatus_InvalidArgument No pin, a slider pin out of range or a release threshold over the touch one.
+ */
+status_t CAPT_TouchCreateHandle(CAPT_Type *base,
+                                capt_touch_handle_t *handle,
+                                const capt_touch_config_t *config,
+                                capt_touch_callback_t callback,
+                                void *userData,
+                                dma_handle_t *dmaHandle,
+                                dma_descriptor_t *descriptors)
+{
+    assert(handle != NULL);
+    assert(config != NULL);
+    assert(dmaHandle != NULL);
+    assert(descriptors != NULL);
+    assert(((uint32_t)descriptors & (FSL_FEATURE_DMA_LINK_DESCRIPTOR_ALIGN_SIZE - 1U)) == 0U);
+
+    uint32_t xpins = config->keyPins;
+    uint32_t i;
+
+    if ((config->sliderPinCount == 1U) || (config->sliderPinCount > CAPT_TOUCH_MAX_PINS) ||
+        ((config->sliderPinCount != 0U) && ((config->sliderPins == NULL) || (config->sliderRange < 2U))) ||
+        (config->releaseThreshold > config->touchThreshold) || (config->filterShift > config->baselineShift))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    for (i = 0U; i < config->sliderPinCount; i++)
+    {
+        if (config->sliderPins[i] >= CAPT_TOUCH_MAX_PINS)
+        {
+            return kStatus_InvalidArgument;
+        }
+        xpins |= 1UL << config->sliderPins[i];
+    }
+
+    if (xpins == 0U)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* Zero handle. */
+    (void)memset(handle, 0, sizeof(*handle));
+
+    handle->base               = base;
+    handle->dmaHandle          = dmaHandle;
+    handle->descriptors        = descriptors;
+    handle->xpins              = (uint16_t)xpins;
+    handle->blockSize          = (uint32_t)__builtin_popcount(xpins);
+    handle->keyPins            = config->keyPins;
+    handle->sliderPinCount     = config->sliderPinCount;
+    handle->sliderRange        = config->sliderRange;
+    handle->filterShift        = config->filterShift;
+    handle->baselineShift      = config->baselineShift;
+    handle->touchThreshold     = config->touchThreshold;
+    handle->releaseThreshold   = config->releaseThreshold;
+    handle->touchDebounce      = config->touchDebounce;
+    handle->releaseDebounce    = config->releaseDebounce;
+    handle->calibrationRounds  = (config->calibrationRounds != 0U) ? config->calibrationRounds : 1U;
+    handle->calibrationLeft    = handle->calibrationRounds;
+    handle->stuckRounds        = config->stuckRounds;
+    handle->lowPowerIdleRounds = config->lowPowerIdleRounds;
+    handle->lowPowerThreshold  = config->lowPowerThreshold;
+    handle->reseed             = (uint16_t)xpins;
+    handle->keys               = 0U;
+    handle->sliderPosition     = (uint16_t)CAPT_TOUCH_SLIDER_RELEASED;
+    handle->touchLower         = ((base->POLL_TCNT & CAPT_POLL_TCNT_TCHLOW_ER_MASK) != 0U);
+    handle->callback           = callback;
+    handle->userData           = userData;
+    for (i = 0U; i < config->sliderPinCount; i++)
+    {
+        handle->sliderPins[i] = config->sliderPins[i];
+    }
+
+    DMA_SetCallback(dmaHandle, CAPT_TouchCallbackDMA, handle);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Calibrates the baselines and starts the scan.
+ *
+ * param base CAPT peripheral base address.
+ * param handle pointer to capt_touch_handle_t structure.
+ * retval kStatus_Success The scan was started.
+ * retval kStatus_Busy The DMA channel is still in use.
+ */
+status_t CAPT_TouchStart(CAPT_Type *base, capt_touch_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    if (DMA_ChannelIsBusy(handle->dmaHandle->base, handle->dmaHandle->channel))
+    {
+        return kStatus_Busy;
+    }
+
+    handle->calibrationLeft = handle->calibrationRounds;
+    handle->reseed          = handle->xpins;
+    handle->keys            = 0U;
+    handle->sliderPosition  = (uint16_t)CAPT_TOUCH_SLIDER_RELEASED;
+    (void)memset(handle->channel, 0, sizeof(handle->channel));
+    (void)memset(&handle->stats, 0, sizeof(handle->stats));
+
+    CAPT_TouchStartScan(base, handle);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Stops the CAPT and the DMA.
+ *
+ * param base CAPT peripheral base address.
+ * param handle pointer to capt_touch_handle_t structure.
+ */
+void CAPT_TouchStop(CAPT_Type *base, capt_touch_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    CAPT_TouchSetCTRL(base, CAPT_CTRL_POLLMODE_MASK | CAPT_CTRL_DMA_MASK, 0U);
+    CAPT_DisableInterrupts(base, CAPT_INTENSET_YESTOUCH_MASK | CAPT_INTENSET_NOTOUCH_MASK |
+                                     CAPT_INTENSET_POLLDONE_MASK | CAPT_INTENSET_TIMEOUT_MASK |
+                                     CAPT_INTENSET_OVERUN_MASK);
+    DMA_AbortTransfer(handle->dmaHandle);
+
+    handle->state = kCAPT_TouchStateIdle;
+}
+
+/*!
+ * brief Switches to the low-power mode.
+ *
+ * param base CAPT peripheral base address.
+ * param handle pointer to capt_touch_handle_t structure.
+ * retval kStatus_Success The low-power mode is entered.
+ * retval kStatus_Fail The scan is not running or still calibrates.
+ */
+status_t CAPT_TouchEnterLowPower(CAPT_Type *base, capt_touch_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    status_t status = kStatus_Fail;
+    uint32_t primask;
+
+    /* The DMA interrupt may switch too. */
+    primask = DisableGlobalIRQ();
+    if ((handle->state == kCAPT_TouchStateScan) && (handle->calibrationLeft == 0U))
+    {
+        CAPT_TouchStartLowPower(base, handle);
+        status = kStatus_Success;
+    }
+    EnableGlobalIRQ(primask);
+
+    return status;
+}
+
+/*!
+ * brief CAPT interrupt handler of the touch pipeline.
+ *
+ * param base CAPT peripheral base address.
+ * param handle pointer to capt_touch_handle_t structure.
+ */
+void CAPT_TouchHandleIRQ(CAPT_Type *base, capt_touch_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    uint32_t flags  = CAPT_GetInterruptStatusFlags(base);
+    uint32_t events = 0U;
+    uint32_t count;
+
+    CAPT_ClearInterruptStatusFlags(base, flags);
+
+    if ((handle->state == kCAPT_TouchStateLowPowerEntry) &&
+        ((flags & (uint32_t)kCAPT_InterruptOfPollDoneStatusFlag) != 0U))
+    {
+        /* The count of all pins together sets the wake-up threshold, it follows the drift at each entry. */
+        count                 = (base->TOUCH & CAPT_TOUCH_COUNT_MASK) >> CAPT_TOUCH_COUNT_SHIFT;
+        handle->lowPowerCount = (uint16_t)count;
+        if (handle->touchLower)
+        {
+            count = (count > handle->lowPowerThreshold) ? (count - handle->lowPowerThreshold) : 0U;
+        }
+        else
+        {
+            count = count + handle->lowPowerThreshold;
+        }
+
+        CAPT_DisableInterrupts(base, (uint32_t)kCAPT_InterruptOfPollDoneEnable);
+        CAPT_SetThreshold(base, count);
+        CAPT_ClearInterruptStatusFlags(base, CAPT_STATUS_YESTOUCH_MASK | CAPT_STATUS_NOTOUCH_MASK |
+                                                 CAPT_STATUS_POLLDONE_MASK | CAPT_STATUS_TIMEOUT_MASK);
+        CAPT_EnableInterrupts(base, (uint32_t)kCAPT_InterruptOfYesTouchEnable);
+
+        handle->state = kCAPT_TouchStateLowPower;
+        handle->stats.lowPowerEntries++;
+        CAPT_TouchSetCTRL(base, CAPT_CTRL_POLLMODE_MASK, CAPT_CTRL_POLLMODE(kCAPT_PollLowPowerMode));
+        events = (uint32_t)kCAPT_TouchEventLowPower;
+    }
+    else if ((handle->state == kCAPT_TouchStateLowPower) &&
+             ((flags & (uint32_t)kCAPT_InterruptOfYesTouchStatusFlag) != 0U))
+    {
+        CAPT_DisableInterrupts(base, (uint32_t)kCAPT_InterruptOfYesTouchEnable);
+        handle->stats.wakeUps++;
+
+        /* The filters restart from the first counts, the baselines are corrected for the drift. */
+        handle->reseed = handle->xpins;
+        handle->resync = true;
+        CAPT_TouchStartScan(base, handle);
+        events = (uint32_t)kCAPT_TouchEventWakeUp;
+    }
+    else
+    {
+        /* Not an interrupt of the pipeline. */
+    }
+
+    if ((events != 0U) && (handle->callback != NULL))
+    {
+        handle->callback(base, handle, events, handle->userData);
+    }
+}
+
+/*!
+ * brief Processes the measurements of one polling round.
+ *
+ * param handle pointer to capt_touch_handle_t structure.
+ * param samples TOUCH register words, one per pin.
+ * param count Number of words.
+ * return Events of the round, see kCAPT_TouchEventKeys.
+ */
+uint32_t CAPT_TouchProcessRound(capt_touch_handle_t *handle, const uint32_t *samples, uint32_t count)
+{
+    assert(handle != NULL);
+    assert((samples != NULL) || (count == 0U));
+
+    capt_touch_channel_t *channel;
+    uint32_t events = 0U;
+    uint32_t keys   = 0U;
+    uint32_t pins   = 0U;
+    uint32_t pin;
+    uint32_t value;
+    uint32_t i;
+    uint16_t position;
+
+    for (i = 0U; i < count; i++)
+    {
+        pin = CAPT_TOUCH_SAMPLE_XPIN(samples[i]);
+        if ((handle->xpins & (1UL << pin)) == 0U)
+        {
+            continue;
+        }
+        if ((samples[i] & CAPT_TOUCH_ISTO_MASK) != 0U)
+        {
+            handle->stats.timeouts++;
+        }
+
+        channel = &handle->channel[pin];
+        value   = CAPT_TOUCH_SAMPLE_COUNT(samples[i]) << CAPT_TOUCH_FRAC_BITS;
+        if ((handle->reseed & (1UL << pin)) != 0U)
+        {
+            handle->reseed &= (uint16_t)~(1UL << pin);
+            channel->filtered = value;
+        }
+        else
+        {
+            channel->filtered = CAPT_TouchTrack(channel->filtered, value, handle->filterShift);
+        }
+        pins |= 1UL << pin;
+    }
+
+    if (handle->calibrationLeft != 0U)
+    {
+        for (pin = 0U; pin < CAPT_TOUCH_MAX_PINS; pin++)
+        {
+            if ((pins & (1UL << pin)) != 0U)
+            {
+                handle->channel[pin].baseline = handle->channel[pin].filtered;
+            }
+        }
+    }
+    else
+    {
+        if (handle->resync && (handle->reseed == 0U))
+        {
+            handle->resync = false;
+            CAPT_TouchResync(handle, pins);
+        }
+        for (pin = 0U; pin < CAPT_TOUCH_MAX_PINS; pin++)
+        {
+            if ((pins & (1UL << pin)) != 0U)
+            {
+                CAPT_TouchUpdateChannel(handle, &handle->channel[pin]);
+            }
+        }
+    }
+
+    handle->stats.rounds++;
+
+    if (handle->calibrationLeft != 0U)
+    {
+        handle->calibrationLeft--;
+        return (handle->calibrationLeft == 0U) ? (uint32_t)kCAPT_TouchEventCalibrated : 0U;
+    }
+
+    /* The keys and the slider are decoded once per round from the debounced pins. */
+    for (pin = 0U; pin < CAPT_TOUCH_MAX_PINS; pin++)
+    {
+        if (handle->channel[pin].touched)
+        {
+            keys |= 1UL << pin;
+        }
+    }
+    keys &= handle->keyPins;
+    if (keys != handle->keys)
+    {
+        handle->keys = (uint16_t)keys;
+        events |= (uint32_t)kCAPT_TouchEventKeys;
+    }
+
+    position = (handle->sliderPinCount != 0U) ? CAPT_TouchDecodeSlider(handle) : (uint16_t)CAPT_TOUCH_SLIDER_RELEASED;
+    if (position != handle->sliderPosition)
+    {
+        handle->sliderPosition = position;
+        events |= (uint32_t)kCAPT_TouchEventSlider;
+    }
+
+    if ((keys == 0U) && (position == (uint16_t)CAPT_TOUCH_SLIDER_RELEASED))
+    {
+        if (handle->idleRounds < UINT16_MAX)
+        {
+            handle->idleRounds++;
+        }
+    }
+    else
+    {
+        handle->idleRounds = 0U;
+    }
+
+    return events;
+}
+
+/*!
+ * brief Gets the statistics of the touch pipeline.
+ *
+ * param handle pointer to capt_touch_handle_t structure.
+ * param stats Returns the statistics.
+ */
+void CAPT_TouchGetStats(capt_touch_handle_t *handle, capt_touch_stats_t *stats)
+{
+    assert(handle != NULL);
+    assert(stats != NULL);
+
+    *stats = handle->stats;
+}
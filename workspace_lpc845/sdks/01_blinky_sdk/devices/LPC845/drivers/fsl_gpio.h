@@ -232,6 +232,11 @@ static inline uint32_t GPIO_PortRead(GPIO_Type *base, uint32_t port)
 /*!
  * @brief Sets port mask, 0 - enable pin, 1 - disable pin.
  *
+ * @note The mask register is shared by all masked accesses to the port and is not saved or restored.
+ * Setting it and then using GPIO_PortMaskedWrite() or GPIO_PortMaskedRead() is not atomic, so masked
+ * access to one port must not be shared between contexts, e.g. main loop and interrupt handler, unless
+ * each pair of calls is done inside a critical section.
+ *
  * @param base GPIO peripheral base pointer(Typically GPIO)
  * @param port GPIO port number
  * @param mask GPIO pin number macro
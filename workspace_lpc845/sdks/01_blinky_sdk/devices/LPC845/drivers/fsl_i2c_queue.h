@@ -0,0 +1,287 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef FSL_I2C_QUEUE_H_
+#define FSL_I2C_QUEUE_H_
+
+#include "fsl_i2c.h"
+#include "fsl_i2c_dma.h"
+
+/*!
+ * @addtogroup i2c_queue_driver
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*! @{ */
+/*! @brief I2C transaction queue driver version. */
+#define FSL_I2C_QUEUE_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*! @} */
+
+/*! @brief I2C transaction queue handle typedef. */
+typedef struct _i2c_queue_handle i2c_queue_handle_t;
+
+/*! @brief I2C queued transaction typedef. */
+typedef struct _i2c_queue_transaction i2c_queue_transaction_t;
+
+/*! @brief I2C transaction burst typedef. */
+typedef struct _i2c_queue_burst i2c_queue_burst_t;
+
+/*!
+ * @brief Timestamp source for the latency of the transactions.
+ *
+ * Any free running up counter works, e.g. a timer count. The latencies are in its ticks.
+ */
+typedef uint32_t (*i2c_queue_timestamp_t)(void);
+
+/*!
+ * @brief Transaction callback, called from the I2C interrupt when a transaction is done.
+ *
+ * The status of the transaction holds the result. The next queued transaction is started
+ * before the callback is called, the bus keeps running while the callback processes the data.
+ */
+typedef void (*i2c_queue_callback_t)(I2C_Type *base,
+                                     i2c_queue_handle_t *handle,
+                                     i2c_queue_transaction_t *transaction,
+                                     void *userData);
+
+/*!
+ * @brief Burst callback, called after the transaction callback of the last transaction of a burst.
+ *
+ * The status is kStatus_Success when all transactions of the burst succeeded, otherwise the
+ * status of the first one that failed.
+ */
+typedef void (*i2c_queue_burst_callback_t)(I2C_Type *base,
+                                           i2c_queue_handle_t *handle,
+                                           i2c_queue_burst_t *burst,
+                                           status_t status,
+                                           void *userData);
+
+/*! @brief Register read or write in the transaction queue. */
+struct _i2c_queue_transaction
+{
+    i2c_master_transfer_t xfer;    /*!< Transfer, see I2C_QueuePrepareTransaction. */
+    volatile status_t status;      /*!< kStatus_I2C_Busy while queued or running, then the result. */
+    uint32_t queueTime;            /*!< Timestamp of the submission. */
+    uint32_t startTime;            /*!< Timestamp of the start of the transfer. */
+    uint32_t doneTime;             /*!< Timestamp of the completion. */
+    i2c_queue_burst_t *burst;      /*!< Burst of the transaction, NULL for single submissions. */
+    i2c_queue_transaction_t *next; /*!< Next transaction in the queue. */
+};
+
+/*! @brief Transactions queued together, once or periodically. */
+struct _i2c_queue_burst
+{
+    i2c_queue_transaction_t *transactions; /*!< Transactions of the burst. */
+    size_t count;                          /*!< Number of transactions. */
+    uint32_t period;                       /*!< Period in calls of I2C_QueueTick, 0 for no period. */
+    uint32_t countdown;                    /*!< Calls of I2C_QueueTick until the next submission. */
+    volatile uint32_t remaining;           /*!< Transactions of the running submission not done yet. */
+    status_t status;                       /*!< First error of the running submission. */
+    uint32_t overruns;                     /*!< Periodic submissions skipped, the burst was still running. */
+    i2c_queue_burst_callback_t callback;   /*!< Burst callback, NULL if none. */
+    void *userData;                        /*!< User data for the burst callback. */
+    i2c_queue_burst_t *next;               /*!< Next periodic burst. */
+};
+
+/*! @brief Statistics of the transaction queue, times in timestamp ticks. */
+typedef struct _i2c_queue_stats
+{
+    uint32_t completed;  /*!< Transactions done successfully. */
+    uint32_t failed;     /*!< Transactions done with an error. */
+    uint32_t maxLatency; /*!< Longest time from the submission to the completion of a transaction. */
+    uint32_t maxGap;     /*!< Longest time the bus stayed idle with a transaction queued. */
+} i2c_queue_stats_t;
+
+/*! @brief I2C transaction queue handle. */
+struct _i2c_queue_handle
+{
+    union
+    {
+        i2c_master_handle_t master;  /*!< Handle of the interrupt transfer. */
+        i2c_master_dma_handle_t dma; /*!< Handle of the DMA transfer. */
+    } driver;                        /*!< Transfer driver handle. */
+    I2C_Type *base;                  /*!< I2C peripheral base address. */
+    bool useDma;                     /*!< Transfers run with I2C_MasterTransferDMA. */
+    i2c_queue_transaction_t *active; /*!< Running transaction, NULL when the bus is idle. */
+    i2c_queue_transaction_t *head;   /*!< First queued transaction. */
+    i2c_queue_transaction_t *tail;   /*!< Last queued transaction. */
+    i2c_queue_burst_t *bursts;       /*!< Periodic bursts. */
+    i2c_queue_timestamp_t timestamp; /*!< Timestamp source, NULL if none. */
+    uint32_t lastDoneTime;           /*!< Timestamp of the last completion. */
+    i2c_queue_callback_t callback;   /*!< Transaction callback, NULL if none. */
+    void *userData;                  /*!< User data for the transaction callback. */
+    i2c_queue_stats_t stats;         /*!< Statistics. */
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name Transaction queue
+ * @{
+ */
+
+/*!
+ * @brief Initializes the transaction queue on top of the interrupt transfer driver.
+ *
+ * The I2C master must be initialized with I2C_MasterInit. The queue takes the transactional
+ * handle of the instance, do not mix it with other transactional calls on the same instance.
+ *
+ * @param base I2C peripheral base address.
+ * @param handle Transaction queue handle.
+ * @param callback Transaction callback, NULL if none.
+ * @param userData User data for the transaction callback.
+ * @param timestamp Timestamp source for the latencies, NULL if none.
+ */
+void I2C_QueueCreateHandle(I2C_Type *base,
+                           i2c_queue_handle_t *handle,
+                           i2c_queue_callback_t callback,
+                           void *userData,
+                           i2c_queue_timestamp_t timestamp);
+
+/*!
+ * @brief Initializes the transaction queue on top of the DMA transfer driver.
+ *
+ * @param base I2C peripheral base address.
+ * @param handle Transaction queue handle.
+ * @param dmaHandle DMA handle of the I2C master request channel, the handle shall be static allocated by users.
+ * @param callback Transaction callback, NULL if none.
+ * @param userData User data for the transaction callback.
+ * @param timestamp Timestamp source for the latencies, NULL if none.
+ */
+void I2C_QueueCreateHandleDMA(I2C_Type *base,
+                              i2c_queue_handle_t *handle,
+                              dma_handle_t *dmaHandle,
+                              i2c_queue_callback_t callback,
+                              void *userData,
+                              i2c_queue_timestamp_t timestamp);
+
+/*!
+ * @brief Prepares a register read or write.
+ *
+ * @param transaction Transaction to prepare.
+ * @param slaveAddress 7-bit slave address.
+ * @param direction kI2C_Read or kI2C_Write.
+ * @param reg Register address, sent MSB first before the data.
+ * @param regSize Size of the register address in bytes, 0 to 4.
+ * @param data Data to read or write.
+ * @param dataSize Number of data bytes.
+ */
+void I2C_QueuePrepareTransaction(i2c_queue_transaction_t *transaction,
+                                 uint8_t slaveAddress,
+                                 i2c_direction_t direction,
+                                 uint32_t reg,
+                                 size_t regSize,
+                                 void *data,
+                                 size_t dataSize);
+
+/*!
+ * @brief Queues transactions.
+ *
+ * The transactions run in the order of the array, after the ones queued before. The next
+ * transaction is started from the interrupt that completes the previous one. Can be called
+ * from interrupts, including the callbacks.
+ *
+ * @code
+ * I2C_QueuePrepareTransaction(&xfer[0], ACCEL_ADDR, kI2C_Read, ACCEL_OUT_X, 1U, accel, 6U);
+ * I2C_QueuePrepareTransaction(&xfer[1], GYRO_ADDR, kI2C_Read, GYRO_OUT_X, 1U, gyro, 6U);
+ * I2C_QueueSubmit(I2C0, &queueHandle, xfer, 2U);
+ * @endcode
+ *
+ * @param base I2C peripheral base address.
+ * @param handle Transaction queue handle.
+ * @param transactions Transactions, they must stay valid until they are done.
+ * @param count Number of transactions.
+ * @retval kStatus_Success The transactions are queued.
+ * @retval kStatus_InvalidArgument A transaction has an invalid register address size.
+ * @retval kStatus_I2C_Busy A transaction is queued already.
+ */
+status_t I2C_QueueSubmit(I2C_Type *base,
+                         i2c_queue_handle_t *handle,
+                         i2c_queue_transaction_t *transactions,
+                         size_t count);
+
+/*!
+ * @brief Initializes a burst of transactions.
+ *
+ * @param burst Burst to initialize.
+ * @param transactions Prepared transactions of the burst.
+ * @param count Number of transactions.
+ * @param period Period in calls of I2C_QueueTick, 0 if the burst is only submitted by I2C_QueueSubmitBurst.
+ * @param callback Burst callback, NULL if none.
+ * @param userData User data for the burst callback.
+ */
+void I2C_QueueCreateBurst(i2c_queue_burst_t *burst,
+                          i2c_queue_transaction_t *transactions,
+                          size_t count,
+                          uint32_t period,
+                          i2c_queue_burst_callback_t callback,
+                          void *userData);
+
+/*!
+ * @brief Queues all transactions of a burst.
+ *
+ * @param base I2C peripheral base address.
+ * @param handle Transaction queue handle.
+ * @param burst Burst to queue.
+ * @retval kStatus_Success The transactions are queued.
+ * @retval kStatus_I2C_Busy The previous submission of the burst is still running, counted as overrun.
+ */
+status_t I2C_QueueSubmitBurst(I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_burst_t *burst);
+
+/*!
+ * @brief Adds a periodic burst, it is submitted every period calls of I2C_QueueTick.
+ *
+ * @param base I2C peripheral base address.
+ * @param handle Transaction queue handle.
+ * @param burst Burst with a period.
+ */
+void I2C_QueueAddBurst(I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_burst_t *burst);
+
+/*!
+ * @brief Removes a periodic burst, a running submission completes.
+ *
+ * @param base I2C peripheral base address.
+ * @param handle Transaction queue handle.
+ * @param burst Burst to remove.
+ */
+void I2C_QueueRemoveBurst(I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_burst_t *burst);
+
+/*!
+ * @brief Submits the periodic bursts that are due.
+ *
+ * Call it from a periodic interrupt, e.g. SysTick.
+ *
+ * @param base I2C peripheral base address.
+ * @param handle Transaction queue handle.
+ */
+void I2C_QueueTick(I2C_Type *base, i2c_queue_handle_t *handle);
+
+/*!
+ * @brief Gets the statistics of the transaction queue.
+ *
+ * @param base I2C peripheral base address.
+ * @param handle Transaction queue handle.
+ * @param stats Returns the statistics.
+ */
+void I2C_QueueGetStats(I2C_Type *base, i2c_queue_handle_t *handle, i2c_queue_stats_t *stats);
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* FSL_I2C_QUEUE_H_ */
@@ -0,0 +1,913 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "fsl_iap_store.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.iap_store"
+#endif
+
+#define IAP_STORE_PAGE_SIZE    ((uint32_t)FSL_FEATURE_SYSCON_FLASH_PAGE_SIZE_BYTES)
+#define IAP_STORE_SECTOR_PAGES ((uint32_t)FSL_FEATURE_SYSCON_FLASH_SECTOR_SIZE_BYTES / IAP_STORE_PAGE_SIZE)
+#define IAP_STORE_MAGIC        (0x5354U)
+#define IAP_STORE_RETIRED      (0x0000U)
+#define IAP_STORE_CRC_SEED     (0xFFFFU)
+
+/*
+ * Block header, at the start of every block in use. The CRC covers the sequence and the erase
+ * count, the magic is programmed to IAP_STORE_RETIRED once the live records of the block are
+ * copied by the garbage collection.
+ */
+typedef struct _iap_store_block_header
+{
+    uint32_t sequence;
+    uint32_t eraseCount;
+    uint16_t magic;
+    uint16_t crc;
+} iap_store_block_header_t;
+
+/* Record header, followed by the value. The CRC covers the members before it and the value. */
+typedef struct _iap_store_record_header
+{
+    uint16_t key;
+    uint16_t length;
+    uint16_t reserved;
+    uint16_t crc;
+} iap_store_record_header_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* CRC-16/CCITT, polynomial 0x1021, four bits per lookup. */
+static const uint16_t s_iapStoreCrcTable[16] = {
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint16_t IAP_StoreCrc(uint16_t crc, const uint8_t *data, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        crc = (uint16_t)(crc << 4U) ^ s_iapStoreCrcTable[((uint32_t)crc >> 12U) ^ ((uint32_t)data[i] >> 4U)];
+        crc = (uint16_t)(crc << 4U) ^ s_iapStoreCrcTable[(((uint32_t)crc >> 12U) ^ (uint32_t)data[i]) & 0x0FU];
+    }
+
+    return crc;
+}
+
+static const uint8_t *IAP_StoreBlockAddress(iap_store_handle_t *handle, uint32_t block)
+{
+    uint32_t page = handle->startPage + (block * IAP_STORE_BLOCK_PAGES);
+
+    return (const uint8_t *)(uintptr_t)((uint32_t)IAP_STORE_FLASH_BASE + (page * IAP_STORE_PAGE_SIZE));
+}
+
+static uint32_t IAP_StoreRecordSize(uint32_t length)
+{
+    uint32_t size = IAP_STORE_RECORD_HEADER_SIZE + ((length == IAP_STORE_DELETED) ? 0U : length);
+
+    return (size + IAP_STORE_RECORD_ALIGN - 1U) & ~(IAP_STORE_RECORD_ALIGN - 1U);
+}
+
+static bool IAP_StoreIsBlank(const uint8_t *data, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0U; i < length; i++)
+    {
+        if (data[i] != 0xFFU)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static uint16_t IAP_StoreRecordCrc(const iap_store_record_header_t *header, const uint8_t *data)
+{
+    uint16_t crc = IAP_StoreCrc(IAP_STORE_CRC_SEED, (const uint8_t *)header, offsetof(iap_store_record_header_t, crc));
+
+    return (header->length == IAP_STORE_DELETED) ? crc : IAP_StoreCrc(crc, data, header->length);
+}
+
+/* Binary search of the index, returns the entry of the key or the position to insert it. */
+static bool IAP_StoreFind(iap_store_handle_t *handle, uint16_t key, uint32_t *position)
+{
+    uint32_t low  = 0U;
+    uint32_t high = handle->indexCount;
+    uint32_t middle;
+
+    while (low < high)
+    {
+        middle = (low + high) / 2U;
+        if (handle->index[middle].key < key)
+        {
+            low = middle + 1U;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    *position = low;
+
+    return (low < handle->indexCount) && (handle->index[low].key == key);
+}
+
+/* Points the index at a new record of the key, the previous record is no longer live. */
+static status_t IAP_StoreIndexUpdate(
+    iap_store_handle_t *handle, uint16_t key, uint32_t block, uint32_t offset, uint32_t length)
+{
+    iap_store_entry_t *entry;
+    uint32_t position;
+
+    if (IAP_StoreFind(handle, key, &position))
+    {
+        entry = &handle->index[position];
+        handle->blocks[entry->block].live -= (uint16_t)IAP_StoreRecordSize(entry->length);
+    }
+    else
+    {
+        if (handle->indexCount == handle->indexSize)
+        {
+            return kStatus_IAP_StoreIndexFull;
+        }
+        (void)memmove(&handle->index[position + 1U], &handle->index[position],
+                      (handle->indexCount - position) * sizeof(iap_store_entry_t));
+        handle->indexCount++;
+        entry      = &handle->index[position];
+        entry->key = key;
+    }
+
+    entry->block  = (uint16_t)block;
+    entry->offset = (uint16_t)offset;
+    entry->length = (uint16_t)length;
+    handle->blocks[block].live += (uint16_t)IAP_StoreRecordSize(length);
+
+    return kStatus_Success;
+}
+
+static void IAP_StoreIndexRemove(iap_store_handle_t *handle, uint32_t position)
+{
+    iap_store_entry_t *entry = &handle->index[position];
+
+    handle->blocks[entry->block].live -= (uint16_t)IAP_StoreRecordSize(entry->length);
+    handle->indexCount--;
+    (void)memmove(entry, entry + 1, (handle->indexCount - position) * sizeof(iap_store_entry_t));
+}
+
+/*
+ * Programs a header and its data at an offset of a block. The pages are programmed with their
+ * current content, only the erased bytes of the new record change.
+ */
+static status_t IAP_StoreProgram(iap_store_handle_t *handle,
+                                 uint32_t block,
+                                 uint32_t offset,
+                                 const void *header,
+                                 uint32_t headerSize,
+                                 const uint8_t *data,
+                                 uint32_t dataSize)
+{
+    const uint8_t *flash = IAP_StoreBlockAddress(handle, block);
+    uint8_t *buffer      = (uint8_t *)handle->buffer;
+    uint32_t firstPage   = offset / IAP_STORE_PAGE_SIZE;
+    uint32_t pages       = ((offset + headerSize + dataSize - 1U) / IAP_STORE_PAGE_SIZE) - firstPage + 1U;
+    uint32_t page        = handle->startPage + (block * IAP_STORE_BLOCK_PAGES) + firstPage;
+    uint32_t start       = offset - (firstPage * IAP_STORE_PAGE_SIZE);
+    uint32_t sector      = page / IAP_STORE_SECTOR_PAGES;
+    status_t status;
+
+    (void)memcpy(buffer, &flash[firstPage * IAP_STORE_PAGE_SIZE], pages * IAP_STORE_PAGE_SIZE);
+    (void)memcpy(&buffer[start], header, headerSize);
+    if (dataSize != 0U)
+    {
+        (void)memcpy(&buffer[start + headerSize], data, dataSize);
+    }
+
+    status = IAP_PrepareSectorForWrite(sector, sector);
+    if (status == kStatus_Success)
+    {
+        status = IAP_CopyRamToFlash(page * IAP_STORE_PAGE_SIZE, handle->buffer, pages * IAP_STORE_PAGE_SIZE,
+                                    handle->systemCoreClock);
+    }
+    handle->stats.programs++;
+    handle->stats.programBytes += pages * IAP_STORE_PAGE_SIZE;
+
+    if ((status == kStatus_Success) && (memcmp(&flash[offset], &buffer[start], headerSize + dataSize) != 0))
+    {
+        status = kStatus_IAP_StoreVerifyError;
+    }
+
+    return status;
+}
+
+static status_t IAP_StoreErase(iap_store_handle_t *handle, uint32_t block)
+{
+    iap_store_block_t *state = &handle->blocks[block];
+    uint32_t page            = handle->startPage + (block * IAP_STORE_BLOCK_PAGES);
+    uint32_t sector          = page / IAP_STORE_SECTOR_PAGES;
+    status_t status;
+
+    status = IAP_PrepareSectorForWrite(sector, sector);
+    if (status == kStatus_Success)
+    {
+        status = IAP_ErasePage(page, page + IAP_STORE_BLOCK_PAGES - 1U, handle->systemCoreClock);
+    }
+    state->eraseCount++;
+    handle->stats.erases++;
+
+    state->dirty = (status != kStatus_Success) || !IAP_StoreIsBlank(IAP_StoreBlockAddress(handle, block),
+                                                                     IAP_STORE_BLOCK_SIZE);
+
+    return state->dirty ? ((status != kStatus_Success) ? status : kStatus_IAP_StoreVerifyError) : kStatus_Success;
+}
+
+static void IAP_StoreCloseActive(iap_store_handle_t *handle)
+{
+    if (handle->active < handle->blockCount)
+    {
+        handle->blocks[handle->active].state = (uint8_t)kIAP_StoreBlockClosed;
+        handle->active                       = handle->blockCount;
+    }
+}
+
+/* Opens the free block with the fewest erases as the active block. */
+static status_t IAP_StoreOpenBlock(iap_store_handle_t *handle)
+{
+    iap_store_block_header_t header;
+    iap_store_block_t *state;
+    uint32_t block = handle->blockCount;
+    uint32_t i;
+    status_t status;
+
+    for (i = 0U; i < handle->blockCount; i++)
+    {
+        if ((handle->blocks[i].state == (uint8_t)kIAP_StoreBlockFree) &&
+            ((block == handle->blockCount) || (handle->blocks[i].eraseCount < handle->blocks[block].eraseCount)))
+        {
+            block = i;
+        }
+    }
+    if (block == handle->blockCount)
+    {
+        return kStatus_IAP_StoreFull;
+    }
+    state = &handle->blocks[block];
+
+    if (state->dirty)
+    {
+        status = IAP_StoreErase(handle, block);
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
+    }
+
+    header.sequence   = handle->nextSequence;
+    header.eraseCount = state->eraseCount;
+    header.magic      = IAP_STORE_MAGIC;
+    header.crc = IAP_StoreCrc(IAP_STORE_CRC_SEED, (const uint8_t *)&header, offsetof(iap_store_block_header_t, magic));
+
+    status = IAP_StoreProgram(handle, block, 0U, &header, sizeof(header), NULL, 0U);
+    if (status != kStatus_Success)
+    {
+        state->dirty = true;
+        return status;
+    }
+
+    IAP_StoreCloseActive(handle);
+    handle->nextSequence++;
+    handle->freeBlocks--;
+    handle->active  = block;
+    state->sequence = header.sequence;
+    state->used     = (uint16_t)IAP_STORE_BLOCK_HEADER_SIZE;
+    state->live     = 0U;
+    state->state    = (uint8_t)kIAP_StoreBlockActive;
+
+    return kStatus_Success;
+}
+
+/*
+ * Appends a record to the active block, opens a new one when it is full. Only the garbage
+ * collection takes the reserved free blocks.
+ */
+static status_t IAP_StoreAppend(iap_store_handle_t *handle,
+                                uint16_t key,
+                                const uint8_t *data,
+                                uint32_t length,
+                                bool useReserve,
+                                uint32_t *block,
+                                uint32_t *offset)
+{
+    iap_store_record_header_t header;
+    iap_store_block_t *state;
+    uint32_t size = IAP_StoreRecordSize(length);
+    status_t status;
+
+    if ((handle->active == handle->blockCount) || ((handle->blocks[handle->active].used + size) > IAP_STORE_BLOCK_SIZE))
+    {
+        if ((!useReserve) && (handle->freeBlocks <= IAP_STORE_RESERVE_BLOCKS))
+        {
+            return kStatus_IAP_StoreFull;
+        }
+        status = IAP_StoreOpenBlock(handle);
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
+    }
+    state = &handle->blocks[handle->active];
+
+    header.key      = key;
+    header.length   = (uint16_t)length;
+    header.reserved = 0xFFFFU;
+    header.crc      = IAP_StoreRecordCrc(&header, data);
+
+    status = IAP_StoreProgram(handle, handle->active, state->used, &header, sizeof(header), data,
+                              (length == IAP_STORE_DELETED) ? 0U : length);
+    if (status != kStatus_Success)
+    {
+        /* The rest of the block is no longer known to be blank. */
+        state->used = (uint16_t)IAP_STORE_BLOCK_SIZE;
+        IAP_StoreCloseActive(handle);
+        return status;
+    }
+
+    *block      = handle->active;
+    *offset     = state->used;
+    state->used = (uint16_t)(state->used + size);
+
+    return kStatus_Success;
+}
+
+/* Returns true when a block holds a record of the key before the offset. */
+static bool IAP_StoreHasOlderRecord(iap_store_handle_t *handle, uint32_t block, uint16_t key, uint32_t offset)
+{
+    const uint8_t *flash = IAP_StoreBlockAddress(handle, block);
+    iap_store_record_header_t header;
+    uint32_t position = IAP_STORE_BLOCK_HEADER_SIZE;
+
+    while (position < offset)
+    {
+        (void)memcpy(&header, &flash[position], sizeof(header));
+        if (header.key == key)
+        {
+            return true;
+        }
+        position += IAP_StoreRecordSize(header.length);
+    }
+
+    return false;
+}
+
+/*
+ * Picks the block to collect: the closed block with the least live data, or with wear leveling the
+ * closed block with the fewest erases when it fell IAP_STORE_WEAR_LIMIT behind. Returns blockCount
+ * when no block would give space.
+ */
+static uint32_t IAP_StoreSelectVictim(iap_store_handle_t *handle, bool wearLeveling)
+{
+    iap_store_block_t *state;
+    uint32_t victim   = handle->blockCount;
+    uint32_t coldest  = handle->blockCount;
+    uint32_t maxErase = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < handle->blockCount; i++)
+    {
+        state    = &handle->blocks[i];
+        maxErase = (state->eraseCount > maxErase) ? state->eraseCount : maxErase;
+        if (state->state != (uint8_t)kIAP_StoreBlockClosed)
+        {
+            continue;
+        }
+        if ((coldest == handle->blockCount) || (state->eraseCount < handle->blocks[coldest].eraseCount))
+        {
+            coldest = i;
+        }
+        if ((victim == handle->blockCount) || (state->live < handle->blocks[victim].live) ||
+            ((state->live == handle->blocks[victim].live) && (state->eraseCount < handle->blocks[victim].eraseCount)))
+        {
+            victim = i;
+        }
+    }
+
+    if (wearLeveling && (coldest != handle->blockCount) &&
+        ((maxErase - handle->blocks[coldest].eraseCount) >= IAP_STORE_WEAR_LIMIT))
+    {
+        return coldest;
+    }
+    if ((victim != handle->blockCount) &&
+        (handle->blocks[victim].live >= (IAP_STORE_BLOCK_SIZE - IAP_STORE_BLOCK_HEADER_SIZE)))
+    {
+        return handle->blockCount;
+    }
+
+    return victim;
+}
+
+/*
+ * Copies the live records of a closed block to the active block, then retires and erases it. A
+ * reset before the block is retired finds the copies in the latest block and drops them.
+ */
+static status_t IAP_StoreCollectBlock(iap_store_handle_t *handle, uint32_t victim)
+{
+    const uint8_t *flash     = IAP_StoreBlockAddress(handle, victim);
+    iap_store_block_t *state = &handle->blocks[victim];
+    uint16_t retired         = IAP_STORE_RETIRED;
+    iap_store_entry_t *entry;
+    bool oldest = true;
+    uint32_t block;
+    uint32_t offset;
+    uint32_t i;
+    status_t status;
+
+    for (i = 0U; i < handle->blockCount; i++)
+    {
+        if ((handle->blocks[i].state != (uint8_t)kIAP_StoreBlockFree) &&
+            (handle->blocks[i].sequence < state->sequence))
+        {
+            oldest = false;
+        }
+    }
+
+    i = 0U;
+    while (i < handle->indexCount)
+    {
+        entry = &handle->index[i];
+        if (entry->block != victim)
+        {
+            i++;
+            continue;
+        }
+
+        /* No older record of a deleted key can come back once the oldest block is erased. */
+        if ((entry->length == IAP_STORE_DELETED) && oldest &&
+            !IAP_StoreHasOlderRecord(handle, victim, entry->key, entry->offset))
+        {
+            IAP_StoreIndexRemove(handle, i);
+            continue;
+        }
+
+        status = IAP_StoreAppend(handle, entry->key, &flash[entry->offset + IAP_STORE_RECORD_HEADER_SIZE],
+                                 entry->length, true, &block, &offset);
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
+        handle->stats.movedBytes += IAP_StoreRecordSize(entry->length);
+        (void)IAP_StoreIndexUpdate(handle, entry->key, block, offset, entry->length);
+        i++;
+    }
+
+    /* The erase below fails the same way if this does not program. */
+    (void)IAP_StoreProgram(handle, victim, offsetof(iap_store_block_header_t, magic), &retired, sizeof(retired),
+                           NULL, 0U);
+
+    state->state = (uint8_t)kIAP_StoreBlockFree;
+    state->used  = 0U;
+    state->live  = 0U;
+    handle->freeBlocks++;
+    handle->stats.collections++;
+
+    /* A failed erase leaves the block dirty, it is erased again before it is opened. */
+    return IAP_StoreErase(handle, victim);
+}
+
+/* Collects until a record of the size fits without the reserved blocks. */
+static status_t IAP_StoreMakeSpace(iap_store_handle_t *handle, uint32_t size)
+{
+    uint32_t victim;
+    uint32_t rounds;
+    status_t status;
+
+    for (rounds = 0U; rounds < (2U * handle->blockCount); rounds++)
+    {
+        if (((handle->active != handle->blockCount) &&
+             ((handle->blocks[handle->active].used + size) <= IAP_STORE_BLOCK_SIZE)) ||
+            (handle->freeBlocks > IAP_STORE_RESERVE_BLOCKS))
+        {
+            return kStatus_Success;
+        }
+
+        /* Moving cold data gives no space, once per write at most. */
+        victim = IAP_StoreSelectVictim(handle, rounds == 0U);
+        if (victim == handle->blockCount)
+        {
+            break;
+        }
+        status = IAP_StoreCollectBlock(handle, victim);
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
+    }
+
+    return kStatus_IAP_StoreFull;
+}
+
+static status_t IAP_StoreWriteRecord(iap_store_handle_t *handle, uint16_t key, const uint8_t *data, uint32_t length)
+{
+    uint32_t block;
+    uint32_t offset;
+    status_t status;
+
+    status = IAP_StoreMakeSpace(handle, IAP_StoreRecordSize(length));
+    if (status == kStatus_Success)
+    {
+        status = IAP_StoreAppend(handle, key, data, length, false, &block, &offset);
+    }
+    if (status == kStatus_Success)
+    {
+        status = IAP_StoreIndexUpdate(handle, key, block, offset, length);
+    }
+
+    return status;
+}
+
+/* Reads the records of a block in use into the index and finds the end of its log. */
+static status_t IAP_StoreScanBlock(iap_store_handle_t *handle, uint32_t block)
+{
+    const uint8_t *flash     = IAP_StoreBlockAddress(handle, block);
+    iap_store_block_t *state = &handle->blocks[block];
+    iap_store_record_header_t header;
+    uint32_t offset = IAP_STORE_BLOCK_HEADER_SIZE;
+    uint32_t size;
+    status_t status;
+
+    while ((offset + IAP_STORE_RECORD_HEADER_SIZE) <= IAP_STORE_BLOCK_SIZE)
+    {
+        (void)memcpy(&header, &flash[offset], sizeof(header));
+        if (IAP_StoreIsBlank((const uint8_t *)&header, sizeof(header)))
+        {
+            /* Records are appended only while the rest of the block is erased. */
+            if (!IAP_StoreIsBlank(&flash[offset], IAP_STORE_BLOCK_SIZE - offset))
+            {
+                handle->stats.tornRecords++;
+                offset = IAP_STORE_BLOCK_SIZE;
+            }
+            break;
+        }
+
+        size = IAP_StoreRecordSize(header.length);
+        if ((header.key > IAP_STORE_MAX_KEY) ||
+            ((header.length > IAP_STORE_MAX_VALUE_SIZE) && (header.length != IAP_STORE_DELETED)) ||
+            ((offset + size) > IAP_STORE_BLOCK_SIZE) ||
+            (IAP_StoreRecordCrc(&header, &flash[offset + IAP_STORE_RECORD_HEADER_SIZE]) != header.crc))
+        {
+            /* Torn by a reset, the block is closed. */
+            handle->stats.tornRecords++;
+            offset = IAP_STORE_BLOCK_SIZE;
+            break;
+        }
+
+        handle->stats.scannedRecords++;
+        status = IAP_StoreIndexUpdate(handle, header.key, block, offset, header.length);
+        if (status != kStatus_Success)
+        {
+            return status;
+        }
+        offset += size;
+    }
+
+    state->used = (uint16_t)offset;
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Opens the store and builds the index from the records in flash.
+ *
+ * param handle Store handle.
+ * param config Store configuration.
+ * retval kStatus_Success The store is open.
+ * retval kStatus_InvalidArgument The configuration is invalid.
+ * retval kStatus_IAP_StoreIndexFull The flash holds more keys than the index, the store is not usable.
+ */
+status_t IAP_StoreInit(iap_store_handle_t *handle, const iap_store_config_t *config)
+{
+    assert(handle != NULL);
+    assert(config != NULL);
+
+    iap_store_block_header_t header;
+    iap_store_block_t *state;
+    const uint8_t *flash;
+    uint32_t blockCount = config->pageCount / IAP_STORE_BLOCK_PAGES;
+    uint32_t maxErase   = 0U;
+    uint32_t last       = blockCount;
+    bool valid;
+    uint32_t next;
+    uint32_t i;
+    status_t status;
+
+    if (((config->startPage % IAP_STORE_BLOCK_PAGES) != 0U) || ((config->pageCount % IAP_STORE_BLOCK_PAGES) != 0U) ||
+        (blockCount < (IAP_STORE_RESERVE_BLOCKS + 2U)) || (blockCount > 0xFFFFU) || (config->blocks == NULL) ||
+        (config->index == NULL) || ((IAP_STORE_SECTOR_PAGES % IAP_STORE_BLOCK_PAGES) != 0U) ||
+        ((IAP_STORE_PAGE_SIZE % IAP_STORE_RECORD_ALIGN) != 0U) || ((IAP_STORE_RECORD_ALIGN % 4U) != 0U))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    (void)memset(handle, 0, sizeof(*handle));
+    (void)memset(config->blocks, 0, blockCount * sizeof(iap_store_block_t));
+    handle->startPage       = config->startPage;
+    handle->blockCount      = blockCount;
+    handle->blocks          = config->blocks;
+    handle->index           = config->index;
+    handle->indexSize       = config->indexSize;
+    handle->active          = blockCount;
+    handle->systemCoreClock = config->systemCoreClock;
+
+    for (i = 0U; i < blockCount; i++)
+    {
+        state = &handle->blocks[i];
+        flash = IAP_StoreBlockAddress(handle, i);
+        (void)memcpy(&header, flash, sizeof(header));
+        valid = (header.crc ==
+                 IAP_StoreCrc(IAP_STORE_CRC_SEED, (const uint8_t *)&header, offsetof(iap_store_block_header_t, magic)));
+        if (valid)
+        {
+            state->sequence   = header.sequence;
+            state->eraseCount = header.eraseCount;
+            maxErase          = (header.eraseCount > maxErase) ? header.eraseCount : maxErase;
+        }
+        else
+        {
+            state->eraseCount = UINT32_MAX;
+        }
+        if (valid && (header.magic == IAP_STORE_MAGIC))
+        {
+            state->state = (uint8_t)kIAP_StoreBlockClosed;
+        }
+        else
+        {
+            /* Retired, or the erase or the header was torn. */
+            state->state = (uint8_t)kIAP_StoreBlockFree;
+            state->dirty = !IAP_StoreIsBlank(flash, IAP_STORE_BLOCK_SIZE);
+            handle->freeBlocks++;
+        }
+    }
+
+    /* The erase count of a block without header is lost, assume the highest one. */
+    for (i = 0U; i < blockCount; i++)
+    {
+        if (handle->blocks[i].eraseCount == UINT32_MAX)
+        {
+            handle->blocks[i].eraseCount = maxErase;
+        }
+    }
+
+    /*
+     * Only the garbage collection takes a reserved block, and it frees its victim before any other
+     * write. With a reserved block missing the latest block holds the copies of an interrupted
+     * collection, the victim still holds the records, the collection runs again.
+     */
+    if (handle->freeBlocks < IAP_STORE_RESERVE_BLOCKS)
+    {
+        for (i = 0U; i < blockCount; i++)
+        {
+            if ((handle->blocks[i].state == (uint8_t)kIAP_StoreBlockClosed) &&
+                ((last == blockCount) || (handle->blocks[i].sequence > handle->blocks[last].sequence)))
+            {
+                last = i;
+            }
+        }
+        handle->blocks[last].state = (uint8_t)kIAP_StoreBlockFree;
+        handle->blocks[last].dirty = true;
+        handle->freeBlocks++;
+        last = blockCount;
+    }
+
+    /* Scan the blocks in the order they were opened, later records replace earlier ones. */
+    do
+    {
+        next = blockCount;
+        for (i = 0U; i < blockCount; i++)
+        {
+            state = &handle->blocks[i];
+            if ((state->state == (uint8_t)kIAP_StoreBlockClosed) &&
+                ((last == blockCount) || (state->sequence > handle->blocks[last].sequence)) &&
+                ((next == blockCount) || (state->sequence < handle->blocks[next].sequence)))
+            {
+                next = i;
+            }
+        }
+        if (next != blockCount)
+        {
+            status = IAP_StoreScanBlock(handle, next);
+            if (status != kStatus_Success)
+            {
+                return status;
+            }
+            last                 = next;
+            handle->nextSequence = handle->blocks[next].sequence + 1U;
+        }
+    } while (next != blockCount);
+
+    /* Only the latest block takes new records, a record in an earlier one would lose to older ones. */
+    if ((last != blockCount) && (handle->blocks[last].used < IAP_STORE_BLOCK_SIZE))
+    {
+        handle->blocks[last].state = (uint8_t)kIAP_StoreBlockActive;
+        handle->active             = last;
+    }
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Erases the store, all values are lost.
+ *
+ * param handle Store handle.
+ * retval kStatus_Success The store is empty.
+ * return The IAP status of a failed erase.
+ */
+status_t IAP_StoreFormat(iap_store_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    iap_store_block_t *state;
+    uint32_t i;
+    status_t result;
+    status_t status = kStatus_Success;
+
+    handle->indexCount = 0U;
+    handle->active     = handle->blockCount;
+    handle->freeBlocks = handle->blockCount;
+
+    for (i = 0U; i < handle->blockCount; i++)
+    {
+        state        = &handle->blocks[i];
+        state->state = (uint8_t)kIAP_StoreBlockFree;
+        state->used  = 0U;
+        state->live  = 0U;
+        result = IAP_StoreErase(handle, i);
+        if ((result != kStatus_Success) && (status == kStatus_Success))
+        {
+            status = result;
+        }
+    }
+
+    return status;
+}
+
+/*!
+ * brief Writes the value of a key.
+ *
+ * param handle Store handle.
+ * param key Key, 0 to IAP_STORE_MAX_KEY.
+ * param data Value.
+ * param length Value size, up to IAP_STORE_MAX_VALUE_SIZE.
+ * retval kStatus_Success The value is committed, it survives a reset.
+ * retval kStatus_InvalidArgument Invalid key or size.
+ * retval kStatus_IAP_StoreIndexFull The key is new and the index is full.
+ * retval kStatus_IAP_StoreFull Not enough space in the store.
+ * retval kStatus_IAP_StoreVerifyError The record did not program correctly.
+ * return The IAP status of a failed program or erase.
+ */
+status_t IAP_StoreWrite(iap_store_handle_t *handle, uint16_t key, const void *data, size_t length)
+{
+    assert(handle != NULL);
+    assert((data != NULL) || (length == 0U));
+
+    iap_store_entry_t *entry;
+    const uint8_t *value;
+    uint32_t position;
+
+    if ((key > IAP_STORE_MAX_KEY) || (length > IAP_STORE_MAX_VALUE_SIZE))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    handle->stats.writes++;
+    handle->stats.valueBytes += length;
+
+    if (IAP_StoreFind(handle, key, &position))
+    {
+        entry = &handle->index[position];
+        value = &IAP_StoreBlockAddress(handle, entry->block)[entry->offset + IAP_STORE_RECORD_HEADER_SIZE];
+        if ((entry->length == length) && ((length == 0U) || (memcmp(value, data, length) == 0)))
+        {
+            handle->stats.skipped++;
+            return kStatus_Success;
+        }
+    }
+    else if (handle->indexCount == handle->indexSize)
+    {
+        return kStatus_IAP_StoreIndexFull;
+    }
+    else
+    {
+        /* New key. */
+    }
+
+    return IAP_StoreWriteRecord(handle, key, (const uint8_t *)data, length);
+}
+
+/*!
+ * brief Reads the value of a key.
+ *
+ * param handle Store handle.
+ * param key Key.
+ * param data Returns the value, up to size bytes.
+ * param size Size of the data buffer.
+ * param length Returns the value size, NULL if not needed.
+ * retval kStatus_Success The value is read, truncated to size bytes.
+ * retval kStatus_IAP_StoreNotFound The key has no value.
+ */
+status_t IAP_StoreRead(iap_store_handle_t *handle, uint16_t key, void *data, size_t size, size_t *length)
+{
+    assert(handle != NULL);
+    assert((data != NULL) || (size == 0U));
+
+    iap_store_entry_t *entry;
+    uint32_t position;
+
+    if ((!IAP_StoreFind(handle, key, &position)) || (handle->index[position].length == IAP_STORE_DELETED))
+    {
+        return kStatus_IAP_StoreNotFound;
+    }
+
+    entry = &handle->index[position];
+    (void)memcpy(data, &IAP_StoreBlockAddress(handle, entry->block)[entry->offset + IAP_STORE_RECORD_HEADER_SIZE],
+                 (size < entry->length) ? size : entry->length);
+    if (length != NULL)
+    {
+        *length = entry->length;
+    }
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Deletes the value of a key.
+ *
+ * param handle Store handle.
+ * param key Key.
+ * retval kStatus_Success The key has no value.
+ * return See IAP_StoreWrite.
+ */
+status_t IAP_StoreDelete(iap_store_handle_t *handle, uint16_t key)
+{
+    assert(handle != NULL);
+
+    uint32_t position;
+
+    if ((!IAP_StoreFind(handle, key, &position)) || (handle->index[position].length == IAP_STORE_DELETED))
+    {
+        return kStatus_Success;
+    }
+
+    return IAP_StoreWriteRecord(handle, key, NULL, IAP_STORE_DELETED);
+}
+
+/*!
+ * brief Collects one block when the free blocks run low.
+ *
+ * param handle Store handle.
+ * retval kStatus_Success A block was collected or there was nothing to do.
+ * return The IAP status of a failed program or erase.
+ */
+status_t IAP_StoreCollect(iap_store_handle_t *handle)
+{
+    assert(handle != NULL);
+
+    uint32_t victim;
+
+    if (handle->freeBlocks > (IAP_STORE_RESERVE_BLOCKS + 1U))
+    {
+        return kStatus_Success;
+    }
+
+    victim = IAP_StoreSelectVictim(handle, true);
+
+    return (victim == handle->blockCount) ? kStatus_Success : IAP_StoreCollectBlock(handle, victim);
+}
+
+/*!
+ * brief Gets the statistics of the store.
+ *
+ * param handle Store handle.
+ * param stats Returns the statistics.
+ */
+void IAP_StoreGetStats(iap_store_handle_t *handle, iap_store_stats_t *stats)
+{
+    assert(handle != NULL);
+    assert(stats != NULL);
+
+    *stats = handle->stats;
+}
@@ -0,0 +1,275 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef FSL_IAP_STORE_H_
+#define FSL_IAP_STORE_H_
+
+#include "fsl_iap.h"
+
+/*!
+ * @addtogroup iap_store_driver
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*! @{ */
+/*! @brief IAP store driver version. */
+#define FSL_IAP_STORE_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*! @} */
+
+/*!
+ * @brief Pages of an erase block.
+ *
+ * The store is a log of erase blocks, a block is erased with one IAP_ErasePage call. Must divide
+ * the pages of a sector.
+ */
+#ifndef IAP_STORE_BLOCK_PAGES
+#define IAP_STORE_BLOCK_PAGES (4U)
+#endif
+
+/*!
+ * @brief Alignment of the records in flash.
+ *
+ * Records smaller than a page share the page, the page is programmed again for every record, only
+ * the erased bytes of the new record change. Set it to FSL_FEATURE_SYSCON_FLASH_PAGE_SIZE_BYTES to
+ * program every page once.
+ */
+#ifndef IAP_STORE_RECORD_ALIGN
+#define IAP_STORE_RECORD_ALIGN (16U)
+#endif
+
+/*! @brief Free blocks kept for the garbage collection, a write never takes the last ones. */
+#ifndef IAP_STORE_RESERVE_BLOCKS
+#define IAP_STORE_RESERVE_BLOCKS (1U)
+#endif
+
+/*!
+ * @brief Spread of the erase counts that moves the block with the fewest erases.
+ *
+ * Blocks holding data that never changes are not collected for free space. When their erase count
+ * falls behind by this amount, the garbage collection moves their data so they take a share of the
+ * erases.
+ */
+#ifndef IAP_STORE_WEAR_LIMIT
+#define IAP_STORE_WEAR_LIMIT (8U)
+#endif
+
+/*! @brief Address of the flash in the memory map, the store reads the records there. */
+#ifndef IAP_STORE_FLASH_BASE
+#define IAP_STORE_FLASH_BASE (0U)
+#endif
+
+/*! @brief Size of an erase block in bytes. */
+#define IAP_STORE_BLOCK_SIZE (IAP_STORE_BLOCK_PAGES * (uint32_t)FSL_FEATURE_SYSCON_FLASH_PAGE_SIZE_BYTES)
+
+/*! @brief Flash bytes of the block header, the records start after it. */
+#define IAP_STORE_BLOCK_HEADER_SIZE \
+    (((12U + IAP_STORE_RECORD_ALIGN - 1U) / IAP_STORE_RECORD_ALIGN) * IAP_STORE_RECORD_ALIGN)
+
+/*! @brief Size of the record header in bytes. */
+#define IAP_STORE_RECORD_HEADER_SIZE (8U)
+
+/*! @brief Largest value of a record. */
+#define IAP_STORE_MAX_VALUE_SIZE (IAP_STORE_BLOCK_SIZE - IAP_STORE_BLOCK_HEADER_SIZE - IAP_STORE_RECORD_HEADER_SIZE)
+
+/*! @brief Largest key, 0xFFFF is the erased state of the flash. */
+#define IAP_STORE_MAX_KEY (0xFFFEU)
+
+/*! @brief IAP store status codes, after the ones of the IAP ROM. */
+enum
+{
+    kStatus_IAP_StoreNotFound  = MAKE_STATUS(kStatusGroup_IAP, 100U), /*!< No value for the key. */
+    kStatus_IAP_StoreFull      = MAKE_STATUS(kStatusGroup_IAP, 101U), /*!< Not enough space, even after collecting. */
+    kStatus_IAP_StoreIndexFull = MAKE_STATUS(kStatusGroup_IAP, 102U), /*!< More keys than index entries. */
+    kStatus_IAP_StoreVerifyError =
+        MAKE_STATUS(kStatusGroup_IAP, 103U), /*!< The programmed record does not read back. */
+};
+
+/*! @brief State of an erase block. */
+typedef enum _iap_store_block_state
+{
+    kIAP_StoreBlockFree   = 0U, /*!< Erased or to be erased before use. */
+    kIAP_StoreBlockActive = 1U, /*!< Records are appended to it. */
+    kIAP_StoreBlockClosed = 2U, /*!< Full or older than the active one, only collected. */
+} iap_store_block_state_t;
+
+/*! @brief RAM state of an erase block. */
+typedef struct _iap_store_block
+{
+    uint32_t sequence;   /*!< Position in the log, from the block header. */
+    uint32_t eraseCount; /*!< Erases of the block. */
+    uint16_t used;       /*!< Bytes written, the next record goes there. */
+    uint16_t live;       /*!< Bytes of the records the index points to. */
+    uint8_t state;       /*!< See iap_store_block_state_t. */
+    bool dirty;          /*!< A free block that is not blank. */
+} iap_store_block_t;
+
+/*! @brief Index entry, the latest record of a key. */
+typedef struct _iap_store_entry
+{
+    uint16_t key;    /*!< Key. */
+    uint16_t block;  /*!< Block of the record. */
+    uint16_t offset; /*!< Offset of the record in the block. */
+    uint16_t length; /*!< Value size, IAP_STORE_DELETED for a deleted key. */
+} iap_store_entry_t;
+
+/*! @brief Length of the index entry of a deleted key. */
+#define IAP_STORE_DELETED (0xFFFFU)
+
+/*! @brief Statistics of the store. */
+typedef struct _iap_store_stats
+{
+    uint32_t writes;         /*!< Values written, unchanged ones included. */
+    uint32_t skipped;        /*!< Writes of the stored value that did not program the flash. */
+    uint32_t valueBytes;     /*!< Bytes of the values written. */
+    uint32_t programs;       /*!< IAP_CopyRamToFlash calls. */
+    uint32_t programBytes;   /*!< Bytes programmed. */
+    uint32_t erases;         /*!< Blocks erased. */
+    uint32_t collections;    /*!< Blocks collected. */
+    uint32_t movedBytes;     /*!< Record bytes copied by the garbage collection. */
+    uint32_t tornRecords;    /*!< Records with a bad CRC found by IAP_StoreInit. */
+    uint32_t scannedRecords; /*!< Records read by IAP_StoreInit. */
+} iap_store_stats_t;
+
+/*! @brief Store configuration. */
+typedef struct _iap_store_config
+{
+    uint32_t startPage;        /*!< First flash page of the store, aligned to IAP_STORE_BLOCK_PAGES. */
+    uint32_t pageCount;        /*!< Flash pages of the store, a multiple of IAP_STORE_BLOCK_PAGES. */
+    iap_store_block_t *blocks; /*!< State of the erase blocks, pageCount / IAP_STORE_BLOCK_PAGES entries. */
+    iap_store_entry_t *index;  /*!< Index memory. */
+    uint32_t indexSize;        /*!< Index entries, the number of keys the store holds. */
+    uint32_t systemCoreClock;  /*!< SystemCoreClock in Hz for the IAP calls. */
+} iap_store_config_t;
+
+/*! @brief Store handle. */
+typedef struct _iap_store_handle
+{
+    uint32_t startPage;                                       /*!< First flash page of the store. */
+    uint32_t blockCount;                                      /*!< Erase blocks of the store. */
+    iap_store_block_t *blocks;                                /*!< State of the erase blocks. */
+    iap_store_entry_t *index;                                 /*!< Index, sorted by key. */
+    uint32_t indexSize;                                       /*!< Index entries. */
+    uint32_t indexCount;                                      /*!< Index entries used. */
+    uint32_t active;                                          /*!< Active block, blockCount if none. */
+    uint32_t freeBlocks;                                      /*!< Blocks in the free state. */
+    uint32_t nextSequence;                                    /*!< Sequence of the next block opened. */
+    uint32_t systemCoreClock;                                 /*!< SystemCoreClock in Hz. */
+    iap_store_stats_t stats;                                  /*!< Statistics. */
+    uint32_t buffer[IAP_STORE_BLOCK_SIZE / sizeof(uint32_t)]; /*!< Page image for IAP_CopyRamToFlash. */
+} iap_store_handle_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name Wear-leveled store
+ * @{
+ */
+
+/*!
+ * @brief Opens the store and builds the index from the records in flash.
+ *
+ * Every write appends a record with a CRC to the active block, the latest record of a key holds
+ * its value. The scan takes the records of the blocks in the order they were opened. A record
+ * torn by a reset fails its CRC, it is skipped together with the rest of its block, the value
+ * before the write stays. Erased flash is an empty store.
+ *
+ * @param handle Store handle.
+ * @param config Store configuration.
+ * @retval kStatus_Success The store is open.
+ * @retval kStatus_InvalidArgument The configuration is invalid.
+ * @retval kStatus_IAP_StoreIndexFull The flash holds more keys than the index, the store is not usable.
+ */
+status_t IAP_StoreInit(iap_store_handle_t *handle, const iap_store_config_t *config);
+
+/*!
+ * @brief Erases the store, all values are lost.
+ *
+ * @param handle Store handle.
+ * @retval kStatus_Success The store is empty.
+ * @return The IAP status of a failed erase.
+ */
+status_t IAP_StoreFormat(iap_store_handle_t *handle);
+
+/*!
+ * @brief Writes the value of a key.
+ *
+ * The write programs the record pages, the flash is erased only when the garbage collection
+ * reclaims a block. Writing the value the key already has does not program the flash.
+ *
+ * @param handle Store handle.
+ * @param key Key, 0 to IAP_STORE_MAX_KEY.
+ * @param data Value.
+ * @param length Value size, up to IAP_STORE_MAX_VALUE_SIZE.
+ * @retval kStatus_Success The value is committed, it survives a reset.
+ * @retval kStatus_InvalidArgument Invalid key or size.
+ * @retval kStatus_IAP_StoreIndexFull The key is new and the index is full.
+ * @retval kStatus_IAP_StoreFull Not enough space in the store.
+ * @retval kStatus_IAP_StoreVerifyError The record did not program correctly.
+ * @return The IAP status of a failed program or erase.
+ */
+status_t IAP_StoreWrite(iap_store_handle_t *handle, uint16_t key, const void *data, size_t length);
+
+/*!
+ * @brief Reads the value of a key.
+ *
+ * @param handle Store handle.
+ * @param key Key.
+ * @param data Returns the value, up to size bytes.
+ * @param size Size of the data buffer.
+ * @param length Returns the value size, NULL if not needed.
+ * @retval kStatus_Success The value is read, truncated to size bytes.
+ * @retval kStatus_IAP_StoreNotFound The key has no value.
+ */
+status_t IAP_StoreRead(iap_store_handle_t *handle, uint16_t key, void *data, size_t size, size_t *length);
+
+/*!
+ * @brief Deletes the value of a key.
+ *
+ * @param handle Store handle.
+ * @param key Key.
+ * @retval kStatus_Success The key has no value.
+ * @return See IAP_StoreWrite.
+ */
+status_t IAP_StoreDelete(iap_store_handle_t *handle, uint16_t key);
+
+/*!
+ * @brief Collects one block when the free blocks run low.
+ *
+ * Call it when the application is idle, a write that finds no free block collects by itself and
+ * stalls for the copies and the erase. Collects when no more than IAP_STORE_RESERVE_BLOCKS + 1
+ * blocks are free.
+ *
+ * @param handle Store handle.
+ * @retval kStatus_Success A block was collected or there was nothing to do.
+ * @return The IAP status of a failed program or erase.
+ */
+status_t IAP_StoreCollect(iap_store_handle_t *handle);
+
+/*!
+ * @brief Gets the statistics of the store.
+ *
+ * @param handle Store handle.
+ * @param stats Returns the statistics.
+ */
+void IAP_StoreGetStats(iap_store_handle_t *handle, iap_store_stats_t *stats);
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* FSL_IAP_STORE_H_ */
@@ -0,0 +1,432 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "fsl_pint_capture.h"
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.pint_capture"
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Pin interrupt of the product term counting up in pattern match mode. */
+#define PINT_CAPTURE_PATTERN_FORWARD (kPINT_PinInt1)
+
+/*! @brief Pin interrupt of the product term counting down in pattern match mode. */
+#define PINT_CAPTURE_PATTERN_REVERSE (kPINT_PinInt3)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void PINT_CaptureCountEdge(pint_capture_handle_t *handle, pint_capture_channel_t *channel, uint32_t timestamp);
+static void PINT_CaptureDecodeQuadrature(pint_capture_handle_t *handle,
+                                         pint_capture_channel_t *channel,
+                                         uint8_t edges);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!
+ * brief Gets the default configuration, the SCTimer counter as one 32-bit up counter.
+ *
+ * param config Pointer to the configuration structure.
+ */
+void PINT_CaptureGetDefaultConfig(pint_capture_config_t *config)
+{
+    assert(config != NULL);
+
+    (void)memset(config, 0, sizeof(*config));
+    config->counter     = &SCT0->COUNT;
+    config->counterMask = 0xFFFFFFFFU;
+    config->counterDown = false;
+}
+
+/*!
+ * brief Initializes the capture handle.
+ *
+ * param base PINT peripheral base address.
+ * param handle Capture handle.
+ * param config Capture configuration.
+ * param ring Event ring.
+ * param ringSize Number of events in the ring, power of 2.
+ * retval kStatus_Success The handle is initialized.
+ * retval kStatus_InvalidArgument ringSize is not a power of 2.
+ */
+status_t PINT_CaptureCreateHandle(PINT_Type *base,
+                                  pint_capture_handle_t *handle,
+                                  const pint_capture_config_t *config,
+                                  pint_capture_event_t *ring,
+                                  uint32_t ringSize)
+{
+    uint32_t i;
+
+    assert((base != NULL) && (handle != NULL) && (config != NULL) && (ring != NULL));
+
+    if ((ringSize == 0U) || ((ringSize & (ringSize - 1U)) != 0U))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    (void)memset(handle, 0, sizeof(*handle));
+    handle->counter     = config->counter;
+    handle->counterMask = config->counterMask;
+    handle->counterDown = config->counterDown;
+    handle->ring        = ring;
+    handle->ringMask    = ringSize - 1U;
+    for (i = 0U; i < PINT_CAPTURE_CHANNELS; i++)
+    {
+        handle->channel[i].level = PINT_CAPTURE_LEVEL_UNKNOWN;
+    }
+
+    /* The pattern match engine is off until PINT_CaptureConfigQuadraturePattern. */
+    PINT_PatternMatchDisable(base);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Captures the rising edges of a pin interrupt and measures their period.
+ *
+ * param base PINT peripheral base address.
+ * param handle Capture handle.
+ * param pintr Pin interrupt.
+ * retval kStatus_Success The channel is captured.
+ * retval kStatus_Fail The pattern match engine drives the interrupts.
+ */
+status_t PINT_CaptureConfigPeriod(PINT_Type *base, pint_capture_handle_t *handle, pint_pin_int_t pintr)
+{
+    pint_capture_channel_t *channel = &handle->channel[pintr];
+
+    if (handle->patternMatch)
+    {
+        return kStatus_Fail;
+    }
+
+    (void)memset(channel, 0, sizeof(*channel));
+    channel->mode  = (uint8_t)kPINT_CaptureModePeriod;
+    channel->level = PINT_CAPTURE_LEVEL_UNKNOWN;
+    handle->bothEdges &= (uint8_t)~(1U << (uint32_t)pintr);
+
+    /* No callback, the application vector calls PINT_CaptureHandleIRQ. */
+    PINT_PinInterruptConfig(base, pintr, kPINT_PinIntEnableRiseEdge, NULL);
+    PINT_EnableCallbackByIndex(base, pintr);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Captures both edges of two pin interrupts and decodes them as quadrature encoder.
+ *
+ * param base PINT peripheral base address.
+ * param handle Capture handle.
+ * param pintrA Pin interrupt of phase A.
+ * param pintrB Pin interrupt of phase B.
+ * param levels Current levels of the phases, bit 0 phase A and bit 1 phase B.
+ * retval kStatus_Success The channels are captured.
+ * retval kStatus_Fail The pattern match engine drives the interrupts.
+ */
+status_t PINT_CaptureConfigQuadrature(
+    PINT_Type *base, pint_capture_handle_t *handle, pint_pin_int_t pintrA, pint_pin_int_t pintrB, uint32_t levels)
+{
+    pint_capture_channel_t *channelA = &handle->channel[pintrA];
+    pint_capture_channel_t *channelB = &handle->channel[pintrB];
+
+    assert(pintrA != pintrB);
+
+    if (handle->patternMatch)
+    {
+        return kStatus_Fail;
+    }
+
+    (void)memset(channelA, 0, sizeof(*channelA));
+    (void)memset(channelB, 0, sizeof(*channelB));
+    channelA->mode    = (uint8_t)kPINT_CaptureModeQuadratureA;
+    channelA->partner = (uint8_t)pintrB;
+    channelA->level   = (uint8_t)(levels & 1U);
+    channelB->mode    = (uint8_t)kPINT_CaptureModeQuadratureB;
+    channelB->partner = (uint8_t)pintrA;
+    channelB->level   = (uint8_t)((levels >> 1U) & 1U);
+    handle->bothEdges |= (uint8_t)((1U << (uint32_t)pintrA) | (1U << (uint32_t)pintrB));
+    handle->position = 0;
+
+    PINT_PinInterruptConfig(base, pintrA, kPINT_PinIntEnableBothEdges, NULL);
+    PINT_PinInterruptConfig(base, pintrB, kPINT_PinIntEnableBothEdges, NULL);
+    PINT_EnableCallbackByIndex(base, pintrA);
+    PINT_EnableCallbackByIndex(base, pintrB);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Decodes a quadrature encoder with the pattern match engine, 1 count per cycle.
+ *
+ * param base PINT peripheral base address.
+ * param handle Capture handle.
+ * param srcA Input of phase A.
+ * param srcB Input of phase B.
+ */
+void PINT_CaptureConfigQuadraturePattern(PINT_Type *base,
+                                         pint_capture_handle_t *handle,
+                                         pint_pmatch_input_src_t srcA,
+                                         pint_pmatch_input_src_t srcB)
+{
+    pint_pmatch_cfg_t cfg;
+    uint32_t i;
+
+    /* Phase A rises while phase B is low: forward. */
+    cfg.bs_src    = srcA;
+    cfg.bs_cfg    = kPINT_PatternMatchStickyRise;
+    cfg.end_point = false;
+    cfg.callback  = NULL;
+    PINT_PatternMatchConfig(base, kPINT_PatternMatchBSlice0, &cfg);
+    cfg.bs_src    = srcB;
+    cfg.bs_cfg    = kPINT_PatternMatchLow;
+    cfg.end_point = true;
+    PINT_PatternMatchConfig(base, kPINT_PatternMatchBSlice1, &cfg);
+
+    /* Phase A rises while phase B is high: reverse. */
+    cfg.bs_src    = srcA;
+    cfg.bs_cfg    = kPINT_PatternMatchStickyRise;
+    cfg.end_point = false;
+    PINT_PatternMatchConfig(base, kPINT_PatternMatchBSlice2, &cfg);
+    cfg.bs_src    = srcB;
+    cfg.bs_cfg    = kPINT_PatternMatchHigh;
+    cfg.end_point = true;
+    PINT_PatternMatchConfig(base, kPINT_PatternMatchBSlice3, &cfg);
+
+    for (i = 0U; i < PINT_CAPTURE_CHANNELS; i++)
+    {
+        (void)memset(&handle->channel[i], 0, sizeof(handle->channel[i]));
+        handle->channel[i].level = PINT_CAPTURE_LEVEL_UNKNOWN;
+    }
+    handle->channel[PINT_CAPTURE_PATTERN_FORWARD].mode = (uint8_t)kPINT_CaptureModePatternForward;
+    handle->channel[PINT_CAPTURE_PATTERN_REVERSE].mode = (uint8_t)kPINT_CaptureModePatternReverse;
+    handle->bothEdges                                  = 0U;
+    handle->patternMatch                               = true;
+    handle->position                                   = 0;
+
+    (void)PINT_PatternMatchResetDetectLogic(base);
+    PINT_PatternMatchEnable(base);
+    PINT_EnableCallbackByIndex(base, PINT_CAPTURE_PATTERN_FORWARD);
+    PINT_EnableCallbackByIndex(base, PINT_CAPTURE_PATTERN_REVERSE);
+}
+
+/*!
+ * brief Stops the capture of a channel and disables its interrupt.
+ *
+ * param base PINT peripheral base address.
+ * param handle Capture handle.
+ * param pintr Pin interrupt.
+ */
+void PINT_CaptureDisableChannel(PINT_Type *base, pint_capture_handle_t *handle, pint_pin_int_t pintr)
+{
+    PINT_DisableCallbackByIndex(base, pintr);
+    if (!handle->patternMatch)
+    {
+        PINT_PinInterruptConfig(base, pintr, kPINT_PinIntEnableNone, NULL);
+    }
+    handle->bothEdges &= (uint8_t)~(1U << (uint32_t)pintr);
+    handle->channel[pintr].mode = (uint8_t)kPINT_CaptureModeDisabled;
+}
+
+/*!
+ * brief Copies events out of the ring without processing them.
+ *
+ * param handle Capture handle.
+ * param events Destination of the events.
+ * param count Maximum number of events.
+ * return Number of events copied.
+ */
+uint32_t PINT_CaptureRead(pint_capture_handle_t *handle, pint_capture_event_t *events, uint32_t count)
+{
+    uint32_t tail      = handle->tail;
+    uint32_t available = handle->head - tail;
+    uint32_t i;
+
+    if (count > available)
+    {
+        count = available;
+    }
+    for (i = 0U; i < count; i++)
+    {
+        events[i] = handle->ring[(tail + i) & handle->ringMask];
+    }
+    /* The slots are copied before the interrupt handler may reuse them. */
+    __COMPILER_BARRIER();
+    handle->tail = tail + count;
+
+    return count;
+}
+
+/* Counts an edge of a channel and measures the period to the previous one. */
+static void PINT_CaptureCountEdge(pint_capture_handle_t *handle, pint_capture_channel_t *channel, uint32_t timestamp)
+{
+    uint32_t period;
+
+    if (channel->hasTimestamp)
+    {
+        period          = (timestamp - channel->lastTimestamp) & handle->counterMask;
+        channel->period = period;
+        channel->periodSum += period;
+        channel->periodCount++;
+    }
+    channel->lastTimestamp = timestamp;
+    channel->hasTimestamp  = true;
+    channel->edgeCount++;
+}
+
+/* Decodes one edge of a quadrature phase, 4 counts per cycle. */
+static void PINT_CaptureDecodeQuadrature(pint_capture_handle_t *handle,
+                                         pint_capture_channel_t *channel,
+                                         uint8_t edges)
+{
+    uint8_t partnerLevel = handle->channel[channel->partner].level;
+    uint8_t level;
+    bool forward;
+
+    if (edges == ((uint8_t)kPINT_CaptureEdgeRise | (uint8_t)kPINT_CaptureEdgeFall))
+    {
+        /* Both edges before the interrupt was served, the level is lost until the next edge. */
+        handle->stats.mergedEdges++;
+        channel->level = PINT_CAPTURE_LEVEL_UNKNOWN;
+        return;
+    }
+
+    level = ((edges & (uint8_t)kPINT_CaptureEdgeRise) != 0U) ? 1U : 0U;
+    if (channel->level == level)
+    {
+        /* The opposite edge was missed. */
+        handle->stats.quadratureErrors++;
+    }
+    else if ((channel->level != PINT_CAPTURE_LEVEL_UNKNOWN) && (partnerLevel != PINT_CAPTURE_LEVEL_UNKNOWN))
+    {
+        /* Phase A leads: A changes to the opposite level of B, B changes to the level of A. */
+        if (channel->mode == (uint8_t)kPINT_CaptureModeQuadratureA)
+        {
+            forward = (level != partnerLevel);
+        }
+        else
+        {
+            forward = (level == partnerLevel);
+        }
+        handle->position += forward ? 1 : -1;
+    }
+    else
+    {
+        /* The levels are known again from now on. */
+    }
+    channel->level = level;
+}
+
+/*!
+ * brief Processes all events in the ring into the channel measurements.
+ *
+ * param handle Capture handle.
+ * return Number of events processed.
+ */
+uint32_t PINT_CaptureProcess(pint_capture_handle_t *handle)
+{
+    uint32_t tail  = handle->tail;
+    uint32_t count = handle->head - tail;
+    const pint_capture_event_t *event;
+    pint_capture_channel_t *channel;
+    uint32_t timestamp;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0U; i < count; i++)
+    {
+        event     = &handle->ring[(tail + i) & handle->ringMask];
+        channel   = &handle->channel[event->channel];
+        timestamp = handle->counterDown ? ~event->timestamp : event->timestamp;
+        timestamp &= handle->counterMask;
+
+        if ((event->edges & (uint8_t)kPINT_CaptureEdgeGap) != 0U)
+        {
+            /* Periods and levels across the dropped events are not known. */
+            for (j = 0U; j < PINT_CAPTURE_CHANNELS; j++)
+            {
+                handle->channel[j].hasTimestamp = false;
+                if (handle->channel[j].mode >= (uint8_t)kPINT_CaptureModeQuadratureA)
+                {
+                    handle->channel[j].level = PINT_CAPTURE_LEVEL_UNKNOWN;
+                }
+            }
+        }
+
+        switch (channel->mode)
+        {
+            case (uint8_t)kPINT_CaptureModePeriod:
+                PINT_CaptureCountEdge(handle, channel, timestamp);
+                break;
+            case (uint8_t)kPINT_CaptureModeQuadratureA:
+                if (event->edges == (uint8_t)kPINT_CaptureEdgeRise)
+                {
+                    PINT_CaptureCountEdge(handle, channel, timestamp);
+                }
+                PINT_CaptureDecodeQuadrature(handle, channel, event->edges & ~(uint8_t)kPINT_CaptureEdgeGap);
+                break;
+            case (uint8_t)kPINT_CaptureModeQuadratureB:
+                PINT_CaptureDecodeQuadrature(handle, channel, event->edges & ~(uint8_t)kPINT_CaptureEdgeGap);
+                break;
+            case (uint8_t)kPINT_CaptureModePatternForward:
+                PINT_CaptureCountEdge(handle, channel, timestamp);
+                handle->position++;
+                break;
+            case (uint8_t)kPINT_CaptureModePatternReverse:
+                PINT_CaptureCountEdge(handle, channel, timestamp);
+                handle->position--;
+                break;
+            default:
+                /* Event of a disabled channel. */
+                break;
+        }
+    }
+
+    __COMPILER_BARRIER();
+    handle->tail = tail + count;
+    handle->stats.events += count;
+
+    return count;
+}
+
+/*!
+ * brief Gets the average frequency of a channel since the last call.
+ *
+ * param handle Capture handle.
+ * param pintr Pin interrupt.
+ * param counterHz Clock of the timestamp counter.
+ * return Frequency in mHz, 0 if no period was completed.
+ */
+uint32_t PINT_CaptureGetFrequency(pint_capture_handle_t *handle, pint_pin_int_t pintr, uint32_t counterHz)
+{
+    pint_capture_channel_t *channel = &handle->channel[pintr];
+    uint32_t frequency              = 0U;
+
+    if (channel->periodSum != 0U)
+    {
+        frequency = (uint32_t)(((uint64_t)channel->periodCount * counterHz * 1000U) / channel->periodSum);
+    }
+    channel->periodSum   = 0U;
+    channel->periodCount = 0U;
+
+    return frequency;
+}
+
+/*!
+ * brief Gets the capture statistics.
+ *
+ * param handle Capture handle.
+ * param stats Returns the statistics.
+ */
+void PINT_CaptureGetStats(pint_capture_handle_t *handle, pint_capture_stats_t *stats)
+{
+    *stats           = handle->stats;
+    stats->overflows = handle->overflows;
+}
@@ -0,0 +1,363 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FSL_PINT_CAPTURE_H_
+#define FSL_PINT_CAPTURE_H_
+
+#include "fsl_pint.h"
+
+/*!
+ * @addtogroup pint_capture
+ * @{
+ */
+
+/*! @file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*! @{ */
+#define FSL_PINT_CAPTURE_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*! @} */
+
+/*! @brief Number of capture channels, one per pin interrupt or pattern match bit slice. */
+#define PINT_CAPTURE_CHANNELS (FSL_FEATURE_PINT_NUMBER_OF_CONNECTED_OUTPUTS)
+
+/*! @brief Level of a quadrature phase that is not known yet. */
+#define PINT_CAPTURE_LEVEL_UNKNOWN (0xFFU)
+
+/*! @brief Edge flags of a capture event. */
+enum _pint_capture_edge
+{
+    kPINT_CaptureEdgeRise    = 1U << 0U, /*!< Rising edge. */
+    kPINT_CaptureEdgeFall    = 1U << 1U, /*!< Falling edge, with kPINT_CaptureEdgeRise both edges were seen
+                                              before the interrupt was served, the level is not known. */
+    kPINT_CaptureEdgePattern = 1U << 2U, /*!< Product term of the pattern match engine matched. */
+    kPINT_CaptureEdgeGap     = 1U << 7U, /*!< Events were dropped before this one, the ring was full. */
+};
+
+/*! @brief Measurement done on the events of a channel. */
+typedef enum _pint_capture_mode
+{
+    kPINT_CaptureModeDisabled       = 0U, /*!< Channel not captured. */
+    kPINT_CaptureModePeriod         = 1U, /*!< Rising edges, period and frequency, e.g. a tachometer. */
+    kPINT_CaptureModeQuadratureA    = 2U, /*!< Both edges of phase A of a quadrature encoder. */
+    kPINT_CaptureModeQuadratureB    = 3U, /*!< Both edges of phase B of a quadrature encoder. */
+    kPINT_CaptureModePatternForward = 4U, /*!< Product term counting the position up. */
+    kPINT_CaptureModePatternReverse = 5U, /*!< Product term counting the position down. */
+} pint_capture_mode_t;
+
+/*! @brief One captured edge, 8 bytes. */
+typedef struct _pint_capture_event
+{
+    uint32_t timestamp; /*!< Raw value of the counter when the interrupt was served. */
+    uint8_t channel;    /*!< Pin interrupt or bit slice, see pint_pin_int_t. */
+    uint8_t edges;      /*!< Edge flags, see _pint_capture_edge. */
+    uint16_t reserved;  /*!< Reserved. */
+} pint_capture_event_t;
+
+/*! @brief Capture configuration. */
+typedef struct _pint_capture_config
+{
+    const volatile uint32_t *counter; /*!< Free running counter read as the timestamp, e.g. &SCT0->COUNT with the
+                                           SCTimer running as one 32-bit counter, or &MRT0->CHANNEL[n].TIMER. */
+    uint32_t counterMask;             /*!< Counter bits, the timestamps wrap at counterMask + 1. */
+    bool counterDown;                 /*!< The counter counts down, like the MRT. */
+} pint_capture_config_t;
+
+/*! @brief Measurement state of a channel, updated by PINT_CaptureProcess. */
+typedef struct _pint_capture_channel
+{
+    uint8_t mode;           /*!< Measurement, see pint_capture_mode_t. */
+    uint8_t partner;        /*!< Other phase of a quadrature channel. */
+    uint8_t level;          /*!< Level of a quadrature phase, PINT_CAPTURE_LEVEL_UNKNOWN if not known. */
+    bool hasTimestamp;      /*!< lastTimestamp is valid. */
+    uint32_t lastTimestamp; /*!< Timestamp of the last counted edge. */
+    uint32_t period;        /*!< Last period in counter ticks, 0 before two edges. */
+    uint32_t periodSum;     /*!< Sum of the periods since the last PINT_CaptureGetFrequency. */
+    uint32_t periodCount;   /*!< Number of periods in periodSum. */
+    uint32_t edgeCount;     /*!< Edges counted. */
+} pint_capture_channel_t;
+
+/*! @brief Capture statistics. */
+typedef struct _pint_capture_stats
+{
+    uint32_t events;           /*!< Events processed. */
+    uint32_t overflows;        /*!< Events dropped because the ring was full. */
+    uint32_t mergedEdges;      /*!< Events with both edges, at least one edge was served late. */
+    uint32_t quadratureErrors; /*!< Quadrature transitions that skipped a state. */
+} pint_capture_stats_t;
+
+/*!
+ * @brief Capture handle.
+ *
+ * The interrupt handler writes head and the ring, the application reads the ring and writes tail. No
+ * critical section is needed as long as the events are read by one context only.
+ */
+typedef struct _pint_capture_handle
+{
+    const volatile uint32_t *counter;   /*!< Timestamp counter. */
+    pint_capture_event_t *ring;         /*!< Event ring. */
+    uint32_t ringMask;                  /*!< Ring size minus 1, the size is a power of 2. */
+    volatile uint32_t head;             /*!< Events written, wraps at 2^32. */
+    volatile uint32_t tail;             /*!< Events read, wraps at 2^32. */
+    volatile uint32_t overflows;        /*!< Events dropped by the interrupt handler. */
+    uint8_t gap;                        /*!< kPINT_CaptureEdgeGap if events were dropped since the last write. */
+    uint8_t bothEdges;                  /*!< Channels with both edges enabled, bit n is channel n. */
+    bool patternMatch;                  /*!< Interrupts come from the pattern match engine. */
+    bool counterDown;                   /*!< The counter counts down. */
+    uint32_t counterMask;               /*!< Counter bits. */
+    int32_t position;                   /*!< Position of the quadrature decoder. */
+    pint_capture_stats_t stats;         /*!< Statistics. */
+    pint_capture_channel_t channel[PINT_CAPTURE_CHANNELS]; /*!< Channel state. */
+} pint_capture_handle_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name Initialization
+ * @{
+ */
+
+/*!
+ * @brief Gets the default configuration, the SCTimer counter as one 32-bit up counter.
+ *
+ * @param config Pointer to the configuration structure.
+ */
+void PINT_CaptureGetDefaultConfig(pint_capture_config_t *config);
+
+/*!
+ * @brief Initializes the capture handle.
+ *
+ * PINT_Init must have been called, the counter must be running.
+ *
+ * @param base PINT peripheral base address.
+ * @param handle Capture handle.
+ * @param config Capture configuration.
+ * @param ring Event ring.
+ * @param ringSize Number of events in the ring, power of 2.
+ * @retval kStatus_Success The handle is initialized.
+ * @retval kStatus_InvalidArgument ringSize is not a power of 2.
+ */
+status_t PINT_CaptureCreateHandle(PINT_Type *base,
+                                  pint_capture_handle_t *handle,
+                                  const pint_capture_config_t *config,
+                                  pint_capture_event_t *ring,
+                                  uint32_t ringSize);
+
+/*!
+ * @brief Captures the rising edges of a pin interrupt and measures their period.
+ *
+ * Enables the pin interrupt in the NVIC, the application routes it to PINT_CaptureHandleIRQ.
+ *
+ * @param base PINT peripheral base address.
+ * @param handle Capture handle.
+ * @param pintr Pin interrupt.
+ * @retval kStatus_Success The channel is captured.
+ * @retval kStatus_Fail The pattern match engine drives the interrupts.
+ */
+status_t PINT_CaptureConfigPeriod(PINT_Type *base, pint_capture_handle_t *handle, pint_pin_int_t pintr);
+
+/*!
+ * @brief Captures both edges of two pin interrupts and decodes them as quadrature encoder, 4 counts per cycle.
+ *
+ * The position counts up when phase A leads. Phase A also measures the period of its rising edges.
+ *
+ * @param base PINT peripheral base address.
+ * @param handle Capture handle.
+ * @param pintrA Pin interrupt of phase A.
+ * @param pintrB Pin interrupt of phase B.
+ * @param levels Current levels of the phases, bit 0 phase A and bit 1 phase B, e.g. read from the GPIO.
+ * @retval kStatus_Success The channels are captured.
+ * @retval kStatus_Fail The pattern match engine drives the interrupts.
+ */
+status_t PINT_CaptureConfigQuadrature(
+    PINT_Type *base, pint_capture_handle_t *handle, pint_pin_int_t pintrA, pint_pin_int_t pintrB, uint32_t levels);
+
+/*!
+ * @brief Decodes a quadrature encoder with the pattern match engine, 1 count per cycle.
+ *
+ * Bit slices 0 and 1 match the rising edge of phase A while phase B is low and interrupt on pin
+ * interrupt 1, bit slices 2 and 3 match it while phase B is high and interrupt on pin interrupt 3.
+ * The interrupt handler only timestamps the match, the direction comes from the hardware. All pin
+ * interrupts are driven by the pattern match engine from now on.
+ *
+ * @param base PINT peripheral base address.
+ * @param handle Capture handle.
+ * @param srcA Input of phase A.
+ * @param srcB Input of phase B.
+ */
+void PINT_CaptureConfigQuadraturePattern(PINT_Type *base,
+                                         pint_capture_handle_t *handle,
+                                         pint_pmatch_input_src_t srcA,
+                                         pint_pmatch_input_src_t srcB);
+
+/*!
+ * @brief Stops the capture of a channel and disables its interrupt.
+ *
+ * @param base PINT peripheral base address.
+ * @param handle Capture handle.
+ * @param pintr Pin interrupt.
+ */
+void PINT_CaptureDisableChannel(PINT_Type *base, pint_capture_handle_t *handle, pint_pin_int_t pintr);
+
+/*! @} */
+
+/*!
+ * @name Interrupt
+ * @{
+ */
+
+/*!
+ * @brief Timestamps one pin interrupt into the event ring.
+ *
+ * Call it from PIN_INTn_IRQHandler of each captured channel in place of the PINT driver handler, it is
+ * inline so that the vector holds the whole capture. Reads the counter first, then the edge flags of
+ * channels with both edges enabled, then clears the interrupt.
+ *
+ * @param base PINT peripheral base address.
+ * @param handle Capture handle.
+ * @param pintr Pin interrupt of the vector.
+ */
+static inline void PINT_CaptureHandleIRQ(PINT_Type *base, pint_capture_handle_t *handle, pint_pin_int_t pintr)
+{
+    uint32_t timestamp = *handle->counter;
+    uint32_t mask      = 1UL << (uint32_t)pintr;
+    uint32_t head      = handle->head;
+    pint_capture_event_t *event;
+    uint8_t edges;
+
+    if (handle->patternMatch)
+    {
+        /* Clears the sticky edges of the bit slices. */
+        base->PMSRC = base->PMSRC;
+        edges       = (uint8_t)kPINT_CaptureEdgePattern;
+    }
+    else
+    {
+        if ((handle->bothEdges & mask) != 0U)
+        {
+            edges = (((base->RISE & mask) != 0U) ? (uint8_t)kPINT_CaptureEdgeRise : 0U) |
+                    (((base->FALL & mask) != 0U) ? (uint8_t)kPINT_CaptureEdgeFall : 0U);
+        }
+        else
+        {
+            edges = (uint8_t)kPINT_CaptureEdgeRise;
+        }
+        /* Clears IST, RISE and FALL of the pin. */
+        base->IST = mask;
+    }
+
+    if ((head - handle->tail) <= handle->ringMask)
+    {
+        event            = &handle->ring[head & handle->ringMask];
+        event->timestamp = timestamp;
+        event->channel   = (uint8_t)pintr;
+        event->edges     = edges | handle->gap;
+        handle->gap      = 0U;
+        /* The event is complete before the application sees it. */
+        __COMPILER_BARRIER();
+        handle->head = head + 1U;
+    }
+    else
+    {
+        handle->overflows++;
+        handle->gap = (uint8_t)kPINT_CaptureEdgeGap;
+    }
+}
+
+/*! @} */
+
+/*!
+ * @name Events and measurements
+ * @{
+ */
+
+/*!
+ * @brief Gets the number of events in the ring.
+ *
+ * @param handle Capture handle.
+ * @return Number of events.
+ */
+static inline uint32_t PINT_CaptureGetCount(pint_capture_handle_t *handle)
+{
+    return handle->head - handle->tail;
+}
+
+/*!
+ * @brief Copies events out of the ring without processing them.
+ *
+ * @param handle Capture handle.
+ * @param events Destination of the events.
+ * @param count Maximum number of events.
+ * @return Number of events copied.
+ */
+uint32_t PINT_CaptureRead(pint_capture_handle_t *handle, pint_capture_event_t *events, uint32_t count);
+
+/*!
+ * @brief Processes all events in the ring into the channel measurements.
+ *
+ * @param handle Capture handle.
+ * @return Number of events processed.
+ */
+uint32_t PINT_CaptureProcess(pint_capture_handle_t *handle);
+
+/*!
+ * @brief Gets the last period of a channel.
+ *
+ * @param handle Capture handle.
+ * @param pintr Pin interrupt.
+ * @return Period in counter ticks, 0 before two edges.
+ */
+static inline uint32_t PINT_CaptureGetPeriod(pint_capture_handle_t *handle, pint_pin_int_t pintr)
+{
+    return handle->channel[pintr].period;
+}
+
+/*!
+ * @brief Gets the average frequency of a channel since the last call.
+ *
+ * @param handle Capture handle.
+ * @param pintr Pin interrupt.
+ * @param counterHz Clock of the timestamp counter.
+ * @return Frequency in mHz, 0 if no period was completed.
+ */
+uint32_t PINT_CaptureGetFrequency(pint_capture_handle_t *handle, pint_pin_int_t pintr, uint32_t counterHz);
+
+/*!
+ * @brief Gets the position of the quadrature decoder.
+ *
+ * @param handle Capture handle.
+ * @return Position in counts.
+ */
+static inline int32_t PINT_CaptureGetPosition(pint_capture_handle_t *handle)
+{
+    return handle->position;
+}
+
+/*!
+ * @brief Gets the capture statistics.
+ *
+ * @param handle Capture handle.
+ * @param stats Returns the statistics.
+ */
+void PINT_CaptureGetStats(pint_capture_handle_t *handle, pint_capture_stats_t *stats);
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* FSL_PINT_CAPTURE_H_ */
@@ -0,0 +1,287 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FSL_SCTIMER_PWM_WAVE_H_
+#define FSL_SCTIMER_PWM_WAVE_H_
+
+#include "fsl_sctimer.h"
+#include "fsl_dma.h"
+
+/*!
+ * @addtogroup sctimer_pwm_wave
+ * @{
+ */
+
+/*! @file */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*! @{ */
+/*! @brief SCTimer PWM waveform driver version. */
+#define FSL_SCTIMER_PWM_WAVE_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*! @} */
+
+/*! @brief Maximum number of PWM outputs driven by one waveform. */
+#define SCTIMER_PWM_WAVE_MAX_OUTPUTS (6U)
+
+/*! @brief Duty cycle of 100 %, duty cycles are Q15 fractions from 0 to SCTIMER_PWM_WAVE_DUTY_FULL. */
+#define SCTIMER_PWM_WAVE_DUTY_FULL (0x8000U)
+
+/*! @brief Angle of a full turn for SCTIMER_PwmWaveSin, the angles wrap at 2^16. */
+#define SCTIMER_PWM_WAVE_TURN (0x10000UL)
+
+/*! @brief Number of rows one link descriptor streams, the DMA moves at most DMA_MAX_TRANSFER_COUNT words. */
+#define SCTIMER_PWM_WAVE_BLOCK_ROWS(rowWords) (DMA_MAX_TRANSFER_COUNT / (rowWords))
+
+/*! @brief Number of link descriptors the application provides for a table of steps rows. */
+#define SCTIMER_PWM_WAVE_DESCRIPTOR_NUM(steps, rowWords) \
+    (((steps) + SCTIMER_PWM_WAVE_BLOCK_ROWS(rowWords) - 1U) / SCTIMER_PWM_WAVE_BLOCK_ROWS(rowWords))
+
+/*! @brief SCTimer PWM waveform handle typedef. */
+typedef struct _sctimer_pwm_wave_handle sctimer_pwm_wave_handle_t;
+
+/*!
+ * @brief Table wrap callback typedef.
+ *
+ * Called from the DMA interrupt each time the DMA has read the last row of the table.
+ */
+typedef void (*sctimer_pwm_wave_callback_t)(SCT_Type *base, sctimer_pwm_wave_handle_t *handle, void *userData);
+
+/*!
+ * @brief Waveform configuration.
+ *
+ * Independent outputs each follow one duty cycle of a row. Complementary outputs come in pairs,
+ * high side first, and follow one duty cycle per pair: the low side is active when the high side
+ * is not, with the dead time between the two, e.g. three half bridges of a motor.
+ */
+typedef struct _sctimer_pwm_wave_config
+{
+    sctimer_pwm_mode_t mode;                              /*!< Edge or center aligned. */
+    sctimer_pwm_level_select_t level;                     /*!< Active level of all outputs. */
+    uint32_t pwmFreq_Hz;                                  /*!< PWM frequency, one table row per period. */
+    uint8_t outputCount;                                  /*!< Number of outputs, even if complementary. */
+    bool complementary;                                   /*!< Outputs are high and low side pairs. */
+    uint32_t deadTime_ns;                                 /*!< Dead time of the pairs, at least one clock. */
+    sctimer_out_t outputs[SCTIMER_PWM_WAVE_MAX_OUTPUTS]; /*!< SCTimer outputs, high side first in a pair. */
+    uint8_t dmaRequest;                                   /*!< SCTimer DMA request 0 or 1 feeding the DMA. */
+} sctimer_pwm_wave_config_t;
+
+/*!
+ * @brief Timing of a waveform, computed from the configuration and the SCTimer clock.
+ *
+ * A row of the table holds rowWords match reload values. Word 0 is the limit of the period, edge
+ * aligned rows of complementary outputs hold the shared dead time match in word 1, the remaining
+ * words hold the matches of the outputs in output order. Unused words are 0.
+ */
+typedef struct _sctimer_pwm_wave_timing
+{
+    sctimer_pwm_mode_t mode; /*!< Edge or center aligned. */
+    bool complementary;      /*!< Outputs are high and low side pairs. */
+    uint8_t duties;          /*!< Duty cycles per row, one per output or per pair. */
+    uint8_t rowWords;        /*!< Match registers written per period, power of 2. */
+    uint32_t sctClock_Hz;    /*!< SCTimer counter clock. */
+    uint32_t periodTicks;    /*!< Counter clocks per PWM period. */
+    uint32_t limit;          /*!< Match 0, period - 1 edge aligned, half the period center aligned. */
+    uint32_t deadTicks;      /*!< Dead time in counter clocks, 0 for independent outputs. */
+    uint32_t maxOnTicks;     /*!< Active time of a high side or independent output at 100 %. */
+} sctimer_pwm_wave_timing_t;
+
+/*! @brief SCTimer PWM waveform handle structure. */
+struct _sctimer_pwm_wave_handle
+{
+    SCT_Type *base;                                /*!< SCTimer peripheral base address. */
+    dma_handle_t *dmaHandle;                       /*!< The DMA handle used. */
+    dma_descriptor_t *descriptors;                 /*!< Link descriptors. */
+    uint32_t descriptorCount;                      /*!< Number of link descriptors. */
+    sctimer_pwm_wave_timing_t timing;              /*!< Timing of the waveform. */
+    const uint32_t *table;                         /*!< Table of the running waveform. */
+    uint32_t steps;                                /*!< Rows of the running waveform. */
+    sctimer_pwm_level_select_t level;              /*!< Active level of all outputs. */
+    uint8_t outputCount;                           /*!< Number of outputs. */
+    uint8_t outputs[SCTIMER_PWM_WAVE_MAX_OUTPUTS]; /*!< SCTimer outputs, high side first in a pair. */
+    volatile uint32_t tableCount;                  /*!< Times the DMA has read the whole table. */
+    sctimer_pwm_wave_callback_t callback;          /*!< Callback function called at each table wrap. */
+    void *userData;                                /*!< Callback parameter passed to callback function. */
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /*_cplusplus. */
+
+/*!
+ * @name Table generation
+ * @{
+ */
+
+/*!
+ * @brief Gets the default configuration, three complementary pairs at 20 kHz edge aligned.
+ *
+ * The outputs are kSCTIMER_Out_0 to kSCTIMER_Out_5, the dead time 500 ns.
+ *
+ * @param config Pointer to the configuration structure.
+ */
+void SCTIMER_PwmWaveGetDefaultConfig(sctimer_pwm_wave_config_t *config);
+
+/*!
+ * @brief Computes the timing of a waveform.
+ *
+ * The period is the nearest number of counter clocks, the dead time is rounded up.
+ *
+ * @param config Pointer to the configuration structure.
+ * @param sctClock_Hz SCTimer counter clock, the source clock divided by the prescaler.
+ * @param timing Returns the timing.
+ * @retval kStatus_Success The timing is valid.
+ * @retval kStatus_InvalidArgument Too many outputs, an odd number of complementary outputs, or no
+ *         active time left in the period after the dead times.
+ */
+status_t SCTIMER_PwmWaveGetTiming(const sctimer_pwm_wave_config_t *config,
+                                  uint32_t sctClock_Hz,
+                                  sctimer_pwm_wave_timing_t *timing);
+
+/*!
+ * @brief Converts the duty cycles of one period into a table row.
+ *
+ * Edge aligned an output is active for duty * periodTicks clocks from the start of the period, center
+ * aligned for an even number of clocks centered on the counter bottom. A complementary pair shares the period minus
+ * two dead times, the high side gets duty of it. 0 and SCTIMER_PWM_WAVE_DUTY_FULL keep an output
+ * inactive or active for the whole period.
+ *
+ * @param timing Timing of the waveform.
+ * @param row Returns timing->rowWords match values.
+ * @param duty timing->duties Q15 duty cycles, from 0 to SCTIMER_PWM_WAVE_DUTY_FULL.
+ */
+void SCTIMER_PwmWaveSetRow(const sctimer_pwm_wave_timing_t *timing, uint32_t *row, const uint16_t *duty);
+
+/*!
+ * @brief Fills a table with one turn of a sine modulation.
+ *
+ * Duty k of step n is 0.5 + 0.5 * amplitude * sin(2 pi n / steps + k * phaseOffset), e.g. a phase offset
+ * of SCTIMER_PWM_WAVE_TURN / 3 for three motor phases, the output frequency is pwmFreq_Hz / steps.
+ *
+ * @param timing Timing of the waveform.
+ * @param table Returns steps rows of timing->rowWords words.
+ * @param steps Rows of the table.
+ * @param amplitude Q15 amplitude, up to SCTIMER_PWM_WAVE_DUTY_FULL.
+ * @param phaseOffset Angle between consecutive duties, SCTIMER_PWM_WAVE_TURN is a full turn.
+ */
+void SCTIMER_PwmWaveFillSine(const sctimer_pwm_wave_timing_t *timing,
+                             uint32_t *table,
+                             uint32_t steps,
+                             uint16_t amplitude,
+                             uint32_t phaseOffset);
+
+/*!
+ * @brief Integer sine, within 6 LSB of the exact value.
+ *
+ * @param angle Angle, SCTIMER_PWM_WAVE_TURN is a full turn.
+ * @return Q15 sine, from -32767 to 32767.
+ */
+int16_t SCTIMER_PwmWaveSin(uint16_t angle);
+
+/*! @} */
+
+/*!
+ * @name Waveform operation
+ * @{
+ */
+
+/*!
+ * @brief Programs the SCTimer events of a waveform and initializes the handle.
+ *
+ * Call it right after SCTIMER_Init with the unified counter, the waveform takes the events from 0 on
+ * and the match registers 0 to rowWords - 1. The period event raises the SCTimer DMA request, the application
+ * routes it to the DMA channel through INPUTMUX. The DMA channel must be enabled.
+ *
+ * @code
+ * DMA_ALLOCATE_LINK_DESCRIPTORS(s_waveDescriptors, SCTIMER_PWM_WAVE_DESCRIPTOR_NUM(WAVE_STEPS, 8U));
+ *
+ * SCTIMER_Init(SCT0, &sctConfig);
+ * DMA_Init(DMA0);
+ * INPUTMUX_Init(INPUTMUX);
+ * INPUTMUX_AttachSignal(INPUTMUX, WAVE_DMA_CHANNEL, kINPUTMUX_SctDma0ToDma);
+ * DMA_EnableChannel(DMA0, WAVE_DMA_CHANNEL);
+ * DMA_CreateHandle(&dmaHandle, DMA0, WAVE_DMA_CHANNEL);
+ * SCTIMER_PwmWaveCreateHandle(SCT0, &waveHandle, &waveConfig, CLOCK_GetFreq(kCLOCK_Fro), NULL, NULL, &dmaHandle,
+ *                             s_waveDescriptors, ARRAY_SIZE(s_waveDescriptors));
+ * SCTIMER_PwmWaveFillSine(&waveHandle.timing, s_table, WAVE_STEPS, amplitude, SCTIMER_PWM_WAVE_TURN / 3U);
+ * SCTIMER_PwmWaveStart(SCT0, &waveHandle, s_table, WAVE_STEPS);
+ * @endcode
+ *
+ * @param base SCTimer peripheral base address.
+ * @param handle pointer to sctimer_pwm_wave_handle_t structure.
+ * @param config Pointer to the configuration structure.
+ * @param srcClock_Hz SCTimer clock, the prescaler of the unified counter divides it.
+ * @param callback Callback function called at each table wrap, NULL if not used.
+ * @param userData user param passed to the callback function.
+ * @param dmaHandle DMA handle pointer.
+ * @param descriptors Link descriptors allocated with DMA_ALLOCATE_LINK_DESCRIPTORS.
+ * @param descriptorCount Number of link descriptors, see SCTIMER_PWM_WAVE_DESCRIPTOR_NUM.
+ * @retval kStatus_Success The events are programmed.
+ * @retval kStatus_InvalidArgument The timing is not valid, see SCTIMER_PwmWaveGetTiming.
+ * @retval kStatus_Fail Events or match registers are already used.
+ */
+status_t SCTIMER_PwmWaveCreateHandle(SCT_Type *base,
+                                     sctimer_pwm_wave_handle_t *handle,
+                                     const sctimer_pwm_wave_config_t *config,
+                                     uint32_t srcClock_Hz,
+                                     sctimer_pwm_wave_callback_t callback,
+                                     void *userData,
+                                     dma_handle_t *dmaHandle,
+                                     dma_descriptor_t *descriptors,
+                                     uint32_t descriptorCount);
+
+/*!
+ * @brief Starts the counter and streams the table, one row per period, until stopped.
+ *
+ * Row 0 is loaded before the counter starts. The DMA writes each following row into the match
+ * reload registers at the end of a period; edge aligned the row takes effect one period later,
+ * center aligned in the next period. The table wraps around without the CPU.
+ *
+ * @param base SCTimer peripheral base address.
+ * @param handle pointer to sctimer_pwm_wave_handle_t structure.
+ * @param table Table of steps rows, it must stay valid while the waveform runs.
+ * @param steps Rows of the table.
+ * @retval kStatus_Success The waveform runs.
+ * @retval kStatus_InvalidArgument The table is empty or needs more link descriptors than the handle has.
+ * @retval kStatus_Busy The DMA channel is still in use.
+ */
+status_t SCTIMER_PwmWaveStart(SCT_Type *base, sctimer_pwm_wave_handle_t *handle, const uint32_t *table, uint32_t steps);
+
+/*!
+ * @brief Stops the counter and the DMA, the outputs go inactive.
+ *
+ * @param base SCTimer peripheral base address.
+ * @param handle pointer to sctimer_pwm_wave_handle_t structure.
+ */
+void SCTIMER_PwmWaveStop(SCT_Type *base, sctimer_pwm_wave_handle_t *handle);
+
+/*!
+ * @brief Gets the number of times the DMA has read the whole table.
+ *
+ * Counts only with a callback, the wrap interrupt is not enabled without one.
+ *
+ * @param handle pointer to sctimer_pwm_wave_handle_t structure.
+ * @return Table wraps since the waveform started.
+ */
+static inline uint32_t SCTIMER_PwmWaveGetTableCount(sctimer_pwm_wave_handle_t *handle)
+{
+    return handle->tableCount;
+}
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif /*_cplusplus. */
+
+/*! @} */
+
+#endif /* FSL_SCTIMER_PWM_WAVE_H_ */
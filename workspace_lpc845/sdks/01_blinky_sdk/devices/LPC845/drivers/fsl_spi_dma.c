@@ -0,0 +1,497 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "fsl_spi_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.lpc_minispi_dma"
+#endif
+
+/*! @brief One block of a descriptor chain. */
+typedef struct _spi_dma_block
+{
+    uint32_t xferCfg; /*!< Transfer configuration without reload, trigger and interrupt bits. */
+    void *srcAddr;    /*!< Start address of the source. */
+    void *dstAddr;    /*!< Start address of the destination. */
+} spi_dma_block_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief Splits frames between a peripheral register and memory into DMA blocks.
+ *
+ * @param blocks Receives the blocks.
+ * @param frames Number of frames.
+ * @param width Bytes per frame.
+ * @param srcAddr Start of the source.
+ * @param srcInc Source address increment, kDMA_AddressInterleave0xWidth or kDMA_AddressInterleave1xWidth.
+ * @param dstAddr Start of the destination.
+ * @param dstInc Destination address increment.
+ * @return Number of blocks.
+ */
+static uint32_t SPI_SplitBlocksDMA(spi_dma_block_t *blocks,
+                                   uint32_t frames,
+                                   uint32_t width,
+                                   uint8_t *srcAddr,
+                                   uint32_t srcInc,
+                                   uint8_t *dstAddr,
+                                   uint32_t dstInc);
+
+/*!
+ * @brief Loads a chain of blocks into a DMA channel.
+ *
+ * The first block goes to the head descriptor of the channel and the others to the link
+ * descriptors. With notify, every block but the last raises INTB and the last one INTA.
+ *
+ * @param dmaHandle DMA handle of the channel.
+ * @param links Link descriptors, one less than blocks.
+ * @param blocks The blocks.
+ * @param count Number of blocks.
+ * @param notify Raise interrupts.
+ */
+static void SPI_SubmitBlocksDMA(
+    dma_handle_t *dmaHandle, dma_descriptor_t *links, const spi_dma_block_t *blocks, uint32_t count, bool notify);
+
+/*!
+ * @brief Starts a transfer of the master or the slave.
+ *
+ * @param base SPI peripheral base address.
+ * @param handle SPI DMA handle pointer.
+ * @param xfer Pointer to dma transfer structure.
+ * @param isMaster Inject the control word of the last frame.
+ */
+static status_t SPI_TransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer, bool isMaster);
+
+/*!
+ * @brief DMA callback of the receive channel.
+ *
+ * @param handle DMA handle pointer.
+ * @param userData SPI DMA handle.
+ * @param transferDone false on a DMA error.
+ * @param intmode kDMA_IntB for a completed block, kDMA_IntA for the end of the transfer.
+ */
+static void SPI_RxDMACallback(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode);
+
+/*!
+ * @brief DMA callback of the send channel, only called on a DMA error.
+ *
+ * @param handle DMA handle pointer.
+ * @param userData SPI DMA handle.
+ * @param transferDone false on a DMA error.
+ * @param intmode DMA interrupt mode.
+ */
+static void SPI_TxDMACallback(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Link descriptors of the send and receive chains, the head descriptors are in the DMA driver. */
+DMA_ALLOCATE_LINK_DESCRIPTORS(s_spiTxLinkDescriptors[FSL_FEATURE_SOC_SPI_COUNT], SPI_DMA_LINK_DESCRIPTOR_NUM);
+DMA_ALLOCATE_LINK_DESCRIPTORS(s_spiRxLinkDescriptors[FSL_FEATURE_SOC_SPI_COUNT], SPI_DMA_LINK_DESCRIPTOR_NUM);
+
+/* SPI base of each DMA handle, the DMA callbacks only get the SPI DMA handle. */
+static SPI_Type *s_spiDmaBase[FSL_FEATURE_SOC_SPI_COUNT];
+static spi_dma_handle_t *s_spiDmaHandle[FSL_FEATURE_SOC_SPI_COUNT];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t SPI_SplitBlocksDMA(spi_dma_block_t *blocks,
+                                   uint32_t frames,
+                                   uint32_t width,
+                                   uint8_t *srcAddr,
+                                   uint32_t srcInc,
+                                   uint8_t *dstAddr,
+                                   uint32_t dstInc)
+{
+    uint32_t count = 0U;
+    uint32_t blockFrames;
+
+    while (frames != 0U)
+    {
+        blockFrames = (frames > DMA_MAX_TRANSFER_COUNT) ? DMA_MAX_TRANSFER_COUNT : frames;
+
+        blocks[count].xferCfg =
+            DMA_CHANNEL_XFER(false, false, false, false, width, srcInc, dstInc, blockFrames * width);
+        blocks[count].srcAddr = srcAddr;
+        blocks[count].dstAddr = dstAddr;
+
+        srcAddr = &srcAddr[blockFrames * width * srcInc];
+        dstAddr = &dstAddr[blockFrames * width * dstInc];
+        frames -= blockFrames;
+        count++;
+    }
+
+    return count;
+}
+
+static void SPI_SubmitBlocksDMA(
+    dma_handle_t *dmaHandle, dma_descriptor_t *links, const spi_dma_block_t *blocks, uint32_t count, bool notify)
+{
+    uint32_t xferCfg;
+    uint32_t i;
+
+    assert((count != 0U) && (count <= (SPI_DMA_LINK_DESCRIPTOR_NUM + 1U)));
+
+    /* Link descriptors first, the head descriptor starts the chain. */
+    for (i = count; i-- > 0U;)
+    {
+        xferCfg = blocks[i].xferCfg;
+        if ((i + 1U) < count)
+        {
+            xferCfg |= DMA_CHANNEL_XFERCFG_RELOAD_MASK | (notify ? DMA_CHANNEL_XFERCFG_SETINTB_MASK : 0U);
+        }
+        else
+        {
+            xferCfg |= DMA_CHANNEL_XFERCFG_CLRTRIG_MASK | (notify ? DMA_CHANNEL_XFERCFG_SETINTA_MASK : 0U);
+        }
+
+        if (i == 0U)
+        {
+            DMA_SubmitChannelTransferParameter(dmaHandle, xferCfg, blocks[0].srcAddr, blocks[0].dstAddr,
+                                               (count > 1U) ? &links[0] : NULL);
+        }
+        else
+        {
+            DMA_SetupDescriptor(&links[i - 1U], xferCfg, blocks[i].srcAddr, blocks[i].dstAddr,
+                                ((i + 1U) < count) ? &links[i] : NULL);
+        }
+    }
+}
+
+static void SPI_RxDMACallback(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode)
+{
+    spi_dma_handle_t *spiHandle = (spi_dma_handle_t *)userData;
+    uint32_t instance;
+    status_t status;
+
+    assert(spiHandle != NULL);
+
+    if (transferDone && (intmode == (uint32_t)kDMA_IntB))
+    {
+        /* One more block of DMA_MAX_TRANSFER_COUNT frames received. */
+        spiHandle->rxBlockCount++;
+        return;
+    }
+
+    if (transferDone)
+    {
+        status = kStatus_Success;
+    }
+    else
+    {
+        DMA_AbortTransfer(spiHandle->txHandle);
+        DMA_AbortTransfer(handle);
+        status = kStatus_SPI_Error;
+    }
+
+    spiHandle->inProgress = false;
+
+    if (spiHandle->callback != NULL)
+    {
+        for (instance = 0U; instance < (uint32_t)FSL_FEATURE_SOC_SPI_COUNT; instance++)
+        {
+            if (s_spiDmaHandle[instance] == spiHandle)
+            {
+                break;
+            }
+        }
+        assert(instance < (uint32_t)FSL_FEATURE_SOC_SPI_COUNT);
+
+        spiHandle->callback(s_spiDmaBase[instance], spiHandle, status, spiHandle->userData);
+    }
+}
+
+static void SPI_TxDMACallback(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode)
+{
+    spi_dma_handle_t *spiHandle = (spi_dma_handle_t *)userData;
+
+    assert(spiHandle != NULL);
+
+    /* The send chain raises no interrupt, only errors get here. Report them through the receive side. */
+    if (!transferDone)
+    {
+        SPI_RxDMACallback(spiHandle->rxHandle, spiHandle, false, intmode);
+    }
+}
+
+/*!
+ * brief Initialize the SPI master DMA handle.
+ *
+ * This function initializes the SPI master DMA handle which can be used for other SPI master transactional APIs.
+ * Usually, for a specified SPI instance, user need only call this API once to get the initialized handle.
+ *
+ * param base SPI peripheral base address.
+ * param handle SPI handle pointer.
+ * param callback User callback function called at the end of a transfer.
+ * param userData User data for callback.
+ * param txHandle DMA handle pointer for SPI Tx, the handle shall be static allocated by users.
+ * param rxHandle DMA handle pointer for SPI Rx, the handle shall be static allocated by users.
+ */
+status_t SPI_MasterTransferCreateHandleDMA(SPI_Type *base,
+                                           spi_dma_handle_t *handle,
+                                           spi_dma_callback_t callback,
+                                           void *userData,
+                                           dma_handle_t *txHandle,
+                                           dma_handle_t *rxHandle)
+{
+    uint32_t instance;
+
+    assert(NULL != handle);
+    assert(NULL != txHandle);
+    assert(NULL != rxHandle);
+
+    instance = SPI_GetInstance(base);
+
+    (void)memset(handle, 0, sizeof(*handle));
+
+    handle->txHandle = txHandle;
+    handle->rxHandle = rxHandle;
+    handle->callback = callback;
+    handle->userData = userData;
+
+    s_spiDmaBase[instance]   = base;
+    s_spiDmaHandle[instance] = handle;
+
+    DMA_SetCallback(txHandle, SPI_TxDMACallback, handle);
+    DMA_SetCallback(rxHandle, SPI_RxDMACallback, handle);
+
+    return kStatus_Success;
+}
+
+static status_t SPI_TransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer, bool isMaster)
+{
+    uint32_t instance = SPI_GetInstance(base);
+    spi_dma_block_t blocks[SPI_DMA_LINK_DESCRIPTOR_NUM + 1U];
+    uint32_t blockCount;
+    uint32_t dataWidth;
+    uint32_t width;
+    uint32_t frames;
+    uint32_t txFrames;
+    uint32_t control;
+    uint32_t lastData;
+    uint8_t *txAddr;
+
+    assert(NULL != handle);
+    assert(NULL != xfer);
+
+    if (handle->inProgress)
+    {
+        return kStatus_SPI_Busy;
+    }
+
+    dataWidth = (base->TXCTL & SPI_TXCTL_LEN_MASK) >> SPI_TXCTL_LEN_SHIFT;
+    width     = (dataWidth > (uint32_t)kSPI_Data8Bits) ? 2U : 1U;
+
+    if ((xfer->dataSize == 0U) || ((xfer->dataSize % width) != 0U) ||
+        ((xfer->dataSize / width) > SPI_DMA_MAX_TRANSFER_FRAMES) ||
+        ((xfer->txData == NULL) && (xfer->rxData == NULL)) ||
+        ((width == 2U) && ((((uint32_t)xfer->txData | (uint32_t)xfer->rxData) & 1U) != 0U)))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    frames = (uint32_t)xfer->dataSize / width;
+
+    handle->inProgress    = true;
+    handle->isMaster      = isMaster;
+    handle->bytesPerFrame = (uint8_t)width;
+    handle->transferSize  = xfer->dataSize;
+    handle->rxBlockCount  = 0U;
+
+    /* Drop a stale frame and old errors, the receive chain must start with the first frame. */
+    if ((SPI_GetStatusFlags(base) & (uint32_t)kSPI_RxReadyFlag) != 0U)
+    {
+        (void)base->RXDAT;
+    }
+    SPI_ClearStatusFlags(base, (uint32_t)kSPI_RxOverrunFlag | (uint32_t)kSPI_TxUnderrunFlag);
+
+    /* Receive chain, into the buffer or into the dummy sink. */
+    if (xfer->rxData != NULL)
+    {
+        blockCount = SPI_SplitBlocksDMA(blocks, frames, width, (uint8_t *)(uint32_t)&base->RXDAT,
+                                        kDMA_AddressInterleave0xWidth, xfer->rxData, kDMA_AddressInterleave1xWidth);
+    }
+    else
+    {
+        blockCount = SPI_SplitBlocksDMA(blocks, frames, width, (uint8_t *)(uint32_t)&base->RXDAT,
+                                        kDMA_AddressInterleave0xWidth, (uint8_t *)&handle->rxDummy,
+                                        kDMA_AddressInterleave0xWidth);
+    }
+    DMA_SetChannelConfig(handle->rxHandle->base, handle->rxHandle->channel, NULL, true);
+    SPI_SubmitBlocksDMA(handle->rxHandle, s_spiRxLinkDescriptors[instance], blocks, blockCount, true);
+
+    /*
+     * Send chain. The master sends the last frame through TXDATCTL with the end of transfer bit,
+     * all other frames go to TXDAT and use the control bits of TXCTL.
+     */
+    txFrames = isMaster ? (frames - 1U) : frames;
+    txAddr   = (xfer->txData != NULL) ? (uint8_t *)(uint32_t)xfer->txData :
+                                        (uint8_t *)(uint32_t)&s_dummyData[instance];
+    blockCount =
+        SPI_SplitBlocksDMA(blocks, txFrames, width, txAddr,
+                           (xfer->txData != NULL) ? kDMA_AddressInterleave1xWidth : kDMA_AddressInterleave0xWidth,
+                           (uint8_t *)(uint32_t)&base->TXDAT, kDMA_AddressInterleave0xWidth);
+
+    if (isMaster)
+    {
+        control = base->TXCTL & ~(SPI_TXDATCTL_EOT_MASK | SPI_TXDATCTL_EOF_MASK | SPI_TXDATCTL_RXIGNORE_MASK |
+                                  SPI_TXDATCTL_TXDAT_MASK);
+        control |= xfer->configFlags & SPI_TXDATCTL_EOF_MASK;
+        base->TXCTL = control;
+
+        if (xfer->txData == NULL)
+        {
+            lastData = s_dummyData[instance];
+        }
+        else if (width == 2U)
+        {
+            lastData = ((uint32_t)xfer->txData[(txFrames * 2U) + 1U] << 8U) | xfer->txData[txFrames * 2U];
+        }
+        else
+        {
+            lastData = xfer->txData[txFrames];
+        }
+
+        handle->lastTxWord = control | (xfer->configFlags & (SPI_TXDATCTL_EOT_MASK | SPI_TXDATCTL_EOF_MASK)) |
+                             SPI_TXDATCTL_TXDAT(lastData);
+
+        blocks[blockCount].xferCfg =
+            DMA_CHANNEL_XFER(false, false, false, false, sizeof(uint32_t), kDMA_AddressInterleave0xWidth,
+                             kDMA_AddressInterleave0xWidth, sizeof(uint32_t));
+        blocks[blockCount].srcAddr = &handle->lastTxWord;
+        blocks[blockCount].dstAddr = (void *)(uint32_t)&base->TXDATCTL;
+        blockCount++;
+    }
+
+    DMA_SetChannelConfig(handle->txHandle->base, handle->txHandle->channel, NULL, true);
+    SPI_SubmitBlocksDMA(handle->txHandle, s_spiTxLinkDescriptors[instance], blocks, blockCount, false);
+
+    /* Receive first, so no frame is missed. */
+    DMA_StartTransfer(handle->rxHandle);
+    DMA_StartTransfer(handle->txHandle);
+
+    return kStatus_Success;
+}
+
+/*!
+ * brief Perform a non-blocking SPI transfer using DMA.
+ *
+ * param base SPI peripheral base address.
+ * param handle SPI DMA handle pointer.
+ * param xfer Pointer to dma transfer structure.
+ * retval kStatus_Success Successfully start a transfer.
+ * retval kStatus_InvalidArgument Input argument is invalid.
+ * retval kStatus_SPI_Busy SPI is not idle, is running another transfer.
+ */
+status_t SPI_MasterTransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer)
+{
+    return SPI_TransferDMA(base, handle, xfer, true);
+}
+
+/*!
+ * brief Perform a non-blocking SPI slave transfer using DMA.
+ *
+ * param base SPI peripheral base address.
+ * param handle SPI DMA handle pointer.
+ * param xfer Pointer to dma transfer structure.
+ * retval kStatus_Success Successfully start a transfer.
+ * retval kStatus_InvalidArgument Input argument is invalid.
+ * retval kStatus_SPI_Busy SPI is not idle, is running another transfer.
+ */
+status_t SPI_SlaveTransferDMA(SPI_Type *base, spi_dma_handle_t *handle, spi_transfer_t *xfer)
+{
+    return SPI_TransferDMA(base, handle, xfer, false);
+}
+
+/*!
+ * brief Abort a SPI transfer using DMA.
+ *
+ * param base SPI peripheral base address.
+ * param handle SPI DMA handle pointer.
+ */
+void SPI_MasterTransferAbortDMA(SPI_Type *base, spi_dma_handle_t *handle)
+{
+    assert(NULL != handle);
+
+    DMA_AbortTransfer(handle->txHandle);
+    DMA_AbortTransfer(handle->rxHandle);
+
+    /* Release the slave select when the last frame did not get out. */
+    if (handle->inProgress && handle->isMaster && ((SPI_GetStatusFlags(base) & (uint32_t)kSPI_MasterIdleFlag) == 0U))
+    {
+        SPI_ClearStatusFlags(base, (uint32_t)kSPI_EndTransferFlag);
+    }
+
+    handle->inProgress = false;
+}
+
+/*!
+ * brief Gets the master DMA transfer remaining bytes.
+ *
+ * param base SPI peripheral base address.
+ * param handle A pointer to the spi_dma_handle_t structure which stores the transfer state.
+ * param count A number of bytes received so far by the non-blocking transaction.
+ * retval kStatus_Success Get the transferred count.
+ * retval kStatus_NoTransferInProgress No transfer is running.
+ * retval kStatus_InvalidArgument count is NULL.
+ */
+status_t SPI_MasterTransferGetCountDMA(SPI_Type *base, spi_dma_handle_t *handle, size_t *count)
+{
+    assert(NULL != handle);
+
+    DMA_Type *dmaBase;
+    uint32_t channel;
+    uint32_t mask;
+    uint32_t primask;
+    uint32_t pending;
+    uint32_t remaining;
+    uint32_t blocks;
+    uint32_t blockBytes = DMA_MAX_TRANSFER_COUNT * (uint32_t)handle->bytesPerFrame;
+    uint32_t done;
+
+    if (NULL == count)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (!handle->inProgress)
+    {
+        *count = 0U;
+        return kStatus_NoTransferInProgress;
+    }
+
+    dmaBase = handle->rxHandle->base;
+    channel = handle->rxHandle->channel;
+    mask    = 1UL << DMA_CHANNEL_INDEX(dmaBase, channel);
+
+    /* A block may complete while the remaining count is read, read again until INTB is stable. */
+    primask = DisableGlobalIRQ();
+    do
+    {
+        pending   = DMA_COMMON_REG_GET(dmaBase, channel, INTB) & mask;
+        remaining = DMA_GetRemainingBytes(dmaBase, channel);
+    } while (pending != (DMA_COMMON_REG_GET(dmaBase, channel, INTB) & mask));
+    blocks = handle->rxBlockCount + ((pending != 0U) ? 1U : 0U);
+    EnableGlobalIRQ(primask);
+
+    done = blocks * blockBytes;
+    if (((uint32_t)handle->transferSize - done) < blockBytes)
+    {
+        blockBytes = (uint32_t)handle->transferSize - done;
+    }
+
+    *count = (remaining > blockBytes) ? done : (done + blockBytes - remaining);
+
+    return kStatus_Success;
+}
@@ -0,0 +1,374 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef FSL_USART_DMA_H_
+#define FSL_USART_DMA_H_
+
+#include "fsl_usart.h"
+#include "fsl_dma.h"
+
+/*!
+ * @addtogroup usart_dma_driver
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*! @{ */
+/*! @brief USART DMA driver version. */
+#define FSL_USART_DMA_DRIVER_VERSION (MAKE_VERSION(2, 1, 0))
+/*! @} */
+
+/*!
+ * @brief Maximum size of one ring buffer block.
+ *
+ * One block less than the DMA capability, DMA_GetRemainingBytes can not tell a full 1024 transfers
+ * descriptor from a finished one inside a descriptor chain.
+ */
+#define USART_MAX_DMA_RING_BLOCK_SIZE (512U)
+
+/*!
+ * @brief Number of transmit requests queued in the handle, power of 2.
+ *
+ * Counts the running requests as well as the waiting ones.
+ */
+#ifndef USART_DMA_TX_QUEUE_SIZE
+#define USART_DMA_TX_QUEUE_SIZE (8U)
+#endif
+
+/*! @brief Maximum size of one transmit descriptor, longer segments take several descriptors. */
+#define USART_MAX_DMA_TX_DESCRIPTOR_SIZE (DMA_MAX_TRANSFER_COUNT)
+
+/* Forward declaration of the handle typedef. */
+typedef struct _usart_dma_handle usart_dma_handle_t;
+
+/*!
+ * @brief USART DMA transfer callback function.
+ *
+ * In ring buffer mode the status is
+ *  - kStatus_USART_RxIdle when the DMA completed one ring buffer block,
+ *  - kStatus_USART_Timeout when the line went idle in the middle of a block,
+ *  - kStatus_USART_RxRingBufferOverrun when unread data was overwritten,
+ *  - kStatus_USART_RxError on a DMA error.
+ *
+ * Every transmit request ends with one call, in the order of the requests, the status is
+ *  - kStatus_USART_TxIdle when the DMA wrote the last byte of the request to the USART,
+ *  - kStatus_USART_TxError on a DMA error.
+ */
+typedef void (*usart_dma_transfer_callback_t)(USART_Type *base,
+                                              usart_dma_handle_t *handle,
+                                              status_t status,
+                                              void *userData);
+
+/*! @brief USART DMA receive statistics. */
+typedef struct _usart_dma_rx_stats
+{
+    uint32_t rxBytes;        /*!< Bytes stored by the DMA since the ring buffer was started, wraps at 2^32. */
+    uint32_t blockIrqCount;  /*!< DMA interrupts taken, one per completed block. */
+    uint32_t idleFlushCount; /*!< Partial blocks flushed by the idle timer. */
+    uint32_t overrunCount;   /*!< Times unread data was overwritten. */
+} usart_dma_rx_stats_t;
+
+/*! @brief USART DMA transmit statistics. */
+typedef struct _usart_dma_tx_stats
+{
+    uint32_t txBytes;      /*!< Bytes of the completed requests, wraps at 2^32. */
+    uint32_t requestCount; /*!< Requests completed. */
+    uint32_t batchCount;   /*!< Descriptor chains started, back to back requests share one chain. */
+    uint32_t irqCount;     /*!< DMA interrupts taken. */
+    uint32_t busyCount;    /*!< Requests refused, the queue or the descriptor pool was full. */
+} usart_dma_tx_stats_t;
+
+/*! @brief Transmit request queued in the USART DMA handle. */
+typedef struct _usart_dma_tx_request
+{
+    uint32_t bytes;           /*!< Bytes of the request. */
+    uint16_t firstDescriptor; /*!< Index of the first descriptor in the pool. */
+    uint16_t lastDescriptor;  /*!< Index of the last descriptor in the pool, raises INTA. */
+    uint16_t descriptorCount; /*!< Descriptors of the request. */
+} usart_dma_tx_request_t;
+
+/*! @brief USART DMA handle. */
+struct _usart_dma_handle
+{
+    USART_Type *base; /*!< USART peripheral base address. */
+
+    usart_dma_transfer_callback_t callback; /*!< Callback function. */
+    void *userData;                         /*!< User data for callback function. */
+
+    dma_handle_t *txDmaHandle; /*!< The DMA TX channel used. */
+    dma_handle_t *rxDmaHandle; /*!< The DMA RX channel used. */
+
+    dma_descriptor_t *rxDescriptors;  /*!< Link descriptors of the RX ring, one per block. */
+    uint8_t *rxRingBuffer;            /*!< Start address of the receiver ring buffer. */
+    uint32_t rxRingBufferSize;        /*!< Size of the ring buffer, power of 2. */
+    uint32_t rxBlockSize;             /*!< Size of one DMA block, divides the ring buffer size. */
+    volatile uint32_t rxBlockCount;   /*!< Blocks completed, the DMA fills block rxBlockCount next. */
+    volatile uint32_t rxTail;         /*!< Bytes released by the consumer, wraps at 2^32. */
+    uint32_t rxIdleMark;              /*!< Received count seen by the previous idle tick. */
+    bool rxIdleArmed;                 /*!< Data arrived since the last idle flush. */
+    uint32_t rxIdleFlushCount;        /*!< Partial blocks flushed by the idle timer. */
+    uint32_t rxOverrunCount;          /*!< Times unread data was overwritten. */
+    volatile uint8_t rxState;         /*!< RX transfer state. */
+
+    dma_descriptor_t *txDescriptors;                            /*!< Link descriptor pool of the TX requests. */
+    uint32_t txDescriptorNum;                                   /*!< Descriptors in the pool. */
+    uint32_t txDescriptorHead;                                  /*!< Next free descriptor, the pool is a ring. */
+    uint32_t txDescriptorFree;                                  /*!< Descriptors not used by a request. */
+    usart_dma_tx_request_t txRequests[USART_DMA_TX_QUEUE_SIZE]; /*!< Queued and running TX requests. */
+    volatile uint32_t txRequestHead;                            /*!< Requests queued, wraps at 2^32. */
+    volatile uint32_t txRequestTail;                            /*!< Requests completed, wraps at 2^32. */
+    uint32_t txRequestStarted;                                  /*!< Requests handed to the DMA. */
+    usart_dma_tx_stats_t txStats;                               /*!< TX statistics. */
+    volatile uint8_t txState;                                   /*!< TX transfer state. */
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* _cplusplus */
+
+/*!
+ * @name DMA transactional
+ * @{
+ */
+
+/*!
+ * @brief Initializes the USART handle which is used in transactional functions.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @param callback Callback function.
+ * @param userData User data.
+ * @param txDmaHandle User-requested DMA handle for TX DMA transfer, NULL when only receiving.
+ * @param rxDmaHandle User-requested DMA handle for RX DMA transfer, NULL when only sending.
+ * @retval kStatus_Success Handle was created.
+ */
+status_t USART_TransferCreateHandleDMA(USART_Type *base,
+                                       usart_dma_handle_t *handle,
+                                       usart_dma_transfer_callback_t callback,
+                                       void *userData,
+                                       dma_handle_t *txDmaHandle,
+                                       dma_handle_t *rxDmaHandle);
+
+/*!
+ * @brief Starts receiving into a ring buffer with the DMA.
+ *
+ * The ring buffer is split into blocks, each block is a link descriptor and the last one links
+ * back to the first, so the DMA receives forever without a per-byte interrupt. The consumer
+ * reads the data in place with USART_TransferGetRxSpanDMA and gives it back with
+ * USART_TransferReleaseRxSpanDMA.
+ *
+ * Data that ends in the middle of a block is only reported when the line goes idle. Call
+ * USART_TransferRxIdleTickDMA periodically, a repeating MRT channel a few character times
+ * long works well:
+ * @code
+ * DMA_ALLOCATE_LINK_DESCRIPTORS(s_rxDescriptors, RING_SIZE / BLOCK_SIZE);
+ *
+ * USART_TransferCreateHandleDMA(USART0, &usartHandle, callback, NULL, NULL, &rxDmaHandle);
+ * USART_TransferStartRingBufferDMA(USART0, &usartHandle, s_ring, RING_SIZE, BLOCK_SIZE, s_rxDescriptors);
+ * MRT_StartTimer(MRT0, kMRT_Channel_0, USEC_TO_COUNT(100U, CLOCK_GetFreq(kCLOCK_CoreSysClk)));
+ *
+ * void MRT0_IRQHandler(void)
+ * {
+ *     MRT_ClearStatusFlags(MRT0, kMRT_Channel_0, kMRT_TimerInterruptFlag);
+ *     USART_TransferRxIdleTickDMA(USART0, &usartHandle);
+ * }
+ * @endcode
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @param ringBuffer Start address of the ring buffer.
+ * @param ringBufferSize Size of the ring buffer, power of 2.
+ * @param blockSize Bytes per DMA block, power of 2 up to USART_MAX_DMA_RING_BLOCK_SIZE and smaller than
+ *                  ringBufferSize.
+ * @param descriptors ringBufferSize / blockSize link descriptors allocated with DMA_ALLOCATE_LINK_DESCRIPTORS.
+ * @retval kStatus_Success The ring buffer was started.
+ * @retval kStatus_InvalidArgument The ring buffer geometry is not valid.
+ * @retval kStatus_USART_RxBusy The receiver is already in use.
+ */
+status_t USART_TransferStartRingBufferDMA(USART_Type *base,
+                                          usart_dma_handle_t *handle,
+                                          uint8_t *ringBuffer,
+                                          size_t ringBufferSize,
+                                          size_t blockSize,
+                                          dma_descriptor_t *descriptors);
+
+/*!
+ * @brief Stops the DMA ring buffer.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ */
+void USART_TransferStopRingBufferDMA(USART_Type *base, usart_dma_handle_t *handle);
+
+/*!
+ * @brief Gets the length of received data in the DMA ring buffer.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @return Length of received data not released yet.
+ */
+size_t USART_TransferGetRxRingBufferLengthDMA(USART_Type *base, usart_dma_handle_t *handle);
+
+/*!
+ * @brief Gets the oldest received data as one contiguous span of the ring buffer.
+ *
+ * Data wrapping around the end of the ring buffer is returned by two calls, the second one
+ * after the first span was released. The span is not copied, it stays valid until it is
+ * released or the DMA wraps around onto it.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @param data Returns the start of the span.
+ * @return Length of the span, 0 when nothing was received.
+ */
+size_t USART_TransferGetRxSpanDMA(USART_Type *base, usart_dma_handle_t *handle, uint8_t **data);
+
+/*!
+ * @brief Gives received data back to the DMA.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @param length Bytes consumed, at most the length of the received data.
+ * @retval kStatus_Success The data was released.
+ * @retval kStatus_USART_RxRingBufferOverrun The DMA overwrote the data before it was released, the
+ *         ring buffer was emptied.
+ */
+status_t USART_TransferReleaseRxSpanDMA(USART_Type *base, usart_dma_handle_t *handle, size_t length);
+
+/*!
+ * @brief Flushes a partial block when the receive line went idle.
+ *
+ * Call it periodically from a timer interrupt. When no byte arrived since the previous call
+ * and the last received byte does not end a block, the callback is invoked once with
+ * kStatus_USART_Timeout.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ */
+void USART_TransferRxIdleTickDMA(USART_Type *base, usart_dma_handle_t *handle);
+
+/*!
+ * @brief Gets the receive statistics of the DMA ring buffer.
+ *
+ * The throughput is the difference of two rxBytes samples over the time between them.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @param stats Returns the statistics.
+ */
+void USART_TransferGetRxStatsDMA(USART_Type *base, usart_dma_handle_t *handle, usart_dma_rx_stats_t *stats);
+
+/*!
+ * @brief Installs the link descriptors of the DMA transmit requests.
+ *
+ * Every request takes one descriptor per USART_MAX_DMA_TX_DESCRIPTOR_SIZE bytes of each of its
+ * segments, a header + payload + CRC frame takes three. The pool is used as a ring, size it for
+ * the requests that may be queued at the same time.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @param descriptors Link descriptors allocated with DMA_ALLOCATE_LINK_DESCRIPTORS.
+ * @param descriptorNum Number of descriptors, at most 65535.
+ * @retval kStatus_Success The descriptors were installed.
+ * @retval kStatus_InvalidArgument No descriptors.
+ * @retval kStatus_USART_TxBusy Requests are still queued.
+ */
+status_t USART_TransferInstallTxDescriptorsDMA(USART_Type *base,
+                                               usart_dma_handle_t *handle,
+                                               dma_descriptor_t *descriptors,
+                                               size_t descriptorNum);
+
+/*!
+ * @brief Sends a list of buffers as one request with the DMA.
+ *
+ * The segments go out back to back without being copied, each one is a link descriptor of the
+ * same chain, so a frame is sent straight from its header, payload and CRC:
+ * @code
+ * DMA_ALLOCATE_LINK_DESCRIPTORS(s_txDescriptors, 12U);
+ *
+ * USART_TransferCreateHandleDMA(USART0, &usartHandle, callback, NULL, &txDmaHandle, NULL);
+ * USART_TransferInstallTxDescriptorsDMA(USART0, &usartHandle, s_txDescriptors, 12U);
+ *
+ * usart_transfer_t frame[3] = {
+ *     {.txData = header, .dataSize = sizeof(header)},
+ *     {.txData = payload, .dataSize = payloadSize},
+ *     {.txData = crc, .dataSize = sizeof(crc)},
+ * };
+ * USART_TransferSendVectorDMA(USART0, &usartHandle, frame, 3U);
+ * @endcode
+ *
+ * The function returns at once, the buffers must stay unchanged until the callback reported
+ * kStatus_USART_TxIdle for the request. The array of segments is not used after the call.
+ *
+ * Requests sent while the DMA is idle start at once. Requests sent while the DMA is busy wait in
+ * the handle and are linked into one descriptor chain that the DMA interrupt starts when the
+ * running chain is done, so the frames of a chain follow each other without a gap. Between two
+ * chains the USART still sends the byte in its shift register, the next chain starts in time
+ * unless the DMA interrupt is held off for more than a character.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @param vector Segments of the request, zero length segments are skipped.
+ * @param count Number of segments.
+ * @retval kStatus_Success The request was queued.
+ * @retval kStatus_InvalidArgument No data, or no descriptors were installed.
+ * @retval kStatus_USART_TxBusy The queue or the descriptor pool is full, send again after a callback.
+ */
+status_t USART_TransferSendVectorDMA(USART_Type *base,
+                                     usart_dma_handle_t *handle,
+                                     const usart_transfer_t *vector,
+                                     size_t count);
+
+/*!
+ * @brief Sends one buffer with the DMA.
+ *
+ * Same as USART_TransferSendVectorDMA with a single segment.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @param xfer USART DMA transfer structure, see #usart_transfer_t.
+ * @retval kStatus_Success The request was queued.
+ * @retval kStatus_InvalidArgument No data, or no descriptors were installed.
+ * @retval kStatus_USART_TxBusy The queue or the descriptor pool is full.
+ */
+status_t USART_TransferSendDMA(USART_Type *base, usart_dma_handle_t *handle, usart_transfer_t *xfer);
+
+/*!
+ * @brief Aborts the running and the queued transmit requests.
+ *
+ * No callback is invoked for the dropped requests.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ */
+void USART_TransferAbortSendDMA(USART_Type *base, usart_dma_handle_t *handle);
+
+/*!
+ * @brief Gets the transmit statistics.
+ *
+ * The throughput is the difference of two txBytes samples over the time between them, the CPU
+ * load of the transmit path is the time spent in the DMA interrupt over irqCount.
+ *
+ * @param base USART peripheral base address.
+ * @param handle Pointer to usart_dma_handle_t structure.
+ * @param stats Returns the statistics.
+ */
+void USART_TransferGetTxStatsDMA(USART_Type *base, usart_dma_handle_t *handle, usart_dma_tx_stats_t *stats);
+
+/*! @} */
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* FSL_USART_DMA_H_ */
@@ -0,0 +1,963 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* REG_EFL and REG_ERR of the signal context. */
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "fsl_hostsim.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.hostsim"
+#endif
+
+/*! @brief Host page size, register blocks are protected in whole pages. */
+#define HOSTSIM_PAGE_SIZE (0x1000U)
+
+/*! @brief Trap flag of the x86 EFLAGS register, single steps the faulting instruction. */
+#define HOSTSIM_EFLAGS_TF (0x100U)
+
+/*! @brief Write bit of the x86 page fault error code. */
+#define HOSTSIM_PF_WRITE (0x2U)
+
+/*! @brief Exception number of the first device interrupt. */
+#define HOSTSIM_IRQ_BASE (16U)
+
+/*! @brief Priority of thread mode, lower than any exception. */
+#define HOSTSIM_THREAD_PRIORITY (0x100U)
+
+/*! @brief Address range mapped into the host process. */
+typedef struct _hostsim_region
+{
+    uint32_t base; /*!< First address. */
+    uint32_t size; /*!< Size in bytes. */
+} hostsim_region_t;
+
+/*! @brief Register accesses of the instruction being single stepped. */
+typedef struct _hostsim_step
+{
+    hostsim_model_t *model[HOSTSIM_STEP_MAX_ACCESSES]; /*!< Model of each access. */
+    uint32_t offset[HOSTSIM_STEP_MAX_ACCESSES];        /*!< Word offset of each access. */
+    uint32_t oldValue[HOSTSIM_STEP_MAX_ACCESSES];      /*!< Word value before the access. */
+    bool write[HOSTSIM_STEP_MAX_ACCESSES];             /*!< Access is a write. */
+    uint32_t count;                                    /*!< Number of accesses. */
+    bool alarmBlocked;                                 /*!< Tick signal was blocked before the step. */
+} hostsim_step_t;
+
+typedef void (*hostsim_handler_t)(void);
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void HOSTSIM_DefaultHandler(void);
+
+/* Device vector table, the same weak handlers as startup_LPC845.S. */
+#define HOSTSIM_DEVICE_IRQS(X)                                                                                     \
+    X(SPI0)                                                                                                        \
+    X(SPI1) X(DAC0) X(USART0) X(USART1) X(USART2) X(Reserved22) X(I2C1) X(I2C0) X(SCT0) X(MRT0) X(CMP_CAPT) X(WDT) \
+        X(BOD) X(FLASH) X(WKT) X(ADC0_SEQA) X(ADC0_SEQB) X(ADC0_THCMP) X(ADC0_OVR) X(DMA0) X(I2C2) X(I2C3)         \
+            X(CTIMER0) X(PIN_INT0) X(PIN_INT1) X(PIN_INT2) X(PIN_INT3) X(PIN_INT4) X(PIN_INT5_DAC1)                \
+                X(PIN_INT6_USART3) X(PIN_INT7_USART4)
+
+#define HOSTSIM_DECLARE_IRQ(name)                                                                \
+    void name##_DriverIRQHandler(void) __attribute__((weak, alias("HOSTSIM_DefaultHandler"))); \
+    void name##_IRQHandler(void) __attribute__((weak));                                        \
+    void name##_IRQHandler(void)                                                               \
+    {                                                                                          \
+        name##_DriverIRQHandler();                                                             \
+    }
+
+HOSTSIM_DEVICE_IRQS(HOSTSIM_DECLARE_IRQ)
+
+void NMI_Handler(void) __attribute__((weak, alias("HOSTSIM_DefaultHandler")));
+void HardFault_Handler(void) __attribute__((weak, alias("HOSTSIM_DefaultHandler")));
+void SVC_Handler(void) __attribute__((weak, alias("HOSTSIM_DefaultHandler")));
+void PendSV_Handler(void) __attribute__((weak, alias("HOSTSIM_DefaultHandler")));
+void SysTick_Handler(void) __attribute__((weak, alias("HOSTSIM_DefaultHandler")));
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const hostsim_region_t s_regions[] = {
+    {0x40000000U, 0x00080000U}, /* APB peripherals */
+    {0x50000000U, 0x00014000U}, /* AHB peripherals and FAIM */
+    {0xA0000000U, 0x00008000U}, /* GPIO and PINT */
+    {0xE0000000U, 0x00100000U}, /* Private peripheral bus */
+};
+
+#define HOSTSIM_DEVICE_VECTOR(name) name##_IRQHandler,
+
+/* Initial vector table, named like the one of the startup code for SystemInit. */
+const hostsim_handler_t __Vectors[NUMBER_OF_INT_VECTORS] = {
+    NULL,
+    NULL,
+    NMI_Handler,
+    HardFault_Handler,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    SVC_Handler,
+    NULL,
+    NULL,
+    PendSV_Handler,
+    SysTick_Handler,
+    HOSTSIM_DEVICE_IRQS(HOSTSIM_DEVICE_VECTOR)};
+
+static hostsim_handler_t s_vectors[NUMBER_OF_INT_VECTORS];
+static uint32_t s_priority[NUMBER_OF_INT_VECTORS];
+
+/* Exception state, bit n is exception number n. */
+static volatile uint64_t s_enabled;
+static volatile uint64_t s_pending;
+static volatile uint64_t s_lines;
+static volatile uint32_t s_primask;
+static volatile uint32_t s_activeException;
+static volatile uint32_t s_activePriority = HOSTSIM_THREAD_PRIORITY;
+
+static hostsim_model_t *s_models;
+static hostsim_step_t s_step;
+static hostsim_stats_t s_stats;
+static bool s_running;
+static bool s_maskTiming;
+static uint64_t s_maskStart;
+
+static struct timespec s_startTime;
+static uint64_t s_sysTickCycles;
+static uint64_t s_dwtOffset;
+static hostsim_model_t s_dwtModel;
+
+static struct sigaction s_oldSegv;
+static struct sigaction s_oldTrap;
+static struct sigaction s_oldAlarm;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void HOSTSIM_DefaultHandler(void)
+{
+    static const char message[] = "hostsim: unhandled exception\n";
+
+    (void)write(STDERR_FILENO, message, sizeof(message) - 1U);
+    abort();
+}
+
+static hostsim_model_t *HOSTSIM_FindModel(uint32_t address)
+{
+    hostsim_model_t *model;
+
+    for (model = s_models; model != NULL; model = model->next)
+    {
+        if ((address - model->base) < model->size)
+        {
+            break;
+        }
+    }
+
+    return model;
+}
+
+static uint32_t HOSTSIM_PageSpan(const hostsim_model_t *model)
+{
+    return (((model->base & (HOSTSIM_PAGE_SIZE - 1U)) + model->size + HOSTSIM_PAGE_SIZE - 1U) &
+            ~(HOSTSIM_PAGE_SIZE - 1U));
+}
+
+static void HOSTSIM_Unlock(hostsim_model_t *model)
+{
+    if (model->unlockCount++ == 0U)
+    {
+        (void)mprotect((void *)(uintptr_t)(model->base & ~(HOSTSIM_PAGE_SIZE - 1U)), HOSTSIM_PageSpan(model),
+                       PROT_READ | PROT_WRITE);
+    }
+}
+
+static void HOSTSIM_Lock(hostsim_model_t *model)
+{
+    if (--model->unlockCount == 0U)
+    {
+        (void)mprotect((void *)(uintptr_t)(model->base & ~(HOSTSIM_PAGE_SIZE - 1U)), HOSTSIM_PageSpan(model),
+                       PROT_NONE);
+    }
+}
+
+static uint32_t HOSTSIM_ReadWord(const hostsim_model_t *model, uint32_t offset)
+{
+    return *(volatile uint32_t *)(uintptr_t)(model->base + offset);
+}
+
+/* Highest priority exception that may preempt the active one, 0 if none. */
+static uint32_t HOSTSIM_NextException(void)
+{
+    uint64_t ready = (s_pending | s_lines) & s_enabled;
+    uint32_t best  = 0U;
+    uint32_t bestPriority = s_activePriority;
+    uint32_t exception;
+
+    while (ready != 0U)
+    {
+        exception = (uint32_t)__builtin_ctzll(ready);
+        ready &= ready - 1U;
+
+        if (s_priority[exception] < bestPriority)
+        {
+            best         = exception;
+            bestPriority = s_priority[exception];
+        }
+    }
+
+    return best;
+}
+
+/* Takes pending exceptions, the caller holds off the tick signal. */
+static void HOSTSIM_Dispatch(void)
+{
+    uint32_t savedException = s_activeException;
+    uint32_t savedPriority  = s_activePriority;
+    uint32_t exception;
+
+    while ((s_primask == 0U) && ((exception = HOSTSIM_NextException()) != 0U))
+    {
+        (void)__atomic_fetch_and(&s_pending, ~(1ULL << exception), __ATOMIC_SEQ_CST);
+
+        s_activeException = exception;
+        s_activePriority  = s_priority[exception];
+        s_stats.irqCount++;
+
+        s_vectors[exception]();
+
+        s_activeException = savedException;
+        s_activePriority  = savedPriority;
+    }
+}
+
+static void HOSTSIM_DispatchFromThread(void)
+{
+    sigset_t alarm;
+    sigset_t old;
+
+    /*
+     * Enabling interrupts costs a cycle on the core, skip the signal mask calls when nothing is
+     * pending. A tick arriving after the check dispatches by itself.
+     */
+    if ((!s_running) || (((s_pending | s_lines) & s_enabled) == 0U))
+    {
+        return;
+    }
+
+    (void)sigemptyset(&alarm);
+    (void)sigaddset(&alarm, SIGALRM);
+    (void)pthread_sigmask(SIG_BLOCK, &alarm, &old);
+    HOSTSIM_Dispatch();
+    (void)pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+static void HOSTSIM_SysTickUpdate(uint64_t cycles)
+{
+    uint32_t reload = (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) + 1U;
+    uint64_t elapsed;
+
+    if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == 0U)
+    {
+        s_sysTickCycles = cycles;
+        return;
+    }
+
+    elapsed = cycles - s_sysTickCycles;
+    if (elapsed >= reload)
+    {
+        s_sysTickCycles += (elapsed / reload) * reload;
+        SysTick->CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+        if ((SysTick->CTRL & SysTick_CTRL_TICKINT_Msk) != 0U)
+        {
+            HOSTSIM_PendIRQ(SysTick_IRQn);
+        }
+    }
+    SysTick->VAL = reload - 1U - (uint32_t)(cycles - s_sysTickCycles);
+}
+
+static void HOSTSIM_RunTicks(void)
+{
+    uint64_t cycles = HOSTSIM_GetCycles();
+    hostsim_model_t *model;
+
+    s_stats.tickCount++;
+
+    for (model = s_models; model != NULL; model = model->next)
+    {
+        if (model->tick != NULL)
+        {
+            HOSTSIM_Unlock(model);
+            model->tick(model, cycles);
+            HOSTSIM_Lock(model);
+        }
+    }
+
+    HOSTSIM_SysTickUpdate(cycles);
+}
+
+/* SIGSEGV: a locked register block was accessed, unlock it and single step the instruction. */
+static void HOSTSIM_FaultHandler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc         = (ucontext_t *)context;
+    uint32_t address       = (uint32_t)(uintptr_t)info->si_addr;
+    hostsim_model_t *model = NULL;
+    uint32_t index         = s_step.count;
+    uint32_t offset;
+
+    if (((uintptr_t)info->si_addr <= UINT32_MAX) && (index < HOSTSIM_STEP_MAX_ACCESSES))
+    {
+        model = HOSTSIM_FindModel(address);
+    }
+
+    if ((model == NULL) || (model->unlockCount != 0U))
+    {
+        /* Not a register access, let the fault kill the process as usual. */
+        (void)sigaction(sig, &s_oldSegv, NULL);
+        return;
+    }
+
+    if (index == 0U)
+    {
+        /* No tick while the register block is unlocked. */
+        s_step.alarmBlocked = (sigismember(&uc->uc_sigmask, SIGALRM) == 1);
+        (void)sigaddset(&uc->uc_sigmask, SIGALRM);
+    }
+
+    offset = (address - model->base) & ~3U;
+    HOSTSIM_Unlock(model);
+
+    s_step.model[index]  = model;
+    s_step.offset[index] = offset;
+    s_step.write[index]  = ((uc->uc_mcontext.gregs[REG_ERR] & HOSTSIM_PF_WRITE) != 0);
+    if ((!s_step.write[index]) && (model->access != NULL))
+    {
+        model->access(model, offset, kHOSTSIM_AccessPrepareRead, HOSTSIM_ReadWord(model, offset));
+    }
+    s_step.oldValue[index] = HOSTSIM_ReadWord(model, offset);
+    s_step.count           = index + 1U;
+    s_stats.trapCount++;
+
+    uc->uc_mcontext.gregs[REG_EFL] |= HOSTSIM_EFLAGS_TF;
+}
+
+/* SIGTRAP: the instruction completed, run the model hooks and lock the registers again. */
+static void HOSTSIM_TrapHandler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+    hostsim_model_t *model;
+    uint32_t i;
+
+    (void)info;
+
+    if (s_step.count == 0U)
+    {
+        (void)sigaction(sig, &s_oldTrap, NULL);
+        (void)raise(sig);
+        return;
+    }
+
+    uc->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)HOSTSIM_EFLAGS_TF;
+
+    for (i = 0U; i < s_step.count; i++)
+    {
+        model = s_step.model[i];
+        if (model->access != NULL)
+        {
+            model->access(model, s_step.offset[i], s_step.write[i] ? kHOSTSIM_AccessWrite : kHOSTSIM_AccessRead,
+                          s_step.write[i] ? s_step.oldValue[i] : HOSTSIM_ReadWord(model, s_step.offset[i]));
+        }
+    }
+
+    for (i = 0U; i < s_step.count; i++)
+    {
+        HOSTSIM_Lock(s_step.model[i]);
+    }
+    s_step.count = 0U;
+
+    if (!s_step.alarmBlocked)
+    {
+        (void)sigdelset(&uc->uc_sigmask, SIGALRM);
+    }
+
+    /* An access may have raised an interrupt, take it right after the instruction. */
+    HOSTSIM_Dispatch();
+}
+
+/* SIGALRM: simulation tick. */
+static void HOSTSIM_TickHandler(int sig)
+{
+    (void)sig;
+
+    HOSTSIM_RunTicks();
+    HOSTSIM_Dispatch();
+}
+
+static void HOSTSIM_DwtAccess(hostsim_model_t *model, uint32_t offset, hostsim_access_t access, uint32_t oldValue)
+{
+    (void)model;
+    (void)oldValue;
+
+    if (offset == offsetof(DWT_Type, CYCCNT))
+    {
+        if (access == kHOSTSIM_AccessPrepareRead)
+        {
+            if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0U)
+            {
+                DWT->CYCCNT = (uint32_t)(HOSTSIM_GetCycles() - s_dwtOffset);
+            }
+        }
+        else if (access == kHOSTSIM_AccessWrite)
+        {
+            s_dwtOffset = HOSTSIM_GetCycles() - DWT->CYCCNT;
+        }
+        else
+        {
+            /* Nothing to do after a read. */
+        }
+    }
+}
+
+status_t HOSTSIM_Init(void)
+{
+    struct sigaction action;
+    struct itimerval timer;
+    uint32_t i;
+    void *mapped;
+
+    assert(!s_running);
+
+    for (i = 0U; i < ARRAY_SIZE(s_regions); i++)
+    {
+        mapped = mmap((void *)(uintptr_t)s_regions[i].base, s_regions[i].size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (mapped != (void *)(uintptr_t)s_regions[i].base)
+        {
+            if (mapped != MAP_FAILED)
+            {
+                (void)munmap(mapped, s_regions[i].size);
+            }
+            while (i-- > 0U)
+            {
+                (void)munmap((void *)(uintptr_t)s_regions[i].base, s_regions[i].size);
+            }
+            return kStatus_Fail;
+        }
+    }
+
+    /* Reset values the clock driver depends on: 24 MHz FRO divided by 2, PLL locked. */
+    SYSCON->FROOSCCTRL   = 1U;
+    SYSCON->SYSAHBCLKDIV = 1U;
+    *(volatile uint32_t *)(uintptr_t)&SYSCON->SYSPLLSTAT = SYSCON_SYSPLLSTAT_LOCK_MASK;
+    SystemCoreClockUpdate();
+
+    (void)memcpy(s_vectors, __Vectors, sizeof(s_vectors));
+    (void)memset(s_priority, 0, sizeof(s_priority));
+    s_enabled         = (1ULL << HOSTSIM_IRQ_BASE) - 1U;
+    s_pending         = 0U;
+    s_lines           = 0U;
+    s_primask         = 0U;
+    s_activeException = 0U;
+    s_activePriority  = HOSTSIM_THREAD_PRIORITY;
+    s_models          = NULL;
+    (void)memset(&s_step, 0, sizeof(s_step));
+    (void)memset(&s_stats, 0, sizeof(s_stats));
+    s_maskTiming = false;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &s_startTime);
+    s_sysTickCycles = 0U;
+    s_dwtOffset     = 0U;
+
+    (void)memset(&action, 0, sizeof(action));
+    action.sa_sigaction = HOSTSIM_FaultHandler;
+    action.sa_flags     = SA_SIGINFO | SA_NODEFER;
+    /* No tick inside the handlers, it would see the lock count and page rights out of step. */
+    (void)sigemptyset(&action.sa_mask);
+    (void)sigaddset(&action.sa_mask, SIGALRM);
+    (void)sigaction(SIGSEGV, &action, &s_oldSegv);
+
+    action.sa_sigaction = HOSTSIM_TrapHandler;
+    (void)sigaction(SIGTRAP, &action, &s_oldTrap);
+
+    (void)memset(&action, 0, sizeof(action));
+    action.sa_handler = HOSTSIM_TickHandler;
+    action.sa_flags   = SA_RESTART;
+    (void)sigemptyset(&action.sa_mask);
+    (void)sigaction(SIGALRM, &action, &s_oldAlarm);
+
+    (void)memset(&s_dwtModel, 0, sizeof(s_dwtModel));
+    s_dwtModel.base   = DWT_BASE;
+    s_dwtModel.size   = sizeof(DWT_Type);
+    s_dwtModel.access = HOSTSIM_DwtAccess;
+    HOSTSIM_AttachModel(&s_dwtModel);
+
+    s_running = true;
+
+    timer.it_interval.tv_sec  = 0;
+    timer.it_interval.tv_usec = HOSTSIM_TICK_US;
+    timer.it_value            = timer.it_interval;
+    (void)setitimer(ITIMER_REAL, &timer, NULL);
+
+    return kStatus_Success;
+}
+
+void HOSTSIM_Deinit(void)
+{
+    struct itimerval timer;
+    uint32_t i;
+
+    if (!s_running)
+    {
+        return;
+    }
+
+    (void)memset(&timer, 0, sizeof(timer));
+    (void)setitimer(ITIMER_REAL, &timer, NULL);
+
+    s_running = false;
+    s_models  = NULL;
+
+    (void)sigaction(SIGALRM, &s_oldAlarm, NULL);
+    (void)sigaction(SIGTRAP, &s_oldTrap, NULL);
+    (void)sigaction(SIGSEGV, &s_oldSegv, NULL);
+
+    for (i = 0U; i < ARRAY_SIZE(s_regions); i++)
+    {
+        (void)munmap((void *)(uintptr_t)s_regions[i].base, s_regions[i].size);
+    }
+}
+
+void HOSTSIM_AttachModel(hostsim_model_t *model)
+{
+    sigset_t alarm;
+    sigset_t old;
+
+    assert(model != NULL);
+    assert(model->size != 0U);
+    assert(HOSTSIM_FindModel(model->base) == NULL);
+
+    (void)sigemptyset(&alarm);
+    (void)sigaddset(&alarm, SIGALRM);
+    (void)pthread_sigmask(SIG_BLOCK, &alarm, &old);
+
+    model->unlockCount = 1U;
+    model->next        = s_models;
+    s_models           = model;
+    HOSTSIM_Lock(model);
+
+    (void)pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+void HOSTSIM_DetachModel(hostsim_model_t *model)
+{
+    hostsim_model_t **link;
+    sigset_t alarm;
+    sigset_t old;
+
+    assert(model != NULL);
+
+    (void)sigemptyset(&alarm);
+    (void)sigaddset(&alarm, SIGALRM);
+    (void)pthread_sigmask(SIG_BLOCK, &alarm, &old);
+
+    for (link = &s_models; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == model)
+        {
+            *link = model->next;
+            HOSTSIM_Unlock(model);
+            break;
+        }
+    }
+
+    (void)pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+uint32_t HOSTSIM_EnterModel(hostsim_model_t *model)
+{
+    sigset_t alarm;
+    sigset_t old;
+
+    (void)sigemptyset(&alarm);
+    (void)sigaddset(&alarm, SIGALRM);
+    (void)pthread_sigmask(SIG_BLOCK, &alarm, &old);
+
+    HOSTSIM_Unlock(model);
+
+    return (sigismember(&old, SIGALRM) == 1) ? 1U : 0U;
+}
+
+void HOSTSIM_ExitModel(hostsim_model_t *model, uint32_t state)
+{
+    sigset_t alarm;
+
+    HOSTSIM_Lock(model);
+
+    if (state == 0U)
+    {
+        HOSTSIM_Dispatch();
+
+        (void)sigemptyset(&alarm);
+        (void)sigaddset(&alarm, SIGALRM);
+        (void)pthread_sigmask(SIG_UNBLOCK, &alarm, NULL);
+    }
+}
+
+void HOSTSIM_Poll(void)
+{
+    sigset_t alarm;
+    sigset_t old;
+
+    (void)sigemptyset(&alarm);
+    (void)sigaddset(&alarm, SIGALRM);
+    (void)pthread_sigmask(SIG_BLOCK, &alarm, &old);
+
+    HOSTSIM_RunTicks();
+    HOSTSIM_Dispatch();
+
+    (void)pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+static uint64_t HOSTSIM_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)(now.tv_sec - s_startTime.tv_sec) * 1000000000U) + (uint64_t)now.tv_nsec -
+           (uint64_t)s_startTime.tv_nsec;
+}
+
+uint64_t HOSTSIM_GetCycles(void)
+{
+    uint64_t ns = HOSTSIM_GetNs();
+
+    return (uint64_t)(((unsigned __int128)ns * SystemCoreClock) / 1000000000U);
+}
+
+void HOSTSIM_GetStats(hostsim_stats_t *stats)
+{
+    assert(stats != NULL);
+
+    *stats = s_stats;
+}
+
+void HOSTSIM_SetMaskTiming(bool enable)
+{
+    s_maskTiming = enable;
+    s_maskStart  = HOSTSIM_GetNs();
+    if (enable)
+    {
+        s_stats.maskedMaxNs = 0U;
+    }
+}
+
+void HOSTSIM_SetIRQLine(IRQn_Type irq, bool asserted)
+{
+    uint64_t mask = 1ULL << ((uint32_t)((int32_t)irq + (int32_t)HOSTSIM_IRQ_BASE));
+
+    if (asserted)
+    {
+        (void)__atomic_fetch_or(&s_lines, mask, __ATOMIC_SEQ_CST);
+    }
+    else
+    {
+        (void)__atomic_fetch_and(&s_lines, ~mask, __ATOMIC_SEQ_CST);
+    }
+}
+
+void HOSTSIM_PendIRQ(IRQn_Type irq)
+{
+    (void)__atomic_fetch_or(&s_pending, 1ULL << ((uint32_t)((int32_t)irq + (int32_t)HOSTSIM_IRQ_BASE)),
+                            __ATOMIC_SEQ_CST);
+}
+
+static uint32_t HOSTSIM_LoadWidth(uint32_t address, uint32_t width)
+{
+    uint32_t value;
+
+    if (width == 1U)
+    {
+        value = *(volatile uint8_t *)(uintptr_t)address;
+    }
+    else if (width == 2U)
+    {
+        value = *(volatile uint16_t *)(uintptr_t)address;
+    }
+    else
+    {
+        value = *(volatile uint32_t *)(uintptr_t)address;
+    }
+
+    return value;
+}
+
+static void HOSTSIM_StoreWidth(uint32_t address, uint32_t width, uint32_t value)
+{
+    if (width == 1U)
+    {
+        *(volatile uint8_t *)(uintptr_t)address = (uint8_t)value;
+    }
+    else if (width == 2U)
+    {
+        *(volatile uint16_t *)(uintptr_t)address = (uint16_t)value;
+    }
+    else
+    {
+        *(volatile uint32_t *)(uintptr_t)address = value;
+    }
+}
+
+uint32_t HOSTSIM_BusRead(uint32_t address, uint32_t width)
+{
+    hostsim_model_t *model = HOSTSIM_FindModel(address);
+    uint32_t offset;
+    uint32_t value;
+
+    if (model == NULL)
+    {
+        return HOSTSIM_LoadWidth(address, width);
+    }
+
+    offset = (address - model->base) & ~3U;
+    HOSTSIM_Unlock(model);
+    if (model->access != NULL)
+    {
+        model->access(model, offset, kHOSTSIM_AccessPrepareRead, HOSTSIM_ReadWord(model, offset));
+    }
+    value = HOSTSIM_LoadWidth(address, width);
+    if (model->access != NULL)
+    {
+        model->access(model, offset, kHOSTSIM_AccessRead, HOSTSIM_ReadWord(model, offset));
+    }
+    HOSTSIM_Lock(model);
+
+    return value;
+}
+
+void HOSTSIM_BusWrite(uint32_t address, uint32_t width, uint32_t value)
+{
+    hostsim_model_t *model = HOSTSIM_FindModel(address);
+    uint32_t offset;
+    uint32_t oldValue;
+
+    if (model == NULL)
+    {
+        HOSTSIM_StoreWidth(address, width, value);
+        return;
+    }
+
+    offset = (address - model->base) & ~3U;
+    HOSTSIM_Unlock(model);
+    oldValue = HOSTSIM_ReadWord(model, offset);
+    HOSTSIM_StoreWidth(address, width, value);
+    if (model->access != NULL)
+    {
+        model->access(model, offset, kHOSTSIM_AccessWrite, oldValue);
+    }
+    HOSTSIM_Lock(model);
+}
+
+bool HOSTSIM_GetDmaRequest(uint32_t base, uint32_t request)
+{
+    hostsim_model_t *model = HOSTSIM_FindModel(base);
+    bool active            = true;
+
+    if ((model != NULL) && (model->dmaRequest != NULL))
+    {
+        HOSTSIM_Unlock(model);
+        active = model->dmaRequest(model, request);
+        HOSTSIM_Lock(model);
+    }
+
+    return active;
+}
+
+/*******************************************************************************
+ * Core registers
+ ******************************************************************************/
+
+static void HOSTSIM_MaskBegin(void)
+{
+    if (s_maskTiming && (s_primask == 0U))
+    {
+        s_maskStart = HOSTSIM_GetNs();
+    }
+}
+
+static void HOSTSIM_MaskEnd(void)
+{
+    uint64_t ns;
+
+    if (s_maskTiming && (s_primask != 0U))
+    {
+        ns = HOSTSIM_GetNs() - s_maskStart;
+        s_stats.maskedCount++;
+        s_stats.maskedNs += ns;
+        if (ns > s_stats.maskedMaxNs)
+        {
+            s_stats.maskedMaxNs = (uint32_t)ns;
+        }
+    }
+}
+
+void HOSTSIM_EnableIRQ(void)
+{
+    HOSTSIM_MaskEnd();
+    s_primask = 0U;
+    HOSTSIM_DispatchFromThread();
+}
+
+void HOSTSIM_DisableIRQ(void)
+{
+    HOSTSIM_MaskBegin();
+    s_primask = 1U;
+}
+
+uint32_t HOSTSIM_GetPRIMASK(void)
+{
+    return s_primask;
+}
+
+void HOSTSIM_SetPRIMASK(uint32_t priMask)
+{
+    if ((priMask & 1U) != 0U)
+    {
+        HOSTSIM_MaskBegin();
+    }
+    else
+    {
+        HOSTSIM_MaskEnd();
+    }
+    s_primask = priMask & 1U;
+    if (s_primask == 0U)
+    {
+        HOSTSIM_DispatchFromThread();
+    }
+}
+
+uint32_t HOSTSIM_GetIPSR(void)
+{
+    return s_activeException;
+}
+
+void HOSTSIM_WaitForInterrupt(void)
+{
+    sigset_t alarm;
+    sigset_t old;
+    sigset_t wait;
+
+    (void)sigemptyset(&alarm);
+    (void)sigaddset(&alarm, SIGALRM);
+    (void)pthread_sigmask(SIG_BLOCK, &alarm, &old);
+
+    /* Like the core, wake up on a pending interrupt even with PRIMASK set. */
+    if (s_running && (((s_pending | s_lines) & s_enabled) == 0U))
+    {
+        wait = old;
+        (void)sigdelset(&wait, SIGALRM);
+        (void)sigsuspend(&wait);
+    }
+
+    HOSTSIM_Dispatch();
+    (void)pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+/*******************************************************************************
+ * NVIC
+ ******************************************************************************/
+
+void HOSTSIM_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        (void)__atomic_fetch_or(&s_enabled, 1ULL << ((uint32_t)IRQn + HOSTSIM_IRQ_BASE), __ATOMIC_SEQ_CST);
+        HOSTSIM_DispatchFromThread();
+    }
+}
+
+uint32_t HOSTSIM_NVIC_GetEnableIRQ(IRQn_Type IRQn)
+{
+    return ((int32_t)IRQn >= 0) ? (uint32_t)((s_enabled >> ((uint32_t)IRQn + HOSTSIM_IRQ_BASE)) & 1U) : 0U;
+}
+
+void HOSTSIM_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        (void)__atomic_fetch_and(&s_enabled, ~(1ULL << ((uint32_t)IRQn + HOSTSIM_IRQ_BASE)), __ATOMIC_SEQ_CST);
+    }
+}
+
+uint32_t HOSTSIM_NVIC_GetPendingIRQ(IRQn_Type IRQn)
+{
+    return ((int32_t)IRQn >= 0) ?
+               (uint32_t)(((s_pending | s_lines) >> ((uint32_t)IRQn + HOSTSIM_IRQ_BASE)) & 1U) :
+               0U;
+}
+
+void HOSTSIM_NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        HOSTSIM_PendIRQ(IRQn);
+        HOSTSIM_DispatchFromThread();
+    }
+}
+
+void HOSTSIM_NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    if ((int32_t)IRQn >= 0)
+    {
+        (void)__atomic_fetch_and(&s_pending, ~(1ULL << ((uint32_t)IRQn + HOSTSIM_IRQ_BASE)), __ATOMIC_SEQ_CST);
+    }
+}
+
+void HOSTSIM_NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+    s_priority[(uint32_t)((int32_t)IRQn + (int32_t)HOSTSIM_IRQ_BASE)] =
+        priority & ((1UL << __NVIC_PRIO_BITS) - 1UL);
+}
+
+uint32_t HOSTSIM_NVIC_GetPriority(IRQn_Type IRQn)
+{
+    return s_priority[(uint32_t)((int32_t)IRQn + (int32_t)HOSTSIM_IRQ_BASE)];
+}
+
+void HOSTSIM_NVIC_SystemReset(void)
+{
+    static const char message[] = "hostsim: system reset\n";
+
+    (void)write(STDERR_FILENO, message, sizeof(message) - 1U);
+    exit(EXIT_SUCCESS);
+}
+
+void HOSTSIM_NVIC_SetVector(IRQn_Type IRQn, uint32_t vector)
+{
+    s_vectors[(uint32_t)((int32_t)IRQn + (int32_t)HOSTSIM_IRQ_BASE)] = (hostsim_handler_t)(uintptr_t)vector;
+}
+
+uint32_t HOSTSIM_NVIC_GetVector(IRQn_Type IRQn)
+{
+    return (uint32_t)(uintptr_t)s_vectors[(uint32_t)((int32_t)IRQn + (int32_t)HOSTSIM_IRQ_BASE)];
+}
@@ -0,0 +1,1977 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <sys/mman.h>
+
+#include "fsl_hostsim_models.h"
+#include "fsl_capt.h"
+#include "fsl_dma.h"
+#include "fsl_i2c.h"
+#include "fsl_iap.h"
+#include "fsl_pint.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.hostsim_models"
+#endif
+
+/*! @brief Register offset of a member of a register block. */
+#define HOSTSIM_OFFSET(type, member) ((uint32_t)offsetof(type, member))
+
+/*! @brief USART status flags cleared by writing 1. */
+#define HOSTSIM_USART_STAT_W1C                                                                               \
+    (USART_STAT_DELTACTS_MASK | USART_STAT_OVERRUNINT_MASK | USART_STAT_DELTARXBRK_MASK | USART_STAT_START_MASK | \
+     USART_STAT_FRAMERRINT_MASK | USART_STAT_PARITYERRINT_MASK | USART_STAT_RXNOISEINT_MASK | USART_STAT_ABERR_MASK)
+
+/*! @brief SPI status flags cleared by writing 1. */
+#define HOSTSIM_SPI_STAT_W1C \
+    (SPI_STAT_RXOV_MASK | SPI_STAT_TXUR_MASK | SPI_STAT_SSA_MASK | SPI_STAT_SSD_MASK | SPI_STAT_ENDTRANSFER_MASK)
+
+/*! @brief I2C master status flags cleared by writing 1. */
+#define HOSTSIM_I2C_STAT_W1C (I2C_STAT_MSTARBLOSS_MASK | I2C_STAT_MSTSTSTPERR_MASK)
+
+/*! @brief Mid scale result of the 12-bit ADC. */
+#define HOSTSIM_ADC_MID_SCALE (0x800U)
+
+/*! @brief Number of PINT inputs, bit slices and interrupts. */
+#define HOSTSIM_PINT_CHANNELS (8U)
+
+/*! @brief Number of GPIO ports and pins per port. */
+#define HOSTSIM_GPIO_PORTS (2U)
+#define HOSTSIM_GPIO_PINS  (32U)
+
+/*! @brief CAPT status flags cleared by writing 1. */
+#define HOSTSIM_CAPT_STATUS_W1C                                                                      \
+    (CAPT_STATUS_YESTOUCH_MASK | CAPT_STATUS_NOTOUCH_MASK | CAPT_STATUS_POLLDONE_MASK | CAPT_STATUS_TIMEOUT_MASK | \
+     CAPT_STATUS_OVERUN_MASK)
+
+/*! @brief Highest X pin of the CAPT, X0 to X8 on the LPC845. */
+#define HOSTSIM_CAPT_XMAX (8U)
+
+/*! @brief Count of an untouched X pin when the CAPT model has no sample source. */
+#define HOSTSIM_CAPT_NO_TOUCH_COUNT (1000U)
+
+/*! @brief Page holding the IAP ROM entry. */
+#define HOSTSIM_IAP_ENTRY_PAGE ((uint32_t)FSL_FEATURE_SYSCON_IAP_ENTRY_LOCATION & ~0xFFFU)
+#define HOSTSIM_IAP_ENTRY_SIZE (0x1000U)
+
+/*! @brief Flash geometry of the IAP model. */
+#define HOSTSIM_IAP_PAGE_SIZE    ((uint32_t)FSL_FEATURE_SYSCON_FLASH_PAGE_SIZE_BYTES)
+#define HOSTSIM_IAP_SECTOR_SIZE  ((uint32_t)FSL_FEATURE_SYSCON_FLASH_SECTOR_SIZE_BYTES)
+#define HOSTSIM_IAP_SECTORS      ((uint32_t)FSL_FEATURE_SYSCON_FLASH_SIZE_BYTES / HOSTSIM_IAP_SECTOR_SIZE)
+#define HOSTSIM_IAP_SECTOR_PAGES (HOSTSIM_IAP_SECTOR_SIZE / HOSTSIM_IAP_PAGE_SIZE)
+
+/*! @brief IAP ROM return codes, see the IAP driver status codes. */
+enum
+{
+    kHOSTSIM_IapSuccess        = 0U,
+    kHOSTSIM_IapInvalidCommand = 1U,
+    kHOSTSIM_IapSrcAddrError   = 2U,
+    kHOSTSIM_IapDstAddrError   = 3U,
+    kHOSTSIM_IapDstNotMapped   = 5U,
+    kHOSTSIM_IapCountError     = 6U,
+    kHOSTSIM_IapInvalidSector  = 7U,
+    kHOSTSIM_IapSectorNotBlank = 8U,
+    kHOSTSIM_IapNotPrepared    = 9U,
+    kHOSTSIM_IapCompareError   = 10U,
+    kHOSTSIM_IapBusy           = 11U,
+};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void HOSTSIM_DmaRun(hostsim_dma_model_t *dma);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Model called by the ROM entry. */
+static hostsim_iap_model_t *s_iapModel;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* Interrupt status of the USART, SPI, I2C and CAPT, INTSTAT has the bit layout of STAT. */
+static void HOSTSIM_UpdateIRQ(volatile uint32_t *intstat, uint32_t stat, uint32_t inten, IRQn_Type irq)
+{
+    *intstat = stat & inten;
+    HOSTSIM_SetIRQLine(irq, *intstat != 0U);
+}
+
+/*******************************************************************************
+ * USART
+ ******************************************************************************/
+
+static void HOSTSIM_UsartLoadRx(hostsim_usart_model_t *usart)
+{
+    USART_Type *base = (USART_Type *)(uintptr_t)usart->model.base;
+    uint16_t data;
+
+    if (((base->STAT & USART_STAT_RXRDY_MASK) == 0U) && HOSTSIM_FifoPop(usart->rxFifo, &data))
+    {
+        *(volatile uint32_t *)&base->RXDAT     = data;
+        *(volatile uint32_t *)&base->RXDATSTAT = data;
+        base->STAT |= USART_STAT_RXRDY_MASK;
+    }
+}
+
+static void HOSTSIM_UsartUpdate(hostsim_usart_model_t *usart)
+{
+    USART_Type *base = (USART_Type *)(uintptr_t)usart->model.base;
+
+    HOSTSIM_UsartLoadRx(usart);
+
+    if (HOSTSIM_FifoCount(usart->txFifo) < usart->txFifo->size)
+    {
+        base->STAT |= USART_STAT_TXRDY_MASK | USART_STAT_TXIDLE_MASK;
+    }
+
+    HOSTSIM_UpdateIRQ((volatile uint32_t *)&base->INTSTAT, base->STAT, base->INTENSET, usart->irq);
+}
+
+static void HOSTSIM_UsartAccess(hostsim_model_t *model, uint32_t offset, hostsim_access_t access, uint32_t oldValue)
+{
+    hostsim_usart_model_t *usart = (hostsim_usart_model_t *)model;
+    USART_Type *base             = (USART_Type *)(uintptr_t)model->base;
+    uint32_t value;
+
+    if (access == kHOSTSIM_AccessPrepareRead)
+    {
+        return;
+    }
+
+    if (access == kHOSTSIM_AccessRead)
+    {
+        if ((offset == HOSTSIM_OFFSET(USART_Type, RXDAT)) || (offset == HOSTSIM_OFFSET(USART_Type, RXDATSTAT)))
+        {
+            base->STAT &= ~USART_STAT_RXRDY_MASK;
+        }
+    }
+    else
+    {
+        value = *(volatile uint32_t *)(uintptr_t)(model->base + offset);
+
+        switch (offset)
+        {
+            case HOSTSIM_OFFSET(USART_Type, STAT):
+                base->STAT = oldValue & ~(value & HOSTSIM_USART_STAT_W1C);
+                break;
+
+            case HOSTSIM_OFFSET(USART_Type, INTENSET):
+                base->INTENSET = oldValue | value;
+                break;
+
+            case HOSTSIM_OFFSET(USART_Type, INTENCLR):
+                base->INTENSET &= ~value;
+                base->INTENCLR = 0U;
+                break;
+
+            case HOSTSIM_OFFSET(USART_Type, TXDAT):
+                if ((base->CFG & USART_CFG_LOOP_MASK) != 0U)
+                {
+                    (void)HOSTSIM_FifoPush(usart->rxFifo, (uint16_t)value);
+                }
+                else
+                {
+                    (void)HOSTSIM_FifoPush(usart->txFifo, (uint16_t)value);
+                    if (HOSTSIM_FifoCount(usart->txFifo) == usart->txFifo->size)
+                    {
+                        base->STAT &= ~(USART_STAT_TXRDY_MASK | USART_STAT_TXIDLE_MASK);
+                    }
+                }
+                break;
+
+            case HOSTSIM_OFFSET(USART_Type, RXDAT):
+            case HOSTSIM_OFFSET(USART_Type, RXDATSTAT):
+            case HOSTSIM_OFFSET(USART_Type, INTSTAT):
+                *(volatile uint32_t *)(uintptr_t)(model->base + offset) = oldValue;
+                break;
+
+            default:
+                /* Plain register. */
+                break;
+        }
+    }
+
+    HOSTSIM_UsartUpdate(usart);
+}
+
+static void HOSTSIM_UsartTick(hostsim_model_t *model, uint64_t cycles)
+{
+    (void)cycles;
+
+    HOSTSIM_UsartUpdate((hostsim_usart_model_t *)model);
+}
+
+static bool HOSTSIM_UsartDmaRequest(hostsim_model_t *model, uint32_t request)
+{
+    USART_Type *base = (USART_Type *)(uintptr_t)model->base;
+
+    return (base->STAT & ((request == (uint32_t)kHOSTSIM_DmaRequestRx) ? USART_STAT_RXRDY_MASK :
+                                                                          USART_STAT_TXRDY_MASK)) != 0U;
+}
+
+void HOSTSIM_UsartModelInit(hostsim_usart_model_t *usart,
+                            USART_Type *base,
+                            IRQn_Type irq,
+                            hostsim_fifo_t *txFifo,
+                            hostsim_fifo_t *rxFifo)
+{
+    assert(usart != NULL);
+    assert(txFifo != NULL);
+    assert(rxFifo != NULL);
+
+    (void)memset(usart, 0, sizeof(*usart));
+    usart->model.base       = (uint32_t)(uintptr_t)base;
+    usart->model.size       = sizeof(USART_Type);
+    usart->model.access     = HOSTSIM_UsartAccess;
+    usart->model.tick       = HOSTSIM_UsartTick;
+    usart->model.dmaRequest = HOSTSIM_UsartDmaRequest;
+    usart->irq              = irq;
+    usart->txFifo           = txFifo;
+    usart->rxFifo           = rxFifo;
+
+    (void)memset((void *)base, 0, sizeof(USART_Type));
+    base->STAT = USART_STAT_TXRDY_MASK | USART_STAT_TXIDLE_MASK | USART_STAT_RXIDLE_MASK;
+
+    HOSTSIM_AttachModel(&usart->model);
+}
+
+size_t HOSTSIM_UsartModelReceive(hostsim_usart_model_t *usart, const uint8_t *data, size_t length)
+{
+    size_t count;
+    uint32_t state;
+
+    assert(usart != NULL);
+    assert((data != NULL) || (length == 0U));
+
+    for (count = 0U; count < length; count++)
+    {
+        if (!HOSTSIM_FifoPush(usart->rxFifo, data[count]))
+        {
+            break;
+        }
+    }
+
+    state = HOSTSIM_EnterModel(&usart->model);
+    HOSTSIM_UsartUpdate(usart);
+    HOSTSIM_ExitModel(&usart->model, state);
+
+    return count;
+}
+
+/*******************************************************************************
+ * SPI
+ ******************************************************************************/
+
+static void HOSTSIM_SpiTransmit(hostsim_spi_model_t *spi, uint32_t data, uint32_t control)
+{
+    SPI_Type *base = (SPI_Type *)(uintptr_t)spi->model.base;
+    uint32_t width = ((control & SPI_TXDATCTL_LEN_MASK) >> SPI_TXDATCTL_LEN_SHIFT) + 1U;
+    uint32_t mask  = (1UL << width) - 1UL;
+    bool eot       = ((control & SPI_TXDATCTL_EOT_MASK) != 0U);
+    uint32_t miso;
+
+    if ((base->CFG & (SPI_CFG_ENABLE_MASK | SPI_CFG_MASTER_MASK)) != (SPI_CFG_ENABLE_MASK | SPI_CFG_MASTER_MASK))
+    {
+        return;
+    }
+
+    if ((base->CFG & SPI_CFG_LOOP_MASK) != 0U)
+    {
+        miso = data;
+    }
+    else if (spi->slave != NULL)
+    {
+        miso = spi->slave(spi->userData, (uint16_t)(data & mask), eot);
+    }
+    else
+    {
+        miso = 0xFFFFU;
+    }
+
+    if ((control & SPI_TXDATCTL_RXIGNORE_MASK) == 0U)
+    {
+        if ((base->STAT & SPI_STAT_RXRDY_MASK) != 0U)
+        {
+            base->STAT |= SPI_STAT_RXOV_MASK;
+        }
+        *(volatile uint32_t *)&base->RXDAT =
+            (miso & mask) | (control & (SPI_TXDATCTL_TXSSEL0_N_MASK | SPI_TXDATCTL_TXSSEL1_N_MASK |
+                                        SPI_TXDATCTL_TXSSEL2_N_MASK | SPI_TXDATCTL_TXSSEL3_N_MASK));
+        base->STAT |= SPI_STAT_RXRDY_MASK;
+    }
+
+    if (eot)
+    {
+        base->STAT |= SPI_STAT_MSTIDLE_MASK | SPI_STAT_SSD_MASK;
+    }
+    else
+    {
+        base->STAT = (base->STAT & ~SPI_STAT_MSTIDLE_MASK) | SPI_STAT_SSA_MASK;
+    }
+}
+
+static void HOSTSIM_SpiAccess(hostsim_model_t *model, uint32_t offset, hostsim_access_t access, uint32_t oldValue)
+{
+    hostsim_spi_model_t *spi = (hostsim_spi_model_t *)model;
+    SPI_Type *base           = (SPI_Type *)(uintptr_t)model->base;
+    uint32_t value;
+
+    if (access == kHOSTSIM_AccessPrepareRead)
+    {
+        return;
+    }
+
+    if (access == kHOSTSIM_AccessRead)
+    {
+        if (offset == HOSTSIM_OFFSET(SPI_Type, RXDAT))
+        {
+            base->STAT &= ~SPI_STAT_RXRDY_MASK;
+        }
+    }
+    else
+    {
+        value = *(volatile uint32_t *)(uintptr_t)(model->base + offset);
+
+        switch (offset)
+        {
+            case HOSTSIM_OFFSET(SPI_Type, STAT):
+                base->STAT = oldValue & ~(value & HOSTSIM_SPI_STAT_W1C);
+                break;
+
+            case HOSTSIM_OFFSET(SPI_Type, INTENSET):
+                base->INTENSET = oldValue | value;
+                break;
+
+            case HOSTSIM_OFFSET(SPI_Type, INTENCLR):
+                base->INTENSET &= ~value;
+                base->INTENCLR = 0U;
+                break;
+
+            case HOSTSIM_OFFSET(SPI_Type, TXDATCTL):
+                /* TXDATCTL writes the control bits of TXCTL as well. */
+                base->TXCTL = value & ~SPI_TXDATCTL_TXDAT_MASK;
+                HOSTSIM_SpiTransmit(spi, value & SPI_TXDATCTL_TXDAT_MASK, value);
+                break;
+
+            case HOSTSIM_OFFSET(SPI_Type, TXDAT):
+                HOSTSIM_SpiTransmit(spi, value, base->TXCTL);
+                break;
+
+            case HOSTSIM_OFFSET(SPI_Type, RXDAT):
+            case HOSTSIM_OFFSET(SPI_Type, INTSTAT):
+                *(volatile uint32_t *)(uintptr_t)(model->base + offset) = oldValue;
+                break;
+
+            default:
+                /* Plain register. */
+                break;
+        }
+    }
+
+    HOSTSIM_UpdateIRQ((volatile uint32_t *)&base->INTSTAT, base->STAT, base->INTENSET, spi->irq);
+}
+
+static bool HOSTSIM_SpiDmaRequest(hostsim_model_t *model, uint32_t request)
+{
+    SPI_Type *base = (SPI_Type *)(uintptr_t)model->base;
+
+    return (base->STAT &
+            ((request == (uint32_t)kHOSTSIM_DmaRequestRx) ? SPI_STAT_RXRDY_MASK : SPI_STAT_TXRDY_MASK)) != 0U;
+}
+
+void HOSTSIM_SpiModelInit(
+    hostsim_spi_model_t *spi, SPI_Type *base, IRQn_Type irq, hostsim_spi_slave_t slave, void *userData)
+{
+    assert(spi != NULL);
+
+    (void)memset(spi, 0, sizeof(*spi));
+    spi->model.base       = (uint32_t)(uintptr_t)base;
+    spi->model.size       = sizeof(SPI_Type);
+    spi->model.access     = HOSTSIM_SpiAccess;
+    spi->model.dmaRequest = HOSTSIM_SpiDmaRequest;
+    spi->irq              = irq;
+    spi->slave            = slave;
+    spi->userData         = userData;
+
+    (void)memset((void *)base, 0, sizeof(SPI_Type));
+    base->STAT = SPI_STAT_TXRDY_MASK | SPI_STAT_MSTIDLE_MASK;
+
+    HOSTSIM_AttachModel(&spi->model);
+}
+
+/*******************************************************************************
+ * I2C
+ ******************************************************************************/
+
+static void HOSTSIM_I2cSetState(I2C_Type *base, uint32_t state)
+{
+    base->STAT = (base->STAT & ~I2C_STAT_MSTSTATE_MASK) | I2C_STAT_MSTSTATE(state) | I2C_STAT_MSTPENDING_MASK;
+}
+
+static hostsim_i2c_device_t *HOSTSIM_I2cSelect(hostsim_i2c_model_t *i2c, uint32_t address)
+{
+    uint32_t i;
+
+    for (i = 0U; i < i2c->deviceCount; i++)
+    {
+        if ((i2c->device[i].memory != NULL) && (i2c->device[i].address == address))
+        {
+            return &i2c->device[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Moves the data byte in MSTDAT in the direction of the current transfer. */
+static void HOSTSIM_I2cData(hostsim_i2c_model_t *i2c, uint32_t data)
+{
+    I2C_Type *base               = (I2C_Type *)(uintptr_t)i2c->model.base;
+    hostsim_i2c_device_t *device = i2c->selected;
+
+    if (i2c->read)
+    {
+        base->MSTDAT    = device->memory[device->pointer];
+        device->pointer = (device->pointer + 1U) % device->memorySize;
+    }
+    else if (i2c->addressPhase)
+    {
+        device->pointer   = data % device->memorySize;
+        i2c->addressPhase = false;
+    }
+    else
+    {
+        device->memory[device->pointer] = (uint8_t)data;
+        device->pointer                 = (device->pointer + 1U) % device->memorySize;
+    }
+}
+
+static void HOSTSIM_I2cControl(hostsim_i2c_model_t *i2c, uint32_t control)
+{
+    I2C_Type *base = (I2C_Type *)(uintptr_t)i2c->model.base;
+    uint32_t state = (base->STAT & I2C_STAT_MSTSTATE_MASK) >> I2C_STAT_MSTSTATE_SHIFT;
+    uint32_t data  = base->MSTDAT & I2C_MSTDAT_DATA_MASK;
+
+    if ((control & I2C_MSTCTL_MSTSTART_MASK) != 0U)
+    {
+        i2c->read     = ((data & 1U) != 0U);
+        i2c->selected = HOSTSIM_I2cSelect(i2c, data >> 1U);
+        if (i2c->selected == NULL)
+        {
+            HOSTSIM_I2cSetState(base, I2C_STAT_MSTCODE_NACKADR);
+        }
+        else if (i2c->read)
+        {
+            HOSTSIM_I2cData(i2c, data);
+            HOSTSIM_I2cSetState(base, I2C_STAT_MSTCODE_RXREADY);
+        }
+        else
+        {
+            i2c->addressPhase = true;
+            HOSTSIM_I2cSetState(base, I2C_STAT_MSTCODE_TXREADY);
+        }
+    }
+    else if ((control & I2C_MSTCTL_MSTSTOP_MASK) != 0U)
+    {
+        HOSTSIM_I2cSetState(base, I2C_STAT_MSTCODE_IDLE);
+    }
+    else if ((control & I2C_MSTCTL_MSTCONTINUE_MASK) != 0U)
+    {
+        if ((state == I2C_STAT_MSTCODE_TXREADY) || (state == I2C_STAT_MSTCODE_RXREADY))
+        {
+            HOSTSIM_I2cData(i2c, data);
+        }
+        else
+        {
+            /* Continue without a transfer in progress is ignored. */
+        }
+        HOSTSIM_I2cSetState(base, state);
+    }
+    else
+    {
+        /* MSTDMA only. */
+    }
+
+    base->MSTCTL = control & I2C_MSTCTL_MSTDMA_MASK;
+}
+
+static void HOSTSIM_I2cAccess(hostsim_model_t *model, uint32_t offset, hostsim_access_t access, uint32_t oldValue)
+{
+    hostsim_i2c_model_t *i2c = (hostsim_i2c_model_t *)model;
+    I2C_Type *base           = (I2C_Type *)(uintptr_t)model->base;
+    uint32_t state           = (base->STAT & I2C_STAT_MSTSTATE_MASK) >> I2C_STAT_MSTSTATE_SHIFT;
+    bool dma                 = ((base->MSTCTL & I2C_MSTCTL_MSTDMA_MASK) != 0U);
+    uint32_t value;
+
+    if (access == kHOSTSIM_AccessRead)
+    {
+        /* The DMA received a byte, the master receives the next one. */
+        if ((offset == HOSTSIM_OFFSET(I2C_Type, MSTDAT)) && dma && (state == I2C_STAT_MSTCODE_RXREADY))
+        {
+            HOSTSIM_I2cData(i2c, 0U);
+        }
+        return;
+    }
+
+    if (access != kHOSTSIM_AccessWrite)
+    {
+        return;
+    }
+
+    value = *(volatile uint32_t *)(uintptr_t)(model->base + offset);
+
+    switch (offset)
+    {
+        case HOSTSIM_OFFSET(I2C_Type, MSTDAT):
+            /* The DMA wrote a byte, the master sends it. */
+            if (dma && (state == I2C_STAT_MSTCODE_TXREADY))
+            {
+                HOSTSIM_I2cData(i2c, value & I2C_MSTDAT_DATA_MASK);
+            }
+            break;
+
+        case HOSTSIM_OFFSET(I2C_Type, STAT):
+            base->STAT = oldValue & ~(value & HOSTSIM_I2C_STAT_W1C);
+            break;
+
+        case HOSTSIM_OFFSET(I2C_Type, INTENSET):
+            base->INTENSET = oldValue | value;
+            break;
+
+        case HOSTSIM_OFFSET(I2C_Type, INTENCLR):
+            base->INTENSET &= ~value;
+            base->INTENCLR = 0U;
+            break;
+
+        case HOSTSIM_OFFSET(I2C_Type, MSTCTL):
+            HOSTSIM_I2cControl(i2c, value);
+            break;
+
+        case HOSTSIM_OFFSET(I2C_Type, INTSTAT):
+            *(volatile uint32_t *)&base->INTSTAT = oldValue;
+            break;
+
+        default:
+            /* Plain register. */
+            break;
+    }
+
+    /* The DMA serves the master while MSTDMA is set, MSTPENDING does not interrupt. */
+    HOSTSIM_UpdateIRQ((volatile uint32_t *)&base->INTSTAT,
+                      ((base->MSTCTL & I2C_MSTCTL_MSTDMA_MASK) != 0U) ? (base->STAT & ~I2C_STAT_MSTPENDING_MASK) :
+                                                                         base->STAT,
+                      base->INTENSET, i2c->irq);
+}
+
+static bool HOSTSIM_I2cDmaRequest(hostsim_model_t *model, uint32_t request)
+{
+    I2C_Type *base = (I2C_Type *)(uintptr_t)model->base;
+    uint32_t state = (base->STAT & I2C_STAT_MSTSTATE_MASK) >> I2C_STAT_MSTSTATE_SHIFT;
+
+    /* The master has one request line for both directions. */
+    return ((base->MSTCTL & I2C_MSTCTL_MSTDMA_MASK) != 0U) && ((base->STAT & I2C_STAT_MSTPENDING_MASK) != 0U) &&
+           ((state == I2C_STAT_MSTCODE_TXREADY) || (state == I2C_STAT_MSTCODE_RXREADY));
+}
+
+void HOSTSIM_I2cModelInit(hostsim_i2c_model_t *i2c,
+                          I2C_Type *base,
+                          IRQn_Type irq,
+                          uint8_t deviceAddress,
+                          uint8_t *memory,
+                          uint32_t memorySize)
+{
+    assert(i2c != NULL);
+    assert((memory == NULL) || (memorySize != 0U));
+
+    (void)memset(i2c, 0, sizeof(*i2c));
+    i2c->model.base       = (uint32_t)(uintptr_t)base;
+    i2c->model.size       = sizeof(I2C_Type);
+    i2c->model.access     = HOSTSIM_I2cAccess;
+    i2c->model.dmaRequest = HOSTSIM_I2cDmaRequest;
+    i2c->irq              = irq;
+    HOSTSIM_I2cModelAddDevice(i2c, deviceAddress, memory, memorySize);
+
+    (void)memset((void *)base, 0, sizeof(I2C_Type));
+    base->STAT = I2C_STAT_MSTPENDING_MASK;
+
+    HOSTSIM_AttachModel(&i2c->model);
+}
+
+void HOSTSIM_I2cModelAddDevice(hostsim_i2c_model_t *i2c, uint8_t deviceAddress, uint8_t *memory, uint32_t memorySize)
+{
+    hostsim_i2c_device_t *device;
+
+    assert(i2c != NULL);
+    assert(i2c->deviceCount < HOSTSIM_I2C_MAX_DEVICES);
+    assert((memory == NULL) || (memorySize != 0U));
+
+    device             = &i2c->device[i2c->deviceCount];
+    device->address    = deviceAddress;
+    device->memory     = memory;
+    device->memorySize = memorySize;
+    device->pointer    = 0U;
+    i2c->deviceCount++;
+}
+
+/*******************************************************************************
+ * ADC
+ ******************************************************************************/
+
+/* Converts the whole sequence, or its next channel with the interrupt per conversion. */
+static void HOSTSIM_AdcConvert(hostsim_adc_model_t *adc, uint32_t sequence)
+{
+    ADC_Type *base = (ADC_Type *)(uintptr_t)adc->model.base;
+    bool endOfSeq  = (base->SEQ_CTRL[sequence] & ADC_SEQ_CTRL_MODE_MASK) != 0U;
+    uint32_t channel;
+    uint32_t result;
+
+    if (adc->pending[sequence] == 0U)
+    {
+        adc->pending[sequence] =
+            (base->SEQ_CTRL[sequence] & ADC_SEQ_CTRL_CHANNELS_MASK) >> ADC_SEQ_CTRL_CHANNELS_SHIFT;
+    }
+
+    while (adc->pending[sequence] != 0U)
+    {
+        channel = (uint32_t)__builtin_ctz(adc->pending[sequence]);
+        adc->pending[sequence] &= adc->pending[sequence] - 1U;
+        adc->conversions[sequence]++;
+
+        result = (adc->sample != NULL) ? adc->sample(adc->userData, channel) : HOSTSIM_ADC_MID_SCALE;
+        result = ADC_DAT_RESULT(result) | ADC_DAT_CHANNEL(channel) | ADC_DAT_DATAVALID_MASK;
+
+        *(volatile uint32_t *)&base->DAT[channel]       = result;
+        *(volatile uint32_t *)&base->SEQ_GDAT[sequence] = result;
+
+        if (!endOfSeq)
+        {
+            break;
+        }
+    }
+
+    base->FLAGS |= ADC_FLAGS_SEQA_INT_MASK << sequence;
+}
+
+static void HOSTSIM_AdcUpdate(hostsim_adc_model_t *adc)
+{
+    ADC_Type *base = (ADC_Type *)(uintptr_t)adc->model.base;
+
+    HOSTSIM_SetIRQLine(ADC0_SEQA_IRQn, (base->FLAGS & base->INTEN & ADC_FLAGS_SEQA_INT_MASK) != 0U);
+    HOSTSIM_SetIRQLine(ADC0_SEQB_IRQn,
+                       ((base->FLAGS & ADC_FLAGS_SEQB_INT_MASK) != 0U) &&
+                           ((base->INTEN & ADC_INTEN_SEQB_INTEN_MASK) != 0U));
+}
+
+static void HOSTSIM_AdcAccess(hostsim_model_t *model, uint32_t offset, hostsim_access_t access, uint32_t oldValue)
+{
+    hostsim_adc_model_t *adc = (hostsim_adc_model_t *)model;
+    ADC_Type *base           = (ADC_Type *)(uintptr_t)model->base;
+    uint32_t value;
+    uint32_t sequence;
+
+    if (access == kHOSTSIM_AccessPrepareRead)
+    {
+        return;
+    }
+
+    if (access == kHOSTSIM_AccessRead)
+    {
+        if ((offset >= HOSTSIM_OFFSET(ADC_Type, SEQ_GDAT)) && (offset < HOSTSIM_OFFSET(ADC_Type, THR0_LOW)))
+        {
+            *(volatile uint32_t *)(uintptr_t)(model->base + offset) &= ~ADC_DAT_DATAVALID_MASK;
+        }
+        /* With the interrupt per conversion, reading the global data register clears the flag. */
+        if ((offset >= HOSTSIM_OFFSET(ADC_Type, SEQ_GDAT)) && (offset < HOSTSIM_OFFSET(ADC_Type, DAT)))
+        {
+            sequence = (offset - HOSTSIM_OFFSET(ADC_Type, SEQ_GDAT)) / sizeof(uint32_t);
+            if ((base->SEQ_CTRL[sequence] & ADC_SEQ_CTRL_MODE_MASK) == 0U)
+            {
+                base->FLAGS &= ~(ADC_FLAGS_SEQA_INT_MASK << sequence);
+                HOSTSIM_AdcUpdate(adc);
+            }
+        }
+        return;
+    }
+
+    value = *(volatile uint32_t *)(uintptr_t)(model->base + offset);
+
+    if (offset == HOSTSIM_OFFSET(ADC_Type, CTRL))
+    {
+        /* Calibration completes at once. */
+        base->CTRL = value & ~ADC_CTRL_CALMODE_MASK;
+    }
+    else if ((offset >= HOSTSIM_OFFSET(ADC_Type, SEQ_CTRL)) && (offset < HOSTSIM_OFFSET(ADC_Type, SEQ_GDAT)))
+    {
+        sequence = (offset - HOSTSIM_OFFSET(ADC_Type, SEQ_CTRL)) / sizeof(uint32_t);
+        if ((value & ADC_SEQ_CTRL_SEQ_ENA_MASK) == 0U)
+        {
+            adc->pending[sequence] = 0U;
+        }
+        else if ((value & (ADC_SEQ_CTRL_START_MASK | ADC_SEQ_CTRL_BURST_MASK)) != 0U)
+        {
+            base->SEQ_CTRL[sequence] = value & ~ADC_SEQ_CTRL_START_MASK;
+            HOSTSIM_AdcConvert(adc, sequence);
+        }
+        else
+        {
+            /* Enabled and idle. */
+        }
+    }
+    else if (offset == HOSTSIM_OFFSET(ADC_Type, FLAGS))
+    {
+        base->FLAGS = oldValue & ~value;
+    }
+    else if ((offset >= HOSTSIM_OFFSET(ADC_Type, SEQ_GDAT)) && (offset < HOSTSIM_OFFSET(ADC_Type, THR0_LOW)))
+    {
+        /* Read-only data registers. */
+        *(volatile uint32_t *)(uintptr_t)(model->base + offset) = oldValue;
+    }
+    else
+    {
+        /* Plain register. */
+    }
+
+    HOSTSIM_AdcUpdate(adc);
+}
+
+static void HOSTSIM_AdcTick(hostsim_model_t *model, uint64_t cycles)
+{
+    hostsim_adc_model_t *adc = (hostsim_adc_model_t *)model;
+    ADC_Type *base           = (ADC_Type *)(uintptr_t)model->base;
+    uint32_t sequence;
+
+    (void)cycles;
+
+    for (sequence = 0U; sequence < ADC_SEQ_CTRL_COUNT; sequence++)
+    {
+        if (((base->SEQ_CTRL[sequence] & ADC_SEQ_CTRL_SEQ_ENA_MASK) != 0U) &&
+            (((base->SEQ_CTRL[sequence] & ADC_SEQ_CTRL_BURST_MASK) != 0U) || (adc->pending[sequence] != 0U)))
+        {
+            HOSTSIM_AdcConvert(adc, sequence);
+        }
+    }
+
+    HOSTSIM_AdcUpdate(adc);
+}
+
+static bool HOSTSIM_AdcDmaRequest(hostsim_model_t *model, uint32_t request)
+{
+    ADC_Type *base = (ADC_Type *)(uintptr_t)model->base;
+
+    return (request < ADC_SEQ_CTRL_COUNT) && ((base->FLAGS & (ADC_FLAGS_SEQA_INT_MASK << request)) != 0U);
+}
+
+void HOSTSIM_AdcModelInit(hostsim_adc_model_t *adc, ADC_Type *base, hostsim_adc_sample_t sample, void *userData)
+{
+    assert(adc != NULL);
+
+    (void)memset(adc, 0, sizeof(*adc));
+    adc->model.base   = (uint32_t)(uintptr_t)base;
+    adc->model.size   = sizeof(ADC_Type);
+    adc->model.access     = HOSTSIM_AdcAccess;
+    adc->model.tick       = HOSTSIM_AdcTick;
+    adc->model.dmaRequest = HOSTSIM_AdcDmaRequest;
+    adc->sample           = sample;
+    adc->userData         = userData;
+
+    (void)memset((void *)base, 0, sizeof(ADC_Type));
+
+    HOSTSIM_AttachModel(&adc->model);
+}
+
+/*******************************************************************************
+ * CAPT
+ ******************************************************************************/
+
+static void HOSTSIM_CaptMeasure(hostsim_capt_model_t *capt, uint16_t xpins)
+{
+    CAPT_Type *base  = (CAPT_Type *)(uintptr_t)capt->model.base;
+    uint32_t timeout = 1UL << ((base->POLL_TCNT & CAPT_POLL_TCNT_TOUT_MASK) >> CAPT_POLL_TCNT_TOUT_SHIFT);
+    uint32_t tcnt    = (base->POLL_TCNT & CAPT_POLL_TCNT_TCNT_MASK) >> CAPT_POLL_TCNT_TCNT_SHIFT;
+    uint32_t dmaMode = (base->CTRL & CAPT_CTRL_DMA_MASK) >> CAPT_CTRL_DMA_SHIFT;
+    uint32_t seq     = (base->TOUCH & CAPT_TOUCH_SEQ_MASK) >> CAPT_TOUCH_SEQ_SHIFT;
+    uint32_t count;
+    bool isTimeout;
+    bool isTouch;
+
+    count     = (capt->sample != NULL) ? capt->sample(capt->userData, xpins) : HOSTSIM_CAPT_NO_TOUCH_COUNT;
+    isTimeout = (count >= timeout);
+    if (isTimeout)
+    {
+        count = timeout;
+    }
+    isTouch = (!isTimeout) && (((base->POLL_TCNT & CAPT_POLL_TCNT_TCHLOW_ER_MASK) != 0U) ? (count < tcnt) :
+                                                                                            (count > tcnt));
+
+    if (capt->unread)
+    {
+        base->STATUS |= CAPT_STATUS_OVERUN_MASK;
+    }
+    base->STATUS |=
+        isTouch ? CAPT_STATUS_YESTOUCH_MASK : (isTimeout ? CAPT_STATUS_TIMEOUT_MASK : CAPT_STATUS_NOTOUCH_MASK);
+
+    *(volatile uint32_t *)&base->TOUCH = CAPT_TOUCH_COUNT(count) | CAPT_TOUCH_XVAL(__builtin_ctz(xpins)) |
+                                         CAPT_TOUCH_ISTOUCH(isTouch) | CAPT_TOUCH_ISTO(isTimeout) | CAPT_TOUCH_SEQ(seq);
+    capt->unread     = true;
+    capt->dmaRequest = (dmaMode == 3U) || ((dmaMode == 2U) && !isTimeout) || ((dmaMode == 1U) && isTouch);
+}
+
+static void HOSTSIM_CaptEndRound(hostsim_capt_model_t *capt)
+{
+    CAPT_Type *base = (CAPT_Type *)(uintptr_t)capt->model.base;
+    uint32_t poll   = (base->POLL_TCNT & CAPT_POLL_TCNT_POLL_MASK) >> CAPT_POLL_TCNT_POLL_SHIFT;
+    uint32_t fdiv   = (base->CTRL & CAPT_CTRL_FDIV_MASK) >> CAPT_CTRL_FDIV_SHIFT;
+    uint64_t cycles = 4096ULL * poll * (fdiv + 1U);
+    uint32_t touch  = base->TOUCH;
+
+    /* The sequence number of the next round. */
+    *(volatile uint32_t *)&base->TOUCH =
+        (touch & ~CAPT_TOUCH_SEQ_MASK) |
+        CAPT_TOUCH_SEQ(((touch & CAPT_TOUCH_SEQ_MASK) >> CAPT_TOUCH_SEQ_SHIFT) + 1U);
+    base->STATUS |= CAPT_STATUS_POLLDONE_MASK;
+
+    capt->delayTicks = (uint32_t)(((cycles * 1000000U) / ((uint64_t)SystemCoreClock * HOSTSIM_TICK_US)));
+}
+
+static void HOSTSIM_CaptUpdate(hostsim_capt_model_t *capt)
+{
+    CAPT_Type *base = (CAPT_Type *)(uintptr_t)capt->model.base;
+
+    if (capt->roundPins != 0U)
+    {
+        base->STATUS |= CAPT_STATUS_BUSY_MASK;
+    }
+    else
+    {
+        base->STATUS &= ~CAPT_STATUS_BUSY_MASK;
+    }
+
+    HOSTSIM_UpdateIRQ((volatile uint32_t *)&base->INTSTAT, base->STATUS & HOSTSIM_CAPT_STATUS_W1C, base->INTENSET,
+                      CMP_CAPT_IRQn);
+}
+
+static void HOSTSIM_CaptAccess(hostsim_model_t *model, uint32_t offset, hostsim_access_t access, uint32_t oldValue)
+{
+    hostsim_capt_model_t *capt = (hostsim_capt_model_t *)model;
+    CAPT_Type *base            = (CAPT_Type *)(uintptr_t)model->base;
+    uint32_t value;
+
+    if (access == kHOSTSIM_AccessPrepareRead)
+    {
+        return;
+    }
+
+    if (access == kHOSTSIM_AccessRead)
+    {
+        if (offset == HOSTSIM_OFFSET(CAPT_Type, TOUCH))
+        {
+            capt->unread     = false;
+            capt->dmaRequest = false;
+        }
+        return;
+    }
+
+    value = *(volatile uint32_t *)(uintptr_t)(model->base + offset);
+
+    if (offset == HOSTSIM_OFFSET(CAPT_Type, CTRL))
+    {
+        /* The mode changes at once, INCHANGE never reads 1. */
+        base->CTRL = value & ~CAPT_CTRL_INCHANGE_MASK;
+        if ((value & CAPT_CTRL_POLLMODE_MASK) != (oldValue & CAPT_CTRL_POLLMODE_MASK))
+        {
+            capt->roundPins  = 0U;
+            capt->delayTicks = 0U;
+            if ((value & CAPT_CTRL_POLLMODE_MASK) == 0U)
+            {
+                capt->unread     = false;
+                capt->dmaRequest = false;
+            }
+        }
+    }
+    else if (offset == HOSTSIM_OFFSET(CAPT_Type, STATUS))
+    {
+        base->STATUS = oldValue & ~(value & HOSTSIM_CAPT_STATUS_W1C);
+    }
+    else if (offset == HOSTSIM_OFFSET(CAPT_Type, INTENSET))
+    {
+        base->INTENSET = (oldValue | value) & HOSTSIM_CAPT_STATUS_W1C;
+    }
+    else if (offset == HOSTSIM_OFFSET(CAPT_Type, INTENCLR))
+    {
+        base->INTENSET &= ~value;
+        base->INTENCLR = 0U;
+    }
+    else if ((offset == HOSTSIM_OFFSET(CAPT_Type, INTSTAT)) || (offset == HOSTSIM_OFFSET(CAPT_Type, TOUCH)) ||
+             (offset == HOSTSIM_OFFSET(CAPT_Type, ID)))
+    {
+        /* Read-only registers. */
+        *(volatile uint32_t *)(uintptr_t)(model->base + offset) = oldValue;
+    }
+    else
+    {
+        /* Plain register. */
+    }
+
+    HOSTSIM_CaptUpdate(capt);
+}
+
+static void HOSTSIM_CaptTick(hostsim_model_t *model, uint64_t cycles)
+{
+    hostsim_capt_model_t *capt = (hostsim_capt_model_t *)model;
+    CAPT_Type *base            = (CAPT_Type *)(uintptr_t)model->base;
+    uint32_t mode              = (base->CTRL & CAPT_CTRL_POLLMODE_MASK) >> CAPT_CTRL_POLLMODE_SHIFT;
+    uint16_t xpins             = (uint16_t)((base->CTRL & CAPT_CTRL_XPINSEL_MASK) >> CAPT_CTRL_XPINSEL_SHIFT);
+    uint16_t pin;
+
+    (void)cycles;
+
+    if ((mode == (uint32_t)kCAPT_PollInactiveMode) || (xpins == 0U))
+    {
+        return;
+    }
+
+    if (mode == (uint32_t)kCAPT_PollNowMode)
+    {
+        /* One measurement of all pins together, then back to inactive. */
+        HOSTSIM_CaptMeasure(capt, xpins);
+        HOSTSIM_CaptEndRound(capt);
+        base->CTRL &= ~CAPT_CTRL_POLLMODE_MASK;
+    }
+    else if (capt->roundPins == 0U)
+    {
+        if (capt->delayTicks != 0U)
+        {
+            capt->delayTicks--;
+        }
+        else
+        {
+            capt->roundPins = xpins;
+        }
+    }
+    else if (mode == (uint32_t)kCAPT_PollContinuousMode)
+    {
+        pin = capt->roundPins & (uint16_t)(~capt->roundPins + 1U);
+        capt->roundPins &= (uint16_t)~pin;
+        HOSTSIM_CaptMeasure(capt, pin);
+        if (capt->roundPins == 0U)
+        {
+            HOSTSIM_CaptEndRound(capt);
+        }
+    }
+    else
+    {
+        /* Low-power round, all pins together. */
+        capt->roundPins = 0U;
+        HOSTSIM_CaptMeasure(capt, xpins);
+        HOSTSIM_CaptEndRound(capt);
+    }
+
+    HOSTSIM_CaptUpdate(capt);
+}
+
+static bool HOSTSIM_CaptDmaRequest(hostsim_model_t *model, uint32_t request)
+{
+    (void)request;
+
+    return ((hostsim_capt_model_t *)model)->dmaRequest;
+}
+
+void HOSTSIM_CaptModelInit(hostsim_capt_model_t *capt, CAPT_Type *base, hostsim_capt_sample_t sample, void *userData)
+{
+    assert(capt != NULL);
+
+    (void)memset(capt, 0, sizeof(*capt));
+    capt->model.base       = (uint32_t)(uintptr_t)base;
+    capt->model.size       = sizeof(CAPT_Type);
+    capt->model.access     = HOSTSIM_CaptAccess;
+    capt->model.tick       = HOSTSIM_CaptTick;
+    capt->model.dmaRequest = HOSTSIM_CaptDmaRequest;
+    capt->sample           = sample;
+    capt->userData         = userData;
+
+    (void)memset((void *)base, 0, sizeof(CAPT_Type));
+    base->STATUS = CAPT_STATUS_XMAX(HOSTSIM_CAPT_XMAX);
+
+    HOSTSIM_AttachModel(&capt->model);
+}
+
+/*******************************************************************************
+ * PINT
+ ******************************************************************************/
+
+/* Evaluates the bit slices, rise and fall are the input edges of the change being applied. */
+static void HOSTSIM_PintMatch(hostsim_pint_model_t *pint, uint8_t rise, uint8_t fall)
+{
+    static const IRQn_Type s_irqs[] = PINT_IRQS;
+    PINT_Type *base  = (PINT_Type *)(uintptr_t)pint->model.base;
+    uint8_t matches  = 0U;
+    bool term        = true;
+    uint32_t slice;
+    uint32_t input;
+    bool value;
+
+    for (slice = 0U; slice < HOSTSIM_PINT_CHANNELS; slice++)
+    {
+        input = 1UL << ((base->PMSRC >> (PININT_BITSLICE_SRC_START + (slice * 3U))) & PININT_BITSLICE_SRC_MASK);
+        switch ((base->PMCFG >> (PININT_BITSLICE_CFG_START + (slice * 3U))) & PININT_BITSLICE_CFG_MASK)
+        {
+            case (uint32_t)kPINT_PatternMatchAlways:
+                value = true;
+                break;
+            case (uint32_t)kPINT_PatternMatchStickyRise:
+                pint->sticky |= ((rise & input) != 0U) ? (uint8_t)(1U << slice) : 0U;
+                value = (pint->sticky & (1U << slice)) != 0U;
+                break;
+            case (uint32_t)kPINT_PatternMatchStickyFall:
+                pint->sticky |= ((fall & input) != 0U) ? (uint8_t)(1U << slice) : 0U;
+                value = (pint->sticky & (1U << slice)) != 0U;
+                break;
+            case (uint32_t)kPINT_PatternMatchStickyBothEdges:
+                pint->sticky |= (((rise | fall) & input) != 0U) ? (uint8_t)(1U << slice) : 0U;
+                value = (pint->sticky & (1U << slice)) != 0U;
+                break;
+            case (uint32_t)kPINT_PatternMatchHigh:
+                value = (pint->inputs & input) != 0U;
+                break;
+            case (uint32_t)kPINT_PatternMatchLow:
+                value = (pint->inputs & input) == 0U;
+                break;
+            case (uint32_t)kPINT_PatternMatchBothEdges:
+                value = ((rise | fall) & input) != 0U;
+                break;
+            default:
+                value = false;
+                break;
+        }
+
+        term = term && value;
+        /* Slice 7 always ends a product term. */
+        if ((slice == (HOSTSIM_PINT_CHANNELS - 1U)) || ((base->PMCFG & (1UL << slice)) != 0U))
+        {
+            matches |= term ? (uint8_t)(1U << slice) : 0U;
+            term = true;
+        }
+    }
+
+    base->PMCTRL = (base->PMCTRL & ~PINT_PMCTRL_PMAT_MASK) | PINT_PMCTRL_PMAT(matches);
+    if ((base->PMCTRL & PINT_PMCTRL_SEL_PMATCH_MASK) != 0U)
+    {
+        for (slice = 0U; slice < HOSTSIM_PINT_CHANNELS; slice++)
+        {
+            if ((matches & ~pint->matches & (1U << slice)) != 0U)
+            {
+                HOSTSIM_PendIRQ(s_irqs[slice]);
+            }
+        }
+    }
+    pint->matches = matches;
+}
+
+static void HOSTSIM_PintUpdate(hostsim_pint_model_t *pint)
+{
+    static const IRQn_Type s_irqs[] = PINT_IRQS;
+    PINT_Type *base = (PINT_Type *)(uintptr_t)pint->model.base;
+    uint32_t level  = (pint->inputs & base->IENF) | ((uint8_t)~pint->inputs & ~base->IENF);
+    uint32_t ist;
+    uint32_t i;
+
+    /* Edges latched in RISE and FALL, levels as long as the pin is at the active level of IENF. */
+    ist = ((base->RISE & base->IENR) | (base->FALL & base->IENF)) & ~base->ISEL;
+    ist |= level & base->IENR & base->ISEL;
+    base->IST = ist & 0xFFU;
+
+    for (i = 0U; i < HOSTSIM_PINT_CHANNELS; i++)
+    {
+        HOSTSIM_SetIRQLine(s_irqs[i], ((base->PMCTRL & PINT_PMCTRL_SEL_PMATCH_MASK) == 0U) && ((ist & (1UL << i)) != 0U));
+    }
+}
+
+static void HOSTSIM_PintAccess(hostsim_model_t *model, uint32_t offset, hostsim_access_t access, uint32_t oldValue)
+{
+    hostsim_pint_model_t *pint = (hostsim_pint_model_t *)model;
+    PINT_Type *base            = (PINT_Type *)(uintptr_t)model->base;
+    uint32_t value;
+
+    if (access != kHOSTSIM_AccessWrite)
+    {
+        return;
+    }
+
+    value = *(volatile uint32_t *)(uintptr_t)(model->base + offset);
+
+    if (offset == HOSTSIM_OFFSET(PINT_Type, SIENR))
+    {
+        base->IENR |= value;
+        base->SIENR = 0U;
+    }
+    else if (offset == HOSTSIM_OFFSET(PINT_Type, CIENR))
+    {
+        base->IENR &= ~value;
+        base->CIENR = 0U;
+    }
+    else if (offset == HOSTSIM_OFFSET(PINT_Type, SIENF))
+    {
+        base->IENF |= value;
+        base->SIENF = 0U;
+    }
+    else if (offset == HOSTSIM_OFFSET(PINT_Type, CIENF))
+    {
+        base->IENF &= ~value;
+        base->CIENF = 0U;
+    }
+    else if ((offset == HOSTSIM_OFFSET(PINT_Type, RISE)) || (offset == HOSTSIM_OFFSET(PINT_Type, FALL)))
+    {
+        *(volatile uint32_t *)(uintptr_t)(model->base + offset) = oldValue & ~value;
+    }
+    else if (offset == HOSTSIM_OFFSET(PINT_Type, IST))
+    {
+        /* Clears the edges of edge sensitive pins, switches the active level of level sensitive pins. */
+        base->RISE &= ~(value & ~base->ISEL);
+        base->FALL &= ~(value & ~base->ISEL);
+        base->IENF ^= value & base->ISEL;
+    }
+    else if (offset == HOSTSIM_OFFSET(PINT_Type, PMCTRL))
+    {
+        base->PMCTRL = (value & ~PINT_PMCTRL_PMAT_MASK) | (oldValue & PINT_PMCTRL_PMAT_MASK);
+    }
+    else if (offset == HOSTSIM_OFFSET(PINT_Type, PMSRC))
+    {
+        /* Writing PMSRC resets the edge detection of the bit slices. */
+        pint->sticky  = 0U;
+        pint->matches = 0U;
+    }
+    else
+    {
+        /* Plain register. */
+    }
+
+    HOSTSIM_PintMatch(pint, 0U, 0U);
+    HOSTSIM_PintUpdate(pint);
+}
+
+void HOSTSIM_PintModelInit(hostsim_pint_model_t *pint, PINT_Type *base)
+{
+    assert(pint != NULL);
+
+    (void)memset(pint, 0, sizeof(*pint));
+    pint->model.base   = (uint32_t)(uintptr_t)base;
+    pint->model.size   = sizeof(PINT_Type);
+    pint->model.access = HOSTSIM_PintAccess;
+
+    (void)memset((void *)base, 0, sizeof(PINT_Type));
+
+    HOSTSIM_AttachModel(&pint->model);
+}
+
+void HOSTSIM_PintModelSetInputs(hostsim_pint_model_t *pint, uint8_t inputs)
+{
+    PINT_Type *base = (PINT_Type *)(uintptr_t)pint->model.base;
+    uint8_t rise    = inputs & (uint8_t)~pint->inputs;
+    uint8_t fall    = (uint8_t)~inputs & pint->inputs;
+    uint32_t state;
+
+    state        = HOSTSIM_EnterModel(&pint->model);
+    pint->inputs = inputs;
+    base->RISE |= rise;
+    base->FALL |= fall;
+    HOSTSIM_PintMatch(pint, rise, fall);
+    HOSTSIM_PintUpdate(pint);
+    HOSTSIM_ExitModel(&pint->model, state);
+}
+
+/*******************************************************************************
+ * GPIO
+ ******************************************************************************/
+
+/* The pin registers and the read side of MPIN and SET follow the output levels in PIN. */
+static void HOSTSIM_GpioSync(GPIO_Type *base)
+{
+    uint32_t port;
+    uint32_t pin;
+    bool high;
+
+    for (port = 0U; port < HOSTSIM_GPIO_PORTS; port++)
+    {
+        for (pin = 0U; pin < HOSTSIM_GPIO_PINS; pin++)
+        {
+            high               = ((base->PIN[port] & (1UL << pin)) != 0U);
+            base->B[port][pin] = high ? 1U : 0U;
+            base->W[port][pin] = high ? 0xFFFFFFFFU : 0U;
+        }
+        base->MPIN[port]   = base->PIN[port] & ~base->MASK[port];
+        base->SET[port]    = base->PIN[port];
+        base->CLR[port]    = 0U;
+        base->NOT[port]    = 0U;
+        base->DIRSET[port] = 0U;
+        base->DIRCLR[port] = 0U;
+        base->DIRNOT[port] = 0U;
+    }
+}
+
+static void HOSTSIM_GpioSetPin(GPIO_Type *base, uint32_t index, bool high)
+{
+    if (index >= (HOSTSIM_GPIO_PORTS * HOSTSIM_GPIO_PINS))
+    {
+        return;
+    }
+
+    if (high)
+    {
+        base->PIN[index / HOSTSIM_GPIO_PINS] |= 1UL << (index % HOSTSIM_GPIO_PINS);
+    }
+    else
+    {
+        base->PIN[index / HOSTSIM_GPIO_PINS] &= ~(1UL << (index % HOSTSIM_GPIO_PINS));
+    }
+}
+
+static void HOSTSIM_GpioAccess(hostsim_model_t *model, uint32_t offset, hostsim_access_t access, uint32_t oldValue)
+{
+    hostsim_gpio_model_t *gpio = (hostsim_gpio_model_t *)model;
+    GPIO_Type *base            = (GPIO_Type *)(uintptr_t)model->base;
+    uint32_t pins[HOSTSIM_GPIO_PORTS];
+    uint32_t port  = (offset / 4U) % HOSTSIM_GPIO_PORTS;
+    uint32_t group = offset & ~((HOSTSIM_GPIO_PORTS * 4U) - 1U);
+    uint32_t value;
+    uint32_t byte;
+    uint32_t i;
+
+    if (access != kHOSTSIM_AccessWrite)
+    {
+        return;
+    }
+
+    value = *(volatile uint32_t *)(uintptr_t)(model->base + offset);
+    for (i = 0U; i < HOSTSIM_GPIO_PORTS; i++)
+    {
+        pins[i] = base->PIN[i];
+    }
+
+    if (offset < HOSTSIM_OFFSET(GPIO_Type, W))
+    {
+        /* A byte pin register drives its pin high when any bit is set, only the bytes written change. */
+        for (i = 0U; i < 4U; i++)
+        {
+            byte = (value >> (8U * i)) & 0xFFU;
+            if (byte != ((oldValue >> (8U * i)) & 0xFFU))
+            {
+                HOSTSIM_GpioSetPin(base, offset + i, byte != 0U);
+            }
+        }
+    }
+    else if (offset < HOSTSIM_OFFSET(GPIO_Type, DIR))
+    {
+        HOSTSIM_GpioSetPin(base, (offset - HOSTSIM_OFFSET(GPIO_Type, W)) / 4U, value != 0U);
+    }
+    else if (group == HOSTSIM_OFFSET(GPIO_Type, MPIN))
+    {
+        base->PIN[port] = (base->PIN[port] & base->MASK[port]) | (value & ~base->MASK[port]);
+    }
+    else if (group == HOSTSIM_OFFSET(GPIO_Type, SET))
+    {
+        base->PIN[port] |= value;
+    }
+    else if (group == HOSTSIM_OFFSET(GPIO_Type, CLR))
+    {
+        base->PIN[port] &= ~value;
+    }
+    else if (group == HOSTSIM_OFFSET(GPIO_Type, NOT))
+    {
+        base->PIN[port] ^= value;
+    }
+    else if (group == HOSTSIM_OFFSET(GPIO_Type, DIRSET))
+    {
+        base->DIR[port] |= value;
+    }
+    else if (group == HOSTSIM_OFFSET(GPIO_Type, DIRCLR))
+    {
+        base->DIR[port] &= ~value;
+    }
+    else if (group == HOSTSIM_OFFSET(GPIO_Type, DIRNOT))
+    {
+        base->DIR[port] ^= value;
+    }
+    else
+    {
+        /* Plain register, PIN included. */
+    }
+
+    for (i = 0U; i < HOSTSIM_GPIO_PORTS; i++)
+    {
+        if (pins[i] != base->PIN[i])
+        {
+            gpio->writes++;
+            break;
+        }
+    }
+    HOSTSIM_GpioSync(base);
+}
+
+void HOSTSIM_GpioModelInit(hostsim_gpio_model_t *gpio, GPIO_Type *base)
+{
+    assert(gpio != NULL);
+
+    (void)memset(gpio, 0, sizeof(*gpio));
+    gpio->model.base   = (uint32_t)(uintptr_t)base;
+    gpio->model.size   = sizeof(GPIO_Type);
+    gpio->model.access = HOSTSIM_GpioAccess;
+
+    (void)memset((void *)base, 0, sizeof(GPIO_Type));
+
+    HOSTSIM_AttachModel(&gpio->model);
+}
+
+/*******************************************************************************
+ * DMA
+ ******************************************************************************/
+
+static uint32_t HOSTSIM_DmaIncrement(uint32_t increment, uint32_t width)
+{
+    return ((increment == 3U) ? 4U : increment) * width;
+}
+
+static void HOSTSIM_DmaLoad(hostsim_dma_channel_t *channel, const dma_descriptor_t *descriptor, uint32_t xfercfg)
+{
+    channel->srcEndAddr     = (uint32_t)(uintptr_t)descriptor->srcEndAddr;
+    channel->dstEndAddr     = (uint32_t)(uintptr_t)descriptor->dstEndAddr;
+    channel->linkToNextDesc = (uint32_t)(uintptr_t)descriptor->linkToNextDesc;
+    channel->remaining =
+        ((xfercfg & DMA_CHANNEL_XFERCFG_XFERCOUNT_MASK) >> DMA_CHANNEL_XFERCFG_XFERCOUNT_SHIFT) + 1U;
+    channel->loaded = true;
+    if ((xfercfg & DMA_CHANNEL_XFERCFG_SWTRIG_MASK) != 0U)
+    {
+        channel->triggered = true;
+    }
+}
+
+/* Samples the hardware trigger, returns true if it allows the next transfer. */
+static bool HOSTSIM_DmaHardwareTrigger(hostsim_dma_channel_t *channel, uint32_t cfg)
+{
+    bool level = HOSTSIM_GetDmaRequest(channel->requestBase, channel->request) ==
+                 ((cfg & DMA_CHANNEL_CFG_TRIGPOL_MASK) != 0U);
+
+    if ((cfg & DMA_CHANNEL_CFG_TRIGTYPE_MASK) != 0U)
+    {
+        channel->triggered = level;
+        channel->burstLeft = level ? 1U : 0U;
+    }
+    else if (level && !channel->triggerLevel)
+    {
+        channel->triggered = true;
+        channel->burstLeft = ((cfg & DMA_CHANNEL_CFG_TRIGBURST_MASK) != 0U) ?
+                                 (1UL << ((cfg & DMA_CHANNEL_CFG_BURSTPOWER_MASK) >>
+                                          DMA_CHANNEL_CFG_BURSTPOWER_SHIFT)) :
+                                 channel->remaining;
+    }
+    else
+    {
+        /* No edge, the running burst goes on. */
+    }
+    channel->triggerLevel = level;
+
+    return channel->triggered && (channel->burstLeft != 0U);
+}
+
+/* Runs one channel as long as it is requested, returns the number of transfers done. */
+static uint32_t HOSTSIM_DmaRunChannel(hostsim_dma_model_t *dma, uint32_t index, uint32_t budget)
+{
+    DMA_Type *base                 = (DMA_Type *)(uintptr_t)dma->model.base;
+    hostsim_dma_channel_t *channel = &dma->channel[index];
+    uint32_t done                  = 0U;
+    uint32_t xfercfg;
+    uint32_t width;
+    uint32_t srcInc;
+    uint32_t dstInc;
+    const dma_descriptor_t *next;
+    bool hwTrigger;
+
+    hwTrigger = ((base->CHANNEL[index].CFG & DMA_CHANNEL_CFG_HWTRIGEN_MASK) != 0U) && (channel->requestBase != 0U);
+
+    while ((done < budget) && channel->loaded && (channel->triggered || hwTrigger))
+    {
+        if (hwTrigger && !HOSTSIM_DmaHardwareTrigger(channel, base->CHANNEL[index].CFG))
+        {
+            break;
+        }
+        if (((base->CHANNEL[index].CFG & DMA_CHANNEL_CFG_PERIPHREQEN_MASK) != 0U) &&
+            (channel->requestBase != 0U) && (!HOSTSIM_GetDmaRequest(channel->requestBase, channel->request)))
+        {
+            break;
+        }
+
+        xfercfg = base->CHANNEL[index].XFERCFG;
+        width   = 1UL << ((xfercfg & DMA_CHANNEL_XFERCFG_WIDTH_MASK) >> DMA_CHANNEL_XFERCFG_WIDTH_SHIFT);
+        srcInc  = HOSTSIM_DmaIncrement((xfercfg & DMA_CHANNEL_XFERCFG_SRCINC_MASK) >> DMA_CHANNEL_XFERCFG_SRCINC_SHIFT,
+                                       width);
+        dstInc  = HOSTSIM_DmaIncrement((xfercfg & DMA_CHANNEL_XFERCFG_DSTINC_MASK) >> DMA_CHANNEL_XFERCFG_DSTINC_SHIFT,
+                                       width);
+
+        HOSTSIM_BusWrite(channel->dstEndAddr - ((channel->remaining - 1U) * dstInc), width,
+                         HOSTSIM_BusRead(channel->srcEndAddr - ((channel->remaining - 1U) * srcInc), width));
+        channel->remaining--;
+        done++;
+        if (channel->burstLeft != 0U)
+        {
+            channel->burstLeft--;
+        }
+
+        base->CHANNEL[index].XFERCFG = (xfercfg & ~DMA_CHANNEL_XFERCFG_XFERCOUNT_MASK) |
+                                       DMA_CHANNEL_XFERCFG_XFERCOUNT(channel->remaining - 1U);
+        if (channel->remaining != 0U)
+        {
+            continue;
+        }
+
+        /* Descriptor done. */
+        if ((xfercfg & DMA_CHANNEL_XFERCFG_SETINTA_MASK) != 0U)
+        {
+            base->COMMON[0].INTA |= 1UL << index;
+        }
+        if ((xfercfg & DMA_CHANNEL_XFERCFG_SETINTB_MASK) != 0U)
+        {
+            base->COMMON[0].INTB |= 1UL << index;
+        }
+        if ((xfercfg & DMA_CHANNEL_XFERCFG_CLRTRIG_MASK) != 0U)
+        {
+            channel->triggered = false;
+        }
+
+        channel->loaded = false;
+        if (((xfercfg & DMA_CHANNEL_XFERCFG_RELOAD_MASK) != 0U) && (channel->linkToNextDesc != 0U))
+        {
+            next                         = (const dma_descriptor_t *)(uintptr_t)channel->linkToNextDesc;
+            base->CHANNEL[index].XFERCFG = next->xfercfg;
+            if ((next->xfercfg & DMA_CHANNEL_XFERCFG_CFGVALID_MASK) != 0U)
+            {
+                HOSTSIM_DmaLoad(channel, next, next->xfercfg);
+            }
+        }
+        else
+        {
+            base->CHANNEL[index].XFERCFG &= ~DMA_CHANNEL_XFERCFG_CFGVALID_MASK;
+        }
+    }
+
+    return done;
+}
+
+static void HOSTSIM_DmaUpdate(hostsim_dma_model_t *dma)
+{
+    DMA_Type *base   = (DMA_Type *)(uintptr_t)dma->model.base;
+    uint32_t active  = 0U;
+    uint32_t intstat = 0U;
+    uint32_t index;
+
+    for (index = 0U; index < (uint32_t)FSL_FEATURE_DMA_NUMBER_OF_CHANNELS; index++)
+    {
+        if (dma->channel[index].loaded)
+        {
+            active |= 1UL << index;
+        }
+        *(volatile uint32_t *)&base->CHANNEL[index].CTLSTAT =
+            (dma->channel[index].loaded ? DMA_CHANNEL_CTLSTAT_VALIDPENDING_MASK : 0U) |
+            (dma->channel[index].triggered ? DMA_CHANNEL_CTLSTAT_TRIG_MASK : 0U);
+    }
+    *(volatile uint32_t *)&base->COMMON[0].ACTIVE = active;
+    *(volatile uint32_t *)&base->COMMON[0].BUSY   = 0U;
+
+    if (((base->COMMON[0].INTA | base->COMMON[0].INTB) & base->COMMON[0].INTENSET) != 0U)
+    {
+        intstat |= DMA_INTSTAT_ACTIVEINT_MASK;
+    }
+    if ((base->COMMON[0].ERRINT & base->COMMON[0].INTENSET) != 0U)
+    {
+        intstat |= DMA_INTSTAT_ACTIVEERRINT_MASK;
+    }
+    *(volatile uint32_t *)&base->INTSTAT = intstat;
+
+    HOSTSIM_SetIRQLine(DMA0_IRQn, intstat != 0U);
+}
+
+static void HOSTSIM_DmaRun(hostsim_dma_model_t *dma)
+{
+    DMA_Type *base  = (DMA_Type *)(uintptr_t)dma->model.base;
+    uint32_t budget = HOSTSIM_DMA_MAX_TRANSFERS_PER_TICK;
+    uint32_t done;
+    uint32_t index;
+
+    if ((base->CTRL & DMA_CTRL_ENABLE_MASK) != 0U)
+    {
+        /*
+         * Channel 0 has the highest priority. One transfer per channel and pass, like bursts of one
+         * on the device, so a receive channel keeps up with the send channel feeding the peripheral.
+         */
+        do
+        {
+            done = 0U;
+            for (index = 0U; (index < (uint32_t)FSL_FEATURE_DMA_NUMBER_OF_CHANNELS) && (done < budget); index++)
+            {
+                if ((base->COMMON[0].ENABLESET & (1UL << index)) != 0U)
+                {
+                    done += HOSTSIM_DmaRunChannel(dma, index, 1U);
+                }
+            }
+            budget -= done;
+            dma->transferCount += done;
+        } while ((done != 0U) && (budget != 0U));
+    }
+
+    HOSTSIM_DmaUpdate(dma);
+}
+
+static void HOSTSIM_DmaCommonWrite(hostsim_dma_model_t *dma, uint32_t offset, uint32_t value, uint32_t oldValue)
+{
+    DMA_Type *base = (DMA_Type *)(uintptr_t)dma->model.base;
+    uint32_t index;
+
+    switch (offset)
+    {
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].ENABLESET):
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].INTENSET):
+            *(volatile uint32_t *)(uintptr_t)(dma->model.base + offset) = oldValue | value;
+            break;
+
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].ENABLECLR):
+            base->COMMON[0].ENABLESET &= ~value;
+            base->COMMON[0].ENABLECLR = 0U;
+            break;
+
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].INTENCLR):
+            base->COMMON[0].INTENSET &= ~value;
+            base->COMMON[0].INTENCLR = 0U;
+            break;
+
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].ERRINT):
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].INTA):
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].INTB):
+            *(volatile uint32_t *)(uintptr_t)(dma->model.base + offset) = oldValue & ~value;
+            break;
+
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].SETVALID):
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].SETTRIG):
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].ABORT):
+            for (index = 0U; index < (uint32_t)FSL_FEATURE_DMA_NUMBER_OF_CHANNELS; index++)
+            {
+                if ((value & (1UL << index)) == 0U)
+                {
+                    continue;
+                }
+                if (offset == HOSTSIM_OFFSET(DMA_Type, COMMON[0].SETTRIG))
+                {
+                    dma->channel[index].triggered = true;
+                }
+                else if (offset == HOSTSIM_OFFSET(DMA_Type, COMMON[0].ABORT))
+                {
+                    dma->channel[index].loaded    = false;
+                    dma->channel[index].triggered = false;
+                    dma->channel[index].burstLeft = 0U;
+                }
+                else
+                {
+                    base->CHANNEL[index].XFERCFG |= DMA_CHANNEL_XFERCFG_CFGVALID_MASK;
+                    if (!dma->channel[index].loaded)
+                    {
+                        HOSTSIM_DmaLoad(&dma->channel[index],
+                                        &((const dma_descriptor_t *)(uintptr_t)base->SRAMBASE)[index],
+                                        base->CHANNEL[index].XFERCFG);
+                    }
+                }
+            }
+            *(volatile uint32_t *)(uintptr_t)(dma->model.base + offset) = 0U;
+            break;
+
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].ACTIVE):
+        case HOSTSIM_OFFSET(DMA_Type, COMMON[0].BUSY):
+        case HOSTSIM_OFFSET(DMA_Type, INTSTAT):
+            *(volatile uint32_t *)(uintptr_t)(dma->model.base + offset) = oldValue;
+            break;
+
+        default:
+            /* Plain register. */
+            break;
+    }
+}
+
+static void HOSTSIM_DmaAccess(hostsim_model_t *model, uint32_t offset, hostsim_access_t access, uint32_t oldValue)
+{
+    hostsim_dma_model_t *dma = (hostsim_dma_model_t *)model;
+    DMA_Type *base           = (DMA_Type *)(uintptr_t)model->base;
+    uint32_t value;
+    uint32_t index;
+
+    if (access != kHOSTSIM_AccessWrite)
+    {
+        return;
+    }
+
+    value = *(volatile uint32_t *)(uintptr_t)(model->base + offset);
+
+    if (offset >= HOSTSIM_OFFSET(DMA_Type, CHANNEL))
+    {
+        index = (offset - HOSTSIM_OFFSET(DMA_Type, CHANNEL)) / sizeof(base->CHANNEL[0]);
+        offset -= index * (uint32_t)sizeof(base->CHANNEL[0]);
+
+        if (offset == HOSTSIM_OFFSET(DMA_Type, CHANNEL[0].XFERCFG))
+        {
+            if ((value & DMA_CHANNEL_XFERCFG_CFGVALID_MASK) == 0U)
+            {
+                dma->channel[index].loaded = false;
+            }
+            else if (!dma->channel[index].loaded)
+            {
+                HOSTSIM_DmaLoad(&dma->channel[index], &((const dma_descriptor_t *)(uintptr_t)base->SRAMBASE)[index],
+                                value);
+            }
+            else if ((value & DMA_CHANNEL_XFERCFG_SWTRIG_MASK) != 0U)
+            {
+                dma->channel[index].triggered = true;
+            }
+            else
+            {
+                /* Reconfiguration of a loaded channel. */
+            }
+        }
+        else if (offset == HOSTSIM_OFFSET(DMA_Type, CHANNEL[0].CTLSTAT))
+        {
+            *(volatile uint32_t *)&base->CHANNEL[index].CTLSTAT = oldValue;
+        }
+        else
+        {
+            /* CFG is a plain register. */
+        }
+    }
+    else
+    {
+        HOSTSIM_DmaCommonWrite(dma, offset, value, oldValue);
+    }
+
+    HOSTSIM_DmaRun(dma);
+}
+
+static void HOSTSIM_DmaTick(hostsim_model_t *model, uint64_t cycles)
+{
+    (void)cycles;
+
+    HOSTSIM_DmaRun((hostsim_dma_model_t *)model);
+}
+
+void HOSTSIM_DmaModelInit(hostsim_dma_model_t *dma, DMA_Type *base)
+{
+    assert(dma != NULL);
+
+    (void)memset(dma, 0, sizeof(*dma));
+    dma->model.base   = (uint32_t)(uintptr_t)base;
+    dma->model.size   = sizeof(DMA_Type);
+    dma->model.access = HOSTSIM_DmaAccess;
+    dma->model.tick   = HOSTSIM_DmaTick;
+
+    (void)memset((void *)base, 0, sizeof(DMA_Type));
+
+    HOSTSIM_AttachModel(&dma->model);
+}
+
+void HOSTSIM_DmaModelConnect(hostsim_dma_model_t *dma, uint32_t channel, uint32_t peripheral, uint32_t request)
+{
+    uint32_t state;
+
+    assert(dma != NULL);
+    assert(channel < (uint32_t)FSL_FEATURE_DMA_NUMBER_OF_CHANNELS);
+
+    state                              = HOSTSIM_EnterModel(&dma->model);
+    dma->channel[channel].requestBase  = peripheral;
+    dma->channel[channel].request      = request;
+    HOSTSIM_ExitModel(&dma->model, state);
+}
+
+/*******************************************************************************
+ * IAP
+ ******************************************************************************/
+
+static uint32_t HOSTSIM_IapRandom(hostsim_iap_model_t *iap)
+{
+    iap->random = (iap->random * 1664525U) + 1013904223U;
+
+    return iap->random >> 8U;
+}
+
+static void HOSTSIM_IapBusy(hostsim_iap_model_t *iap, uint32_t us)
+{
+    iap->busyUs += us;
+    iap->maxBusyUs = (us > iap->maxBusyUs) ? us : iap->maxBusyUs;
+}
+
+/* Counts the program and erase commands, returns true for the one the power fails in. */
+static bool HOSTSIM_IapPowerFails(hostsim_iap_model_t *iap)
+{
+    if (iap->powerLossCountdown == 0U)
+    {
+        return false;
+    }
+    iap->powerLossCountdown--;
+
+    return (iap->powerLossCountdown == 0U);
+}
+
+static void HOSTSIM_IapPowerLoss(hostsim_iap_model_t *iap)
+{
+    if (iap->powerLoss != NULL)
+    {
+        iap->powerLoss(iap->userData);
+    }
+}
+
+/* Returns the ROM code for a range of sectors that are not all prepared. */
+static uint32_t HOSTSIM_IapCheckPrepared(hostsim_iap_model_t *iap, uint32_t start, uint32_t end)
+{
+    uint32_t sector;
+
+    for (sector = start; sector <= end; sector++)
+    {
+        if ((iap->prepared & (1ULL << sector)) == 0U)
+        {
+            return kHOSTSIM_IapNotPrepared;
+        }
+    }
+
+    return kHOSTSIM_IapSuccess;
+}
+
+static uint32_t HOSTSIM_IapProgram(hostsim_iap_model_t *iap, uint32_t dst, uint32_t src, uint32_t count)
+{
+    const uint8_t *data = (const uint8_t *)(uintptr_t)src;
+    uint32_t length     = count;
+    uint32_t status;
+    uint32_t i;
+
+    if ((dst % HOSTSIM_IAP_PAGE_SIZE) != 0U)
+    {
+        return kHOSTSIM_IapDstAddrError;
+    }
+    if ((src % sizeof(uint32_t)) != 0U)
+    {
+        return kHOSTSIM_IapSrcAddrError;
+    }
+    if ((count == 0U) || ((count % HOSTSIM_IAP_PAGE_SIZE) != 0U) || (count > HOSTSIM_IAP_SECTOR_SIZE))
+    {
+        return kHOSTSIM_IapCountError;
+    }
+    if ((dst + count) > (uint32_t)FSL_FEATURE_SYSCON_FLASH_SIZE_BYTES)
+    {
+        return kHOSTSIM_IapDstNotMapped;
+    }
+    status = HOSTSIM_IapCheckPrepared(iap, dst / HOSTSIM_IAP_SECTOR_SIZE, (dst + count - 1U) / HOSTSIM_IAP_SECTOR_SIZE);
+    if (status != kHOSTSIM_IapSuccess)
+    {
+        return status;
+    }
+    iap->prepared = 0U;
+
+    if (HOSTSIM_IapPowerFails(iap))
+    {
+        /* Part of the bytes are programmed, the last one of them partly. */
+        length = HOSTSIM_IapRandom(iap) % count;
+        iap->flash[dst + length] &= (uint8_t)(data[length] | HOSTSIM_IapRandom(iap));
+    }
+    for (i = 0U; i < length; i++)
+    {
+        iap->flash[dst + i] &= data[i];
+    }
+
+    iap->programs++;
+    iap->programBytes += length;
+    HOSTSIM_IapBusy(iap, (count / HOSTSIM_IAP_PAGE_SIZE) * HOSTSIM_IAP_PROGRAM_US);
+    if (length != count)
+    {
+        HOSTSIM_IapPowerLoss(iap);
+        return kHOSTSIM_IapBusy;
+    }
+
+    return kHOSTSIM_IapSuccess;
+}
+
+static uint32_t HOSTSIM_IapErase(hostsim_iap_model_t *iap, uint32_t startPage, uint32_t endPage)
+{
+    uint32_t pages = endPage - startPage + 1U;
+    uint32_t status;
+    uint32_t page;
+    uint32_t i;
+
+    if ((endPage < startPage) || (endPage >= HOSTSIM_IAP_PAGES))
+    {
+        return kHOSTSIM_IapInvalidSector;
+    }
+    status = HOSTSIM_IapCheckPrepared(iap, startPage / HOSTSIM_IAP_SECTOR_PAGES, endPage / HOSTSIM_IAP_SECTOR_PAGES);
+    if (status != kHOSTSIM_IapSuccess)
+    {
+        return status;
+    }
+    iap->prepared = 0U;
+
+    if (HOSTSIM_IapPowerFails(iap))
+    {
+        /* Part of the pages are erased, the last one of them partly. */
+        pages = HOSTSIM_IapRandom(iap) % (endPage - startPage + 1U);
+        for (i = 0U; i < HOSTSIM_IAP_PAGE_SIZE; i++)
+        {
+            iap->flash[((startPage + pages) * HOSTSIM_IAP_PAGE_SIZE) + i] |= (uint8_t)HOSTSIM_IapRandom(iap);
+        }
+    }
+    for (page = startPage; page < (startPage + pages); page++)
+    {
+        (void)memset(&iap->flash[page * HOSTSIM_IAP_PAGE_SIZE], 0xFF, HOSTSIM_IAP_PAGE_SIZE);
+        iap->pageErases[page]++;
+    }
+
+    iap->erases++;
+    HOSTSIM_IapBusy(iap, HOSTSIM_IAP_ERASE_US);
+    if (pages != (endPage - startPage + 1U))
+    {
+        HOSTSIM_IapPowerLoss(iap);
+        return kHOSTSIM_IapBusy;
+    }
+
+    return kHOSTSIM_IapSuccess;
+}
+
+static uint32_t HOSTSIM_IapBlankCheck(hostsim_iap_model_t *iap, uint32_t startSector, uint32_t endSector)
+{
+    uint32_t i;
+
+    if ((endSector < startSector) || (endSector >= HOSTSIM_IAP_SECTORS))
+    {
+        return kHOSTSIM_IapInvalidSector;
+    }
+    for (i = startSector * HOSTSIM_IAP_SECTOR_SIZE; i < ((endSector + 1U) * HOSTSIM_IAP_SECTOR_SIZE); i++)
+    {
+        if (iap->flash[i] != 0xFFU)
+        {
+            return kHOSTSIM_IapSectorNotBlank;
+        }
+    }
+
+    return kHOSTSIM_IapSuccess;
+}
+
+/* Called by the ROM entry of the device, see FSL_FEATURE_SYSCON_IAP_ENTRY_LOCATION. */
+static void HOSTSIM_IapEntry(uint32_t command[], uint32_t result[])
+{
+    hostsim_iap_model_t *iap = s_iapModel;
+
+    switch (command[0])
+    {
+        case (uint32_t)kIapCmd_IAP_PrepareSectorforWrite:
+            if ((command[2] < command[1]) || (command[2] >= HOSTSIM_IAP_SECTORS))
+            {
+                result[0] = kHOSTSIM_IapInvalidSector;
+                break;
+            }
+            iap->prepared |= ((2ULL << command[2]) - 1U) & ~((1ULL << command[1]) - 1U);
+            result[0] = kHOSTSIM_IapSuccess;
+            break;
+
+        case (uint32_t)kIapCmd_IAP_CopyRamToFlash:
+            result[0] = HOSTSIM_IapProgram(iap, command[1], command[2], command[3]);
+            break;
+
+        case (uint32_t)kIapCmd_IAP_EraseSector:
+            result[0] = ((command[2] < command[1]) || (command[2] >= HOSTSIM_IAP_SECTORS)) ?
+                            kHOSTSIM_IapInvalidSector :
+                            HOSTSIM_IapErase(iap, command[1] * HOSTSIM_IAP_SECTOR_PAGES,
+                                             ((command[2] + 1U) * HOSTSIM_IAP_SECTOR_PAGES) - 1U);
+            break;
+
+        case (uint32_t)kIapCmd_IAP_ErasePage:
+            result[0] = HOSTSIM_IapErase(iap, command[1], command[2]);
+            break;
+
+        case (uint32_t)kIapCmd_IAP_BlankCheckSector:
+            result[0] = HOSTSIM_IapBlankCheck(iap, command[1], command[2]);
+            break;
+
+        case (uint32_t)kIapCmd_IAP_Compare:
+            result[0] = ((command[1] + command[3]) > (uint32_t)FSL_FEATURE_SYSCON_FLASH_SIZE_BYTES) ?
+                            kHOSTSIM_IapDstNotMapped :
+                        (memcmp(&iap->flash[command[1]], (const void *)(uintptr_t)command[2], command[3]) != 0) ?
+                            kHOSTSIM_IapCompareError :
+                            kHOSTSIM_IapSuccess;
+            break;
+
+        default:
+            result[0] = kHOSTSIM_IapInvalidCommand;
+            break;
+    }
+}
+
+status_t HOSTSIM_IapModelInit(hostsim_iap_model_t *iap)
+{
+    /* movabs $HOSTSIM_IapEntry, %rax; jmp *%rax */
+    uint8_t jump[12] = {0x48U, 0xB8U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0xFFU, 0xE0U};
+    uint64_t target  = (uint64_t)(uintptr_t)HOSTSIM_IapEntry;
+    void *entry;
+    void *flash;
+
+    assert(iap != NULL);
+    assert(s_iapModel == NULL);
+
+    entry = mmap((void *)(uintptr_t)HOSTSIM_IAP_ENTRY_PAGE, HOSTSIM_IAP_ENTRY_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    flash = mmap((void *)(uintptr_t)HOSTSIM_IAP_FLASH_BASE, (size_t)FSL_FEATURE_SYSCON_FLASH_SIZE_BYTES,
+                 PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if ((entry != (void *)(uintptr_t)HOSTSIM_IAP_ENTRY_PAGE) || (flash != (void *)(uintptr_t)HOSTSIM_IAP_FLASH_BASE))
+    {
+        if (entry != MAP_FAILED)
+        {
+            (void)munmap(entry, HOSTSIM_IAP_ENTRY_SIZE);
+        }
+        if (flash != MAP_FAILED)
+        {
+            (void)munmap(flash, (size_t)FSL_FEATURE_SYSCON_FLASH_SIZE_BYTES);
+        }
+        return kStatus_Fail;
+    }
+
+    /* The ROM entry is an odd Thumb address, the host runs the jump from there as it is. */
+    (void)memcpy(&jump[2], &target, sizeof(target));
+    (void)memcpy((void *)(uintptr_t)FSL_FEATURE_SYSCON_IAP_ENTRY_LOCATION, jump, sizeof(jump));
+    (void)mprotect(entry, HOSTSIM_IAP_ENTRY_SIZE, PROT_READ | PROT_EXEC);
+
+    (void)memset(iap, 0, sizeof(*iap));
+    iap->flash  = (uint8_t *)flash;
+    iap->random = 1U;
+    (void)memset(iap->flash, 0xFF, (size_t)FSL_FEATURE_SYSCON_FLASH_SIZE_BYTES);
+
+    s_iapModel = iap;
+
+    return kStatus_Success;
+}
+
+void HOSTSIM_IapModelDeinit(hostsim_iap_model_t *iap)
+{
+    assert(s_iapModel == iap);
+
+    (void)munmap((void *)(uintptr_t)HOSTSIM_IAP_ENTRY_PAGE, HOSTSIM_IAP_ENTRY_SIZE);
+    (void)munmap(iap->flash, (size_t)FSL_FEATURE_SYSCON_FLASH_SIZE_BYTES);
+    s_iapModel = NULL;
+}
+
+void HOSTSIM_IapModelSetPowerLoss(hostsim_iap_model_t *iap,
+                                  uint32_t commands,
+                                  hostsim_iap_power_loss_t powerLoss,
+                                  void *userData)
+{
+    assert(iap != NULL);
+
+    iap->powerLossCountdown = commands;
+    iap->powerLoss          = powerLoss;
+    iap->userData           = userData;
+}
@@ -0,0 +1,368 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Runs the unmodified USART, SPI, I2C, DMA and SPI DMA drivers against the register models and
+ * reports the simulated cycles, register traps and interrupts of each driver path.
+ */
+
+#include <stdio.h>
+
+#include "fsl_hostsim_models.h"
+#include "fsl_usart.h"
+#include "fsl_spi.h"
+#include "fsl_i2c.h"
+#include "fsl_dma.h"
+#include "fsl_spi_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_USART_BYTES    (1024U)
+#define BENCH_SPI_BYTES      (256U)
+#define BENCH_I2C_BYTES      (16U)
+#define BENCH_DMA_BYTES      (1024U)
+#define BENCH_SPI_DMA_BYTES  (3000U)
+#define BENCH_BUFFER_SIZE    (3072U)
+#define BENCH_FIFO_SIZE      (2048U)
+#define BENCH_EEPROM_SIZE    (256U)
+#define BENCH_EEPROM_ADDR    (0x50U)
+#define BENCH_DMA_CHANNEL    (0U)
+#define BENCH_SPI_RX_CHANNEL (10U) /* SPI0_RX_DMA request */
+#define BENCH_SPI_TX_CHANNEL (11U) /* SPI0_TX_DMA request */
+
+typedef struct _bench_sample
+{
+    uint64_t cycles;
+    hostsim_stats_t stats;
+} bench_sample_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Buffers seen by the DMA must have 32-bit addresses, they are static in a non-PIE program. */
+static uint16_t s_txFifoBuffer[BENCH_FIFO_SIZE];
+static uint16_t s_rxFifoBuffer[BENCH_FIFO_SIZE];
+static hostsim_fifo_t s_txFifo;
+static hostsim_fifo_t s_rxFifo;
+static uint8_t s_eeprom[BENCH_EEPROM_SIZE];
+static uint8_t s_txData[BENCH_BUFFER_SIZE];
+static uint8_t s_rxData[BENCH_BUFFER_SIZE];
+
+static hostsim_usart_model_t s_usartModel;
+static hostsim_spi_model_t s_spiModel;
+static hostsim_i2c_model_t s_i2cModel;
+static hostsim_dma_model_t s_dmaModel;
+
+static usart_handle_t s_usartHandle;
+static dma_handle_t s_dmaHandle;
+static dma_handle_t s_spiTxDmaHandle;
+static dma_handle_t s_spiRxDmaHandle;
+static spi_dma_handle_t s_spiDmaHandle;
+static volatile bool s_usartRxDone;
+static volatile bool s_dmaDone;
+static volatile status_t s_spiDmaStatus;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void BENCH_Start(bench_sample_t *sample)
+{
+    HOSTSIM_GetStats(&sample->stats);
+    sample->cycles = HOSTSIM_GetCycles();
+}
+
+static void BENCH_Report(const char *name, const bench_sample_t *start, uint32_t bytes, status_t status)
+{
+    hostsim_stats_t stats;
+    uint64_t cycles = HOSTSIM_GetCycles() - start->cycles;
+
+    HOSTSIM_GetStats(&stats);
+    (void)printf("%-28s %6u bytes %10llu cycles %8.1f cycles/byte %6u traps %5u irqs  %s\r\n", name,
+                 (unsigned int)bytes, (unsigned long long)cycles, (double)cycles / (double)bytes,
+                 (unsigned int)(stats.trapCount - start->stats.trapCount),
+                 (unsigned int)(stats.irqCount - start->stats.irqCount),
+                 (status == kStatus_Success) ? "ok" : "FAILED");
+}
+
+static void BENCH_UsartCallback(USART_Type *base, usart_handle_t *handle, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)userData;
+
+    if (status == kStatus_USART_RxIdle)
+    {
+        s_usartRxDone = true;
+    }
+}
+
+static void BENCH_DmaCallback(dma_handle_t *handle, void *userData, bool transferDone, uint32_t intmode)
+{
+    (void)handle;
+    (void)userData;
+    (void)intmode;
+
+    if (transferDone)
+    {
+        s_dmaDone = true;
+    }
+}
+
+static void BENCH_SpiDmaCallback(SPI_Type *base, spi_dma_handle_t *handle, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)userData;
+
+    s_spiDmaStatus = status;
+}
+
+static void BENCH_Usart(void)
+{
+    usart_config_t config;
+    usart_transfer_t xfer;
+    bench_sample_t sample;
+    status_t status;
+    uint32_t i;
+    uint16_t frame;
+
+    for (i = 0U; i < BENCH_BUFFER_SIZE; i++)
+    {
+        s_txData[i] = (uint8_t)(i * 7U);
+    }
+
+    HOSTSIM_FifoInit(&s_txFifo, s_txFifoBuffer, BENCH_FIFO_SIZE);
+    HOSTSIM_FifoInit(&s_rxFifo, s_rxFifoBuffer, BENCH_FIFO_SIZE);
+    HOSTSIM_UsartModelInit(&s_usartModel, USART0, USART0_IRQn, &s_txFifo, &s_rxFifo);
+
+    USART_GetDefaultConfig(&config);
+    config.enableTx = true;
+    config.enableRx = true;
+    (void)USART_Init(USART0, &config, CLOCK_GetFreq(kCLOCK_MainClk));
+
+    BENCH_Start(&sample);
+    status = USART_WriteBlocking(USART0, s_txData, BENCH_USART_BYTES);
+    for (i = 0U; (i < BENCH_USART_BYTES) && (status == kStatus_Success); i++)
+    {
+        if ((!HOSTSIM_FifoPop(&s_txFifo, &frame)) || ((uint8_t)frame != s_txData[i]))
+        {
+            status = kStatus_Fail;
+        }
+    }
+    BENCH_Report("USART write blocking", &sample, BENCH_USART_BYTES, status);
+
+    (void)USART_TransferCreateHandle(USART0, &s_usartHandle, BENCH_UsartCallback, NULL);
+    xfer.rxData   = s_rxData;
+    xfer.dataSize = BENCH_USART_BYTES;
+    s_usartRxDone = false;
+
+    BENCH_Start(&sample);
+    status = USART_TransferReceiveNonBlocking(USART0, &s_usartHandle, &xfer, NULL);
+    (void)HOSTSIM_UsartModelReceive(&s_usartModel, s_txData, BENCH_USART_BYTES);
+    while (!s_usartRxDone)
+    {
+        __WFI();
+    }
+    if ((status == kStatus_Success) && (memcmp(s_rxData, s_txData, BENCH_USART_BYTES) != 0))
+    {
+        status = kStatus_Fail;
+    }
+    BENCH_Report("USART receive interrupt", &sample, BENCH_USART_BYTES, status);
+
+    USART_Deinit(USART0);
+}
+
+static void BENCH_Spi(void)
+{
+    spi_master_config_t config;
+    spi_transfer_t xfer;
+    bench_sample_t sample;
+    status_t status;
+
+    HOSTSIM_SpiModelInit(&s_spiModel, SPI0, SPI0_IRQn, NULL, NULL);
+
+    SPI_MasterGetDefaultConfig(&config);
+    config.enableLoopback = true;
+    (void)SPI_MasterInit(SPI0, &config, CLOCK_GetFreq(kCLOCK_MainClk));
+
+    (void)memset(s_rxData, 0, BENCH_SPI_BYTES);
+    xfer.txData      = s_txData;
+    xfer.rxData      = s_rxData;
+    xfer.dataSize    = BENCH_SPI_BYTES;
+    xfer.configFlags = (uint32_t)kSPI_EndOfTransfer;
+
+    BENCH_Start(&sample);
+    status = SPI_MasterTransferBlocking(SPI0, &xfer);
+    if ((status == kStatus_Success) && (memcmp(s_rxData, s_txData, BENCH_SPI_BYTES) != 0))
+    {
+        status = kStatus_Fail;
+    }
+    BENCH_Report("SPI loopback blocking", &sample, BENCH_SPI_BYTES, status);
+
+    SPI_Deinit(SPI0);
+}
+
+static void BENCH_I2c(void)
+{
+    i2c_master_config_t config;
+    i2c_master_transfer_t xfer;
+    bench_sample_t sample;
+    status_t status;
+
+    HOSTSIM_I2cModelInit(&s_i2cModel, I2C0, I2C0_IRQn, BENCH_EEPROM_ADDR, s_eeprom, BENCH_EEPROM_SIZE);
+
+    I2C_MasterGetDefaultConfig(&config);
+    I2C_MasterInit(I2C0, &config, CLOCK_GetFreq(kCLOCK_MainClk));
+
+    (void)memset(&xfer, 0, sizeof(xfer));
+    xfer.slaveAddress   = BENCH_EEPROM_ADDR;
+    xfer.subaddress     = 0x10U;
+    xfer.subaddressSize = 1U;
+    xfer.data           = s_txData;
+    xfer.dataSize       = BENCH_I2C_BYTES;
+    xfer.direction      = kI2C_Write;
+
+    BENCH_Start(&sample);
+    status = I2C_MasterTransferBlocking(I2C0, &xfer);
+    if ((status == kStatus_Success) && (memcmp(&s_eeprom[0x10U], s_txData, BENCH_I2C_BYTES) != 0))
+    {
+        status = kStatus_Fail;
+    }
+    BENCH_Report("I2C EEPROM write blocking", &sample, BENCH_I2C_BYTES, status);
+
+    (void)memset(s_rxData, 0, BENCH_I2C_BYTES);
+    xfer.data      = s_rxData;
+    xfer.direction = kI2C_Read;
+
+    BENCH_Start(&sample);
+    status = I2C_MasterTransferBlocking(I2C0, &xfer);
+    if ((status == kStatus_Success) && (memcmp(s_rxData, s_txData, BENCH_I2C_BYTES) != 0))
+    {
+        status = kStatus_Fail;
+    }
+    BENCH_Report("I2C EEPROM read blocking", &sample, BENCH_I2C_BYTES, status);
+
+    I2C_MasterDeinit(I2C0);
+}
+
+static void BENCH_Dma(void)
+{
+    dma_transfer_config_t config;
+    bench_sample_t sample;
+    status_t status;
+
+    HOSTSIM_DmaModelInit(&s_dmaModel, DMA0);
+
+    DMA_Init(DMA0);
+    DMA_EnableChannel(DMA0, BENCH_DMA_CHANNEL);
+    DMA_CreateHandle(&s_dmaHandle, DMA0, BENCH_DMA_CHANNEL);
+    DMA_SetCallback(&s_dmaHandle, BENCH_DmaCallback, NULL);
+
+    (void)memset(s_rxData, 0, BENCH_DMA_BYTES);
+    DMA_PrepareTransfer(&config, s_txData, s_rxData, sizeof(uint32_t), BENCH_DMA_BYTES, kDMA_MemoryToMemory, NULL);
+    s_dmaDone = false;
+
+    BENCH_Start(&sample);
+    status = DMA_SubmitTransfer(&s_dmaHandle, &config);
+    DMA_StartTransfer(&s_dmaHandle);
+    while (!s_dmaDone)
+    {
+        __WFI();
+    }
+    if ((status == kStatus_Success) && (memcmp(s_rxData, s_txData, BENCH_DMA_BYTES) != 0))
+    {
+        status = kStatus_Fail;
+    }
+    BENCH_Report("DMA memory to memory", &sample, BENCH_DMA_BYTES, status);
+
+    DMA_Deinit(DMA0);
+}
+
+static void BENCH_SpiDma(void)
+{
+    spi_master_config_t config;
+    spi_transfer_t xfer;
+    bench_sample_t sample;
+    status_t status;
+    size_t count;
+
+    /* Fresh SPI and DMA models, the ones of the previous cases are still attached. */
+    HOSTSIM_DetachModel(&s_spiModel.model);
+    HOSTSIM_DetachModel(&s_dmaModel.model);
+    HOSTSIM_SpiModelInit(&s_spiModel, SPI0, SPI0_IRQn, NULL, NULL);
+    HOSTSIM_DmaModelInit(&s_dmaModel, DMA0);
+    HOSTSIM_DmaModelConnect(&s_dmaModel, BENCH_SPI_RX_CHANNEL, (uint32_t)SPI0, (uint32_t)kHOSTSIM_DmaRequestRx);
+    HOSTSIM_DmaModelConnect(&s_dmaModel, BENCH_SPI_TX_CHANNEL, (uint32_t)SPI0, (uint32_t)kHOSTSIM_DmaRequestTx);
+
+    SPI_MasterGetDefaultConfig(&config);
+    config.enableLoopback = true;
+    (void)SPI_MasterInit(SPI0, &config, CLOCK_GetFreq(kCLOCK_MainClk));
+
+    DMA_Init(DMA0);
+    DMA_EnableChannel(DMA0, BENCH_SPI_RX_CHANNEL);
+    DMA_EnableChannel(DMA0, BENCH_SPI_TX_CHANNEL);
+    DMA_CreateHandle(&s_spiRxDmaHandle, DMA0, BENCH_SPI_RX_CHANNEL);
+    DMA_CreateHandle(&s_spiTxDmaHandle, DMA0, BENCH_SPI_TX_CHANNEL);
+    (void)SPI_MasterTransferCreateHandleDMA(SPI0, &s_spiDmaHandle, BENCH_SpiDmaCallback, NULL, &s_spiTxDmaHandle,
+                                            &s_spiRxDmaHandle);
+
+    /* More than DMA_MAX_TRANSFER_COUNT frames, so the transfer runs through the link descriptors. */
+    (void)memset(s_rxData, 0, BENCH_SPI_DMA_BYTES);
+    xfer.txData      = s_txData;
+    xfer.rxData      = s_rxData;
+    xfer.dataSize    = BENCH_SPI_DMA_BYTES;
+    xfer.configFlags = (uint32_t)kSPI_EndOfTransfer;
+    s_spiDmaStatus   = kStatus_SPI_Busy;
+
+    BENCH_Start(&sample);
+    status = SPI_MasterTransferDMA(SPI0, &s_spiDmaHandle, &xfer);
+    while (s_spiDmaStatus == kStatus_SPI_Busy)
+    {
+        __WFI();
+    }
+    if (status == kStatus_Success)
+    {
+        status = s_spiDmaStatus;
+    }
+    if ((status == kStatus_Success) && ((memcmp(s_rxData, s_txData, BENCH_SPI_DMA_BYTES) != 0) ||
+                                        ((SPI_GetStatusFlags(SPI0) & (uint32_t)kSPI_MasterIdleFlag) == 0U) ||
+                                        (SPI_MasterTransferGetCountDMA(SPI0, &s_spiDmaHandle, &count) !=
+                                         kStatus_NoTransferInProgress)))
+    {
+        status = kStatus_Fail;
+    }
+    BENCH_Report("SPI loopback DMA", &sample, BENCH_SPI_DMA_BYTES, status);
+
+    DMA_Deinit(DMA0);
+    SPI_Deinit(SPI0);
+}
+
+int main(void)
+{
+    hostsim_stats_t stats;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    BENCH_Usart();
+    BENCH_Spi();
+    BENCH_I2c();
+    BENCH_Dma();
+    BENCH_SpiDma();
+
+    HOSTSIM_GetStats(&stats);
+    (void)printf("total: %u traps, %u irqs, %u ticks, core clock %u Hz\r\n", (unsigned int)stats.trapCount,
+                 (unsigned int)stats.irqCount, (unsigned int)stats.tickCount, (unsigned int)SystemCoreClock);
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,569 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Replays a recorded touch trace of five keys and a four-pin slider through the CAPT model. The
+ * interrupt per measurement of the capt_key example runs against the touch pipeline with the DMA,
+ * once scanning all the time and once with the low-power mode between the touches. Reports the
+ * handler cycles, traps and interrupts per polling round and checks the decoded touches against the
+ * trace. The trace drifts like a temperature change, a baseline calibrated once sees false touches.
+ */
+
+#include <stdio.h>
+
+#include "fsl_hostsim_models.h"
+#include "fsl_capt_touch.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_ROUNDS              (1500U)
+#define BENCH_KEYS                (5U) /* X0 to X4 */
+#define BENCH_SLIDER_PINS         (4U) /* X5 to X8 */
+#define BENCH_PINS                (BENCH_KEYS + BENCH_SLIDER_PINS)
+#define BENCH_XPINS               ((1U << BENCH_PINS) - 1U)
+#define BENCH_KEY_PINS            ((1U << BENCH_KEYS) - 1U)
+#define BENCH_BASE_COUNT          (900U)
+#define BENCH_DRIFT               (85U) /* Counts towards a touch at the middle of the trace. */
+#define BENCH_NOISE               (6U) /* Counts of uniform noise on each side. */
+#define BENCH_TOUCH               (130U) /* Counts of a finger on a pin. */
+#define BENCH_GLITCH_PERIOD       (97U) /* Rounds between single-measurement glitches. */
+#define BENCH_GLITCH              (150U)
+#define BENCH_SLIDER_RANGE        (256U)
+#define BENCH_SWIPE_START         (1330U)
+#define BENCH_SWIPE_ROUNDS        (80U)
+#define BENCH_DETECT_MARGIN       (8U) /* Rounds after a touch in which its detection counts. */
+#define BENCH_ISR_WINDOW          (4U) /* Rounds of the window average of the capt_key example. */
+#define BENCH_ISR_THRESHOLD       (60U)
+#define BENCH_ISR_RELEASE         (40U)
+#define BENCH_ISR_CALIBRATION     (8U)
+#define BENCH_IDLE_ROUNDS         (100U)
+#define BENCH_LOW_POWER_THRESHOLD (40U)
+#define BENCH_CAPT_DMA_CHANNEL    (24U) /* CAPT_DMA request */
+
+typedef struct _bench_touch
+{
+    uint8_t pin;
+    uint16_t start;
+    uint16_t rounds;
+} bench_touch_t;
+
+typedef struct _bench_result
+{
+    uint64_t handlerCycles;
+    uint32_t traps;
+    uint32_t irqs;
+    uint32_t scanRounds;
+    uint32_t detected;
+    uint32_t missed;
+    uint32_t falseTouches;
+    uint32_t wakeUps;
+    uint32_t sliderUpdates;
+    uint32_t sliderError;
+    uint32_t sliderSamples;
+} bench_result_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* The recorded touches, X2 and X3 together once, X0 to X1 near the peak of the drift. */
+static const bench_touch_t s_touches[] = {
+    {0U, 60U, 25U},   {1U, 150U, 30U}, {2U, 240U, 40U}, {3U, 240U, 40U}, {4U, 330U, 60U},
+    {0U, 650U, 25U},  {2U, 720U, 30U}, {1U, 800U, 25U}, {3U, 1250U, 30U}, {4U, 1460U, 20U},
+};
+
+static const uint8_t s_sliderPins[BENCH_SLIDER_PINS] = {5U, 6U, 7U, 8U};
+
+static uint16_t s_trace[BENCH_ROUNDS][BENCH_PINS];
+static uint16_t s_combined[BENCH_ROUNDS];
+
+static hostsim_capt_model_t s_captModel;
+static hostsim_dma_model_t s_dmaModel;
+
+/* Descriptors and the handle holding the buffer are seen by the DMA, they need 32-bit addresses. */
+DMA_ALLOCATE_LINK_DESCRIPTORS(s_captDescriptors, CAPT_TOUCH_DESCRIPTOR_NUM);
+static capt_touch_handle_t s_touchHandle;
+static dma_handle_t s_dmaHandle;
+
+static volatile uint32_t s_traceRound;
+static volatile bool s_usePipeline;
+static uint64_t s_handlerCycles;
+static uint16_t s_lastKeys;
+static uint32_t s_press[BENCH_ROUNDS];
+static bench_result_t *s_result;
+
+/* State of the capt_key style handler. */
+static uint16_t s_isrWindow[BENCH_PINS][BENCH_ISR_WINDOW];
+static uint32_t s_isrBaseline[BENCH_PINS];
+static uint32_t s_isrRounds;
+static uint16_t s_isrKeys;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t BENCH_Random(uint32_t *state)
+{
+    *state = (*state * 1664525U) + 1013904223U;
+
+    return *state >> 8;
+}
+
+/* Count a finger takes from a key pin, ramps of three rounds at both ends. */
+static uint32_t BENCH_KeyTouch(uint32_t pin, uint32_t round)
+{
+    uint32_t touch = 0U;
+    uint32_t edge;
+    uint32_t i;
+
+    for (i = 0U; i < ARRAY_SIZE(s_touches); i++)
+    {
+        if ((s_touches[i].pin == pin) && (round >= s_touches[i].start) &&
+            (round < (uint32_t)s_touches[i].start + s_touches[i].rounds))
+        {
+            edge = round - s_touches[i].start;
+            edge = MIN(edge, (uint32_t)s_touches[i].start + s_touches[i].rounds - 1U - round);
+            touch += (edge >= 2U) ? BENCH_TOUCH : (BENCH_TOUCH * (edge + 1U)) / 3U;
+        }
+    }
+
+    return touch;
+}
+
+/* Finger position on the slider in 1/256 pin, the swipe goes from the first pin to the last one. */
+static uint32_t BENCH_SwipePosition(uint32_t round)
+{
+    return ((round - BENCH_SWIPE_START) * (BENCH_SLIDER_PINS - 1U) * 256U) / (BENCH_SWIPE_ROUNDS - 1U);
+}
+
+static uint32_t BENCH_SliderTouch(uint32_t index, uint32_t round)
+{
+    uint32_t position;
+    uint32_t distance;
+
+    if ((round < BENCH_SWIPE_START) || (round >= (BENCH_SWIPE_START + BENCH_SWIPE_ROUNDS)))
+    {
+        return 0U;
+    }
+
+    /* The finger covers 1.3 pins. */
+    position = BENCH_SwipePosition(round);
+    distance = (position > (index * 256U)) ? (position - (index * 256U)) : ((index * 256U) - position);
+
+    return (distance >= 333U) ? 0U : (BENCH_TOUCH * (333U - distance)) / 333U;
+}
+
+/*
+ * The trace as recorded on a board: counts drift down by BENCH_DRIFT and back with the temperature,
+ * with noise and single-measurement glitches. The combined count of the low-power rounds is the mean
+ * of the pins, a finger takes half its count of a pin from it.
+ */
+static void BENCH_RecordTrace(void)
+{
+    uint32_t seed = 0x5EEDU;
+    uint32_t round;
+    uint32_t pin;
+    uint32_t drift;
+    uint32_t touch;
+    uint32_t sum;
+    uint32_t touchSum;
+    int32_t count;
+
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        drift    = (BENCH_DRIFT * MIN(round, BENCH_ROUNDS - round)) / (BENCH_ROUNDS / 2U);
+        sum      = 0U;
+        touchSum = 0U;
+        for (pin = 0U; pin < BENCH_PINS; pin++)
+        {
+            touch = (pin < BENCH_KEYS) ? BENCH_KeyTouch(pin, round) : BENCH_SliderTouch(pin - BENCH_KEYS, round);
+            count = (int32_t)(BENCH_BASE_COUNT + (pin * 25U)) - (int32_t)drift - (int32_t)touch +
+                    (int32_t)(BENCH_Random(&seed) % ((2U * BENCH_NOISE) + 1U)) - (int32_t)BENCH_NOISE;
+            if ((round % BENCH_GLITCH_PERIOD) == (pin * 11U))
+            {
+                count -= (int32_t)BENCH_GLITCH;
+            }
+            s_trace[round][pin] = (uint16_t)count;
+            sum += (uint32_t)count + touch;
+            touchSum += touch;
+        }
+        s_combined[round] = (uint16_t)((sum / BENCH_PINS) - (touchSum / 2U));
+    }
+}
+
+/* The CAPT measures the pins of a round in order, X0 starts the next row of the trace. */
+static uint16_t BENCH_Sample(void *userData, uint16_t xpins)
+{
+    uint32_t round;
+
+    (void)userData;
+
+    if ((xpins & 1U) != 0U)
+    {
+        s_traceRound++;
+    }
+    round = MIN(s_traceRound, BENCH_ROUNDS) - 1U;
+
+    if ((xpins & (xpins - 1U)) != 0U)
+    {
+        return s_combined[round];
+    }
+
+    return s_trace[round][__builtin_ctz(xpins)];
+}
+
+static uint32_t BENCH_Round(void)
+{
+    return MIN(s_traceRound, BENCH_ROUNDS) - 1U;
+}
+
+/* Counts the key presses and the slider error, a press is detected when the keys gain a pin. */
+static void BENCH_Decoded(uint16_t keys, uint16_t sliderPosition)
+{
+    uint32_t round   = BENCH_Round();
+    uint16_t pressed = (uint16_t)(keys & ~s_lastKeys);
+    uint32_t expected;
+
+    s_press[round] |= pressed;
+    s_lastKeys = keys;
+
+    if ((sliderPosition != (uint16_t)CAPT_TOUCH_SLIDER_RELEASED) && (round >= BENCH_SWIPE_START) &&
+        (round < (BENCH_SWIPE_START + BENCH_SWIPE_ROUNDS)))
+    {
+        expected = (BENCH_SwipePosition(round) * (BENCH_SLIDER_RANGE - 1U)) / ((BENCH_SLIDER_PINS - 1U) * 256U);
+        s_result->sliderError +=
+            (sliderPosition > expected) ? (sliderPosition - expected) : (expected - sliderPosition);
+        s_result->sliderSamples++;
+    }
+}
+
+/* Matches the presses with the recorded touches. */
+static void BENCH_Check(bench_result_t *result)
+{
+    uint32_t i;
+    uint32_t round;
+    uint32_t end;
+    uint32_t bit;
+
+    for (i = 0U; i < ARRAY_SIZE(s_touches); i++)
+    {
+        bit = 1UL << s_touches[i].pin;
+        end = MIN((uint32_t)s_touches[i].start + s_touches[i].rounds + BENCH_DETECT_MARGIN, BENCH_ROUNDS);
+        for (round = s_touches[i].start; round < end; round++)
+        {
+            if ((s_press[round] & bit) != 0U)
+            {
+                s_press[round] &= ~bit;
+                break;
+            }
+        }
+        if (round < end)
+        {
+            result->detected++;
+        }
+        else
+        {
+            result->missed++;
+        }
+    }
+
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        result->falseTouches += (uint32_t)__builtin_popcount(s_press[round]);
+    }
+}
+
+void DMA0_DriverIRQHandler(void);
+
+void DMA0_IRQHandler(void)
+{
+    uint64_t start = HOSTSIM_GetCycles();
+
+    DMA0_DriverIRQHandler();
+    s_handlerCycles += HOSTSIM_GetCycles() - start;
+}
+
+/* The capt_key example: every measurement interrupts, a window average against a fixed baseline. */
+static void BENCH_IsrMeasurement(void)
+{
+    capt_touch_data_t data;
+    uint32_t pin;
+    uint32_t sum;
+    uint32_t i;
+
+    CAPT_ClearInterruptStatusFlags(CAPT, CAPT_GetInterruptStatusFlags(CAPT));
+    if (!CAPT_GetTouchData(CAPT, &data) || (data.XpinsIndex >= BENCH_PINS))
+    {
+        return;
+    }
+
+    s_isrWindow[data.XpinsIndex][s_isrRounds % BENCH_ISR_WINDOW] = data.count;
+    if (data.XpinsIndex != (BENCH_PINS - 1U))
+    {
+        return;
+    }
+
+    s_isrRounds++;
+    if (s_isrRounds < BENCH_ISR_WINDOW)
+    {
+        return;
+    }
+
+    for (pin = 0U; pin < BENCH_PINS; pin++)
+    {
+        sum = 0U;
+        for (i = 0U; i < BENCH_ISR_WINDOW; i++)
+        {
+            sum += s_isrWindow[pin][i];
+        }
+        sum /= BENCH_ISR_WINDOW;
+
+        if (s_isrRounds < (BENCH_ISR_WINDOW + BENCH_ISR_CALIBRATION))
+        {
+            s_isrBaseline[pin] += sum;
+            if (s_isrRounds == (BENCH_ISR_WINDOW + BENCH_ISR_CALIBRATION - 1U))
+            {
+                s_isrBaseline[pin] /= BENCH_ISR_CALIBRATION;
+            }
+        }
+        else if ((sum + BENCH_ISR_THRESHOLD) < s_isrBaseline[pin])
+        {
+            s_isrKeys |= (uint16_t)(1U << pin);
+        }
+        else if ((sum + BENCH_ISR_RELEASE) >= s_isrBaseline[pin])
+        {
+            s_isrKeys &= (uint16_t)~(1U << pin);
+        }
+        else
+        {
+            /* Hysteresis. */
+        }
+    }
+
+    s_result->scanRounds++;
+    BENCH_Decoded(s_isrKeys & BENCH_KEY_PINS, (uint16_t)CAPT_TOUCH_SLIDER_RELEASED);
+}
+
+void CMP_CAPT_IRQHandler(void)
+{
+    uint64_t start = HOSTSIM_GetCycles();
+
+    if (s_usePipeline)
+    {
+        CAPT_TouchHandleIRQ(CAPT, &s_touchHandle);
+    }
+    else
+    {
+        BENCH_IsrMeasurement();
+    }
+    s_handlerCycles += HOSTSIM_GetCycles() - start;
+}
+
+static void BENCH_TouchCallback(CAPT_Type *base, capt_touch_handle_t *handle, uint32_t events, void *userData)
+{
+    (void)base;
+    (void)userData;
+
+    if ((events & ((uint32_t)kCAPT_TouchEventKeys | (uint32_t)kCAPT_TouchEventSlider)) != 0U)
+    {
+        BENCH_Decoded(CAPT_TouchGetKeys(handle), CAPT_TouchGetSliderPosition(handle));
+    }
+    if ((events & (uint32_t)kCAPT_TouchEventSlider) != 0U)
+    {
+        s_result->sliderUpdates++;
+    }
+}
+
+/* Fresh CAPT and DMA models, the CAPT polls every 1 ms. */
+static void BENCH_InitCapt(void)
+{
+    capt_config_t config;
+
+    HOSTSIM_DetachModel(&s_captModel.model);
+    HOSTSIM_DetachModel(&s_dmaModel.model);
+
+    HOSTSIM_CaptModelInit(&s_captModel, CAPT, BENCH_Sample, NULL);
+    HOSTSIM_DmaModelInit(&s_dmaModel, DMA0);
+    HOSTSIM_DmaModelConnect(&s_dmaModel, BENCH_CAPT_DMA_CHANNEL, (uint32_t)CAPT, kHOSTSIM_DmaRequestRx);
+
+    CAPT_GetDefaultConfig(&config);
+    config.enableXpins  = (uint16_t)BENCH_XPINS;
+    config.clockDivider = 2U;
+    config.pollCount    = 1U;
+    CAPT_Init(CAPT, &config);
+    CAPT_SetThreshold(CAPT, 0U);
+
+    s_traceRound = 0U;
+    s_lastKeys   = 0U;
+    (void)memset(s_press, 0, sizeof(s_press));
+    s_handlerCycles = 0U;
+}
+
+static void BENCH_Report(const char *name, bench_result_t *result, const hostsim_stats_t *start)
+{
+    hostsim_stats_t stats;
+
+    HOSTSIM_GetStats(&stats);
+    result->handlerCycles = s_handlerCycles;
+    result->traps         = stats.trapCount - start->trapCount;
+    result->irqs          = stats.irqCount - start->irqCount;
+    BENCH_Check(result);
+
+    (void)printf("%-20s %4u scans %8.1f cycles/round %6.2f traps/round %5.2f irqs/round  "
+                 "keys %2u/%2u false %3u  wake-ups %2u  slider %3u updates err %5.1f  %s\r\n",
+                 name, (unsigned int)result->scanRounds, (double)result->handlerCycles / (double)BENCH_ROUNDS,
+                 (double)result->traps / (double)BENCH_ROUNDS, (double)result->irqs / (double)BENCH_ROUNDS,
+                 (unsigned int)result->detected, (unsigned int)ARRAY_SIZE(s_touches),
+                 (unsigned int)result->falseTouches, (unsigned int)result->wakeUps,
+                 (unsigned int)result->sliderUpdates,
+                 (result->sliderSamples != 0U) ? ((double)result->sliderError / (double)result->sliderSamples) : 0.0,
+                 ((result->missed == 0U) && (result->falseTouches == 0U)) ? "ok" : "errors");
+}
+
+static void BENCH_Isr(void)
+{
+    bench_result_t result = {0};
+    hostsim_stats_t start;
+
+    BENCH_InitCapt();
+    s_result      = &result;
+    s_usePipeline = false;
+    s_isrRounds   = 0U;
+    s_isrKeys     = 0U;
+    (void)memset(s_isrBaseline, 0, sizeof(s_isrBaseline));
+
+    HOSTSIM_GetStats(&start);
+    CAPT_EnableInterrupts(CAPT, (uint32_t)kCAPT_InterruptOfYesTouchEnable | (uint32_t)kCAPT_InterruptOfNoTouchEnable |
+                                    (uint32_t)kCAPT_InterruptOfTimeOutEnable);
+    EnableIRQ(CMP_CAPT_IRQn);
+    CAPT_SetPollMode(CAPT, kCAPT_PollContinuousMode);
+
+    while (s_traceRound < BENCH_ROUNDS)
+    {
+        __WFI();
+    }
+
+    CAPT_SetPollMode(CAPT, kCAPT_PollInactiveMode);
+    DisableIRQ(CMP_CAPT_IRQn);
+    BENCH_Report("interrupt capt_key", &result, &start);
+    CAPT_Deinit(CAPT);
+}
+
+static void BENCH_Pipeline(const char *name, uint16_t idleRounds)
+{
+    bench_result_t result = {0};
+    capt_touch_config_t config;
+    capt_touch_stats_t stats;
+    hostsim_stats_t start;
+
+    BENCH_InitCapt();
+    s_result      = &result;
+    s_usePipeline = true;
+
+    DMA_Init(DMA0);
+    DMA_EnableChannel(DMA0, BENCH_CAPT_DMA_CHANNEL);
+    DMA_CreateHandle(&s_dmaHandle, DMA0, BENCH_CAPT_DMA_CHANNEL);
+
+    CAPT_TouchGetDefaultConfig(&config);
+    config.keyPins            = (uint16_t)BENCH_KEY_PINS;
+    config.sliderPins         = s_sliderPins;
+    config.sliderPinCount     = BENCH_SLIDER_PINS;
+    config.sliderRange        = BENCH_SLIDER_RANGE;
+    config.lowPowerIdleRounds = idleRounds;
+    config.lowPowerThreshold  = BENCH_LOW_POWER_THRESHOLD;
+    (void)CAPT_TouchCreateHandle(CAPT, &s_touchHandle, &config, BENCH_TouchCallback, NULL, &s_dmaHandle,
+                                 s_captDescriptors);
+
+    HOSTSIM_GetStats(&start);
+    EnableIRQ(CMP_CAPT_IRQn);
+    (void)CAPT_TouchStart(CAPT, &s_touchHandle);
+
+    while (s_traceRound < BENCH_ROUNDS)
+    {
+        __WFI();
+    }
+
+    CAPT_TouchStop(CAPT, &s_touchHandle);
+    DisableIRQ(CMP_CAPT_IRQn);
+    CAPT_TouchGetStats(&s_touchHandle, &stats);
+    result.scanRounds = stats.rounds;
+    result.wakeUps    = stats.wakeUps;
+    BENCH_Report(name, &result, &start);
+    CAPT_Deinit(CAPT);
+    DMA_Deinit(DMA0);
+}
+
+/* The recorded rows fed straight to the round processing, the cost of the batch without the I/O. */
+static void BENCH_Replay(void)
+{
+    static uint32_t samples[BENCH_ROUNDS][BENCH_PINS];
+    bench_result_t result = {0};
+    capt_touch_config_t config;
+    hostsim_stats_t stats;
+    uint64_t start;
+    uint32_t round;
+    uint32_t pin;
+    uint32_t events;
+
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        for (pin = 0U; pin < BENCH_PINS; pin++)
+        {
+            samples[round][pin] = CAPT_TOUCH_COUNT(s_trace[round][pin]) | CAPT_TOUCH_XVAL(pin);
+        }
+    }
+
+    BENCH_InitCapt();
+    s_result = &result;
+    DMA_Init(DMA0);
+    DMA_CreateHandle(&s_dmaHandle, DMA0, BENCH_CAPT_DMA_CHANNEL);
+
+    CAPT_TouchGetDefaultConfig(&config);
+    config.keyPins        = (uint16_t)BENCH_KEY_PINS;
+    config.sliderPins     = s_sliderPins;
+    config.sliderPinCount = BENCH_SLIDER_PINS;
+    config.sliderRange    = BENCH_SLIDER_RANGE;
+    (void)CAPT_TouchCreateHandle(CAPT, &s_touchHandle, &config, NULL, NULL, &s_dmaHandle, s_captDescriptors);
+
+    HOSTSIM_GetStats(&stats);
+    start = HOSTSIM_GetCycles();
+    for (round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        s_traceRound = round + 1U;
+        events       = CAPT_TouchProcessRound(&s_touchHandle, samples[round], BENCH_PINS);
+        if ((events & ((uint32_t)kCAPT_TouchEventKeys | (uint32_t)kCAPT_TouchEventSlider)) != 0U)
+        {
+            BENCH_Decoded(CAPT_TouchGetKeys(&s_touchHandle), CAPT_TouchGetSliderPosition(&s_touchHandle));
+            result.sliderUpdates += ((events & (uint32_t)kCAPT_TouchEventSlider) != 0U) ? 1U : 0U;
+        }
+    }
+    s_handlerCycles   = HOSTSIM_GetCycles() - start;
+    result.scanRounds = BENCH_ROUNDS;
+
+    BENCH_Report("replay batch", &result, &stats);
+    CAPT_Deinit(CAPT);
+    DMA_Deinit(DMA0);
+}
+
+int main(void)
+{
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    BENCH_RecordTrace();
+
+    BENCH_Replay();
+    BENCH_Isr();
+    BENCH_Pipeline("pipeline DMA", 0U);
+    BENCH_Pipeline("pipeline low-power", BENCH_IDLE_ROUNDS);
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
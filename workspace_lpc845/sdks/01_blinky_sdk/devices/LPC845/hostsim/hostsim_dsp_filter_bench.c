@@ -0,0 +1,414 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Checks the Cortex-M0 family kernels of the fast Q15 filters of CMSIS-DSP against the generic C
+ * kernels they replace, built from the same sources without CMSIS_DSP_CM0_FAST_Q15, once as the SDK
+ * builds them and once with ARM_MATH_LOOPUNROLL. The FIR and the biquad DF1 run with tap and stage
+ * counts around CMSIS_DSP_CM0_FIR_TAPS, random block lengths and random
+ * coefficients over white noise at full scale, the same noise scaled down and a square wave between
+ * the limits, so that the 32-bit accumulators wrap and the outputs saturate. Every output must be
+ * bit exact. The generic FIR takes even tap counts only, an odd filter runs there with a zero
+ * coefficient in front of the oldest sample. The moving average has no generic kernel, it is checked against the sum of the window
+ * computed for every output and against its own unrolled build.
+ *
+ * Then counts the cycles per sample of each kernel on 1 ms blocks at 48 kHz with
+ * MSDK_GetCpuCycleCount. On the device these are core cycles, on the host the DWT cycle counter of
+ * the simulator follows the host clock at SystemCoreClock and only the ratios mean something.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fsl_common.h"
+#include "fsl_hostsim.h"
+#include "dsp/filtering_functions.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_VARIANTS     (3U)    /* Cortex-M0 kernel, generic C and generic C unrolled. */
+#define BENCH_MAX_TAPS     (32U)
+#define BENCH_MAX_BLOCK    (60U)
+#define BENCH_MAX_SHIFT    (8U)
+#define BENCH_STATE_SIZE   (1U << BENCH_MAX_SHIFT)
+#define BENCH_SAMPLES      (5760U) /* A multiple of BENCH_MAX_BLOCK and BENCH_CYCLE_BLOCK. */
+#define BENCH_CYCLE_BLOCK  (48U)
+#define BENCH_CYCLE_BLOCKS (20000U)
+
+typedef enum _bench_variant
+{
+    kBENCH_Cm0 = 0U,
+    kBENCH_Generic,
+    kBENCH_Unrolled,
+} bench_variant_t;
+
+typedef enum _bench_kernel
+{
+    kBENCH_Fir = 0U,
+    kBENCH_Biquad,
+    kBENCH_Average,
+} bench_kernel_t;
+
+typedef enum _bench_signal
+{
+    kBENCH_Noise = 0U,
+    kBENCH_Scaled,
+    kBENCH_Square,
+    kBENCH_Signals,
+} bench_signal_t;
+
+typedef struct _bench_config
+{
+    bench_kernel_t kernel;
+    uint8_t length; /* Taps, stages or log2 of the window. */
+    uint8_t factor; /* Post shift. */
+} bench_config_t;
+
+/* The generic C kernels, see the CMakeLists.txt. */
+void arm_fir_fast_q15_generic(const arm_fir_instance_q15 *S, const q15_t *pSrc, q15_t *pDst, uint32_t blockSize);
+void arm_biquad_cascade_df1_fast_q15_generic(const arm_biquad_casd_df1_inst_q15 *S,
+                                             const q15_t *pSrc,
+                                             q15_t *pDst,
+                                             uint32_t blockSize);
+void arm_fir_fast_q15_unrolled(const arm_fir_instance_q15 *S, const q15_t *pSrc, q15_t *pDst, uint32_t blockSize);
+void arm_biquad_cascade_df1_fast_q15_unrolled(const arm_biquad_casd_df1_inst_q15 *S,
+                                              const q15_t *pSrc,
+                                              q15_t *pDst,
+                                              uint32_t blockSize);
+void arm_moving_average_q15_unrolled(arm_moving_average_instance_q15 *S,
+                                     const q15_t *pSrc,
+                                     q15_t *pDst,
+                                     uint32_t blockSize);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static const bench_config_t s_configs[] = {
+    {kBENCH_Fir, 1U, 0U},    {kBENCH_Fir, 3U, 0U},    {kBENCH_Fir, 4U, 0U},     {kBENCH_Fir, 7U, 0U},
+    {kBENCH_Fir, 8U, 0U},    {kBENCH_Fir, 9U, 0U},    {kBENCH_Fir, 16U, 0U},    {kBENCH_Fir, 31U, 0U},
+    {kBENCH_Biquad, 1U, 0U}, {kBENCH_Biquad, 1U, 1U}, {kBENCH_Biquad, 2U, 1U},  {kBENCH_Biquad, 4U, 2U},
+    {kBENCH_Average, 0U, 0U}, {kBENCH_Average, 1U, 0U}, {kBENCH_Average, 4U, 0U}, {kBENCH_Average, 8U, 0U},
+};
+
+/* 8 taps, the unrolled length, 2 biquads and a window of 16 samples. */
+static const bench_config_t s_cycleConfigs[] = {
+    {kBENCH_Fir, 8U, 0U},
+    {kBENCH_Biquad, 2U, 1U},
+    {kBENCH_Average, 4U, 0U},
+};
+
+static const char *const s_kernelNames[] = {"fir_fast", "biquad_df1_fast", "moving_average"};
+
+static arm_fir_instance_q15 s_fir[BENCH_VARIANTS];
+static arm_biquad_casd_df1_inst_q15 s_biquad[BENCH_VARIANTS];
+static arm_moving_average_instance_q15 s_average[BENCH_VARIANTS];
+/* The coefficients start at s_coeffs[1], s_coeffs[0] is the zero in front of odd FIR filters. */
+static q15_t s_coeffs[BENCH_MAX_TAPS + 1U];
+static q15_t s_state[BENCH_VARIANTS][BENCH_STATE_SIZE];
+static q15_t s_input[BENCH_SAMPLES];
+static q15_t s_output[BENCH_VARIANTS][BENCH_SAMPLES];
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+static void BENCH_Signal(bench_signal_t signal)
+{
+    uint32_t run = 0U;
+    q15_t level  = INT16_MAX;
+    uint32_t i;
+
+    for (i = 0U; i < BENCH_SAMPLES; i++)
+    {
+        if (signal == kBENCH_Noise)
+        {
+            s_input[i] = (q15_t)BENCH_Random();
+        }
+        else if (signal == kBENCH_Scaled)
+        {
+            /* Down by log2 of the longest filter, no FIR accumulator wraps with scaled coefficients. */
+            s_input[i] = (q15_t)((q15_t)BENCH_Random() >> 5);
+        }
+        else
+        {
+            /* Runs of 1 to 8 samples at either limit. */
+            if (run == 0U)
+            {
+                run   = 1U + (BENCH_Random() % 8U);
+                level = (level == INT16_MAX) ? INT16_MIN : INT16_MAX;
+            }
+            s_input[i] = level;
+            run--;
+        }
+    }
+}
+
+/* Random coefficients and cleared state for every variant, at full scale except for the scaled signal. */
+static void BENCH_Init(const bench_config_t *config, bench_signal_t signal)
+{
+    uint32_t shift = (signal == kBENCH_Scaled) ? 5U : 0U;
+    uint32_t pad;
+    uint32_t v;
+    uint32_t i;
+
+    for (i = 1U; i <= BENCH_MAX_TAPS; i++)
+    {
+        s_coeffs[i] = (q15_t)((q15_t)BENCH_Random() >> shift);
+    }
+
+    for (v = 0U; v < BENCH_VARIANTS; v++)
+    {
+        switch (config->kernel)
+        {
+            case kBENCH_Fir:
+                pad = (v == (uint32_t)kBENCH_Cm0) ? 0U : (config->length & 1U);
+                (void)arm_fir_init_q15(&s_fir[v], (uint16_t)(config->length + pad), &s_coeffs[1U - pad], s_state[v],
+                                       BENCH_MAX_BLOCK);
+                break;
+            case kBENCH_Biquad:
+                /* {b10, 0, b11, b12, a11, a12, b20, 0, ...}, the second one of each stage is 0. */
+                for (i = 0U; i < config->length; i++)
+                {
+                    s_coeffs[(6U * i) + 2U] = 0;
+                }
+                arm_biquad_cascade_df1_init_q15(&s_biquad[v], config->length, &s_coeffs[1], s_state[v],
+                                                (int8_t)config->factor);
+                break;
+            default:
+                (void)arm_moving_average_init_q15(&s_average[v], config->length, s_state[v]);
+                break;
+        }
+    }
+}
+
+/* The window summed for every output, the samples before the start are 0. */
+static void BENCH_AverageDirect(uint32_t shift, const q15_t *pSrc, q15_t *pDst, uint32_t blockSize)
+{
+    uint32_t n = (uint32_t)(pSrc - s_input);
+    uint32_t i;
+    uint32_t k;
+    int32_t sum;
+
+    for (i = 0U; i < blockSize; i++, n++)
+    {
+        sum = 0;
+        for (k = 0U; (k < (1UL << shift)) && (k <= n); k++)
+        {
+            sum += s_input[n - k];
+        }
+        pDst[i] = (q15_t)(sum >> shift);
+    }
+}
+
+/* Returns the number of outputs. */
+static uint32_t BENCH_Process(
+    const bench_config_t *config, bench_variant_t v, const q15_t *pSrc, q15_t *pDst, uint32_t blockSize)
+{
+    switch (config->kernel)
+    {
+        case kBENCH_Fir:
+            if (v == kBENCH_Cm0)
+            {
+                arm_fir_fast_q15(&s_fir[v], pSrc, pDst, blockSize);
+            }
+            else if (v == kBENCH_Generic)
+            {
+                arm_fir_fast_q15_generic(&s_fir[v], pSrc, pDst, blockSize);
+            }
+            else
+            {
+                arm_fir_fast_q15_unrolled(&s_fir[v], pSrc, pDst, blockSize);
+            }
+            break;
+        case kBENCH_Biquad:
+            if (v == kBENCH_Cm0)
+            {
+                arm_biquad_cascade_df1_fast_q15(&s_biquad[v], pSrc, pDst, blockSize);
+            }
+            else if (v == kBENCH_Generic)
+            {
+                arm_biquad_cascade_df1_fast_q15_generic(&s_biquad[v], pSrc, pDst, blockSize);
+            }
+            else
+            {
+                arm_biquad_cascade_df1_fast_q15_unrolled(&s_biquad[v], pSrc, pDst, blockSize);
+            }
+            break;
+        default:
+            if (v == kBENCH_Cm0)
+            {
+                arm_moving_average_q15(&s_average[v], pSrc, pDst, blockSize);
+            }
+            else if (v == kBENCH_Generic)
+            {
+                BENCH_AverageDirect(config->length, pSrc, pDst, blockSize);
+            }
+            else
+            {
+                arm_moving_average_q15_unrolled(&s_average[v], pSrc, pDst, blockSize);
+            }
+            break;
+    }
+
+    return blockSize;
+}
+
+static void BENCH_Describe(const bench_config_t *config, char *text, size_t size)
+{
+    switch (config->kernel)
+    {
+        case kBENCH_Fir:
+            (void)snprintf(text, size, "%2u taps", (unsigned int)config->length);
+            break;
+        case kBENCH_Biquad:
+            (void)snprintf(text, size, "%u stages >> %u", (unsigned int)config->length, (unsigned int)config->factor);
+            break;
+        default:
+            (void)snprintf(text, size, "window %3u", (unsigned int)(1UL << config->length));
+            break;
+    }
+}
+
+/* Outputs of a variant that differ from the ones of the Cortex-M0 kernel. */
+static uint32_t BENCH_Differ(bench_variant_t v, uint32_t outputs)
+{
+    uint32_t differ = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < outputs; i++)
+    {
+        differ += (s_output[v][i] != s_output[kBENCH_Cm0][i]) ? 1U : 0U;
+    }
+
+    return differ;
+}
+
+static void BENCH_Verify(void)
+{
+    const bench_config_t *config;
+    uint32_t differ[BENCH_VARIANTS];
+    uint32_t total;
+    uint32_t outputs;
+    uint32_t block;
+    uint32_t n;
+    uint32_t c;
+    uint32_t s;
+    uint32_t v;
+    char text[24];
+
+    for (c = 0U; c < ARRAY_SIZE(s_configs); c++)
+    {
+        config = &s_configs[c];
+        total  = 0U;
+        (void)memset(differ, 0, sizeof(differ));
+
+        for (s = 0U; s < (uint32_t)kBENCH_Signals; s++)
+        {
+            BENCH_Signal((bench_signal_t)s);
+            BENCH_Init(config, (bench_signal_t)s);
+
+            /* The same blocks of random length for every variant, the state carries over. */
+            outputs = 0U;
+            for (n = 0U; n < BENCH_SAMPLES; n += block)
+            {
+                block = 1U + (BENCH_Random() % BENCH_MAX_BLOCK);
+                block = MIN(block, BENCH_SAMPLES - n);
+                for (v = 0U; v < BENCH_VARIANTS; v++)
+                {
+                    (void)BENCH_Process(config, (bench_variant_t)v, &s_input[n], &s_output[v][outputs], block);
+                }
+                outputs += block;
+            }
+
+            for (v = 0U; v < BENCH_VARIANTS; v++)
+            {
+                differ[v] += BENCH_Differ((bench_variant_t)v, outputs);
+            }
+            total += outputs;
+        }
+
+        BENCH_Describe(config, text, sizeof(text));
+        (void)printf("%-16s %-14s %6u outputs  %4u differ from %-9s %4u from unrolled  %s\r\n",
+                     s_kernelNames[config->kernel], text, (unsigned int)total, (unsigned int)differ[kBENCH_Generic],
+                     (config->kernel == kBENCH_Average) ? "the sums" : "generic",
+                     (unsigned int)differ[kBENCH_Unrolled],
+                     ((differ[kBENCH_Generic] == 0U) && (differ[kBENCH_Unrolled] == 0U)) ? "ok" : "FAILED");
+    }
+}
+
+static void BENCH_Cycles(void)
+{
+    const bench_config_t *config;
+    double perSample[BENCH_VARIANTS];
+    uint32_t offset;
+    uint32_t start;
+    uint32_t block;
+    uint32_t c;
+    uint32_t v;
+    bool ok;
+    char text[24];
+
+    MSDK_EnableCpuCycleCounter();
+    BENCH_Signal(kBENCH_Scaled);
+
+    for (c = 0U; c < ARRAY_SIZE(s_cycleConfigs); c++)
+    {
+        config = &s_cycleConfigs[c];
+        BENCH_Init(config, kBENCH_Scaled);
+
+        for (v = 0U; v < BENCH_VARIANTS; v++)
+        {
+            /* The cycle counter is read once per run, a read traps into the simulator. */
+            start = MSDK_GetCpuCycleCount();
+            for (block = 0U; block < BENCH_CYCLE_BLOCKS; block++)
+            {
+                offset = (block % (BENCH_SAMPLES / BENCH_CYCLE_BLOCK)) * BENCH_CYCLE_BLOCK;
+                (void)BENCH_Process(config, (bench_variant_t)v, &s_input[offset], &s_output[v][offset],
+                                    BENCH_CYCLE_BLOCK);
+            }
+            perSample[v] = (double)(uint32_t)(MSDK_GetCpuCycleCount() - start) /
+                           ((double)BENCH_CYCLE_BLOCKS * (double)BENCH_CYCLE_BLOCK);
+        }
+
+        /* The last pass over the signal of every variant, with the state of all the blocks before. The
+           direct sums do not see the end of the signal before its start. */
+        ok = ((config->kernel == kBENCH_Average) || (BENCH_Differ(kBENCH_Generic, BENCH_SAMPLES) == 0U)) &&
+             (BENCH_Differ(kBENCH_Unrolled, BENCH_SAMPLES) == 0U);
+
+        BENCH_Describe(config, text, sizeof(text));
+        (void)printf("%-16s %-14s cycles/sample  cm0 %7.3f  %-7s %7.3f  unrolled %7.3f  %s\r\n",
+                     s_kernelNames[config->kernel], text, perSample[kBENCH_Cm0],
+                     (config->kernel == kBENCH_Average) ? "sums" : "generic", perSample[kBENCH_Generic],
+                     perSample[kBENCH_Unrolled], ok ? "ok" : "FAILED");
+    }
+}
+
+int main(void)
+{
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    (void)printf("CMSIS_DSP_CM0_FIR_TAPS %u\r\n", (unsigned int)CMSIS_DSP_CM0_FIR_TAPS);
+    BENCH_Verify();
+    BENCH_Cycles();
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,368 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Writes settings with a skewed update pattern through the unmodified IAP driver on the IAP ROM
+ * model. First as a sector image that is erased and programmed again for every update, then with
+ * the wear-leveled store, once collecting in the writes and once collecting when idle. Compares the
+ * write amplification, the erases and their spread over the pages, and the time the core stalls
+ * on the flash. Then cuts the power in random program and erase commands and checks that every
+ * committed value survives the reset.
+ */
+
+#include <setjmp.h>
+#include <stdio.h>
+
+#include "fsl_hostsim_models.h"
+#include "fsl_iap_store.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_START_PAGE     (768U) /* Last 16 KB of the flash. */
+#define BENCH_PAGE_COUNT     (64U)
+#define BENCH_BLOCKS         (BENCH_PAGE_COUNT / IAP_STORE_BLOCK_PAGES)
+#define BENCH_KEYS           (32U)
+#define BENCH_HOT_KEYS       (4U)
+#define BENCH_HOT_PERCENT    (90U)
+#define BENCH_MAX_VALUE      (16U)
+#define BENCH_WRITES         (5000U)
+#define BENCH_POWER_LOSSES   (500U)
+#define BENCH_PAGE_SIZE      ((uint32_t)FSL_FEATURE_SYSCON_FLASH_PAGE_SIZE_BYTES)
+#define BENCH_SECTOR_SIZE    ((uint32_t)FSL_FEATURE_SYSCON_FLASH_SECTOR_SIZE_BYTES)
+#define BENCH_IMAGE_SLOT     (BENCH_SECTOR_SIZE / BENCH_KEYS)
+
+/* Committed value of a key. */
+typedef struct _bench_value
+{
+    bool present;
+    uint8_t length;
+    uint8_t data[BENCH_MAX_VALUE];
+} bench_value_t;
+
+typedef struct _bench_result
+{
+    uint32_t writes;
+    uint32_t valueBytes;
+    uint64_t stallUs;
+    uint32_t maxStallUs;
+    uint64_t idleUs;
+} bench_result_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Page images handed to the IAP ROM must have 32-bit addresses, they are static in a non-PIE program. */
+static uint32_t s_image[BENCH_SECTOR_SIZE / sizeof(uint32_t)];
+static iap_store_handle_t s_store;
+static iap_store_block_t s_blocks[BENCH_BLOCKS];
+static iap_store_entry_t s_index[BENCH_KEYS];
+
+static hostsim_iap_model_t s_iapModel;
+static bench_value_t s_values[BENCH_KEYS];
+static uint32_t s_random = 1U;
+static jmp_buf s_reset;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t BENCH_Random(void)
+{
+    s_random = (s_random * 1103515245U) + 12345U;
+
+    return s_random >> 8U;
+}
+
+/* Most updates go to a few keys, e.g. counters and the last state, the rest changes rarely. */
+static uint16_t BENCH_NextKey(void)
+{
+    if ((BENCH_Random() % 100U) < BENCH_HOT_PERCENT)
+    {
+        return (uint16_t)(BENCH_Random() % BENCH_HOT_KEYS);
+    }
+
+    return (uint16_t)(BENCH_HOT_KEYS + (BENCH_Random() % (BENCH_KEYS - BENCH_HOT_KEYS)));
+}
+
+static void BENCH_NextValue(uint16_t key, bench_value_t *value)
+{
+    uint32_t i;
+
+    value->present = true;
+    value->length  = (uint8_t)(4U + (key % (BENCH_MAX_VALUE - 3U)));
+    for (i = 0U; i < value->length; i++)
+    {
+        value->data[i] = (uint8_t)BENCH_Random();
+    }
+}
+
+static const uint8_t *BENCH_Flash(uint32_t address)
+{
+    return &s_iapModel.flash[address];
+}
+
+static void BENCH_ResetModel(void)
+{
+    (void)memset(s_iapModel.flash, 0xFF, (size_t)FSL_FEATURE_SYSCON_FLASH_SIZE_BYTES);
+    (void)memset(s_iapModel.pageErases, 0, sizeof(s_iapModel.pageErases));
+    s_iapModel.programs     = 0U;
+    s_iapModel.programBytes = 0U;
+    s_iapModel.erases       = 0U;
+    s_iapModel.busyUs       = 0U;
+    s_iapModel.maxBusyUs    = 0U;
+    (void)memset(s_values, 0, sizeof(s_values));
+    s_random = 1U;
+}
+
+static void BENCH_Report(const char *name, const bench_result_t *result)
+{
+    uint32_t minErases = UINT32_MAX;
+    uint32_t maxErases = 0U;
+    uint32_t page;
+
+    for (page = BENCH_START_PAGE; page < (BENCH_START_PAGE + BENCH_PAGE_COUNT); page++)
+    {
+        minErases = (s_iapModel.pageErases[page] < minErases) ? s_iapModel.pageErases[page] : minErases;
+        maxErases = (s_iapModel.pageErases[page] > maxErases) ? s_iapModel.pageErases[page] : maxErases;
+    }
+
+    (void)printf(
+        "%-20s %5u writes  amplification %6.1f  %5u erases  page erases %4u..%-4u  "
+        "stall avg %7.1f max %6u us  idle %7.1f ms\r\n",
+        name, (unsigned int)result->writes, (double)s_iapModel.programBytes / (double)result->valueBytes,
+        (unsigned int)s_iapModel.erases, (unsigned int)minErases, (unsigned int)maxErases,
+        (double)result->stallUs / (double)result->writes, (unsigned int)result->maxStallUs,
+        (double)result->idleUs / 1000.0);
+}
+
+static void BENCH_Stall(bench_result_t *result, uint64_t busyUs)
+{
+    uint32_t stallUs = (uint32_t)(s_iapModel.busyUs - busyUs);
+
+    result->writes++;
+    result->stallUs += stallUs;
+    result->maxStallUs = (stallUs > result->maxStallUs) ? stallUs : result->maxStallUs;
+}
+
+/* The values live at fixed places of one sector, an update erases and programs the whole sector. */
+static void BENCH_SectorImage(void)
+{
+    bench_result_t result = {0};
+    uint32_t address      = BENCH_START_PAGE * BENCH_PAGE_SIZE;
+    uint32_t sector       = address / BENCH_SECTOR_SIZE;
+    bench_value_t value;
+    uint64_t busyUs;
+    uint32_t write;
+    uint16_t key;
+    bool ok = true;
+
+    BENCH_ResetModel();
+
+    for (write = 0U; write < BENCH_WRITES; write++)
+    {
+        key = BENCH_NextKey();
+        BENCH_NextValue(key, &value);
+        result.valueBytes += value.length;
+        busyUs = s_iapModel.busyUs;
+
+        (void)memcpy(s_image, BENCH_Flash(address), BENCH_SECTOR_SIZE);
+        (void)memcpy(&((uint8_t *)s_image)[key * BENCH_IMAGE_SLOT], value.data, value.length);
+        ok = ok && (IAP_PrepareSectorForWrite(sector, sector) == kStatus_Success);
+        ok = ok && (IAP_EraseSector(sector, sector, SystemCoreClock) == kStatus_Success);
+        ok = ok && (IAP_PrepareSectorForWrite(sector, sector) == kStatus_Success);
+        ok = ok && (IAP_CopyRamToFlash(address, s_image, BENCH_SECTOR_SIZE, SystemCoreClock) == kStatus_Success);
+        ok = ok && (memcmp(BENCH_Flash(address + (key * BENCH_IMAGE_SLOT)), value.data, value.length) == 0);
+
+        BENCH_Stall(&result, busyUs);
+    }
+
+    BENCH_Report("sector image", &result);
+    if (!ok)
+    {
+        (void)printf("sector image FAILED\r\n");
+    }
+}
+
+static status_t BENCH_StoreInit(void)
+{
+    iap_store_config_t config = {
+        .startPage       = BENCH_START_PAGE,
+        .pageCount       = BENCH_PAGE_COUNT,
+        .blocks          = s_blocks,
+        .index           = s_index,
+        .indexSize       = BENCH_KEYS,
+        .systemCoreClock = SystemCoreClock,
+    };
+
+    return IAP_StoreInit(&s_store, &config);
+}
+
+/* Every committed value reads back, the key of an interrupted update may have the old or the new one. */
+static bool BENCH_StoreCheck(int32_t pendingKey, const bench_value_t *pending)
+{
+    uint8_t data[BENCH_MAX_VALUE];
+    const bench_value_t *expected;
+    size_t length;
+    status_t status;
+    uint32_t key;
+    bool ok = true;
+
+    for (key = 0U; key < BENCH_KEYS; key++)
+    {
+        expected = &s_values[key];
+        status   = IAP_StoreRead(&s_store, (uint16_t)key, data, sizeof(data), &length);
+        if (((int32_t)key == pendingKey) && (pending->present == (status == kStatus_Success)) &&
+            (!pending->present || ((length == pending->length) && (memcmp(data, pending->data, length) == 0))))
+        {
+            s_values[key] = *pending;
+        }
+        else if (expected->present)
+        {
+            ok = ok && (status == kStatus_Success) && (length == expected->length) &&
+                 (memcmp(data, expected->data, length) == 0);
+        }
+        else
+        {
+            ok = ok && (status == kStatus_IAP_StoreNotFound);
+        }
+    }
+
+    return ok;
+}
+
+/* Skewed updates of the store, collecting in the writes or after every write when idle. */
+static void BENCH_Store(const char *name, bool idleCollect)
+{
+    bench_result_t result = {0};
+    iap_store_stats_t stats;
+    uint64_t busyUs;
+    uint64_t cycles;
+    uint32_t write;
+    uint16_t key;
+    bool ok;
+
+    BENCH_ResetModel();
+    ok = (BENCH_StoreInit() == kStatus_Success);
+
+    for (write = 0U; ok && (write < BENCH_WRITES); write++)
+    {
+        key = BENCH_NextKey();
+        BENCH_NextValue(key, &s_values[key]);
+        result.valueBytes += s_values[key].length;
+
+        busyUs = s_iapModel.busyUs;
+        ok     = (IAP_StoreWrite(&s_store, key, s_values[key].data, s_values[key].length) == kStatus_Success);
+        BENCH_Stall(&result, busyUs);
+
+        if (idleCollect)
+        {
+            busyUs = s_iapModel.busyUs;
+            ok     = ok && (IAP_StoreCollect(&s_store) == kStatus_Success);
+            result.idleUs += s_iapModel.busyUs - busyUs;
+        }
+    }
+
+    BENCH_Report(name, &result);
+    IAP_StoreGetStats(&s_store, &stats);
+
+    /* Reset, the index is built again from the flash. */
+    cycles = HOSTSIM_GetCycles();
+    ok     = ok && (BENCH_StoreInit() == kStatus_Success);
+    cycles = HOSTSIM_GetCycles() - cycles;
+    ok     = ok && BENCH_StoreCheck(-1, NULL);
+
+    (void)printf("%-20s %u collections, %u bytes moved, %u skipped  boot %u records in %u cycles  %s\r\n", name,
+                 (unsigned int)stats.collections, (unsigned int)stats.movedBytes, (unsigned int)stats.skipped,
+                 (unsigned int)s_store.stats.scannedRecords, (unsigned int)cycles, ok ? "ok" : "FAILED");
+}
+
+static void BENCH_PowerLoss(void *userData)
+{
+    (void)userData;
+
+    longjmp(s_reset, 1);
+}
+
+/* Updates and deletes until the power fails in one of them, then resets and checks the values. */
+static void BENCH_PowerLosses(void)
+{
+    static volatile int32_t pendingKey;
+    static bench_value_t pending;
+    volatile uint32_t failures = 0U;
+    volatile uint32_t torn     = 0U;
+    volatile uint32_t loss;
+    uint32_t fullWrites = 0U;
+    status_t status;
+
+    BENCH_ResetModel();
+    (void)BENCH_StoreInit();
+
+    for (loss = 0U; loss < BENCH_POWER_LOSSES; loss++)
+    {
+        HOSTSIM_IapModelSetPowerLoss(&s_iapModel, 1U + (BENCH_Random() % 16U), BENCH_PowerLoss, NULL);
+        if (setjmp(s_reset) == 0)
+        {
+            for (;;)
+            {
+                pendingKey = (int32_t)BENCH_NextKey();
+                if ((BENCH_Random() % 10U) == 0U)
+                {
+                    pending.present = false;
+                    status          = IAP_StoreDelete(&s_store, (uint16_t)pendingKey);
+                }
+                else
+                {
+                    BENCH_NextValue((uint16_t)pendingKey, &pending);
+                    status = IAP_StoreWrite(&s_store, (uint16_t)pendingKey, pending.data, pending.length);
+                }
+                if (status == kStatus_IAP_StoreFull)
+                {
+                    fullWrites++;
+                }
+                else if (status == kStatus_Success)
+                {
+                    s_values[pendingKey] = pending;
+                }
+                else
+                {
+                    failures++;
+                }
+            }
+        }
+
+        /* Reset, the core starts with the interrupts enabled. */
+        __enable_irq();
+        HOSTSIM_IapModelSetPowerLoss(&s_iapModel, 0U, NULL, NULL);
+        if ((BENCH_StoreInit() != kStatus_Success) || !BENCH_StoreCheck(pendingKey, &pending))
+        {
+            failures++;
+        }
+        torn += s_store.stats.tornRecords;
+    }
+
+    (void)printf("%-20s %u resets, %u torn records seen at boot, %u full  %s\r\n", "power loss", (unsigned int)loss,
+                 (unsigned int)torn, (unsigned int)fullWrites, (failures == 0U) ? "ok" : "FAILED");
+}
+
+int main(void)
+{
+    if ((HOSTSIM_Init() != kStatus_Success) || (HOSTSIM_IapModelInit(&s_iapModel) != kStatus_Success))
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    BENCH_SectorImage();
+    BENCH_Store("store", false);
+    BENCH_Store("store idle collect", true);
+    BENCH_PowerLosses();
+
+    HOSTSIM_IapModelDeinit(&s_iapModel);
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef HOSTSIM_NVIC_VIRTUAL_H_
+#define HOSTSIM_NVIC_VIRTUAL_H_
+
+/* NVIC functions of the host build, the interrupt controller is part of the simulator. */
+void HOSTSIM_NVIC_EnableIRQ(IRQn_Type IRQn);
+uint32_t HOSTSIM_NVIC_GetEnableIRQ(IRQn_Type IRQn);
+void HOSTSIM_NVIC_DisableIRQ(IRQn_Type IRQn);
+uint32_t HOSTSIM_NVIC_GetPendingIRQ(IRQn_Type IRQn);
+void HOSTSIM_NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void HOSTSIM_NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+void HOSTSIM_NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+uint32_t HOSTSIM_NVIC_GetPriority(IRQn_Type IRQn);
+__NO_RETURN void HOSTSIM_NVIC_SystemReset(void);
+
+#define NVIC_SetPriorityGrouping(X) (void)(X)
+#define NVIC_GetPriorityGrouping()  (0U)
+#define NVIC_EnableIRQ              HOSTSIM_NVIC_EnableIRQ
+#define NVIC_GetEnableIRQ           HOSTSIM_NVIC_GetEnableIRQ
+#define NVIC_DisableIRQ             HOSTSIM_NVIC_DisableIRQ
+#define NVIC_GetPendingIRQ          HOSTSIM_NVIC_GetPendingIRQ
+#define NVIC_SetPendingIRQ          HOSTSIM_NVIC_SetPendingIRQ
+#define NVIC_ClearPendingIRQ        HOSTSIM_NVIC_ClearPendingIRQ
+#define NVIC_SetPriority            HOSTSIM_NVIC_SetPriority
+#define NVIC_GetPriority            HOSTSIM_NVIC_GetPriority
+#define NVIC_SystemReset            HOSTSIM_NVIC_SystemReset
+
+#endif /* HOSTSIM_NVIC_VIRTUAL_H_ */
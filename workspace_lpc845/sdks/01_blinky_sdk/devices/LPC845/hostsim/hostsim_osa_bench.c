@@ -0,0 +1,270 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Runs the bare metal OSA task loop with 2 to 32 tasks and reports the dispatch latency from
+ * OSA_SemaphorePost to the task entry and the fairness between always ready tasks of the same
+ * priority. Built once per scheduler, see FSL_OSA_BM_SCHEDULER_BITMAP. Last, a ready task lowered
+ * below another one by OSA_TaskSetPriority must run after it.
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "fsl_hostsim.h"
+#include "fsl_os_abstraction.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_MAX_TASKS      (32U)
+#define BENCH_POSTS_PER_TASK (2000U)
+#define BENCH_FAIR_RUNS      (10000U)
+
+#if (defined(FSL_OSA_BM_SCHEDULER_BITMAP) && (FSL_OSA_BM_SCHEDULER_BITMAP > 0U))
+#define BENCH_SCHEDULER_NAME "bitmap"
+#else
+#define BENCH_SCHEDULER_NAME "list"
+#endif
+
+typedef struct _bench_task
+{
+    OSA_TASK_HANDLE_DEFINE(handle);
+    OSA_SEMAPHORE_HANDLE_DEFINE(semaphore);
+    uint32_t runs;
+} bench_task_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static void BENCH_LatencyTask(osa_task_param_t param);
+static void BENCH_FairTask(osa_task_param_t param);
+static void BENCH_OrderTask(osa_task_param_t param);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static OSA_TASK_DEFINE(BENCH_LatencyTask, OSA_PRIORITY_NORMAL, 1, 0, 0);
+static OSA_TASK_DEFINE(BENCH_FairTask, OSA_PRIORITY_NORMAL, 1, 0, 0);
+static OSA_TASK_DEFINE(BENCH_OrderTask, OSA_PRIORITY_NORMAL, 1, 0, 0);
+
+static bench_task_t s_tasks[BENCH_MAX_TASKS];
+static OSA_SEMAPHORE_HANDLE_DEFINE(s_stopSemaphore);
+static uint64_t s_postTime;
+static uint64_t s_latencySum;
+static uint64_t s_latencyMax;
+static uint32_t s_totalRuns;
+static uint32_t s_order[2U];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t BENCH_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+/* Waits for its semaphore, records the latency when it was posted. */
+static void BENCH_LatencyTask(osa_task_param_t param)
+{
+    bench_task_t *task = (bench_task_t *)param;
+    uint64_t latency;
+
+    if (OSA_SemaphoreWait((osa_semaphore_handle_t)task->semaphore, osaWaitForever_c) == KOSA_StatusSuccess)
+    {
+        latency = BENCH_GetNs() - s_postTime;
+        s_latencySum += latency;
+        if (latency > s_latencyMax)
+        {
+            s_latencyMax = latency;
+        }
+        task->runs++;
+    }
+}
+
+/* Always ready until BENCH_FAIR_RUNS runs were done by all tasks together. */
+static void BENCH_FairTask(osa_task_param_t param)
+{
+    bench_task_t *task = (bench_task_t *)param;
+
+    if (s_totalRuns < BENCH_FAIR_RUNS)
+    {
+        s_totalRuns++;
+        task->runs++;
+    }
+    else
+    {
+        (void)OSA_SemaphoreWait((osa_semaphore_handle_t)s_stopSemaphore, osaWaitForever_c);
+    }
+}
+
+/* Notes the order of its first run, then waits for the stop semaphore. */
+static void BENCH_OrderTask(osa_task_param_t param)
+{
+    bench_task_t *task = (bench_task_t *)param;
+
+    if (s_totalRuns < (sizeof(s_order) / sizeof(s_order[0])))
+    {
+        s_order[s_totalRuns] = (uint32_t)(task - s_tasks);
+        s_totalRuns++;
+    }
+    (void)OSA_SemaphoreWait((osa_semaphore_handle_t)s_stopSemaphore, osaWaitForever_c);
+}
+
+static void BENCH_CreateTasks(uint32_t count, const osa_task_def_t *taskDef, bool spreadPriorities)
+{
+    osa_task_def_t def = *taskDef;
+    uint32_t i;
+
+    OSA_Init();
+    (void)memset(s_tasks, 0, sizeof(s_tasks));
+
+    for (i = 0U; i < count; i++)
+    {
+        /* The last task gets the lowest priority, it is at the tail of the task list. */
+        def.tpriority =
+            spreadPriorities ? (OSA_PRIORITY_REAL_TIME + ((i * (OSA_PRIORITY_IDLE + 1U)) / count)) : OSA_PRIORITY_NORMAL;
+        (void)OSA_SemaphoreCreateBinary((osa_semaphore_handle_t)s_tasks[i].semaphore);
+        (void)OSA_TaskCreate((osa_task_handle_t)s_tasks[i].handle, &def, &s_tasks[i]);
+    }
+}
+
+static void BENCH_DestroyTasks(uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        (void)OSA_TaskDestroy((osa_task_handle_t)s_tasks[i].handle);
+        (void)OSA_SemaphoreDestroy((osa_semaphore_handle_t)s_tasks[i].semaphore);
+    }
+}
+
+static void BENCH_Latency(uint32_t count)
+{
+    uint32_t post;
+    uint32_t i;
+    double average;
+    uint32_t tailRuns;
+    bool ok;
+
+    BENCH_CreateTasks(count, OSA_TASK(BENCH_LatencyTask), true);
+    /* First run, the tasks take the initial semaphore count and block. */
+    OSA_ProcessTasks();
+    for (i = 0U; i < count; i++)
+    {
+        s_tasks[i].runs = 0U;
+    }
+    s_latencySum = 0U;
+    s_latencyMax = 0U;
+
+    /* Post every task in turn, then the tail task alone for the worst case of the list walk. */
+    for (post = 0U; post < (BENCH_POSTS_PER_TASK * count); post++)
+    {
+        s_postTime = BENCH_GetNs();
+        (void)OSA_SemaphorePost((osa_semaphore_handle_t)s_tasks[post % count].semaphore);
+        OSA_ProcessTasks();
+    }
+    average      = (double)s_latencySum / (double)(BENCH_POSTS_PER_TASK * count);
+    tailRuns     = s_tasks[count - 1U].runs;
+    s_latencySum = 0U;
+    for (post = 0U; post < BENCH_POSTS_PER_TASK; post++)
+    {
+        s_postTime = BENCH_GetNs();
+        (void)OSA_SemaphorePost((osa_semaphore_handle_t)s_tasks[count - 1U].semaphore);
+        OSA_ProcessTasks();
+    }
+
+    ok = (s_tasks[count - 1U].runs == (tailRuns + BENCH_POSTS_PER_TASK));
+    for (i = 0U; i < (count - 1U); i++)
+    {
+        ok = ok && (s_tasks[i].runs == BENCH_POSTS_PER_TASK);
+    }
+
+    (void)printf("%-7s latency %2u tasks  avg %6.1f ns  tail %6.1f ns  max %7u ns  %s\r\n", BENCH_SCHEDULER_NAME,
+                 (unsigned int)count, average, (double)s_latencySum / (double)BENCH_POSTS_PER_TASK,
+                 (unsigned int)s_latencyMax, ok ? "ok" : "FAILED");
+
+    BENCH_DestroyTasks(count);
+}
+
+static void BENCH_Fairness(uint32_t count)
+{
+    uint32_t minRuns = UINT32_MAX;
+    uint32_t maxRuns = 0U;
+    uint32_t i;
+
+    BENCH_CreateTasks(count, OSA_TASK(BENCH_FairTask), false);
+    s_totalRuns = 0U;
+    (void)memset(s_stopSemaphore, 0, sizeof(s_stopSemaphore));
+    (void)OSA_SemaphoreCreate((osa_semaphore_handle_t)s_stopSemaphore, 0U);
+
+    /* All tasks stay ready, the loop returns once all of them wait for the stop semaphore. */
+    OSA_ProcessTasks();
+
+    for (i = 0U; i < count; i++)
+    {
+        minRuns = (s_tasks[i].runs < minRuns) ? s_tasks[i].runs : minRuns;
+        maxRuns = (s_tasks[i].runs > maxRuns) ? s_tasks[i].runs : maxRuns;
+    }
+
+    (void)printf("%-7s fairness %2u tasks  runs min %5u max %5u  ratio %.3f\r\n", BENCH_SCHEDULER_NAME,
+                 (unsigned int)count, (unsigned int)minRuns, (unsigned int)maxRuns,
+                 (double)minRuns / (double)maxRuns);
+
+    BENCH_DestroyTasks(count);
+}
+
+/* Both tasks are ready when the one created at the highest priority is lowered below the other. */
+static void BENCH_SetPriority(void)
+{
+    bool ok;
+
+    BENCH_CreateTasks(2U, OSA_TASK(BENCH_OrderTask), true);
+    s_totalRuns = 0U;
+    (void)memset(s_stopSemaphore, 0, sizeof(s_stopSemaphore));
+    (void)OSA_SemaphoreCreate((osa_semaphore_handle_t)s_stopSemaphore, 0U);
+
+    ok = OSA_TaskSetPriority((osa_task_handle_t)s_tasks[0].handle, OSA_PRIORITY_IDLE) == KOSA_StatusSuccess;
+    OSA_ProcessTasks();
+    ok = ok && (s_totalRuns == 2U) && (s_order[0] == 1U) && (s_order[1] == 0U);
+
+    (void)printf("%-7s set priority of a ready task  order %u %u  %s\r\n", BENCH_SCHEDULER_NAME,
+                 (unsigned int)s_order[0], (unsigned int)s_order[1], ok ? "ok" : "FAILED");
+
+    BENCH_DestroyTasks(2U);
+}
+
+int main(void)
+{
+    uint32_t count;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    for (count = 2U; count <= BENCH_MAX_TASKS; count *= 2U)
+    {
+        BENCH_Latency(count);
+    }
+    for (count = 2U; count <= BENCH_MAX_TASKS; count *= 2U)
+    {
+        BENCH_Fairness(count);
+    }
+    BENCH_SetPriority();
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
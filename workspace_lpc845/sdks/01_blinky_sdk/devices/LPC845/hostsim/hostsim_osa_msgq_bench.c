@@ -0,0 +1,365 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Runs the bare metal OSA message queue against interrupts taken inside OSA_MsgQPut, OSA_MsgQGet
+ * and the loan of a message slot, then with a SysTick handler putting and getting messages at
+ * random points of the task loop. Reports the time spent with interrupts masked per message
+ * for 4 to 64 byte messages. Built once per queue mode, see FSL_OSA_BM_MSGQ_SLOTS.
+ */
+
+#include <stdio.h>
+
+#include "fsl_hostsim.h"
+#include "fsl_os_abstraction.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_QUEUE_LENGTH   (8U)
+#define BENCH_MAX_MSG_WORDS  (16U)
+#define BENCH_MEASURE_MSGS   (20000U)
+#define BENCH_STRESS_MSGS    (2000000U)
+#define BENCH_STRESS_TICK_HZ (20000U)
+
+#define BENCH_TASK (0U)
+#define BENCH_ISR  (1U)
+
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+#define BENCH_MODE_NAME "slots"
+#else
+#define BENCH_MODE_NAME "copy"
+#endif
+
+/*! @brief What the interrupt handler does when it is taken. */
+typedef enum _bench_isr_action
+{
+    kBENCH_IsrPut = 0U,
+    kBENCH_IsrGet,
+} bench_isr_action_t;
+
+/*! @brief Messages seen by one consumer. */
+typedef struct _bench_consumer
+{
+    uint32_t received;
+    uint32_t corrupted;
+    uint32_t reordered;
+    uint32_t nextSequence[2];
+} bench_consumer_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static OSA_MSGQ_HANDLE_DEFINE(s_queue, BENCH_QUEUE_LENGTH, BENCH_MAX_MSG_WORDS * sizeof(uint32_t));
+static uint32_t s_msgSize;
+
+static volatile bench_isr_action_t s_isrAction;
+static uint32_t s_isrMessage[BENCH_MAX_MSG_WORDS];
+static osa_status_t s_isrStatus;
+
+static volatile bool s_stressRunning;
+static uint32_t s_sequence[2];
+static uint32_t s_put[2];
+static bench_consumer_t s_consumer[2];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* The first word carries the producer and the sequence number, the others are derived from it. */
+static void BENCH_MakeMessage(uint32_t *message, uint32_t producer, uint32_t sequence)
+{
+    uint32_t i;
+
+    message[0] = (producer << 24U) | (sequence & 0x00FFFFFFU);
+    for (i = 1U; i < (s_msgSize / sizeof(uint32_t)); i++)
+    {
+        message[i] = message[0] ^ (i * 0x9E3779B9U);
+    }
+}
+
+static bool BENCH_CheckMessage(const uint32_t *message)
+{
+    uint32_t i;
+
+    for (i = 1U; i < (s_msgSize / sizeof(uint32_t)); i++)
+    {
+        if (message[i] != (message[0] ^ (i * 0x9E3779B9U)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void BENCH_CreateQueue(uint32_t msgSize)
+{
+    s_msgSize = msgSize;
+    (void)memset(s_queue, 0, sizeof(s_queue));
+    (void)OSA_MsgQCreate((osa_msgq_handle_t)s_queue, BENCH_QUEUE_LENGTH, msgSize);
+}
+
+static void BENCH_Consume(bench_consumer_t *consumer, const uint32_t *message)
+{
+    uint32_t producer = message[0] >> 24U;
+    uint32_t sequence = message[0] & 0x00FFFFFFU;
+
+    consumer->received++;
+    if ((producer > BENCH_ISR) || (!BENCH_CheckMessage(message)))
+    {
+        consumer->corrupted++;
+        return;
+    }
+
+    /* Every consumer sees the messages of a producer in the order they were put. */
+    if (sequence < consumer->nextSequence[producer])
+    {
+        consumer->reordered++;
+    }
+    consumer->nextSequence[producer] = sequence + 1U;
+}
+
+static void BENCH_StressStep(uint32_t producer)
+{
+    uint32_t message[BENCH_MAX_MSG_WORDS];
+
+    BENCH_MakeMessage(message, producer, s_sequence[producer]);
+    if (OSA_MsgQPut((osa_msgq_handle_t)s_queue, message) == KOSA_StatusSuccess)
+    {
+        s_sequence[producer]++;
+        s_put[producer]++;
+    }
+    if (OSA_MsgQGet((osa_msgq_handle_t)s_queue, message, 0U) == KOSA_StatusSuccess)
+    {
+        BENCH_Consume(&s_consumer[producer], message);
+    }
+}
+
+void PIN_INT0_IRQHandler(void)
+{
+    if (kBENCH_IsrPut == s_isrAction)
+    {
+        BENCH_MakeMessage(s_isrMessage, BENCH_ISR, 0U);
+        s_isrStatus = OSA_MsgQPut((osa_msgq_handle_t)s_queue, s_isrMessage);
+    }
+    else
+    {
+        s_isrStatus = OSA_MsgQGet((osa_msgq_handle_t)s_queue, s_isrMessage, 0U);
+    }
+}
+
+void SysTick_Handler(void)
+{
+    if (s_stressRunning)
+    {
+        BENCH_StressStep(BENCH_ISR);
+    }
+}
+
+static bool BENCH_GetMessage(uint32_t producer, uint32_t sequence)
+{
+    uint32_t message[BENCH_MAX_MSG_WORDS];
+    uint32_t expected[BENCH_MAX_MSG_WORDS];
+
+    BENCH_MakeMessage(expected, producer, sequence);
+    if (OSA_MsgQGet((osa_msgq_handle_t)s_queue, message, 0U) != KOSA_StatusSuccess)
+    {
+        return false;
+    }
+
+    return (memcmp(message, expected, s_msgSize) == 0);
+}
+
+/* The interrupt pended before the call is taken at the first point the call enables interrupts. */
+static void BENCH_ReportInterleave(const char *name, bool ok)
+{
+    (void)printf("%-5s interleave %-16s %s\r\n", BENCH_MODE_NAME, name, ok ? "ok" : "FAILED");
+}
+
+static void BENCH_Interleave(void)
+{
+    uint32_t message[BENCH_MAX_MSG_WORDS];
+    bool ok;
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+    uint32_t *pSlot;
+    uint32_t i;
+#endif
+
+    /* Put interrupted by a put, the message reserved first is read first. */
+    BENCH_CreateQueue(16U);
+    BENCH_MakeMessage(message, BENCH_TASK, 0U);
+    s_isrAction = kBENCH_IsrPut;
+    HOSTSIM_PendIRQ(PIN_INT0_IRQn);
+    ok = (OSA_MsgQPut((osa_msgq_handle_t)s_queue, message) == KOSA_StatusSuccess);
+    ok = ok && (s_isrStatus == KOSA_StatusSuccess) && BENCH_GetMessage(BENCH_TASK, 0U) &&
+         BENCH_GetMessage(BENCH_ISR, 0U);
+    BENCH_ReportInterleave("put in put", ok);
+
+    /* Get interrupted by a get, both get a message of their own. */
+    BENCH_CreateQueue(64U);
+    BENCH_MakeMessage(message, BENCH_TASK, 0U);
+    (void)OSA_MsgQPut((osa_msgq_handle_t)s_queue, message);
+    BENCH_MakeMessage(message, BENCH_TASK, 1U);
+    (void)OSA_MsgQPut((osa_msgq_handle_t)s_queue, message);
+    s_isrAction = kBENCH_IsrGet;
+    HOSTSIM_PendIRQ(PIN_INT0_IRQn);
+    ok = (OSA_MsgQGet((osa_msgq_handle_t)s_queue, message, 0U) == KOSA_StatusSuccess) && BENCH_CheckMessage(message);
+    ok = ok && (s_isrStatus == KOSA_StatusSuccess) && BENCH_CheckMessage(s_isrMessage) &&
+         ((message[0] ^ s_isrMessage[0]) == 1U) && (OSA_MsgQAvailableMsgs((osa_msgq_handle_t)s_queue) == 0);
+    BENCH_ReportInterleave("get in get", ok);
+
+#if (defined(FSL_OSA_BM_MSGQ_SLOTS) && (FSL_OSA_BM_MSGQ_SLOTS > 0U))
+    /* Put while a slot is on loan, the later message waits for the commit of the loan. */
+    BENCH_CreateQueue(32U);
+    ok          = (OSA_MsgQReserve((osa_msgq_handle_t)s_queue, (void **)&pSlot) == KOSA_StatusSuccess);
+    s_isrAction = kBENCH_IsrPut;
+    HOSTSIM_PendIRQ(PIN_INT0_IRQn);
+    HOSTSIM_Poll();
+    ok = ok && (s_isrStatus == KOSA_StatusSuccess) && (OSA_MsgQAvailableMsgs((osa_msgq_handle_t)s_queue) == 1) &&
+         (OSA_MsgQGet((osa_msgq_handle_t)s_queue, message, 0U) == KOSA_StatusTimeout);
+    BENCH_MakeMessage(pSlot, BENCH_TASK, 0U);
+    ok = ok && (OSA_MsgQCommit((osa_msgq_handle_t)s_queue, pSlot) == KOSA_StatusSuccess) &&
+         BENCH_GetMessage(BENCH_TASK, 0U) && BENCH_GetMessage(BENCH_ISR, 0U);
+    BENCH_ReportInterleave("put in loan", ok);
+
+    /* A released loan is skipped and its slot is used again. */
+    BENCH_CreateQueue(32U);
+    ok = (OSA_MsgQReserve((osa_msgq_handle_t)s_queue, (void **)&pSlot) == KOSA_StatusSuccess);
+    HOSTSIM_PendIRQ(PIN_INT0_IRQn);
+    HOSTSIM_Poll();
+    ok = ok && (OSA_MsgQRelease((osa_msgq_handle_t)s_queue, pSlot) == KOSA_StatusSuccess) &&
+         BENCH_GetMessage(BENCH_ISR, 0U);
+    for (i = 0U; i < BENCH_QUEUE_LENGTH; i++)
+    {
+        BENCH_MakeMessage(message, BENCH_TASK, i);
+        ok = ok && (OSA_MsgQPut((osa_msgq_handle_t)s_queue, message) == KOSA_StatusSuccess);
+    }
+    ok = ok && (OSA_MsgQPut((osa_msgq_handle_t)s_queue, message) == KOSA_StatusError);
+    for (i = 0U; i < BENCH_QUEUE_LENGTH; i++)
+    {
+        ok = ok && BENCH_GetMessage(BENCH_TASK, i);
+    }
+    BENCH_ReportInterleave("release in loan", ok);
+#endif
+}
+
+static void BENCH_Stress(void)
+{
+    uint32_t message[BENCH_MAX_MSG_WORDS];
+    uint32_t received;
+    uint32_t corrupted;
+    uint32_t reordered;
+    uint32_t i;
+    bool ok;
+
+    BENCH_CreateQueue(BENCH_MAX_MSG_WORDS * sizeof(uint32_t));
+    (void)memset(s_sequence, 0, sizeof(s_sequence));
+    (void)memset(s_put, 0, sizeof(s_put));
+    (void)memset(s_consumer, 0, sizeof(s_consumer));
+
+    s_stressRunning = true;
+    (void)SysTick_Config(SystemCoreClock / BENCH_STRESS_TICK_HZ);
+    for (i = 0U; i < BENCH_STRESS_MSGS; i++)
+    {
+        BENCH_StressStep(BENCH_TASK);
+    }
+    SysTick->CTRL   = 0U;
+    s_stressRunning = false;
+
+    while (OSA_MsgQGet((osa_msgq_handle_t)s_queue, message, 0U) == KOSA_StatusSuccess)
+    {
+        BENCH_Consume(&s_consumer[BENCH_TASK], message);
+    }
+
+    received  = s_consumer[BENCH_TASK].received + s_consumer[BENCH_ISR].received;
+    corrupted = s_consumer[BENCH_TASK].corrupted + s_consumer[BENCH_ISR].corrupted;
+    reordered = s_consumer[BENCH_TASK].reordered + s_consumer[BENCH_ISR].reordered;
+    ok        = (received == (s_put[BENCH_TASK] + s_put[BENCH_ISR])) && (corrupted == 0U) && (reordered == 0U) &&
+         (s_put[BENCH_ISR] != 0U);
+
+    (void)printf("%-5s stress  task puts %6u  isr puts %5u  isr gets %5u  corrupted %u  reordered %u  %s\r\n",
+                 BENCH_MODE_NAME, (unsigned int)s_put[BENCH_TASK], (unsigned int)s_put[BENCH_ISR],
+                 (unsigned int)s_consumer[BENCH_ISR].received, (unsigned int)corrupted, (unsigned int)reordered,
+                 ok ? "ok" : "FAILED");
+}
+
+/* Time of an empty masked section, the clock reads of the timing. */
+static double BENCH_MaskOverhead(void)
+{
+    hostsim_stats_t before;
+    hostsim_stats_t after;
+    uint32_t i;
+
+    HOSTSIM_SetMaskTiming(true);
+    HOSTSIM_GetStats(&before);
+    for (i = 0U; i < BENCH_MEASURE_MSGS; i++)
+    {
+        __disable_irq();
+        __enable_irq();
+    }
+    HOSTSIM_GetStats(&after);
+    HOSTSIM_SetMaskTiming(false);
+
+    return (double)(after.maskedNs - before.maskedNs) / (double)BENCH_MEASURE_MSGS;
+}
+
+static void BENCH_MaskedTime(uint32_t msgSize, double overhead)
+{
+    uint32_t message[BENCH_MAX_MSG_WORDS];
+    hostsim_stats_t before;
+    hostsim_stats_t after;
+    uint32_t sections;
+    uint32_t i;
+
+    BENCH_CreateQueue(msgSize);
+    BENCH_MakeMessage(message, BENCH_TASK, 0U);
+
+    HOSTSIM_SetMaskTiming(true);
+    HOSTSIM_GetStats(&before);
+    for (i = 0U; i < BENCH_MEASURE_MSGS; i++)
+    {
+        (void)OSA_MsgQPut((osa_msgq_handle_t)s_queue, message);
+        (void)OSA_MsgQGet((osa_msgq_handle_t)s_queue, message, 0U);
+    }
+    HOSTSIM_GetStats(&after);
+    HOSTSIM_SetMaskTiming(false);
+
+    sections = (after.maskedCount - before.maskedCount) / BENCH_MEASURE_MSGS;
+    (void)printf("%-5s masked %2u byte msg  put+get %6.1f ns in %u sections  max %6u ns\r\n", BENCH_MODE_NAME,
+                 (unsigned int)msgSize,
+                 ((double)(after.maskedNs - before.maskedNs) / (double)BENCH_MEASURE_MSGS) -
+                     ((double)sections * overhead),
+                 (unsigned int)sections, (unsigned int)after.maskedMaxNs);
+}
+
+int main(void)
+{
+    uint32_t msgSize;
+    double overhead;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    NVIC_EnableIRQ(PIN_INT0_IRQn);
+
+    BENCH_Interleave();
+    BENCH_Stress();
+
+    /* The masked time is reported without the clock reads, the max includes them and the tick signal. */
+    overhead = BENCH_MaskOverhead();
+    for (msgSize = 4U; msgSize <= (BENCH_MAX_MSG_WORDS * sizeof(uint32_t)); msgSize *= 2U)
+    {
+        BENCH_MaskedTime(msgSize, overhead);
+    }
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,362 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Runs the RTX kernel on the host with 4 to 64 threads sleeping in osDelay and as many periodic
+ * timers, and measures the time distribution of the service calls that put a thread or a timer into
+ * the delay or timer list and of the kernel tick. Every wakeup and timer callback is checked against
+ * the tick it was due, tickless idle is checked with osKernelSuspend and osKernelResume. Built once
+ * per list, see OS_DELAY_WHEEL.
+ *
+ * The bench acts as the running thread, see rtx/rtx_core_host.h. The kernel tick is SysTick pended
+ * by the bench, the timer callbacks are read from the timer queue instead of the timer thread.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "fsl_hostsim.h"
+#include "cmsis_os2.h"
+#include "rtx_os.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_SLEEPERS_MAX (64U)
+#define BENCH_TICKS        (50000U)
+#define BENCH_SKIP_EVERY   (16U)
+#define BENCH_DELAY_SHORT  (256U)
+#define BENCH_LONG_EVERY   (64U)
+#define BENCH_DELAY_LONG   (100000U)
+#define BENCH_CALLBACKS    (BENCH_SLEEPERS_MAX)
+#define BENCH_SAMPLES      (BENCH_TICKS * 2U)
+#define BENCH_STACK_SIZE   (256U)
+#define BENCH_THREADS      (BENCH_SLEEPERS_MAX + 1U)
+
+#if (defined(OS_DELAY_WHEEL) && (OS_DELAY_WHEEL != 0))
+#define BENCH_LIST_NAME "wheel"
+#else
+#define BENCH_LIST_NAME "list"
+#endif
+
+typedef struct _bench_samples
+{
+    uint32_t count;
+    uint32_t ns[BENCH_SAMPLES];
+} bench_samples_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static osRtxThread_t s_threadCb[BENCH_THREADS];
+static uint64_t s_threadStack[BENCH_THREADS][BENCH_STACK_SIZE / 8U];
+static uint32_t s_threadCount;
+
+static osThreadId_t s_ctrl;
+static uint32_t s_sleepers;
+static uint32_t s_wakeTick[BENCH_THREADS];
+
+static osTimerId_t s_timer[BENCH_SLEEPERS_MAX];
+static uint32_t s_timerPeriod[BENCH_SLEEPERS_MAX];
+static uint32_t s_timerTick[BENCH_SLEEPERS_MAX];
+static uint32_t s_timers;
+
+static bench_samples_t s_delaySamples;
+static bench_samples_t s_timerSamples;
+static bench_samples_t s_tickSamples;
+
+static uint32_t s_late;
+static uint32_t s_errors;
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t BENCH_GetNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+/* Called by the kernel instead of the endless loop of RTX_Config.c. */
+uint32_t osRtxErrorNotify(uint32_t code, void *object_id)
+{
+    (void)code;
+    (void)object_id;
+
+    s_errors++;
+
+    return 0U;
+}
+
+/*
+ * The timer queue of rtx_lib.c is sized for the 8 byte callback info of the target, it takes 16
+ * bytes on the host. The kernel gets a queue of the host size instead, the bench is linked with
+ * --wrap=osRtxMessageQueueTimerSetup.
+ */
+int32_t __wrap_osRtxMessageQueueTimerSetup(void)
+{
+    static osRtxMessageQueue_t cb;
+    static uint64_t mem[(BENCH_CALLBACKS * (sizeof(osRtxTimerFinfo_t) + sizeof(osRtxMessage_t))) / 8U];
+    osMessageQueueAttr_t attr = {0};
+
+    attr.cb_mem  = &cb;
+    attr.cb_size = sizeof(cb);
+    attr.mq_mem  = mem;
+    attr.mq_size = sizeof(mem);
+
+    osRtxInfo.timer.mq = osMessageQueueNew(BENCH_CALLBACKS, sizeof(osRtxTimerFinfo_t), &attr);
+
+    return (osRtxInfo.timer.mq != NULL) ? 0 : -1;
+}
+
+static void BENCH_Thread(void *argument)
+{
+    (void)argument;
+}
+
+static void BENCH_TimerCallback(void *argument)
+{
+    (void)argument;
+}
+
+static osThreadId_t BENCH_NewThread(const char *name, osPriority_t priority)
+{
+    osThreadAttr_t attr = {0};
+
+    attr.name       = name;
+    attr.cb_mem     = &s_threadCb[s_threadCount];
+    attr.cb_size    = sizeof(s_threadCb[0]);
+    attr.stack_mem  = s_threadStack[s_threadCount];
+    attr.stack_size = sizeof(s_threadStack[0]);
+    attr.priority   = priority;
+    s_threadCount++;
+
+    return osThreadNew(BENCH_Thread, NULL, &attr);
+}
+
+/* Mostly short delays, one in BENCH_LONG_EVERY long enough for the upper levels and the overflow of the wheel. */
+static uint32_t BENCH_Delay(void)
+{
+    if ((BENCH_Random() % BENCH_LONG_EVERY) == 0U)
+    {
+        return 1U + (BENCH_Random() % BENCH_DELAY_LONG);
+    }
+
+    return 1U + (BENCH_Random() % BENCH_DELAY_SHORT);
+}
+
+static void BENCH_Record(bench_samples_t *samples, uint64_t ns)
+{
+    if (samples->count < BENCH_SAMPLES)
+    {
+        samples->ns[samples->count++] = (uint32_t)ns;
+    }
+}
+
+static int BENCH_Compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* The running sleeper goes back to sleep, the next ready sleeper or the control thread runs on. */
+static void BENCH_Sleep(void)
+{
+    uint32_t index = (uint32_t)((osRtxThread_t *)osThreadGetId() - s_threadCb);
+    uint32_t delay = BENCH_Delay();
+    uint64_t start;
+
+    s_wakeTick[index] = osKernelGetTickCount() + delay;
+    start             = BENCH_GetNs();
+    (void)osDelay(delay);
+    BENCH_Record(&s_delaySamples, BENCH_GetNs() - start);
+}
+
+/* Sleepers woken by the tick run before the control thread, each one is checked and sleeps again. */
+static void BENCH_Wakeups(void)
+{
+    uint32_t index;
+
+    while (osThreadGetId() != s_ctrl)
+    {
+        index = (uint32_t)((osRtxThread_t *)osThreadGetId() - s_threadCb);
+        if (osKernelGetTickCount() != s_wakeTick[index])
+        {
+            s_late++;
+        }
+        BENCH_Sleep();
+    }
+}
+
+static void BENCH_TimerStart(uint32_t index)
+{
+    uint32_t period = BENCH_Delay();
+    uint64_t start;
+
+    s_timerPeriod[index] = period;
+    s_timerTick[index]   = osKernelGetTickCount() + period;
+    start                = BENCH_GetNs();
+    (void)osTimerStart(s_timer[index], period);
+    BENCH_Record(&s_timerSamples, BENCH_GetNs() - start);
+}
+
+/* Callbacks queued by the tick, each timer is due now and again one period later. */
+static void BENCH_Callbacks(void)
+{
+    osRtxTimerFinfo_t finfo;
+    uint32_t index;
+
+    while (osMessageQueueGet(osRtxInfo.timer.mq, &finfo, NULL, 0U) == osOK)
+    {
+        index = (uint32_t)(uintptr_t)finfo.arg;
+        if (s_timerTick[index] != osKernelGetTickCount())
+        {
+            s_late++;
+        }
+        s_timerTick[index] += s_timerPeriod[index];
+    }
+}
+
+static void BENCH_Tick(void)
+{
+    uint64_t start = BENCH_GetNs();
+
+    HOSTSIM_PendIRQ(SysTick_IRQn);
+    HOSTSIM_Poll();
+    BENCH_Record(&s_tickSamples, BENCH_GetNs() - start);
+
+    BENCH_Callbacks();
+    BENCH_Wakeups();
+}
+
+/* Tickless idle: the sleep time is the next due wakeup or callback, part of it is skipped. */
+static void BENCH_Idle(void)
+{
+    uint32_t now   = osKernelGetTickCount();
+    uint32_t sleep = osWaitForever;
+    uint32_t ticks;
+    uint32_t i;
+
+    for (i = 0U; i < s_sleepers; i++)
+    {
+        ticks = s_wakeTick[i + 1U] - now;
+        sleep = (ticks < sleep) ? ticks : sleep;
+    }
+    for (i = 0U; i < s_timers; i++)
+    {
+        ticks = s_timerTick[i] - now;
+        sleep = (ticks < sleep) ? ticks : sleep;
+    }
+
+    ticks = osKernelSuspend();
+    if (ticks != sleep)
+    {
+        s_late++;
+    }
+    osKernelResume(BENCH_Random() % ticks);
+}
+
+static void BENCH_Report(const char *name, uint32_t sleepers, bench_samples_t *samples, bool ok)
+{
+    uint64_t sum = 0U;
+    uint32_t i;
+
+    qsort(samples->ns, samples->count, sizeof(samples->ns[0]), BENCH_Compare);
+    for (i = 0U; i < samples->count; i++)
+    {
+        sum += samples->ns[i];
+    }
+
+    (void)printf("%-5s %-6s %2u sleeping  mean %6.1f  p50 %5u  p99 %5u  max %6u ns  %s\r\n", BENCH_LIST_NAME, name,
+                 (unsigned int)sleepers, (double)sum / (double)samples->count,
+                 (unsigned int)samples->ns[samples->count / 2U],
+                 (unsigned int)samples->ns[(samples->count * 99U) / 100U],
+                 (unsigned int)samples->ns[samples->count - 1U], ok ? "ok" : "FAILED");
+}
+
+static void BENCH_Run(uint32_t sleepers)
+{
+    uint32_t tick;
+
+    /* A new sleeper preempts the control thread and goes to sleep at once. */
+    while (s_sleepers < sleepers)
+    {
+        (void)BENCH_NewThread("sleeper", osPriorityNormal);
+        BENCH_Sleep();
+        s_sleepers++;
+    }
+    while (s_timers < sleepers)
+    {
+        s_timer[s_timers] = osTimerNew(BENCH_TimerCallback, osTimerPeriodic, (void *)(uintptr_t)s_timers, NULL);
+        BENCH_TimerStart(s_timers);
+        s_timers++;
+    }
+
+    s_delaySamples.count = 0U;
+    s_timerSamples.count = 0U;
+    s_tickSamples.count  = 0U;
+    s_late               = 0U;
+
+    for (tick = 0U; tick < BENCH_TICKS; tick++)
+    {
+        if ((tick % BENCH_SKIP_EVERY) == 0U)
+        {
+            BENCH_Idle();
+        }
+        BENCH_Tick();
+        BENCH_TimerStart(BENCH_Random() % s_timers);
+    }
+
+    BENCH_Report("delay", sleepers, &s_delaySamples, s_late == 0U);
+    BENCH_Report("timer", sleepers, &s_timerSamples, s_late == 0U);
+    BENCH_Report("tick", sleepers, &s_tickSamples, s_late == 0U);
+}
+
+int main(void)
+{
+    bool ok;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    (void)osKernelInitialize();
+    s_ctrl = BENCH_NewThread("ctrl", osPriorityBelowNormal);
+    (void)osKernelStart();
+    ok = (osThreadGetId() == s_ctrl) && (osRtxInfo.timer.mq != NULL);
+    (void)printf("%-5s kernel start                                                       %s\r\n", BENCH_LIST_NAME,
+                 ok ? "ok" : "FAILED");
+
+    BENCH_Run(4U);
+    BENCH_Run(16U);
+    BENCH_Run(64U);
+
+    (void)printf("%-5s kernel errors %-6u                                               %s\r\n", BENCH_LIST_NAME,
+                 (unsigned int)s_errors, (s_errors == 0U) ? "ok" : "FAILED");
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,408 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Runs the timer manager on a virtual hal_timer and measures the host time spent with interrupts
+ * masked for 4 to 64 opened timers. The hal_timer below stands in for the CTIMER adapter: a 1 MHz
+ * counter that restarts at the timeout and then calls the callback of the timer manager, moved on
+ * in virtual time by the bench. A quarter of the timers are interval timers of 1 to 50 ms, a quarter
+ * restart themselves from their callback with 0.5 to 20 ms, a quarter are guards that the
+ * application starts and mostly stops before they expire, and the rest stay opened but idle.
+ *
+ * Every callback is checked against the time its timer should expire: never early, and late by no
+ * more than TM_MIN_TIMER_INTERVAL. TM_GetRemainingTime of a running guard not yet due must give the
+ * time left. The callback times are folded into a checksum that must be the one of the list backend
+ * for both backends, the run is in virtual time and the same on every host. Built
+ * once per backend, see TM_ENABLE_DELTA_QUEUE. The handles hold pointers and are larger than
+ * TIMER_HANDLE_SIZE on the host.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fsl_hostsim.h"
+#include "fsl_adapter_timer.h"
+#include "fsl_component_timer_manager.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_MAX_TIMERS   (64U)
+#define BENCH_HANDLE_WORDS (8U) /* 64 bytes, the handle with host pointers. */
+#define BENCH_RUN_US       (10000000U)
+#define BENCH_HAL_MAX_US   (0xFFFFFFFFU - 4000U) /* HAL_TimerGetMaxTimeout of the CTIMER adapter at 1 MHz. */
+
+#ifndef TM_MIN_TIMER_INTERVAL
+#define TM_MIN_TIMER_INTERVAL 300U
+#endif
+
+#if (defined(TM_ENABLE_DELTA_QUEUE) && (TM_ENABLE_DELTA_QUEUE > 0U))
+#define BENCH_BACKEND_NAME "delta"
+#else
+#define BENCH_BACKEND_NAME "list"
+#endif
+
+typedef enum _bench_kind
+{
+    kBENCH_Interval = 0U,
+    kBENCH_Chained,
+    kBENCH_Guard,
+    kBENCH_Idle,
+} bench_kind_t;
+
+typedef struct _bench_timer
+{
+    uint64_t expected; /* Virtual time the timer should expire. */
+    uint32_t interval;
+    uint32_t seed; /* Timeouts of a chained timer, the same whatever the order of the callbacks. */
+    bench_kind_t kind;
+    bool running;
+} bench_timer_t;
+
+/* The virtual hal_timer, a single instance. */
+typedef struct _bench_hal_timer
+{
+    uint32_t count;
+    uint32_t timeout;
+    bool running;
+    hal_timer_callback_t callback;
+    void *callbackParam;
+} bench_hal_timer_t;
+
+typedef struct _bench_result
+{
+    uint32_t callbacks;
+    uint32_t early;
+    uint32_t late;
+    uint32_t lateMax;
+    uint32_t remainingChecks;
+    uint32_t remainingErrors;
+    uint32_t checksum;
+} bench_result_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Checksums of the callback times with the list backend, for 4, 8, 16, 32 and 64 timers. */
+static const uint32_t s_reference[] = {0xF2674CC8U, 0xE8D29E99U, 0x3730DD4EU, 0x8CA16410U, 0x344694C6U};
+
+static uint64_t s_handles[BENCH_MAX_TIMERS][BENCH_HANDLE_WORDS];
+static bench_timer_t s_timers[BENCH_MAX_TIMERS];
+static uint32_t s_timerCount;
+
+static bench_hal_timer_t s_hal;
+static uint64_t s_nowUs;
+static bench_result_t s_result;
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+static uint32_t BENCH_ChainedTimeout(bench_timer_t *timer)
+{
+    timer->seed = (timer->seed * 1103515245U) + 12345U;
+
+    return 500U + (((timer->seed >> 8U) % 40U) * 500U);
+}
+
+hal_timer_status_t HAL_TimerInit(hal_timer_handle_t halTimerHandle, hal_timer_config_t *halTimerConfig)
+{
+    (void)halTimerHandle;
+
+    (void)memset(&s_hal, 0, sizeof(s_hal));
+    s_hal.timeout = halTimerConfig->timeout;
+
+    return kStatus_HAL_TimerSuccess;
+}
+
+void HAL_TimerDeinit(hal_timer_handle_t halTimerHandle)
+{
+    (void)halTimerHandle;
+
+    s_hal.running = false;
+}
+
+void HAL_TimerEnable(hal_timer_handle_t halTimerHandle)
+{
+    (void)halTimerHandle;
+
+    s_hal.running = true;
+}
+
+void HAL_TimerDisable(hal_timer_handle_t halTimerHandle)
+{
+    (void)halTimerHandle;
+
+    s_hal.running = false;
+}
+
+void HAL_TimerInstallCallback(hal_timer_handle_t halTimerHandle, hal_timer_callback_t callback, void *callbackParam)
+{
+    (void)halTimerHandle;
+
+    s_hal.callback      = callback;
+    s_hal.callbackParam = callbackParam;
+}
+
+uint32_t HAL_TimerGetMaxTimeout(hal_timer_handle_t halTimerHandle)
+{
+    (void)halTimerHandle;
+
+    return BENCH_HAL_MAX_US;
+}
+
+uint32_t HAL_TimerGetCurrentTimerCount(hal_timer_handle_t halTimerHandle)
+{
+    (void)halTimerHandle;
+
+    return s_hal.count;
+}
+
+/* As the CTIMER adapter, the timer is set up again: stopped with the counter cleared. */
+hal_timer_status_t HAL_TimerUpdateTimeout(hal_timer_handle_t halTimerHandle, uint32_t timeout)
+{
+    (void)halTimerHandle;
+
+    if ((timeout < 1U) || (timeout > BENCH_HAL_MAX_US))
+    {
+        return kStatus_HAL_TimerOutOfRanger;
+    }
+    s_hal.timeout = timeout;
+    s_hal.count   = 0U;
+    s_hal.running = false;
+
+    return kStatus_HAL_TimerSuccess;
+}
+
+void HAL_TimerExitLowpower(hal_timer_handle_t halTimerHandle)
+{
+    (void)halTimerHandle;
+}
+
+void HAL_TimerEnterLowpower(hal_timer_handle_t halTimerHandle)
+{
+    (void)halTimerHandle;
+}
+
+/* Moves the virtual time on to the target, the counter restarts and interrupts at the timeout. */
+static void BENCH_AdvanceTo(uint64_t targetUs)
+{
+    uint64_t step;
+
+    while (s_nowUs < targetUs)
+    {
+        step = targetUs - s_nowUs;
+        if (s_hal.running && (step >= (uint64_t)(s_hal.timeout - s_hal.count)))
+        {
+            s_nowUs += (uint64_t)(s_hal.timeout - s_hal.count);
+            s_hal.count = 0U;
+            /* The match interrupt, taken from thread mode with interrupts enabled. */
+            if (s_hal.callback != NULL)
+            {
+                s_hal.callback(s_hal.callbackParam);
+            }
+        }
+        else
+        {
+            s_hal.count += s_hal.running ? (uint32_t)step : 0U;
+            s_nowUs = targetUs;
+        }
+    }
+}
+
+static void BENCH_Start(uint32_t index, uint8_t type, uint32_t timeoutUs)
+{
+    s_timers[index].expected = s_nowUs + timeoutUs;
+    s_timers[index].running  = true;
+    (void)TM_Start((timer_handle_t)s_handles[index], type | kTimerModeSetMicrosTimer, timeoutUs);
+}
+
+static void BENCH_Callback(void *param)
+{
+    uint32_t index       = (uint32_t)(uintptr_t)param;
+    bench_timer_t *timer = &s_timers[index];
+    uint64_t late;
+
+    s_result.callbacks++;
+    if (s_nowUs < timer->expected)
+    {
+        s_result.early++;
+    }
+    else
+    {
+        late             = s_nowUs - timer->expected;
+        s_result.late += (late != 0U) ? 1U : 0U;
+        s_result.lateMax = (late > s_result.lateMax) ? (uint32_t)late : s_result.lateMax;
+    }
+    /* A sum, timers expiring at the same time may be called back in another order. */
+    s_result.checksum += ((index + 1U) * 2654435761U) ^ ((uint32_t)s_nowUs * 40503U);
+
+    switch (timer->kind)
+    {
+        case kBENCH_Interval:
+            /* Restarted by the timer manager, the interval counts from this expiry. */
+            timer->expected = s_nowUs + timer->interval;
+            break;
+        case kBENCH_Chained:
+            BENCH_Start(index, kTimerModeSingleShot, BENCH_ChainedTimeout(timer));
+            break;
+        default:
+            timer->running = false;
+            break;
+    }
+}
+
+/* The application: starts a guard, or stops it or checks its time left if it runs. */
+static void BENCH_Application(void)
+{
+    uint32_t guards = s_timerCount / 4U;
+    uint32_t index  = (2U * guards) + (BENCH_Random() % guards);
+    uint32_t remaining;
+
+    if (!s_timers[index].running)
+    {
+        BENCH_Start(index, kTimerModeSingleShot, 5000U + ((BENCH_Random() % 96U) * 1000U));
+    }
+    else if ((BENCH_Random() % 4U) != 0U)
+    {
+        s_timers[index].running = false;
+        (void)TM_Stop((timer_handle_t)s_handles[index]);
+    }
+    else if (s_timers[index].expected > s_nowUs)
+    {
+        /* Not for a guard past its time, the list backend does not stop at zero. */
+        remaining = TM_GetRemainingTime((timer_handle_t)s_handles[index]);
+        s_result.remainingChecks++;
+        s_result.remainingErrors += (remaining != (uint32_t)(s_timers[index].expected - s_nowUs)) ? 1U : 0U;
+    }
+}
+
+/* Time of an empty masked section, the clock reads of the timing. */
+static double BENCH_MaskOverhead(void)
+{
+    hostsim_stats_t before;
+    hostsim_stats_t after;
+    uint32_t i;
+
+    HOSTSIM_SetMaskTiming(true);
+    HOSTSIM_GetStats(&before);
+    for (i = 0U; i < 100000U; i++)
+    {
+        __disable_irq();
+        __enable_irq();
+    }
+    HOSTSIM_GetStats(&after);
+    HOSTSIM_SetMaskTiming(false);
+
+    return (double)(after.maskedNs - before.maskedNs) / 100000.0;
+}
+
+static void BENCH_Run(uint32_t timers, uint32_t reference, double overhead)
+{
+    timer_config_t config = {.srcClock_Hz = 1000000U, .instance = 0U};
+    hostsim_stats_t before;
+    hostsim_stats_t after;
+    uint64_t appUs;
+    uint32_t sections;
+    uint32_t i;
+    bool ok;
+
+    (void)memset(s_handles, 0, sizeof(s_handles));
+    (void)memset(s_timers, 0, sizeof(s_timers));
+    (void)memset(&s_result, 0, sizeof(s_result));
+    s_timerCount = timers;
+    s_nowUs      = 0U;
+    (void)TM_Init(&config);
+
+    for (i = 0U; i < timers; i++)
+    {
+        s_timers[i].kind = (bench_kind_t)(i / (timers / 4U));
+        (void)TM_Open((timer_handle_t)s_handles[i]);
+        (void)TM_InstallCallback((timer_handle_t)s_handles[i], BENCH_Callback, (void *)(uintptr_t)i);
+    }
+
+    HOSTSIM_SetMaskTiming(true);
+    HOSTSIM_GetStats(&before);
+    for (i = 0U; i < timers; i++)
+    {
+        if (s_timers[i].kind == kBENCH_Interval)
+        {
+            s_timers[i].interval = 1000U + ((BENCH_Random() % 50U) * 1000U);
+            BENCH_Start(i, kTimerModeIntervalTimer, s_timers[i].interval);
+        }
+        else if (s_timers[i].kind == kBENCH_Chained)
+        {
+            s_timers[i].seed = i;
+            BENCH_Start(i, kTimerModeSingleShot, BENCH_ChainedTimeout(&s_timers[i]));
+        }
+        else
+        {
+            /* Started by the application or idle. */
+        }
+    }
+
+    appUs = 0U;
+    while (s_nowUs < BENCH_RUN_US)
+    {
+        appUs += 100U + (BENCH_Random() % 1901U);
+        BENCH_AdvanceTo(appUs);
+        BENCH_Application();
+    }
+    HOSTSIM_GetStats(&after);
+    HOSTSIM_SetMaskTiming(false);
+
+    for (i = 0U; i < timers; i++)
+    {
+        (void)TM_Close((timer_handle_t)s_handles[i]);
+    }
+    TM_Deinit();
+
+    sections = after.maskedCount - before.maskedCount;
+    ok       = (s_result.callbacks != 0U) && (s_result.early == 0U) && (s_result.lateMax <= TM_MIN_TIMER_INTERVAL) &&
+         (s_result.remainingChecks != 0U) && (s_result.remainingErrors == 0U) && (s_result.checksum == reference);
+    (void)printf("%-5s %2u timers  masked %6.2f us/ms  max %6u ns  %5.1f ns/section  late %5u max %3u us  callbacks %6u"
+                 "  checksum %08x  %s\r\n",
+                 BENCH_BACKEND_NAME, (unsigned int)timers,
+                 (((double)(after.maskedNs - before.maskedNs) - ((double)sections * overhead)) / 1000.0) /
+                     ((double)s_nowUs / 1000.0),
+                 (unsigned int)after.maskedMaxNs,
+                 ((double)(after.maskedNs - before.maskedNs) / (double)sections) - overhead,
+                 (unsigned int)s_result.late, (unsigned int)s_result.lateMax, (unsigned int)s_result.callbacks, (unsigned int)s_result.checksum,
+                 ok ? "ok" : "FAILED");
+}
+
+int main(void)
+{
+    double overhead;
+    uint32_t timers;
+    uint32_t i = 0U;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    overhead = BENCH_MaskOverhead();
+    for (timers = 4U; timers <= BENCH_MAX_TIMERS; timers *= 2U)
+    {
+        s_seed = timers;
+        BENCH_Run(timers, s_reference[i++], overhead);
+    }
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
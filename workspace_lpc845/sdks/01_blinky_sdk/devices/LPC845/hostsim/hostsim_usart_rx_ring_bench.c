@@ -0,0 +1,291 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Receives a numbered byte stream through the USART and DMA models into the DMA ring buffer and
+ * reads it in place with USART_TransferGetRxSpanDMA and USART_TransferReleaseRxSpanDMA. A scripted
+ * run checks the span offsets and lengths around the end of the ring: a span stops at the end and
+ * the rest follows from the start, and releasing less than a span returns the remainder first.
+ * A random run of arrivals, spans and partial releases then checks every byte over many wraps of
+ * the ring, and last the ring is filled past its size without a release, which must be reported
+ * as an overrun by the callback and the release and leave the ring empty and the stream intact.
+ */
+
+#include <stdio.h>
+
+#include "fsl_hostsim_models.h"
+#include "fsl_usart_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_RX_CHANNEL     (0U) /* USART0_RX_DMA request */
+#define BENCH_RING_SIZE      (64U)
+#define BENCH_BLOCK_SIZE     (16U)
+#define BENCH_DESCRIPTOR_NUM (BENCH_RING_SIZE / BENCH_BLOCK_SIZE)
+#define BENCH_RANDOM_BYTES   (50000U)
+
+typedef struct _bench_span
+{
+    uint32_t arrive;  /* Bytes received before the span is taken. */
+    uint32_t index;   /* Expected offset of the span in the ring. */
+    uint32_t length;  /* Expected length of the span. */
+    uint32_t release; /* Bytes released of the span. */
+} bench_span_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* From an empty ring, the tail moves 0, 40, 48, 64, 69, 78, 112 and 128. */
+static const bench_span_t s_script[] = {
+    {48U, 0U, 48U, 40U},  /* Less than returned. */
+    {0U, 40U, 8U, 8U},    /* The remainder first. */
+    {30U, 48U, 16U, 16U}, /* 30 bytes more cross the end, the span stops at the end of the ring. */
+    {0U, 0U, 14U, 5U},    /* The rest from the start. */
+    {0U, 5U, 9U, 9U},
+    {50U, 14U, 50U, 34U}, /* Ends at the end of the ring, the tail wraps to 0. */
+    {0U, 48U, 16U, 16U},
+    {0U, 0U, 0U, 0U},     /* Empty. */
+};
+
+/* Buffers seen by the DMA must have 32-bit addresses, they are static in a non-PIE program. */
+static uint16_t s_txFifoBuffer[16U];
+static uint16_t s_rxFifoBuffer[16U];
+static hostsim_fifo_t s_txFifo;
+static hostsim_fifo_t s_rxFifo;
+static hostsim_usart_model_t s_usartModel;
+static hostsim_dma_model_t s_dmaModel;
+
+DMA_ALLOCATE_LINK_DESCRIPTORS(s_rxDescriptors, BENCH_DESCRIPTOR_NUM);
+static dma_handle_t s_rxDmaHandle;
+static usart_dma_handle_t s_handle;
+static uint8_t s_ring[BENCH_RING_SIZE];
+
+static uint32_t s_sent;
+static uint32_t s_read;
+static volatile uint32_t s_blocks;
+static volatile uint32_t s_overruns;
+static volatile uint32_t s_errors;
+static uint32_t s_seed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t BENCH_Random(void)
+{
+    s_seed = (s_seed * 1103515245U) + 12345U;
+
+    return s_seed >> 8U;
+}
+
+/* Byte n of the stream, a pattern that does not repeat with the ring size. */
+static uint8_t BENCH_Byte(uint32_t n)
+{
+    return (uint8_t)((n * 7U) + (n >> 8U));
+}
+
+static void BENCH_Callback(USART_Type *base, usart_dma_handle_t *handle, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)userData;
+
+    if (status == kStatus_USART_RxIdle)
+    {
+        s_blocks++;
+    }
+    else if (status == kStatus_USART_RxRingBufferOverrun)
+    {
+        s_overruns++;
+    }
+    else
+    {
+        s_errors++;
+    }
+}
+
+/*
+ * Receives the next bytes of the stream, one character time each: the DMA moves the byte into the
+ * ring and a block interrupt is taken before the next byte, as on the line.
+ */
+static void BENCH_Arrive(uint32_t length)
+{
+    uint8_t byte;
+
+    while (length > 0U)
+    {
+        byte = BENCH_Byte(s_sent);
+        (void)HOSTSIM_UsartModelReceive(&s_usartModel, &byte, 1U);
+        HOSTSIM_Poll();
+        s_sent++;
+        length--;
+    }
+}
+
+/* Takes a span, checks it against the stream and releases part of it. */
+static bool BENCH_Span(uint32_t *index, uint32_t *length, uint32_t release)
+{
+    uint8_t *data;
+    uint32_t i;
+    bool ok;
+
+    *length = (uint32_t)USART_TransferGetRxSpanDMA(USART0, &s_handle, &data);
+    *index  = (data == NULL) ? 0U : (uint32_t)(data - s_ring);
+    ok      = ((*length == 0U) == (data == NULL)) && ((*index + *length) <= BENCH_RING_SIZE) &&
+         ((data == NULL) || (*index == (s_read % BENCH_RING_SIZE)));
+    for (i = 0U; ok && (i < *length); i++)
+    {
+        ok = data[i] == BENCH_Byte(s_read + i);
+    }
+
+    release = (release < *length) ? release : *length;
+    ok      = ok && (USART_TransferReleaseRxSpanDMA(USART0, &s_handle, release) == kStatus_Success);
+    s_read += release;
+
+    return ok;
+}
+
+static void BENCH_Setup(void)
+{
+    usart_config_t config;
+
+    HOSTSIM_FifoInit(&s_txFifo, s_txFifoBuffer, ARRAY_SIZE(s_txFifoBuffer));
+    HOSTSIM_FifoInit(&s_rxFifo, s_rxFifoBuffer, ARRAY_SIZE(s_rxFifoBuffer));
+    HOSTSIM_UsartModelInit(&s_usartModel, USART0, USART0_IRQn, &s_txFifo, &s_rxFifo);
+    HOSTSIM_DmaModelInit(&s_dmaModel, DMA0);
+    HOSTSIM_DmaModelConnect(&s_dmaModel, BENCH_RX_CHANNEL, (uint32_t)USART0, (uint32_t)kHOSTSIM_DmaRequestRx);
+
+    USART_GetDefaultConfig(&config);
+    config.baudRate_Bps = 115200U;
+    config.enableRx     = true;
+    (void)USART_Init(USART0, &config, CLOCK_GetFreq(kCLOCK_MainClk));
+
+    DMA_Init(DMA0);
+    DMA_EnableChannel(DMA0, BENCH_RX_CHANNEL);
+    DMA_CreateHandle(&s_rxDmaHandle, DMA0, BENCH_RX_CHANNEL);
+    (void)USART_TransferCreateHandleDMA(USART0, &s_handle, BENCH_Callback, NULL, NULL, &s_rxDmaHandle);
+    (void)USART_TransferStartRingBufferDMA(USART0, &s_handle, s_ring, BENCH_RING_SIZE, BENCH_BLOCK_SIZE,
+                                           s_rxDescriptors);
+
+    s_sent     = 0U;
+    s_read     = 0U;
+    s_blocks   = 0U;
+    s_overruns = 0U;
+    s_errors   = 0U;
+}
+
+static void BENCH_Teardown(void)
+{
+    USART_TransferStopRingBufferDMA(USART0, &s_handle);
+    DMA_Deinit(DMA0);
+    USART_Deinit(USART0);
+    HOSTSIM_DetachModel(&s_dmaModel.model);
+    HOSTSIM_DetachModel(&s_usartModel.model);
+}
+
+static void BENCH_Script(void)
+{
+    uint32_t index;
+    uint32_t length;
+    uint32_t i;
+    bool ok = true;
+
+    BENCH_Setup();
+    for (i = 0U; i < ARRAY_SIZE(s_script); i++)
+    {
+        BENCH_Arrive(s_script[i].arrive);
+        ok = BENCH_Span(&index, &length, s_script[i].release) && ok;
+        ok = ok && (index == s_script[i].index) && (length == s_script[i].length);
+        if (!ok)
+        {
+            (void)printf("script step %u: span at %u of %u bytes\r\n", (unsigned int)i, (unsigned int)index,
+                         (unsigned int)length);
+            break;
+        }
+    }
+    ok = ok && (s_blocks == (s_sent / BENCH_BLOCK_SIZE)) && (s_overruns == 0U) && (s_errors == 0U);
+    (void)printf("script   %3u spans  %6u bytes  %2u blocks  wrap and partial release     %s\r\n",
+                 (unsigned int)ARRAY_SIZE(s_script), (unsigned int)s_sent, (unsigned int)s_blocks,
+                 ok ? "ok" : "FAILED");
+    BENCH_Teardown();
+}
+
+static void BENCH_RandomRun(void)
+{
+    uint32_t spans   = 0U;
+    uint32_t wrapped = 0U;
+    uint32_t index;
+    uint32_t length;
+    uint32_t space;
+    uint32_t unread;
+    bool ok = true;
+
+    BENCH_Setup();
+    while (ok && (s_read < BENCH_RANDOM_BYTES))
+    {
+        /* Never more than the free space, the ring must not overrun. */
+        space = BENCH_RING_SIZE - (s_sent - s_read);
+        BENCH_Arrive(BENCH_Random() % (space + 1U));
+
+        unread = s_sent - s_read;
+        ok     = (USART_TransferGetRxRingBufferLengthDMA(USART0, &s_handle) == unread) &&
+             BENCH_Span(&index, &length, BENCH_Random() % (BENCH_RING_SIZE + 1U));
+        /* The span stopped at the end of the ring with more data behind it. */
+        wrapped += ((index + length) == BENCH_RING_SIZE) && (length < unread) ? 1U : 0U;
+        spans++;
+    }
+    ok = ok && (s_overruns == 0U) && (s_errors == 0U) && (wrapped != 0U);
+    (void)printf("random   %6u spans %6u bytes  %5u ring wraps %5u spans at the end  %s\r\n", (unsigned int)spans,
+                 (unsigned int)s_read, (unsigned int)(s_sent / BENCH_RING_SIZE), (unsigned int)wrapped,
+                 ok ? "ok" : "FAILED");
+    BENCH_Teardown();
+}
+
+static void BENCH_Overrun(void)
+{
+    uint32_t index;
+    uint32_t length;
+    uint32_t lost;
+    bool ok;
+
+    BENCH_Setup();
+    BENCH_Arrive(24U);
+    ok = BENCH_Span(&index, &length, 8U);
+
+    /* One block more than the free space, the DMA runs over the unread data. */
+    BENCH_Arrive(BENCH_RING_SIZE - (s_sent - s_read) + BENCH_BLOCK_SIZE);
+    ok     = ok && (s_overruns != 0U) &&
+         (USART_TransferReleaseRxSpanDMA(USART0, &s_handle, 0U) == kStatus_USART_RxRingBufferOverrun) &&
+         (USART_TransferGetRxRingBufferLengthDMA(USART0, &s_handle) == 0U);
+    lost   = s_sent - s_read;
+    s_read = s_sent;
+
+    /* The stream goes on from the next byte. */
+    BENCH_Arrive(40U);
+    ok = ok && BENCH_Span(&index, &length, BENCH_RING_SIZE) && (length == 40U) && BENCH_Span(&index, &length, 0U) &&
+         (length == 0U) && (s_errors == 0U);
+    (void)printf("overrun  %3u callbacks %3u bytes dropped, ring emptied, stream resumes  %s\r\n",
+                 (unsigned int)s_overruns, (unsigned int)lost, ok ? "ok" : "FAILED");
+    BENCH_Teardown();
+}
+
+int main(void)
+{
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    BENCH_Script();
+    BENCH_RandomRun();
+    BENCH_Overrun();
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
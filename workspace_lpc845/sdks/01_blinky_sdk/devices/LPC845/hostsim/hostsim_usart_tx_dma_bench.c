@@ -0,0 +1,465 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Sends header + payload + CRC frames through the USART and DMA models. Checks the descriptors
+ * USART_TransferSendVectorDMA builds for the segments, then streams frames through a line that
+ * shifts out one character per step and counts the steps the line stays idle with data queued.
+ * Last compares the CPU cost per byte of USART_WriteBlocking, USART_TransferSendNonBlocking and
+ * the DMA vector path.
+ */
+
+#include <stdio.h>
+
+#include "fsl_hostsim_models.h"
+#include "fsl_usart_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BENCH_TX_CHANNEL     (1U) /* USART0_TX_DMA request */
+#define BENCH_DESCRIPTOR_NUM (12U)
+#define BENCH_HEADER_SIZE    (4U)
+#define BENCH_CRC_SIZE       (2U)
+#define BENCH_LONG_PAYLOAD   (2500U) /* Three descriptors */
+#define BENCH_LINE_FIFO_SIZE (2U)    /* Holding and shift register */
+#define BENCH_FAST_FIFO_SIZE (4096U) /* Takes a whole frame, the CPU cost only */
+#define BENCH_STREAM_FRAMES  (200U)
+#define BENCH_MAX_PAYLOAD    (300U)
+#define BENCH_STREAM_SIZE    (BENCH_STREAM_FRAMES * (BENCH_HEADER_SIZE + BENCH_MAX_PAYLOAD + BENCH_CRC_SIZE))
+#define BENCH_COST_PAYLOAD   (1018U) /* 1024 bytes a frame */
+#define BENCH_COST_FRAMES    (16U)
+
+typedef struct _bench_sample
+{
+    uint64_t cycles;
+    hostsim_stats_t stats;
+} bench_sample_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Buffers seen by the DMA must have 32-bit addresses, they are static in a non-PIE program. */
+static uint16_t s_txFifoBuffer[BENCH_FAST_FIFO_SIZE];
+static uint16_t s_rxFifoBuffer[16U];
+static hostsim_fifo_t s_txFifo;
+static hostsim_fifo_t s_rxFifo;
+static hostsim_usart_model_t s_usartModel;
+static hostsim_dma_model_t s_dmaModel;
+
+DMA_ALLOCATE_LINK_DESCRIPTORS(s_txDescriptors, BENCH_DESCRIPTOR_NUM);
+static dma_handle_t s_txDmaHandle;
+static usart_dma_handle_t s_handle;
+static usart_handle_t s_irqHandle;
+
+static uint8_t s_payload[BENCH_LONG_PAYLOAD];
+/* Twice the queue, a frame refused by a full queue does not overwrite one still sent. */
+static uint8_t s_headers[2U * USART_DMA_TX_QUEUE_SIZE][BENCH_HEADER_SIZE];
+static uint8_t s_crcs[2U * USART_DMA_TX_QUEUE_SIZE][BENCH_CRC_SIZE];
+static uint8_t s_expected[BENCH_STREAM_SIZE];
+static uint8_t s_line[BENCH_STREAM_SIZE];
+static uint32_t s_lineCount;
+static uint32_t s_expectedCount;
+
+static volatile uint32_t s_txDone;
+static volatile uint32_t s_txErrors;
+static volatile bool s_irqTxDone;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void BENCH_Start(bench_sample_t *sample)
+{
+    HOSTSIM_GetStats(&sample->stats);
+    sample->cycles = HOSTSIM_GetCycles();
+}
+
+static void BENCH_Report(const char *name, const bench_sample_t *start, uint32_t bytes, bool ok)
+{
+    hostsim_stats_t stats;
+    uint64_t cycles = HOSTSIM_GetCycles() - start->cycles;
+
+    HOSTSIM_GetStats(&stats);
+    (void)printf("%-20s %6u bytes %10llu cycles %8.1f cycles/byte %6.3f traps/byte %5u irqs  %s\r\n", name,
+                 (unsigned int)bytes, (unsigned long long)cycles, (double)cycles / (double)bytes,
+                 (double)(stats.trapCount - start->stats.trapCount) / (double)bytes,
+                 (unsigned int)(stats.irqCount - start->stats.irqCount), ok ? "ok" : "FAILED");
+}
+
+static void BENCH_Callback(USART_Type *base, usart_dma_handle_t *handle, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)userData;
+
+    if (status == kStatus_USART_TxIdle)
+    {
+        s_txDone++;
+    }
+    else
+    {
+        s_txErrors++;
+    }
+}
+
+static void BENCH_IrqCallback(USART_Type *base, usart_handle_t *handle, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)userData;
+
+    if (status == kStatus_USART_TxIdle)
+    {
+        s_irqTxDone = true;
+    }
+}
+
+/* Attaches the USART model with a transmit FIFO of size frames and starts the drivers. */
+static void BENCH_Setup(uint32_t size)
+{
+    usart_config_t config;
+
+    HOSTSIM_FifoInit(&s_txFifo, s_txFifoBuffer, size);
+    HOSTSIM_FifoInit(&s_rxFifo, s_rxFifoBuffer, ARRAY_SIZE(s_rxFifoBuffer));
+    HOSTSIM_UsartModelInit(&s_usartModel, USART0, USART0_IRQn, &s_txFifo, &s_rxFifo);
+    HOSTSIM_DmaModelInit(&s_dmaModel, DMA0);
+    HOSTSIM_DmaModelConnect(&s_dmaModel, BENCH_TX_CHANNEL, (uint32_t)USART0, (uint32_t)kHOSTSIM_DmaRequestTx);
+
+    USART_GetDefaultConfig(&config);
+    config.baudRate_Bps = 115200U;
+    config.enableTx     = true;
+    (void)USART_Init(USART0, &config, CLOCK_GetFreq(kCLOCK_MainClk));
+
+    DMA_Init(DMA0);
+    DMA_CreateHandle(&s_txDmaHandle, DMA0, BENCH_TX_CHANNEL);
+    (void)USART_TransferCreateHandleDMA(USART0, &s_handle, BENCH_Callback, NULL, &s_txDmaHandle, NULL);
+    (void)USART_TransferInstallTxDescriptorsDMA(USART0, &s_handle, s_txDescriptors, BENCH_DESCRIPTOR_NUM);
+
+    s_txDone        = 0U;
+    s_txErrors      = 0U;
+    s_lineCount     = 0U;
+    s_expectedCount = 0U;
+}
+
+static void BENCH_Teardown(void)
+{
+    DMA_Deinit(DMA0);
+    USART_Deinit(USART0);
+    HOSTSIM_DetachModel(&s_dmaModel.model);
+    HOSTSIM_DetachModel(&s_usartModel.model);
+}
+
+/* Shifts one character out of the line, returns false when the line had nothing to send. */
+static bool BENCH_LineStep(void)
+{
+    uint32_t state;
+    uint16_t frame;
+    bool sent;
+
+    state = HOSTSIM_EnterModel(&s_usartModel.model);
+    sent  = HOSTSIM_FifoPop(&s_txFifo, &frame);
+    HOSTSIM_ExitModel(&s_usartModel.model, state);
+
+    if (sent && (s_lineCount < BENCH_STREAM_SIZE))
+    {
+        s_line[s_lineCount] = (uint8_t)frame;
+    }
+    if (sent)
+    {
+        s_lineCount++;
+    }
+
+    /* The USART raises TXRDY again, the DMA refills it and its interrupt is taken. */
+    HOSTSIM_Poll();
+
+    return sent;
+}
+
+/* Drops what the line holds, the CPU cost runs do not wait for the line. */
+static void BENCH_LineFlush(void)
+{
+    uint32_t state;
+
+    state         = HOSTSIM_EnterModel(&s_usartModel.model);
+    s_txFifo.tail = s_txFifo.head;
+    HOSTSIM_ExitModel(&s_usartModel.model, state);
+    HOSTSIM_Poll();
+}
+
+static void BENCH_Expect(const usart_transfer_t *vector, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0U; i < count; i++)
+    {
+        (void)memcpy(&s_expected[s_expectedCount], vector[i].txData, vector[i].dataSize);
+        s_expectedCount += (uint32_t)vector[i].dataSize;
+    }
+}
+
+/* Builds a frame in slot, the payload is a window of s_payload. */
+static void BENCH_Frame(usart_transfer_t *vector, uint32_t slot, uint32_t sequence, uint32_t offset, uint32_t size)
+{
+    s_headers[slot][0] = 0x2BU;
+    s_headers[slot][1] = (uint8_t)sequence;
+    s_headers[slot][2] = (uint8_t)size;
+    s_headers[slot][3] = (uint8_t)(size >> 8U);
+    s_crcs[slot][0]    = (uint8_t)(sequence * 7U);
+    s_crcs[slot][1]    = (uint8_t)(sequence * 13U);
+
+    vector[0].txData   = s_headers[slot];
+    vector[0].dataSize = BENCH_HEADER_SIZE;
+    vector[1].txData   = &s_payload[offset];
+    vector[1].dataSize = size;
+    vector[2].txData   = s_crcs[slot];
+    vector[2].dataSize = BENCH_CRC_SIZE;
+}
+
+/* Checks one built descriptor. */
+static bool BENCH_CheckDescriptor(uint32_t index, const uint8_t *data, uint32_t size, bool last)
+{
+    const dma_descriptor_t *descriptor = &s_txDescriptors[index];
+    uint32_t xfercfg                   = descriptor->xfercfg;
+    uint32_t count = ((xfercfg & DMA_CHANNEL_XFERCFG_XFERCOUNT_MASK) >> DMA_CHANNEL_XFERCFG_XFERCOUNT_SHIFT) + 1U;
+
+    return (count == size) && (descriptor->srcEndAddr == (const void *)&data[size - 1U]) &&
+           (descriptor->dstEndAddr == (void *)(uint32_t)&USART0->TXDAT) &&
+           (descriptor->linkToNextDesc == &s_txDescriptors[(index + 1U) % BENCH_DESCRIPTOR_NUM]) &&
+           (((xfercfg & DMA_CHANNEL_XFERCFG_SETINTA_MASK) != 0U) == last) &&
+           (((xfercfg & DMA_CHANNEL_XFERCFG_RELOAD_MASK) != 0U) == !last);
+}
+
+static void BENCH_Descriptors(void)
+{
+    usart_transfer_t vector[4];
+    usart_transfer_t frame[3];
+    usart_dma_tx_stats_t stats;
+    uint32_t i;
+    uint32_t steps;
+    bool ok = true;
+
+    BENCH_Setup(BENCH_LINE_FIFO_SIZE);
+
+    /* Rejected requests. */
+    vector[0].txData   = NULL;
+    vector[0].dataSize = 0U;
+    vector[1].txData   = NULL;
+    vector[1].dataSize = 4U;
+    ok = ok && (USART_TransferSendVectorDMA(USART0, &s_handle, NULL, 1U) == kStatus_InvalidArgument);
+    ok = ok && (USART_TransferSendVectorDMA(USART0, &s_handle, vector, 0U) == kStatus_InvalidArgument);
+    ok = ok && (USART_TransferSendVectorDMA(USART0, &s_handle, vector, 1U) == kStatus_InvalidArgument);
+    ok = ok && (USART_TransferSendVectorDMA(USART0, &s_handle, vector, 2U) == kStatus_InvalidArgument);
+
+    /* A long payload is split, the empty segment takes no descriptor. The line holds the DMA. */
+    BENCH_Frame(frame, 0U, 1U, 0U, BENCH_LONG_PAYLOAD);
+    vector[0] = frame[0];
+    vector[1] = frame[1];
+    vector[2].txData   = s_crcs[0];
+    vector[2].dataSize = 0U;
+    vector[3] = frame[2];
+    ok        = ok && (USART_TransferSendVectorDMA(USART0, &s_handle, vector, 4U) == kStatus_Success);
+    BENCH_Expect(frame, 3U);
+
+    ok = ok && (s_handle.txDescriptorFree == (BENCH_DESCRIPTOR_NUM - 5U));
+    ok = ok && BENCH_CheckDescriptor(0U, s_headers[0], BENCH_HEADER_SIZE, false);
+    ok = ok && BENCH_CheckDescriptor(1U, &s_payload[0], USART_MAX_DMA_TX_DESCRIPTOR_SIZE, false);
+    ok = ok && BENCH_CheckDescriptor(2U, &s_payload[1024], USART_MAX_DMA_TX_DESCRIPTOR_SIZE, false);
+    ok = ok && BENCH_CheckDescriptor(3U, &s_payload[2048], BENCH_LONG_PAYLOAD - 2048U, false);
+    ok = ok && BENCH_CheckDescriptor(4U, s_crcs[0], BENCH_CRC_SIZE, true);
+
+    /* Queued behind the running chain, they form the next one and wrap around the pool. */
+    BENCH_Frame(frame, 1U, 2U, 100U, 16U);
+    ok = ok && (USART_TransferSendVectorDMA(USART0, &s_handle, frame, 3U) == kStatus_Success);
+    BENCH_Expect(frame, 3U);
+    BENCH_Frame(frame, 2U, 3U, 200U, 1100U);
+    ok = ok && (USART_TransferSendVectorDMA(USART0, &s_handle, frame, 3U) == kStatus_Success);
+    BENCH_Expect(frame, 3U);
+    ok = ok && BENCH_CheckDescriptor(7U, s_crcs[1], BENCH_CRC_SIZE, true);
+    ok = ok && BENCH_CheckDescriptor(10U, &s_payload[1224], 76U, false);
+    ok = ok && BENCH_CheckDescriptor(11U, s_crcs[2], BENCH_CRC_SIZE, true);
+
+    /* The pool is full. */
+    BENCH_Frame(frame, 3U, 4U, 0U, 8U);
+    ok = ok && (USART_TransferSendVectorDMA(USART0, &s_handle, frame, 3U) == kStatus_USART_TxBusy);
+
+    for (steps = 0U; (s_txDone < 3U) && (steps < BENCH_STREAM_SIZE); steps++)
+    {
+        (void)BENCH_LineStep();
+    }
+    while (BENCH_LineStep())
+    {
+    }
+
+    /* The first request of the second chain now links on to the second one. */
+    ok = ok && ((s_txDescriptors[7].xfercfg & DMA_CHANNEL_XFERCFG_RELOAD_MASK) != 0U);
+    ok = ok && ((s_txDescriptors[11].xfercfg & DMA_CHANNEL_XFERCFG_RELOAD_MASK) == 0U);
+    ok = ok && (s_handle.txDescriptorFree == BENCH_DESCRIPTOR_NUM);
+
+    USART_TransferGetTxStatsDMA(USART0, &s_handle, &stats);
+    ok = ok && (stats.requestCount == 3U) && (stats.batchCount == 2U) && (stats.busyCount == 1U) &&
+         (stats.txBytes == s_expectedCount) && (s_txErrors == 0U);
+    ok = ok && (s_lineCount == s_expectedCount) && (memcmp(s_line, s_expected, s_expectedCount) == 0);
+
+    (void)printf("%-20s %u requests %u chains %u descriptors %6u bytes  %s\r\n", "descriptors",
+                 (unsigned int)stats.requestCount, (unsigned int)stats.batchCount, BENCH_DESCRIPTOR_NUM,
+                 (unsigned int)s_lineCount, ok ? "ok" : "FAILED");
+
+    /* Abort drops everything without a callback. */
+    BENCH_Frame(frame, 0U, 5U, 0U, 64U);
+    (void)USART_TransferSendVectorDMA(USART0, &s_handle, frame, 3U);
+    (void)USART_TransferSendVectorDMA(USART0, &s_handle, frame, 3U);
+    USART_TransferAbortSendDMA(USART0, &s_handle);
+    for (i = 0U; i < 16U; i++)
+    {
+        (void)BENCH_LineStep();
+    }
+    ok = (s_txDone == 3U) && (s_handle.txDescriptorFree == BENCH_DESCRIPTOR_NUM) &&
+         (USART_TransferSendVectorDMA(USART0, &s_handle, frame, 3U) == kStatus_Success);
+    while (BENCH_LineStep())
+    {
+    }
+    ok = ok && (s_txDone == 4U);
+    (void)printf("%-20s 2 requests dropped, the next one sent  %s\r\n", "abort", ok ? "ok" : "FAILED");
+
+    BENCH_Teardown();
+}
+
+static void BENCH_Stream(void)
+{
+    usart_transfer_t frame[3];
+    usart_dma_tx_stats_t stats;
+    uint32_t sent   = 0U;
+    uint32_t steps  = 0U;
+    uint32_t gaps   = 0U;
+    uint32_t size;
+    status_t status;
+    bool ok;
+
+    BENCH_Setup(BENCH_LINE_FIFO_SIZE);
+
+    /* The application queues frames as fast as the handle takes them, the line sets the pace. */
+    while ((s_txDone < BENCH_STREAM_FRAMES) && (steps < (4U * BENCH_STREAM_SIZE)))
+    {
+        while (sent < BENCH_STREAM_FRAMES)
+        {
+            size = ((sent * 2654435761U) >> 16U) % (BENCH_MAX_PAYLOAD + 1U);
+            BENCH_Frame(frame, sent % (2U * USART_DMA_TX_QUEUE_SIZE), sent, sent % 256U, size);
+            status = USART_TransferSendVectorDMA(USART0, &s_handle, frame, 3U);
+            if (status != kStatus_Success)
+            {
+                break;
+            }
+            BENCH_Expect(frame, 3U);
+            sent++;
+        }
+
+        if (!BENCH_LineStep() && (s_lineCount < s_expectedCount))
+        {
+            gaps++;
+        }
+        steps++;
+    }
+    /* The last request is reported when its last byte entered the USART. */
+    while (BENCH_LineStep())
+    {
+    }
+
+    USART_TransferGetTxStatsDMA(USART0, &s_handle, &stats);
+    ok = (s_txDone == BENCH_STREAM_FRAMES) && (s_txErrors == 0U) && (gaps == 0U) &&
+         (stats.txBytes == s_expectedCount) && (s_lineCount == s_expectedCount) &&
+         (memcmp(s_line, s_expected, s_expectedCount) == 0);
+
+    (void)printf("%-20s %u frames %6u bytes %3u chains %3u irqs %4u refused %u idle steps  %s\r\n", "stream",
+                 (unsigned int)stats.requestCount, (unsigned int)stats.txBytes, (unsigned int)stats.batchCount,
+                 (unsigned int)stats.irqCount, (unsigned int)stats.busyCount, (unsigned int)gaps,
+                 ok ? "ok" : "FAILED");
+
+    BENCH_Teardown();
+}
+
+static void BENCH_Cost(void)
+{
+    usart_transfer_t frame[3];
+    usart_transfer_t xfer;
+    bench_sample_t sample;
+    uint32_t bytes = BENCH_COST_FRAMES * (BENCH_HEADER_SIZE + BENCH_COST_PAYLOAD + BENCH_CRC_SIZE);
+    uint32_t i;
+    uint32_t j;
+    bool ok = true;
+
+    BENCH_Setup(BENCH_FAST_FIFO_SIZE);
+    BENCH_Frame(frame, 0U, 0U, 0U, BENCH_COST_PAYLOAD);
+
+    BENCH_Start(&sample);
+    for (i = 0U; i < BENCH_COST_FRAMES; i++)
+    {
+        for (j = 0U; j < 3U; j++)
+        {
+            ok = ok && (USART_WriteBlocking(USART0, frame[j].txData, frame[j].dataSize) == kStatus_Success);
+        }
+        BENCH_LineFlush();
+    }
+    BENCH_Report("write blocking", &sample, bytes, ok);
+
+    (void)USART_TransferCreateHandle(USART0, &s_irqHandle, BENCH_IrqCallback, NULL);
+    BENCH_Start(&sample);
+    for (i = 0U; i < BENCH_COST_FRAMES; i++)
+    {
+        for (j = 0U; j < 3U; j++)
+        {
+            xfer.txData   = frame[j].txData;
+            xfer.dataSize = frame[j].dataSize;
+            s_irqTxDone   = false;
+            ok            = ok && (USART_TransferSendNonBlocking(USART0, &s_irqHandle, &xfer) == kStatus_Success);
+            while (!s_irqTxDone)
+            {
+                __WFI();
+            }
+        }
+        BENCH_LineFlush();
+    }
+    BENCH_Report("send interrupt", &sample, bytes, ok);
+    NVIC_DisableIRQ(USART0_IRQn);
+
+    BENCH_Start(&sample);
+    for (i = 0U; i < BENCH_COST_FRAMES; i++)
+    {
+        ok = ok && (USART_TransferSendVectorDMA(USART0, &s_handle, frame, 3U) == kStatus_Success);
+        while (s_txDone <= i)
+        {
+            __WFI();
+        }
+        BENCH_LineFlush();
+    }
+    BENCH_Report("send vector dma", &sample, bytes, ok && (s_txErrors == 0U));
+
+    BENCH_Teardown();
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    if (HOSTSIM_Init() != kStatus_Success)
+    {
+        (void)printf("hostsim: peripheral address space not available\r\n");
+        return 1;
+    }
+
+    for (i = 0U; i < BENCH_LONG_PAYLOAD; i++)
+    {
+        s_payload[i] = (uint8_t)((i * 31U) ^ (i >> 8U));
+    }
+
+    BENCH_Descriptors();
+    BENCH_Stream();
+    BENCH_Cost();
+
+    HOSTSIM_Deinit();
+
+    return 0;
+}
@@ -0,0 +1,13 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Run-time environment of the RTX host benches, the device header of the LPC845.
+ */
+#ifndef RTE_COMPONENTS_H
+#define RTE_COMPONENTS_H
+
+#define CMSIS_device_header "LPC845.h"
+
+#endif /* RTE_COMPONENTS_H */
@@ -149,8 +149,6 @@ static void _FMSTR_NetPoll(void)
 
 static void _FMSTR_NetSendResponse(FMSTR_BPTR pResponse, FMSTR_SIZE nLength, FMSTR_U8 statusCode, void *identification)
 {
-    FMSTR_U16 i;
-    FMSTR_U8 c;
     FMSTR_U16 todo;
     FMSTR_U16 sent   = 0U;
     FMSTR_S32 res    = 1;
@@ -189,15 +187,8 @@ static void _FMSTR_NetSendResponse(FMSTR_BPTR pResponse, FMSTR_SIZE nLength, FMS
     FMSTR_Crc8Init(&chSum);
 
     /* Checksum CRC8 */
-    pResponse = &fmstr_pNetBuffer[3];
-    for (i = 0; i < nLength + 3U; i++)
-    {
-        /* Get from FMSTR buffer */
-        pResponse = FMSTR_ValueFromBuffer8(&c, pResponse);
-
-        /* add character to checksum */
-        FMSTR_Crc8AddByte(&chSum, c);
-    }
+    FMSTR_Crc8AddBlock(&chSum, &fmstr_pNetBuffer[3], nLength + 3U);
+    pResponse = FMSTR_SkipInBuffer(&fmstr_pNetBuffer[3], nLength + 3U);
 
     /* Store checksum after the message */
     pResponse = FMSTR_ValueToBuffer8(pResponse, chSum);
@@ -231,8 +222,6 @@ static void _FMSTR_NetSendResponse(FMSTR_BPTR pResponse, FMSTR_SIZE nLength, FMS
 static FMSTR_BOOL _FMSTR_NetProcess(void)
 {
     FMSTR_BCHR chSum = 0U, crc;
-    FMSTR_U16 i;
-    FMSTR_U8 c;
     int received   = 0;
     FMSTR_U16 todo = 0;
     FMSTR_BPTR pMessageIO, pCmdPayload, pCrc;
@@ -332,14 +321,7 @@ static FMSTR_BOOL _FMSTR_NetProcess(void)
     pMessageIO = FMSTR_ValueFromBuffer8(&crc, pMessageIO);
 
     /* Count CRC */
-    for (i = 0; i < nLength + 3U; i++)
-    {
-        /* Get from FMSTR buffer */
-        pCrc = FMSTR_ValueFromBuffer8(&c, pCrc);
-
-        /* add character to checksum */
-        FMSTR_Crc8AddByte(&chSum, c);
-    }
+    FMSTR_Crc8AddBlock(&chSum, pCrc, nLength + 3U);
 
     /* Checksum */
     if (crc == chSum)
@@ -136,6 +136,13 @@ FMSTR_TYPEDEF_LPTR(FMSTR_TSA_ENTRY, _FMSTR_LP_TSA_ENTRY);
 
 #define SHA1_BLOCK_SIZE 20
 
+/* One memory block of the session read group */
+typedef struct
+{
+    FMSTR_ADDR addr; /* Block address */
+    FMSTR_SIZE size; /* Block size */
+} FMSTR_READGROUP_ITEM;
+
 typedef struct fmstr_sha1_ctx
 {
     FMSTR_U8 data[64];
@@ -169,6 +176,11 @@ typedef struct FMSTR_SESSION_S
     } restr; /* Restricted access */
 #endif       /* FMSTR_CFG_F1_RESTRICTED_ACCESS */
 
+#if FMSTR_USE_READMEMS > 0 && FMSTR_MAX_READGROUP_VARS > 0
+    FMSTR_READGROUP_ITEM readGroup[FMSTR_MAX_READGROUP_VARS]; /* Blocks read by the READRDGRP command */
+    FMSTR_U8 readGroupCount;                                  /* Number of blocks in the read group */
+#endif
+
 } FMSTR_SESSION;
 
 /* There are multiple global instances of different transports. User selects one in
@@ -213,6 +225,9 @@ FMSTR_BOOL FMSTR_InitRec(void);
 FMSTR_BPTR FMSTR_SetRecCmd(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_SIZE inputLen, FMSTR_U8 *retStatus);
 FMSTR_BPTR FMSTR_GetRecCmd(FMSTR_SESSION *session, FMSTR_BPTR msgBuffIO, FMSTR_U8 *retStatus);
 FMSTR_BOOL FMSTR_IsInRecBuffer(FMSTR_ADDR addr, FMSTR_SIZE size);
+#if FMSTR_REC_COMPRESS > 0
+FMSTR_BPTR FMSTR_CopyRecToBuffer(FMSTR_BPTR destBuff, FMSTR_ADDR srcAddr, FMSTR_SIZE size);
+#endif
 #endif
 
 #if FMSTR_USE_TSA > 0
@@ -347,6 +362,17 @@ FMSTR_SIZE FMSTR_GetAlignmentCorrection(FMSTR_ADDR addr, FMSTR_SIZE size);
 #endif
 #endif
 
+/* check batched read settings */
+#if FMSTR_USE_READMEMS > 0
+#if FMSTR_USE_READMEM == 0
+#error Batched read needs the FMSTR_USE_READMEM feature
+#endif
+
+#if FMSTR_MAX_READGROUP_VARS > 255
+#error Error in FMSTR_MAX_READGROUP_VARS value. Use a value in range 0..255
+#endif
+#endif
+
 #if FMSTR_USE_PIPES > 0
 
 #if defined(FMSTR_PIPES_EXPERIMENTAL)
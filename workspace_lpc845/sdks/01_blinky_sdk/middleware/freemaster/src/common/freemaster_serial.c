@@ -340,9 +340,6 @@ static void _FMSTR_SerialSendResponse(FMSTR_BPTR pResponse,
                                       FMSTR_U8 statusCode,
                                       void *identification)
 {
-    FMSTR_SIZE8 i;
-    FMSTR_U8 c;
-
     FMSTR_UNUSED(identification);
 
     if (nLength > 254U || pResponse != &fmstr_pCommBuffer[2])
@@ -373,13 +370,8 @@ static void _FMSTR_SerialSendResponse(FMSTR_BPTR pResponse,
     FMSTR_Crc8Init(&fmstr_nRxCrc8);
 
     /* status byte and data are already there, compute checksum only     */
-    pResponse = fmstr_pTxBuff;
-    for (i = 1U; i < fmstr_nTxTodo; i++)
-    {
-        pResponse = FMSTR_ValueFromBuffer8(&c, pResponse);
-        /* add character to checksum */
-        FMSTR_Crc8AddByte(&fmstr_nRxCrc8, c);
-    }
+    FMSTR_Crc8AddBlock(&fmstr_nRxCrc8, fmstr_pTxBuff, (FMSTR_SIZE)(fmstr_nTxTodo - 1U));
+    pResponse = FMSTR_SkipInBuffer(fmstr_pTxBuff, fmstr_nTxTodo - 1U);
 
     /* store checksum after the message */
     pResponse = FMSTR_ValueToBuffer8(pResponse, fmstr_nRxCrc8);
@@ -39,6 +39,32 @@ static FMSTR_ADDR fmstr_tsaBuffAddr; /* Dynamic TSA buffer address */
 static FMSTR_SIZE fmstr_tsaTableIndex;
 #endif
 
+#if FMSTR_USE_TSA_SAFETY > 0 && FMSTR_TSA_INDEX_SIZE > 0
+/* Memory interval, the end is not part of it */
+typedef struct
+{
+    FMSTR_ADDR start;
+    FMSTR_ADDR end;
+} FMSTR_TSA_INTERVAL;
+
+/* Intervals sorted by address, merged so that no two of them overlap or touch */
+typedef struct
+{
+    FMSTR_TSA_INTERVAL items[FMSTR_TSA_INDEX_SIZE];
+    FMSTR_SIZE count;
+} FMSTR_TSA_INDEX;
+
+static FMSTR_TSA_INDEX fmstr_tsaReadIndex;  /* Variables, TSA tables and their strings */
+static FMSTR_TSA_INDEX fmstr_tsaWriteIndex; /* Read-write variables */
+static FMSTR_BOOL fmstr_tsaIndexValid;      /* All entries fit into the index, otherwise the tables are walked */
+
+static void _FMSTR_TsaIndexBuild(void);
+static void _FMSTR_TsaIndexAddEntry(FMSTR_LP_TSA_ENTRY pte);
+static void _FMSTR_TsaIndexAdd(FMSTR_TSA_INDEX *index, FMSTR_ADDR addr, FMSTR_SIZE size);
+static FMSTR_SIZE _FMSTR_TsaIndexFind(const FMSTR_TSA_INDEX *index, FMSTR_ADDR addr);
+static FMSTR_BOOL _FMSTR_TsaIndexCheck(const FMSTR_TSA_INDEX *index, FMSTR_ADDR addr, FMSTR_SIZE size);
+#endif
+
 /******************************************************************************
  *
  * @brief    TSA Initialization
@@ -54,6 +80,11 @@ FMSTR_BOOL FMSTR_InitTsa(void)
     fmstr_tsaBuffAddr   = (FMSTR_ADDR)NULL;
 #endif
 
+#if FMSTR_USE_TSA_SAFETY > 0 && FMSTR_TSA_INDEX_SIZE > 0
+    /* the static tables do not change, index them once */
+    _FMSTR_TsaIndexBuild();
+#endif
+
     return FMSTR_TRUE;
 }
 
@@ -73,6 +104,10 @@ FMSTR_BOOL FMSTR_SetUpTsaBuff(FMSTR_ADDR buffAddr, FMSTR_SIZE buffSize)
         FMSTR_SIZE alignment = FMSTR_GetAlignmentCorrection(buffAddr, sizeof(FMSTR_ADDR));
         fmstr_tsaBuffAddr    = buffAddr + alignment;
         fmstr_tsaBuffSize    = buffSize - alignment;
+#if FMSTR_USE_TSA_SAFETY > 0 && FMSTR_TSA_INDEX_SIZE > 0
+        /* entries of a cleared buffer must not stay accessible */
+        _FMSTR_TsaIndexBuild();
+#endif
         return FMSTR_TRUE;
     }
     else
@@ -160,6 +195,13 @@ FMSTR_BOOL FMSTR_TsaAddVar(FMSTR_TSATBL_STRPTR tsaName,
         pItem->addr.p = FMSTR_TSATBL_VOIDPTR_CAST(varAddr);
         pItem->info.p = FMSTR_TSATBL_VOIDPTR_CAST(info);
         fmstr_tsaTableIndex++;
+
+#if FMSTR_USE_TSA_SAFETY > 0 && FMSTR_TSA_INDEX_SIZE > 0
+        /* the new entry and the grown table itself */
+        _FMSTR_TsaIndexAddEntry(pItem);
+        _FMSTR_TsaIndexAdd(&fmstr_tsaReadIndex, fmstr_tsaBuffAddr,
+                           (FMSTR_SIZE)(fmstr_tsaTableIndex * sizeof(FMSTR_TSA_ENTRY)));
+#endif
         return FMSTR_TRUE;
     }
     else
@@ -338,6 +380,29 @@ FMSTR_BOOL FMSTR_CheckTsaSpace(FMSTR_ADDR varAddr, FMSTR_SIZE varSize, FMSTR_BOO
     varSize = (varSize + 1) / FMSTR_CFG_BUS_WIDTH;
 #endif
 
+#if FMSTR_USE_TSA_SAFETY > 0 && FMSTR_TSA_INDEX_SIZE > 0
+    /* binary search in the index, the tables are only walked when it overflowed */
+    if (fmstr_tsaIndexValid != FMSTR_FALSE)
+    {
+        if (writeAccess != FMSTR_FALSE)
+        {
+            return _FMSTR_TsaIndexCheck(&fmstr_tsaWriteIndex, varAddr, varSize);
+        }
+
+        if (_FMSTR_TsaIndexCheck(&fmstr_tsaReadIndex, varAddr, varSize) != FMSTR_FALSE)
+        {
+            return FMSTR_TRUE;
+        }
+
+#if FMSTR_USE_RECORDER > 0
+        /* the recorder buffer may change at runtime, it is not indexed */
+        return FMSTR_IsInRecBuffer(varAddr, varSize);
+#else
+        return FMSTR_FALSE;
+#endif
+    }
+#endif
+
     /* to be as fast as possible during normal operation,
        check variable entries in all tables first */
     tableIndex = 0U;
@@ -451,6 +516,247 @@ FMSTR_BOOL FMSTR_CheckTsaSpace(FMSTR_ADDR varAddr, FMSTR_SIZE varSize, FMSTR_BOO
     return FMSTR_FALSE;
 }
 
+#if FMSTR_USE_TSA_SAFETY > 0 && FMSTR_TSA_INDEX_SIZE > 0
+
+/******************************************************************************
+ *
+ * @brief    Build the TSA safety index from all TSA tables
+ *
+ ******************************************************************************/
+
+static void _FMSTR_TsaIndexBuild(void)
+{
+    FMSTR_LP_TSA_ENTRY pte;
+    FMSTR_ADDR pteAddr;
+    FMSTR_SIZE tableIndex;
+    FMSTR_SIZE i, cnt;
+
+    fmstr_tsaReadIndex.count  = 0U;
+    fmstr_tsaWriteIndex.count = 0U;
+    fmstr_tsaIndexValid       = FMSTR_TRUE;
+
+    tableIndex = 0U;
+    while ((pteAddr = FMSTR_TsaGetTable(tableIndex, &cnt)) != NULL)
+    {
+        pte = (FMSTR_LP_TSA_ENTRY)FMSTR_CAST_ADDR_TO_PTR(pteAddr);
+
+        /* the TSA table itself is readable */
+        _FMSTR_TsaIndexAdd(&fmstr_tsaReadIndex, pteAddr, cnt);
+
+        /* number of items in a table */
+        cnt /= (FMSTR_SIZE)sizeof(FMSTR_TSA_ENTRY);
+
+        /* all table entries */
+        for (i = 0U; i < cnt; i++)
+        {
+            _FMSTR_TsaIndexAddEntry(pte);
+            pte++;
+        }
+
+        tableIndex++;
+    }
+}
+
+/******************************************************************************
+ *
+ * @brief    Add the memory of one TSA table entry to the index
+ *
+ * @param    pte - TSA table entry
+ *
+ * The same memory as accepted by the table walk of FMSTR_CheckTsaSpace: the
+ * variable for reading (and writing when it is read-write), the name and type
+ * strings for reading.
+ *
+ ******************************************************************************/
+
+static void _FMSTR_TsaIndexAddEntry(FMSTR_LP_TSA_ENTRY pte)
+{
+    unsigned long info;
+    FMSTR_ADDR addr;
+
+    if (sizeof(pte->addr.p) < sizeof(pte->addr.n))
+    {
+        info = (unsigned long)pte->info.n;
+        addr = pte->addr.n;
+    }
+    else
+    {
+        info = (unsigned long)pte->info.p;
+        addr = (FMSTR_ADDR)pte->addr.p;
+    }
+
+    if (_FMSTR_IsMemoryMapped(pte->type.p, info) != FMSTR_FALSE)
+    {
+        _FMSTR_TsaIndexAdd(&fmstr_tsaReadIndex, addr, (FMSTR_SIZE)(info >> 2));
+
+        if ((info & FMSTR_TSA_INFO_VAR_MASK) == FMSTR_TSA_INFO_RW_VAR)
+        {
+            _FMSTR_TsaIndexAdd(&fmstr_tsaWriteIndex, addr, (FMSTR_SIZE)(info >> 2));
+        }
+    }
+
+    /* system strings are always accessible as C-pointers */
+    if (pte->name.p != NULL)
+    {
+        _FMSTR_TsaIndexAdd(&fmstr_tsaReadIndex, (FMSTR_ADDR)(pte->name.p), FMSTR_StrLen(pte->name.p));
+    }
+
+    if (pte->type.p != NULL)
+    {
+        _FMSTR_TsaIndexAdd(&fmstr_tsaReadIndex, (FMSTR_ADDR)(pte->type.p), FMSTR_StrLen(pte->type.p));
+    }
+}
+
+/******************************************************************************
+ *
+ * @brief    Add a memory interval to the index
+ *
+ * @param    index - read or write index
+ * @param    addr - start of the memory
+ * @param    size - size of the memory
+ *
+ * The interval is merged with all intervals it overlaps or touches. When the
+ * index is full, it is marked invalid and the tables are walked again.
+ *
+ ******************************************************************************/
+
+static void _FMSTR_TsaIndexAdd(FMSTR_TSA_INDEX *index, FMSTR_ADDR addr, FMSTR_SIZE size)
+{
+    FMSTR_ADDR end;
+    FMSTR_SIZE first, last, i;
+
+    if (size == 0U || fmstr_tsaIndexValid == FMSTR_FALSE)
+    {
+        return;
+    }
+
+#ifdef __HCS12X__
+    /* convert from logical to global if needed */
+    addr = FMSTR_FixHcs12xAddr(addr);
+#endif
+    end = addr + size;
+
+    /* intervals first..last-1 overlap or touch the new one */
+    first = _FMSTR_TsaIndexFind(index, addr);
+    if (first > 0U && index->items[first - 1U].end >= addr)
+    {
+        first--;
+    }
+
+    last = first;
+    while (last < index->count && index->items[last].start <= end)
+    {
+        last++;
+    }
+
+    if (first == last)
+    {
+        /* insert a new interval */
+        if (index->count >= (FMSTR_SIZE)FMSTR_TSA_INDEX_SIZE)
+        {
+            fmstr_tsaIndexValid = FMSTR_FALSE;
+            return;
+        }
+
+        for (i = index->count; i > first; i--)
+        {
+            index->items[i] = index->items[i - 1U];
+        }
+
+        index->items[first].start = addr;
+        index->items[first].end   = end;
+        index->count++;
+        return;
+    }
+
+    /* merge into the first one and drop the others */
+    if (index->items[first].start < addr)
+    {
+        addr = index->items[first].start;
+    }
+    if (index->items[last - 1U].end > end)
+    {
+        end = index->items[last - 1U].end;
+    }
+
+    index->items[first].start = addr;
+    index->items[first].end   = end;
+
+    first++;
+    for (i = last; i < index->count; i++)
+    {
+        index->items[first] = index->items[i];
+        first++;
+    }
+    index->count = first;
+}
+
+/******************************************************************************
+ *
+ * @brief    Binary search in the index
+ *
+ * @param    index - read or write index
+ * @param    addr - address to look up
+ *
+ * @return   Number of intervals starting at or below the address
+ *
+ ******************************************************************************/
+
+static FMSTR_SIZE _FMSTR_TsaIndexFind(const FMSTR_TSA_INDEX *index, FMSTR_ADDR addr)
+{
+    FMSTR_SIZE low  = 0U;
+    FMSTR_SIZE high = index->count;
+    FMSTR_SIZE mid;
+
+    while (low < high)
+    {
+        mid = low + ((high - low) >> 1);
+        if (index->items[mid].start <= addr)
+        {
+            low = mid + 1U;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/******************************************************************************
+ *
+ * @brief    Check wether given memory region lies in one interval of the index
+ *
+ * @param    index - read or write index
+ * @param    addr - address of the memory to be checked
+ * @param    size - size of the memory to be checked
+ *
+ * @return   This function returns non-zero if the memory is covered
+ *
+ ******************************************************************************/
+
+static FMSTR_BOOL _FMSTR_TsaIndexCheck(const FMSTR_TSA_INDEX *index, FMSTR_ADDR addr, FMSTR_SIZE size)
+{
+    FMSTR_SIZE i;
+
+#ifdef __HCS12X__
+    /* convert from logical to global if needed */
+    addr = FMSTR_FixHcs12xAddr(addr);
+#endif
+
+    /* the last interval starting at or below the address is the only candidate */
+    i = _FMSTR_TsaIndexFind(index, addr);
+    if (i == 0U)
+    {
+        return FMSTR_FALSE;
+    }
+
+    return (FMSTR_BOOL)((addr + size) <= index->items[i - 1U].end ? FMSTR_TRUE : FMSTR_FALSE);
+}
+
+#endif /* FMSTR_USE_TSA_SAFETY > 0 && FMSTR_TSA_INDEX_SIZE > 0 */
+
 /* Check type of the entry. */
 static FMSTR_BOOL _FMSTR_IsMemoryMapped(const char *type, unsigned long info)
 {